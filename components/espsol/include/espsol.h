@@ -26,12 +26,20 @@
 
 /* RPC client for Solana network communication */
 #include "espsol_rpc.h"
+#include "espsol_transport.h"
+#include "espsol_cancel.h"
 
 /* Transaction building and serialization */
 #include "espsol_tx.h"
+#include "espsol_alt.h"
+#include "espsol_nonce.h"
+#include "espsol_template.h"
+#include "espsol_pack.h"
+#include "espsol_view.h"
 
 /* SPL Token operations */
 #include "espsol_token.h"
+#include "espsol_fee.h"
 
 #ifdef __cplusplus
 extern "C" {
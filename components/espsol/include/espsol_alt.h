@@ -0,0 +1,344 @@
+/**
+ * @file espsol_alt.h
+ * @brief ESPSOL Address Lookup Table API
+ *
+ * Decoding and caching of address lookup table accounts, automatic table
+ * selection for v0 transactions, and Address Lookup Table program
+ * instructions for maintaining tables.
+ *
+ * @copyright Copyright (c) 2025 SkyRizz
+ * @license Apache-2.0
+ */
+
+#ifndef ESPSOL_ALT_H
+#define ESPSOL_ALT_H
+
+#include "espsol_types.h"
+#include "espsol_tx.h"
+#include "espsol_rpc.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ============================================================================
+ * Constants
+ * ========================================================================== */
+
+/** @brief Address Lookup Table Program ID (AddressLookupTab1e1111111111111111111111111) */
+extern const uint8_t ESPSOL_ADDRESS_LOOKUP_TABLE_PROGRAM_ID[ESPSOL_PUBKEY_SIZE];
+
+/** @brief Size of the lookup table account header */
+#define ESPSOL_ALT_HEADER_SIZE      56
+
+/** @brief Maximum number of addresses in a lookup table */
+#define ESPSOL_ALT_MAX_ADDRESSES    256
+
+/** @brief deactivation_slot of a table that is still active */
+#define ESPSOL_ALT_ACTIVE           UINT64_MAX
+
+/* ============================================================================
+ * Account Decoding
+ * ========================================================================== */
+
+/**
+ * @brief Decoded lookup table account header
+ */
+typedef struct {
+    uint64_t deactivation_slot;             /**< Slot of deactivation (ESPSOL_ALT_ACTIVE if active) */
+    uint64_t last_extended_slot;            /**< Slot of the last extension */
+    uint8_t last_extended_start_index;      /**< First address added by the last extension */
+    bool has_authority;                     /**< Table is mutable */
+    uint8_t authority[ESPSOL_PUBKEY_SIZE];  /**< Authority (if has_authority) */
+    size_t address_count;                   /**< Number of addresses */
+} espsol_alt_state_t;
+
+/**
+ * @brief Decode lookup table account data
+ *
+ * @param[in]  data       Account data
+ * @param[in]  data_len   Length of data
+ * @param[out] state      Decoded header
+ * @param[out] addresses  Set to the address array inside data (can be NULL)
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if data or state is NULL
+ *     - ESP_ERR_ESPSOL_RPC_PARSE_ERROR if data is not a lookup table
+ */
+esp_err_t espsol_alt_decode(const uint8_t *data, size_t data_len,
+                            espsol_alt_state_t *state,
+                            const uint8_t (**addresses)[ESPSOL_PUBKEY_SIZE]);
+
+/* ============================================================================
+ * Lookup Table Cache
+ * ========================================================================== */
+
+/**
+ * @brief Opaque handle for a lookup table cache
+ */
+typedef struct espsol_alt_cache *espsol_alt_cache_handle_t;
+
+/**
+ * @brief Lookup table cache configuration
+ */
+typedef struct {
+    size_t max_tables;          /**< Tables kept (least recently loaded is evicted) */
+    uint64_t max_age_slots;     /**< Slots a loaded table stays valid (0 = forever) */
+} espsol_alt_cache_config_t;
+
+/**
+ * @brief Default cache configuration initializer
+ */
+#define ESPSOL_ALT_CACHE_CONFIG_DEFAULT() { \
+    .max_tables = 8, \
+    .max_age_slots = 9000 \
+}
+
+/**
+ * @brief Create a lookup table cache
+ *
+ * @param[in]  config   Configuration (NULL for defaults)
+ * @param[out] cache    Created cache
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if cache is NULL or max_tables is 0
+ *     - ESP_ERR_NO_MEM if allocation fails
+ */
+esp_err_t espsol_alt_cache_create(const espsol_alt_cache_config_t *config,
+                                  espsol_alt_cache_handle_t *cache);
+
+/**
+ * @brief Destroy a lookup table cache
+ *
+ * Tables selected into transactions become invalid.
+ *
+ * @param[in] cache     Cache handle
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if cache is NULL
+ */
+esp_err_t espsol_alt_cache_destroy(espsol_alt_cache_handle_t cache);
+
+/**
+ * @brief Add or replace a table from its account data
+ *
+ * Addresses added by an extension in the slot the data was read at are
+ * not usable yet and are left out.
+ *
+ * @param[in] cache      Cache handle
+ * @param[in] key        Table address
+ * @param[in] data       Account data
+ * @param[in] data_len   Length of data
+ * @param[in] slot       Slot the data was read at
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if any pointer is NULL
+ *     - ESP_ERR_ESPSOL_RPC_PARSE_ERROR if data is not a lookup table
+ *     - ESP_ERR_NO_MEM if allocation fails
+ */
+esp_err_t espsol_alt_cache_put(espsol_alt_cache_handle_t cache,
+                               const uint8_t key[ESPSOL_PUBKEY_SIZE],
+                               const uint8_t *data, size_t data_len,
+                               uint64_t slot);
+
+/**
+ * @brief Fetch a table with getAccountInfo and add it to the cache
+ *
+ * The response is streamed, so tables of any size work with the default
+ * client buffer.
+ *
+ * @param[in] cache     Cache handle
+ * @param[in] rpc       RPC client handle
+ * @param[in] key       Table address
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if any argument is NULL
+ *     - ESP_ERR_NOT_FOUND if the account does not exist
+ *     - ESP_ERR_ESPSOL_RPC_PARSE_ERROR if the account is not a lookup table
+ *     - ESP_ERR_ESPSOL_RPC_FAILED on RPC error
+ */
+esp_err_t espsol_alt_cache_fetch(espsol_alt_cache_handle_t cache,
+                                 espsol_rpc_handle_t rpc,
+                                 const uint8_t key[ESPSOL_PUBKEY_SIZE]);
+
+/**
+ * @brief Get a cached table
+ *
+ * @param[in]  cache    Cache handle
+ * @param[in]  key      Table address
+ * @param[out] table    Table view (valid until the entry is replaced or removed)
+ * @param[out] state    Decoded header (can be NULL)
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if any required argument is NULL
+ *     - ESP_ERR_NOT_FOUND if the table is not cached
+ */
+esp_err_t espsol_alt_cache_get(espsol_alt_cache_handle_t cache,
+                               const uint8_t key[ESPSOL_PUBKEY_SIZE],
+                               espsol_lookup_table_t *table,
+                               espsol_alt_state_t *state);
+
+/**
+ * @brief Find a cached table holding an address
+ *
+ * @param[in]  cache      Cache handle
+ * @param[in]  address    Address to look up
+ * @param[out] table_key  Table holding it (can be NULL)
+ * @param[out] index      Index of the address in that table (can be NULL)
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if cache or address is NULL
+ *     - ESP_ERR_NOT_FOUND if no active cached table holds the address
+ */
+esp_err_t espsol_alt_cache_find(espsol_alt_cache_handle_t cache,
+                                const uint8_t address[ESPSOL_PUBKEY_SIZE],
+                                uint8_t table_key[ESPSOL_PUBKEY_SIZE],
+                                uint8_t *index);
+
+/**
+ * @brief Remove a table from the cache
+ *
+ * @param[in] cache     Cache handle
+ * @param[in] key       Table address
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if cache or key is NULL
+ *     - ESP_ERR_NOT_FOUND if the table is not cached
+ */
+esp_err_t espsol_alt_cache_remove(espsol_alt_cache_handle_t cache,
+                                  const uint8_t key[ESPSOL_PUBKEY_SIZE]);
+
+/**
+ * @brief Drop tables that are too old or deactivated
+ *
+ * @param[in]  cache         Cache handle
+ * @param[in]  current_slot  Current slot
+ * @param[out] removed       Number of tables dropped (can be NULL)
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if cache is NULL
+ */
+esp_err_t espsol_alt_cache_expire(espsol_alt_cache_handle_t cache,
+                                  uint64_t current_slot,
+                                  size_t *removed);
+
+/**
+ * @brief Choose the cached tables that make a transaction smallest
+ *
+ * Considers every combination of up to ESPSOL_MAX_LOOKUP_TABLES active
+ * tables. A table costs 34 bytes plus one byte per account it loads and
+ * saves 32 bytes per account. Replaces any lookup tables already added to
+ * the transaction. The transaction is made v0 if that saves space and
+ * left (or made) legacy otherwise. When a legacy message would exceed
+ * ESPSOL_MAX_ACCOUNTS, tables are used even if they cost bytes.
+ *
+ * The transaction refers to table contents held by the cache, so keep the
+ * selected entries cached until it has been serialized.
+ *
+ * @param[in]  cache     Cache handle
+ * @param[in]  tx        Transaction with its instructions added
+ * @param[out] saved     Bytes saved compared with a legacy message, negative
+ *                       if tables were needed to fit (can be NULL)
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if cache or tx is NULL
+ *     - ESP_ERR_NOT_SUPPORTED if versioned transactions are disabled
+ *     - ESP_ERR_ESPSOL_MAX_ACCOUNTS if the accounts do not fit even with tables
+ */
+esp_err_t espsol_alt_cache_select(espsol_alt_cache_handle_t cache,
+                                  espsol_tx_handle_t tx,
+                                  int *saved);
+
+/* ============================================================================
+ * Lookup Table Program Instructions
+ * ========================================================================== */
+
+/**
+ * @brief Add a CreateLookupTable instruction
+ *
+ * The table address is derived from the authority and recent_slot, which
+ * must be a recent slot (for example from espsol_rpc_get_slot()).
+ *
+ * @param[in]  tx           Transaction handle
+ * @param[in]  authority    Table authority (must sign)
+ * @param[in]  payer        Pays for the table account (must sign)
+ * @param[in]  recent_slot  Recent slot
+ * @param[out] table        Derived table address (can be NULL)
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if tx, authority or payer is NULL
+ *     - ESP_ERR_ESPSOL_CRYPTO_ERROR if no table address could be derived
+ *     - ESP_ERR_ESPSOL_MAX_INSTRUCTIONS if instruction limit reached
+ */
+esp_err_t espsol_tx_add_alt_create(espsol_tx_handle_t tx,
+                                   const uint8_t authority[ESPSOL_PUBKEY_SIZE],
+                                   const uint8_t payer[ESPSOL_PUBKEY_SIZE],
+                                   uint64_t recent_slot,
+                                   uint8_t table[ESPSOL_PUBKEY_SIZE]);
+
+/**
+ * @brief Add an ExtendLookupTable instruction
+ *
+ * The number of addresses per instruction is bounded by
+ * ESPSOL_MAX_INSTRUCTION_DATA, about 30 once the other accounts and the
+ * signatures are on the wire.
+ *
+ * @param[in] tx             Transaction handle
+ * @param[in] table          Table address
+ * @param[in] authority      Table authority (must sign)
+ * @param[in] payer          Pays for the extra space (must sign)
+ * @param[in] addresses      Addresses to append
+ * @param[in] address_count  Number of addresses
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if any pointer is NULL or address_count is 0
+ *     - ESP_ERR_ESPSOL_BUFFER_TOO_SMALL if the addresses do not fit one instruction
+ *     - ESP_ERR_ESPSOL_MAX_INSTRUCTIONS if instruction limit reached
+ */
+esp_err_t espsol_tx_add_alt_extend(espsol_tx_handle_t tx,
+                                   const uint8_t table[ESPSOL_PUBKEY_SIZE],
+                                   const uint8_t authority[ESPSOL_PUBKEY_SIZE],
+                                   const uint8_t payer[ESPSOL_PUBKEY_SIZE],
+                                   const uint8_t (*addresses)[ESPSOL_PUBKEY_SIZE],
+                                   size_t address_count);
+
+/**
+ * @brief Add a DeactivateLookupTable instruction
+ *
+ * A deactivated table can be closed once it has cooled down (about 513
+ * slots).
+ *
+ * @param[in] tx         Transaction handle
+ * @param[in] table      Table address
+ * @param[in] authority  Table authority (must sign)
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if any argument is NULL
+ *     - ESP_ERR_ESPSOL_MAX_INSTRUCTIONS if instruction limit reached
+ */
+esp_err_t espsol_tx_add_alt_deactivate(espsol_tx_handle_t tx,
+                                       const uint8_t table[ESPSOL_PUBKEY_SIZE],
+                                       const uint8_t authority[ESPSOL_PUBKEY_SIZE]);
+
+/**
+ * @brief Add a CloseLookupTable instruction
+ *
+ * @param[in] tx         Transaction handle
+ * @param[in] table      Deactivated table address
+ * @param[in] authority  Table authority (must sign)
+ * @param[in] recipient  Receives the table's lamports
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if any argument is NULL
+ *     - ESP_ERR_ESPSOL_MAX_INSTRUCTIONS if instruction limit reached
+ */
+esp_err_t espsol_tx_add_alt_close(espsol_tx_handle_t tx,
+                                  const uint8_t table[ESPSOL_PUBKEY_SIZE],
+                                  const uint8_t authority[ESPSOL_PUBKEY_SIZE],
+                                  const uint8_t recipient[ESPSOL_PUBKEY_SIZE]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ESPSOL_ALT_H */
@@ -0,0 +1,146 @@
+/**
+ * @file espsol_cancel.h
+ * @brief ESPSOL Deadlines and Cancellation
+ *
+ * Per-call time budgets and cancellation tokens shared by the RPC and
+ * WebSocket clients. A deadline covers the whole call, including retries
+ * and backoff; a cancellation token can be triggered from any task to
+ * abort calls that are waiting on the network.
+ *
+ * @copyright Copyright (c) 2025 SkyRizz
+ * @license Apache-2.0
+ */
+
+#ifndef ESPSOL_CANCEL_H
+#define ESPSOL_CANCEL_H
+
+#include "espsol_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Interval at which blocking waits re-check cancellation (ms)
+ */
+#define ESPSOL_CANCEL_POLL_MS       20
+
+/* ============================================================================
+ * Cancellation Token
+ * ========================================================================== */
+
+/**
+ * @brief Cancellation token
+ *
+ * Owned by the caller. One token may be shared by several clients; it
+ * stays cancelled until reset.
+ */
+typedef struct {
+    volatile uint32_t cancelled;    /**< Non-zero once cancelled (use the functions below) */
+} espsol_cancel_token_t;
+
+/**
+ * @brief Static initializer for a cancellation token
+ */
+#define ESPSOL_CANCEL_TOKEN_INIT() { .cancelled = 0 }
+
+/**
+ * @brief Request cancellation (safe to call from any task)
+ *
+ * @param[in] token    Cancellation token
+ */
+void espsol_cancel_token_cancel(espsol_cancel_token_t *token);
+
+/**
+ * @brief Clear a cancellation so the token can be reused
+ *
+ * @param[in] token    Cancellation token
+ */
+void espsol_cancel_token_reset(espsol_cancel_token_t *token);
+
+/**
+ * @brief Check whether cancellation was requested
+ *
+ * @param[in] token    Cancellation token (NULL is never cancelled)
+ * @return true if cancelled
+ */
+bool espsol_cancel_token_is_cancelled(const espsol_cancel_token_t *token);
+
+/* ============================================================================
+ * Call Options
+ * ========================================================================== */
+
+/**
+ * @brief Limits applied to each API call on a client
+ */
+typedef struct {
+    uint32_t deadline_ms;           /**< Budget per call incl. retries (0 = none) */
+    espsol_cancel_token_t *cancel;  /**< Cancellation token (NULL = none) */
+} espsol_call_options_t;
+
+/**
+ * @brief Default call options (no deadline, not cancellable)
+ */
+#define ESPSOL_CALL_OPTIONS_DEFAULT() { \
+    .deadline_ms = 0, \
+    .cancel = NULL \
+}
+
+/* ============================================================================
+ * Deadline
+ * ========================================================================== */
+
+/**
+ * @brief Deadline of one call in progress
+ */
+typedef struct {
+    int64_t expires_us;                     /**< Monotonic expiry time (0 = none) */
+    const espsol_cancel_token_t *cancel;    /**< Cancellation token (may be NULL) */
+} espsol_deadline_t;
+
+/**
+ * @brief Start a deadline for a call
+ *
+ * @param[out] deadline    Deadline to initialize
+ * @param[in]  options     Call options (NULL for no limits)
+ */
+void espsol_deadline_start(espsol_deadline_t *deadline,
+                           const espsol_call_options_t *options);
+
+/**
+ * @brief Check whether a call may continue
+ *
+ * @param[in] deadline     Deadline (NULL for no limits)
+ * @return
+ *     - ESP_OK if the call may continue
+ *     - ESP_ERR_ESPSOL_CANCELLED if the token was cancelled
+ *     - ESP_ERR_ESPSOL_TIMEOUT if the deadline has passed
+ */
+esp_err_t espsol_deadline_check(const espsol_deadline_t *deadline);
+
+/**
+ * @brief Clamp a wait to the time left
+ *
+ * @param[in] deadline     Deadline (NULL for no limits)
+ * @param[in] limit_ms     Upper bound for the wait
+ * @return min(limit_ms, remaining time), 0 if expired
+ */
+uint32_t espsol_deadline_remaining_ms(const espsol_deadline_t *deadline, uint32_t limit_ms);
+
+/**
+ * @brief Sleep, waking early on cancellation or expiry
+ *
+ * @param[in] deadline     Deadline (NULL for no limits)
+ * @param[in] ms           Time to sleep
+ * @return
+ *     - ESP_OK after sleeping the full time
+ *     - ESP_ERR_ESPSOL_CANCELLED if cancelled while sleeping
+ *     - ESP_ERR_ESPSOL_TIMEOUT if the deadline passed while sleeping
+ */
+esp_err_t espsol_deadline_sleep(const espsol_deadline_t *deadline, uint32_t ms);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ESPSOL_CANCEL_H */
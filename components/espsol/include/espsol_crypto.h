@@ -18,6 +18,7 @@
 #define ESPSOL_CRYPTO_H
 
 #include "espsol_types.h"
+#include "espsol_utils.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -32,13 +33,26 @@ extern "C" {
  *
  * Contains Ed25519 public and private keys.
  * The private key includes the 32-byte seed followed by the 32-byte public key.
+ * The expanded key is derived from the seed once, when the keypair is set
+ * up, so signing does not hash the seed again for every signature.
  */
 typedef struct {
     uint8_t public_key[ESPSOL_PUBKEY_SIZE];     /**< Ed25519 public key (32 bytes) */
     uint8_t private_key[ESPSOL_PRIVKEY_SIZE];   /**< Ed25519 private key (64 bytes) */
+    uint8_t expanded_key[64];                    /**< SHA-512(seed): clamped scalar, then nonce prefix */
     bool initialized;                            /**< Whether keypair is valid */
 } espsol_keypair_t;
 
+/**
+ * @brief A message with its signature and signer, for batch verification
+ */
+typedef struct {
+    const uint8_t *message;         /**< Signed message */
+    size_t message_len;             /**< Length of message */
+    const uint8_t *signature;       /**< ESPSOL_SIGNATURE_SIZE bytes */
+    const uint8_t *public_key;      /**< ESPSOL_PUBKEY_SIZE bytes */
+} espsol_signed_message_t;
+
 /* ============================================================================
  * Initialization
  * ========================================================================== */
@@ -60,13 +74,15 @@ esp_err_t espsol_crypto_init(void);
 /**
  * @brief Generate cryptographically secure random bytes
  *
- * Uses ESP32 hardware RNG on device, or system RNG on host.
+ * Uses ESP32 hardware RNG on device, or system RNG on host (getrandom()
+ * on Linux, /dev/urandom elsewhere).
  *
  * @param[out] buffer   Output buffer for random bytes
  * @param[in]  len      Number of bytes to generate
  *
  * @return ESP_OK on success
  * @return ESP_ERR_INVALID_ARG if buffer is NULL
+ * @return ESP_ERR_ESPSOL_CRYPTO_ERROR if the host has no system generator
  */
 esp_err_t espsol_random_bytes(uint8_t *buffer, size_t len);
 
@@ -233,6 +249,37 @@ esp_err_t espsol_sign(const uint8_t *message, size_t message_len,
                        const espsol_keypair_t *keypair,
                        uint8_t signature[ESPSOL_SIGNATURE_SIZE]);
 
+/**
+ * @brief Produce a message into a writer
+ *
+ * @param[in] ctx     Producer context
+ * @param[in] writer  Destination for the message bytes
+ * @return ESP_OK, or an error that stops signing
+ */
+typedef esp_err_t (*espsol_message_fn)(void *ctx, const espsol_writer_t *writer);
+
+/**
+ * @brief Sign a message streamed by a producer
+ *
+ * Ed25519 hashes the message twice, once for the nonce and once for the
+ * challenge, so the producer is called twice and must write the same
+ * bytes both times. The bytes go straight into the hash: the message is
+ * never gathered in memory and nothing is allocated.
+ *
+ * @param[in]  message    Producer of the message
+ * @param[in]  ctx        Passed to message
+ * @param[in]  keypair    Keypair to sign with
+ * @param[out] signature  Output buffer for signature (64 bytes)
+ *
+ * @return ESP_OK on success
+ * @return ESP_ERR_INVALID_ARG if arguments are NULL
+ * @return ESP_ERR_ESPSOL_KEYPAIR_NOT_INIT if keypair not initialized
+ * @return Errors from the producer, in which case signature is zeroed
+ */
+esp_err_t espsol_sign_stream(espsol_message_fn message, void *ctx,
+                              const espsol_keypair_t *keypair,
+                              uint8_t signature[ESPSOL_SIGNATURE_SIZE]);
+
 /**
  * @brief Sign a message using raw private key
  *
@@ -285,6 +332,58 @@ esp_err_t espsol_verify(const uint8_t *message, size_t message_len,
                          const uint8_t signature[ESPSOL_SIGNATURE_SIZE],
                          const uint8_t public_key[ESPSOL_PUBKEY_SIZE]);
 
+/**
+ * @brief Verify several signatures over the same message
+ *
+ * Gives exactly the result of calling espsol_verify() on each signature,
+ * which is also what the Solana runtime decides, so it is safe for
+ * relayed transactions. The signatures are checked one by one; see
+ * espsol_verify_batch() for why they are not batched.
+ *
+ * @param[in]  message        Signed message
+ * @param[in]  message_len    Length of message
+ * @param[in]  signatures     count signatures
+ * @param[in]  public_keys    count public keys, in signature order
+ * @param[in]  count          Number of signatures
+ * @param[out] invalid_index  Index of the first invalid signature (optional)
+ *
+ * @return ESP_OK if every signature is valid
+ * @return ESP_ERR_INVALID_ARG if arguments are NULL
+ * @return ESP_ERR_ESPSOL_SIGNATURE_INVALID if a signature is invalid
+ */
+esp_err_t espsol_verify_signers(const uint8_t *message, size_t message_len,
+                                const uint8_t (*signatures)[ESPSOL_SIGNATURE_SIZE],
+                                const uint8_t (*public_keys)[ESPSOL_PUBKEY_SIZE],
+                                size_t count, size_t *invalid_index);
+
+/**
+ * @brief Verify many signed messages
+ *
+ * Every signature covers its own message. With the built-in backends,
+ * all signatures are combined into one randomized, cofactored check that
+ * costs about half as much as separate espsol_verify() calls; if it
+ * fails, the messages are verified one by one to find the first invalid
+ * one. libsodium has no batch API, so its builds always verify one by one.
+ *
+ * Guarantee: every item that espsol_verify() accepts passes. The reverse
+ * does not hold: an item whose R or public key has a small-order
+ * component can pass here although espsol_verify() and the Solana
+ * runtime reject it. Rejecting such points would cost more than verifying
+ * the items separately. Honest signers never produce them, so use this for
+ * signatures from known devices, and espsol_verify_signers() or
+ * espsol_verify() for untrusted input.
+ *
+ * @param[in]  items          count signed messages
+ * @param[in]  count          Number of items
+ * @param[out] invalid_index  Index of the first invalid item (optional)
+ *
+ * @return ESP_OK if every signature is valid
+ * @return ESP_ERR_INVALID_ARG if arguments are NULL
+ * @return ESP_ERR_ESPSOL_SIGNATURE_INVALID if a signature is invalid
+ */
+esp_err_t espsol_verify_batch(const espsol_signed_message_t *items, size_t count,
+                              size_t *invalid_index);
+
 /**
  * @brief Verify signature using keypair's public key
  *
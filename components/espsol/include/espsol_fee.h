@@ -0,0 +1,158 @@
+/**
+ * @file espsol_fee.h
+ * @brief ESPSOL Rent and Fee Calculation
+ *
+ * Local calculation of rent-exempt minimum balances and transaction fees.
+ * The Rent sysvar parameters only change through feature activation, so
+ * they can be fetched once (see espsol_rpc_get_rent()) and reused for any
+ * account size without further RPC round trips.
+ *
+ * @copyright Copyright (c) 2025 SkyRizz
+ * @license Apache-2.0
+ */
+
+#ifndef ESPSOL_FEE_H
+#define ESPSOL_FEE_H
+
+#include "espsol_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ============================================================================
+ * Rent and Fee Constants
+ * ========================================================================== */
+
+/** @brief Rent sysvar address */
+#define ESPSOL_RENT_SYSVAR_ADDRESS  "SysvarRent111111111111111111111111111111111"
+
+/** @brief Serialized Rent sysvar size (u64 + f64 + u8) */
+#define ESPSOL_RENT_SYSVAR_SIZE     17
+
+/** @brief Account metadata bytes charged on top of the data length */
+#define ESPSOL_ACCOUNT_STORAGE_OVERHEAD     128
+
+/** @brief Default rent rate (lamports per byte-year) */
+#define ESPSOL_DEFAULT_LAMPORTS_PER_BYTE_YEAR   3480
+
+/** @brief Default exemption threshold (years) */
+#define ESPSOL_DEFAULT_EXEMPTION_THRESHOLD      2.0
+
+/** @brief Default percentage of collected rent that is burned */
+#define ESPSOL_DEFAULT_BURN_PERCENT             50
+
+/** @brief Base fee charged per transaction signature */
+#define ESPSOL_LAMPORTS_PER_SIGNATURE           5000
+
+/** @brief Micro-lamports per lamport (compute unit price unit) */
+#define ESPSOL_MICRO_LAMPORTS_PER_LAMPORT       1000000ULL
+
+/** @brief Compute units granted per instruction when no limit is requested */
+#define ESPSOL_DEFAULT_INSTRUCTION_COMPUTE_UNITS    200000
+
+/** @brief Maximum compute units per transaction */
+#define ESPSOL_MAX_COMPUTE_UNIT_LIMIT               1400000
+
+/* ============================================================================
+ * Rent Parameters
+ * ========================================================================== */
+
+/**
+ * @brief Rent sysvar parameters
+ */
+typedef struct {
+    uint64_t lamports_per_byte_year;  /**< Rental rate in lamports per byte-year */
+    double exemption_threshold;       /**< Years of rent required for exemption */
+    uint8_t burn_percent;             /**< Percentage of rent burned */
+} espsol_rent_t;
+
+/**
+ * @brief Default rent parameters initializer (current cluster values)
+ */
+#define ESPSOL_RENT_DEFAULT() { \
+    .lamports_per_byte_year = ESPSOL_DEFAULT_LAMPORTS_PER_BYTE_YEAR, \
+    .exemption_threshold = ESPSOL_DEFAULT_EXEMPTION_THRESHOLD, \
+    .burn_percent = ESPSOL_DEFAULT_BURN_PERCENT \
+}
+
+/* ============================================================================
+ * Rent Calculation
+ * ========================================================================== */
+
+/**
+ * @brief Decode Rent sysvar account data
+ *
+ * @param[in]  data     Raw account data of the Rent sysvar
+ * @param[in]  data_len Length of data (at least ESPSOL_RENT_SYSVAR_SIZE)
+ * @param[out] rent     Decoded rent parameters
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if an argument is NULL or the data is malformed
+ */
+esp_err_t espsol_rent_decode(const uint8_t *data, size_t data_len,
+                              espsol_rent_t *rent);
+
+/**
+ * @brief Calculate minimum balance for rent exemption
+ *
+ * Computes (128 + data_len) * lamports_per_byte_year * exemption_threshold
+ * with exact integer arithmetic. With default parameters this is
+ * 6960 lamports per byte, or 890880 lamports for an empty account.
+ *
+ * @param[in]  rent      Rent parameters (NULL for defaults)
+ * @param[in]  data_len  Account data length in bytes
+ * @param[out] lamports  Minimum balance in lamports
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if lamports is NULL or the result overflows
+ */
+esp_err_t espsol_rent_minimum_balance(const espsol_rent_t *rent,
+                                       size_t data_len,
+                                       uint64_t *lamports);
+
+/* ============================================================================
+ * Fee Calculation
+ * ========================================================================== */
+
+/**
+ * @brief Calculate the priority fee for a compute budget
+ *
+ * Computes ceil(compute_unit_price * compute_unit_limit / 1,000,000).
+ *
+ * @param[in]  compute_unit_limit  Requested compute units
+ * @param[in]  compute_unit_price  Price in micro-lamports per compute unit
+ * @param[out] lamports            Priority fee in lamports
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if lamports is NULL or the result overflows
+ */
+esp_err_t espsol_fee_priority(uint32_t compute_unit_limit,
+                               uint64_t compute_unit_price,
+                               uint64_t *lamports);
+
+/**
+ * @brief Calculate the total fee for a transaction
+ *
+ * Base fee of 5000 lamports per signature plus the priority fee.
+ * Use espsol_tx_calculate_fee() to derive the inputs from a built
+ * transaction.
+ *
+ * @param[in]  num_signatures      Number of required signatures
+ * @param[in]  compute_unit_limit  Requested compute units
+ * @param[in]  compute_unit_price  Price in micro-lamports per compute unit
+ * @param[out] lamports            Total fee in lamports
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if lamports is NULL or the result overflows
+ */
+esp_err_t espsol_fee_calculate(size_t num_signatures,
+                                uint32_t compute_unit_limit,
+                                uint64_t compute_unit_price,
+                                uint64_t *lamports);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ESPSOL_FEE_H */
@@ -0,0 +1,280 @@
+/**
+ * @file espsol_nonce.h
+ * @brief ESPSOL Durable Nonce API
+ *
+ * Decoding and caching of nonce accounts, and System Program nonce
+ * instructions. A transaction that uses a durable nonce instead of a
+ * recent blockhash (see espsol_tx_set_durable_nonce()) does not expire,
+ * so it can be signed offline and sent much later.
+ *
+ * @copyright Copyright (c) 2025 SkyRizz
+ * @license Apache-2.0
+ */
+
+#ifndef ESPSOL_NONCE_H
+#define ESPSOL_NONCE_H
+
+#include "espsol_types.h"
+#include "espsol_tx.h"
+#include "espsol_rpc.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ============================================================================
+ * Constants
+ * ========================================================================== */
+
+/** @brief Size of a nonce account */
+#define ESPSOL_NONCE_ACCOUNT_SIZE   80
+
+/* ============================================================================
+ * Account Decoding
+ * ========================================================================== */
+
+/**
+ * @brief Decoded nonce account
+ */
+typedef struct {
+    uint32_t version;                       /**< 0 = legacy, 1 = current */
+    bool initialized;                       /**< Account holds a nonce */
+    uint8_t authority[ESPSOL_PUBKEY_SIZE];  /**< Authority allowed to advance it */
+    uint8_t nonce[ESPSOL_BLOCKHASH_SIZE];   /**< Nonce, used as the recent blockhash */
+    uint64_t lamports_per_signature;        /**< Fee rate stored with the nonce */
+} espsol_nonce_state_t;
+
+/**
+ * @brief Decode nonce account data
+ *
+ * An uninitialized account decodes with initialized set to false.
+ *
+ * @param[in]  data      Account data
+ * @param[in]  data_len  Length of data (ESPSOL_NONCE_ACCOUNT_SIZE)
+ * @param[out] state     Decoded account
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if data or state is NULL
+ *     - ESP_ERR_ESPSOL_RPC_PARSE_ERROR if data is not a nonce account
+ */
+esp_err_t espsol_nonce_decode(const uint8_t *data, size_t data_len,
+                              espsol_nonce_state_t *state);
+
+/* ============================================================================
+ * Nonce Cache
+ * ========================================================================== */
+
+/**
+ * @brief Opaque handle for a nonce cache
+ *
+ * Each nonce can sign one transaction: advancing it is what makes the
+ * transaction unique. The cache hands every nonce out once and only hands
+ * out an account again after a newer nonce value has been put.
+ */
+typedef struct espsol_nonce_cache *espsol_nonce_cache_handle_t;
+
+/**
+ * @brief Create a nonce cache
+ *
+ * @param[in]  max_accounts  Nonce accounts kept
+ * @param[out] cache         Created cache
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if cache is NULL or max_accounts is 0
+ *     - ESP_ERR_NO_MEM if allocation fails
+ */
+esp_err_t espsol_nonce_cache_create(size_t max_accounts, espsol_nonce_cache_handle_t *cache);
+
+/**
+ * @brief Destroy a nonce cache
+ *
+ * @param[in] cache     Cache handle
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if cache is NULL
+ */
+esp_err_t espsol_nonce_cache_destroy(espsol_nonce_cache_handle_t cache);
+
+/**
+ * @brief Add or refresh a nonce account from its data
+ *
+ * A refreshed account becomes available again only if its nonce changed.
+ *
+ * @param[in] cache      Cache handle
+ * @param[in] key        Nonce account address
+ * @param[in] data       Account data
+ * @param[in] data_len   Length of data
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if any pointer is NULL
+ *     - ESP_ERR_ESPSOL_RPC_PARSE_ERROR if data is not an initialized nonce account
+ *     - ESP_ERR_NO_MEM if the cache is full
+ */
+esp_err_t espsol_nonce_cache_put(espsol_nonce_cache_handle_t cache,
+                                 const uint8_t key[ESPSOL_PUBKEY_SIZE],
+                                 const uint8_t *data, size_t data_len);
+
+/**
+ * @brief Fetch a nonce account with getAccountInfo and add it to the cache
+ *
+ * @param[in] cache     Cache handle
+ * @param[in] rpc       RPC client handle
+ * @param[in] key       Nonce account address
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if any argument is NULL
+ *     - ESP_ERR_NOT_FOUND if the account does not exist
+ *     - ESP_ERR_ESPSOL_RPC_PARSE_ERROR if the account is not a nonce account
+ *     - ESP_ERR_ESPSOL_RPC_FAILED on RPC error
+ */
+esp_err_t espsol_nonce_cache_fetch(espsol_nonce_cache_handle_t cache,
+                                   espsol_rpc_handle_t rpc,
+                                   const uint8_t key[ESPSOL_PUBKEY_SIZE]);
+
+/**
+ * @brief Get a cached nonce account without using it
+ *
+ * @param[in]  cache    Cache handle
+ * @param[in]  key      Nonce account address
+ * @param[out] state    Decoded account
+ * @param[out] used     Whether the nonce was handed out already (can be NULL)
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if any required argument is NULL
+ *     - ESP_ERR_NOT_FOUND if the account is not cached
+ */
+esp_err_t espsol_nonce_cache_get(espsol_nonce_cache_handle_t cache,
+                                 const uint8_t key[ESPSOL_PUBKEY_SIZE],
+                                 espsol_nonce_state_t *state,
+                                 bool *used);
+
+/**
+ * @brief Hand out an unused nonce and mark it used
+ *
+ * @param[in]  cache    Cache handle
+ * @param[out] key      Nonce account address
+ * @param[out] state    Decoded account
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if any argument is NULL
+ *     - ESP_ERR_NOT_FOUND if every cached nonce has been used
+ */
+esp_err_t espsol_nonce_cache_take(espsol_nonce_cache_handle_t cache,
+                                  uint8_t key[ESPSOL_PUBKEY_SIZE],
+                                  espsol_nonce_state_t *state);
+
+/**
+ * @brief Remove a nonce account from the cache
+ *
+ * @param[in] cache     Cache handle
+ * @param[in] key       Nonce account address
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if cache or key is NULL
+ *     - ESP_ERR_NOT_FOUND if the account is not cached
+ */
+esp_err_t espsol_nonce_cache_remove(espsol_nonce_cache_handle_t cache,
+                                    const uint8_t key[ESPSOL_PUBKEY_SIZE]);
+
+/* ============================================================================
+ * Nonce Instructions
+ * ========================================================================== */
+
+/**
+ * @brief Add CreateAccount and InitializeNonceAccount instructions
+ *
+ * Use espsol_rent_minimum_balance() with ESPSOL_NONCE_ACCOUNT_SIZE for
+ * lamports.
+ *
+ * @param[in] tx             Transaction handle
+ * @param[in] from           Funding account (must sign)
+ * @param[in] nonce_account  New nonce account (must sign)
+ * @param[in] authority      Nonce authority
+ * @param[in] lamports       Balance of the new account
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if any pointer is NULL
+ *     - ESP_ERR_ESPSOL_MAX_INSTRUCTIONS if instruction limit reached
+ */
+esp_err_t espsol_tx_add_nonce_create(espsol_tx_handle_t tx,
+                                     const uint8_t from[ESPSOL_PUBKEY_SIZE],
+                                     const uint8_t nonce_account[ESPSOL_PUBKEY_SIZE],
+                                     const uint8_t authority[ESPSOL_PUBKEY_SIZE],
+                                     uint64_t lamports);
+
+/**
+ * @brief Add an InitializeNonceAccount instruction
+ *
+ * @param[in] tx             Transaction handle
+ * @param[in] nonce_account  Nonce account, allocated with ESPSOL_NONCE_ACCOUNT_SIZE
+ *                           bytes and owned by the System Program
+ * @param[in] authority      Nonce authority
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if any argument is NULL
+ *     - ESP_ERR_ESPSOL_MAX_INSTRUCTIONS if instruction limit reached
+ */
+esp_err_t espsol_tx_add_nonce_initialize(espsol_tx_handle_t tx,
+                                         const uint8_t nonce_account[ESPSOL_PUBKEY_SIZE],
+                                         const uint8_t authority[ESPSOL_PUBKEY_SIZE]);
+
+/**
+ * @brief Add an AdvanceNonceAccount instruction
+ *
+ * Advancing a nonce invalidates every transaction signed with its current
+ * value. To send with a durable nonce use espsol_tx_set_durable_nonce(),
+ * which places this instruction first.
+ *
+ * @param[in] tx             Transaction handle
+ * @param[in] nonce_account  Nonce account
+ * @param[in] authority      Nonce authority (must sign)
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if any argument is NULL
+ *     - ESP_ERR_ESPSOL_MAX_INSTRUCTIONS if instruction limit reached
+ */
+esp_err_t espsol_tx_add_nonce_advance(espsol_tx_handle_t tx,
+                                      const uint8_t nonce_account[ESPSOL_PUBKEY_SIZE],
+                                      const uint8_t authority[ESPSOL_PUBKEY_SIZE]);
+
+/**
+ * @brief Add a WithdrawNonceAccount instruction
+ *
+ * @param[in] tx             Transaction handle
+ * @param[in] nonce_account  Nonce account
+ * @param[in] authority      Nonce authority (must sign)
+ * @param[in] to             Receives the lamports
+ * @param[in] lamports       Amount to withdraw (the whole balance closes the account)
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if any pointer is NULL
+ *     - ESP_ERR_ESPSOL_MAX_INSTRUCTIONS if instruction limit reached
+ */
+esp_err_t espsol_tx_add_nonce_withdraw(espsol_tx_handle_t tx,
+                                       const uint8_t nonce_account[ESPSOL_PUBKEY_SIZE],
+                                       const uint8_t authority[ESPSOL_PUBKEY_SIZE],
+                                       const uint8_t to[ESPSOL_PUBKEY_SIZE],
+                                       uint64_t lamports);
+
+/**
+ * @brief Add an AuthorizeNonceAccount instruction
+ *
+ * @param[in] tx             Transaction handle
+ * @param[in] nonce_account  Nonce account
+ * @param[in] authority      Current authority (must sign)
+ * @param[in] new_authority  New authority
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if any argument is NULL
+ *     - ESP_ERR_ESPSOL_MAX_INSTRUCTIONS if instruction limit reached
+ */
+esp_err_t espsol_tx_add_nonce_authorize(espsol_tx_handle_t tx,
+                                        const uint8_t nonce_account[ESPSOL_PUBKEY_SIZE],
+                                        const uint8_t authority[ESPSOL_PUBKEY_SIZE],
+                                        const uint8_t new_authority[ESPSOL_PUBKEY_SIZE]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ESPSOL_NONCE_H */
@@ -0,0 +1,161 @@
+/**
+ * @file espsol_pack.h
+ * @brief ESPSOL Instruction Packer
+ *
+ * Packs a stream of instructions into as few legacy transactions as
+ * possible. Each transaction is filled greedily up to the wire size,
+ * account, signer and instruction limits, with optional room left for
+ * Compute Budget instructions. Sizes are tracked incrementally, so
+ * nothing is serialized until the transactions are signed.
+ *
+ * @copyright Copyright (c) 2025 SkyRizz
+ * @license Apache-2.0
+ */
+
+#ifndef ESPSOL_PACK_H
+#define ESPSOL_PACK_H
+
+#include "espsol_types.h"
+#include "espsol_tx.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ============================================================================
+ * Packer Configuration
+ * ========================================================================== */
+
+/** @brief Wire bytes of SetComputeUnitLimit and SetComputeUnitPrice, program key included */
+#define ESPSOL_PACKER_COMPUTE_BUDGET_BYTES  52
+
+/**
+ * @brief Packer configuration
+ */
+typedef struct {
+    uint8_t fee_payer[ESPSOL_PUBKEY_SIZE];  /**< Fee payer of every transaction */
+    const uint8_t *blockhash;               /**< Recent blockhash to set (NULL = set later) */
+    bool reserve_compute_budget;            /**< Leave room for two Compute Budget instructions */
+    size_t reserve_bytes;                   /**< Extra wire bytes to leave free */
+    size_t reserve_instructions;            /**< Extra instruction slots to leave free */
+    size_t reserve_accounts;                /**< Extra account slots to leave free */
+} espsol_packer_config_t;
+
+/**
+ * @brief Default packer configuration (room for Compute Budget instructions)
+ */
+#define ESPSOL_PACKER_CONFIG_DEFAULT() { \
+    .fee_payer = {0}, \
+    .blockhash = NULL, \
+    .reserve_compute_budget = true, \
+    .reserve_bytes = 0, \
+    .reserve_instructions = 0, \
+    .reserve_accounts = 0 \
+}
+
+/** @brief Packer handle */
+typedef struct espsol_packer *espsol_packer_handle_t;
+
+/* ============================================================================
+ * Packer Lifecycle
+ * ========================================================================== */
+
+/**
+ * @brief Create a packer
+ *
+ * @param[in]  config   Configuration (fee payer required)
+ * @param[out] packer   Receives the packer handle
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if an argument is NULL or the reserves leave no room
+ *     - ESP_ERR_NO_MEM if allocation fails
+ */
+esp_err_t espsol_packer_create(const espsol_packer_config_t *config,
+                                espsol_packer_handle_t *packer);
+
+/**
+ * @brief Destroy a packer and every transaction not taken from it
+ *
+ * @param[in] packer    Packer handle
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if packer is NULL
+ */
+esp_err_t espsol_packer_destroy(espsol_packer_handle_t packer);
+
+/* ============================================================================
+ * Packing
+ * ========================================================================== */
+
+/**
+ * @brief Add an instruction
+ *
+ * The instruction goes into the open transaction if it fits, otherwise
+ * that transaction is closed and a new one started.
+ *
+ * @param[in] packer         Packer handle
+ * @param[in] program_id     Program ID
+ * @param[in] accounts       Account metas (can be NULL if account_count is 0)
+ * @param[in] account_count  Number of account metas
+ * @param[in] data           Instruction data (can be NULL if data_len is 0)
+ * @param[in] data_len       Length of instruction data
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if a required argument is NULL
+ *     - ESP_ERR_ESPSOL_BUFFER_TOO_SMALL if the instruction does not fit even
+ *       an empty transaction
+ *     - ESP_ERR_ESPSOL_MAX_ACCOUNTS if it has too many accounts or signers
+ *     - ESP_ERR_NO_MEM if allocation fails
+ */
+esp_err_t espsol_packer_add_instruction(espsol_packer_handle_t packer,
+                                         const uint8_t program_id[ESPSOL_PUBKEY_SIZE],
+                                         const espsol_account_meta_t *accounts,
+                                         size_t account_count,
+                                         const uint8_t *data,
+                                         size_t data_len);
+
+/**
+ * @brief Add a SOL transfer
+ *
+ * @return Same as espsol_packer_add_instruction()
+ */
+esp_err_t espsol_packer_add_transfer(espsol_packer_handle_t packer,
+                                      const uint8_t from[ESPSOL_PUBKEY_SIZE],
+                                      const uint8_t to[ESPSOL_PUBKEY_SIZE],
+                                      uint64_t lamports);
+
+/**
+ * @brief Close the open transaction so it can be taken
+ *
+ * @param[in] packer    Packer handle
+ * @return
+ *     - ESP_OK on success (also when nothing is open)
+ *     - ESP_ERR_INVALID_ARG if packer is NULL
+ */
+esp_err_t espsol_packer_flush(espsol_packer_handle_t packer);
+
+/**
+ * @brief Take the oldest closed transaction
+ *
+ * Ownership passes to the caller, who signs, sends and destroys it.
+ * Compute Budget instructions can still be added within the reserve.
+ *
+ * @param[in]  packer   Packer handle
+ * @param[out] tx       Receives the transaction handle
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if an argument is NULL
+ *     - ESP_ERR_NOT_FOUND if no closed transaction is waiting
+ */
+esp_err_t espsol_packer_take(espsol_packer_handle_t packer, espsol_tx_handle_t *tx);
+
+/**
+ * @brief Get the number of closed transactions waiting to be taken
+ */
+size_t espsol_packer_pending(espsol_packer_handle_t packer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ESPSOL_PACK_H */
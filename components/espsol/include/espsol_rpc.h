@@ -3,8 +3,9 @@
  * @brief ESPSOL RPC Client API
  *
  * This file provides the JSON-RPC 2.0 client interface for communicating
- * with Solana RPC nodes. Uses native esp_http_client for HTTP requests
- * and cJSON for JSON parsing.
+ * with Solana RPC nodes. Requests go through a pluggable transport
+ * (esp_http_client by default) and responses are parsed in place without
+ * building a JSON tree.
  *
  * @copyright Copyright (c) 2025 SkyRizz
  * @license Apache-2.0
@@ -14,6 +15,9 @@
 #define ESPSOL_RPC_H
 
 #include "espsol_types.h"
+#include "espsol_fee.h"
+#include "espsol_transport.h"
+#include "espsol_tx.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -55,6 +59,18 @@ typedef struct {
     char error[128];                            /**< Error message if any */
 } espsol_tx_response_t;
 
+/**
+ * @brief One entry of an address's transaction history
+ */
+typedef struct {
+    char signature[ESPSOL_SIGNATURE_MAX_LEN];  /**< Transaction signature (Base58) */
+    uint64_t slot;                              /**< Slot the transaction was processed */
+    bool failed;                                /**< Transaction failed */
+    char error[128];                            /**< Error JSON if failed (may be truncated) */
+    bool has_block_time;                        /**< block_time is known */
+    int64_t block_time;                         /**< Unix timestamp of the block */
+} espsol_signature_info_t;
+
 /**
  * @brief Token account information structure
  */
@@ -76,6 +92,7 @@ typedef struct {
     size_t buffer_size;               /**< HTTP response buffer size */
     uint8_t max_retries;              /**< Max retry attempts (0 = no retry) */
     uint32_t retry_delay_ms;          /**< Initial retry delay (doubles each attempt) */
+    const espsol_rpc_transport_t *transport; /**< Custom transport (NULL = HTTP) */
 } espsol_rpc_config_t;
 
 /**
@@ -87,7 +104,8 @@ typedef struct {
     .commitment = ESPSOL_COMMITMENT_CONFIRMED, \
     .buffer_size = ESPSOL_DEFAULT_BUFFER_SIZE, \
     .max_retries = 3, \
-    .retry_delay_ms = 500 \
+    .retry_delay_ms = 500, \
+    .transport = NULL \
 }
 
 /* ============================================================================
@@ -152,6 +170,51 @@ esp_err_t espsol_rpc_set_timeout(espsol_rpc_handle_t handle, uint32_t timeout_ms
 esp_err_t espsol_rpc_set_commitment(espsol_rpc_handle_t handle, 
                                      espsol_commitment_t commitment);
 
+/**
+ * @brief Replace the transport used for requests
+ *
+ * Use this to route requests through a recorder or replay transport
+ * (see espsol_transport.h). Host builds have no default transport.
+ *
+ * @param[in] handle       RPC client handle
+ * @param[in] transport    Transport to install (NULL restores the default)
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if handle is NULL or transport has no perform function
+ */
+esp_err_t espsol_rpc_set_transport(espsol_rpc_handle_t handle,
+                                    const espsol_rpc_transport_t *transport);
+
+/**
+ * @brief Get the transport currently used for requests
+ *
+ * Typically passed as the inner transport of a recorder.
+ *
+ * @param[in]  handle      RPC client handle
+ * @param[out] transport   Pointer to receive transport
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if any argument is NULL
+ */
+esp_err_t espsol_rpc_get_transport(espsol_rpc_handle_t handle,
+                                    espsol_rpc_transport_t *transport);
+
+/**
+ * @brief Set the deadline and cancellation token applied to each call
+ *
+ * The deadline covers a whole call, including retries and backoff, and
+ * starts again with every call. A cancelled token makes calls in progress
+ * and later calls return ESP_ERR_ESPSOL_CANCELLED until it is reset.
+ *
+ * @param[in] handle   RPC client handle
+ * @param[in] options  Call options (copied; NULL restores no limits)
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if handle is NULL
+ */
+esp_err_t espsol_rpc_set_call_options(espsol_rpc_handle_t handle,
+                                       const espsol_call_options_t *options);
+
 /* ============================================================================
  * Network Information
  * ========================================================================== */
@@ -301,6 +364,27 @@ esp_err_t espsol_rpc_send_transaction(espsol_rpc_handle_t handle,
                                        const char *tx_base64,
                                        char *signature, size_t sig_len);
 
+/**
+ * @brief Send a signed transaction handle
+ *
+ * Encodes the transaction as Base64 directly into the request body, so
+ * the only copy is the request itself.
+ *
+ * @param[in]  handle      RPC client handle
+ * @param[in]  tx          Signed transaction
+ * @param[out] signature   Buffer to receive transaction signature (Base58)
+ * @param[in]  sig_len     Size of signature buffer
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if any required argument is NULL
+ *     - ESP_ERR_ESPSOL_TX_NOT_SIGNED if the transaction is not fully signed
+ *     - ESP_ERR_NO_MEM if the request cannot be allocated
+ *     - ESP_ERR_ESPSOL_BUFFER_TOO_SMALL if signature buffer too small
+ *     - ESP_ERR_ESPSOL_RPC_FAILED on network/transaction error
+ */
+esp_err_t espsol_rpc_send_tx(espsol_rpc_handle_t handle, espsol_tx_handle_t tx,
+                             char *signature, size_t sig_len);
+
 /**
  * @brief Get transaction details by signature
  *
@@ -351,6 +435,212 @@ esp_err_t espsol_rpc_get_signature_statuses(espsol_rpc_handle_t handle,
                                              size_t count,
                                              bool *confirmed);
 
+/* ============================================================================
+ * Address History
+ * ========================================================================== */
+
+/**
+ * @brief Opaque address history iterator
+ */
+typedef struct espsol_history_iter *espsol_history_iter_t;
+
+/**
+ * @brief Address history iterator configuration
+ */
+typedef struct {
+    const char *before;     /**< Start below this signature (NULL = newest) */
+    const char *until;      /**< Stop at this signature, exclusive (NULL = none) */
+    uint16_t page_size;     /**< Signatures per request (1-1000) */
+    uint32_t limit;         /**< Total signatures to return (0 = no limit) */
+    bool prefetch;          /**< Fetch the next page in a background task */
+} espsol_history_config_t;
+
+/**
+ * @brief Default history configuration (newest first, 16 per page)
+ *
+ * On a transport without streaming a page must fit the response buffer;
+ * 16 signatures fit the default 4 KB.
+ */
+#define ESPSOL_HISTORY_CONFIG_DEFAULT() { \
+    .before = NULL, \
+    .until = NULL, \
+    .page_size = 16, \
+    .limit = 0, \
+    .prefetch = false \
+}
+
+/**
+ * @brief Open an iterator over an address's signatures (getSignaturesForAddress)
+ *
+ * Entries are returned newest first, one at a time. Pages are decoded as
+ * they stream in, so only the current page's entries (plus the next
+ * page's when prefetching) are kept, never the response text; the before
+ * cursor and limit are managed internally.
+ *
+ * With prefetch enabled, pages are fetched by a background task through
+ * handle at any time until the iterator is closed. The task shares the
+ * client's buffers and last error, so handle must not be used at all in
+ * the meantime, not even by the task that opened the iterator; open it
+ * on a dedicated client.
+ *
+ * @param[in]  handle    RPC client handle
+ * @param[in]  address   Base58 address
+ * @param[in]  config    Iterator configuration (NULL for defaults)
+ * @param[out] iter      Created iterator
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if an argument is NULL or invalid
+ *     - ESP_ERR_NO_MEM if allocation fails
+ */
+esp_err_t espsol_rpc_history_open(espsol_rpc_handle_t handle,
+                                  const char *address,
+                                  const espsol_history_config_t *config,
+                                  espsol_history_iter_t *iter);
+
+/**
+ * @brief Get the next history entry
+ *
+ * Fetches the next page when the current one is used up. After an error
+ * the same call may be repeated to retry the failed page.
+ *
+ * @param[in]  iter      Iterator
+ * @param[out] info      Next entry
+ * @return
+ *     - ESP_OK if info holds an entry
+ *     - ESP_ERR_NOT_FOUND when the history is exhausted
+ *     - ESP_ERR_INVALID_ARG if an argument is NULL
+ *     - ESP_ERR_ESPSOL_BUFFER_TOO_SMALL if a page exceeds the client buffer
+ *       on a transport without streaming (reduce page_size or raise
+ *       buffer_size)
+ *     - Any RPC error from fetching a page
+ */
+esp_err_t espsol_rpc_history_next(espsol_history_iter_t iter,
+                                  espsol_signature_info_t *info);
+
+/**
+ * @brief Close an iterator and free its pages
+ *
+ * Waits for an outstanding prefetch to finish.
+ *
+ * @param[in] iter       Iterator (NULL is ignored)
+ * @return ESP_OK
+ */
+esp_err_t espsol_rpc_history_close(espsol_history_iter_t iter);
+
+/* ============================================================================
+ * Block Streaming
+ * ========================================================================== */
+
+/**
+ * @brief A transaction that matched a block filter
+ *
+ * Pointers are only valid during the callback.
+ */
+typedef struct {
+    uint64_t slot;                              /**< Slot of the block */
+    uint32_t index;                             /**< Position in the block */
+    const uint8_t *tx;                          /**< Serialized transaction */
+    size_t tx_len;                              /**< Length of tx */
+    char signature[ESPSOL_SIGNATURE_MAX_LEN];   /**< First signature (Base58) */
+    bool failed;                                /**< Transaction failed */
+    const char *error;                          /**< Error JSON if failed, else "" (may be truncated) */
+    uint8_t program;                            /**< Index of the first matching program */
+} espsol_block_tx_t;
+
+/**
+ * @brief Summary of a streamed block
+ */
+typedef struct {
+    uint64_t slot;                              /**< Slot requested */
+    bool skipped;                               /**< Slot has no block */
+    char blockhash[ESPSOL_ADDRESS_MAX_LEN];     /**< Block hash (Base58) */
+    uint64_t parent_slot;                       /**< Parent slot */
+    uint64_t block_height;                      /**< Block height */
+    bool has_block_time;                        /**< block_time is known */
+    int64_t block_time;                         /**< Unix timestamp */
+    uint32_t tx_count;                          /**< Transactions in the block */
+    uint32_t matched;                           /**< Transactions passed to the callback */
+} espsol_block_info_t;
+
+/**
+ * @brief Called for each matching transaction
+ *
+ * @return ESP_OK to continue; any other value stops the stream and is returned
+ */
+typedef esp_err_t (*espsol_block_tx_cb_t)(const espsol_block_tx_t *tx, void *user_ctx);
+
+/**
+ * @brief Called after each block of a walk, including skipped slots
+ *
+ * @return ESP_OK to continue; any other value stops the walk and is returned
+ */
+typedef esp_err_t (*espsol_block_cb_t)(const espsol_block_info_t *info, void *user_ctx);
+
+/** @brief Default bytes of matches buffered for a pipelined block */
+#define ESPSOL_BLOCK_PIPELINE_BUFFER    32768
+
+/**
+ * @brief Block filter and callbacks
+ */
+typedef struct {
+    const uint8_t (*programs)[ESPSOL_PUBKEY_SIZE];  /**< Watched program IDs */
+    size_t program_count;                           /**< Number of programs (0 = match all) */
+    espsol_block_tx_cb_t on_transaction;            /**< Matching transaction callback */
+    espsol_block_cb_t on_block;                     /**< Block summary callback (walk only, optional) */
+    void *user_ctx;                                 /**< Passed to the callbacks */
+    espsol_rpc_handle_t pipeline;                   /**< Second client for the next block (walk only) */
+    size_t pipeline_buffer;                         /**< Bytes of buffered matches for the pipelined
+                                                         block (0 = ESPSOL_BLOCK_PIPELINE_BUFFER) */
+} espsol_block_filter_t;
+
+/**
+ * @brief Stream one block (getBlock) and report matching transactions
+ *
+ * Requests full transaction details in base64 and parses the response as
+ * it arrives, so block size is not limited by the client buffer. A
+ * transaction matches when its account keys include a watched program.
+ *
+ * @param[in]  handle    RPC client handle
+ * @param[in]  slot      Slot to fetch
+ * @param[in]  filter    Filter and callbacks
+ * @param[out] info      Block summary (optional)
+ * @return
+ *     - ESP_OK on success (info->skipped is set for skipped slots)
+ *     - ESP_ERR_INVALID_ARG if handle, filter or on_transaction is NULL
+ *     - ESP_ERR_ESPSOL_RPC_FAILED on RPC error (e.g. block not available yet)
+ *     - ESP_ERR_ESPSOL_RPC_PARSE_ERROR on malformed response
+ *     - The callback's error if it stopped the stream
+ */
+esp_err_t espsol_rpc_get_block_stream(espsol_rpc_handle_t handle,
+                                      uint64_t slot,
+                                      const espsol_block_filter_t *filter,
+                                      espsol_block_info_t *info);
+
+/**
+ * @brief Stream consecutive blocks
+ *
+ * Blocks are delivered in slot order. When filter->pipeline is set, the
+ * next block is requested on that client by a background task while the
+ * current one streams; its matches are buffered and delivered after the
+ * current block. If they outgrow filter->pipeline_buffer bytes (each
+ * match counts its transaction plus a few hundred bytes), the background
+ * fetch stops and the block is streamed again on handle once the current
+ * one is delivered, so memory stays bounded at the cost of one request.
+ *
+ * @param[in]  handle      RPC client handle
+ * @param[in]  start_slot  First slot
+ * @param[in]  count       Number of slots to walk
+ * @param[in]  filter      Filter and callbacks
+ * @param[out] next_slot   First slot not fully delivered (optional);
+ *                         start_slot + count on success
+ * @return Same as espsol_rpc_get_block_stream(), plus on_block's error
+ */
+esp_err_t espsol_rpc_walk_blocks(espsol_rpc_handle_t handle,
+                                 uint64_t start_slot,
+                                 uint32_t count,
+                                 const espsol_block_filter_t *filter,
+                                 uint64_t *next_slot);
+
 /* ============================================================================
  * Airdrop (devnet/testnet only)
  * ========================================================================== */
@@ -476,6 +766,24 @@ esp_err_t espsol_rpc_get_minimum_balance_for_rent_exemption(
     size_t data_len,
     uint64_t *lamports);
 
+/**
+ * @brief Get the Rent sysvar parameters
+ *
+ * Fetches and decodes the Rent sysvar on first use and caches it in the
+ * client; later calls return the cached value without a network request.
+ * Pass the result to espsol_rent_minimum_balance() to compute rent-exempt
+ * balances for any account size locally.
+ *
+ * @param[in]  handle      RPC client handle
+ * @param[out] rent        Pointer to receive rent parameters
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if handle or rent is NULL
+ *     - ESP_ERR_ESPSOL_RPC_PARSE_ERROR if the sysvar data is malformed
+ *     - ESP_ERR_ESPSOL_RPC_FAILED on network error
+ */
+esp_err_t espsol_rpc_get_rent(espsol_rpc_handle_t handle, espsol_rent_t *rent);
+
 #ifdef __cplusplus
 }
 #endif
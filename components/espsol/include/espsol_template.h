@@ -0,0 +1,221 @@
+/**
+ * @file espsol_template.h
+ * @brief ESPSOL Patchable Transaction Templates
+ *
+ * A template is a sealed transaction frozen into wire format. Selected
+ * byte ranges (amounts, account keys, the blockhash) can be patched in
+ * place and the message re-signed, without recompiling accounts or
+ * touching the heap. The template is laid out exactly as sent, so
+ * serialization is free.
+ *
+ * @copyright Copyright (c) 2025 SkyRizz
+ * @license Apache-2.0
+ */
+
+#ifndef ESPSOL_TEMPLATE_H
+#define ESPSOL_TEMPLATE_H
+
+#include "espsol_types.h"
+#include "espsol_tx.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ============================================================================
+ * Template Types
+ * ========================================================================== */
+
+/** @brief Maximum number of patchable slots per template */
+#define ESPSOL_TX_TEMPLATE_MAX_SLOTS    8
+
+/**
+ * @brief Kind of a template slot
+ */
+typedef enum {
+    ESPSOL_TX_SLOT_DATA = 0,    /**< Bytes of instruction data */
+    ESPSOL_TX_SLOT_KEY,         /**< A static account key */
+} espsol_tx_slot_kind_t;
+
+/**
+ * @brief Patchable byte range of the message
+ */
+typedef struct {
+    uint16_t offset;                /**< Offset within the message */
+    uint8_t size;                   /**< Size in bytes */
+    uint8_t kind;                   /**< espsol_tx_slot_kind_t */
+} espsol_tx_slot_t;
+
+/**
+ * @brief Transaction template
+ *
+ * Holds the signature section followed by the message, exactly as sent.
+ * Treat the fields as private.
+ */
+typedef struct {
+    uint8_t wire[ESPSOL_MAX_TX_SIZE];   /**< Signatures, then the message */
+    size_t wire_len;                    /**< Total transaction length */
+    size_t message_offset;              /**< Offset of the message in wire */
+    size_t message_len;                 /**< Message length */
+    size_t signer_count;                /**< Required signatures */
+    size_t key_count;                   /**< Static account keys */
+    size_t keys_offset;                 /**< Offset of the first key in the message */
+    size_t blockhash_offset;            /**< Offset of the blockhash in the message */
+    uint32_t signed_mask;               /**< Bit per signature slot holding a valid signature */
+    espsol_tx_slot_t slots[ESPSOL_TX_TEMPLATE_MAX_SLOTS];
+    size_t slot_count;
+} espsol_tx_template_t;
+
+/* ============================================================================
+ * Template Creation
+ * ========================================================================== */
+
+/**
+ * @brief Create a template from a transaction
+ *
+ * Seals the transaction and copies its message. The transaction can be
+ * destroyed afterwards. The blockhash is always patchable.
+ *
+ * @param[out] tpl   Template to initialize
+ * @param[in]  tx    Transaction with fee payer, blockhash and instructions
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if tpl or tx is NULL
+ *     - Errors from espsol_tx_seal()
+ */
+esp_err_t espsol_tx_template_init(espsol_tx_template_t *tpl, espsol_tx_handle_t tx);
+
+/**
+ * @brief Mark instruction data bytes as patchable
+ *
+ * @param[in]  tpl          Template
+ * @param[in]  instruction  Instruction index
+ * @param[in]  offset       Offset within the instruction data
+ * @param[in]  size         Number of bytes (1 to 32)
+ * @param[out] slot         Receives the slot index
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if an argument is NULL or the range is outside the data
+ *     - ESP_ERR_ESPSOL_BUFFER_TOO_SMALL if all slots are in use
+ *
+ * @code
+ * // Lamports of a System transfer: u64 after the 4-byte instruction tag
+ * size_t amount_slot;
+ * espsol_tx_template_add_data_slot(&tpl, 0, 4, 8, &amount_slot);
+ * @endcode
+ */
+esp_err_t espsol_tx_template_add_data_slot(espsol_tx_template_t *tpl,
+                                            size_t instruction,
+                                            size_t offset, size_t size,
+                                            size_t *slot);
+
+/**
+ * @brief Mark a static account key as patchable
+ *
+ * Signer keys cannot be patched since their signature slots depend on
+ * them.
+ *
+ * @param[in]  tpl      Template
+ * @param[in]  pubkey   Key as it appears in the template
+ * @param[out] slot     Receives the slot index
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if an argument is NULL or the key is a signer
+ *     - ESP_ERR_NOT_FOUND if the key is not a static account key
+ *     - ESP_ERR_ESPSOL_BUFFER_TOO_SMALL if all slots are in use
+ */
+esp_err_t espsol_tx_template_add_key_slot(espsol_tx_template_t *tpl,
+                                           const uint8_t pubkey[ESPSOL_PUBKEY_SIZE],
+                                           size_t *slot);
+
+/* ============================================================================
+ * Patching
+ * ========================================================================== */
+
+/**
+ * @brief Patch a slot with raw bytes
+ *
+ * Patching invalidates all signatures.
+ *
+ * @param[in] tpl    Template
+ * @param[in] slot   Slot index
+ * @param[in] data   New bytes
+ * @param[in] len    Must equal the slot size
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if an argument is invalid, or a key slot would
+ *       duplicate another account key
+ */
+esp_err_t espsol_tx_template_set_bytes(espsol_tx_template_t *tpl, size_t slot,
+                                        const uint8_t *data, size_t len);
+
+/**
+ * @brief Patch an 8-byte slot with a little-endian u64 (e.g. lamports)
+ */
+esp_err_t espsol_tx_template_set_u64(espsol_tx_template_t *tpl, size_t slot, uint64_t value);
+
+/**
+ * @brief Patch a 32-byte slot with a public key (e.g. the recipient)
+ */
+esp_err_t espsol_tx_template_set_pubkey(espsol_tx_template_t *tpl, size_t slot,
+                                         const uint8_t pubkey[ESPSOL_PUBKEY_SIZE]);
+
+/**
+ * @brief Replace the recent blockhash
+ */
+esp_err_t espsol_tx_template_set_blockhash(espsol_tx_template_t *tpl,
+                                            const uint8_t blockhash[ESPSOL_BLOCKHASH_SIZE]);
+
+/* ============================================================================
+ * Signing and Output
+ * ========================================================================== */
+
+/**
+ * @brief Sign the template message
+ *
+ * @param[in] tpl        Template
+ * @param[in] keypair    Keypair of one of the required signers
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if an argument is NULL
+ *     - ESP_ERR_ESPSOL_TX_BUILD_ERROR if the keypair is not a required signer
+ *     - ESP_ERR_ESPSOL_CRYPTO_ERROR if signing fails
+ */
+esp_err_t espsol_tx_template_sign(espsol_tx_template_t *tpl, const espsol_keypair_t *keypair);
+
+/**
+ * @brief Check whether every required signature is present
+ */
+bool espsol_tx_template_is_signed(const espsol_tx_template_t *tpl);
+
+/**
+ * @brief Get the signed transaction in wire format
+ *
+ * @param[in]  tpl    Template
+ * @param[out] data   Receives a pointer into the template
+ * @param[out] len    Receives the transaction length
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if an argument is NULL
+ *     - ESP_ERR_ESPSOL_TX_NOT_SIGNED if a signature is missing
+ */
+esp_err_t espsol_tx_template_get_transaction(const espsol_tx_template_t *tpl,
+                                              const uint8_t **data, size_t *len);
+
+/**
+ * @brief Encode the signed transaction as Base64 for RPC submission
+ *
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if an argument is NULL
+ *     - ESP_ERR_ESPSOL_TX_NOT_SIGNED if a signature is missing
+ *     - ESP_ERR_ESPSOL_BUFFER_TOO_SMALL if output is too small
+ */
+esp_err_t espsol_tx_template_to_base64(const espsol_tx_template_t *tpl,
+                                        char *output, size_t output_len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ESPSOL_TEMPLATE_H */
@@ -35,6 +35,12 @@ extern "C" {
 /** @brief Token decimals for native SOL wrapped token */
 #define ESPSOL_WSOL_DECIMALS        9
 
+/** @brief Maximum seed length for PDAs and seed-derived addresses (bytes) */
+#define ESPSOL_MAX_SEED_LEN         32
+
+/** @brief Maximum seeds of a PDA, the bump seed included */
+#define ESPSOL_MAX_SEEDS            16
+
 /* ============================================================================
  * SPL Token Instructions
  * ========================================================================== */
@@ -84,20 +90,46 @@ esp_err_t espsol_token_get_ata_address(
     const uint8_t mint[ESPSOL_PUBKEY_SIZE],
     uint8_t ata_address[ESPSOL_PUBKEY_SIZE]);
 
+/**
+ * @brief Derive the ATA addresses of many (wallet, mint) pairs
+ *
+ * Pairs are split among up to CONFIG_ESPSOL_PDA_WORKERS threads, the
+ * caller included, once there are enough of them to be worth a thread.
+ * Use it to prepare the recipients of an airdrop list.
+ *
+ * @param[in]  wallets        count wallet owner public keys
+ * @param[in]  mints          count token mint public keys
+ * @param[in]  count          Number of pairs
+ * @param[out] ata_addresses  count ATA addresses, in pair order
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if an array is NULL
+ *     - ESP_ERR_ESPSOL_CRYPTO_ERROR if a derivation fails (the other
+ *       addresses are still written)
+ */
+esp_err_t espsol_token_get_ata_addresses_batch(
+    const uint8_t (*wallets)[ESPSOL_PUBKEY_SIZE],
+    const uint8_t (*mints)[ESPSOL_PUBKEY_SIZE],
+    size_t count,
+    uint8_t (*ata_addresses)[ESPSOL_PUBKEY_SIZE]);
+
 /**
  * @brief Derive a Program Derived Address (PDA)
  *
- * General-purpose PDA derivation for any program.
+ * General-purpose PDA derivation for any program. The seeds are hashed
+ * once; bump candidates continue from that state, several at a time
+ * where the host can hash them in parallel.
  *
  * @param[in]  seeds        Array of seed buffers
- * @param[in]  seed_lens    Array of seed lengths
- * @param[in]  seed_count   Number of seeds
+ * @param[in]  seed_lens    Array of seed lengths, each at most ESPSOL_MAX_SEED_LEN
+ * @param[in]  seed_count   Number of seeds, below ESPSOL_MAX_SEEDS (the bump is one more)
  * @param[in]  program_id   Program ID (32 bytes)
  * @param[out] pda          Output buffer for PDA address (32 bytes)
  * @param[out] bump         Output bump seed (can be NULL if not needed)
  * @return
  *     - ESP_OK on success
- *     - ESP_ERR_INVALID_ARG if required arguments are NULL
+ *     - ESP_ERR_INVALID_ARG if required arguments are NULL, a seed is longer
+ *       than ESPSOL_MAX_SEED_LEN or there are too many seeds
  *     - ESP_ERR_ESPSOL_CRYPTO_ERROR if PDA derivation fails
  */
 esp_err_t espsol_token_find_pda(
@@ -108,6 +140,27 @@ esp_err_t espsol_token_find_pda(
     uint8_t pda[ESPSOL_PUBKEY_SIZE],
     uint8_t *bump);
 
+/**
+ * @brief Derive an address from a base key, a seed and an owner program
+ *
+ * The address is SHA-256(base || seed || owner), as used by the System
+ * Program's createAccountWithSeed. It needs no bump and may be on the curve.
+ *
+ * @param[in]  base       Base public key (signs for the account)
+ * @param[in]  seed       Seed string, at most ESPSOL_MAX_SEED_LEN bytes
+ * @param[in]  owner      Program that will own the account
+ * @param[out] address    Derived address (32 bytes)
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if an argument is NULL, the seed is too long
+ *       or owner ends with the PDA marker "ProgramDerivedAddress"
+ */
+esp_err_t espsol_token_create_with_seed(
+    const uint8_t base[ESPSOL_PUBKEY_SIZE],
+    const char *seed,
+    const uint8_t owner[ESPSOL_PUBKEY_SIZE],
+    uint8_t address[ESPSOL_PUBKEY_SIZE]);
+
 /* ============================================================================
  * Transaction Building - Token Instructions
  * ========================================================================== */
@@ -291,7 +344,9 @@ esp_err_t espsol_tx_add_token_sync_native(
  * @brief Check if a public key is on the Ed25519 curve
  *
  * PDAs are not on the curve. This can be used to verify if an address
- * is a regular pubkey or a PDA.
+ * is a regular pubkey or a PDA. Follows the runtime's rule: the key is on
+ * the curve if it decompresses to a point, so small-order points (the
+ * all-zero key among them) and non-canonical encodings are on the curve.
  *
  * @param[in] pubkey     Public key to check (32 bytes)
  * @return true if on curve (regular pubkey), false if off curve (PDA)
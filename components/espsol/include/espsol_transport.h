@@ -0,0 +1,252 @@
+/**
+ * @file espsol_transport.h
+ * @brief ESPSOL RPC Transport API
+ *
+ * The RPC client sends each JSON-RPC request through a transport. On
+ * ESP32 the default transport is esp_http_client; custom transports can
+ * be installed with espsol_rpc_set_transport().
+ *
+ * Two transports are provided for deterministic testing and benchmarks:
+ * - Recorder: wraps another transport and writes every exchange, with
+ *   its latency, to a compact binary file.
+ * - Replay: serves recorded exchanges back by request matching, with
+ *   optional latency injection. Works in host builds without network.
+ *
+ * @copyright Copyright (c) 2025 SkyRizz
+ * @license Apache-2.0
+ */
+
+#ifndef ESPSOL_TRANSPORT_H
+#define ESPSOL_TRANSPORT_H
+
+#include "espsol_types.h"
+#include "espsol_cancel.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ============================================================================
+ * Transport Interface
+ * ========================================================================== */
+
+/**
+ * @brief Perform one request/response exchange
+ *
+ * @param[in]  ctx           Transport context
+ * @param[in]  request       JSON-RPC request body
+ * @param[in]  request_len   Length of request body
+ * @param[out] response      Buffer for response body (not NUL-terminated)
+ * @param[in]  response_cap  Capacity of response buffer
+ * @param[out] response_len  Number of response bytes written
+ * @param[out] status_code   HTTP status code (200 on success)
+ * @param[in]  deadline      Deadline of the calling API function; blocking
+ *                           waits must end when espsol_deadline_check() fails
+ * @return
+ *     - ESP_OK if a response was received (check status_code)
+ *     - ESP_ERR_ESPSOL_BUFFER_TOO_SMALL if the response does not fit
+ *     - ESP_ERR_ESPSOL_NETWORK_ERROR on connection failure (retried)
+ *     - ESP_ERR_ESPSOL_TIMEOUT or ESP_ERR_ESPSOL_CANCELLED from the deadline
+ *     - Any other error aborts the request without retry
+ */
+typedef esp_err_t (*espsol_rpc_perform_fn)(void *ctx,
+                                           const char *request, size_t request_len,
+                                           char *response, size_t response_cap,
+                                           size_t *response_len,
+                                           int *status_code,
+                                           const espsol_deadline_t *deadline);
+
+/**
+ * @brief Receive one chunk of a streamed response body
+ *
+ * @param[in] sink_ctx     Sink context
+ * @param[in] status_code  HTTP status code of the response
+ * @param[in] data         Chunk data
+ * @param[in] len          Chunk length
+ * @return ESP_OK to continue; any other value aborts the exchange and is
+ *         returned by the transport
+ */
+typedef esp_err_t (*espsol_rpc_sink_fn)(void *sink_ctx, int status_code,
+                                        const char *data, size_t len);
+
+/**
+ * @brief Perform one exchange, streaming the response body to a sink
+ *
+ * Used for responses too large for the client buffer (e.g. getBlock).
+ *
+ * @param[in]  ctx           Transport context
+ * @param[in]  request       JSON-RPC request body
+ * @param[in]  request_len   Length of request body
+ * @param[in]  sink          Receives the response body in order
+ * @param[in]  sink_ctx      Context passed to sink
+ * @param[out] status_code   HTTP status code (200 on success)
+ * @param[in]  deadline      Deadline of the calling API function
+ * @return Same as espsol_rpc_perform_fn, or the sink's error
+ */
+typedef esp_err_t (*espsol_rpc_perform_stream_fn)(void *ctx,
+                                                  const char *request, size_t request_len,
+                                                  espsol_rpc_sink_fn sink, void *sink_ctx,
+                                                  int *status_code,
+                                                  const espsol_deadline_t *deadline);
+
+/**
+ * @brief RPC transport
+ */
+typedef struct {
+    espsol_rpc_perform_fn perform;                  /**< Exchange function */
+    espsol_rpc_perform_stream_fn perform_stream;    /**< Streaming exchange (NULL = use perform) */
+    void *ctx;                                      /**< Context passed to perform */
+} espsol_rpc_transport_t;
+
+/* ============================================================================
+ * Recorder Transport
+ * ========================================================================== */
+
+/**
+ * @brief Opaque handle for a recording transport
+ */
+typedef struct espsol_rpc_recorder *espsol_rpc_recorder_handle_t;
+
+/**
+ * @brief Create a recorder that wraps another transport
+ *
+ * Every exchange performed through the recorder is forwarded to inner and
+ * appended to the file at path (created or truncated), including failed
+ * exchanges so retry behavior can be replayed.
+ *
+ * @param[in]  path      Output file path
+ * @param[in]  inner     Transport that performs the real exchange
+ * @param[out] recorder  Pointer to receive recorder handle
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if any argument is NULL
+ *     - ESP_ERR_NO_MEM if memory allocation fails
+ *     - ESP_FAIL if the file cannot be opened
+ */
+esp_err_t espsol_rpc_recorder_create(const char *path,
+                                      const espsol_rpc_transport_t *inner,
+                                      espsol_rpc_recorder_handle_t *recorder);
+
+/**
+ * @brief Get the transport to install with espsol_rpc_set_transport()
+ *
+ * @param[in]  recorder   Recorder handle
+ * @param[out] transport  Pointer to receive transport
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if any argument is NULL
+ */
+esp_err_t espsol_rpc_recorder_get_transport(espsol_rpc_recorder_handle_t recorder,
+                                             espsol_rpc_transport_t *transport);
+
+/**
+ * @brief Get the number of exchanges recorded so far
+ *
+ * @param[in]  recorder   Recorder handle
+ * @param[out] count      Pointer to receive count
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if any argument is NULL
+ */
+esp_err_t espsol_rpc_recorder_get_count(espsol_rpc_recorder_handle_t recorder,
+                                         size_t *count);
+
+/**
+ * @brief Flush and close the recording
+ *
+ * @param[in] recorder   Recorder handle
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if recorder is NULL
+ *     - ESP_FAIL if writing the file failed
+ */
+esp_err_t espsol_rpc_recorder_destroy(espsol_rpc_recorder_handle_t recorder);
+
+/* ============================================================================
+ * Replay Transport
+ * ========================================================================== */
+
+/**
+ * @brief Opaque handle for a replay transport
+ */
+typedef struct espsol_rpc_replay *espsol_rpc_replay_handle_t;
+
+/**
+ * @brief Replay configuration
+ */
+typedef struct {
+    uint16_t latency_percent;   /**< Recorded latency to inject, in percent (0 = none) */
+    uint32_t added_latency_ms;  /**< Fixed latency added to every exchange */
+    bool strict_order;          /**< Require requests in recorded order */
+} espsol_rpc_replay_config_t;
+
+/**
+ * @brief Default replay configuration (no delay, match in any order)
+ */
+#define ESPSOL_RPC_REPLAY_CONFIG_DEFAULT() { \
+    .latency_percent = 0, \
+    .added_latency_ms = 0, \
+    .strict_order = false \
+}
+
+/**
+ * @brief Load a recording for replay
+ *
+ * Requests are matched on their body with the JSON-RPC "id" member
+ * ignored. Each recorded exchange is served once; identical requests are
+ * served in recorded order.
+ *
+ * @param[in]  path     Recording file path
+ * @param[in]  config   Replay configuration (NULL for defaults)
+ * @param[out] replay   Pointer to receive replay handle
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if path or replay is NULL
+ *     - ESP_ERR_NO_MEM if memory allocation fails
+ *     - ESP_FAIL if the file cannot be read or is malformed
+ */
+esp_err_t espsol_rpc_replay_create(const char *path,
+                                    const espsol_rpc_replay_config_t *config,
+                                    espsol_rpc_replay_handle_t *replay);
+
+/**
+ * @brief Get the transport to install with espsol_rpc_set_transport()
+ *
+ * Requests with no matching exchange fail with ESP_ERR_ESPSOL_RPC_FAILED.
+ *
+ * @param[in]  replay     Replay handle
+ * @param[out] transport  Pointer to receive transport
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if any argument is NULL
+ */
+esp_err_t espsol_rpc_replay_get_transport(espsol_rpc_replay_handle_t replay,
+                                           espsol_rpc_transport_t *transport);
+
+/**
+ * @brief Get the number of exchanges not yet served
+ *
+ * @param[in]  replay     Replay handle
+ * @param[out] count      Pointer to receive count
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if any argument is NULL
+ */
+esp_err_t espsol_rpc_replay_get_remaining(espsol_rpc_replay_handle_t replay,
+                                           size_t *count);
+
+/**
+ * @brief Free a replay transport
+ *
+ * @param[in] replay     Replay handle
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if replay is NULL
+ */
+esp_err_t espsol_rpc_replay_destroy(espsol_rpc_replay_handle_t replay);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ESPSOL_TRANSPORT_H */
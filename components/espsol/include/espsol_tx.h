@@ -15,6 +15,7 @@
 
 #include "espsol_types.h"
 #include "espsol_crypto.h"
+#include "espsol_utils.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -36,6 +37,15 @@ extern const uint8_t ESPSOL_ASSOCIATED_TOKEN_PROGRAM_ID[ESPSOL_PUBKEY_SIZE];
 /** @brief Memo Program ID (MemoSq4gqABAXKb96qnH8TysNcWxMyWCqXgDLGmfcHr) */
 extern const uint8_t ESPSOL_MEMO_PROGRAM_ID[ESPSOL_PUBKEY_SIZE];
 
+/** @brief Compute Budget Program ID (ComputeBudget111111111111111111111111111111) */
+extern const uint8_t ESPSOL_COMPUTE_BUDGET_PROGRAM_ID[ESPSOL_PUBKEY_SIZE];
+
+/** @brief RecentBlockhashes sysvar ID (SysvarRecentB1ockHashes11111111111111111111) */
+extern const uint8_t ESPSOL_RECENT_BLOCKHASHES_SYSVAR_ID[ESPSOL_PUBKEY_SIZE];
+
+/** @brief Rent sysvar ID (SysvarRent111111111111111111111111111111111) */
+extern const uint8_t ESPSOL_RENT_SYSVAR_ID[ESPSOL_PUBKEY_SIZE];
+
 /* ============================================================================
  * Transaction Handle
  * ========================================================================== */
@@ -58,10 +68,43 @@ typedef struct {
     bool is_writable;                     /**< Whether account is writable */
 } espsol_account_meta_t;
 
+/* ============================================================================
+ * Versioned Transactions
+ * ========================================================================== */
+
+/**
+ * @brief Transaction message format
+ */
+typedef enum {
+    ESPSOL_TX_VERSION_LEGACY = 0,   /**< Legacy message (default) */
+    ESPSOL_TX_VERSION_0,            /**< Version 0 message with address lookup tables */
+} espsol_tx_version_t;
+
+/**
+ * @brief Address lookup table contents
+ *
+ * The addresses are not copied and must stay valid until the transaction
+ * has been signed and serialized.
+ */
+typedef struct {
+    uint8_t key[ESPSOL_PUBKEY_SIZE];                /**< Lookup table account address */
+    const uint8_t (*addresses)[ESPSOL_PUBKEY_SIZE]; /**< Addresses stored in the table */
+    size_t address_count;                           /**< Number of addresses (max 256) */
+} espsol_lookup_table_t;
+
 /* ============================================================================
  * Transaction Lifecycle
  * ========================================================================== */
 
+/**
+ * @brief Suggested buffer size for espsol_tx_init_static()
+ *
+ * Holds a handful of instructions over about ten accounts, such as a
+ * transfer with a memo and Compute Budget instructions, together with
+ * the sealed message and signatures.
+ */
+#define ESPSOL_TX_STATIC_SIZE   1536
+
 /**
  * @brief Create a new transaction
  *
@@ -73,6 +116,24 @@ typedef struct {
  */
 esp_err_t espsol_tx_create(espsol_tx_handle_t *tx);
 
+/**
+ * @brief Create a transaction inside a caller-provided buffer
+ *
+ * The handle, instructions, account keys and signatures all live in the
+ * buffer, so building and signing never allocates. Operations that need
+ * more room than the buffer has left fail with ESP_ERR_NO_MEM. The buffer
+ * must outlive the handle; espsol_tx_destroy() releases nothing.
+ *
+ * @param[in]  buffer   Storage for the transaction (stack or static)
+ * @param[in]  size     Size of buffer in bytes (see ESPSOL_TX_STATIC_SIZE)
+ * @param[out] tx       Pointer to receive transaction handle
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if buffer or tx is NULL
+ *     - ESP_ERR_ESPSOL_BUFFER_TOO_SMALL if buffer cannot hold a transaction
+ */
+esp_err_t espsol_tx_init_static(void *buffer, size_t size, espsol_tx_handle_t *tx);
+
 /**
  * @brief Destroy a transaction and free resources
  *
@@ -129,6 +190,78 @@ esp_err_t espsol_tx_set_fee_payer(espsol_tx_handle_t tx,
 esp_err_t espsol_tx_set_recent_blockhash(espsol_tx_handle_t tx,
                                           const uint8_t blockhash[ESPSOL_BLOCKHASH_SIZE]);
 
+/**
+ * @brief Use a durable nonce instead of a recent blockhash
+ *
+ * Sets the nonce as the recent blockhash and makes AdvanceNonceAccount
+ * instruction 0, ahead of any Compute Budget instructions. Instructions
+ * added later go after it. A transaction signed this way stays valid
+ * until the nonce is advanced, so it can be signed offline well in
+ * advance. Call again with the same account and authority to move to a
+ * new nonce value. Requires CONFIG_ESPSOL_ENABLE_DURABLE_NONCES on ESP-IDF.
+ *
+ * @param[in] tx             Transaction handle
+ * @param[in] nonce_account  Initialized nonce account
+ * @param[in] authority      Nonce authority (must sign)
+ * @param[in] nonce          Current nonce value (see espsol_nonce_decode())
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if an argument is NULL, or a different nonce
+ *       account or authority is already set
+ *     - ESP_ERR_NOT_SUPPORTED if durable nonces are disabled
+ *     - Errors from espsol_tx_add_instruction() when the advance is added
+ */
+esp_err_t espsol_tx_set_durable_nonce(espsol_tx_handle_t tx,
+                                      const uint8_t nonce_account[ESPSOL_PUBKEY_SIZE],
+                                      const uint8_t authority[ESPSOL_PUBKEY_SIZE],
+                                      const uint8_t nonce[ESPSOL_BLOCKHASH_SIZE]);
+
+/**
+ * @brief Select the message format
+ *
+ * Version 0 messages can load accounts from address lookup tables, which
+ * replaces each 32-byte key with a 1-byte index. Requires
+ * CONFIG_ESPSOL_ENABLE_VERSIONED_TX on ESP-IDF.
+ *
+ * @param[in] tx         Transaction handle
+ * @param[in] version    Message version
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if tx is NULL or version is unknown
+ *     - ESP_ERR_NOT_SUPPORTED if versioned transactions are disabled
+ */
+esp_err_t espsol_tx_set_version(espsol_tx_handle_t tx, espsol_tx_version_t version);
+
+/**
+ * @brief Get the message format
+ *
+ * @param[in]  tx        Transaction handle
+ * @param[out] version   Message version
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if tx or version is NULL
+ */
+esp_err_t espsol_tx_get_version(espsol_tx_handle_t tx, espsol_tx_version_t *version);
+
+/**
+ * @brief Make an address lookup table available to the transaction
+ *
+ * Switches the transaction to a version 0 message. When the message is
+ * compiled, accounts that are neither signers nor invoked programs are
+ * loaded from the first table that contains them; all other accounts
+ * stay in the message. Tables that end up unused are left out.
+ *
+ * @param[in] tx         Transaction handle
+ * @param[in] table      Table address and contents
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if tx or table is NULL, or the table has more than 256 addresses
+ *     - ESP_ERR_NOT_SUPPORTED if versioned transactions are disabled
+ *     - ESP_ERR_ESPSOL_MAX_ACCOUNTS if ESPSOL_MAX_LOOKUP_TABLES tables were already added
+ */
+esp_err_t espsol_tx_add_lookup_table(espsol_tx_handle_t tx,
+                                      const espsol_lookup_table_t *table);
+
 /* ============================================================================
  * Built-in Instructions (System Program)
  * ========================================================================== */
@@ -184,6 +317,9 @@ esp_err_t espsol_tx_add_create_account(espsol_tx_handle_t tx,
  * @brief Add a custom instruction
  *
  * For advanced users who need to interact with programs beyond System Program.
+ * Accounts are stored once per transaction and the data is copied, so the
+ * only limits are ESPSOL_MAX_LOADED_ACCOUNTS distinct keys and the
+ * ESPSOL_MAX_TX_SIZE wire size.
  *
  * @param[in] tx             Transaction handle
  * @param[in] program_id     Program to invoke
@@ -196,6 +332,8 @@ esp_err_t espsol_tx_add_create_account(espsol_tx_handle_t tx,
  *     - ESP_ERR_INVALID_ARG if required arguments are NULL
  *     - ESP_ERR_ESPSOL_MAX_INSTRUCTIONS if instruction limit reached
  *     - ESP_ERR_ESPSOL_MAX_ACCOUNTS if account limit reached
+ *     - ESP_ERR_ESPSOL_BUFFER_TOO_SMALL if the instructions exceed the wire size
+ *     - ESP_ERR_NO_MEM if the transaction storage cannot grow
  */
 esp_err_t espsol_tx_add_instruction(espsol_tx_handle_t tx,
                                      const uint8_t program_id[ESPSOL_PUBKEY_SIZE],
@@ -215,13 +353,122 @@ esp_err_t espsol_tx_add_instruction(espsol_tx_handle_t tx,
  *     - ESP_OK on success
  *     - ESP_ERR_INVALID_ARG if tx or memo is NULL
  *     - ESP_ERR_ESPSOL_MAX_INSTRUCTIONS if instruction limit reached
+ *     - ESP_ERR_ESPSOL_BUFFER_TOO_SMALL if the memo exceeds ESPSOL_MAX_INSTRUCTION_DATA
  */
 esp_err_t espsol_tx_add_memo(espsol_tx_handle_t tx, const char *memo);
 
+/* ============================================================================
+ * Compute Budget
+ * ========================================================================== */
+
+/** @brief Smallest heap frame that can be requested (bytes) */
+#define ESPSOL_MIN_HEAP_FRAME_BYTES     (32 * 1024)
+
+/** @brief Largest heap frame that can be requested (bytes) */
+#define ESPSOL_MAX_HEAP_FRAME_BYTES     (256 * 1024)
+
+/**
+ * @brief Set the compute unit limit (SetComputeUnitLimit)
+ *
+ * Compute Budget instructions are kept at the front of the message, one
+ * per kind: setting a value again updates the existing instruction, so
+ * the budget can be changed at any time, e.g. from a fresh fee estimate.
+ * Changing it drops the signatures.
+ *
+ * @param[in] tx     Transaction handle
+ * @param[in] units  Compute units for the whole transaction
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if tx is NULL
+ *     - Errors from espsol_tx_add_instruction() when the instruction is new
+ */
+esp_err_t espsol_tx_set_compute_unit_limit(espsol_tx_handle_t tx, uint32_t units);
+
+/**
+ * @brief Set the compute unit price (SetComputeUnitPrice)
+ *
+ * The priority fee is price * limit / 1,000,000 lamports. New
+ * transactions start with CONFIG_ESPSOL_DEFAULT_PRIORITY_FEE when it is
+ * non-zero; this overrides it.
+ *
+ * @param[in] tx              Transaction handle
+ * @param[in] micro_lamports  Price per compute unit in micro-lamports
+ * @return Same as espsol_tx_set_compute_unit_limit()
+ */
+esp_err_t espsol_tx_set_compute_unit_price(espsol_tx_handle_t tx, uint64_t micro_lamports);
+
+/**
+ * @brief Request a larger program heap (RequestHeapFrame)
+ *
+ * @param[in] tx     Transaction handle
+ * @param[in] bytes  Heap size, a multiple of 1024 between
+ *                   ESPSOL_MIN_HEAP_FRAME_BYTES and ESPSOL_MAX_HEAP_FRAME_BYTES
+ * @return Same as espsol_tx_set_compute_unit_limit()
+ */
+esp_err_t espsol_tx_set_heap_frame(espsol_tx_handle_t tx, uint32_t bytes);
+
+/**
+ * @brief Limit the account data the transaction may load (SetLoadedAccountsDataSizeLimit)
+ *
+ * A tighter limit lowers the cost the scheduler assigns to the transaction.
+ *
+ * @param[in] tx     Transaction handle
+ * @param[in] bytes  Maximum loaded account data in bytes (non-zero)
+ * @return Same as espsol_tx_set_compute_unit_limit()
+ */
+esp_err_t espsol_tx_set_loaded_accounts_data_limit(espsol_tx_handle_t tx, uint32_t bytes);
+
+/**
+ * @brief Remove every Compute Budget instruction, including the default price
+ *
+ * @param[in] tx     Transaction handle
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if tx is NULL
+ */
+esp_err_t espsol_tx_clear_compute_budget(espsol_tx_handle_t tx);
+
 /* ============================================================================
  * Signing
  * ========================================================================== */
 
+/**
+ * @brief Seal the transaction message
+ *
+ * Compiles the accounts and serializes the message once, keeping the
+ * bytes with the transaction. Signing and serialization reuse them, so
+ * any number of signers costs a single message serialization. Any later
+ * change to the transaction drops the seal and its signatures. Signing
+ * seals the transaction implicitly.
+ *
+ * @param[in] tx     Transaction handle
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if tx is NULL
+ *     - ESP_ERR_ESPSOL_TX_BUILD_ERROR if transaction not properly configured
+ *     - ESP_ERR_ESPSOL_MAX_ACCOUNTS if the message has too many accounts
+ *     - ESP_ERR_NO_MEM if the message does not fit in a static transaction
+ */
+esp_err_t espsol_tx_seal(espsol_tx_handle_t tx);
+
+/**
+ * @brief Get the sealed message bytes
+ *
+ * Seals the transaction if needed. The message is what each signer
+ * signs, e.g. with an external signer followed by signature injection.
+ * The pointer stays valid until the transaction is modified.
+ *
+ * @param[in]  tx           Transaction handle
+ * @param[out] message      Receives a pointer to the message
+ * @param[out] message_len  Receives the message length
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if any argument is NULL
+ *     - Errors from espsol_tx_seal()
+ */
+esp_err_t espsol_tx_get_message(espsol_tx_handle_t tx,
+                                 const uint8_t **message, size_t *message_len);
+
 /**
  * @brief Sign the transaction with a keypair
  *
@@ -256,6 +503,44 @@ esp_err_t espsol_tx_sign_multiple(espsol_tx_handle_t tx,
                                    const espsol_keypair_t **keypairs,
                                    size_t count);
 
+/**
+ * @brief Add a signature made elsewhere
+ *
+ * Places a detached signature, e.g. from a backend or a hardware signer
+ * working on espsol_tx_get_message(), in the slot of its signer. The
+ * signature is verified against the sealed message first.
+ *
+ * @param[in] tx         Transaction handle
+ * @param[in] pubkey     Signer public key
+ * @param[in] signature  Signature over the message
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if any argument is NULL
+ *     - ESP_ERR_ESPSOL_TX_BUILD_ERROR if pubkey is not a required signer
+ *     - ESP_ERR_ESPSOL_SIGNATURE_INVALID if the signature does not verify
+ *     - Errors from espsol_tx_seal()
+ */
+esp_err_t espsol_tx_add_signature(espsol_tx_handle_t tx,
+                                   const uint8_t pubkey[ESPSOL_PUBKEY_SIZE],
+                                   const uint8_t signature[ESPSOL_SIGNATURE_SIZE]);
+
+/**
+ * @brief Verify every signature of a signed transaction
+ *
+ * Checks each signer slot against the sealed message with
+ * espsol_verify_signers(), which decides exactly as the Solana runtime
+ * does. Use it before forwarding a co-signed transaction.
+ *
+ * @param[in]  tx             Transaction handle
+ * @param[out] invalid_index  Signer index of the first invalid signature (optional)
+ * @return
+ *     - ESP_OK if every signature is valid
+ *     - ESP_ERR_INVALID_ARG if tx is NULL
+ *     - ESP_ERR_ESPSOL_TX_NOT_SIGNED if a slot has no signature yet
+ *     - ESP_ERR_ESPSOL_SIGNATURE_INVALID if a signature does not verify
+ */
+esp_err_t espsol_tx_verify_signatures(espsol_tx_handle_t tx, size_t *invalid_index);
+
 /* ============================================================================
  * Serialization
  * ========================================================================== */
@@ -279,9 +564,49 @@ esp_err_t espsol_tx_serialize(espsol_tx_handle_t tx,
                                uint8_t *buffer, size_t buffer_len,
                                size_t *out_len);
 
+/**
+ * @brief Serialize a transaction that may still miss signatures
+ *
+ * Missing signatures are written as zeros, so the result can be passed
+ * to other signers. Seals the transaction if needed.
+ *
+ * @param[in]  tx          Transaction handle
+ * @param[out] buffer      Output buffer
+ * @param[in]  buffer_len  Size of output buffer
+ * @param[out] out_len     Actual serialized length
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if any argument is NULL
+ *     - ESP_ERR_ESPSOL_BUFFER_TOO_SMALL if buffer too small
+ *     - Errors from espsol_tx_seal()
+ */
+esp_err_t espsol_tx_serialize_partial(espsol_tx_handle_t tx,
+                                       uint8_t *buffer, size_t buffer_len,
+                                       size_t *out_len);
+
+/**
+ * @brief Stream the signed transaction to a writer
+ *
+ * Emits the wire bytes in order straight from the transaction, without a
+ * staging buffer. Chain an encoder such as espsol_base64_writer_init() in
+ * front of the destination to produce text output in one pass.
+ *
+ * @param[in] tx        Transaction handle
+ * @param[in] writer    Destination
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if any argument is NULL
+ *     - ESP_ERR_ESPSOL_TX_NOT_SIGNED if transaction not signed
+ *     - Errors from the writer
+ */
+esp_err_t espsol_tx_write(espsol_tx_handle_t tx, const espsol_writer_t *writer);
+
 /**
  * @brief Serialize the transaction to Base64 for RPC submission
  *
+ * Encodes while serializing, with no intermediate copy of the
+ * transaction.
+ *
  * @param[in]  tx          Transaction handle
  * @param[out] output      Output buffer for Base64 string
  * @param[in]  output_len  Size of output buffer
@@ -297,6 +622,9 @@ esp_err_t espsol_tx_to_base64(espsol_tx_handle_t tx,
 /**
  * @brief Serialize the transaction to Base58
  *
+ * The transaction is serialized into the tail of output and encoded in
+ * place, so output only needs espsol_base58_encoded_len() bytes.
+ *
  * @param[in]  tx          Transaction handle
  * @param[out] output      Output buffer for Base58 string
  * @param[in]  output_len  Size of output buffer
@@ -386,6 +714,71 @@ esp_err_t espsol_tx_get_instruction_count(espsol_tx_handle_t tx, size_t *count);
  */
 esp_err_t espsol_tx_get_account_count(espsol_tx_handle_t tx, size_t *count);
 
+/**
+ * @brief Get the serialized size of the transaction once signed
+ *
+ * Exact size of espsol_tx_serialize() output, including one signature
+ * per required signer, without signing. The size is kept as a running
+ * total while instructions are added. With lookup tables the accounts
+ * are compiled to count the loaded ones.
+ *
+ * @param[in]  tx     Transaction handle
+ * @param[out] size   Receives the size in bytes
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if tx or size is NULL
+ */
+esp_err_t espsol_tx_get_size(espsol_tx_handle_t tx, size_t *size);
+
+/**
+ * @brief Check whether an instruction would fit the transaction
+ *
+ * Reports the error espsol_tx_add_instruction() or serialization would
+ * hit, without changing the transaction. Accounts already present cost
+ * nothing. Exact for messages without lookup tables; with tables, new
+ * accounts are counted as static keys, so the result is an upper bound.
+ *
+ * @param[in]  tx             Transaction handle
+ * @param[in]  program_id     Program ID
+ * @param[in]  accounts       Account metas (can be NULL if account_count is 0)
+ * @param[in]  account_count  Number of account metas
+ * @param[in]  data_len       Instruction data length
+ * @param[out] size           Receives the size with the instruction (can be NULL)
+ * @return
+ *     - ESP_OK if the instruction fits
+ *     - ESP_ERR_INVALID_ARG if a required argument is NULL
+ *     - ESP_ERR_ESPSOL_MAX_INSTRUCTIONS if the instruction limit is reached
+ *     - ESP_ERR_ESPSOL_MAX_ACCOUNTS if the account or signer limit would be exceeded
+ *     - ESP_ERR_ESPSOL_BUFFER_TOO_SMALL if the transaction would exceed ESPSOL_MAX_TX_SIZE
+ */
+esp_err_t espsol_tx_instruction_fits(espsol_tx_handle_t tx,
+                                      const uint8_t program_id[ESPSOL_PUBKEY_SIZE],
+                                      const espsol_account_meta_t *accounts,
+                                      size_t account_count,
+                                      size_t data_len,
+                                      size_t *size);
+
+/* ============================================================================
+ * Fee Calculation
+ * ========================================================================== */
+
+/**
+ * @brief Calculate the fee the network will charge for the transaction
+ *
+ * Computed locally from the number of required signatures and any
+ * Compute Budget instructions in the transaction. When no compute unit
+ * limit is requested, the default of 200,000 units per instruction
+ * (capped at 1.4M) is used for the priority fee.
+ *
+ * @param[in]  tx        Transaction handle
+ * @param[out] lamports  Pointer to receive fee in lamports
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if tx or lamports is NULL
+ *     - ESP_ERR_ESPSOL_MAX_ACCOUNTS if too many accounts
+ */
+esp_err_t espsol_tx_calculate_fee(espsol_tx_handle_t tx, uint64_t *lamports);
+
 #ifdef __cplusplus
 }
 #endif
@@ -25,6 +25,8 @@ typedef int esp_err_t;
 #define ESP_OK 0
 #define ESP_ERR_INVALID_ARG 0x102
 #define ESP_ERR_NO_MEM 0x101
+#define ESP_ERR_NOT_FOUND 0x105
+#define ESP_ERR_NOT_SUPPORTED 0x106
 #define ESP_FAIL -1
 #endif
 
@@ -79,14 +81,20 @@ extern "C" {
 /** @brief Maximum number of accounts per transaction */
 #define ESPSOL_MAX_ACCOUNTS         20
 
-/** @brief Maximum number of signers per transaction */
-#define ESPSOL_MAX_SIGNERS          4
+/** @brief Maximum number of accounts per v0 transaction, including looked-up accounts */
+#define ESPSOL_MAX_LOADED_ACCOUNTS  64
+
+/** @brief Maximum number of address lookup tables per v0 transaction */
+#define ESPSOL_MAX_LOOKUP_TABLES    4
+
+/** @brief Maximum number of signers per transaction (96 wire bytes each) */
+#define ESPSOL_MAX_SIGNERS          12
 
 /** @brief Maximum serialized transaction size */
 #define ESPSOL_MAX_TX_SIZE          1232
 
-/** @brief Maximum instruction data size */
-#define ESPSOL_MAX_INSTRUCTION_DATA 256
+/** @brief Maximum instruction data size (one signer, no other accounts) */
+#define ESPSOL_MAX_INSTRUCTION_DATA (ESPSOL_MAX_TX_SIZE - 170)
 
 /* ============================================================================
  * Network Constants
@@ -276,13 +284,20 @@ extern "C" {
  */
 #define ESP_ERR_ESPSOL_INVALID_MNEMONIC     (ESP_ERR_ESPSOL_BASE + 0x14)
 
+/**
+ * @brief Operation cancelled
+ * @details A cancellation token passed in the call options was cancelled
+ *          while the call was waiting. See espsol_cancel.h.
+ */
+#define ESP_ERR_ESPSOL_CANCELLED            (ESP_ERR_ESPSOL_BASE + 0x15)
+
 /** @brief Highest ESPSOL error code (for range checking) */
-#define ESP_ERR_ESPSOL_MAX                  ESP_ERR_ESPSOL_INVALID_MNEMONIC
+#define ESP_ERR_ESPSOL_MAX                  ESP_ERR_ESPSOL_CANCELLED
 
 /**
  * @brief Check if an error code is an ESPSOL-specific error
  * @param err Error code to check
- * @return true if error is ESPSOL-specific (0x50001-0x50013)
+ * @return true if error is ESPSOL-specific (0x50001-0x50015)
  */
 #define ESPSOL_IS_ERR(err) \
     ((err) >= (ESP_ERR_ESPSOL_BASE + 1) && (err) <= ESP_ERR_ESPSOL_MAX)
@@ -26,6 +26,10 @@ extern "C" {
  * @brief Encode binary data to Base58 string
  *
  * Encodes binary data using the Base58 alphabet used by Solana and Bitcoin.
+ * The output buffer doubles as working memory, so there is no input size
+ * limit beyond its length, and data may itself lie inside output (e.g.
+ * serialized into its tail to encode without a second buffer). On error
+ * the contents of output are undefined.
  *
  * @param[in]  data       Input binary data
  * @param[in]  data_len   Length of input data
@@ -43,7 +47,8 @@ esp_err_t espsol_base58_encode(const uint8_t *data, size_t data_len,
 /**
  * @brief Decode Base58 string to binary data
  *
- * Decodes a Base58 string to binary data.
+ * Decodes a Base58 string to binary data, using the output buffer as
+ * working memory. On error the contents of output are undefined.
  *
  * @param[in]  input      Input Base58 string (null-terminated)
  * @param[out] output     Output buffer for decoded data
@@ -132,6 +137,92 @@ size_t espsol_base64_encoded_len(size_t data_len);
  */
 size_t espsol_base64_decoded_len(size_t encoded_len);
 
+/* ============================================================================
+ * Streaming Writers
+ * ========================================================================== */
+
+/**
+ * @brief Accept the next chunk of a byte stream
+ *
+ * @param[in] ctx   Writer context
+ * @param[in] data  Next bytes
+ * @param[in] len   Length of data
+ * @return ESP_OK to continue, any other code stops the producer
+ */
+typedef esp_err_t (*espsol_write_fn)(void *ctx, const uint8_t *data, size_t len);
+
+/**
+ * @brief Destination for streamed output
+ *
+ * Serialization writes its bytes in order through write(). Encoders are
+ * writers themselves, so they chain in front of a buffer, a socket or an
+ * HTTP request body without intermediate copies.
+ */
+typedef struct {
+    espsol_write_fn write;      /**< Called with each chunk */
+    void *ctx;                  /**< Passed to write() */
+} espsol_writer_t;
+
+/**
+ * @brief Writer into a fixed caller buffer
+ */
+typedef struct {
+    uint8_t *buffer;            /**< Destination */
+    size_t capacity;            /**< Size of buffer */
+    size_t len;                 /**< Bytes written so far */
+} espsol_buffer_writer_t;
+
+/**
+ * @brief Base64 encoder in front of another writer
+ *
+ * Holds at most two input bytes and a small block of output characters,
+ * so any amount of data is encoded in constant memory.
+ */
+typedef struct {
+    const espsol_writer_t *out; /**< Receives the Base64 characters */
+    uint8_t pending[2];         /**< Input bytes not yet forming a group */
+    uint8_t pending_len;        /**< Bytes in pending */
+    uint8_t block_len;          /**< Characters in block */
+    char block[64];             /**< Characters not yet passed on */
+} espsol_base64_writer_t;
+
+/**
+ * @brief Set up a writer into a caller buffer
+ *
+ * A write that does not fit fails with ESP_ERR_ESPSOL_BUFFER_TOO_SMALL
+ * and writes nothing.
+ *
+ * @param[out] sink      Buffer writer state
+ * @param[in]  buffer    Destination buffer
+ * @param[in]  capacity  Size of buffer
+ * @param[out] writer    Writer to pass to producers
+ */
+void espsol_buffer_writer_init(espsol_buffer_writer_t *sink,
+                               uint8_t *buffer, size_t capacity,
+                               espsol_writer_t *writer);
+
+/**
+ * @brief Set up a Base64 encoder in front of another writer
+ *
+ * @param[out] enc      Encoder state
+ * @param[in]  out      Writer receiving the characters (no terminator)
+ * @param[out] writer   Writer to pass to producers
+ */
+void espsol_base64_writer_init(espsol_base64_writer_t *enc,
+                               const espsol_writer_t *out,
+                               espsol_writer_t *writer);
+
+/**
+ * @brief Encode the last bytes with padding and flush the encoder
+ *
+ * @param[in] enc   Encoder state
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if enc is NULL
+ *     - Errors from the output writer
+ */
+esp_err_t espsol_base64_writer_finish(espsol_base64_writer_t *enc);
+
 /* ============================================================================
  * Public Key / Address Utilities
  * ========================================================================== */
@@ -0,0 +1,270 @@
+/**
+ * @file espsol_view.h
+ * @brief ESPSOL Wire Transaction Parser
+ *
+ * Parses serialized legacy and v0 transactions into a read-only view of
+ * the original bytes: nothing is copied and nothing is allocated. Use it
+ * to inspect a transaction received from a backend before signing it, or
+ * to check a transaction before spending an RPC round trip on it.
+ *
+ * @copyright Copyright (c) 2025 SkyRizz
+ * @license Apache-2.0
+ */
+
+#ifndef ESPSOL_VIEW_H
+#define ESPSOL_VIEW_H
+
+#include "espsol_types.h"
+#include "espsol_crypto.h"
+#include "espsol_tx.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ============================================================================
+ * View Types
+ * ========================================================================== */
+
+/**
+ * @brief Read-only view of a serialized transaction
+ *
+ * Every pointer refers into the parsed buffer, which must stay valid and
+ * unchanged while the view is used.
+ */
+typedef struct {
+    const uint8_t *wire;                /**< Whole transaction (NULL for a bare message) */
+    size_t wire_len;                    /**< Transaction length */
+    const uint8_t *signatures;          /**< signature_count slots of ESPSOL_SIGNATURE_SIZE bytes */
+    size_t signature_count;             /**< Signature slots */
+    const uint8_t *message;             /**< Message, the bytes every signer signs */
+    size_t message_len;                 /**< Message length */
+    espsol_tx_version_t version;        /**< Message format */
+    uint8_t required_signatures;        /**< Header: signer keys */
+    uint8_t readonly_signed;            /**< Header: read-only signer keys */
+    uint8_t readonly_unsigned;          /**< Header: read-only non-signer keys */
+    const uint8_t *keys;                /**< key_count static keys of ESPSOL_PUBKEY_SIZE bytes */
+    size_t key_count;                   /**< Static account keys */
+    const uint8_t *blockhash;           /**< Recent blockhash or durable nonce */
+    const uint8_t *instructions;        /**< First compiled instruction */
+    size_t instruction_count;           /**< Compiled instructions */
+    const uint8_t *lookups;             /**< First lookup table entry (v0 only) */
+    size_t lookup_count;                /**< Lookup table entries */
+    size_t loaded_writable;             /**< Writable accounts loaded from tables */
+    size_t loaded_readonly;             /**< Read-only accounts loaded from tables */
+} espsol_tx_view_t;
+
+/**
+ * @brief Compiled instruction within a view
+ */
+typedef struct {
+    uint8_t program_index;              /**< Index of the program key */
+    const uint8_t *accounts;            /**< account_count account indexes */
+    size_t account_count;               /**< Accounts passed to the program */
+    const uint8_t *data;                /**< Instruction data */
+    size_t data_len;                    /**< Length of data */
+} espsol_tx_view_instruction_t;
+
+/**
+ * @brief Address lookup table entry within a view
+ */
+typedef struct {
+    const uint8_t *key;                 /**< Lookup table account address */
+    const uint8_t *writable;            /**< writable_count indexes into the table */
+    size_t writable_count;              /**< Writable accounts loaded */
+    const uint8_t *readonly;            /**< readonly_count indexes into the table */
+    size_t readonly_count;              /**< Read-only accounts loaded */
+} espsol_tx_view_lookup_t;
+
+/* ============================================================================
+ * Parsing
+ * ========================================================================== */
+
+/**
+ * @brief Parse a serialized transaction
+ *
+ * Checks that every length and count stays within the buffer and that
+ * no bytes follow the message. Use espsol_tx_view_validate() for the
+ * checks the runtime applies on top of that.
+ *
+ * @param[in]  data     Transaction bytes
+ * @param[in]  len      Length of data
+ * @param[out] view     View into data
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if data or view is NULL
+ *     - ESP_ERR_ESPSOL_ENCODING_FAILED if the bytes are not a transaction
+ *     - ESP_ERR_NOT_SUPPORTED for a message version other than legacy or 0
+ */
+esp_err_t espsol_tx_view_parse(const uint8_t *data, size_t len, espsol_tx_view_t *view);
+
+/**
+ * @brief Parse a bare message, without signatures
+ *
+ * The view has no wire bytes and no signature slots.
+ *
+ * @return Same as espsol_tx_view_parse()
+ */
+esp_err_t espsol_tx_view_parse_message(const uint8_t *message, size_t len,
+                                        espsol_tx_view_t *view);
+
+/**
+ * @brief Check a parsed transaction before signing or sending it
+ *
+ * Applies the runtime's sanitize rules: a writable fee payer, header
+ * counts within the keys, one signature slot per signer, no duplicate
+ * static keys, program indexes among the static keys (never the fee
+ * payer), account indexes within the loaded accounts and no empty
+ * lookups. Signatures are not checked.
+ *
+ * @param[in] view      Parsed view
+ * @return
+ *     - ESP_OK if the transaction is well formed
+ *     - ESP_ERR_INVALID_ARG if view is NULL
+ *     - ESP_ERR_ESPSOL_BUFFER_TOO_SMALL if it exceeds ESPSOL_MAX_TX_SIZE
+ *     - ESP_ERR_ESPSOL_TX_BUILD_ERROR if a rule is broken
+ */
+esp_err_t espsol_tx_view_validate(const espsol_tx_view_t *view);
+
+/* ============================================================================
+ * Accessors
+ * ========================================================================== */
+
+/**
+ * @brief Get a compiled instruction
+ *
+ * Walks the instructions from the first, so iterating over all of them
+ * is quadratic in the (small) instruction count.
+ *
+ * @param[in]  view     Parsed view
+ * @param[in]  index    Instruction index
+ * @param[out] ix       Instruction
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if an argument is NULL or index is out of range
+ */
+esp_err_t espsol_tx_view_get_instruction(const espsol_tx_view_t *view, size_t index,
+                                         espsol_tx_view_instruction_t *ix);
+
+/**
+ * @brief Get an address lookup table entry
+ *
+ * @param[in]  view     Parsed view
+ * @param[in]  index    Lookup index
+ * @param[out] lookup   Lookup entry
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if an argument is NULL or index is out of range
+ */
+esp_err_t espsol_tx_view_get_lookup(const espsol_tx_view_t *view, size_t index,
+                                    espsol_tx_view_lookup_t *lookup);
+
+/**
+ * @brief Get a static account key
+ *
+ * @return Pointer to the key, or NULL if index is not a static key
+ */
+const uint8_t *espsol_tx_view_get_key(const espsol_tx_view_t *view, size_t index);
+
+/**
+ * @brief Find a static account key
+ *
+ * @param[in]  view     Parsed view
+ * @param[in]  pubkey   Key to find
+ * @param[out] index    Account index
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if an argument is NULL
+ *     - ESP_ERR_NOT_FOUND if the key is not a static key
+ */
+esp_err_t espsol_tx_view_find_key(const espsol_tx_view_t *view,
+                                  const uint8_t pubkey[ESPSOL_PUBKEY_SIZE],
+                                  size_t *index);
+
+/**
+ * @brief Check whether an account must sign
+ */
+bool espsol_tx_view_is_signer(const espsol_tx_view_t *view, size_t index);
+
+/**
+ * @brief Check whether an account is writable
+ *
+ * Indexes past the static keys refer to accounts loaded from lookup
+ * tables, writable ones first.
+ */
+bool espsol_tx_view_is_writable(const espsol_tx_view_t *view, size_t index);
+
+/**
+ * @brief Check whether a signature slot holds a signature
+ *
+ * An unsigned slot is all zeros. The signature itself is not verified.
+ */
+bool espsol_tx_view_is_signed(const espsol_tx_view_t *view, size_t index);
+
+/* ============================================================================
+ * Signing Serialized Transactions
+ * ========================================================================== */
+
+/**
+ * @brief Sign a serialized transaction in place
+ *
+ * Writes the signature into the keypair's slot, leaving the other slots
+ * as they are. Use it to co-sign a partially signed transaction from
+ * espsol_tx_serialize_partial() without rebuilding it.
+ *
+ * @param[in,out] wire      Transaction bytes
+ * @param[in]     len       Length of wire
+ * @param[in]     keypair   Signing keypair
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if wire or keypair is NULL
+ *     - ESP_ERR_ESPSOL_TX_BUILD_ERROR if the keypair is not a required signer
+ *       or the slot count does not match the header
+ *     - Errors from espsol_tx_view_parse()
+ */
+esp_err_t espsol_tx_wire_sign(uint8_t *wire, size_t len, const espsol_keypair_t *keypair);
+
+/**
+ * @brief Add a detached signature to a serialized transaction in place
+ *
+ * The signature is verified against the message before it is written.
+ *
+ * @param[in,out] wire       Transaction bytes
+ * @param[in]     len        Length of wire
+ * @param[in]     pubkey     Signer public key
+ * @param[in]     signature  Signature over the message
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if any argument is NULL
+ *     - ESP_ERR_ESPSOL_TX_BUILD_ERROR if pubkey is not a required signer
+ *       or the slot count does not match the header
+ *     - ESP_ERR_ESPSOL_SIGNATURE_INVALID if the signature does not verify
+ *     - Errors from espsol_tx_view_parse()
+ */
+esp_err_t espsol_tx_wire_add_signature(uint8_t *wire, size_t len,
+                                       const uint8_t pubkey[ESPSOL_PUBKEY_SIZE],
+                                       const uint8_t signature[ESPSOL_SIGNATURE_SIZE]);
+
+/**
+ * @brief Verify every signature of a parsed transaction
+ *
+ * Checks each slot against the message with espsol_verify_signers(),
+ * which decides exactly as the Solana runtime does. Use it on relays
+ * before forwarding a transaction.
+ *
+ * @param[in]  view           Parsed transaction (not a bare message)
+ * @param[out] invalid_index  Slot of the first invalid signature (optional)
+ * @return
+ *     - ESP_OK if every signature is valid
+ *     - ESP_ERR_INVALID_ARG if view is NULL
+ *     - ESP_ERR_ESPSOL_TX_BUILD_ERROR if the slot count does not match the header
+ *     - ESP_ERR_ESPSOL_TX_NOT_SIGNED if a slot is empty
+ *     - ESP_ERR_ESPSOL_SIGNATURE_INVALID if a signature does not verify
+ */
+esp_err_t espsol_tx_view_verify_signatures(const espsol_tx_view_t *view, size_t *invalid_index);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ESPSOL_VIEW_H */
@@ -21,6 +21,7 @@
 #define ESPSOL_WS_H
 
 #include "espsol_types.h"
+#include "espsol_cancel.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -222,6 +223,22 @@ esp_err_t espsol_ws_cleanup(espsol_ws_handle_t handle);
  */
 esp_err_t espsol_ws_is_connected(espsol_ws_handle_t handle, bool *connected);
 
+/**
+ * @brief Set the deadline and cancellation token applied to each call
+ *
+ * Bounds how long subscribe and unsubscribe calls wait for the client lock
+ * and for the message to be sent.
+ *
+ * @param[in] handle WebSocket client handle
+ * @param[in] options Call options (copied; NULL restores no limits)
+ *
+ * @return
+ *   - ESP_OK: Success
+ *   - ESP_ERR_INVALID_ARG: handle is NULL
+ */
+esp_err_t espsol_ws_set_call_options(espsol_ws_handle_t handle,
+                                     const espsol_call_options_t *options);
+
 /* ============================================================================
  * Subscription Functions
  * ========================================================================== */
@@ -1,9 +1,15 @@
 /**
  * @file espsol_ed25519.h
- * @brief Portable Ed25519 Implementation (TweetNaCl-derived)
+ * @brief Portable Ed25519 Implementation
  *
- * Minimal Ed25519 implementation for host testing when libsodium is unavailable.
- * Based on TweetNaCl, a compact, audited cryptographic library.
+ * Ed25519 for host testing when libsodium is unavailable. Two backends
+ * provide the functions below:
+ * - espsol_ed25519_fast.c: 5x51-bit field limbs with 128-bit products,
+ *   a precomputed base point table and sliding-window verification
+ * - espsol_ed25519.c: TweetNaCl, a compact, audited reference
+ *
+ * The fast backend is used when the compiler has unsigned __int128,
+ * unless ESPSOL_ED25519_REF is defined.
  *
  * This should only be used for testing. On ESP32, use libsodium.
  *
@@ -14,6 +20,13 @@
 #define ESPSOL_ED25519_H
 
 #include "espsol_types.h"
+#include "espsol_crypto.h"
+
+#if defined(__SIZEOF_INT128__) && !defined(ESPSOL_ED25519_REF)
+#define ESPSOL_ED25519_FAST 1
+#else
+#define ESPSOL_ED25519_FAST 0
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -27,11 +40,26 @@ esp_err_t espsol_ed25519_keypair_from_seed(const uint8_t seed[32],
                                             uint8_t private_key[64]);
 
 /**
- * @brief Sign a message with Ed25519 (detached signature)
+ * @brief Signing, first half: reduce the nonce and commit to it
+ *
+ * Hashing is left to the caller, so the message can be streamed.
+ *
+ * @param[in]  nonce    SHA-512(prefix || message)
+ * @param[out] r        Nonce reduced mod L, kept for espsol_ed25519_sign_finish()
+ * @param[out] R        Encoded [r]B, the first half of the signature
+ */
+void espsol_ed25519_sign_commit(const uint8_t nonce[64], uint8_t r[32], uint8_t R[32]);
+
+/**
+ * @brief Signing, second half: S = (r + k * a) mod L
+ *
+ * @param[in]  challenge  SHA-512(R || A || message)
+ * @param[in]  scalar     Clamped secret scalar a
+ * @param[in]  r          Reduced nonce from espsol_ed25519_sign_commit()
+ * @param[out] S          Second half of the signature
  */
-esp_err_t espsol_ed25519_sign(const uint8_t *message, size_t message_len,
-                               const uint8_t private_key[64],
-                               uint8_t signature[64]);
+void espsol_ed25519_sign_finish(const uint8_t challenge[64], const uint8_t scalar[32],
+                                const uint8_t r[32], uint8_t S[32]);
 
 /**
  * @brief Verify an Ed25519 signature
@@ -40,6 +68,25 @@ esp_err_t espsol_ed25519_verify(const uint8_t *message, size_t message_len,
                                  const uint8_t signature[64],
                                  const uint8_t public_key[32]);
 
+/**
+ * @brief Verify several signed messages in a single check
+ *
+ * Uses the cofactored batch equation with weights derived from entropy
+ * and the inputs. Reports only whether all signatures are valid.
+ */
+esp_err_t espsol_ed25519_verify_batch(const espsol_signed_message_t *items, size_t count,
+                                      const uint8_t entropy[32]);
+
+/**
+ * @brief Check whether 32 bytes decompress to a curve point
+ *
+ * The rule of libsodium's ge25519_frombytes() and of the decompression
+ * Solana uses for PDAs: the top bit is the sign of x, y may be
+ * non-canonical and small-order points count. Runs in constant time and
+ * shares its square root with signature verification.
+ */
+bool espsol_ed25519_is_on_curve(const uint8_t point[32]);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,242 @@
+/**
+ * @file espsol_json.h
+ * @brief ESPSOL Minimal JSON Reader (Internal)
+ *
+ * Allocation-free JSON reader used by the RPC client. Values are spans
+ * into the original text; lookups walk the text on demand, so parsing a
+ * response never copies or builds a tree.
+ *
+ * @copyright Copyright (c) 2025 SkyRizz
+ * @license Apache-2.0
+ */
+
+#ifndef ESPSOL_JSON_H
+#define ESPSOL_JSON_H
+
+#include "espsol_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief JSON value types
+ */
+typedef enum {
+    ESPSOL_JSON_INVALID = 0,
+    ESPSOL_JSON_NULL,
+    ESPSOL_JSON_BOOL,
+    ESPSOL_JSON_NUMBER,
+    ESPSOL_JSON_STRING,
+    ESPSOL_JSON_ARRAY,
+    ESPSOL_JSON_OBJECT,
+} espsol_json_type_t;
+
+/**
+ * @brief A JSON value (span of the source text)
+ */
+typedef struct {
+    const char *ptr;    /**< First character of the value */
+    size_t len;         /**< Length of the value text */
+} espsol_json_t;
+
+/**
+ * @brief Locate the single JSON value in a text buffer
+ *
+ * @return true if text contains one complete value (surrounding whitespace allowed)
+ */
+bool espsol_json_parse(const char *text, size_t len, espsol_json_t *out);
+
+/**
+ * @brief Get the type of a value
+ */
+espsol_json_type_t espsol_json_type(const espsol_json_t *value);
+
+/**
+ * @brief Look up an object member by key
+ *
+ * @return true if value is an object containing key
+ */
+bool espsol_json_get(const espsol_json_t *object, const char *key, espsol_json_t *out);
+
+/**
+ * @brief Iterate array elements
+ *
+ * Set *cursor to 0 before the first call.
+ *
+ * @return true if an element was returned, false at end of array
+ */
+bool espsol_json_array_next(const espsol_json_t *array, size_t *cursor, espsol_json_t *out);
+
+/**
+ * @brief Get array element by index
+ */
+bool espsol_json_index(const espsol_json_t *array, size_t index, espsol_json_t *out);
+
+/**
+ * @brief Get number of array elements (0 if not an array)
+ */
+size_t espsol_json_array_size(const espsol_json_t *array);
+
+/**
+ * @brief Read a non-negative integer
+ */
+bool espsol_json_get_u64(const espsol_json_t *value, uint64_t *out);
+
+/**
+ * @brief Read a signed integer
+ */
+bool espsol_json_get_i64(const espsol_json_t *value, int64_t *out);
+
+/**
+ * @brief Read a boolean
+ */
+bool espsol_json_get_bool(const espsol_json_t *value, bool *out);
+
+/**
+ * @brief Check for null (a missing value is not null)
+ */
+bool espsol_json_is_null(const espsol_json_t *value);
+
+/**
+ * @brief Copy a string value, resolving escapes, NUL-terminated
+ *
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if value is not a valid string
+ *     - ESP_ERR_ESPSOL_BUFFER_TOO_SMALL if out is too small
+ */
+esp_err_t espsol_json_get_string(const espsol_json_t *value, char *out, size_t out_len);
+
+/**
+ * @brief Compare a string value (without escapes) to a C string
+ */
+bool espsol_json_string_equals(const espsol_json_t *value, const char *str);
+
+/* ============================================================================
+ * Streaming Reader
+ * ========================================================================== */
+
+/**
+ * @brief Maximum container nesting tracked by the streaming reader
+ */
+#define ESPSOL_JSON_STREAM_MAX_DEPTH    16
+
+/**
+ * @brief Longest object key the streaming reader can match
+ */
+#define ESPSOL_JSON_STREAM_KEY_LEN      24
+
+typedef struct espsol_json_stream espsol_json_stream_t;
+
+/**
+ * @brief Called when a value starts
+ *
+ * Return a buffer to capture the value's text (including quotes or
+ * brackets), or NULL to skip it. Not called for values inside a capture.
+ *
+ * @param[in]  ctx     Callback context
+ * @param[in]  stream  Stream (use espsol_json_stream_at() to check the path)
+ * @param[in]  first   First character of the value
+ * @param[out] cap     Capacity of the returned buffer
+ */
+typedef char *(*espsol_json_begin_fn)(void *ctx, const espsol_json_stream_t *stream,
+                                      char first, size_t *cap);
+
+/**
+ * @brief Called when a value ends
+ *
+ * @param[in] ctx        Callback context
+ * @param[in] stream     Stream, positioned at the value's path
+ * @param[in] text       Captured text (NULL if not captured)
+ * @param[in] len        Captured length (at most the buffer capacity)
+ * @param[in] truncated  The value did not fit the capture buffer
+ * @return false to stop the stream
+ */
+typedef bool (*espsol_json_end_fn)(void *ctx, const espsol_json_stream_t *stream,
+                                   const char *text, size_t len, bool truncated);
+
+/**
+ * @brief Push parser for JSON that arrives in chunks
+ *
+ * Tracks the path of the current value so callers can pick out the parts
+ * they need from documents far larger than memory. Structure is checked
+ * loosely; numbers and literals are not validated.
+ */
+struct espsol_json_stream {
+    struct {
+        char key[ESPSOL_JSON_STREAM_KEY_LEN];   /**< Member name (object) */
+        uint32_t index;                         /**< Element index (array) */
+        bool object;                            /**< Container is an object */
+        bool key_truncated;                     /**< key was too long to store */
+    } levels[ESPSOL_JSON_STREAM_MAX_DEPTH];     /**< Open containers */
+    uint8_t depth;                              /**< Number of open containers */
+    uint8_t state;                              /**< Tokenizer state */
+    bool escape;                                /**< Previous string char was '\\' */
+    bool done;                                  /**< Root value complete */
+    bool failed;                                /**< Malformed input or stopped */
+    size_t key_len;                             /**< Bytes of key read so far */
+    char *capture;                              /**< Capture buffer (NULL = none) */
+    size_t capture_cap;                         /**< Capture buffer capacity */
+    size_t capture_len;                         /**< Captured bytes */
+    uint8_t capture_depth;                      /**< Depth of the captured value */
+    bool capture_truncated;                     /**< Capture overflowed */
+    espsol_json_begin_fn on_begin;              /**< Value start callback */
+    espsol_json_end_fn on_end;                  /**< Value end callback */
+    void *ctx;                                  /**< Callback context */
+};
+
+/**
+ * @brief Initialize a streaming reader
+ */
+void espsol_json_stream_init(espsol_json_stream_t *stream,
+                             espsol_json_begin_fn on_begin,
+                             espsol_json_end_fn on_end,
+                             void *ctx);
+
+/**
+ * @brief Feed the next chunk of text
+ *
+ * @return false if the input is malformed, too deep, or a callback stopped it
+ */
+bool espsol_json_stream_feed(espsol_json_stream_t *stream, const char *data, size_t len);
+
+/**
+ * @brief Check whether the root value has been read completely
+ */
+bool espsol_json_stream_done(const espsol_json_stream_t *stream);
+
+/**
+ * @brief Match the path of the current value
+ *
+ * The path lists one segment per container, separated by '.': an object
+ * key, an array index, or '#' for any index. "" matches the root value.
+ * Example: "result.transactions.#.meta"
+ */
+bool espsol_json_stream_at(const espsol_json_stream_t *stream, const char *path);
+
+/**
+ * @brief Get the array index of the current value within level
+ *
+ * @return Element index, or 0 if that level is not an array
+ */
+uint32_t espsol_json_stream_index(const espsol_json_stream_t *stream, size_t level);
+
+/**
+ * @brief Strip the quotes of a captured string in place
+ *
+ * Leaves the raw contents NUL-terminated, escapes untouched, e.g. for a
+ * base64 decoder. The buffer needs room for len bytes.
+ *
+ * @param[in,out] text       Captured text
+ * @param[in]     len        Captured length
+ * @param[in]     truncated  The capture overflowed
+ * @return false if the capture is not a complete string
+ */
+bool espsol_json_unquote(char *text, size_t len, bool truncated);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ESPSOL_JSON_H */
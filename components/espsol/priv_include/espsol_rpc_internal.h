@@ -0,0 +1,76 @@
+/**
+ * @file espsol_rpc_internal.h
+ * @brief ESPSOL RPC Client Internals (Private Header)
+ *
+ * Hooks used by RPC features implemented outside espsol_rpc.c.
+ *
+ * @copyright Copyright (c) 2025 SkyRizz
+ * @license Apache-2.0
+ */
+
+#ifndef ESPSOL_RPC_INTERNAL_H
+#define ESPSOL_RPC_INTERNAL_H
+
+#include "espsol_rpc.h"
+#include "espsol_json.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Perform a JSON-RPC request, streaming the response body to sink
+ *
+ * Applies the client's call options and retry policy; a request is only
+ * retried while no part of the body has reached the sink. The sink only
+ * sees bodies of HTTP 200 responses.
+ *
+ * @param[in] handle     RPC client handle
+ * @param[in] method     JSON-RPC method
+ * @param[in] params     JSON params (NULL for [])
+ * @param[in] sink       Receives the response body
+ * @param[in] sink_ctx   Context passed to sink
+ * @return
+ *     - ESP_OK if the whole body was delivered
+ *     - The sink's error if it stopped the stream
+ *     - Transport and HTTP errors as for other RPC calls
+ */
+esp_err_t espsol_rpc_stream_request(espsol_rpc_handle_t handle,
+                                    const char *method,
+                                    const char *params,
+                                    espsol_rpc_sink_fn sink,
+                                    void *sink_ctx);
+
+/**
+ * @brief Set the message returned by espsol_rpc_get_last_error()
+ */
+void espsol_rpc_set_last_error(espsol_rpc_handle_t handle, const char *message);
+
+/**
+ * @brief Get the code of a JSON-RPC error object
+ *
+ * @return The "code" member, or -1 if it is missing
+ */
+int64_t espsol_rpc_error_code(const espsol_json_t *error);
+
+/**
+ * @brief Record a JSON-RPC error object as the last error
+ *
+ * Sets "RPC error <code>: <message>" and logs it.
+ *
+ * @param[in] handle  RPC client handle
+ * @param[in] error   The response's "error" value
+ * @return ESP_ERR_ESPSOL_RPC_FAILED
+ */
+esp_err_t espsol_rpc_report_error(espsol_rpc_handle_t handle, const espsol_json_t *error);
+
+/**
+ * @brief Get the client's default commitment
+ */
+espsol_commitment_t espsol_rpc_get_commitment(espsol_rpc_handle_t handle);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ESPSOL_RPC_INTERNAL_H */
@@ -0,0 +1,162 @@
+/**
+ * @file espsol_sha.h
+ * @brief Portable SHA-256 and SHA-512
+ *
+ * Hash functions for host builds, where neither libsodium nor mbedTLS is
+ * available. Shared by both Ed25519 backends, PDA derivation and the
+ * mnemonic checksum. On ESP32, libsodium and mbedTLS are used instead.
+ *
+ * On x86-64 the block functions use SHA-NI and AVX2 when the CPU has
+ * them, chosen once at load time. Results are identical on every path.
+ *
+ * @copyright Public domain (TweetNaCl)
+ */
+
+#ifndef ESPSOL_SHA_H
+#define ESPSOL_SHA_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Compute a SHA-256 digest
+ */
+void espsol_sha256(const uint8_t *data, size_t len, uint8_t out[32]);
+
+/**
+ * @brief Compute the SHA-256 digests of several independent inputs
+ *
+ * With AVX2, eight inputs are hashed at once, one per vector lane, which
+ * suits batches of similar short inputs such as PDA candidates. Other
+ * hosts hash them one after another.
+ *
+ * @param[in]  data   count input pointers
+ * @param[in]  len    count input lengths
+ * @param[in]  count  Number of inputs
+ * @param[out] out    count digests
+ */
+void espsol_sha256_many(const uint8_t *const *data, const size_t *len, size_t count,
+                        uint8_t (*out)[32]);
+
+/**
+ * @brief Inputs espsol_sha256_many() hashes at once
+ *
+ * @return 8 with AVX2, 1 when inputs are hashed one after another
+ */
+size_t espsol_sha256_lanes(void);
+
+/**
+ * @brief Incremental SHA-256 state
+ *
+ * A copy taken after a common prefix is a midstate: hashing several
+ * inputs that share the prefix continues from it instead of starting over.
+ */
+typedef struct {
+    uint32_t state[8];          /**< Chaining value */
+    uint64_t total;             /**< Bytes hashed so far */
+    uint8_t block[64];          /**< Bytes not yet forming a full block */
+    size_t block_len;           /**< Bytes in block */
+} espsol_sha256_ctx_t;
+
+/**
+ * @brief Start a SHA-256 digest
+ */
+void espsol_sha256_init(espsol_sha256_ctx_t *ctx);
+
+/**
+ * @brief Hash the next bytes of the input
+ */
+void espsol_sha256_update(espsol_sha256_ctx_t *ctx, const uint8_t *data, size_t len);
+
+/**
+ * @brief Pad the input and write the digest
+ *
+ * The state must be initialized again before it is reused.
+ */
+void espsol_sha256_final(espsol_sha256_ctx_t *ctx, uint8_t out[32]);
+
+/**
+ * @brief Compute the SHA-256 digests of one prefix followed by several inputs
+ *
+ * Digest i covers everything hashed into prefix, then data[i]; prefix is
+ * left unchanged. Inputs share the lanes of espsol_sha256_many() when the
+ * prefix ends on a block boundary (block_len is 0).
+ *
+ * @param[in]  prefix  State after the common prefix
+ * @param[in]  data    count input pointers
+ * @param[in]  len     count input lengths
+ * @param[in]  count   Number of inputs
+ * @param[out] out     count digests
+ */
+void espsol_sha256_many_from(const espsol_sha256_ctx_t *prefix, const uint8_t *const *data,
+                             const size_t *len, size_t count, uint8_t (*out)[32]);
+
+/**
+ * @brief Compute a SHA-512 digest
+ */
+void espsol_sha512(const uint8_t *data, size_t len, uint8_t out[64]);
+
+/**
+ * @brief Incremental SHA-512 state
+ *
+ * Lets a digest be computed over data that arrives in pieces, for example
+ * from a streaming writer, without gathering it in one buffer first.
+ */
+typedef struct {
+    uint64_t state[8];          /**< Chaining value */
+    uint64_t total;             /**< Bytes hashed so far */
+    uint8_t block[128];         /**< Bytes not yet forming a full block */
+    size_t block_len;           /**< Bytes in block */
+} espsol_sha512_ctx_t;
+
+/**
+ * @brief Start a SHA-512 digest
+ */
+void espsol_sha512_init(espsol_sha512_ctx_t *ctx);
+
+/**
+ * @brief Hash the next bytes of the input
+ */
+void espsol_sha512_update(espsol_sha512_ctx_t *ctx, const uint8_t *data, size_t len);
+
+/**
+ * @brief Pad the input and write the digest
+ *
+ * The state must be initialized again before it is reused.
+ */
+void espsol_sha512_final(espsol_sha512_ctx_t *ctx, uint8_t out[64]);
+
+/** SHA-256 block function using the SHA extensions */
+#define ESPSOL_SHA_SHANI    (1u << 0)
+/** SHA-512 block function and eight-lane SHA-256 using AVX2 */
+#define ESPSOL_SHA_AVX2     (1u << 1)
+
+/**
+ * @brief Accelerated paths this CPU supports
+ *
+ * @return ESPSOL_SHA_* flags, 0 on other architectures or with
+ *         ESPSOL_SHA_PORTABLE defined
+ */
+unsigned espsol_sha_cpu_features(void);
+
+/**
+ * @brief Restrict hashing to some accelerated paths
+ *
+ * The best paths are selected automatically; this exists so tests can
+ * check each path against the portable code. Not thread-safe: call it
+ * only while no other thread is hashing.
+ *
+ * @param[in] features  ESPSOL_SHA_* flags to allow, 0 for portable code only
+ * @return The flags now in use (those allowed and supported)
+ */
+unsigned espsol_sha_select(unsigned features);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ESPSOL_SHA_H */
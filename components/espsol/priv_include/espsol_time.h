@@ -0,0 +1,59 @@
+/**
+ * @file espsol_time.h
+ * @brief ESPSOL Monotonic Time and Delay Helpers (Internal)
+ *
+ * Thin platform layer so RPC retry, polling and replay timing behave the
+ * same on ESP-IDF and in host builds.
+ *
+ * @copyright Copyright (c) 2025 SkyRizz
+ * @license Apache-2.0
+ */
+
+#ifndef ESPSOL_TIME_H
+#define ESPSOL_TIME_H
+
+#include <stdint.h>
+
+#if defined(ESP_PLATFORM) && ESP_PLATFORM
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#else
+#include <time.h>
+#endif
+
+/**
+ * @brief Monotonic time in microseconds
+ */
+static inline int64_t espsol_time_us(void)
+{
+#if defined(ESP_PLATFORM) && ESP_PLATFORM
+    return esp_timer_get_time();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+#endif
+}
+
+/**
+ * @brief Block the calling task for at least ms milliseconds
+ */
+static inline void espsol_delay_ms(uint32_t ms)
+{
+    if (ms == 0) {
+        return;
+    }
+#if defined(ESP_PLATFORM) && ESP_PLATFORM
+    TickType_t ticks = pdMS_TO_TICKS(ms);
+    vTaskDelay(ticks > 0 ? ticks : 1);
+#else
+    struct timespec ts = {
+        .tv_sec = ms / 1000,
+        .tv_nsec = (long)(ms % 1000) * 1000000L,
+    };
+    nanosleep(&ts, NULL);
+#endif
+}
+
+#endif /* ESPSOL_TIME_H */
@@ -0,0 +1,93 @@
+/**
+ * @file espsol_tx_internal.h
+ * @brief ESPSOL Transaction Internals (Private Header)
+ *
+ * Hooks used by transaction features implemented outside espsol_tx.c.
+ *
+ * @copyright Copyright (c) 2025 SkyRizz
+ * @license Apache-2.0
+ */
+
+#ifndef ESPSOL_TX_INTERNAL_H
+#define ESPSOL_TX_INTERNAL_H
+
+#include "espsol_tx.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief List the accounts that may be loaded from a lookup table
+ *
+ * These are the deduplicated accounts that are neither signers nor
+ * invoked programs. The pointers stay valid until the transaction is
+ * modified.
+ *
+ * @param[in]  tx             Transaction handle
+ * @param[out] keys           Receives pointers to the account keys
+ * @param[in]  capacity       Size of keys
+ * @param[out] count          Number of keys
+ * @param[out] account_count  Number of accounts in the message (can be NULL)
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if tx, keys or count is NULL
+ *     - ESP_ERR_ESPSOL_MAX_ACCOUNTS if the transaction has too many accounts
+ *     - ESP_ERR_ESPSOL_BUFFER_TOO_SMALL if capacity is too small
+ */
+esp_err_t espsol_tx_get_lookup_candidates(espsol_tx_handle_t tx,
+                                           const uint8_t **keys,
+                                           size_t capacity,
+                                           size_t *count,
+                                           size_t *account_count);
+
+/**
+ * @brief Growth of a legacy message when an instruction is added
+ */
+typedef struct {
+    size_t new_keys;            /**< Accounts not yet in the message */
+    size_t new_signers;         /**< Accounts that become required signers */
+    size_t instruction_bytes;   /**< Wire bytes of the instruction itself */
+} espsol_tx_cost_t;
+
+/**
+ * @brief Work out what adding an instruction would add to the message
+ *
+ * Accounts already in the message, including the fee payer, cost
+ * nothing unless they become signers. The transaction is not changed.
+ *
+ * @param[in]  tx             Transaction handle
+ * @param[in]  program_id     Program ID
+ * @param[in]  accounts       Account metas (can be NULL if account_count is 0)
+ * @param[in]  account_count  Number of account metas
+ * @param[in]  data_len       Instruction data length
+ * @param[out] cost           Receives the growth
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if a required argument is NULL
+ */
+esp_err_t espsol_tx_instruction_cost(espsol_tx_handle_t tx,
+                                      const uint8_t program_id[ESPSOL_PUBKEY_SIZE],
+                                      const espsol_account_meta_t *accounts,
+                                      size_t account_count,
+                                      size_t data_len,
+                                      espsol_tx_cost_t *cost);
+
+/**
+ * @brief Read a canonical compact-u16
+ *
+ * Rejects overlong encodings and values above 0xFFFF, as the runtime does.
+ *
+ * @param[in]     buf    Buffer
+ * @param[in]     len    Length of buf
+ * @param[in,out] pos    Read position, advanced past the value
+ * @param[out]    value  Receives the value
+ * @return true on success, false if the encoding is truncated or not canonical
+ */
+bool espsol_tx_read_compact_u16(const uint8_t *buf, size_t len, size_t *pos, size_t *value);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ESPSOL_TX_INTERNAL_H */
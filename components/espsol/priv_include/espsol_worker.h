@@ -0,0 +1,81 @@
+/**
+ * @file espsol_worker.h
+ * @brief ESPSOL Background Worker (Internal)
+ *
+ * A single background task that runs one job at a time. Used to prefetch
+ * RPC pages while the caller processes the current one. Backed by a
+ * FreeRTOS task on ESP-IDF and a pthread in host builds.
+ *
+ * @copyright Copyright (c) 2025 SkyRizz
+ * @license Apache-2.0
+ */
+
+#ifndef ESPSOL_WORKER_H
+#define ESPSOL_WORKER_H
+
+#include "espsol_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Stack size for worker tasks that perform RPC requests (bytes)
+ *
+ * Large enough for an HTTPS exchange through esp_http_client.
+ */
+#define ESPSOL_WORKER_STACK_SIZE    6144
+
+/**
+ * @brief Opaque worker handle
+ */
+typedef struct espsol_worker *espsol_worker_t;
+
+/**
+ * @brief Job function run on the worker
+ */
+typedef void (*espsol_worker_fn_t)(void *arg);
+
+/**
+ * @brief Start a worker
+ *
+ * @param[in]  name        Task name (ESP-IDF only)
+ * @param[in]  stack_size  Task stack size in bytes (ESP-IDF only)
+ * @param[out] worker      Created worker
+ * @return
+ *     - ESP_OK on success
+ *     - ESP_ERR_INVALID_ARG if worker is NULL
+ *     - ESP_ERR_NO_MEM if the task could not be created
+ */
+esp_err_t espsol_worker_create(const char *name, uint32_t stack_size, espsol_worker_t *worker);
+
+/**
+ * @brief Run a job on the worker
+ *
+ * Waits for any previous job to finish first.
+ *
+ * @param[in] worker   Worker handle
+ * @param[in] fn       Job function
+ * @param[in] arg      Job argument
+ */
+void espsol_worker_submit(espsol_worker_t worker, espsol_worker_fn_t fn, void *arg);
+
+/**
+ * @brief Wait until the current job (if any) has finished
+ *
+ * @param[in] worker   Worker handle
+ */
+void espsol_worker_wait(espsol_worker_t worker);
+
+/**
+ * @brief Finish the current job and stop the worker
+ *
+ * @param[in] worker   Worker handle (NULL is ignored)
+ */
+void espsol_worker_destroy(espsol_worker_t worker);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ESPSOL_WORKER_H */
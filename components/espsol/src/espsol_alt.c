@@ -0,0 +1,906 @@
+/**
+ * @file espsol_alt.c
+ * @brief ESPSOL Address Lookup Table Implementation
+ *
+ * Lookup table account layout (all integers little-endian):
+ *
+ *   u32 state (1 = lookup table) | u64 deactivation_slot |
+ *   u64 last_extended_slot | u8 last_extended_slot_start_index |
+ *   u8 has_authority | 32 authority | 2 padding | 32 * n addresses
+ *
+ * @copyright Copyright (c) 2025 SkyRizz
+ * @license Apache-2.0
+ */
+
+#include "espsol_alt.h"
+#include "espsol_tx_internal.h"
+#include "espsol_rpc_internal.h"
+#include "espsol_token.h"
+#include "espsol_utils.h"
+#include "espsol_json.h"
+
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+#if defined(ESP_PLATFORM) && ESP_PLATFORM
+#include "esp_log.h"
+static const char *TAG = "espsol_alt";
+#else
+#define ESP_LOGD(tag, ...)
+#define ESP_LOGE(tag, ...)
+#endif
+
+/* Address Lookup Table Program: AddressLookupTab1e1111111111111111111111111 */
+const uint8_t ESPSOL_ADDRESS_LOOKUP_TABLE_PROGRAM_ID[ESPSOL_PUBKEY_SIZE] = {
+    0x02, 0x77, 0xa6, 0xaf, 0x97, 0x33, 0x9b, 0x7a,
+    0xc8, 0x8d, 0x18, 0x92, 0xc9, 0x04, 0x46, 0xf5,
+    0x00, 0x02, 0x30, 0x92, 0x66, 0xf6, 0x2e, 0x53,
+    0xc1, 0x18, 0x24, 0x49, 0x82, 0x00, 0x00, 0x00
+};
+
+/** Program state discriminator of an initialized table */
+#define ALT_STATE_LOOKUP_TABLE  1
+
+/** Message bytes of a lookup: table key plus the two index array lengths */
+#define ALT_LOOKUP_OVERHEAD     (ESPSOL_PUBKEY_SIZE + 2)
+
+/** Bytes saved per account loaded from a table instead of the message */
+#define ALT_ACCOUNT_SAVING      (ESPSOL_PUBKEY_SIZE - 1)
+
+/* Instruction discriminators */
+#define ALT_IX_CREATE           0
+#define ALT_IX_EXTEND           2
+#define ALT_IX_DEACTIVATE       3
+#define ALT_IX_CLOSE            4
+
+/* ============================================================================
+ * Internal Structures
+ * ========================================================================== */
+
+/**
+ * @brief Cached table
+ */
+typedef struct {
+    bool used;                                  /**< Entry holds a table */
+    uint8_t key[ESPSOL_PUBKEY_SIZE];            /**< Table address */
+    espsol_alt_state_t state;                   /**< Decoded header */
+    uint8_t (*addresses)[ESPSOL_PUBKEY_SIZE];   /**< Table contents */
+    size_t usable_count;                        /**< Addresses that can be referenced */
+    uint64_t slot;                              /**< Slot the data was read at */
+} alt_entry_t;
+
+/**
+ * @brief Slot of the address index
+ */
+typedef struct {
+    uint16_t entry;         /**< Entry index + 1 (0 = empty slot) */
+    uint8_t index;          /**< Address index within the table */
+} alt_slot_t;
+
+struct espsol_alt_cache {
+    espsol_alt_cache_config_t config;   /**< Configuration */
+    alt_entry_t *entries;               /**< config.max_tables entries */
+    alt_slot_t *index;                  /**< Open-addressing address index */
+    size_t index_size;                  /**< Slots in index (power of two) */
+};
+
+/* ============================================================================
+ * Internal Helper Functions
+ * ========================================================================== */
+
+static uint64_t get_u64(const uint8_t *p)
+{
+    uint64_t v = 0;
+    for (int i = 7; i >= 0; i--) {
+        v = (v << 8) | p[i];
+    }
+    return v;
+}
+
+static void put_u64(uint8_t *p, uint64_t v)
+{
+    for (int i = 0; i < 8; i++) {
+        p[i] = (uint8_t)(v >> (i * 8));
+    }
+}
+
+/**
+ * @brief FNV-1a hash of a public key
+ */
+static uint32_t hash_pubkey(const uint8_t key[ESPSOL_PUBKEY_SIZE])
+{
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < ESPSOL_PUBKEY_SIZE; i++) {
+        h = (h ^ key[i]) * 16777619u;
+    }
+    return h;
+}
+
+static bool entry_active(const alt_entry_t *entry)
+{
+    return entry->used && entry->state.deactivation_slot == ESPSOL_ALT_ACTIVE;
+}
+
+static alt_entry_t *find_entry(struct espsol_alt_cache *cache, const uint8_t key[ESPSOL_PUBKEY_SIZE])
+{
+    for (size_t i = 0; i < cache->config.max_tables; i++) {
+        if (cache->entries[i].used &&
+            memcmp(cache->entries[i].key, key, ESPSOL_PUBKEY_SIZE) == 0) {
+            return &cache->entries[i];
+        }
+    }
+    return NULL;
+}
+
+static void free_entry(alt_entry_t *entry)
+{
+    free(entry->addresses);
+    memset(entry, 0, sizeof(*entry));
+}
+
+/**
+ * @brief Rebuild the address index over all active tables
+ *
+ * Tables change rarely compared with lookups, so the index is rebuilt
+ * whenever one is added or removed. It is kept at most half full.
+ */
+static esp_err_t rebuild_index(struct espsol_alt_cache *cache)
+{
+    size_t total = 0;
+    for (size_t i = 0; i < cache->config.max_tables; i++) {
+        if (entry_active(&cache->entries[i])) {
+            total += cache->entries[i].usable_count;
+        }
+    }
+
+    size_t size = 16;
+    while (size < total * 2) {
+        size *= 2;
+    }
+
+    if (size != cache->index_size) {
+        alt_slot_t *index = realloc(cache->index, size * sizeof(alt_slot_t));
+        if (!index) {
+            return ESP_ERR_NO_MEM;
+        }
+        cache->index = index;
+        cache->index_size = size;
+    }
+    memset(cache->index, 0, cache->index_size * sizeof(alt_slot_t));
+
+    size_t mask = cache->index_size - 1;
+    for (size_t e = 0; e < cache->config.max_tables; e++) {
+        const alt_entry_t *entry = &cache->entries[e];
+        if (!entry_active(entry)) {
+            continue;
+        }
+        for (size_t k = 0; k < entry->usable_count; k++) {
+            size_t pos = hash_pubkey(entry->addresses[k]) & mask;
+            while (cache->index[pos].entry != 0) {
+                pos = (pos + 1) & mask;
+            }
+            cache->index[pos].entry = (uint16_t)(e + 1);
+            cache->index[pos].index = (uint8_t)k;
+        }
+    }
+    return ESP_OK;
+}
+
+/**
+ * @brief Mark the tables that hold an address in masks
+ */
+static void index_lookup(const struct espsol_alt_cache *cache,
+                         const uint8_t address[ESPSOL_PUBKEY_SIZE],
+                         uint64_t *masks, uint64_t bit)
+{
+    size_t mask = cache->index_size - 1;
+    size_t pos = hash_pubkey(address) & mask;
+
+    while (cache->index[pos].entry != 0) {
+        const alt_slot_t *slot = &cache->index[pos];
+        const alt_entry_t *entry = &cache->entries[slot->entry - 1];
+        if (memcmp(entry->addresses[slot->index], address, ESPSOL_PUBKEY_SIZE) == 0) {
+            masks[slot->entry - 1] |= bit;
+        }
+        pos = (pos + 1) & mask;
+    }
+}
+
+static int popcount64(uint64_t v)
+{
+    int count = 0;
+    while (v) {
+        v &= v - 1;
+        count++;
+    }
+    return count;
+}
+
+/* ============================================================================
+ * Account Decoding
+ * ========================================================================== */
+
+esp_err_t espsol_alt_decode(const uint8_t *data, size_t data_len,
+                            espsol_alt_state_t *state,
+                            const uint8_t (**addresses)[ESPSOL_PUBKEY_SIZE])
+{
+    if (!data || !state) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (data_len < ESPSOL_ALT_HEADER_SIZE ||
+        (data_len - ESPSOL_ALT_HEADER_SIZE) % ESPSOL_PUBKEY_SIZE != 0 ||
+        (data_len - ESPSOL_ALT_HEADER_SIZE) / ESPSOL_PUBKEY_SIZE > ESPSOL_ALT_MAX_ADDRESSES) {
+        return ESP_ERR_ESPSOL_RPC_PARSE_ERROR;
+    }
+
+    uint32_t discriminator = (uint32_t)data[0] | ((uint32_t)data[1] << 8) |
+                             ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+    if (discriminator != ALT_STATE_LOOKUP_TABLE) {
+        return ESP_ERR_ESPSOL_RPC_PARSE_ERROR;
+    }
+
+    state->deactivation_slot = get_u64(data + 4);
+    state->last_extended_slot = get_u64(data + 12);
+    state->last_extended_start_index = data[20];
+    state->has_authority = data[21] != 0;
+    if (state->has_authority) {
+        memcpy(state->authority, data + 22, ESPSOL_PUBKEY_SIZE);
+    } else {
+        memset(state->authority, 0, ESPSOL_PUBKEY_SIZE);
+    }
+    state->address_count = (data_len - ESPSOL_ALT_HEADER_SIZE) / ESPSOL_PUBKEY_SIZE;
+
+    if (addresses) {
+        *addresses = (const uint8_t (*)[ESPSOL_PUBKEY_SIZE])(data + ESPSOL_ALT_HEADER_SIZE);
+    }
+    return ESP_OK;
+}
+
+/* ============================================================================
+ * Lookup Table Cache
+ * ========================================================================== */
+
+esp_err_t espsol_alt_cache_create(const espsol_alt_cache_config_t *config,
+                                  espsol_alt_cache_handle_t *cache)
+{
+    espsol_alt_cache_config_t defaults = ESPSOL_ALT_CACHE_CONFIG_DEFAULT();
+    if (!config) {
+        config = &defaults;
+    }
+
+    /* Entry numbers are stored in 16 bits in the index */
+    if (!cache || config->max_tables == 0 || config->max_tables > UINT16_MAX) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    struct espsol_alt_cache *c = calloc(1, sizeof(struct espsol_alt_cache));
+    if (!c) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    c->config = *config;
+    c->entries = calloc(config->max_tables, sizeof(alt_entry_t));
+    if (!c->entries || rebuild_index(c) != ESP_OK) {
+        free(c->entries);
+        free(c);
+        return ESP_ERR_NO_MEM;
+    }
+
+    *cache = c;
+    return ESP_OK;
+}
+
+esp_err_t espsol_alt_cache_destroy(espsol_alt_cache_handle_t cache)
+{
+    if (!cache) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    for (size_t i = 0; i < cache->config.max_tables; i++) {
+        free_entry(&cache->entries[i]);
+    }
+    free(cache->entries);
+    free(cache->index);
+    free(cache);
+    return ESP_OK;
+}
+
+esp_err_t espsol_alt_cache_put(espsol_alt_cache_handle_t cache,
+                               const uint8_t key[ESPSOL_PUBKEY_SIZE],
+                               const uint8_t *data, size_t data_len,
+                               uint64_t slot)
+{
+    if (!cache || !key || !data) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    espsol_alt_state_t state;
+    const uint8_t (*addresses)[ESPSOL_PUBKEY_SIZE];
+    esp_err_t err = espsol_alt_decode(data, data_len, &state, &addresses);
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    uint8_t (*copy)[ESPSOL_PUBKEY_SIZE] = NULL;
+    if (state.address_count > 0) {
+        copy = malloc(state.address_count * ESPSOL_PUBKEY_SIZE);
+        if (!copy) {
+            return ESP_ERR_NO_MEM;
+        }
+        memcpy(copy, addresses, state.address_count * ESPSOL_PUBKEY_SIZE);
+    }
+
+    alt_entry_t *entry = find_entry(cache, key);
+    if (!entry) {
+        /* Use a free entry, or evict the one read longest ago */
+        entry = &cache->entries[0];
+        for (size_t i = 0; i < cache->config.max_tables; i++) {
+            if (!cache->entries[i].used) {
+                entry = &cache->entries[i];
+                break;
+            }
+            if (cache->entries[i].slot < entry->slot) {
+                entry = &cache->entries[i];
+            }
+        }
+    }
+    free_entry(entry);
+
+    entry->used = true;
+    memcpy(entry->key, key, ESPSOL_PUBKEY_SIZE);
+    entry->state = state;
+    entry->addresses = copy;
+    entry->slot = slot;
+
+    /* Addresses appended in the slot the data was read at are not usable yet */
+    entry->usable_count = state.address_count;
+    if (slot <= state.last_extended_slot &&
+        state.last_extended_start_index < state.address_count) {
+        entry->usable_count = state.last_extended_start_index;
+    }
+
+    ESP_LOGD(TAG, "Cached table with %u addresses at slot %llu",
+             (unsigned)entry->usable_count, (unsigned long long)slot);
+    return rebuild_index(cache);
+}
+
+esp_err_t espsol_alt_cache_get(espsol_alt_cache_handle_t cache,
+                               const uint8_t key[ESPSOL_PUBKEY_SIZE],
+                               espsol_lookup_table_t *table,
+                               espsol_alt_state_t *state)
+{
+    if (!cache || !key || !table) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    const alt_entry_t *entry = find_entry(cache, key);
+    if (!entry) {
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    memcpy(table->key, entry->key, ESPSOL_PUBKEY_SIZE);
+    table->addresses = (const uint8_t (*)[ESPSOL_PUBKEY_SIZE])entry->addresses;
+    table->address_count = entry->usable_count;
+    if (state) {
+        *state = entry->state;
+    }
+    return ESP_OK;
+}
+
+esp_err_t espsol_alt_cache_find(espsol_alt_cache_handle_t cache,
+                                const uint8_t address[ESPSOL_PUBKEY_SIZE],
+                                uint8_t table_key[ESPSOL_PUBKEY_SIZE],
+                                uint8_t *index)
+{
+    if (!cache || !address) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    size_t mask = cache->index_size - 1;
+    size_t pos = hash_pubkey(address) & mask;
+
+    while (cache->index[pos].entry != 0) {
+        const alt_slot_t *slot = &cache->index[pos];
+        const alt_entry_t *entry = &cache->entries[slot->entry - 1];
+        if (memcmp(entry->addresses[slot->index], address, ESPSOL_PUBKEY_SIZE) == 0) {
+            if (table_key) {
+                memcpy(table_key, entry->key, ESPSOL_PUBKEY_SIZE);
+            }
+            if (index) {
+                *index = slot->index;
+            }
+            return ESP_OK;
+        }
+        pos = (pos + 1) & mask;
+    }
+    return ESP_ERR_NOT_FOUND;
+}
+
+esp_err_t espsol_alt_cache_remove(espsol_alt_cache_handle_t cache,
+                                  const uint8_t key[ESPSOL_PUBKEY_SIZE])
+{
+    if (!cache || !key) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    alt_entry_t *entry = find_entry(cache, key);
+    if (!entry) {
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    free_entry(entry);
+    return rebuild_index(cache);
+}
+
+esp_err_t espsol_alt_cache_expire(espsol_alt_cache_handle_t cache,
+                                  uint64_t current_slot,
+                                  size_t *removed)
+{
+    if (!cache) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    size_t count = 0;
+    for (size_t i = 0; i < cache->config.max_tables; i++) {
+        alt_entry_t *entry = &cache->entries[i];
+        if (!entry->used) {
+            continue;
+        }
+        bool stale = cache->config.max_age_slots > 0 &&
+                     current_slot > entry->slot + cache->config.max_age_slots;
+        if (stale || !entry_active(entry)) {
+            free_entry(entry);
+            count++;
+        }
+    }
+
+    if (removed) {
+        *removed = count;
+    }
+    return count > 0 ? rebuild_index(cache) : ESP_OK;
+}
+
+/* ============================================================================
+ * Table Selection
+ * ========================================================================== */
+
+/**
+ * @brief Best combination found so far
+ */
+typedef struct {
+    const uint64_t *masks;                      /**< Candidate accounts per entry */
+    const size_t *entries;                      /**< Entries worth considering */
+    size_t entry_count;                         /**< Number of entries */
+    size_t account_count;                       /**< All accounts of the transaction */
+    size_t current[ESPSOL_MAX_LOOKUP_TABLES];   /**< Combination being built */
+    size_t best[ESPSOL_MAX_LOOKUP_TABLES];      /**< Best combination */
+    size_t best_count;                          /**< Tables in best */
+    int best_saving;                            /**< Bytes saved by best */
+    bool found;                                 /**< best is valid */
+} alt_search_t;
+
+static void search_tables(alt_search_t *search, size_t start, size_t depth, uint64_t covered)
+{
+    size_t loaded = (size_t)popcount64(covered);
+
+    /* Every static key must fit the message */
+    if (search->account_count - loaded <= ESPSOL_MAX_ACCOUNTS) {
+        int saving = (int)loaded * ALT_ACCOUNT_SAVING - (int)depth * ALT_LOOKUP_OVERHEAD;
+        if (!search->found || saving > search->best_saving) {
+            memcpy(search->best, search->current, depth * sizeof(size_t));
+            search->best_count = depth;
+            search->best_saving = saving;
+            search->found = true;
+        }
+    }
+
+    if (depth == ESPSOL_MAX_LOOKUP_TABLES) {
+        return;
+    }
+
+    for (size_t i = start; i < search->entry_count; i++) {
+        uint64_t added = search->masks[search->entries[i]] & ~covered;
+        if (added == 0) {
+            continue;
+        }
+        search->current[depth] = search->entries[i];
+        search_tables(search, i + 1, depth + 1, covered | added);
+    }
+}
+
+esp_err_t espsol_alt_cache_select(espsol_alt_cache_handle_t cache,
+                                  espsol_tx_handle_t tx,
+                                  int *saved)
+{
+    if (!cache || !tx) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    espsol_tx_version_t original;
+    espsol_tx_get_version(tx, &original);
+
+    /* Start from a v0 draft without tables so every account is counted */
+    esp_err_t err = espsol_tx_set_version(tx, ESPSOL_TX_VERSION_LEGACY);
+    if (err == ESP_OK) {
+        err = espsol_tx_set_version(tx, ESPSOL_TX_VERSION_0);
+    }
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    const uint8_t *keys[ESPSOL_MAX_LOADED_ACCOUNTS];
+    size_t key_count = 0;
+    size_t account_count = 0;
+    err = espsol_tx_get_lookup_candidates(tx, keys, ESPSOL_MAX_LOADED_ACCOUNTS,
+                                          &key_count, &account_count);
+    if (err != ESP_OK) {
+        espsol_tx_set_version(tx, original);
+        return err;
+    }
+
+    uint64_t *masks = calloc(cache->config.max_tables, sizeof(uint64_t));
+    size_t *entries = calloc(cache->config.max_tables, sizeof(size_t));
+    if (!masks || !entries) {
+        free(masks);
+        free(entries);
+        espsol_tx_set_version(tx, original);
+        return ESP_ERR_NO_MEM;
+    }
+
+    for (size_t i = 0; i < key_count; i++) {
+        index_lookup(cache, keys[i], masks, (uint64_t)1 << i);
+    }
+
+    /* A table loading a single account costs more than it saves, but may
+     * still be needed to get the static keys under the limit */
+    alt_search_t search = {
+        .masks = masks,
+        .entries = entries,
+        .account_count = account_count,
+    };
+    bool over_limit = account_count > ESPSOL_MAX_ACCOUNTS;
+    for (size_t e = 0; e < cache->config.max_tables; e++) {
+        int loaded = popcount64(masks[e]);
+        if (loaded >= 2 || (over_limit && loaded == 1)) {
+            entries[search.entry_count++] = e;
+        }
+    }
+
+    search_tables(&search, 0, 0, 0);
+
+    /* The version prefix and lookup count byte cost 2 bytes */
+    bool use_tables = search.found && search.best_count > 0 &&
+                      (over_limit || search.best_saving > 2);
+
+    if (!search.found) {
+        err = ESP_ERR_ESPSOL_MAX_ACCOUNTS;
+        espsol_tx_set_version(tx, original);
+    } else if (use_tables) {
+        for (size_t i = 0; i < search.best_count && err == ESP_OK; i++) {
+            const alt_entry_t *entry = &cache->entries[search.best[i]];
+            espsol_lookup_table_t table = {
+                .addresses = (const uint8_t (*)[ESPSOL_PUBKEY_SIZE])entry->addresses,
+                .address_count = entry->usable_count,
+            };
+            memcpy(table.key, entry->key, ESPSOL_PUBKEY_SIZE);
+            err = espsol_tx_add_lookup_table(tx, &table);
+        }
+    } else {
+        err = espsol_tx_set_version(tx, ESPSOL_TX_VERSION_LEGACY);
+    }
+
+    if (saved) {
+        *saved = use_tables ? search.best_saving - 2 : 0;
+    }
+
+    free(masks);
+    free(entries);
+    return err;
+}
+
+/* ============================================================================
+ * RPC Fetch
+ * ========================================================================== */
+
+/** Largest table account */
+#define ALT_DATA_MAX    (ESPSOL_ALT_HEADER_SIZE + ESPSOL_ALT_MAX_ADDRESSES * ESPSOL_PUBKEY_SIZE)
+
+/** Base64 text of the largest table, with quotes */
+#define ALT_B64_MAX     ((ALT_DATA_MAX + 2) / 3 * 4 + 2)
+
+typedef struct {
+    espsol_json_stream_t json;              /**< Streaming reader */
+    char *data;                             /**< Base64 account data */
+    bool data_valid;                        /**< data holds a complete value */
+    bool missing;                           /**< Account does not exist */
+    char owner[ESPSOL_ADDRESS_MAX_LEN + 2]; /**< Owner (JSON string) */
+    char slot[24];                          /**< Context slot */
+    char rpc_error[256];                    /**< JSON-RPC error object */
+    bool has_rpc_error;                     /**< rpc_error is set */
+} alt_fetch_t;
+
+static char *fetch_on_begin(void *ctx, const espsol_json_stream_t *json, char first, size_t *cap)
+{
+    alt_fetch_t *fetch = ctx;
+
+    if (espsol_json_stream_at(json, "result.value")) {
+        fetch->missing = first == 'n';
+        return NULL;
+    }
+    if (espsol_json_stream_at(json, "result.value.data.0")) {
+        *cap = ALT_B64_MAX;
+        return fetch->data;
+    }
+    if (espsol_json_stream_at(json, "result.value.owner")) {
+        *cap = sizeof(fetch->owner) - 1;
+        return fetch->owner;
+    }
+    if (espsol_json_stream_at(json, "result.context.slot")) {
+        *cap = sizeof(fetch->slot) - 1;
+        return fetch->slot;
+    }
+    if (espsol_json_stream_at(json, "error")) {
+        *cap = sizeof(fetch->rpc_error) - 1;
+        return fetch->rpc_error;
+    }
+    return NULL;
+}
+
+static bool fetch_on_end(void *ctx, const espsol_json_stream_t *json,
+                         const char *text, size_t len, bool truncated)
+{
+    alt_fetch_t *fetch = ctx;
+    (void)json;
+
+    if (text == fetch->data) {
+        fetch->data_valid = espsol_json_unquote(fetch->data, len, truncated);
+    } else if (text == fetch->owner) {
+        fetch->owner[len] = '\0';
+    } else if (text == fetch->slot) {
+        fetch->slot[len] = '\0';
+    } else if (text == fetch->rpc_error) {
+        fetch->rpc_error[len] = '\0';
+        fetch->has_rpc_error = true;
+    }
+    return true;
+}
+
+static esp_err_t fetch_sink(void *sink_ctx, int status_code, const char *data, size_t len)
+{
+    alt_fetch_t *fetch = sink_ctx;
+    (void)status_code;
+
+    return espsol_json_stream_feed(&fetch->json, data, len) ?
+           ESP_OK : ESP_ERR_ESPSOL_RPC_PARSE_ERROR;
+}
+
+/**
+ * @brief Check a streamed getAccountInfo response and add the table
+ */
+static esp_err_t fetch_finish(struct espsol_alt_cache *cache, espsol_rpc_handle_t rpc,
+                              const uint8_t key[ESPSOL_PUBKEY_SIZE], alt_fetch_t *fetch)
+{
+    if (fetch->has_rpc_error) {
+        espsol_json_t error = { .ptr = fetch->rpc_error, .len = strlen(fetch->rpc_error) };
+        return espsol_rpc_report_error(rpc, &error);
+    }
+
+    if (fetch->missing) {
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    char program[ESPSOL_ADDRESS_MAX_LEN];
+    espsol_pubkey_to_address(ESPSOL_ADDRESS_LOOKUP_TABLE_PROGRAM_ID, program, sizeof(program));
+
+    uint64_t slot = 0;
+    espsol_json_t owner = { .ptr = fetch->owner, .len = strlen(fetch->owner) };
+    espsol_json_t slot_value = { .ptr = fetch->slot, .len = strlen(fetch->slot) };
+    if (!fetch->data_valid || !espsol_json_string_equals(&owner, program) ||
+        !espsol_json_get_u64(&slot_value, &slot)) {
+        espsol_rpc_set_last_error(rpc, "Account is not an address lookup table");
+        return ESP_ERR_ESPSOL_RPC_PARSE_ERROR;
+    }
+
+    size_t decoded_len = ALT_DATA_MAX;
+    uint8_t *decoded = malloc(decoded_len);
+    if (!decoded) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    esp_err_t err = espsol_base64_decode(fetch->data, decoded, &decoded_len);
+    if (err == ESP_OK) {
+        err = espsol_alt_cache_put(cache, key, decoded, decoded_len, slot);
+    } else {
+        err = ESP_ERR_ESPSOL_RPC_PARSE_ERROR;
+    }
+
+    free(decoded);
+    return err;
+}
+
+esp_err_t espsol_alt_cache_fetch(espsol_alt_cache_handle_t cache,
+                                 espsol_rpc_handle_t rpc,
+                                 const uint8_t key[ESPSOL_PUBKEY_SIZE])
+{
+    if (!cache || !rpc || !key) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    char address[ESPSOL_ADDRESS_MAX_LEN];
+    esp_err_t err = espsol_pubkey_to_address(key, address, sizeof(address));
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    alt_fetch_t *fetch = calloc(1, sizeof(alt_fetch_t));
+    if (!fetch) {
+        return ESP_ERR_NO_MEM;
+    }
+    fetch->data = malloc(ALT_B64_MAX + 1);
+    if (!fetch->data) {
+        free(fetch);
+        return ESP_ERR_NO_MEM;
+    }
+    espsol_json_stream_init(&fetch->json, fetch_on_begin, fetch_on_end, fetch);
+
+    char params[160];
+    snprintf(params, sizeof(params),
+             "[\"%s\",{\"encoding\":\"base64\",\"commitment\":\"%s\"}]",
+             address, espsol_commitment_to_str(espsol_rpc_get_commitment(rpc)));
+
+    err = espsol_rpc_stream_request(rpc, "getAccountInfo", params, fetch_sink, fetch);
+    if (err == ESP_OK && !espsol_json_stream_done(&fetch->json)) {
+        espsol_rpc_set_last_error(rpc, "Truncated getAccountInfo response");
+        err = ESP_ERR_ESPSOL_RPC_PARSE_ERROR;
+    }
+    if (err == ESP_OK) {
+        err = fetch_finish(cache, rpc, key, fetch);
+    }
+
+    free(fetch->data);
+    free(fetch);
+    return err;
+}
+
+/* ============================================================================
+ * Lookup Table Program Instructions
+ * ========================================================================== */
+
+esp_err_t espsol_tx_add_alt_create(espsol_tx_handle_t tx,
+                                   const uint8_t authority[ESPSOL_PUBKEY_SIZE],
+                                   const uint8_t payer[ESPSOL_PUBKEY_SIZE],
+                                   uint64_t recent_slot,
+                                   uint8_t table[ESPSOL_PUBKEY_SIZE])
+{
+    if (!tx || !authority || !payer) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    /* Table address: PDA of [authority, recent_slot (u64 LE)] */
+    uint8_t slot_seed[8];
+    put_u64(slot_seed, recent_slot);
+    const uint8_t *seeds[2] = { authority, slot_seed };
+    const size_t seed_lens[2] = { ESPSOL_PUBKEY_SIZE, sizeof(slot_seed) };
+
+    uint8_t address[ESPSOL_PUBKEY_SIZE];
+    uint8_t bump = 0;
+    esp_err_t err = espsol_token_find_pda(seeds, seed_lens, 2,
+                                          ESPSOL_ADDRESS_LOOKUP_TABLE_PROGRAM_ID,
+                                          address, &bump);
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    espsol_account_meta_t accounts[4] = {
+        { .is_signer = false, .is_writable = true },
+        { .is_signer = true, .is_writable = false },
+        { .is_signer = true, .is_writable = true },
+        { .is_signer = false, .is_writable = false },
+    };
+    memcpy(accounts[0].pubkey, address, ESPSOL_PUBKEY_SIZE);
+    memcpy(accounts[1].pubkey, authority, ESPSOL_PUBKEY_SIZE);
+    memcpy(accounts[2].pubkey, payer, ESPSOL_PUBKEY_SIZE);
+    memcpy(accounts[3].pubkey, ESPSOL_SYSTEM_PROGRAM_ID, ESPSOL_PUBKEY_SIZE);
+
+    /* Data: u32 discriminator, u64 recent_slot, u8 bump_seed */
+    uint8_t data[13] = { ALT_IX_CREATE, 0, 0, 0 };
+    put_u64(data + 4, recent_slot);
+    data[12] = bump;
+
+    err = espsol_tx_add_instruction(tx, ESPSOL_ADDRESS_LOOKUP_TABLE_PROGRAM_ID,
+                                    accounts, 4, data, sizeof(data));
+    if (err == ESP_OK && table) {
+        memcpy(table, address, ESPSOL_PUBKEY_SIZE);
+    }
+    return err;
+}
+
+esp_err_t espsol_tx_add_alt_extend(espsol_tx_handle_t tx,
+                                   const uint8_t table[ESPSOL_PUBKEY_SIZE],
+                                   const uint8_t authority[ESPSOL_PUBKEY_SIZE],
+                                   const uint8_t payer[ESPSOL_PUBKEY_SIZE],
+                                   const uint8_t (*addresses)[ESPSOL_PUBKEY_SIZE],
+                                   size_t address_count)
+{
+    if (!tx || !table || !authority || !payer || !addresses || address_count == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    /* Data: u32 discriminator, u64 count, addresses */
+    size_t data_len = 12 + address_count * ESPSOL_PUBKEY_SIZE;
+    if (address_count > ESPSOL_MAX_INSTRUCTION_DATA / ESPSOL_PUBKEY_SIZE ||
+        data_len > ESPSOL_MAX_INSTRUCTION_DATA) {
+        return ESP_ERR_ESPSOL_BUFFER_TOO_SMALL;
+    }
+
+    uint8_t *data = malloc(data_len);
+    if (!data) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    memset(data, 0, 4);
+    data[0] = ALT_IX_EXTEND;
+    put_u64(data + 4, address_count);
+    memcpy(data + 12, addresses, address_count * ESPSOL_PUBKEY_SIZE);
+
+    espsol_account_meta_t accounts[4] = {
+        { .is_signer = false, .is_writable = true },
+        { .is_signer = true, .is_writable = false },
+        { .is_signer = true, .is_writable = true },
+        { .is_signer = false, .is_writable = false },
+    };
+    memcpy(accounts[0].pubkey, table, ESPSOL_PUBKEY_SIZE);
+    memcpy(accounts[1].pubkey, authority, ESPSOL_PUBKEY_SIZE);
+    memcpy(accounts[2].pubkey, payer, ESPSOL_PUBKEY_SIZE);
+    memcpy(accounts[3].pubkey, ESPSOL_SYSTEM_PROGRAM_ID, ESPSOL_PUBKEY_SIZE);
+
+    esp_err_t err = espsol_tx_add_instruction(tx, ESPSOL_ADDRESS_LOOKUP_TABLE_PROGRAM_ID,
+                                              accounts, 4, data, data_len);
+    free(data);
+    return err;
+}
+
+esp_err_t espsol_tx_add_alt_deactivate(espsol_tx_handle_t tx,
+                                       const uint8_t table[ESPSOL_PUBKEY_SIZE],
+                                       const uint8_t authority[ESPSOL_PUBKEY_SIZE])
+{
+    if (!tx || !table || !authority) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    espsol_account_meta_t accounts[2] = {
+        { .is_signer = false, .is_writable = true },
+        { .is_signer = true, .is_writable = false },
+    };
+    memcpy(accounts[0].pubkey, table, ESPSOL_PUBKEY_SIZE);
+    memcpy(accounts[1].pubkey, authority, ESPSOL_PUBKEY_SIZE);
+
+    const uint8_t data[4] = { ALT_IX_DEACTIVATE, 0, 0, 0 };
+    return espsol_tx_add_instruction(tx, ESPSOL_ADDRESS_LOOKUP_TABLE_PROGRAM_ID,
+                                     accounts, 2, data, sizeof(data));
+}
+
+esp_err_t espsol_tx_add_alt_close(espsol_tx_handle_t tx,
+                                  const uint8_t table[ESPSOL_PUBKEY_SIZE],
+                                  const uint8_t authority[ESPSOL_PUBKEY_SIZE],
+                                  const uint8_t recipient[ESPSOL_PUBKEY_SIZE])
+{
+    if (!tx || !table || !authority || !recipient) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    espsol_account_meta_t accounts[3] = {
+        { .is_signer = false, .is_writable = true },
+        { .is_signer = true, .is_writable = false },
+        { .is_signer = false, .is_writable = true },
+    };
+    memcpy(accounts[0].pubkey, table, ESPSOL_PUBKEY_SIZE);
+    memcpy(accounts[1].pubkey, authority, ESPSOL_PUBKEY_SIZE);
+    memcpy(accounts[2].pubkey, recipient, ESPSOL_PUBKEY_SIZE);
+
+    const uint8_t data[4] = { ALT_IX_CLOSE, 0, 0, 0 };
+    return espsol_tx_add_instruction(tx, ESPSOL_ADDRESS_LOOKUP_TABLE_PROGRAM_ID,
+                                     accounts, 3, data, sizeof(data));
+}
@@ -63,42 +63,42 @@ esp_err_t espsol_base58_encode(const uint8_t *data, size_t data_len,
         return ESP_OK;
     }
 
+    /* Every input byte yields at least one character */
+    if (output_len < data_len + 1) {
+        return ESP_ERR_ESPSOL_BUFFER_TOO_SMALL;
+    }
+
+    /*
+     * The output buffer is the working memory: the input moves to its tail
+     * and the base58 digits (least significant first) grow from the front.
+     * Each input byte adds at least one digit, so if the result fits, the
+     * digits never reach an input byte that has not been consumed yet.
+     */
+    size_t in_off = output_len - data_len;
+    uint8_t *digits = (uint8_t *)output;
+    memmove(digits + in_off, data, data_len);
+
     /* Count leading zeros */
     size_t leading_zeros = 0;
-    while (leading_zeros < data_len && data[leading_zeros] == 0) {
+    while (leading_zeros < data_len && digits[in_off + leading_zeros] == 0) {
         leading_zeros++;
     }
 
-    /* Allocate temporary buffer for base58 conversion */
-    /* Max size: data_len * 138 / 100 + 1 */
-    size_t max_encoded = espsol_base58_encoded_len(data_len);
-    
-    if (output_len < max_encoded) {
-        /* Check if buffer might be too small */
-        /* We'll verify the actual size after encoding */
-    }
-
-    /* Working buffer - we'll build the result in reverse */
-    uint8_t temp[256];  /* Should be enough for most Solana use cases */
-    if (max_encoded > sizeof(temp)) {
-        return ESP_ERR_ESPSOL_BUFFER_TOO_SMALL;
-    }
-    
-    memset(temp, 0, sizeof(temp));
     size_t temp_len = 0;
 
     /* Process the input as a big number, converting to base58 */
     for (size_t i = leading_zeros; i < data_len; i++) {
-        uint32_t carry = data[i];
+        uint32_t carry = digits[in_off + i];
+        size_t limit = in_off + i + 1;  /* First input byte still needed */
         
         /* Multiply existing digits by 256 and add carry */
         for (size_t j = 0; j < temp_len || carry; j++) {
-            if (j >= sizeof(temp)) {
+            if (j >= limit) {
                 return ESP_ERR_ESPSOL_BUFFER_TOO_SMALL;
             }
             
-            carry += 256 * (j < temp_len ? temp[j] : 0);
-            temp[j] = carry % 58;
+            carry += 256 * (j < temp_len ? digits[j] : 0);
+            digits[j] = carry % 58;
             carry /= 58;
             
             if (j >= temp_len) {
@@ -114,14 +114,18 @@ esp_err_t espsol_base58_encode(const uint8_t *data, size_t data_len,
         return ESP_ERR_ESPSOL_BUFFER_TOO_SMALL;
     }
 
-    /* Add leading '1's for each leading zero byte */
+    /* Most significant digit first, after one '1' per leading zero byte */
+    for (size_t i = 0; i < temp_len / 2; i++) {
+        uint8_t digit = digits[i];
+        digits[i] = digits[temp_len - 1 - i];
+        digits[temp_len - 1 - i] = digit;
+    }
+    memmove(output + leading_zeros, digits, temp_len);
     for (size_t i = 0; i < leading_zeros; i++) {
         output[i] = '1';
     }
-
-    /* Copy the base58 digits in reverse order */
-    for (size_t i = 0; i < temp_len; i++) {
-        output[leading_zeros + i] = BASE58_ALPHABET[temp[temp_len - 1 - i]];
+    for (size_t i = leading_zeros; i < total_len; i++) {
+        output[i] = BASE58_ALPHABET[(uint8_t)output[i]];
     }
 
     /* Null terminate */
@@ -150,15 +154,8 @@ esp_err_t espsol_base58_decode(const char *input,
         leading_ones++;
     }
 
-    /* Allocate temporary buffer for binary conversion */
-    size_t max_decoded = espsol_base58_decoded_len(input_len);
-    uint8_t temp[256];  /* Should be enough for most Solana use cases */
-    
-    if (max_decoded > sizeof(temp)) {
-        return ESP_ERR_ESPSOL_BUFFER_TOO_SMALL;
-    }
-    
-    memset(temp, 0, sizeof(temp));
+    /* Bytes (least significant first) are built in the output buffer */
+    size_t capacity = *output_len;
     size_t temp_len = 0;
 
     /* Process each Base58 character */
@@ -174,12 +171,12 @@ esp_err_t espsol_base58_decode(const char *input,
 
         /* Multiply existing digits by 58 and add carry */
         for (size_t j = 0; j < temp_len || carry; j++) {
-            if (j >= sizeof(temp)) {
+            if (j >= capacity) {
                 return ESP_ERR_ESPSOL_BUFFER_TOO_SMALL;
             }
             
-            carry += 58 * (j < temp_len ? temp[j] : 0);
-            temp[j] = carry & 0xFF;
+            carry += 58 * (j < temp_len ? output[j] : 0);
+            output[j] = carry & 0xFF;
             carry >>= 8;
             
             if (j >= temp_len) {
@@ -191,20 +188,19 @@ esp_err_t espsol_base58_decode(const char *input,
     /* Calculate total output length */
     size_t total_len = leading_ones + temp_len;
     
-    if (*output_len < total_len) {
+    if (capacity < total_len) {
         *output_len = total_len;  /* Report required size */
         return ESP_ERR_ESPSOL_BUFFER_TOO_SMALL;
     }
 
-    /* Write leading zeros */
-    for (size_t i = 0; i < leading_ones; i++) {
-        output[i] = 0;
-    }
-
-    /* Copy the binary data in reverse order */
-    for (size_t i = 0; i < temp_len; i++) {
-        output[leading_ones + i] = temp[temp_len - 1 - i];
+    /* Most significant byte first, after the leading zeros */
+    for (size_t i = 0; i < temp_len / 2; i++) {
+        uint8_t byte = output[i];
+        output[i] = output[temp_len - 1 - i];
+        output[temp_len - 1 - i] = byte;
     }
+    memmove(output + leading_ones, output, temp_len);
+    memset(output, 0, leading_ones);
 
     *output_len = total_len;
     return ESP_OK;
@@ -185,3 +185,135 @@ esp_err_t espsol_base64_decode(const char *input,
     *output_len = decoded_len;
     return ESP_OK;
 }
+
+/* ============================================================================
+ * Streaming Writers
+ * ========================================================================== */
+
+static esp_err_t buffer_write(void *ctx, const uint8_t *data, size_t len)
+{
+    espsol_buffer_writer_t *sink = ctx;
+
+    if (len > sink->capacity - sink->len) {
+        return ESP_ERR_ESPSOL_BUFFER_TOO_SMALL;
+    }
+    memcpy(sink->buffer + sink->len, data, len);
+    sink->len += len;
+    return ESP_OK;
+}
+
+void espsol_buffer_writer_init(espsol_buffer_writer_t *sink,
+                               uint8_t *buffer, size_t capacity,
+                               espsol_writer_t *writer)
+{
+    sink->buffer = buffer;
+    sink->capacity = capacity;
+    sink->len = 0;
+    writer->write = buffer_write;
+    writer->ctx = sink;
+}
+
+/**
+ * @brief Pass the encoded characters on to the output writer
+ */
+static esp_err_t base64_flush(espsol_base64_writer_t *enc)
+{
+    if (enc->block_len == 0) {
+        return ESP_OK;
+    }
+    esp_err_t err = enc->out->write(enc->out->ctx, (const uint8_t *)enc->block,
+                                    enc->block_len);
+    enc->block_len = 0;
+    return err;
+}
+
+/**
+ * @brief Encode one 3-byte group into the block
+ */
+static esp_err_t base64_group(espsol_base64_writer_t *enc, uint32_t triple)
+{
+    if ((size_t)enc->block_len + 4 > sizeof(enc->block)) {
+        esp_err_t err = base64_flush(enc);
+        if (err != ESP_OK) {
+            return err;
+        }
+    }
+    char *out = enc->block + enc->block_len;
+    out[0] = BASE64_ALPHABET[(triple >> 18) & 0x3F];
+    out[1] = BASE64_ALPHABET[(triple >> 12) & 0x3F];
+    out[2] = BASE64_ALPHABET[(triple >> 6) & 0x3F];
+    out[3] = BASE64_ALPHABET[triple & 0x3F];
+    enc->block_len += 4;
+    return ESP_OK;
+}
+
+static esp_err_t base64_write(void *ctx, const uint8_t *data, size_t len)
+{
+    espsol_base64_writer_t *enc = ctx;
+    esp_err_t err;
+
+    /* Complete a group started by an earlier write */
+    while (enc->pending_len > 0 && len > 0) {
+        if (enc->pending_len == 2) {
+            uint32_t triple = ((uint32_t)enc->pending[0] << 16) |
+                              ((uint32_t)enc->pending[1] << 8) | data[0];
+            enc->pending_len = 0;
+            err = base64_group(enc, triple);
+            if (err != ESP_OK) {
+                return err;
+            }
+        } else {
+            enc->pending[enc->pending_len++] = data[0];
+        }
+        data++;
+        len--;
+    }
+
+    for (; len >= 3; data += 3, len -= 3) {
+        err = base64_group(enc, ((uint32_t)data[0] << 16) |
+                                ((uint32_t)data[1] << 8) | data[2]);
+        if (err != ESP_OK) {
+            return err;
+        }
+    }
+
+    while (len > 0) {
+        enc->pending[enc->pending_len++] = *data++;
+        len--;
+    }
+    return ESP_OK;
+}
+
+void espsol_base64_writer_init(espsol_base64_writer_t *enc,
+                               const espsol_writer_t *out,
+                               espsol_writer_t *writer)
+{
+    memset(enc, 0, sizeof(*enc));
+    enc->out = out;
+    writer->write = base64_write;
+    writer->ctx = enc;
+}
+
+esp_err_t espsol_base64_writer_finish(espsol_base64_writer_t *enc)
+{
+    if (enc == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (enc->pending_len > 0) {
+        uint32_t val = (uint32_t)enc->pending[0] << 16;
+        if (enc->pending_len == 2) {
+            val |= (uint32_t)enc->pending[1] << 8;
+        }
+        esp_err_t err = base64_group(enc, val);
+        if (err != ESP_OK) {
+            return err;
+        }
+        enc->block[enc->block_len - 1] = BASE64_PAD;
+        if (enc->pending_len == 1) {
+            enc->block[enc->block_len - 2] = BASE64_PAD;
+        }
+        enc->pending_len = 0;
+    }
+    return base64_flush(enc);
+}
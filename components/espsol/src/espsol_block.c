@@ -0,0 +1,510 @@
+/**
+ * @file espsol_block.c
+ * @brief ESPSOL Streaming Block Ingestion Implementation
+ *
+ * getBlock responses are parsed while they arrive: only the base64
+ * transaction, its error and the block summary are kept, one transaction
+ * at a time, so memory use does not depend on block size.
+ *
+ * @copyright Copyright (c) 2025 SkyRizz
+ * @license Apache-2.0
+ */
+
+#include "espsol_rpc.h"
+#include "espsol_rpc_internal.h"
+#include "espsol_tx_internal.h"
+#include "espsol_utils.h"
+#include "espsol_json.h"
+#include "espsol_worker.h"
+
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+#if defined(ESP_PLATFORM) && ESP_PLATFORM
+#include "esp_log.h"
+static const char *TAG = "espsol_block";
+#else
+/* Host compilation stubs */
+#define ESP_LOGW(tag, ...)
+#define ESP_LOGE(tag, ...)
+#endif
+
+/* ============================================================================
+ * Block Parser
+ * ========================================================================== */
+
+/** Base64 text of the largest transaction, with quotes */
+#define BLOCK_TX_B64_MAX    ((ESPSOL_MAX_TX_SIZE + 2) / 3 * 4 + 2)
+
+/**
+ * @brief Matching transaction held back for later delivery
+ */
+typedef struct {
+    uint32_t index;                             /**< Position in the block */
+    uint8_t program;                            /**< Matching program */
+    bool failed;                                /**< Transaction failed */
+    char signature[ESPSOL_SIGNATURE_MAX_LEN];   /**< First signature */
+    char error[128];                            /**< Error JSON */
+    uint8_t *tx;                                /**< Serialized transaction */
+    size_t tx_len;                              /**< Length of tx */
+} block_match_t;
+
+typedef struct {
+    const espsol_block_filter_t *filter;    /**< Filter and callbacks */
+    espsol_json_stream_t json;              /**< Streaming reader */
+    espsol_block_info_t info;               /**< Summary being built */
+    char tx_b64[BLOCK_TX_B64_MAX + 1];      /**< Current transaction (quoted base64) */
+    bool tx_valid;                          /**< tx_b64 holds a complete value */
+    char error[128];                        /**< Current transaction error JSON */
+    char scalar[ESPSOL_ADDRESS_MAX_LEN + 2]; /**< Block summary value */
+    char rpc_error[256];                    /**< JSON-RPC error object */
+    bool has_rpc_error;                     /**< rpc_error is set */
+    uint8_t tx[ESPSOL_MAX_TX_SIZE];         /**< Decoded transaction */
+    esp_err_t cb_err;                       /**< Error that stopped the stream */
+    bool defer;                             /**< Buffer matches instead of calling back */
+    block_match_t *matches;                 /**< Buffered matches */
+    size_t match_count;                     /**< Number of buffered matches */
+    size_t match_bytes;                     /**< Heap held by the buffered matches */
+    bool overflow;                          /**< Matches outgrew the buffer; block not kept */
+} block_parser_t;
+
+/**
+ * @brief Find the first watched program among the account keys
+ *
+ * @return Program index, or -1 if none matches or the transaction is malformed
+ */
+static int match_programs(const espsol_block_filter_t *filter, const uint8_t *tx, size_t len)
+{
+    size_t pos = 0, sig_count, key_count;
+
+    if (!espsol_tx_read_compact_u16(tx, len, &pos, &sig_count) || sig_count == 0 ||
+        pos + sig_count * ESPSOL_SIGNATURE_SIZE > len) {
+        return -1;
+    }
+    pos += sig_count * ESPSOL_SIGNATURE_SIZE;
+
+    /* Versioned messages start with 0x80 | version */
+    if (pos < len && (tx[pos] & 0x80)) {
+        pos++;
+    }
+    pos += 3;   /* Message header */
+
+    if (!espsol_tx_read_compact_u16(tx, len, &pos, &key_count) ||
+        pos + key_count * ESPSOL_PUBKEY_SIZE > len) {
+        return -1;
+    }
+
+    if (filter->program_count == 0) {
+        return 0;
+    }
+
+    const uint8_t *keys = tx + pos;
+    for (size_t k = 0; k < key_count; k++) {
+        for (size_t p = 0; p < filter->program_count; p++) {
+            if (memcmp(keys + k * ESPSOL_PUBKEY_SIZE, filter->programs[p],
+                       ESPSOL_PUBKEY_SIZE) == 0) {
+                return (int)p;
+            }
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Keep a match for delivery after the current block
+ */
+static esp_err_t defer_match(block_parser_t *parser, const espsol_block_tx_t *tx)
+{
+    /* Past the limit the walk streams this block again instead */
+    size_t limit = parser->filter->pipeline_buffer ? parser->filter->pipeline_buffer :
+                   ESPSOL_BLOCK_PIPELINE_BUFFER;
+    size_t bytes = parser->match_bytes + sizeof(block_match_t) + tx->tx_len;
+    if (bytes > limit) {
+        parser->overflow = true;
+        return ESP_ERR_NO_MEM;
+    }
+
+    block_match_t *matches = realloc(parser->matches,
+                                     (parser->match_count + 1) * sizeof(*matches));
+    if (!matches) {
+        parser->overflow = true;
+        return ESP_ERR_NO_MEM;
+    }
+    parser->matches = matches;
+
+    block_match_t *match = &matches[parser->match_count];
+    match->tx = malloc(tx->tx_len);
+    if (!match->tx) {
+        parser->overflow = true;
+        return ESP_ERR_NO_MEM;
+    }
+    parser->match_bytes = bytes;
+    memcpy(match->tx, tx->tx, tx->tx_len);
+    match->tx_len = tx->tx_len;
+    match->index = tx->index;
+    match->program = tx->program;
+    match->failed = tx->failed;
+    strcpy(match->signature, tx->signature);
+    snprintf(match->error, sizeof(match->error), "%s", tx->error);
+    parser->match_count++;
+    return ESP_OK;
+}
+
+/**
+ * @brief Decode and filter the transaction that just ended
+ */
+static esp_err_t process_transaction(block_parser_t *parser, uint32_t index)
+{
+    parser->info.tx_count++;
+
+    if (!parser->tx_valid) {
+        ESP_LOGW(TAG, "Slot %llu tx %u: unreadable transaction skipped",
+                 (unsigned long long)parser->info.slot, (unsigned)index);
+        return ESP_OK;
+    }
+
+    size_t tx_len = sizeof(parser->tx);
+    if (espsol_base64_decode(parser->tx_b64, parser->tx, &tx_len) != ESP_OK) {
+        return ESP_OK;
+    }
+
+    int program = match_programs(parser->filter, parser->tx, tx_len);
+    if (program < 0) {
+        return ESP_OK;
+    }
+
+    espsol_block_tx_t tx = {
+        .slot = parser->info.slot,
+        .index = index,
+        .tx = parser->tx,
+        .tx_len = tx_len,
+        .failed = parser->error[0] != '\0',
+        .error = parser->error,
+        .program = (uint8_t)program,
+    };
+    /* The first signature follows its compact-u16 count (1 byte below 128) */
+    size_t sig_pos = parser->tx[0] & 0x80 ? 2 : 1;
+    espsol_base58_encode(parser->tx + sig_pos, ESPSOL_SIGNATURE_SIZE,
+                         tx.signature, sizeof(tx.signature));
+
+    parser->info.matched++;
+
+    if (parser->defer) {
+        return defer_match(parser, &tx);
+    }
+    return parser->filter->on_transaction(&tx, parser->filter->user_ctx);
+}
+
+static char *block_on_begin(void *ctx, const espsol_json_stream_t *json, char first, size_t *cap)
+{
+    block_parser_t *parser = ctx;
+
+    if (espsol_json_stream_at(json, "result.transactions.#.transaction.0")) {
+        *cap = BLOCK_TX_B64_MAX;
+        return parser->tx_b64;
+    }
+    if (espsol_json_stream_at(json, "result.transactions.#")) {
+        parser->tx_valid = false;
+        parser->error[0] = '\0';
+        return NULL;
+    }
+    if (first != 'n' && espsol_json_stream_at(json, "result.transactions.#.meta.err")) {
+        *cap = sizeof(parser->error) - 1;
+        return parser->error;
+    }
+    if (espsol_json_stream_at(json, "result")) {
+        if (first == 'n') {
+            parser->info.skipped = true;
+        }
+        return NULL;
+    }
+    if (espsol_json_stream_at(json, "result.blockhash") ||
+        espsol_json_stream_at(json, "result.parentSlot") ||
+        espsol_json_stream_at(json, "result.blockHeight") ||
+        espsol_json_stream_at(json, "result.blockTime")) {
+        *cap = sizeof(parser->scalar) - 1;
+        return parser->scalar;
+    }
+    if (espsol_json_stream_at(json, "error")) {
+        *cap = sizeof(parser->rpc_error) - 1;
+        return parser->rpc_error;
+    }
+    return NULL;
+}
+
+static bool block_on_end(void *ctx, const espsol_json_stream_t *json,
+                         const char *text, size_t len, bool truncated)
+{
+    block_parser_t *parser = ctx;
+
+    if (!text) {
+        if (espsol_json_stream_at(json, "result.transactions.#")) {
+            parser->cb_err = process_transaction(parser, espsol_json_stream_index(json, 2));
+            return parser->cb_err == ESP_OK;
+        }
+        return true;
+    }
+
+    if (text == parser->tx_b64) {
+        parser->tx_valid = espsol_json_unquote(parser->tx_b64, len, truncated);
+    } else if (text == parser->error) {
+        parser->error[len] = '\0';
+    } else if (text == parser->rpc_error) {
+        parser->rpc_error[len] = '\0';
+        parser->has_rpc_error = true;
+    } else if (text == parser->scalar) {
+        parser->scalar[len] = '\0';
+        espsol_json_t value = { .ptr = parser->scalar, .len = len };
+        if (truncated) {
+            return true;
+        }
+        if (espsol_json_stream_at(json, "result.blockhash")) {
+            espsol_json_get_string(&value, parser->info.blockhash, sizeof(parser->info.blockhash));
+        } else if (espsol_json_stream_at(json, "result.parentSlot")) {
+            espsol_json_get_u64(&value, &parser->info.parent_slot);
+        } else if (espsol_json_stream_at(json, "result.blockHeight")) {
+            espsol_json_get_u64(&value, &parser->info.block_height);
+        } else {
+            parser->info.has_block_time = espsol_json_get_i64(&value, &parser->info.block_time);
+        }
+    }
+    return true;
+}
+
+static esp_err_t block_sink(void *sink_ctx, int status_code, const char *data, size_t len)
+{
+    block_parser_t *parser = sink_ctx;
+    (void)status_code;
+
+    if (!espsol_json_stream_feed(&parser->json, data, len)) {
+        return parser->cb_err != ESP_OK ? parser->cb_err : ESP_ERR_ESPSOL_RPC_PARSE_ERROR;
+    }
+    return ESP_OK;
+}
+
+static void free_matches(block_parser_t *parser)
+{
+    for (size_t i = 0; i < parser->match_count; i++) {
+        free(parser->matches[i].tx);
+    }
+    free(parser->matches);
+    parser->matches = NULL;
+    parser->match_count = 0;
+    parser->match_bytes = 0;
+}
+
+/**
+ * @brief Deliver matches buffered by a pipelined fetch
+ */
+static esp_err_t deliver_matches(block_parser_t *parser)
+{
+    for (size_t i = 0; i < parser->match_count; i++) {
+        const block_match_t *match = &parser->matches[i];
+        espsol_block_tx_t tx = {
+            .slot = parser->info.slot,
+            .index = match->index,
+            .tx = match->tx,
+            .tx_len = match->tx_len,
+            .failed = match->failed,
+            .error = match->error,
+            .program = match->program,
+        };
+        strcpy(tx.signature, match->signature);
+
+        esp_err_t err = parser->filter->on_transaction(&tx, parser->filter->user_ctx);
+        if (err != ESP_OK) {
+            return err;
+        }
+    }
+    return ESP_OK;
+}
+
+/**
+ * @brief Stream one block through a parser
+ */
+static esp_err_t stream_block(espsol_rpc_handle_t handle, uint64_t slot, block_parser_t *parser)
+{
+    const espsol_block_filter_t *filter = parser->filter;
+    bool defer = parser->defer;
+
+    free_matches(parser);
+    memset(parser, 0, sizeof(*parser));
+    parser->filter = filter;
+    parser->defer = defer;
+    parser->info.slot = slot;
+    espsol_json_stream_init(&parser->json, block_on_begin, block_on_end, parser);
+
+    /* getBlock rejects commitment below confirmed */
+    const char *commitment = espsol_rpc_get_commitment(handle) == ESPSOL_COMMITMENT_FINALIZED ?
+                             "finalized" : "confirmed";
+
+    char params[192];
+    snprintf(params, sizeof(params),
+             "[%llu,{\"encoding\":\"base64\",\"transactionDetails\":\"full\","
+             "\"maxSupportedTransactionVersion\":0,\"rewards\":false,"
+             "\"commitment\":\"%s\"}]",
+             (unsigned long long)slot, commitment);
+
+    esp_err_t err = espsol_rpc_stream_request(handle, "getBlock", params, block_sink, parser);
+    if (err != ESP_OK) {
+        if (err == ESP_ERR_ESPSOL_RPC_PARSE_ERROR) {
+            espsol_rpc_set_last_error(handle, "Malformed getBlock response");
+        }
+        return err;
+    }
+
+    if (!espsol_json_stream_done(&parser->json)) {
+        espsol_rpc_set_last_error(handle, "Truncated getBlock response");
+        return ESP_ERR_ESPSOL_RPC_PARSE_ERROR;
+    }
+
+    if (parser->has_rpc_error) {
+        espsol_json_t error = { .ptr = parser->rpc_error, .len = strlen(parser->rpc_error) };
+        int64_t code = espsol_rpc_error_code(&error);
+
+        /* Skipped slot, or skipped/missing in long-term storage */
+        if (code == -32007 || code == -32009) {
+            parser->info.skipped = true;
+            return ESP_OK;
+        }
+        return espsol_rpc_report_error(handle, &error);
+    }
+
+    return ESP_OK;
+}
+
+/* ============================================================================
+ * Public Functions
+ * ========================================================================== */
+
+esp_err_t espsol_rpc_get_block_stream(espsol_rpc_handle_t handle,
+                                      uint64_t slot,
+                                      const espsol_block_filter_t *filter,
+                                      espsol_block_info_t *info)
+{
+    if (!handle || !filter || !filter->on_transaction ||
+        (filter->program_count > 0 && !filter->programs)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    block_parser_t *parser = calloc(1, sizeof(*parser));
+    if (!parser) {
+        return ESP_ERR_NO_MEM;
+    }
+    parser->filter = filter;
+
+    esp_err_t err = stream_block(handle, slot, parser);
+    if (err == ESP_OK && info) {
+        *info = parser->info;
+    }
+
+    free(parser);
+    return err;
+}
+
+/**
+ * @brief Background fetch of the block after the current one
+ */
+typedef struct {
+    espsol_rpc_handle_t handle;     /**< Pipeline client */
+    uint64_t slot;                  /**< Slot to fetch */
+    block_parser_t *parser;         /**< Parser buffering matches */
+    esp_err_t err;                  /**< Result */
+} block_job_t;
+
+static void block_job(void *arg)
+{
+    block_job_t *job = arg;
+    job->err = stream_block(job->handle, job->slot, job->parser);
+}
+
+esp_err_t espsol_rpc_walk_blocks(espsol_rpc_handle_t handle,
+                                 uint64_t start_slot,
+                                 uint32_t count,
+                                 const espsol_block_filter_t *filter,
+                                 uint64_t *next_slot)
+{
+    if (!handle || !filter || !filter->on_transaction ||
+        (filter->program_count > 0 && !filter->programs)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    uint64_t slot = start_slot;
+    uint64_t end = start_slot + count;
+    esp_err_t err = ESP_OK;
+
+    block_parser_t *parsers = calloc(filter->pipeline ? 2 : 1, sizeof(block_parser_t));
+    espsol_worker_t worker = NULL;
+    if (!parsers) {
+        return ESP_ERR_NO_MEM;
+    }
+    parsers[0].filter = filter;
+
+    if (filter->pipeline) {
+        parsers[1].filter = filter;
+        parsers[1].defer = true;
+        err = espsol_worker_create("espsol_block", ESPSOL_WORKER_STACK_SIZE, &worker);
+        if (err != ESP_OK) {
+            free(parsers);
+            return err;
+        }
+    }
+
+    while (slot < end) {
+        /* Keep the following block in flight on the second client */
+        block_job_t job = { .handle = filter->pipeline, .slot = slot + 1, .parser = &parsers[1] };
+        bool pipelined = worker && slot + 1 < end;
+        if (pipelined) {
+            espsol_worker_submit(worker, block_job, &job);
+        }
+
+        err = stream_block(handle, slot, &parsers[0]);
+        if (pipelined) {
+            espsol_worker_wait(worker);
+        }
+        if (err == ESP_OK && filter->on_block) {
+            err = filter->on_block(&parsers[0].info, filter->user_ctx);
+        }
+        if (err != ESP_OK) {
+            break;
+        }
+        slot++;
+
+        if (pipelined) {
+            err = job.err;
+            if (parsers[1].overflow) {
+                /* Too many matches to hold: stream that block directly next */
+                free_matches(&parsers[1]);
+                err = ESP_OK;
+                continue;
+            }
+            if (err != ESP_OK) {
+                const char *message = espsol_rpc_get_last_error(filter->pipeline);
+                if (message) {
+                    espsol_rpc_set_last_error(handle, message);
+                }
+                break;
+            }
+            err = deliver_matches(&parsers[1]);
+            if (err == ESP_OK && filter->on_block) {
+                err = filter->on_block(&parsers[1].info, filter->user_ctx);
+            }
+            if (err != ESP_OK) {
+                break;
+            }
+            slot++;
+        }
+    }
+
+    if (next_slot) {
+        *next_slot = slot;
+    }
+
+    espsol_worker_destroy(worker);
+    if (filter->pipeline) {
+        free_matches(&parsers[1]);
+    }
+    free(parsers);
+    return err;
+}
@@ -0,0 +1,117 @@
+/**
+ * @file espsol_cancel.c
+ * @brief ESPSOL Deadlines and Cancellation Implementation
+ *
+ * @copyright Copyright (c) 2025 SkyRizz
+ * @license Apache-2.0
+ */
+
+#include "espsol_cancel.h"
+#include "espsol_time.h"
+
+/* ============================================================================
+ * Cancellation Token
+ * ========================================================================== */
+
+void espsol_cancel_token_cancel(espsol_cancel_token_t *token)
+{
+    if (token) {
+        __atomic_store_n(&token->cancelled, 1, __ATOMIC_RELEASE);
+    }
+}
+
+void espsol_cancel_token_reset(espsol_cancel_token_t *token)
+{
+    if (token) {
+        __atomic_store_n(&token->cancelled, 0, __ATOMIC_RELEASE);
+    }
+}
+
+bool espsol_cancel_token_is_cancelled(const espsol_cancel_token_t *token)
+{
+    return token && __atomic_load_n(&token->cancelled, __ATOMIC_ACQUIRE) != 0;
+}
+
+/* ============================================================================
+ * Deadline
+ * ========================================================================== */
+
+void espsol_deadline_start(espsol_deadline_t *deadline,
+                           const espsol_call_options_t *options)
+{
+    if (!deadline) {
+        return;
+    }
+
+    deadline->expires_us = 0;
+    deadline->cancel = NULL;
+
+    if (options) {
+        if (options->deadline_ms > 0) {
+            deadline->expires_us = espsol_time_us() + (int64_t)options->deadline_ms * 1000;
+        }
+        deadline->cancel = options->cancel;
+    }
+}
+
+esp_err_t espsol_deadline_check(const espsol_deadline_t *deadline)
+{
+    if (!deadline) {
+        return ESP_OK;
+    }
+
+    if (espsol_cancel_token_is_cancelled(deadline->cancel)) {
+        return ESP_ERR_ESPSOL_CANCELLED;
+    }
+
+    if (deadline->expires_us != 0 && espsol_time_us() >= deadline->expires_us) {
+        return ESP_ERR_ESPSOL_TIMEOUT;
+    }
+
+    return ESP_OK;
+}
+
+uint32_t espsol_deadline_remaining_ms(const espsol_deadline_t *deadline, uint32_t limit_ms)
+{
+    if (!deadline || deadline->expires_us == 0) {
+        return limit_ms;
+    }
+
+    int64_t remaining_us = deadline->expires_us - espsol_time_us();
+    if (remaining_us <= 0) {
+        return 0;
+    }
+
+    /* Round up so a wait never ends just short of the deadline */
+    int64_t remaining_ms = (remaining_us + 999) / 1000;
+    return remaining_ms < limit_ms ? (uint32_t)remaining_ms : limit_ms;
+}
+
+esp_err_t espsol_deadline_sleep(const espsol_deadline_t *deadline, uint32_t ms)
+{
+    /* Nothing can interrupt the sleep: do it in one go */
+    if (!deadline || (deadline->expires_us == 0 && !deadline->cancel)) {
+        espsol_delay_ms(ms);
+        return ESP_OK;
+    }
+
+    int64_t wake_us = espsol_time_us() + (int64_t)ms * 1000;
+
+    for (;;) {
+        esp_err_t err = espsol_deadline_check(deadline);
+        if (err != ESP_OK) {
+            return err;
+        }
+
+        int64_t left_us = wake_us - espsol_time_us();
+        if (left_us <= 0) {
+            return ESP_OK;
+        }
+
+        uint32_t slice = (uint32_t)((left_us + 999) / 1000);
+        if (deadline->cancel && slice > ESPSOL_CANCEL_POLL_MS) {
+            slice = ESPSOL_CANCEL_POLL_MS;
+        }
+        espsol_delay_ms(espsol_deadline_remaining_ms(deadline, slice));
+    }
+}
@@ -13,6 +13,7 @@
 #include "espsol_crypto.h"
 #include "espsol_utils.h"
 #include <string.h>
+#include <stdlib.h>
 
 /* Platform-specific includes */
 #if defined(ESP_PLATFORM) && ESP_PLATFORM
@@ -27,14 +28,19 @@ static const char *TAG = "espsol_crypto";
 #else
 /* Host compilation - use libsodium if available */
 #include <stdio.h>
-#include <stdlib.h>
-#include <time.h>
 
 #ifdef USE_LIBSODIUM
 #include <sodium.h>
 #else
 /* Minimal Ed25519 implementation for host testing */
 #include "espsol_ed25519.h"
+#include "espsol_sha.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#if defined(__linux__)
+#include <sys/random.h>
+#endif
 #endif
 
 #define LOG_I(fmt, ...) printf("[INFO] " fmt "\n", ##__VA_ARGS__)
@@ -97,17 +103,6 @@ static esp_err_t ed25519_keypair_from_seed(const uint8_t *seed,
     return ESP_OK;
 }
 
-static esp_err_t ed25519_sign(const uint8_t *message, size_t message_len,
-                               const uint8_t *private_key,
-                               uint8_t *signature)
-{
-    unsigned long long sig_len;
-    if (crypto_sign_detached(signature, &sig_len, message, message_len, private_key) != 0) {
-        return ESP_ERR_ESPSOL_CRYPTO_ERROR;
-    }
-    return ESP_OK;
-}
-
 static esp_err_t ed25519_verify(const uint8_t *message, size_t message_len,
                                  const uint8_t *signature,
                                  const uint8_t *public_key)
@@ -118,6 +113,14 @@ static esp_err_t ed25519_verify(const uint8_t *message, size_t message_len,
     return ESP_OK;
 }
 
+static esp_err_t ed25519_verify_batch(const espsol_signed_message_t *items, size_t count)
+{
+    /* libsodium has no batch verification; verify_items() checks the
+     * signatures one by one, so only the built-in backends batch */
+    (void)items; (void)count;
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
 #else /* Host implementation */
 
 esp_err_t espsol_crypto_init(void)
@@ -131,9 +134,6 @@ esp_err_t espsol_crypto_init(void)
         LOG_E("Failed to initialize libsodium");
         return ESP_ERR_ESPSOL_CRYPTO_ERROR;
     }
-#else
-    /* Seed basic RNG for non-crypto random (test only) */
-    srand((unsigned int)time(NULL));
 #endif
 
     s_crypto_initialized = true;
@@ -152,14 +152,32 @@ esp_err_t espsol_random_bytes(uint8_t *buffer, size_t len)
 
 #ifdef USE_LIBSODIUM
     randombytes_buf(buffer, len);
+    return ESP_OK;
 #else
-    /* Fallback: use system random (NOT cryptographically secure - for testing only) */
-    for (size_t i = 0; i < len; i++) {
-        buffer[i] = (uint8_t)(rand() & 0xFF);
-    }
+    /* Keys and batch verification weights need the OS generator; never fall back */
+    while (len > 0) {
+#if defined(__linux__)
+        ssize_t n = getrandom(buffer, len, 0);
+#else
+        ssize_t n = -1;
+        int fd = open("/dev/urandom", O_RDONLY);
+        if (fd >= 0) {
+            n = read(fd, buffer, len);
+            close(fd);
+        }
 #endif
-
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            LOG_E("System random generator unavailable");
+            return ESP_ERR_ESPSOL_CRYPTO_ERROR;
+        }
+        buffer += n;
+        len -= (size_t)n;
+    }
     return ESP_OK;
+#endif
 }
 
 #ifdef USE_LIBSODIUM
@@ -174,17 +192,6 @@ static esp_err_t ed25519_keypair_from_seed(const uint8_t *seed,
     return ESP_OK;
 }
 
-static esp_err_t ed25519_sign(const uint8_t *message, size_t message_len,
-                               const uint8_t *private_key,
-                               uint8_t *signature)
-{
-    unsigned long long sig_len;
-    if (crypto_sign_detached(signature, &sig_len, message, message_len, private_key) != 0) {
-        return ESP_ERR_ESPSOL_CRYPTO_ERROR;
-    }
-    return ESP_OK;
-}
-
 static esp_err_t ed25519_verify(const uint8_t *message, size_t message_len,
                                  const uint8_t *signature,
                                  const uint8_t *public_key)
@@ -195,6 +202,14 @@ static esp_err_t ed25519_verify(const uint8_t *message, size_t message_len,
     return ESP_OK;
 }
 
+static esp_err_t ed25519_verify_batch(const espsol_signed_message_t *items, size_t count)
+{
+    /* libsodium has no batch verification; verify_items() checks the
+     * signatures one by one, so only the built-in backends batch */
+    (void)items; (void)count;
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
 #else /* Portable Ed25519 implementation */
 
 /* Use embedded Ed25519 implementation (TweetNaCl-derived) */
@@ -205,13 +220,6 @@ static esp_err_t ed25519_keypair_from_seed(const uint8_t *seed,
     return espsol_ed25519_keypair_from_seed(seed, public_key, private_key);
 }
 
-static esp_err_t ed25519_sign(const uint8_t *message, size_t message_len,
-                               const uint8_t *private_key,
-                               uint8_t *signature)
-{
-    return espsol_ed25519_sign(message, message_len, private_key, signature);
-}
-
 static esp_err_t ed25519_verify(const uint8_t *message, size_t message_len,
                                  const uint8_t *signature,
                                  const uint8_t *public_key)
@@ -219,10 +227,175 @@ static esp_err_t ed25519_verify(const uint8_t *message, size_t message_len,
     return espsol_ed25519_verify(message, message_len, signature, public_key);
 }
 
+static esp_err_t ed25519_verify_batch(const espsol_signed_message_t *items, size_t count)
+{
+    uint8_t entropy[32];
+    esp_err_t err = espsol_random_bytes(entropy, sizeof(entropy));
+    if (err != ESP_OK) {
+        return err;
+    }
+    return espsol_ed25519_verify_batch(items, count, entropy);
+}
+
 #endif /* USE_LIBSODIUM */
 
 #endif /* ESP_PLATFORM */
 
+/* ============================================================================
+ * Signing Primitives
+ * ============================================================================
+ * Ed25519 signing hashes the message twice,
+ *
+ *   r = H(prefix || M),  R = [r]B,  S = (r + H(R || A || M) * a) mod L
+ *
+ * with a and prefix the two halves of SHA-512(seed). The hashes are fed
+ * incrementally, so a streamed message is never gathered in memory.
+ * ========================================================================== */
+
+#if (defined(ESP_PLATFORM) && ESP_PLATFORM) || defined(USE_LIBSODIUM)
+
+typedef crypto_hash_sha512_state sha512_state_t;
+
+static void sha512_init(sha512_state_t *state)
+{
+    crypto_hash_sha512_init(state);
+}
+
+static void sha512_update(sha512_state_t *state, const uint8_t *data, size_t len)
+{
+    crypto_hash_sha512_update(state, data, len);
+}
+
+static void sha512_final(sha512_state_t *state, uint8_t out[64])
+{
+    crypto_hash_sha512_final(state, out);
+}
+
+static void ed25519_sign_commit(const uint8_t nonce[64], uint8_t r[32], uint8_t R[32])
+{
+    crypto_core_ed25519_scalar_reduce(r, nonce);
+    crypto_scalarmult_ed25519_base_noclamp(R, r);
+}
+
+static void ed25519_sign_finish(const uint8_t challenge[64], const uint8_t scalar[32],
+                                const uint8_t r[32], uint8_t S[32])
+{
+    uint8_t k[32];
+    crypto_core_ed25519_scalar_reduce(k, challenge);
+    crypto_core_ed25519_scalar_mul(k, k, scalar);
+    crypto_core_ed25519_scalar_add(S, k, r);
+    memset(k, 0, sizeof(k));
+}
+
+#else /* Portable Ed25519 implementation */
+
+typedef espsol_sha512_ctx_t sha512_state_t;
+
+static void sha512_init(sha512_state_t *state)
+{
+    espsol_sha512_init(state);
+}
+
+static void sha512_update(sha512_state_t *state, const uint8_t *data, size_t len)
+{
+    espsol_sha512_update(state, data, len);
+}
+
+static void sha512_final(sha512_state_t *state, uint8_t out[64])
+{
+    espsol_sha512_final(state, out);
+}
+
+static void ed25519_sign_commit(const uint8_t nonce[64], uint8_t r[32], uint8_t R[32])
+{
+    espsol_ed25519_sign_commit(nonce, r, R);
+}
+
+static void ed25519_sign_finish(const uint8_t challenge[64], const uint8_t scalar[32],
+                                const uint8_t r[32], uint8_t S[32])
+{
+    espsol_ed25519_sign_finish(challenge, scalar, r, S);
+}
+
+#endif
+
+/**
+ * @brief expanded = SHA-512(seed), with the scalar half clamped
+ */
+static void ed25519_expand(const uint8_t seed[ESPSOL_SEED_SIZE], uint8_t expanded[64])
+{
+    sha512_state_t state;
+
+    sha512_init(&state);
+    sha512_update(&state, seed, ESPSOL_SEED_SIZE);
+    sha512_final(&state, expanded);
+    memset(&state, 0, sizeof(state));
+
+    expanded[0] &= 248;
+    expanded[31] &= 127;
+    expanded[31] |= 64;
+}
+
+static esp_err_t hash_write(void *ctx, const uint8_t *data, size_t len)
+{
+    sha512_update((sha512_state_t *)ctx, data, len);
+    return ESP_OK;
+}
+
+/**
+ * @brief Sign with a cached expansion, hashing the message as it is produced
+ */
+static esp_err_t ed25519_sign_expanded(const uint8_t expanded[64],
+                                       const uint8_t public_key[ESPSOL_PUBKEY_SIZE],
+                                       espsol_message_fn message, void *ctx,
+                                       uint8_t signature[ESPSOL_SIGNATURE_SIZE])
+{
+    sha512_state_t state;
+    espsol_writer_t writer = { hash_write, &state };
+    uint8_t digest[64], r[32];
+
+    /* r = H(prefix || M), R = [r]B */
+    sha512_init(&state);
+    sha512_update(&state, expanded + 32, 32);
+    esp_err_t err = message(ctx, &writer);
+    if (err == ESP_OK) {
+        sha512_final(&state, digest);
+        ed25519_sign_commit(digest, r, signature);
+
+        /* S = (r + H(R || A || M) * a) mod L */
+        sha512_init(&state);
+        sha512_update(&state, signature, 32);
+        sha512_update(&state, public_key, ESPSOL_PUBKEY_SIZE);
+        err = message(ctx, &writer);
+    }
+    if (err == ESP_OK) {
+        sha512_final(&state, digest);
+        ed25519_sign_finish(digest, expanded, r, signature + 32);
+    } else {
+        memset(signature, 0, ESPSOL_SIGNATURE_SIZE);
+    }
+
+    /* The nonce and the hash state are as secret as the key */
+    memset(&state, 0, sizeof(state));
+    memset(digest, 0, sizeof(digest));
+    memset(r, 0, sizeof(r));
+    return err;
+}
+
+typedef struct {
+    const uint8_t *data;
+    size_t len;
+} message_buffer_t;
+
+static esp_err_t write_message_buffer(void *ctx, const espsol_writer_t *writer)
+{
+    const message_buffer_t *buf = (const message_buffer_t *)ctx;
+    if (buf->len == 0) {
+        return ESP_OK;
+    }
+    return writer->write(writer->ctx, buf->data, buf->len);
+}
+
 /* ============================================================================
  * Common Implementation
  * ========================================================================== */
@@ -288,6 +461,7 @@ esp_err_t espsol_keypair_from_seed(const uint8_t seed[ESPSOL_SEED_SIZE],
         return err;
     }
 
+    ed25519_expand(seed, keypair->expanded_key);
     keypair->initialized = true;
     return ESP_OK;
 }
@@ -300,6 +474,7 @@ esp_err_t espsol_keypair_clear(espsol_keypair_t *keypair)
 
     /* Securely clear sensitive data */
     memset(keypair->private_key, 0, sizeof(keypair->private_key));
+    memset(keypair->expanded_key, 0, sizeof(keypair->expanded_key));
     memset(keypair->public_key, 0, sizeof(keypair->public_key));
     keypair->initialized = false;
 
@@ -322,6 +497,7 @@ esp_err_t espsol_keypair_from_private_key(const uint8_t private_key[ESPSOL_PRIVK
     /* Extract public key from private key (last 32 bytes) */
     memcpy(keypair->public_key, private_key + ESPSOL_SEED_SIZE, ESPSOL_PUBKEY_SIZE);
 
+    ed25519_expand(private_key, keypair->expanded_key);
     keypair->initialized = true;
     return ESP_OK;
 }
@@ -406,7 +582,25 @@ esp_err_t espsol_sign(const uint8_t *message, size_t message_len,
         return ESP_ERR_ESPSOL_KEYPAIR_NOT_INIT;
     }
 
-    return ed25519_sign(message, message_len, keypair->private_key, signature);
+    message_buffer_t buf = { message, message_len };
+    return ed25519_sign_expanded(keypair->expanded_key, keypair->public_key,
+                                 write_message_buffer, &buf, signature);
+}
+
+esp_err_t espsol_sign_stream(espsol_message_fn message, void *ctx,
+                              const espsol_keypair_t *keypair,
+                              uint8_t signature[ESPSOL_SIGNATURE_SIZE])
+{
+    if (message == NULL || keypair == NULL || signature == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (!keypair->initialized) {
+        return ESP_ERR_ESPSOL_KEYPAIR_NOT_INIT;
+    }
+
+    return ed25519_sign_expanded(keypair->expanded_key, keypair->public_key,
+                                 message, ctx, signature);
 }
 
 esp_err_t espsol_sign_raw(const uint8_t *message, size_t message_len,
@@ -422,7 +616,15 @@ esp_err_t espsol_sign_raw(const uint8_t *message, size_t message_len,
         return ESP_ERR_INVALID_ARG;
     }
 
-    return ed25519_sign(message, message_len, private_key, signature);
+    /* No cached expansion here: hash the seed for this one signature */
+    uint8_t expanded[64];
+    ed25519_expand(private_key, expanded);
+
+    message_buffer_t buf = { message, message_len };
+    esp_err_t err = ed25519_sign_expanded(expanded, private_key + ESPSOL_SEED_SIZE,
+                                          write_message_buffer, &buf, signature);
+    memset(expanded, 0, sizeof(expanded));
+    return err;
 }
 
 esp_err_t espsol_sign_string(const char *message,
@@ -467,6 +669,74 @@ esp_err_t espsol_verify_keypair(const uint8_t *message, size_t message_len,
     return espsol_verify(message, message_len, signature, keypair->public_key);
 }
 
+/**
+ * @brief Batch check, then one at a time to find the first invalid item
+ */
+static esp_err_t verify_items(const espsol_signed_message_t *items, size_t count,
+                              size_t *invalid_index)
+{
+    if (count > 1) {
+        esp_err_t err = ed25519_verify_batch(items, count);
+        if (err == ESP_OK) {
+            return ESP_OK;
+        }
+    }
+
+    /* One at a time: to find the signature that failed the batch, or
+     * when the backend cannot batch */
+    for (size_t i = 0; i < count; i++) {
+        esp_err_t err = ed25519_verify(items[i].message, items[i].message_len,
+                                       items[i].signature, items[i].public_key);
+        if (err != ESP_OK) {
+            if (invalid_index) {
+                *invalid_index = i;
+            }
+            return err;
+        }
+    }
+    return ESP_OK;
+}
+
+esp_err_t espsol_verify_signers(const uint8_t *message, size_t message_len,
+                                const uint8_t (*signatures)[ESPSOL_SIGNATURE_SIZE],
+                                const uint8_t (*public_keys)[ESPSOL_PUBKEY_SIZE],
+                                size_t count, size_t *invalid_index)
+{
+    if ((count > 0 && (signatures == NULL || public_keys == NULL)) ||
+        (message == NULL && message_len > 0)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    /* Never batched: the cofactored batch equation accepts small-order
+     * components that espsol_verify() and the runtime reject */
+    for (size_t i = 0; i < count; i++) {
+        esp_err_t err = ed25519_verify(message, message_len, signatures[i], public_keys[i]);
+        if (err != ESP_OK) {
+            if (invalid_index) {
+                *invalid_index = i;
+            }
+            return err;
+        }
+    }
+    return ESP_OK;
+}
+
+esp_err_t espsol_verify_batch(const espsol_signed_message_t *items, size_t count,
+                              size_t *invalid_index)
+{
+    if (items == NULL && count > 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    for (size_t i = 0; i < count; i++) {
+        if (items[i].signature == NULL || items[i].public_key == NULL ||
+            (items[i].message == NULL && items[i].message_len > 0)) {
+            return ESP_ERR_INVALID_ARG;
+        }
+    }
+
+    return verify_items(items, count, invalid_index);
+}
+
 esp_err_t espsol_public_key_from_private(const uint8_t private_key[ESPSOL_PRIVKEY_SIZE],
                                           uint8_t public_key[ESPSOL_PUBKEY_SIZE])
 {
@@ -674,6 +944,7 @@ esp_err_t espsol_keypair_load_from_nvs(const char *nvs_key,
     memcpy(keypair->public_key, 
            keypair->private_key + ESPSOL_SEED_SIZE, 
            ESPSOL_PUBKEY_SIZE);
+    ed25519_expand(keypair->private_key, keypair->expanded_key);
     keypair->initialized = true;
     
     LOG_I("Keypair loaded from NVS key: %s", nvs_key);
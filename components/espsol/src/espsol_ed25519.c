@@ -3,7 +3,8 @@
  * @brief Portable Ed25519 Implementation (TweetNaCl-derived)
  *
  * This is a minimal, portable Ed25519 implementation derived from TweetNaCl.
- * Used for host testing when libsodium is not available.
+ * Used for host testing when libsodium is not available and the radix 2^51
+ * backend in espsol_ed25519_fast.c is not selected (see espsol_ed25519.h).
  *
  * On ESP32, the libsodium implementation is used instead (faster, hardware-accelerated).
  *
@@ -11,22 +12,23 @@
  */
 
 #include "espsol_ed25519.h"
+#include "espsol_sha.h"
 #include <string.h>
 #include <stdlib.h>
 
 /* Only compile for non-ESP32 platforms without libsodium */
 #if !defined(ESP_PLATFORM) || !ESP_PLATFORM
-#ifndef USE_LIBSODIUM
+#if !defined(USE_LIBSODIUM) && !ESPSOL_ED25519_FAST
 
 /* ============================================================================
  * TweetNaCl-derived Ed25519 Implementation
  * ============================================================================
  * This is a simplified version of TweetNaCl's Ed25519 implementation.
- * It includes SHA-512, field arithmetic, and curve operations.
+ * It includes field arithmetic and curve operations; SHA-512 comes from
+ * espsol_sha.c.
  * ========================================================================== */
 
 typedef uint8_t u8;
-typedef uint32_t u32;
 typedef uint64_t u64;
 typedef int64_t i64;
 typedef i64 gf[16];
@@ -54,211 +56,6 @@ static const gf I = {
     0xd7a7, 0x3dfb, 0x0099, 0x2b4d, 0xdf0b, 0x4fc1, 0x2480, 0x2b83
 };
 
-/* ============================================================================
- * SHA-512 Implementation
- * ========================================================================== */
-
-static const u64 K[80] = {
-    0x428a2f98d728ae22ULL, 0x7137449123ef65cdULL, 0xb5c0fbcfec4d3b2fULL, 0xe9b5dba58189dbbcULL,
-    0x3956c25bf348b538ULL, 0x59f111f1b605d019ULL, 0x923f82a4af194f9bULL, 0xab1c5ed5da6d8118ULL,
-    0xd807aa98a3030242ULL, 0x12835b0145706fbeULL, 0x243185be4ee4b28cULL, 0x550c7dc3d5ffb4e2ULL,
-    0x72be5d74f27b896fULL, 0x80deb1fe3b1696b1ULL, 0x9bdc06a725c71235ULL, 0xc19bf174cf692694ULL,
-    0xe49b69c19ef14ad2ULL, 0xefbe4786384f25e3ULL, 0x0fc19dc68b8cd5b5ULL, 0x240ca1cc77ac9c65ULL,
-    0x2de92c6f592b0275ULL, 0x4a7484aa6ea6e483ULL, 0x5cb0a9dcbd41fbd4ULL, 0x76f988da831153b5ULL,
-    0x983e5152ee66dfabULL, 0xa831c66d2db43210ULL, 0xb00327c898fb213fULL, 0xbf597fc7beef0ee4ULL,
-    0xc6e00bf33da88fc2ULL, 0xd5a79147930aa725ULL, 0x06ca6351e003826fULL, 0x142929670a0e6e70ULL,
-    0x27b70a8546d22ffcULL, 0x2e1b21385c26c926ULL, 0x4d2c6dfc5ac42aedULL, 0x53380d139d95b3dfULL,
-    0x650a73548baf63deULL, 0x766a0abb3c77b2a8ULL, 0x81c2c92e47edaee6ULL, 0x92722c851482353bULL,
-    0xa2bfe8a14cf10364ULL, 0xa81a664bbc423001ULL, 0xc24b8b70d0f89791ULL, 0xc76c51a30654be30ULL,
-    0xd192e819d6ef5218ULL, 0xd69906245565a910ULL, 0xf40e35855771202aULL, 0x106aa07032bbd1b8ULL,
-    0x19a4c116b8d2d0c8ULL, 0x1e376c085141ab53ULL, 0x2748774cdf8eeb99ULL, 0x34b0bcb5e19b48a8ULL,
-    0x391c0cb3c5c95a63ULL, 0x4ed8aa4ae3418acbULL, 0x5b9cca4f7763e373ULL, 0x682e6ff3d6b2b8a3ULL,
-    0x748f82ee5defb2fcULL, 0x78a5636f43172f60ULL, 0x84c87814a1f0ab72ULL, 0x8cc702081a6439ecULL,
-    0x90befffa23631e28ULL, 0xa4506cebde82bde9ULL, 0xbef9a3f7b2c67915ULL, 0xc67178f2e372532bULL,
-    0xca273eceea26619cULL, 0xd186b8c721c0c207ULL, 0xeada7dd6cde0eb1eULL, 0xf57d4f7fee6ed178ULL,
-    0x06f067aa72176fbaULL, 0x0a637dc5a2c898a6ULL, 0x113f9804bef90daeULL, 0x1b710b35131c471bULL,
-    0x28db77f523047d84ULL, 0x32caab7b40c72493ULL, 0x3c9ebe0a15c9bebcULL, 0x431d67c49c100d4cULL,
-    0x4cc5d4becb3e42b6ULL, 0x597f299cfc657e2aULL, 0x5fcb6fab3ad6faecULL, 0x6c44198c4a475817ULL
-};
-
-static u64 dl64(const u8 *x)
-{
-    u64 u = 0;
-    for (int i = 0; i < 8; i++) u = (u << 8) | x[i];
-    return u;
-}
-
-static void ts64(u8 *x, u64 u)
-{
-    for (int i = 7; i >= 0; i--) { x[i] = u & 0xff; u >>= 8; }
-}
-
-#define R(x, c) ((x) >> (c) | (x) << (64 - (c)))
-#define Ch(x, y, z) (((x) & (y)) ^ (~(x) & (z)))
-#define Maj(x, y, z) (((x) & (y)) ^ ((x) & (z)) ^ ((y) & (z)))
-#define Sigma0(x) (R(x, 28) ^ R(x, 34) ^ R(x, 39))
-#define Sigma1(x) (R(x, 14) ^ R(x, 18) ^ R(x, 41))
-#define sigma0(x) (R(x, 1) ^ R(x, 8) ^ ((x) >> 7))
-#define sigma1(x) (R(x, 19) ^ R(x, 61) ^ ((x) >> 6))
-
-static int sha512_block(u64 *h, const u8 *m, u64 n)
-{
-    u64 a, b, c, d, e, f, g, hh, t1, t2, w[80];
-
-    while (n >= 128) {
-        for (int i = 0; i < 16; i++) w[i] = dl64(m + 8 * i);
-        for (int i = 16; i < 80; i++)
-            w[i] = sigma1(w[i-2]) + w[i-7] + sigma0(w[i-15]) + w[i-16];
-
-        a = h[0]; b = h[1]; c = h[2]; d = h[3];
-        e = h[4]; f = h[5]; g = h[6]; hh = h[7];
-
-        for (int i = 0; i < 80; i++) {
-            t1 = hh + Sigma1(e) + Ch(e, f, g) + K[i] + w[i];
-            t2 = Sigma0(a) + Maj(a, b, c);
-            hh = g; g = f; f = e; e = d + t1;
-            d = c; c = b; b = a; a = t1 + t2;
-        }
-
-        h[0] += a; h[1] += b; h[2] += c; h[3] += d;
-        h[4] += e; h[5] += f; h[6] += g; h[7] += hh;
-
-        m += 128;
-        n -= 128;
-    }
-    return (int)n;
-}
-
-static void sha512(u8 *out, const u8 *m, u64 n)
-{
-    u64 h[8] = {
-        0x6a09e667f3bcc908ULL, 0xbb67ae8584caa73bULL,
-        0x3c6ef372fe94f82bULL, 0xa54ff53a5f1d36f1ULL,
-        0x510e527fade682d1ULL, 0x9b05688c2b3e6c1fULL,
-        0x1f83d9abfb41bd6bULL, 0x5be0cd19137e2179ULL
-    };
-    u8 x[256];
-    u64 b = n;
-
-    sha512_block(h, m, n);
-    m += n;
-    n &= 127;
-    m -= n;
-
-    memset(x, 0, 256);
-    memcpy(x, m, n);
-    x[n] = 128;
-
-    n = 256 - 128 * (n < 112);
-    x[n - 9] = (u8)(b >> 61);
-    ts64(x + n - 8, b << 3);
-    sha512_block(h, x, n);
-
-    for (int i = 0; i < 8; i++) ts64(out + 8 * i, h[i]);
-}
-
-/* ============================================================================
- * SHA-256 Implementation (for PDA derivation)
- * ========================================================================== */
-
-static const u32 K256[64] = {
-    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
-    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
-    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
-    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
-    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
-    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
-    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
-    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
-};
-
-static u32 dl32(const u8 *x)
-{
-    return ((u32)x[0] << 24) | ((u32)x[1] << 16) | ((u32)x[2] << 8) | x[3];
-}
-
-static void ts32(u8 *x, u32 u)
-{
-    x[0] = (u8)(u >> 24);
-    x[1] = (u8)(u >> 16);
-    x[2] = (u8)(u >> 8);
-    x[3] = (u8)u;
-}
-
-#define R32(x, c) (((x) >> (c)) | ((x) << (32 - (c))))
-#define S32(x, c) ((x) >> (c))
-#define Sigma0_256(x) (R32(x, 2) ^ R32(x, 13) ^ R32(x, 22))
-#define Sigma1_256(x) (R32(x, 6) ^ R32(x, 11) ^ R32(x, 25))
-#define sigma0_256(x) (R32(x, 7) ^ R32(x, 18) ^ S32(x, 3))
-#define sigma1_256(x) (R32(x, 17) ^ R32(x, 19) ^ S32(x, 10))
-#define Ch32(x, y, z) (((x) & (y)) ^ (~(x) & (z)))
-#define Maj32(x, y, z) (((x) & (y)) ^ ((x) & (z)) ^ ((y) & (z)))
-
-static void sha256_block(u32 *h, const u8 *m, u64 n)
-{
-    u32 a, b, c, d, e, f, g, hh, t1, t2, w[64];
-
-    while (n >= 64) {
-        for (int i = 0; i < 16; i++) w[i] = dl32(m + 4 * i);
-        for (int i = 16; i < 64; i++)
-            w[i] = sigma1_256(w[i-2]) + w[i-7] + sigma0_256(w[i-15]) + w[i-16];
-
-        a = h[0]; b = h[1]; c = h[2]; d = h[3];
-        e = h[4]; f = h[5]; g = h[6]; hh = h[7];
-
-        for (int i = 0; i < 64; i++) {
-            t1 = hh + Sigma1_256(e) + Ch32(e, f, g) + K256[i] + w[i];
-            t2 = Sigma0_256(a) + Maj32(a, b, c);
-            hh = g; g = f; f = e; e = d + t1;
-            d = c; c = b; b = a; a = t1 + t2;
-        }
-
-        h[0] += a; h[1] += b; h[2] += c; h[3] += d;
-        h[4] += e; h[5] += f; h[6] += g; h[7] += hh;
-
-        m += 64;
-        n -= 64;
-    }
-}
-
-void espsol_sha256(const u8 *data, size_t len, u8 out[32])
-{
-    u32 h[8] = {
-        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
-        0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
-    };
-    u8 x[128];
-    u64 b = len;
-    u64 n = len;
-
-    sha256_block(h, data, n);
-    data += (n / 64) * 64;
-    n &= 63;
-
-    memset(x, 0, 128);
-    memcpy(x, data, n);
-    x[n] = 0x80;
-
-    if (n >= 56) {
-        sha256_block(h, x, 64);
-        memset(x, 0, 64);
-    }
-
-    /* Length in bits at the end */
-    x[63] = (u8)(b << 3);
-    x[62] = (u8)(b >> 5);
-    x[61] = (u8)(b >> 13);
-    x[60] = (u8)(b >> 21);
-    x[59] = (u8)(b >> 29);
-    x[58] = (u8)(b >> 37);
-    x[57] = (u8)(b >> 45);
-    x[56] = (u8)(b >> 53);
-
-    sha256_block(h, x, 64);
-
-    for (int i = 0; i < 8; i++) ts32(out + 4 * i, h[i]);
-}
-
 /* ============================================================================
  * Field Arithmetic
  * ========================================================================== */
@@ -274,7 +71,7 @@ static void car25519(gf o)
         o[i] += (1LL << 16);
         i64 c = o[i] >> 16;
         o[(i + 1) * (i < 15)] += c - 1 + 37 * (c - 1) * (i == 15);
-        o[i] -= c << 16;
+        o[i] -= c * 65536;
     }
 }
 
@@ -322,6 +119,17 @@ static int neq25519(const gf a, const gf b)
     return memcmp(c, d, 32);
 }
 
+/**
+ * @brief 1 if a is zero mod p, 0 otherwise, without branching
+ */
+static int iszero25519(const gf a)
+{
+    u8 d[32], acc = 0;
+    pack25519(d, a);
+    for (int i = 0; i < 32; i++) acc |= d[i];
+    return 1 & ((acc - 1) >> 8);
+}
+
 static u8 par25519(const gf a)
 {
     u8 d[32];
@@ -458,15 +266,22 @@ static void scalarbase(gf p[4], const u8 *s)
     scalarmult(p, q, s);
 }
 
-static int unpackneg(gf r[4], const u8 p[32])
+/**
+ * @brief Recover x from y, constant time
+ *
+ * x = u v^3 (u v^7)^((p - 5) / 8) for u = y^2 - 1, v = d y^2 + 1 squares
+ * to u / v or to -u / v; the second case is fixed by a factor sqrt(-1).
+ * No inversion is needed.
+ *
+ * @return 1 if y is the coordinate of a curve point, 0 otherwise
+ */
+static int recover_x(gf x, const gf y)
 {
-    gf t, chk, num, den, den2, den4, den6;
-    set25519(r[2], gf1);
-    unpack25519(r[1], p);
-    S(num, r[1]);
+    gf t, chk, num, den, den2, den4, den6, xi;
+    S(num, y);
     M(den, num, D);
-    Z(num, num, r[2]);
-    A(den, r[2], den);
+    Z(num, num, gf1);
+    A(den, gf1, den);
 
     S(den2, den);
     S(den4, den2);
@@ -478,20 +293,37 @@ static int unpackneg(gf r[4], const u8 p[32])
     M(t, t, num);
     M(t, t, den);
     M(t, t, den);
-    M(r[0], t, den);
+    M(x, t, den);
 
-    S(chk, r[0]);
+    S(chk, x);
     M(chk, chk, den);
-    if (neq25519(chk, num)) M(r[0], r[0], I);
+    Z(t, chk, num);
+    int m_root = iszero25519(t);
+    A(t, chk, num);
+    int p_root = iszero25519(t);
 
-    S(chk, r[0]);
-    M(chk, chk, den);
-    if (neq25519(chk, num)) return -1;
+    M(xi, x, I);
+    sel25519(x, xi, 1 - m_root);
+    return m_root | p_root;
+}
+
+/**
+ * @brief Decompress a point and negate it, constant time
+ *
+ * @return 0 on success, -1 if the bytes are not a curve point
+ */
+static int unpackneg(gf r[4], const u8 p[32])
+{
+    gf neg;
+    set25519(r[2], gf1);
+    unpack25519(r[1], p);
+    int ok = recover_x(r[0], r[1]);
 
-    if (par25519(r[0]) == (p[31] >> 7)) Z(r[0], gf0, r[0]);
+    Z(neg, gf0, r[0]);
+    sel25519(r[0], neg, 1 ^ par25519(r[0]) ^ (p[31] >> 7));
 
     M(r[3], r[0], r[1]);
-    return 0;
+    return ok - 1;
 }
 
 /* ============================================================================
@@ -513,7 +345,7 @@ static void modL(u8 *r, i64 x[64])
         for (int j = i - 32; j < i - 12; ++j) {
             x[j] += carry - 16 * x[i] * (i64)L[j - (i - 32)];
             carry = (x[j] + 128) >> 8;
-            x[j] -= carry << 8;
+            x[j] -= carry * 256;
         }
         x[i - 12] += carry;
         x[i] = 0;
@@ -543,6 +375,111 @@ static void reduce(u8 *r)
     modL(r, x);
 }
 
+/**
+ * @brief Check that a scalar is below L
+ */
+static int scalar_canonical(const u8 *s)
+{
+    for (int i = 31; i >= 0; --i) {
+        if (s[i] != L[i]) return s[i] < L[i];
+    }
+    return 0;
+}
+
+/* ============================================================================
+ * Batch Verification
+ * ============================================================================
+ * Signatures (R_i, s_i) over messages M_i with h_i = H(R_i || A_i || M_i) are
+ * checked together with random 128-bit weights z_i:
+ *
+ *   [8] ( [sum z_i s_i] B - sum [z_i] R_i - sum [z_i h_i] A_i ) == 0
+ *
+ * The multi-scalar product shares its 252 doublings across all points
+ * (Straus, 4-bit windows), so each signature costs two decompressions
+ * and about a hundred additions instead of two full scalar multiplies.
+ * ========================================================================== */
+
+typedef gf ge[4];
+
+#define WINDOW_ENTRIES 16
+
+static void set_identity(gf p[4])
+{
+    set25519(p[0], gf0);
+    set25519(p[1], gf1);
+    set25519(p[2], gf1);
+    set25519(p[3], gf0);
+}
+
+static void set_point(gf p[4], gf q[4])
+{
+    for (int i = 0; i < 4; i++) set25519(p[i], q[i]);
+}
+
+static int is_identity(gf p[4])
+{
+    return !neq25519(p[0], gf0) && !neq25519(p[1], p[2]);
+}
+
+/**
+ * @brief Fill table[j] = j * p for j < WINDOW_ENTRIES
+ */
+static void window_table(ge *table, gf p[4])
+{
+    set_identity(table[0]);
+    set_point(table[1], p);
+    for (int j = 2; j < WINDOW_ENTRIES; j++) {
+        set_point(table[j], table[j - 1]);
+        add(table[j], p);
+    }
+}
+
+/**
+ * @brief acc = acc + a * b mod L, for a of a_len bytes
+ */
+static void muladd_modL(u8 acc[32], const u8 *a, size_t a_len, const u8 b[32])
+{
+    i64 x[64];
+    for (int i = 0; i < 64; ++i) x[i] = 0;
+    for (int i = 0; i < 32; ++i) x[i] = (u64)acc[i];
+    for (size_t i = 0; i < a_len; ++i)
+        for (int j = 0; j < 32; ++j)
+            x[i + j] += (u64)a[i] * (u64)b[j];
+    modL(acc, x);
+}
+
+/**
+ * @brief sum [scalars[k]] tables[k][1], variable time
+ */
+static void multi_scalarmult(gf p[4], ge *tables, u8 (*scalars)[32], size_t points)
+{
+    set_identity(p);
+    for (int w = 63; w >= 0; --w) {
+        if (w != 63) {
+            for (int d = 0; d < 4; d++) add(p, p);
+        }
+        for (size_t k = 0; k < points; k++) {
+            int digit = (scalars[k][w >> 1] >> ((w & 1) * 4)) & 15;
+            if (digit) add(p, tables[k * WINDOW_ENTRIES + digit]);
+        }
+    }
+}
+
+/**
+ * @brief h = SHA-512(R || A || message), hashed in place without a copy
+ */
+static void challenge_hash(u8 h[64], const u8 R[32], const u8 A[32],
+                           const u8 *message, size_t message_len)
+{
+    espsol_sha512_ctx_t ctx;
+
+    espsol_sha512_init(&ctx);
+    espsol_sha512_update(&ctx, R, 32);
+    espsol_sha512_update(&ctx, A, 32);
+    espsol_sha512_update(&ctx, message, message_len);
+    espsol_sha512_final(&ctx, h);
+}
+
 /* ============================================================================
  * Public API
  * ========================================================================== */
@@ -559,7 +496,7 @@ esp_err_t espsol_ed25519_keypair_from_seed(const uint8_t seed[32],
     gf p[4];
 
     /* Hash the seed to get the secret scalar */
-    sha512(d, seed, 32);
+    espsol_sha512(seed, 32, d);
     d[0] &= 248;
     d[31] &= 127;
     d[31] |= 64;
@@ -575,68 +512,28 @@ esp_err_t espsol_ed25519_keypair_from_seed(const uint8_t seed[32],
     return ESP_OK;
 }
 
-esp_err_t espsol_ed25519_sign(const uint8_t *message, size_t message_len,
-                               const uint8_t private_key[64],
-                               uint8_t signature[64])
+void espsol_ed25519_sign_commit(const uint8_t nonce[64], uint8_t r[32], uint8_t R[32])
 {
-    if (private_key == NULL || signature == NULL) {
-        return ESP_ERR_INVALID_ARG;
-    }
-    if (message == NULL && message_len > 0) {
-        return ESP_ERR_INVALID_ARG;
-    }
-
-    u8 d[64], h[64], r[64];
-    i64 x[64];
+    u8 t[64];
     gf p[4];
 
-    /* Hash private key */
-    sha512(d, private_key, 32);
-    d[0] &= 248;
-    d[31] &= 127;
-    d[31] |= 64;
-
-    /* Compute r = H(prefix || message) */
-    /* Create hash input: d[32..63] || message */
-    size_t hlen = 32 + message_len;
-    u8 *hm = (u8 *)malloc(hlen > 0 ? hlen : 1);
-    if (!hm) return ESP_ERR_ESPSOL_CRYPTO_ERROR;
-
-    memcpy(hm, d + 32, 32);
-    if (message_len > 0 && message != NULL) {
-        memcpy(hm + 32, message, message_len);
-    }
-    sha512(r, hm, hlen);
-    free(hm);
-
-    reduce(r);
-    scalarbase(p, r);
-    pack(signature, p);
-
-    /* Compute S = (r + H(R || A || message) * s) mod L */
-    hlen = 64 + message_len;
-    hm = (u8 *)malloc(hlen > 0 ? hlen : 1);
-    if (!hm) return ESP_ERR_ESPSOL_CRYPTO_ERROR;
-
-    memcpy(hm, signature, 32);
-    memcpy(hm + 32, private_key + 32, 32);
-    if (message_len > 0 && message != NULL) {
-        memcpy(hm + 64, message, message_len);
-    }
-    sha512(h, hm, hlen);
-    free(hm);
-
-    reduce(h);
-
-    for (int i = 0; i < 64; ++i) x[i] = 0;
-    for (int i = 0; i < 32; ++i) x[i] = (u64)r[i];
-    for (int i = 0; i < 32; ++i)
-        for (int j = 0; j < 32; ++j)
-            x[i + j] += (u64)h[i] * (u64)d[j];
+    memcpy(t, nonce, 64);
+    reduce(t);
+    scalarbase(p, t);
+    pack(R, p);
+    memcpy(r, t, 32);
+}
 
-    modL(signature + 32, x);
+void espsol_ed25519_sign_finish(const uint8_t challenge[64], const uint8_t scalar[32],
+                                const uint8_t r[32], uint8_t S[32])
+{
+    u8 k[64], acc[32];
 
-    return ESP_OK;
+    memcpy(k, challenge, 64);
+    reduce(k);
+    memcpy(acc, r, 32);
+    muladd_modL(acc, k, 32, scalar);
+    memcpy(S, acc, 32);
 }
 
 esp_err_t espsol_ed25519_verify(const uint8_t *message, size_t message_len,
@@ -653,23 +550,13 @@ esp_err_t espsol_ed25519_verify(const uint8_t *message, size_t message_len,
     u8 t[32], h[64];
     gf p[4], q[4];
 
-    if (unpackneg(q, public_key)) {
+    /* Non-canonical S would allow malleated signatures */
+    if (!scalar_canonical(signature + 32) || unpackneg(q, public_key)) {
         return ESP_ERR_ESPSOL_SIGNATURE_INVALID;
     }
 
     /* Compute h = H(R || A || message) */
-    size_t hlen = 64 + message_len;
-    u8 *hm = (u8 *)malloc(hlen > 0 ? hlen : 1);
-    if (!hm) return ESP_ERR_ESPSOL_CRYPTO_ERROR;
-
-    memcpy(hm, signature, 32);
-    memcpy(hm + 32, public_key, 32);
-    if (message_len > 0 && message != NULL) {
-        memcpy(hm + 64, message, message_len);
-    }
-    sha512(h, hm, hlen);
-    free(hm);
-
+    challenge_hash(h, signature, public_key, message, message_len);
     reduce(h);
 
     /* Compute P = S*B - h*A */
@@ -686,5 +573,101 @@ esp_err_t espsol_ed25519_verify(const uint8_t *message, size_t message_len,
     return ESP_OK;
 }
 
-#endif /* !USE_LIBSODIUM */
+esp_err_t espsol_ed25519_verify_batch(const espsol_signed_message_t *items, size_t count,
+                                      const uint8_t entropy[32])
+{
+    if ((items == NULL && count > 0) || entropy == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    for (size_t i = 0; i < count; i++) {
+        if (items[i].signature == NULL || items[i].public_key == NULL ||
+            (items[i].message == NULL && items[i].message_len > 0)) {
+            return ESP_ERR_INVALID_ARG;
+        }
+    }
+    if (count == 0) {
+        return ESP_OK;
+    }
+
+    /* Point k: B, then -R_i and -A_i for each signature */
+    size_t points = 1 + 2 * count;
+    ge *tables = (ge *)malloc(points * WINDOW_ENTRIES * sizeof(ge));
+    u8 (*scalars)[32] = (u8 (*)[32])calloc(points, 32);
+    if (!tables || !scalars) {
+        free(tables);
+        free(scalars);
+        return ESP_ERR_ESPSOL_CRYPTO_ERROR;
+    }
+
+    esp_err_t err = ESP_OK;
+    u8 b[32] = {0};
+    gf p[4];
+
+    for (size_t i = 0; i < count && err == ESP_OK; i++) {
+        const u8 *sig = items[i].signature;
+        ge *r_table = tables + (1 + 2 * i) * WINDOW_ENTRIES;
+        ge *a_table = r_table + WINDOW_ENTRIES;
+
+        if (!scalar_canonical(sig + 32) ||
+            unpackneg(p, sig) != 0) {
+            err = ESP_ERR_ESPSOL_SIGNATURE_INVALID;
+            break;
+        }
+        window_table(r_table, p);
+        if (unpackneg(p, items[i].public_key) != 0) {
+            err = ESP_ERR_ESPSOL_SIGNATURE_INVALID;
+            break;
+        }
+        window_table(a_table, p);
+
+        /* h_i = H(R_i || A_i || M_i) */
+        u8 h[64];
+        challenge_hash(h, sig, items[i].public_key, items[i].message, items[i].message_len);
+        reduce(h);
+
+        /* z_i = H(entropy || R_i || s_i || h_i), 128 bits */
+        u8 zin[128], z[64];
+        memcpy(zin, entropy, 32);
+        memcpy(zin + 32, sig, 64);
+        memcpy(zin + 96, h, 32);
+        espsol_sha512(zin, sizeof(zin), z);
+
+        memcpy(scalars[1 + 2 * i], z, 16);
+        muladd_modL(scalars[2 + 2 * i], z, 16, h);
+        muladd_modL(b, z, 16, sig + 32);
+    }
+
+    if (err == ESP_OK) {
+        gf base[4];
+        set25519(base[0], X);
+        set25519(base[1], Y);
+        set25519(base[2], gf1);
+        M(base[3], X, Y);
+        window_table(tables, base);
+        memcpy(scalars[0], b, 32);
+
+        multi_scalarmult(p, tables, scalars, points);
+        for (int d = 0; d < 3; d++) add(p, p);
+        if (!is_identity(p)) {
+            err = ESP_ERR_ESPSOL_SIGNATURE_INVALID;
+        }
+    }
+
+    free(tables);
+    free(scalars);
+    return err;
+}
+
+/* ============================================================================
+ * Point Checks
+ * ========================================================================== */
+
+bool espsol_ed25519_is_on_curve(const uint8_t point[32])
+{
+    gf x, y;
+    unpack25519(y, point);
+    return recover_x(x, y) == 1;
+}
+
+#endif /* !USE_LIBSODIUM && !ESPSOL_ED25519_FAST */
 #endif /* !ESP_PLATFORM */
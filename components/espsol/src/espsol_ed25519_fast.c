@@ -0,0 +1,1177 @@
+/**
+ * @file espsol_ed25519_fast.c
+ * @brief Fast Portable Ed25519 Implementation (radix 2^51)
+ *
+ * Ed25519 for host builds on compilers with unsigned __int128. Field
+ * elements are five 51-bit limbs multiplied into 128-bit products,
+ * multiples of the base point come from a precomputed table and
+ * verification uses sliding-window double-scalar multiplication.
+ *
+ * Key derivation and signing handle secret scalars in constant time: table
+ * entries are selected by masking, never by indexing with secret digits.
+ * Verification only sees public data and may branch on it.
+ *
+ * Define ESPSOL_ED25519_REF to use the TweetNaCl backend in
+ * espsol_ed25519.c instead.
+ *
+ * @copyright Copyright (c) 2025 SkyRizz
+ * @license Apache-2.0
+ */
+
+#include "espsol_ed25519.h"
+#include "espsol_sha.h"
+#include <string.h>
+#include <stdlib.h>
+
+/* Only compile for non-ESP32 platforms without libsodium */
+#if !defined(ESP_PLATFORM) || !ESP_PLATFORM
+#if !defined(USE_LIBSODIUM) && ESPSOL_ED25519_FAST
+
+typedef uint8_t u8;
+typedef uint64_t u64;
+typedef int64_t i64;
+typedef unsigned __int128 u128;
+typedef u64 fe[5];
+
+#define MASK51 ((UINT64_C(1) << 51) - 1)
+
+/* d = -121665/121666 */
+static const fe fe_d = {
+    0x34dca135978a3, 0x1a8283b156ebd, 0x5e7a26001c029, 0x739c663a03cbb, 0x52036cee2b6ff
+};
+static const fe fe_d2 = {
+    0x69b9426b2f159, 0x35050762add7a, 0x3cf44c0038052, 0x6738cc7407977, 0x2406d9dc56dff
+};
+/* sqrt(-1) */
+static const fe fe_sqrtm1 = {
+    0x61b274a0ea0b0, 0x0d5a5fc8f189d, 0x7ef5e9cbd0c60, 0x78595a6804c9e, 0x2b8324804fc1d
+};
+
+/* ============================================================================
+ * Field Arithmetic (mod p = 2^255 - 19)
+ * ============================================================================
+ * Limbs of sums may exceed 51 bits; fe_mul() and fe_sq() accept limbs up
+ * to 2^54 and return them below 2^52. fe_sub() adds 4p before subtracting,
+ * so its second operand must be a product, a sum of two products or a
+ * difference.
+ * ========================================================================== */
+
+static u64 load64(const u8 *s)
+{
+    u64 r = 0;
+    for (int i = 7; i >= 0; i--) r = (r << 8) | s[i];
+    return r;
+}
+
+static void store64(u8 *s, u64 v)
+{
+    for (int i = 0; i < 8; i++) { s[i] = (u8)v; v >>= 8; }
+}
+
+static void fe_0(fe h)
+{
+    for (int i = 0; i < 5; i++) h[i] = 0;
+}
+
+static void fe_1(fe h)
+{
+    fe_0(h);
+    h[0] = 1;
+}
+
+static void fe_copy(fe h, const fe f)
+{
+    for (int i = 0; i < 5; i++) h[i] = f[i];
+}
+
+static void fe_carry(fe h)
+{
+    u64 c;
+    c = h[0] >> 51; h[0] &= MASK51; h[1] += c;
+    c = h[1] >> 51; h[1] &= MASK51; h[2] += c;
+    c = h[2] >> 51; h[2] &= MASK51; h[3] += c;
+    c = h[3] >> 51; h[3] &= MASK51; h[4] += c;
+    c = h[4] >> 51; h[4] &= MASK51; h[0] += 19 * c;
+}
+
+static void fe_add(fe h, const fe f, const fe g)
+{
+    for (int i = 0; i < 5; i++) h[i] = f[i] + g[i];
+}
+
+static void fe_sub(fe h, const fe f, const fe g)
+{
+    h[0] = f[0] + 0x1fffffffffffb4 - g[0];
+    for (int i = 1; i < 5; i++) h[i] = f[i] + 0x1ffffffffffffc - g[i];
+    fe_carry(h);
+}
+
+static void fe_neg(fe h, const fe f)
+{
+    static const fe zero = {0};
+    fe_sub(h, zero, f);
+}
+
+static void fe_mul(fe h, const fe f, const fe g)
+{
+    u64 f0 = f[0], f1 = f[1], f2 = f[2], f3 = f[3], f4 = f[4];
+    u64 g0 = g[0], g1 = g[1], g2 = g[2], g3 = g[3], g4 = g[4];
+    u64 g1_19 = 19 * g1, g2_19 = 19 * g2, g3_19 = 19 * g3, g4_19 = 19 * g4;
+
+    u128 r0 = (u128)f0 * g0 + (u128)f1 * g4_19 + (u128)f2 * g3_19 + (u128)f3 * g2_19 + (u128)f4 * g1_19;
+    u128 r1 = (u128)f0 * g1 + (u128)f1 * g0 + (u128)f2 * g4_19 + (u128)f3 * g3_19 + (u128)f4 * g2_19;
+    u128 r2 = (u128)f0 * g2 + (u128)f1 * g1 + (u128)f2 * g0 + (u128)f3 * g4_19 + (u128)f4 * g3_19;
+    u128 r3 = (u128)f0 * g3 + (u128)f1 * g2 + (u128)f2 * g1 + (u128)f3 * g0 + (u128)f4 * g4_19;
+    u128 r4 = (u128)f0 * g4 + (u128)f1 * g3 + (u128)f2 * g2 + (u128)f3 * g1 + (u128)f4 * g0;
+
+    r1 += (u64)(r0 >> 51); h[0] = (u64)r0 & MASK51;
+    r2 += (u64)(r1 >> 51); h[1] = (u64)r1 & MASK51;
+    r3 += (u64)(r2 >> 51); h[2] = (u64)r2 & MASK51;
+    r4 += (u64)(r3 >> 51); h[3] = (u64)r3 & MASK51;
+    h[4] = (u64)r4 & MASK51;
+    h[0] += 19 * (u64)(r4 >> 51);
+    h[1] += h[0] >> 51;
+    h[0] &= MASK51;
+}
+
+static void fe_sq(fe h, const fe f)
+{
+    u64 f0 = f[0], f1 = f[1], f2 = f[2], f3 = f[3], f4 = f[4];
+    u64 d0 = 2 * f0, d1 = 2 * f1, d2 = 2 * f2, d3 = 2 * f3;
+    u64 f3_19 = 19 * f3, f4_19 = 19 * f4;
+
+    u128 r0 = (u128)f0 * f0 + (u128)d1 * f4_19 + (u128)d2 * f3_19;
+    u128 r1 = (u128)d0 * f1 + (u128)d2 * f4_19 + (u128)f3 * f3_19;
+    u128 r2 = (u128)d0 * f2 + (u128)f1 * f1 + (u128)d3 * f4_19;
+    u128 r3 = (u128)d0 * f3 + (u128)d1 * f2 + (u128)f4 * f4_19;
+    u128 r4 = (u128)d0 * f4 + (u128)d1 * f3 + (u128)f2 * f2;
+
+    r1 += (u64)(r0 >> 51); h[0] = (u64)r0 & MASK51;
+    r2 += (u64)(r1 >> 51); h[1] = (u64)r1 & MASK51;
+    r3 += (u64)(r2 >> 51); h[2] = (u64)r2 & MASK51;
+    r4 += (u64)(r3 >> 51); h[3] = (u64)r3 & MASK51;
+    h[4] = (u64)r4 & MASK51;
+    h[0] += 19 * (u64)(r4 >> 51);
+    h[1] += h[0] >> 51;
+    h[0] &= MASK51;
+}
+
+static void fe_sq_n(fe h, const fe f, int n)
+{
+    fe_sq(h, f);
+    while (--n > 0) fe_sq(h, h);
+}
+
+static void fe_frombytes(fe h, const u8 s[32])
+{
+    u64 t0 = load64(s), t1 = load64(s + 8), t2 = load64(s + 16), t3 = load64(s + 24);
+    h[0] = t0 & MASK51;
+    h[1] = ((t0 >> 51) | (t1 << 13)) & MASK51;
+    h[2] = ((t1 >> 38) | (t2 << 26)) & MASK51;
+    h[3] = ((t2 >> 25) | (t3 << 39)) & MASK51;
+    h[4] = (t3 >> 12) & MASK51;
+}
+
+static void fe_tobytes(u8 s[32], const fe f)
+{
+    u64 t[5], q;
+    fe_copy(t, f);
+    fe_carry(t);
+    fe_carry(t);
+
+    /* q = 1 exactly when t >= p; then subtract p as + 19 - 2^255 */
+    q = (t[0] + 19) >> 51;
+    q = (t[1] + q) >> 51;
+    q = (t[2] + q) >> 51;
+    q = (t[3] + q) >> 51;
+    q = (t[4] + q) >> 51;
+
+    t[0] += 19 * q;
+    t[1] += t[0] >> 51; t[0] &= MASK51;
+    t[2] += t[1] >> 51; t[1] &= MASK51;
+    t[3] += t[2] >> 51; t[2] &= MASK51;
+    t[4] += t[3] >> 51; t[3] &= MASK51;
+    t[4] &= MASK51;
+
+    store64(s, t[0] | (t[1] << 51));
+    store64(s + 8, (t[1] >> 13) | (t[2] << 38));
+    store64(s + 16, (t[2] >> 26) | (t[3] << 25));
+    store64(s + 24, (t[3] >> 39) | (t[4] << 12));
+}
+
+static int fe_isnegative(const fe f)
+{
+    u8 s[32];
+    fe_tobytes(s, f);
+    return s[0] & 1;
+}
+
+static int fe_iszero(const fe f)
+{
+    u8 s[32], acc = 0;
+    fe_tobytes(s, f);
+    for (int i = 0; i < 32; i++) acc |= s[i];
+    return acc == 0;
+}
+
+/**
+ * @brief f = g if b is 1, unchanged if b is 0, without branching
+ */
+static void fe_cmov(fe f, const fe g, u64 b)
+{
+    u64 mask = 0 - b;
+    for (int i = 0; i < 5; i++) f[i] ^= mask & (f[i] ^ g[i]);
+}
+
+/**
+ * @brief z250 = z^(2^250 - 1), z11 = z^11
+ */
+static void fe_pow250(fe z250, fe z11, const fe z)
+{
+    fe t0, t1, t2;
+
+    fe_sq(t0, z);                   /* 2 */
+    fe_sq_n(t1, t0, 2);             /* 8 */
+    fe_mul(t1, z, t1);              /* 9 */
+    fe_mul(z11, t0, t1);            /* 11 */
+    fe_sq(t0, z11);                 /* 22 */
+    fe_mul(t0, t1, t0);             /* 2^5 - 1 */
+    fe_sq_n(t1, t0, 5);
+    fe_mul(t0, t1, t0);             /* 2^10 - 1 */
+    fe_sq_n(t1, t0, 10);
+    fe_mul(t1, t1, t0);             /* 2^20 - 1 */
+    fe_sq_n(t2, t1, 20);
+    fe_mul(t1, t2, t1);             /* 2^40 - 1 */
+    fe_sq_n(t1, t1, 10);
+    fe_mul(t0, t1, t0);             /* 2^50 - 1 */
+    fe_sq_n(t1, t0, 50);
+    fe_mul(t1, t1, t0);             /* 2^100 - 1 */
+    fe_sq_n(t2, t1, 100);
+    fe_mul(t1, t2, t1);             /* 2^200 - 1 */
+    fe_sq_n(t1, t1, 50);
+    fe_mul(z250, t1, t0);           /* 2^250 - 1 */
+}
+
+static void fe_invert(fe out, const fe z)
+{
+    fe t, z11;
+    fe_pow250(t, z11, z);
+    fe_sq_n(t, t, 5);
+    fe_mul(out, t, z11);            /* 2^255 - 21 = p - 2 */
+}
+
+static void fe_pow22523(fe out, const fe z)
+{
+    fe t, z11;
+    fe_pow250(t, z11, z);
+    fe_sq_n(t, t, 2);
+    fe_mul(out, t, z);              /* 2^252 - 3 = (p - 5) / 8 */
+}
+
+/* ============================================================================
+ * Curve Operations
+ * ============================================================================
+ * Extended coordinates (X:Y:Z:T) with x = X/Z, y = Y/Z, xy = T/Z, and the
+ * unified addition formulas for a = -1, which are complete on this curve.
+ * ========================================================================== */
+
+typedef struct { fe X, Y, Z; } ge_p2;
+typedef struct { fe X, Y, Z, T; } ge_p3;
+typedef struct { fe X, Y, Z, T; } ge_p1p1;
+typedef struct { fe yplusx, yminusx, xy2d; } ge_precomp;
+typedef struct { fe YplusX, YminusX, Z, T2d; } ge_cached;
+
+#include "espsol_ed25519_tables.h"
+
+static void ge_p2_0(ge_p2 *h)
+{
+    fe_0(h->X);
+    fe_1(h->Y);
+    fe_1(h->Z);
+}
+
+static void ge_p3_0(ge_p3 *h)
+{
+    fe_0(h->X);
+    fe_1(h->Y);
+    fe_1(h->Z);
+    fe_0(h->T);
+}
+
+static void ge_precomp_0(ge_precomp *h)
+{
+    fe_1(h->yplusx);
+    fe_1(h->yminusx);
+    fe_0(h->xy2d);
+}
+
+static void ge_p3_to_p2(ge_p2 *r, const ge_p3 *p)
+{
+    fe_copy(r->X, p->X);
+    fe_copy(r->Y, p->Y);
+    fe_copy(r->Z, p->Z);
+}
+
+static void ge_p3_to_cached(ge_cached *r, const ge_p3 *p)
+{
+    fe_add(r->YplusX, p->Y, p->X);
+    fe_sub(r->YminusX, p->Y, p->X);
+    fe_copy(r->Z, p->Z);
+    fe_mul(r->T2d, p->T, fe_d2);
+}
+
+static void ge_p1p1_to_p2(ge_p2 *r, const ge_p1p1 *p)
+{
+    fe_mul(r->X, p->X, p->T);
+    fe_mul(r->Y, p->Y, p->Z);
+    fe_mul(r->Z, p->Z, p->T);
+}
+
+static void ge_p1p1_to_p3(ge_p3 *r, const ge_p1p1 *p)
+{
+    fe_mul(r->X, p->X, p->T);
+    fe_mul(r->Y, p->Y, p->Z);
+    fe_mul(r->Z, p->Z, p->T);
+    fe_mul(r->T, p->X, p->Y);
+}
+
+static void ge_p2_dbl(ge_p1p1 *r, const ge_p2 *p)
+{
+    fe t0;
+    fe_sq(r->X, p->X);
+    fe_sq(r->Z, p->Y);
+    fe_sq(r->T, p->Z);
+    fe_add(r->T, r->T, r->T);
+    fe_add(r->Y, p->X, p->Y);
+    fe_sq(t0, r->Y);
+    fe_add(r->Y, r->Z, r->X);
+    fe_sub(r->Z, r->Z, r->X);
+    fe_sub(r->X, t0, r->Y);
+    fe_sub(r->T, r->T, r->Z);
+}
+
+static void ge_p3_dbl(ge_p1p1 *r, const ge_p3 *p)
+{
+    ge_p2 q;
+    ge_p3_to_p2(&q, p);
+    ge_p2_dbl(r, &q);
+}
+
+static void ge_add(ge_p1p1 *r, const ge_p3 *p, const ge_cached *q)
+{
+    fe t0;
+    fe_add(r->X, p->Y, p->X);
+    fe_sub(r->Y, p->Y, p->X);
+    fe_mul(r->Z, r->X, q->YplusX);
+    fe_mul(r->Y, r->Y, q->YminusX);
+    fe_mul(r->T, q->T2d, p->T);
+    fe_mul(r->X, p->Z, q->Z);
+    fe_add(t0, r->X, r->X);
+    fe_sub(r->X, r->Z, r->Y);
+    fe_add(r->Y, r->Z, r->Y);
+    fe_add(r->Z, t0, r->T);
+    fe_sub(r->T, t0, r->T);
+}
+
+static void ge_sub(ge_p1p1 *r, const ge_p3 *p, const ge_cached *q)
+{
+    fe t0;
+    fe_add(r->X, p->Y, p->X);
+    fe_sub(r->Y, p->Y, p->X);
+    fe_mul(r->Z, r->X, q->YminusX);
+    fe_mul(r->Y, r->Y, q->YplusX);
+    fe_mul(r->T, q->T2d, p->T);
+    fe_mul(r->X, p->Z, q->Z);
+    fe_add(t0, r->X, r->X);
+    fe_sub(r->X, r->Z, r->Y);
+    fe_add(r->Y, r->Z, r->Y);
+    fe_sub(r->Z, t0, r->T);
+    fe_add(r->T, t0, r->T);
+}
+
+static void ge_madd(ge_p1p1 *r, const ge_p3 *p, const ge_precomp *q)
+{
+    fe t0;
+    fe_add(r->X, p->Y, p->X);
+    fe_sub(r->Y, p->Y, p->X);
+    fe_mul(r->Z, r->X, q->yplusx);
+    fe_mul(r->Y, r->Y, q->yminusx);
+    fe_mul(r->T, q->xy2d, p->T);
+    fe_add(t0, p->Z, p->Z);
+    fe_sub(r->X, r->Z, r->Y);
+    fe_add(r->Y, r->Z, r->Y);
+    fe_add(r->Z, t0, r->T);
+    fe_sub(r->T, t0, r->T);
+}
+
+static void ge_msub(ge_p1p1 *r, const ge_p3 *p, const ge_precomp *q)
+{
+    fe t0;
+    fe_add(r->X, p->Y, p->X);
+    fe_sub(r->Y, p->Y, p->X);
+    fe_mul(r->Z, r->X, q->yminusx);
+    fe_mul(r->Y, r->Y, q->yplusx);
+    fe_mul(r->T, q->xy2d, p->T);
+    fe_add(t0, p->Z, p->Z);
+    fe_sub(r->X, r->Z, r->Y);
+    fe_add(r->Y, r->Z, r->Y);
+    fe_sub(r->Z, t0, r->T);
+    fe_add(r->T, t0, r->T);
+}
+
+static void ge_p3_tobytes(u8 s[32], const ge_p3 *h)
+{
+    fe recip, x, y;
+    fe_invert(recip, h->Z);
+    fe_mul(x, h->X, recip);
+    fe_mul(y, h->Y, recip);
+    fe_tobytes(s, y);
+    s[31] ^= (u8)(fe_isnegative(x) << 7);
+}
+
+static void ge_p2_tobytes(u8 s[32], const ge_p2 *h)
+{
+    fe recip, x, y;
+    fe_invert(recip, h->Z);
+    fe_mul(x, h->X, recip);
+    fe_mul(y, h->Y, recip);
+    fe_tobytes(s, y);
+    s[31] ^= (u8)(fe_isnegative(x) << 7);
+}
+
+/**
+ * @brief Recover x from y, constant time
+ *
+ * Solves x^2 = u / v for u = y^2 - 1, v = d y^2 + 1 with one
+ * exponentiation and no inversion: x = u v^3 (u v^7)^((p - 5) / 8)
+ * squares to u / v or to -u / v, and the second case is fixed by a
+ * factor sqrt(-1). The sign of x is left to the caller.
+ *
+ * @return 1 if y is the coordinate of a curve point, 0 otherwise
+ */
+static int ge_recover_x(fe x, const fe y)
+{
+    fe one, u, v, v3, vxx, m_check, p_check, x_sqrtm1;
+
+    fe_1(one);
+    fe_sq(u, y);
+    fe_mul(v, u, fe_d);
+    fe_sub(u, u, one);
+    fe_add(v, v, one);
+
+    fe_sq(v3, v);
+    fe_mul(v3, v3, v);
+    fe_sq(x, v3);
+    fe_mul(x, x, v);
+    fe_mul(x, x, u);
+    fe_pow22523(x, x);
+    fe_mul(x, x, v3);
+    fe_mul(x, x, u);
+
+    fe_sq(vxx, x);
+    fe_mul(vxx, vxx, v);
+    fe_sub(m_check, vxx, u);
+    fe_add(p_check, vxx, u);
+    int m_root = fe_iszero(m_check);
+    int p_root = fe_iszero(p_check);
+
+    fe_mul(x_sqrtm1, x, fe_sqrtm1);
+    fe_cmov(x, x_sqrtm1, (u64)(1 - m_root));
+    return m_root | p_root;
+}
+
+/**
+ * @brief Decompress a point and negate it, constant time
+ *
+ * Like libsodium's ge25519_frombytes(), y is not required to be below p
+ * and the point may have small order.
+ *
+ * @return 0 on success, -1 if the bytes are not a curve point
+ */
+static int ge_frombytes_negate(ge_p3 *h, const u8 s[32])
+{
+    fe negx;
+
+    fe_frombytes(h->Y, s);
+    fe_1(h->Z);
+    int ok = ge_recover_x(h->X, h->Y);
+
+    fe_neg(negx, h->X);
+    fe_cmov(h->X, negx, (u64)(1 ^ fe_isnegative(h->X) ^ (s[31] >> 7)));
+
+    fe_mul(h->T, h->X, h->Y);
+    return ok - 1;
+}
+
+/* ============================================================================
+ * Fixed-Base Comb (constant time)
+ * ========================================================================== */
+
+static u8 ct_equal(u8 b, u8 c)
+{
+    u64 x = (u64)(b ^ c);
+    return (u8)((x - 1) >> 63);
+}
+
+static u8 ct_negative(signed char b)
+{
+    return (u8)((u64)(i64)b >> 63);
+}
+
+static void precomp_cmov(ge_precomp *t, const ge_precomp *u, u8 b)
+{
+    fe_cmov(t->yplusx, u->yplusx, b);
+    fe_cmov(t->yminusx, u->yminusx, b);
+    fe_cmov(t->xy2d, u->xy2d, b);
+}
+
+/**
+ * @brief t = b * 256^pos * B for a digit -8 <= b <= 8
+ *
+ * Reads every entry of the row so the access pattern does not depend on b.
+ */
+static void select_precomp(ge_precomp *t, int pos, signed char b)
+{
+    ge_precomp minust;
+    u8 bnegative = ct_negative(b);
+    u8 babs = (u8)(b - 2 * ((-(int)bnegative) & b));
+
+    ge_precomp_0(t);
+    for (int j = 0; j < 8; j++) {
+        precomp_cmov(t, &base_comb[pos][j], ct_equal(babs, (u8)(j + 1)));
+    }
+    fe_copy(minust.yplusx, t->yminusx);
+    fe_copy(minust.yminusx, t->yplusx);
+    fe_neg(minust.xy2d, t->xy2d);
+    precomp_cmov(t, &minust, bnegative);
+}
+
+/**
+ * @brief h = a * B for a scalar with a[31] <= 127
+ *
+ * Writes a in 64 signed radix-16 digits e[i] and sums e[i] 16^i B as
+ * two combs over the table rows: odd digits, four doublings, even digits.
+ */
+static void ge_scalarmult_base(ge_p3 *h, const u8 a[32])
+{
+    signed char e[64];
+    signed char carry = 0;
+    ge_p1p1 r;
+    ge_p2 s;
+    ge_precomp t;
+
+    for (int i = 0; i < 32; i++) {
+        e[2 * i] = (signed char)(a[i] & 15);
+        e[2 * i + 1] = (signed char)((a[i] >> 4) & 15);
+    }
+    for (int i = 0; i < 63; i++) {
+        e[i] = (signed char)(e[i] + carry);
+        carry = (signed char)((e[i] + 8) >> 4);
+        e[i] = (signed char)(e[i] - carry * 16);
+    }
+    e[63] = (signed char)(e[63] + carry);
+
+    ge_p3_0(h);
+    for (int i = 1; i < 64; i += 2) {
+        select_precomp(&t, i / 2, e[i]);
+        ge_madd(&r, h, &t);
+        ge_p1p1_to_p3(h, &r);
+    }
+
+    ge_p3_dbl(&r, h);
+    ge_p1p1_to_p2(&s, &r);
+    ge_p2_dbl(&r, &s);
+    ge_p1p1_to_p2(&s, &r);
+    ge_p2_dbl(&r, &s);
+    ge_p1p1_to_p2(&s, &r);
+    ge_p2_dbl(&r, &s);
+    ge_p1p1_to_p3(h, &r);
+
+    for (int i = 0; i < 64; i += 2) {
+        select_precomp(&t, i / 2, e[i]);
+        ge_madd(&r, h, &t);
+        ge_p1p1_to_p3(h, &r);
+    }
+}
+
+/* ============================================================================
+ * Sliding-Window Multiplication (variable time)
+ * ========================================================================== */
+
+/* Digits of public scalars: odd, |digit| <= 15 for points with an 8-entry
+ * table, <= 63 for the base point and its 32 precomputed odd multiples */
+#define SLIDE_LIMIT 15
+#define SLIDE_LIMIT_BASE 63
+#define ODD_MULTIPLES 8
+
+/**
+ * @brief Rewrite a scalar as sparse odd digits with |r[i]| <= limit
+ */
+static void slide(signed char r[256], const u8 a[32], int limit)
+{
+    for (int i = 0; i < 256; ++i) r[i] = (signed char)(1 & (a[i >> 3] >> (i & 7)));
+
+    for (int i = 0; i < 256; ++i) {
+        if (!r[i]) continue;
+        for (int b = 1; b <= 7 && i + b < 256; ++b) {
+            if (!r[i + b]) continue;
+            int v = r[i + b] * (1 << b);
+            if (r[i] + v <= limit) {
+                r[i] = (signed char)(r[i] + v);
+                r[i + b] = 0;
+            } else if (r[i] - v >= -limit) {
+                r[i] = (signed char)(r[i] - v);
+                for (int k = i + b; k < 256; ++k) {
+                    if (!r[k]) {
+                        r[k] = 1;
+                        break;
+                    }
+                    r[k] = 0;
+                }
+            } else {
+                break;
+            }
+        }
+    }
+}
+
+/**
+ * @brief table[k] = (2k + 1) * p for k < ODD_MULTIPLES
+ */
+static void odd_multiples(ge_cached *table, const ge_p3 *p)
+{
+    ge_p1p1 t;
+    ge_p3 p2, u;
+
+    ge_p3_to_cached(&table[0], p);
+    ge_p3_dbl(&t, p);
+    ge_p1p1_to_p3(&p2, &t);
+    for (int k = 1; k < ODD_MULTIPLES; k++) {
+        ge_add(&t, &p2, &table[k - 1]);
+        ge_p1p1_to_p3(&u, &t);
+        ge_p3_to_cached(&table[k], &u);
+    }
+}
+
+/**
+ * @brief t = t + digit * point, for a digit from slide()
+ */
+static void add_digit(ge_p1p1 *t, const ge_cached *table, int digit)
+{
+    ge_p3 u;
+    ge_p1p1_to_p3(&u, t);
+    if (digit > 0) {
+        ge_add(t, &u, &table[digit / 2]);
+    } else {
+        ge_sub(t, &u, &table[-digit / 2]);
+    }
+}
+
+static void add_base_digit(ge_p1p1 *t, int digit)
+{
+    ge_p3 u;
+    ge_p1p1_to_p3(&u, t);
+    if (digit > 0) {
+        ge_madd(t, &u, &base_odd[digit / 2]);
+    } else {
+        ge_msub(t, &u, &base_odd[-digit / 2]);
+    }
+}
+
+/**
+ * @brief r = a * A + b * B
+ */
+static void ge_double_scalarmult_vartime(ge_p2 *r, const u8 a[32], const ge_p3 *A,
+                                         const u8 b[32])
+{
+    signed char aslide[256], bslide[256];
+    ge_cached Ai[ODD_MULTIPLES];
+    ge_p1p1 t;
+    int i;
+
+    slide(aslide, a, SLIDE_LIMIT);
+    slide(bslide, b, SLIDE_LIMIT_BASE);
+    odd_multiples(Ai, A);
+
+    ge_p2_0(r);
+    for (i = 255; i >= 0; --i) {
+        if (aslide[i] || bslide[i]) break;
+    }
+
+    for (; i >= 0; --i) {
+        ge_p2_dbl(&t, r);
+        if (aslide[i]) add_digit(&t, Ai, aslide[i]);
+        if (bslide[i]) add_base_digit(&t, bslide[i]);
+        ge_p1p1_to_p2(r, &t);
+    }
+}
+
+/* ============================================================================
+ * Modular Reduction (L = 2^252 + 27742317777372353535851937790883648493)
+ * ========================================================================== */
+
+static const i64 L[32] = {
+    0xed, 0xd3, 0xf5, 0x5c, 0x1a, 0x63, 0x12, 0x58,
+    0xd6, 0x9c, 0xf7, 0xa2, 0xde, 0xf9, 0xde, 0x14,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0x10
+};
+
+static void modL(u8 *r, i64 x[64])
+{
+    i64 carry;
+    for (int i = 63; i >= 32; --i) {
+        carry = 0;
+        for (int j = i - 32; j < i - 12; ++j) {
+            x[j] += carry - 16 * x[i] * L[j - (i - 32)];
+            carry = (x[j] + 128) >> 8;
+            x[j] -= carry * 256;
+        }
+        x[i - 12] += carry;
+        x[i] = 0;
+    }
+
+    carry = 0;
+    for (int j = 0; j < 32; ++j) {
+        x[j] += carry - (x[31] >> 4) * L[j];
+        carry = x[j] >> 8;
+        x[j] &= 255;
+    }
+
+    for (int j = 0; j < 32; ++j)
+        x[j] -= carry * L[j];
+
+    for (int i = 0; i < 32; ++i) {
+        x[i + 1] += x[i] >> 8;
+        r[i] = (u8)(x[i] & 255);
+    }
+}
+
+static void reduce(u8 *r)
+{
+    i64 x[64];
+    for (int i = 0; i < 64; ++i) x[i] = (u64)r[i];
+    for (int i = 0; i < 64; ++i) r[i] = 0;
+    modL(r, x);
+}
+
+/**
+ * @brief acc = acc + a * b mod L, for a of a_len bytes
+ */
+static void muladd_modL(u8 acc[32], const u8 *a, size_t a_len, const u8 b[32])
+{
+    i64 x[64];
+    for (int i = 0; i < 64; ++i) x[i] = 0;
+    for (int i = 0; i < 32; ++i) x[i] = (u64)acc[i];
+    for (size_t i = 0; i < a_len; ++i)
+        for (int j = 0; j < 32; ++j)
+            x[i + j] += (u64)a[i] * (u64)b[j];
+    modL(acc, x);
+}
+
+/**
+ * @brief Check that a scalar is below L
+ */
+static int scalar_canonical(const u8 *s)
+{
+    for (int i = 31; i >= 0; --i) {
+        if (s[i] != L[i]) return s[i] < L[i];
+    }
+    return 0;
+}
+
+/**
+ * @brief h = SHA-512(R || A || message), hashed in place without a copy
+ */
+static void challenge_hash(u8 h[64], const u8 R[32], const u8 A[32],
+                           const u8 *message, size_t message_len)
+{
+    espsol_sha512_ctx_t ctx;
+
+    espsol_sha512_init(&ctx);
+    espsol_sha512_update(&ctx, R, 32);
+    espsol_sha512_update(&ctx, A, 32);
+    espsol_sha512_update(&ctx, message, message_len);
+    espsol_sha512_final(&ctx, h);
+}
+
+/* ============================================================================
+ * Public API
+ * ========================================================================== */
+
+esp_err_t espsol_ed25519_keypair_from_seed(const uint8_t seed[32],
+                                            uint8_t public_key[32],
+                                            uint8_t private_key[64])
+{
+    if (seed == NULL || public_key == NULL || private_key == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    u8 d[64];
+    ge_p3 A;
+
+    /* Hash the seed to get the secret scalar */
+    espsol_sha512(seed, 32, d);
+    d[0] &= 248;
+    d[31] &= 127;
+    d[31] |= 64;
+
+    /* Compute public key as d * B */
+    ge_scalarmult_base(&A, d);
+    ge_p3_tobytes(public_key, &A);
+
+    /* Private key = seed || public_key */
+    memcpy(private_key, seed, 32);
+    memcpy(private_key + 32, public_key, 32);
+
+    return ESP_OK;
+}
+
+void espsol_ed25519_sign_commit(const uint8_t nonce[64], uint8_t r[32], uint8_t R[32])
+{
+    u8 t[64];
+    ge_p3 P;
+
+    memcpy(t, nonce, 64);
+    reduce(t);
+    ge_scalarmult_base(&P, t);
+    ge_p3_tobytes(R, &P);
+    memcpy(r, t, 32);
+}
+
+void espsol_ed25519_sign_finish(const uint8_t challenge[64], const uint8_t scalar[32],
+                                const uint8_t r[32], uint8_t S[32])
+{
+    u8 k[64], acc[32];
+
+    memcpy(k, challenge, 64);
+    reduce(k);
+    memcpy(acc, r, 32);
+    muladd_modL(acc, k, 32, scalar);
+    memcpy(S, acc, 32);
+}
+
+esp_err_t espsol_ed25519_verify(const uint8_t *message, size_t message_len,
+                                 const uint8_t signature[64],
+                                 const uint8_t public_key[32])
+{
+    if (signature == NULL || public_key == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (message == NULL && message_len > 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    u8 t[32], h[64];
+    ge_p3 A;
+    ge_p2 R;
+
+    /* Non-canonical S would allow malleated signatures */
+    if (!scalar_canonical(signature + 32) ||
+        ge_frombytes_negate(&A, public_key) != 0) {
+        return ESP_ERR_ESPSOL_SIGNATURE_INVALID;
+    }
+
+    /* Compute h = H(R || A || message) */
+    challenge_hash(h, signature, public_key, message, message_len);
+    reduce(h);
+
+    /* Compute R' = S*B - h*A (A was negated on decompression) */
+    ge_double_scalarmult_vartime(&R, h, &A, signature + 32);
+    ge_p2_tobytes(t, &R);
+
+    /* Verify R == R' */
+    if (memcmp(signature, t, 32) != 0) {
+        return ESP_ERR_ESPSOL_SIGNATURE_INVALID;
+    }
+
+    return ESP_OK;
+}
+
+/* ============================================================================
+ * Batch Verification
+ * ============================================================================
+ * Same equation as the reference backend,
+ *
+ *   [8] ( [sum z_i s_i] B - sum [z_i] R_i - sum [z_i h_i] A_i ) == 0
+ *
+ * Small batches interleave sliding windows: one chain of 253 doublings,
+ * with one addition per nonzero digit of each scalar. Large batches use
+ * Pippenger's bucket method, whose cost per point falls as the batch grows.
+ * ========================================================================== */
+
+/* From here on buckets need fewer additions per point than sliding windows */
+#define PIPPENGER_MIN_POINTS 128
+
+static void ge_p3_add(ge_p3 *r, const ge_p3 *p, const ge_p3 *q)
+{
+    ge_cached c;
+    ge_p1p1 t;
+    ge_p3_to_cached(&c, q);
+    ge_add(&t, p, &c);
+    ge_p1p1_to_p3(r, &t);
+}
+
+/**
+ * @brief r = sum [scalars[k]] points[k] + [b] B, by interleaved sliding windows
+ */
+static int msm_straus(ge_p2 *r, const ge_p3 *points, const u8 (*scalars)[32], size_t n,
+                      const u8 b[32])
+{
+    ge_cached *tables = (ge_cached *)malloc(n * ODD_MULTIPLES * sizeof(ge_cached));
+    signed char (*digits)[256] = (signed char (*)[256])malloc((n + 1) * 256);
+    if (!tables || !digits) {
+        free(tables);
+        free(digits);
+        return -1;
+    }
+
+    for (size_t k = 0; k < n; k++) {
+        odd_multiples(tables + k * ODD_MULTIPLES, &points[k]);
+        slide(digits[k], scalars[k], SLIDE_LIMIT);
+    }
+    slide(digits[n], b, SLIDE_LIMIT_BASE);
+
+    ge_p1p1 t;
+    ge_p2_0(r);
+    for (int bit = 255; bit >= 0; --bit) {
+        ge_p2_dbl(&t, r);
+        for (size_t k = 0; k < n; k++) {
+            if (digits[k][bit]) add_digit(&t, tables + k * ODD_MULTIPLES, digits[k][bit]);
+        }
+        if (digits[n][bit]) add_base_digit(&t, digits[n][bit]);
+        ge_p1p1_to_p2(r, &t);
+    }
+
+    free(tables);
+    free(digits);
+    return 0;
+}
+
+/**
+ * @brief Window width minimizing windows * (points + buckets summed)
+ */
+static int pippenger_width(size_t n)
+{
+    int best = 2;
+    size_t best_cost = (size_t)-1;
+    for (int c = 2; c <= 12; c++) {
+        size_t cost = (size_t)((256 + c - 1) / c) * (n + ((size_t)1 << c));
+        if (cost < best_cost) {
+            best_cost = cost;
+            best = c;
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief Write s in signed radix 2^c, digits in [-2^(c-1) + 1, 2^(c-1)]
+ */
+static void recode(int16_t *digits, const u8 s[32], int c, int windows)
+{
+    int half = 1 << (c - 1);
+    int carry = 0;
+    for (int w = 0; w < windows; w++) {
+        int v = 0;
+        for (int k = 0; k < c; k++) {
+            int bit = w * c + k;
+            if (bit < 256) v |= ((s[bit >> 3] >> (bit & 7)) & 1) << k;
+        }
+        v += carry;
+        carry = v > half;
+        digits[w] = (int16_t)(v - (carry << c));
+    }
+}
+
+/**
+ * @brief r = sum [scalars[k]] points[k] + [b] B, by bucket accumulation
+ *
+ * Each c-bit window sorts the points into 2^(c-1) buckets by digit, then
+ * sums the buckets weighted by their digit with two running sums.
+ */
+static int msm_pippenger(ge_p2 *r, const ge_p3 *points, const u8 (*scalars)[32], size_t n,
+                         const u8 b[32])
+{
+    int c = pippenger_width(n);
+    int windows = (256 + c - 1) / c;
+    size_t buckets = (size_t)1 << (c - 1);
+
+    ge_cached *cached = (ge_cached *)malloc(n * sizeof(ge_cached));
+    int16_t *digits = (int16_t *)malloc(n * windows * sizeof(int16_t));
+    ge_p3 *bucket = (ge_p3 *)malloc(buckets * sizeof(ge_p3));
+    u8 *used = (u8 *)malloc(buckets);
+    if (!cached || !digits || !bucket || !used) {
+        free(cached);
+        free(digits);
+        free(bucket);
+        free(used);
+        return -1;
+    }
+
+    for (size_t k = 0; k < n; k++) {
+        ge_p3_to_cached(&cached[k], &points[k]);
+        recode(digits + k * windows, scalars[k], c, windows);
+    }
+
+    ge_p1p1 t;
+    ge_p2 s;
+    ge_p3 acc, running, sum;
+    ge_p3_0(&acc);
+
+    for (int w = windows - 1; w >= 0; --w) {
+        if (w != windows - 1) {
+            ge_p3_to_p2(&s, &acc);
+            for (int d = 0; d < c; d++) {
+                ge_p2_dbl(&t, &s);
+                if (d + 1 < c) ge_p1p1_to_p2(&s, &t);
+            }
+            ge_p1p1_to_p3(&acc, &t);
+        }
+
+        memset(used, 0, buckets);
+        for (size_t k = 0; k < n; k++) {
+            int d = digits[k * windows + w];
+            if (d == 0) continue;
+            size_t j = (size_t)(d > 0 ? d : -d) - 1;
+            if (!used[j]) {
+                bucket[j] = points[k];
+                if (d < 0) {
+                    fe_neg(bucket[j].X, bucket[j].X);
+                    fe_neg(bucket[j].T, bucket[j].T);
+                }
+                used[j] = 1;
+                continue;
+            }
+            if (d > 0) {
+                ge_add(&t, &bucket[j], &cached[k]);
+            } else {
+                ge_sub(&t, &bucket[j], &cached[k]);
+            }
+            ge_p1p1_to_p3(&bucket[j], &t);
+        }
+
+        /* sum_j (j + 1) bucket[j] */
+        int started = 0;
+        ge_p3_0(&running);
+        ge_p3_0(&sum);
+        for (size_t j = buckets; j-- > 0;) {
+            if (used[j]) {
+                ge_p3_add(&running, &running, &bucket[j]);
+                started = 1;
+            }
+            if (started) ge_p3_add(&sum, &sum, &running);
+        }
+        ge_p3_add(&acc, &acc, &sum);
+    }
+
+    ge_p3 base;
+    ge_scalarmult_base(&base, b);
+    ge_p3_add(&acc, &acc, &base);
+    ge_p3_to_p2(r, &acc);
+
+    free(cached);
+    free(digits);
+    free(bucket);
+    free(used);
+    return 0;
+}
+
+esp_err_t espsol_ed25519_verify_batch(const espsol_signed_message_t *items, size_t count,
+                                      const uint8_t entropy[32])
+{
+    if ((items == NULL && count > 0) || entropy == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    for (size_t i = 0; i < count; i++) {
+        if (items[i].signature == NULL || items[i].public_key == NULL ||
+            (items[i].message == NULL && items[i].message_len > 0)) {
+            return ESP_ERR_INVALID_ARG;
+        }
+    }
+    if (count == 0) {
+        return ESP_OK;
+    }
+
+    /* Point 2i is -R_i, point 2i + 1 is -A_i */
+    size_t points = 2 * count;
+    ge_p3 *p = (ge_p3 *)malloc(points * sizeof(ge_p3));
+    u8 (*scalars)[32] = (u8 (*)[32])calloc(points, 32);
+    if (!p || !scalars) {
+        free(p);
+        free(scalars);
+        return ESP_ERR_ESPSOL_CRYPTO_ERROR;
+    }
+
+    esp_err_t err = ESP_OK;
+    u8 b[32] = {0};
+
+    for (size_t i = 0; i < count; i++) {
+        const u8 *sig = items[i].signature;
+
+        if (!scalar_canonical(sig + 32) ||
+            ge_frombytes_negate(&p[2 * i], sig) != 0 ||
+            ge_frombytes_negate(&p[2 * i + 1], items[i].public_key) != 0) {
+            err = ESP_ERR_ESPSOL_SIGNATURE_INVALID;
+            break;
+        }
+
+        /* h_i = H(R_i || A_i || M_i) */
+        u8 h[64];
+        challenge_hash(h, sig, items[i].public_key, items[i].message, items[i].message_len);
+        reduce(h);
+
+        /* z_i = H(entropy || R_i || s_i || h_i), 128 bits */
+        u8 zin[128], z[64];
+        memcpy(zin, entropy, 32);
+        memcpy(zin + 32, sig, 64);
+        memcpy(zin + 96, h, 32);
+        espsol_sha512(zin, sizeof(zin), z);
+
+        memcpy(scalars[2 * i], z, 16);
+        muladd_modL(scalars[2 * i + 1], z, 16, h);
+        muladd_modL(b, z, 16, sig + 32);
+    }
+
+    if (err == ESP_OK) {
+        ge_p2 r;
+        ge_p1p1 t;
+        fe check;
+        int rc = points < PIPPENGER_MIN_POINTS
+                 ? msm_straus(&r, p, (const u8 (*)[32])scalars, points, b)
+                 : msm_pippenger(&r, p, (const u8 (*)[32])scalars, points, b);
+
+        if (rc != 0) {
+            err = ESP_ERR_ESPSOL_CRYPTO_ERROR;
+        } else {
+            for (int d = 0; d < 3; d++) {
+                ge_p2_dbl(&t, &r);
+                ge_p1p1_to_p2(&r, &t);
+            }
+            fe_sub(check, r.Y, r.Z);
+            if (!fe_iszero(r.X) || !fe_iszero(check)) {
+                err = ESP_ERR_ESPSOL_SIGNATURE_INVALID;
+            }
+        }
+    }
+
+    free(p);
+    free(scalars);
+    return err;
+}
+
+/* ============================================================================
+ * Point Checks
+ * ========================================================================== */
+
+bool espsol_ed25519_is_on_curve(const uint8_t point[32])
+{
+    fe x, y;
+
+    /* Only whether x exists matters: no sign, no extended coordinates */
+    fe_frombytes(y, point);
+    return ge_recover_x(x, y) == 1;
+}
+
+#endif /* !USE_LIBSODIUM && ESPSOL_ED25519_FAST */
+#endif /* !ESP_PLATFORM */
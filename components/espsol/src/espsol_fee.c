@@ -0,0 +1,246 @@
+/**
+ * @file espsol_fee.c
+ * @brief ESPSOL Rent and Fee Calculation Implementation
+ *
+ * Rent-exempt minimum balance and fee arithmetic. All calculations use
+ * 64x64->128 bit integer products so results are exact on 32-bit targets
+ * without floating-point rounding.
+ *
+ * @copyright Copyright (c) 2025 SkyRizz
+ * @license Apache-2.0
+ */
+
+#include "espsol_fee.h"
+
+#include <string.h>
+#include <math.h>
+
+/* ============================================================================
+ * Internal Helper Functions
+ * ========================================================================== */
+
+/**
+ * @brief Multiply two u64 values into a 128-bit (hi, lo) result
+ */
+static void mul_u64(uint64_t a, uint64_t b, uint64_t *hi, uint64_t *lo)
+{
+    uint64_t a_lo = a & 0xFFFFFFFFULL, a_hi = a >> 32;
+    uint64_t b_lo = b & 0xFFFFFFFFULL, b_hi = b >> 32;
+
+    uint64_t p0 = a_lo * b_lo;
+    uint64_t p1 = a_lo * b_hi;
+    uint64_t p2 = a_hi * b_lo;
+    uint64_t p3 = a_hi * b_hi;
+
+    uint64_t mid = (p0 >> 32) + (p1 & 0xFFFFFFFFULL) + (p2 & 0xFFFFFFFFULL);
+
+    *lo = (mid << 32) | (p0 & 0xFFFFFFFFULL);
+    *hi = p3 + (p1 >> 32) + (p2 >> 32) + (mid >> 32);
+}
+
+/**
+ * @brief Divide a 128-bit (hi, lo) value by a 32-bit divisor
+ * @return false if the quotient does not fit in 64 bits
+ */
+static bool div_u128_u32(uint64_t hi, uint64_t lo, uint32_t divisor, uint64_t *quotient)
+{
+    uint32_t words[4] = {
+        (uint32_t)(hi >> 32), (uint32_t)hi,
+        (uint32_t)(lo >> 32), (uint32_t)lo
+    };
+    uint32_t q[4];
+    uint64_t rem = 0;
+
+    for (int i = 0; i < 4; i++) {
+        uint64_t cur = (rem << 32) | words[i];
+        q[i] = (uint32_t)(cur / divisor);
+        rem = cur % divisor;
+    }
+
+    if (q[0] != 0 || q[1] != 0) {
+        return false;
+    }
+
+    *quotient = ((uint64_t)q[2] << 32) | q[3];
+    return true;
+}
+
+/**
+ * @brief Decompose a non-negative double into odd mantissa * 2^exponent
+ *
+ * The decomposition is exact, so scaling an integer by the threshold can
+ * be done with integer multiplication and shifts.
+ */
+static void decompose_double(double value, uint64_t *mantissa, int *exponent)
+{
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+
+    int raw_exp = (int)((bits >> 52) & 0x7FF);
+    uint64_t frac = bits & 0x000FFFFFFFFFFFFFULL;
+
+    if (raw_exp == 0) {
+        /* Zero or subnormal */
+        *mantissa = frac;
+        *exponent = -1074;
+    } else {
+        *mantissa = frac | (1ULL << 52);
+        *exponent = raw_exp - 1075;
+    }
+
+    if (*mantissa == 0) {
+        *exponent = 0;
+        return;
+    }
+
+    while ((*mantissa & 1) == 0) {
+        *mantissa >>= 1;
+        (*exponent)++;
+    }
+}
+
+/* ============================================================================
+ * Rent Calculation
+ * ========================================================================== */
+
+esp_err_t espsol_rent_decode(const uint8_t *data, size_t data_len,
+                              espsol_rent_t *rent)
+{
+    if (!data || !rent || data_len < ESPSOL_RENT_SYSVAR_SIZE) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    /* Layout: u64 lamports_per_byte_year, f64 exemption_threshold, u8 burn_percent */
+    uint64_t lamports_per_byte_year = 0;
+    uint64_t threshold_bits = 0;
+    for (int i = 0; i < 8; i++) {
+        lamports_per_byte_year |= (uint64_t)data[i] << (i * 8);
+        threshold_bits |= (uint64_t)data[8 + i] << (i * 8);
+    }
+
+    double threshold;
+    memcpy(&threshold, &threshold_bits, sizeof(threshold));
+
+    if (isnan(threshold) || isinf(threshold) || threshold < 0.0 || data[16] > 100) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    rent->lamports_per_byte_year = lamports_per_byte_year;
+    rent->exemption_threshold = threshold;
+    rent->burn_percent = data[16];
+
+    return ESP_OK;
+}
+
+esp_err_t espsol_rent_minimum_balance(const espsol_rent_t *rent,
+                                       size_t data_len,
+                                       uint64_t *lamports)
+{
+    if (!lamports) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    espsol_rent_t defaults = ESPSOL_RENT_DEFAULT();
+    if (!rent) {
+        rent = &defaults;
+    }
+
+    if (isnan(rent->exemption_threshold) || isinf(rent->exemption_threshold) ||
+        rent->exemption_threshold < 0.0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    /* bytes * rate, rejecting overflow */
+    uint64_t bytes = (uint64_t)data_len + ESPSOL_ACCOUNT_STORAGE_OVERHEAD;
+    uint64_t hi, lo;
+    mul_u64(bytes, rent->lamports_per_byte_year, &hi, &lo);
+    if (hi != 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    /* Scale by threshold = mantissa * 2^exponent */
+    uint64_t mantissa;
+    int exponent;
+    decompose_double(rent->exemption_threshold, &mantissa, &exponent);
+
+    if (mantissa == 0 || lo == 0) {
+        *lamports = 0;
+        return ESP_OK;
+    }
+
+    mul_u64(lo, mantissa, &hi, &lo);
+
+    if (exponent >= 0) {
+        if (hi != 0 || exponent >= 64 || (exponent > 0 && (lo >> (64 - exponent)) != 0)) {
+            return ESP_ERR_INVALID_ARG;
+        }
+        *lamports = lo << exponent;
+    } else {
+        int shift = -exponent;
+        if (shift >= 128) {
+            *lamports = 0;
+        } else if (shift >= 64) {
+            *lamports = hi >> (shift - 64);
+        } else {
+            if ((hi >> shift) != 0) {
+                return ESP_ERR_INVALID_ARG;
+            }
+            *lamports = (lo >> shift) | (shift > 0 ? hi << (64 - shift) : 0);
+        }
+    }
+
+    return ESP_OK;
+}
+
+/* ============================================================================
+ * Fee Calculation
+ * ========================================================================== */
+
+esp_err_t espsol_fee_priority(uint32_t compute_unit_limit,
+                               uint64_t compute_unit_price,
+                               uint64_t *lamports)
+{
+    if (!lamports) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    uint64_t hi, lo;
+    mul_u64(compute_unit_price, compute_unit_limit, &hi, &lo);
+
+    /* Round up: (price * limit + 999999) / 1000000 */
+    uint64_t round = ESPSOL_MICRO_LAMPORTS_PER_LAMPORT - 1;
+    lo += round;
+    if (lo < round) {
+        hi++;
+    }
+
+    if (!div_u128_u32(hi, lo, (uint32_t)ESPSOL_MICRO_LAMPORTS_PER_LAMPORT, lamports)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t espsol_fee_calculate(size_t num_signatures,
+                                uint32_t compute_unit_limit,
+                                uint64_t compute_unit_price,
+                                uint64_t *lamports)
+{
+    if (!lamports) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    uint64_t priority = 0;
+    esp_err_t err = espsol_fee_priority(compute_unit_limit, compute_unit_price, &priority);
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    uint64_t base = (uint64_t)num_signatures * ESPSOL_LAMPORTS_PER_SIGNATURE;
+    if (base + priority < base) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    *lamports = base + priority;
+    return ESP_OK;
+}
@@ -0,0 +1,754 @@
+/**
+ * @file espsol_json.c
+ * @brief ESPSOL Minimal JSON Reader Implementation
+ *
+ * Span-based JSON reader. Values are located by skipping over the text,
+ * which keeps RPC response handling free of heap allocations.
+ *
+ * @copyright Copyright (c) 2025 SkyRizz
+ * @license Apache-2.0
+ */
+
+#include "espsol_json.h"
+
+#include <string.h>
+
+/* ============================================================================
+ * Internal Helper Functions
+ * ========================================================================== */
+
+static bool is_ws(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+static const char *skip_ws(const char *p, const char *end)
+{
+    while (p < end && is_ws(*p)) {
+        p++;
+    }
+    return p;
+}
+
+/**
+ * @brief Skip a string starting at the opening quote
+ * @return Pointer past the closing quote, or NULL if unterminated
+ */
+static const char *skip_string(const char *p, const char *end)
+{
+    p++;
+    while (p < end) {
+        if (*p == '\\') {
+            p += 2;
+            continue;
+        }
+        if (*p == '"') {
+            return p + 1;
+        }
+        p++;
+    }
+    return NULL;
+}
+
+/**
+ * @brief Skip one value
+ * @return Pointer past the value, or NULL if malformed
+ */
+static const char *skip_value(const char *p, const char *end)
+{
+    if (p >= end) {
+        return NULL;
+    }
+
+    if (*p == '"') {
+        return skip_string(p, end);
+    }
+
+    if (*p == '{' || *p == '[') {
+        int depth = 0;
+        while (p < end) {
+            char c = *p;
+            if (c == '"') {
+                p = skip_string(p, end);
+                if (!p) {
+                    return NULL;
+                }
+                continue;
+            }
+            if (c == '{' || c == '[') {
+                depth++;
+            } else if (c == '}' || c == ']') {
+                if (--depth == 0) {
+                    return p + 1;
+                }
+            }
+            p++;
+        }
+        return NULL;
+    }
+
+    /* Scalar: number, true, false, null */
+    const char *start = p;
+    while (p < end && !is_ws(*p) && *p != ',' && *p != '}' && *p != ']' && *p != ':') {
+        p++;
+    }
+    return p > start ? p : NULL;
+}
+
+static int hex_value(char c)
+{
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+static bool read_hex4(const char *p, const char *end, uint32_t *out)
+{
+    if (end - p < 4) {
+        return false;
+    }
+    uint32_t v = 0;
+    for (int i = 0; i < 4; i++) {
+        int h = hex_value(p[i]);
+        if (h < 0) {
+            return false;
+        }
+        v = (v << 4) | (uint32_t)h;
+    }
+    *out = v;
+    return true;
+}
+
+/* ============================================================================
+ * Public Functions
+ * ========================================================================== */
+
+bool espsol_json_parse(const char *text, size_t len, espsol_json_t *out)
+{
+    if (!text || !out) {
+        return false;
+    }
+
+    const char *end = text + len;
+    const char *p = skip_ws(text, end);
+    const char *value_end = skip_value(p, end);
+    if (!value_end) {
+        return false;
+    }
+
+    if (skip_ws(value_end, end) != end) {
+        return false;
+    }
+
+    out->ptr = p;
+    out->len = (size_t)(value_end - p);
+    return true;
+}
+
+espsol_json_type_t espsol_json_type(const espsol_json_t *value)
+{
+    if (!value || !value->ptr || value->len == 0) {
+        return ESPSOL_JSON_INVALID;
+    }
+
+    switch (value->ptr[0]) {
+        case '{': return ESPSOL_JSON_OBJECT;
+        case '[': return ESPSOL_JSON_ARRAY;
+        case '"': return ESPSOL_JSON_STRING;
+        case 'n': return ESPSOL_JSON_NULL;
+        case 't':
+        case 'f': return ESPSOL_JSON_BOOL;
+        default:
+            if (value->ptr[0] == '-' || (value->ptr[0] >= '0' && value->ptr[0] <= '9')) {
+                return ESPSOL_JSON_NUMBER;
+            }
+            return ESPSOL_JSON_INVALID;
+    }
+}
+
+bool espsol_json_get(const espsol_json_t *object, const char *key, espsol_json_t *out)
+{
+    if (espsol_json_type(object) != ESPSOL_JSON_OBJECT || !key || !out) {
+        return false;
+    }
+
+    const char *end = object->ptr + object->len;
+    const char *p = object->ptr + 1;
+    size_t key_len = strlen(key);
+
+    while (p < end) {
+        p = skip_ws(p, end);
+        if (p >= end || *p == '}') {
+            return false;
+        }
+        if (*p == ',') {
+            p++;
+            continue;
+        }
+        if (*p != '"') {
+            return false;
+        }
+
+        const char *name = p + 1;
+        const char *name_end = skip_string(p, end);
+        if (!name_end) {
+            return false;
+        }
+        size_t name_len = (size_t)(name_end - 1 - name);
+
+        p = skip_ws(name_end, end);
+        if (p >= end || *p != ':') {
+            return false;
+        }
+        p = skip_ws(p + 1, end);
+
+        const char *value_end = skip_value(p, end);
+        if (!value_end) {
+            return false;
+        }
+
+        if (name_len == key_len && memcmp(name, key, key_len) == 0) {
+            out->ptr = p;
+            out->len = (size_t)(value_end - p);
+            return true;
+        }
+
+        p = value_end;
+    }
+
+    return false;
+}
+
+bool espsol_json_array_next(const espsol_json_t *array, size_t *cursor, espsol_json_t *out)
+{
+    if (espsol_json_type(array) != ESPSOL_JSON_ARRAY || !cursor || !out) {
+        return false;
+    }
+
+    const char *end = array->ptr + array->len;
+    const char *p = array->ptr + (*cursor == 0 ? 1 : *cursor);
+
+    p = skip_ws(p, end);
+    if (p < end && *p == ',') {
+        p = skip_ws(p + 1, end);
+    }
+    if (p >= end || *p == ']') {
+        *cursor = array->len;
+        return false;
+    }
+
+    const char *value_end = skip_value(p, end);
+    if (!value_end) {
+        *cursor = array->len;
+        return false;
+    }
+
+    out->ptr = p;
+    out->len = (size_t)(value_end - p);
+    *cursor = (size_t)(value_end - array->ptr);
+    return true;
+}
+
+bool espsol_json_index(const espsol_json_t *array, size_t index, espsol_json_t *out)
+{
+    size_t cursor = 0;
+    espsol_json_t item;
+
+    for (size_t i = 0; espsol_json_array_next(array, &cursor, &item); i++) {
+        if (i == index) {
+            if (out) {
+                *out = item;
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t espsol_json_array_size(const espsol_json_t *array)
+{
+    size_t cursor = 0;
+    size_t count = 0;
+    espsol_json_t item;
+
+    while (espsol_json_array_next(array, &cursor, &item)) {
+        count++;
+    }
+    return count;
+}
+
+bool espsol_json_get_u64(const espsol_json_t *value, uint64_t *out)
+{
+    if (espsol_json_type(value) != ESPSOL_JSON_NUMBER || !out) {
+        return false;
+    }
+
+    uint64_t result = 0;
+    for (size_t i = 0; i < value->len; i++) {
+        char c = value->ptr[i];
+        if (c < '0' || c > '9') {
+            return false;
+        }
+        uint64_t digit = (uint64_t)(c - '0');
+        if (result > (UINT64_MAX - digit) / 10) {
+            return false;
+        }
+        result = result * 10 + digit;
+    }
+
+    *out = result;
+    return true;
+}
+
+bool espsol_json_get_i64(const espsol_json_t *value, int64_t *out)
+{
+    if (espsol_json_type(value) != ESPSOL_JSON_NUMBER || !out) {
+        return false;
+    }
+
+    bool negative = value->ptr[0] == '-';
+    espsol_json_t digits = {
+        .ptr = value->ptr + (negative ? 1 : 0),
+        .len = value->len - (negative ? 1 : 0),
+    };
+
+    uint64_t magnitude;
+    if (!espsol_json_get_u64(&digits, &magnitude)) {
+        return false;
+    }
+
+    if (negative) {
+        if (magnitude > (uint64_t)INT64_MAX + 1) {
+            return false;
+        }
+        *out = (int64_t)(0 - magnitude);
+    } else {
+        if (magnitude > (uint64_t)INT64_MAX) {
+            return false;
+        }
+        *out = (int64_t)magnitude;
+    }
+    return true;
+}
+
+bool espsol_json_get_bool(const espsol_json_t *value, bool *out)
+{
+    if (!value || !value->ptr || !out) {
+        return false;
+    }
+    if (value->len == 4 && memcmp(value->ptr, "true", 4) == 0) {
+        *out = true;
+        return true;
+    }
+    if (value->len == 5 && memcmp(value->ptr, "false", 5) == 0) {
+        *out = false;
+        return true;
+    }
+    return false;
+}
+
+bool espsol_json_is_null(const espsol_json_t *value)
+{
+    return value && value->ptr && value->len == 4 && memcmp(value->ptr, "null", 4) == 0;
+}
+
+esp_err_t espsol_json_get_string(const espsol_json_t *value, char *out, size_t out_len)
+{
+    if (espsol_json_type(value) != ESPSOL_JSON_STRING || value->len < 2 || !out || out_len == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    const char *p = value->ptr + 1;
+    const char *end = value->ptr + value->len - 1;
+    size_t n = 0;
+
+    while (p < end) {
+        char c = *p++;
+        uint8_t utf8[4];
+        size_t utf8_len = 1;
+        utf8[0] = (uint8_t)c;
+
+        if (c == '\\') {
+            if (p >= end) {
+                return ESP_ERR_INVALID_ARG;
+            }
+            char e = *p++;
+            switch (e) {
+                case '"':  utf8[0] = '"'; break;
+                case '\\': utf8[0] = '\\'; break;
+                case '/':  utf8[0] = '/'; break;
+                case 'b':  utf8[0] = '\b'; break;
+                case 'f':  utf8[0] = '\f'; break;
+                case 'n':  utf8[0] = '\n'; break;
+                case 'r':  utf8[0] = '\r'; break;
+                case 't':  utf8[0] = '\t'; break;
+                case 'u': {
+                    uint32_t cp;
+                    if (!read_hex4(p, end, &cp)) {
+                        return ESP_ERR_INVALID_ARG;
+                    }
+                    p += 4;
+                    /* Surrogate pair */
+                    if (cp >= 0xD800 && cp <= 0xDBFF) {
+                        uint32_t low;
+                        if (end - p < 6 || p[0] != '\\' || p[1] != 'u' ||
+                            !read_hex4(p + 2, end, &low) || low < 0xDC00 || low > 0xDFFF) {
+                            return ESP_ERR_INVALID_ARG;
+                        }
+                        p += 6;
+                        cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                    }
+                    if (cp < 0x80) {
+                        utf8[0] = (uint8_t)cp;
+                    } else if (cp < 0x800) {
+                        utf8[0] = (uint8_t)(0xC0 | (cp >> 6));
+                        utf8[1] = (uint8_t)(0x80 | (cp & 0x3F));
+                        utf8_len = 2;
+                    } else if (cp < 0x10000) {
+                        utf8[0] = (uint8_t)(0xE0 | (cp >> 12));
+                        utf8[1] = (uint8_t)(0x80 | ((cp >> 6) & 0x3F));
+                        utf8[2] = (uint8_t)(0x80 | (cp & 0x3F));
+                        utf8_len = 3;
+                    } else {
+                        utf8[0] = (uint8_t)(0xF0 | (cp >> 18));
+                        utf8[1] = (uint8_t)(0x80 | ((cp >> 12) & 0x3F));
+                        utf8[2] = (uint8_t)(0x80 | ((cp >> 6) & 0x3F));
+                        utf8[3] = (uint8_t)(0x80 | (cp & 0x3F));
+                        utf8_len = 4;
+                    }
+                    break;
+                }
+                default:
+                    return ESP_ERR_INVALID_ARG;
+            }
+        }
+
+        if (n + utf8_len >= out_len) {
+            out[0] = '\0';
+            return ESP_ERR_ESPSOL_BUFFER_TOO_SMALL;
+        }
+        memcpy(out + n, utf8, utf8_len);
+        n += utf8_len;
+    }
+
+    out[n] = '\0';
+    return ESP_OK;
+}
+
+bool espsol_json_string_equals(const espsol_json_t *value, const char *str)
+{
+    if (espsol_json_type(value) != ESPSOL_JSON_STRING || value->len < 2 || !str) {
+        return false;
+    }
+    size_t len = strlen(str);
+    return value->len - 2 == len && memcmp(value->ptr + 1, str, len) == 0;
+}
+
+/* ============================================================================
+ * Streaming Reader
+ * ========================================================================== */
+
+enum {
+    STREAM_VALUE = 0,       /**< Expecting a value */
+    STREAM_VALUE_OR_END,    /**< After '[': value or ']' */
+    STREAM_KEY_OR_END,      /**< After '{': key or '}' */
+    STREAM_KEY_NEXT,        /**< After ',' in an object: key */
+    STREAM_KEY,             /**< Inside a key */
+    STREAM_COLON,           /**< After a key */
+    STREAM_STRING,          /**< Inside a string value */
+    STREAM_SCALAR,          /**< Inside a number or literal */
+    STREAM_AFTER,           /**< After a value */
+};
+
+static void stream_take(espsol_json_stream_t *s, char c)
+{
+    if (s->capture_len < s->capture_cap) {
+        s->capture[s->capture_len++] = c;
+    } else {
+        s->capture_truncated = true;
+    }
+}
+
+static void stream_begin_value(espsol_json_stream_t *s, char c)
+{
+    if (s->capture || !s->on_begin) {
+        return;
+    }
+
+    size_t cap = 0;
+    char *buf = s->on_begin(s->ctx, s, c, &cap);
+    if (buf && cap > 0) {
+        s->capture = buf;
+        s->capture_cap = cap;
+        s->capture_len = 0;
+        s->capture_depth = s->depth;
+        s->capture_truncated = false;
+        stream_take(s, c);
+    }
+}
+
+static bool stream_end_value(espsol_json_stream_t *s)
+{
+    s->state = STREAM_AFTER;
+
+    const char *text = NULL;
+    size_t len = 0;
+    bool truncated = false;
+
+    if (s->capture) {
+        if (s->capture_depth != s->depth) {
+            return true;    /* Inside a captured value */
+        }
+        text = s->capture;
+        len = s->capture_len;
+        truncated = s->capture_truncated;
+        s->capture = NULL;
+    }
+
+    if (s->on_end && !s->on_end(s->ctx, s, text, len, truncated)) {
+        return false;
+    }
+    if (s->depth == 0) {
+        s->done = true;
+    }
+    return true;
+}
+
+static bool stream_push(espsol_json_stream_t *s, bool object)
+{
+    if (s->depth >= ESPSOL_JSON_STREAM_MAX_DEPTH) {
+        return false;
+    }
+    s->levels[s->depth].object = object;
+    s->levels[s->depth].index = 0;
+    s->levels[s->depth].key[0] = '\0';
+    s->levels[s->depth].key_truncated = false;
+    s->depth++;
+    s->state = object ? STREAM_KEY_OR_END : STREAM_VALUE_OR_END;
+    return true;
+}
+
+static bool stream_close(espsol_json_stream_t *s)
+{
+    s->depth--;
+    return stream_end_value(s);
+}
+
+static bool stream_step(espsol_json_stream_t *s, char c)
+{
+    /* A scalar ends at the first delimiter, which belongs to the parent */
+    if (s->state == STREAM_SCALAR) {
+        if (!is_ws(c) && c != ',' && c != '}' && c != ']') {
+            if (s->capture) {
+                stream_take(s, c);
+            }
+            return true;
+        }
+        if (!stream_end_value(s)) {
+            return false;
+        }
+    }
+
+    if (s->capture) {
+        stream_take(s, c);
+    }
+
+    switch (s->state) {
+        case STREAM_VALUE:
+        case STREAM_VALUE_OR_END:
+            if (is_ws(c)) {
+                return true;
+            }
+            if (c == ']' && s->state == STREAM_VALUE_OR_END) {
+                return stream_close(s);
+            }
+            if (s->done || c == ',' || c == ':' || c == '}' || c == ']') {
+                return false;
+            }
+            stream_begin_value(s, c);
+            if (c == '{' || c == '[') {
+                return stream_push(s, c == '{');
+            }
+            if (c == '"') {
+                s->escape = false;
+                s->state = STREAM_STRING;
+            } else {
+                s->state = STREAM_SCALAR;
+            }
+            return true;
+
+        case STREAM_KEY_OR_END:
+        case STREAM_KEY_NEXT:
+            if (is_ws(c)) {
+                return true;
+            }
+            if (c == '}' && s->state == STREAM_KEY_OR_END) {
+                return stream_close(s);
+            }
+            if (c != '"') {
+                return false;
+            }
+            s->key_len = 0;
+            s->escape = false;
+            s->levels[s->depth - 1].key_truncated = false;
+            s->state = STREAM_KEY;
+            return true;
+
+        case STREAM_KEY: {
+            char *key = s->levels[s->depth - 1].key;
+            if (c == '"' && !s->escape) {
+                key[s->key_len] = '\0';
+                s->state = STREAM_COLON;
+                return true;
+            }
+            s->escape = !s->escape && c == '\\';
+            if (s->key_len < ESPSOL_JSON_STREAM_KEY_LEN - 1) {
+                key[s->key_len++] = c;
+            } else {
+                s->levels[s->depth - 1].key_truncated = true;
+            }
+            return true;
+        }
+
+        case STREAM_COLON:
+            if (is_ws(c)) {
+                return true;
+            }
+            if (c != ':') {
+                return false;
+            }
+            s->state = STREAM_VALUE;
+            return true;
+
+        case STREAM_STRING:
+            if (s->escape) {
+                s->escape = false;
+            } else if (c == '\\') {
+                s->escape = true;
+            } else if (c == '"') {
+                return stream_end_value(s);
+            }
+            return true;
+
+        case STREAM_AFTER:
+            if (is_ws(c)) {
+                return true;
+            }
+            if (s->depth == 0) {
+                return false;   /* Text after the root value */
+            }
+            if (c == ',') {
+                if (s->levels[s->depth - 1].object) {
+                    s->state = STREAM_KEY_NEXT;
+                } else {
+                    s->levels[s->depth - 1].index++;
+                    s->state = STREAM_VALUE;
+                }
+                return true;
+            }
+            if ((c == '}' && s->levels[s->depth - 1].object) ||
+                (c == ']' && !s->levels[s->depth - 1].object)) {
+                return stream_close(s);
+            }
+            return false;
+
+        default:
+            return false;
+    }
+}
+
+void espsol_json_stream_init(espsol_json_stream_t *stream,
+                             espsol_json_begin_fn on_begin,
+                             espsol_json_end_fn on_end,
+                             void *ctx)
+{
+    memset(stream, 0, sizeof(*stream));
+    stream->state = STREAM_VALUE;
+    stream->on_begin = on_begin;
+    stream->on_end = on_end;
+    stream->ctx = ctx;
+}
+
+bool espsol_json_stream_feed(espsol_json_stream_t *stream, const char *data, size_t len)
+{
+    if (!stream || stream->failed) {
+        return false;
+    }
+
+    for (size_t i = 0; i < len; i++) {
+        if (!stream_step(stream, data[i])) {
+            stream->failed = true;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool espsol_json_stream_done(const espsol_json_stream_t *stream)
+{
+    if (!stream || stream->failed) {
+        return false;
+    }
+    /* A root scalar ends with the text */
+    return stream->done || (stream->state == STREAM_SCALAR && stream->depth == 0);
+}
+
+bool espsol_json_stream_at(const espsol_json_stream_t *stream, const char *path)
+{
+    size_t level = 0;
+
+    while (*path) {
+        const char *seg_end = strchr(path, '.');
+        size_t seg_len = seg_end ? (size_t)(seg_end - path) : strlen(path);
+
+        if (level >= stream->depth) {
+            return false;
+        }
+
+        if (stream->levels[level].object) {
+            if (stream->levels[level].key_truncated ||
+                strlen(stream->levels[level].key) != seg_len ||
+                memcmp(stream->levels[level].key, path, seg_len) != 0) {
+                return false;
+            }
+        } else if (!(seg_len == 1 && path[0] == '#')) {
+            uint32_t index = 0;
+            for (size_t i = 0; i < seg_len; i++) {
+                if (path[i] < '0' || path[i] > '9') {
+                    return false;
+                }
+                index = index * 10 + (uint32_t)(path[i] - '0');
+            }
+            if (seg_len == 0 || index != stream->levels[level].index) {
+                return false;
+            }
+        }
+
+        level++;
+        path += seg_len;
+        if (*path == '.') {
+            path++;
+        }
+    }
+
+    return level == stream->depth;
+}
+
+uint32_t espsol_json_stream_index(const espsol_json_stream_t *stream, size_t level)
+{
+    if (level >= stream->depth || stream->levels[level].object) {
+        return 0;
+    }
+    return stream->levels[level].index;
+}
+
+bool espsol_json_unquote(char *text, size_t len, bool truncated)
+{
+    if (truncated || len < 2 || text[0] != '"') {
+        return false;
+    }
+    memmove(text, text + 1, len - 2);
+    text[len - 2] = '\0';
+    return true;
+}
@@ -29,15 +29,15 @@ static const char *TAG = "espsol_mnemonic";
 /* Host compilation */
 #include <stdlib.h>
 
-/* Use mbedTLS if available, otherwise use the SHA-256 from espsol_ed25519.c */
+/* Use mbedTLS if available, otherwise use the SHA-256 from espsol_sha.c */
 #ifdef USE_MBEDTLS
 #include "mbedtls/sha256.h"
 #include "mbedtls/sha512.h"
 #include "mbedtls/pkcs5.h"
 #include "mbedtls/md.h"
 #else
-/* SHA-256 is provided by espsol_ed25519.c for host testing */
-extern void espsol_sha256(const uint8_t *data, size_t len, uint8_t out[32]);
+/* SHA-256 is provided by espsol_sha.c for host testing */
+#include "espsol_sha.h"
 #endif
 
 /* Disable verbose logging for host tests */
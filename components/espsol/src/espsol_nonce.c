@@ -0,0 +1,420 @@
+/**
+ * @file espsol_nonce.c
+ * @brief ESPSOL Durable Nonce Implementation
+ *
+ * Nonce account layout (all integers little-endian):
+ *
+ *   u32 version (0 = legacy, 1 = current) | u32 state (1 = initialized) |
+ *   32 authority | 32 durable nonce | u64 lamports_per_signature
+ *
+ * @copyright Copyright (c) 2025 SkyRizz
+ * @license Apache-2.0
+ */
+
+#include "espsol_nonce.h"
+#include "espsol_utils.h"
+
+#include <string.h>
+#include <stdlib.h>
+
+#if defined(ESP_PLATFORM) && ESP_PLATFORM
+#include "esp_log.h"
+static const char *TAG = "espsol_nonce";
+#else
+#define ESP_LOGD(tag, ...)
+#define ESP_LOGE(tag, ...)
+#endif
+
+/** Program state of an initialized nonce account */
+#define NONCE_STATE_INITIALIZED     1
+
+/** Highest known account version */
+#define NONCE_VERSION_CURRENT       1
+
+/* System Program instruction discriminators */
+#define NONCE_IX_ADVANCE            4
+#define NONCE_IX_WITHDRAW           5
+#define NONCE_IX_INITIALIZE         6
+#define NONCE_IX_AUTHORIZE          7
+
+/* ============================================================================
+ * Internal Structures
+ * ========================================================================== */
+
+/**
+ * @brief Cached nonce account
+ */
+typedef struct {
+    bool present;                       /**< Entry holds an account */
+    bool used;                          /**< Current nonce handed out */
+    uint8_t key[ESPSOL_PUBKEY_SIZE];    /**< Nonce account address */
+    espsol_nonce_state_t state;         /**< Decoded account */
+} nonce_entry_t;
+
+struct espsol_nonce_cache {
+    nonce_entry_t *entries;
+    size_t max_accounts;
+};
+
+/* ============================================================================
+ * Internal Helper Functions
+ * ========================================================================== */
+
+static uint32_t get_u32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint64_t get_u64(const uint8_t *p)
+{
+    uint64_t v = 0;
+    for (int i = 7; i >= 0; i--) {
+        v = (v << 8) | p[i];
+    }
+    return v;
+}
+
+static void put_u64(uint8_t *p, uint64_t v)
+{
+    for (int i = 0; i < 8; i++) {
+        p[i] = (uint8_t)(v >> (i * 8));
+    }
+}
+
+static nonce_entry_t *find_entry(struct espsol_nonce_cache *cache,
+                                 const uint8_t key[ESPSOL_PUBKEY_SIZE])
+{
+    for (size_t i = 0; i < cache->max_accounts; i++) {
+        if (cache->entries[i].present &&
+            memcmp(cache->entries[i].key, key, ESPSOL_PUBKEY_SIZE) == 0) {
+            return &cache->entries[i];
+        }
+    }
+    return NULL;
+}
+
+/* ============================================================================
+ * Account Decoding
+ * ========================================================================== */
+
+esp_err_t espsol_nonce_decode(const uint8_t *data, size_t data_len,
+                              espsol_nonce_state_t *state)
+{
+    if (!data || !state) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (data_len != ESPSOL_NONCE_ACCOUNT_SIZE || get_u32(data) > NONCE_VERSION_CURRENT ||
+        get_u32(data + 4) > NONCE_STATE_INITIALIZED) {
+        return ESP_ERR_ESPSOL_RPC_PARSE_ERROR;
+    }
+
+    state->version = get_u32(data);
+    state->initialized = get_u32(data + 4) == NONCE_STATE_INITIALIZED;
+    memcpy(state->authority, data + 8, ESPSOL_PUBKEY_SIZE);
+    memcpy(state->nonce, data + 40, ESPSOL_BLOCKHASH_SIZE);
+    state->lamports_per_signature = get_u64(data + 72);
+    return ESP_OK;
+}
+
+/* ============================================================================
+ * Nonce Cache
+ * ========================================================================== */
+
+esp_err_t espsol_nonce_cache_create(size_t max_accounts, espsol_nonce_cache_handle_t *cache)
+{
+    if (!cache || max_accounts == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    struct espsol_nonce_cache *c = calloc(1, sizeof(struct espsol_nonce_cache));
+    if (!c) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    c->entries = calloc(max_accounts, sizeof(nonce_entry_t));
+    if (!c->entries) {
+        free(c);
+        return ESP_ERR_NO_MEM;
+    }
+    c->max_accounts = max_accounts;
+
+    *cache = c;
+    return ESP_OK;
+}
+
+esp_err_t espsol_nonce_cache_destroy(espsol_nonce_cache_handle_t cache)
+{
+    if (!cache) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    free(cache->entries);
+    free(cache);
+    return ESP_OK;
+}
+
+esp_err_t espsol_nonce_cache_put(espsol_nonce_cache_handle_t cache,
+                                 const uint8_t key[ESPSOL_PUBKEY_SIZE],
+                                 const uint8_t *data, size_t data_len)
+{
+    if (!cache || !key || !data) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    espsol_nonce_state_t state;
+    esp_err_t err = espsol_nonce_decode(data, data_len, &state);
+    if (err != ESP_OK) {
+        return err;
+    }
+    if (!state.initialized) {
+        return ESP_ERR_ESPSOL_RPC_PARSE_ERROR;
+    }
+
+    nonce_entry_t *entry = find_entry(cache, key);
+    if (entry) {
+        /* Reading the account again before it advanced must not recycle the nonce */
+        if (memcmp(entry->state.nonce, state.nonce, ESPSOL_BLOCKHASH_SIZE) != 0) {
+            entry->used = false;
+        }
+    } else {
+        for (size_t i = 0; i < cache->max_accounts && !entry; i++) {
+            if (!cache->entries[i].present) {
+                entry = &cache->entries[i];
+            }
+        }
+        if (!entry) {
+            return ESP_ERR_NO_MEM;
+        }
+        entry->present = true;
+        entry->used = false;
+        memcpy(entry->key, key, ESPSOL_PUBKEY_SIZE);
+    }
+
+    entry->state = state;
+    ESP_LOGD(TAG, "Cached nonce account (%s)", entry->used ? "used" : "available");
+    return ESP_OK;
+}
+
+esp_err_t espsol_nonce_cache_fetch(espsol_nonce_cache_handle_t cache,
+                                   espsol_rpc_handle_t rpc,
+                                   const uint8_t key[ESPSOL_PUBKEY_SIZE])
+{
+    if (!cache || !rpc || !key) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    char address[ESPSOL_ADDRESS_MAX_LEN];
+    esp_err_t err = espsol_pubkey_to_address(key, address, sizeof(address));
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    uint8_t data[ESPSOL_NONCE_ACCOUNT_SIZE];
+    espsol_account_info_t info = {0};
+    info.data = data;
+    info.data_capacity = sizeof(data);
+
+    err = espsol_rpc_get_account_info(rpc, address, &info);
+    if (err == ESP_ERR_ESPSOL_BUFFER_TOO_SMALL) {
+        return ESP_ERR_ESPSOL_RPC_PARSE_ERROR;
+    }
+    if (err != ESP_OK) {
+        return err;
+    }
+    if (info.owner[0] == '\0') {
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    /* Nonce accounts belong to the System Program */
+    char system[ESPSOL_ADDRESS_MAX_LEN];
+    espsol_pubkey_to_address(ESPSOL_SYSTEM_PROGRAM_ID, system, sizeof(system));
+    if (strcmp(info.owner, system) != 0) {
+        ESP_LOGE(TAG, "Account is not a nonce account");
+        return ESP_ERR_ESPSOL_RPC_PARSE_ERROR;
+    }
+
+    return espsol_nonce_cache_put(cache, key, data, info.data_len);
+}
+
+esp_err_t espsol_nonce_cache_get(espsol_nonce_cache_handle_t cache,
+                                 const uint8_t key[ESPSOL_PUBKEY_SIZE],
+                                 espsol_nonce_state_t *state,
+                                 bool *used)
+{
+    if (!cache || !key || !state) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    const nonce_entry_t *entry = find_entry(cache, key);
+    if (!entry) {
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    *state = entry->state;
+    if (used) {
+        *used = entry->used;
+    }
+    return ESP_OK;
+}
+
+esp_err_t espsol_nonce_cache_take(espsol_nonce_cache_handle_t cache,
+                                  uint8_t key[ESPSOL_PUBKEY_SIZE],
+                                  espsol_nonce_state_t *state)
+{
+    if (!cache || !key || !state) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    for (size_t i = 0; i < cache->max_accounts; i++) {
+        nonce_entry_t *entry = &cache->entries[i];
+        if (entry->present && !entry->used) {
+            entry->used = true;
+            memcpy(key, entry->key, ESPSOL_PUBKEY_SIZE);
+            *state = entry->state;
+            return ESP_OK;
+        }
+    }
+    return ESP_ERR_NOT_FOUND;
+}
+
+esp_err_t espsol_nonce_cache_remove(espsol_nonce_cache_handle_t cache,
+                                    const uint8_t key[ESPSOL_PUBKEY_SIZE])
+{
+    if (!cache || !key) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    nonce_entry_t *entry = find_entry(cache, key);
+    if (!entry) {
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    memset(entry, 0, sizeof(*entry));
+    return ESP_OK;
+}
+
+/* ============================================================================
+ * Nonce Instructions
+ * ========================================================================== */
+
+esp_err_t espsol_tx_add_nonce_create(espsol_tx_handle_t tx,
+                                     const uint8_t from[ESPSOL_PUBKEY_SIZE],
+                                     const uint8_t nonce_account[ESPSOL_PUBKEY_SIZE],
+                                     const uint8_t authority[ESPSOL_PUBKEY_SIZE],
+                                     uint64_t lamports)
+{
+    if (!tx || !from || !nonce_account || !authority) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    esp_err_t err = espsol_tx_add_create_account(tx, from, nonce_account, lamports,
+                                                 ESPSOL_NONCE_ACCOUNT_SIZE,
+                                                 ESPSOL_SYSTEM_PROGRAM_ID);
+    if (err != ESP_OK) {
+        return err;
+    }
+    return espsol_tx_add_nonce_initialize(tx, nonce_account, authority);
+}
+
+esp_err_t espsol_tx_add_nonce_initialize(espsol_tx_handle_t tx,
+                                         const uint8_t nonce_account[ESPSOL_PUBKEY_SIZE],
+                                         const uint8_t authority[ESPSOL_PUBKEY_SIZE])
+{
+    if (!tx || !nonce_account || !authority) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    espsol_account_meta_t accounts[3] = {
+        { .is_signer = false, .is_writable = true },
+        { .is_signer = false, .is_writable = false },
+        { .is_signer = false, .is_writable = false },
+    };
+    memcpy(accounts[0].pubkey, nonce_account, ESPSOL_PUBKEY_SIZE);
+    memcpy(accounts[1].pubkey, ESPSOL_RECENT_BLOCKHASHES_SYSVAR_ID, ESPSOL_PUBKEY_SIZE);
+    memcpy(accounts[2].pubkey, ESPSOL_RENT_SYSVAR_ID, ESPSOL_PUBKEY_SIZE);
+
+    /* Data: u32 discriminator, authority */
+    uint8_t data[4 + ESPSOL_PUBKEY_SIZE] = { NONCE_IX_INITIALIZE, 0, 0, 0 };
+    memcpy(data + 4, authority, ESPSOL_PUBKEY_SIZE);
+
+    return espsol_tx_add_instruction(tx, ESPSOL_SYSTEM_PROGRAM_ID,
+                                     accounts, 3, data, sizeof(data));
+}
+
+esp_err_t espsol_tx_add_nonce_advance(espsol_tx_handle_t tx,
+                                      const uint8_t nonce_account[ESPSOL_PUBKEY_SIZE],
+                                      const uint8_t authority[ESPSOL_PUBKEY_SIZE])
+{
+    if (!tx || !nonce_account || !authority) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    espsol_account_meta_t accounts[3] = {
+        { .is_signer = false, .is_writable = true },
+        { .is_signer = false, .is_writable = false },
+        { .is_signer = true, .is_writable = false },
+    };
+    memcpy(accounts[0].pubkey, nonce_account, ESPSOL_PUBKEY_SIZE);
+    memcpy(accounts[1].pubkey, ESPSOL_RECENT_BLOCKHASHES_SYSVAR_ID, ESPSOL_PUBKEY_SIZE);
+    memcpy(accounts[2].pubkey, authority, ESPSOL_PUBKEY_SIZE);
+
+    const uint8_t data[4] = { NONCE_IX_ADVANCE, 0, 0, 0 };
+    return espsol_tx_add_instruction(tx, ESPSOL_SYSTEM_PROGRAM_ID,
+                                     accounts, 3, data, sizeof(data));
+}
+
+esp_err_t espsol_tx_add_nonce_withdraw(espsol_tx_handle_t tx,
+                                       const uint8_t nonce_account[ESPSOL_PUBKEY_SIZE],
+                                       const uint8_t authority[ESPSOL_PUBKEY_SIZE],
+                                       const uint8_t to[ESPSOL_PUBKEY_SIZE],
+                                       uint64_t lamports)
+{
+    if (!tx || !nonce_account || !authority || !to) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    espsol_account_meta_t accounts[5] = {
+        { .is_signer = false, .is_writable = true },
+        { .is_signer = false, .is_writable = true },
+        { .is_signer = false, .is_writable = false },
+        { .is_signer = false, .is_writable = false },
+        { .is_signer = true, .is_writable = false },
+    };
+    memcpy(accounts[0].pubkey, nonce_account, ESPSOL_PUBKEY_SIZE);
+    memcpy(accounts[1].pubkey, to, ESPSOL_PUBKEY_SIZE);
+    memcpy(accounts[2].pubkey, ESPSOL_RECENT_BLOCKHASHES_SYSVAR_ID, ESPSOL_PUBKEY_SIZE);
+    memcpy(accounts[3].pubkey, ESPSOL_RENT_SYSVAR_ID, ESPSOL_PUBKEY_SIZE);
+    memcpy(accounts[4].pubkey, authority, ESPSOL_PUBKEY_SIZE);
+
+    /* Data: u32 discriminator, u64 lamports */
+    uint8_t data[12] = { NONCE_IX_WITHDRAW, 0, 0, 0 };
+    put_u64(data + 4, lamports);
+
+    return espsol_tx_add_instruction(tx, ESPSOL_SYSTEM_PROGRAM_ID,
+                                     accounts, 5, data, sizeof(data));
+}
+
+esp_err_t espsol_tx_add_nonce_authorize(espsol_tx_handle_t tx,
+                                        const uint8_t nonce_account[ESPSOL_PUBKEY_SIZE],
+                                        const uint8_t authority[ESPSOL_PUBKEY_SIZE],
+                                        const uint8_t new_authority[ESPSOL_PUBKEY_SIZE])
+{
+    if (!tx || !nonce_account || !authority || !new_authority) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    espsol_account_meta_t accounts[2] = {
+        { .is_signer = false, .is_writable = true },
+        { .is_signer = true, .is_writable = false },
+    };
+    memcpy(accounts[0].pubkey, nonce_account, ESPSOL_PUBKEY_SIZE);
+    memcpy(accounts[1].pubkey, authority, ESPSOL_PUBKEY_SIZE);
+
+    /* Data: u32 discriminator, new authority */
+    uint8_t data[4 + ESPSOL_PUBKEY_SIZE] = { NONCE_IX_AUTHORIZE, 0, 0, 0 };
+    memcpy(data + 4, new_authority, ESPSOL_PUBKEY_SIZE);
+
+    return espsol_tx_add_instruction(tx, ESPSOL_SYSTEM_PROGRAM_ID,
+                                     accounts, 2, data, sizeof(data));
+}
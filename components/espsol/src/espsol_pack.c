@@ -0,0 +1,368 @@
+/**
+ * @file espsol_pack.c
+ * @brief ESPSOL Instruction Packer Implementation
+ *
+ * The packer keeps one open transaction and its running legacy wire
+ * size. Before each instruction it asks the transaction what the
+ * instruction would add (new accounts, new signers, instruction bytes)
+ * and closes the transaction when a limit would be crossed.
+ *
+ * @copyright Copyright (c) 2025 SkyRizz
+ * @license Apache-2.0
+ */
+
+#include "espsol_pack.h"
+#include "espsol_tx_internal.h"
+
+#include <string.h>
+#include <stdlib.h>
+
+#if defined(ESP_PLATFORM) && ESP_PLATFORM
+#include "esp_log.h"
+static const char *TAG = "espsol_pack";
+#else
+#define ESP_LOGI(tag, ...)
+#define ESP_LOGW(tag, ...)
+#define ESP_LOGE(tag, ...)
+#define ESP_LOGD(tag, ...)
+#endif
+
+#ifdef CONFIG_ESPSOL_DEFAULT_PRIORITY_FEE
+#define DEFAULT_PRIORITY_FEE CONFIG_ESPSOL_DEFAULT_PRIORITY_FEE
+#else
+#define DEFAULT_PRIORITY_FEE 0
+#endif
+
+/** Bytes, accounts and instructions taken by the Compute Budget reserve */
+#if DEFAULT_PRIORITY_FEE > 0
+/* New transactions already hold SetComputeUnitPrice and the program key:
+ * only SetComputeUnitLimit (index, account count, length, 5 data bytes) is left */
+#define COMPUTE_BUDGET_BYTES            8
+#define COMPUTE_BUDGET_ACCOUNTS         0
+#define COMPUTE_BUDGET_INSTRUCTIONS     1
+#else
+#define COMPUTE_BUDGET_BYTES            ESPSOL_PACKER_COMPUTE_BUDGET_BYTES
+#define COMPUTE_BUDGET_ACCOUNTS         1
+#define COMPUTE_BUDGET_INSTRUCTIONS     2
+#endif
+
+/**
+ * Legacy message with only the fee payer: signature count, one
+ * signature, header, key count, payer key, blockhash, instruction count
+ */
+#define EMPTY_TX_SIZE   (1 + ESPSOL_SIGNATURE_SIZE + 3 + 1 + ESPSOL_PUBKEY_SIZE + ESPSOL_BLOCKHASH_SIZE + 1)
+
+/* ============================================================================
+ * Internal Structures
+ * ========================================================================== */
+
+struct espsol_packer {
+    espsol_packer_config_t config;
+    uint8_t blockhash[ESPSOL_BLOCKHASH_SIZE];
+
+    /* Limits after reserves */
+    size_t max_size;
+    size_t max_accounts;
+    size_t max_instructions;
+
+    /* Open transaction and its running totals */
+    espsol_tx_handle_t open;
+    size_t size;
+    size_t accounts;
+    size_t signers;
+    size_t instructions;
+    size_t packed;              /**< Instructions added by the packer */
+
+    /* Closed transactions, oldest at head */
+    espsol_tx_handle_t *closed;
+    size_t closed_head;
+    size_t closed_count;
+    size_t closed_cap;
+};
+
+/* ============================================================================
+ * Internal Helper Functions
+ * ========================================================================== */
+
+static esp_err_t open_tx(struct espsol_packer *packer)
+{
+    espsol_tx_handle_t tx = NULL;
+    esp_err_t err = espsol_tx_create(&tx);
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    espsol_tx_set_fee_payer(tx, packer->config.fee_payer);
+    if (packer->config.blockhash) {
+        espsol_tx_set_recent_blockhash(tx, packer->blockhash);
+    }
+
+    /* A new transaction may already hold the default priority fee instruction */
+    size_t size, accounts, instructions;
+    err = espsol_tx_get_size(tx, &size);
+    if (err == ESP_OK) {
+        err = espsol_tx_get_account_count(tx, &accounts);
+    }
+    if (err == ESP_OK) {
+        err = espsol_tx_get_instruction_count(tx, &instructions);
+    }
+    if (err != ESP_OK) {
+        espsol_tx_destroy(tx);
+        return err;
+    }
+
+    packer->open = tx;
+    packer->size = size;
+    packer->accounts = accounts;
+    packer->signers = 1;
+    packer->instructions = instructions;
+    packer->packed = 0;
+    return ESP_OK;
+}
+
+static esp_err_t close_tx(struct espsol_packer *packer)
+{
+    if (!packer->open) {
+        return ESP_OK;
+    }
+
+    /* Compact the queue to the front before growing it */
+    if (packer->closed_head + packer->closed_count == packer->closed_cap) {
+        if (packer->closed_head > 0) {
+            memmove(packer->closed, packer->closed + packer->closed_head,
+                    packer->closed_count * sizeof(espsol_tx_handle_t));
+            packer->closed_head = 0;
+        } else {
+            size_t cap = packer->closed_cap ? packer->closed_cap * 2 : 4;
+            espsol_tx_handle_t *closed = realloc(packer->closed, cap * sizeof(espsol_tx_handle_t));
+            if (!closed) {
+                return ESP_ERR_NO_MEM;
+            }
+            packer->closed = closed;
+            packer->closed_cap = cap;
+        }
+    }
+
+    packer->closed[packer->closed_head + packer->closed_count++] = packer->open;
+    packer->open = NULL;
+    ESP_LOGD(TAG, "Closed transaction: %u instructions, %u bytes",
+             (unsigned)packer->instructions, (unsigned)packer->size);
+    return ESP_OK;
+}
+
+/**
+ * @brief Check an instruction against the limits of the open transaction
+ */
+static bool fits(const struct espsol_packer *packer, const espsol_tx_cost_t *cost)
+{
+    return packer->instructions + 1 <= packer->max_instructions &&
+           packer->accounts + cost->new_keys <= packer->max_accounts &&
+           packer->signers + cost->new_signers <= ESPSOL_MAX_SIGNERS &&
+           packer->size + cost->new_keys * ESPSOL_PUBKEY_SIZE +
+               cost->new_signers * ESPSOL_SIGNATURE_SIZE + cost->instruction_bytes <= packer->max_size;
+}
+
+/**
+ * @brief Error for an instruction that does not fit an empty transaction
+ */
+static esp_err_t oversize_error(const struct espsol_packer *packer, const espsol_tx_cost_t *cost)
+{
+    bool accounts_ok = packer->accounts + cost->new_keys <= packer->max_accounts &&
+                       packer->signers + cost->new_signers <= ESPSOL_MAX_SIGNERS;
+    return accounts_ok ? ESP_ERR_ESPSOL_BUFFER_TOO_SMALL : ESP_ERR_ESPSOL_MAX_ACCOUNTS;
+}
+
+/* ============================================================================
+ * Packer Lifecycle
+ * ========================================================================== */
+
+esp_err_t espsol_packer_create(const espsol_packer_config_t *config,
+                                espsol_packer_handle_t *packer)
+{
+    if (!config || !packer) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    size_t reserve_bytes = config->reserve_bytes;
+    size_t reserve_accounts = config->reserve_accounts;
+    size_t reserve_instructions = config->reserve_instructions;
+    if (config->reserve_compute_budget) {
+        reserve_bytes += COMPUTE_BUDGET_BYTES;
+        reserve_accounts += COMPUTE_BUDGET_ACCOUNTS;
+        reserve_instructions += COMPUTE_BUDGET_INSTRUCTIONS;
+    }
+
+    /* The fee payer takes one account; every transaction needs one instruction */
+    if (reserve_bytes >= ESPSOL_MAX_TX_SIZE - EMPTY_TX_SIZE ||
+        reserve_accounts >= ESPSOL_MAX_ACCOUNTS - 1 ||
+        reserve_instructions >= ESPSOL_MAX_INSTRUCTIONS) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    struct espsol_packer *p = calloc(1, sizeof(struct espsol_packer));
+    if (!p) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    p->config = *config;
+    if (config->blockhash) {
+        memcpy(p->blockhash, config->blockhash, ESPSOL_BLOCKHASH_SIZE);
+        p->config.blockhash = p->blockhash;
+    }
+    p->max_size = ESPSOL_MAX_TX_SIZE - reserve_bytes;
+    p->max_accounts = ESPSOL_MAX_ACCOUNTS - reserve_accounts;
+    p->max_instructions = ESPSOL_MAX_INSTRUCTIONS - reserve_instructions;
+
+    *packer = p;
+    return ESP_OK;
+}
+
+esp_err_t espsol_packer_destroy(espsol_packer_handle_t packer)
+{
+    if (!packer) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (packer->open) {
+        espsol_tx_destroy(packer->open);
+    }
+    for (size_t i = 0; i < packer->closed_count; i++) {
+        espsol_tx_destroy(packer->closed[packer->closed_head + i]);
+    }
+    free(packer->closed);
+    free(packer);
+    return ESP_OK;
+}
+
+/* ============================================================================
+ * Packing
+ * ========================================================================== */
+
+esp_err_t espsol_packer_add_instruction(espsol_packer_handle_t packer,
+                                         const uint8_t program_id[ESPSOL_PUBKEY_SIZE],
+                                         const espsol_account_meta_t *accounts,
+                                         size_t account_count,
+                                         const uint8_t *data,
+                                         size_t data_len)
+{
+    if (!packer || !program_id || (account_count > 0 && !accounts) ||
+        (data_len > 0 && !data)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    esp_err_t err;
+    espsol_tx_cost_t cost;
+
+    if (!packer->open) {
+        err = open_tx(packer);
+        if (err != ESP_OK) {
+            return err;
+        }
+    }
+
+    err = espsol_tx_instruction_cost(packer->open, program_id, accounts, account_count,
+                                     data_len, &cost);
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    if (!fits(packer, &cost)) {
+        /* Too big for an empty transaction; keep it open for the next instruction */
+        if (packer->packed == 0) {
+            return oversize_error(packer, &cost);
+        }
+
+        err = close_tx(packer);
+        if (err == ESP_OK) {
+            err = open_tx(packer);
+        }
+        if (err != ESP_OK) {
+            return err;
+        }
+        err = espsol_tx_instruction_cost(packer->open, program_id, accounts, account_count,
+                                         data_len, &cost);
+        if (err != ESP_OK) {
+            return err;
+        }
+        if (!fits(packer, &cost)) {
+            return oversize_error(packer, &cost);
+        }
+    }
+
+    err = espsol_tx_add_instruction(packer->open, program_id, accounts, account_count,
+                                    data, data_len);
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    packer->size += cost.new_keys * ESPSOL_PUBKEY_SIZE + cost.new_signers * ESPSOL_SIGNATURE_SIZE +
+                    cost.instruction_bytes;
+    packer->accounts += cost.new_keys;
+    packer->signers += cost.new_signers;
+    packer->instructions++;
+    packer->packed++;
+    return ESP_OK;
+}
+
+esp_err_t espsol_packer_add_transfer(espsol_packer_handle_t packer,
+                                      const uint8_t from[ESPSOL_PUBKEY_SIZE],
+                                      const uint8_t to[ESPSOL_PUBKEY_SIZE],
+                                      uint64_t lamports)
+{
+    if (!packer || !from || !to) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    /* Same layout as espsol_tx_add_transfer() */
+    espsol_account_meta_t accounts[2] = {
+        { .is_signer = true, .is_writable = true },
+        { .is_signer = false, .is_writable = true },
+    };
+    memcpy(accounts[0].pubkey, from, ESPSOL_PUBKEY_SIZE);
+    memcpy(accounts[1].pubkey, to, ESPSOL_PUBKEY_SIZE);
+
+    uint8_t data[12] = { 2, 0, 0, 0 };
+    for (int i = 0; i < 8; i++) {
+        data[4 + i] = (uint8_t)(lamports >> (i * 8));
+    }
+
+    return espsol_packer_add_instruction(packer, ESPSOL_SYSTEM_PROGRAM_ID,
+                                         accounts, 2, data, sizeof(data));
+}
+
+esp_err_t espsol_packer_flush(espsol_packer_handle_t packer)
+{
+    if (!packer) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    /* An open transaction without packed instructions is simply dropped */
+    if (packer->open && packer->packed == 0) {
+        espsol_tx_destroy(packer->open);
+        packer->open = NULL;
+        return ESP_OK;
+    }
+    return close_tx(packer);
+}
+
+esp_err_t espsol_packer_take(espsol_packer_handle_t packer, espsol_tx_handle_t *tx)
+{
+    if (!packer || !tx) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (packer->closed_count == 0) {
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    *tx = packer->closed[packer->closed_head++];
+    if (--packer->closed_count == 0) {
+        packer->closed_head = 0;
+    }
+    return ESP_OK;
+}
+
+size_t espsol_packer_pending(espsol_packer_handle_t packer)
+{
+    return packer ? packer->closed_count : 0;
+}
@@ -2,27 +2,32 @@
  * @file espsol_rpc.c
  * @brief ESPSOL RPC Client Implementation
  *
- * JSON-RPC 2.0 client for Solana RPC nodes using native ESP-IDF
- * esp_http_client and cJSON.
+ * JSON-RPC 2.0 client for Solana RPC nodes. Requests are sent through a
+ * pluggable transport (esp_http_client by default on ESP32) and responses
+ * are read in place with the allocation-free espsol_json reader, so the
+ * same code runs in host builds against a replay transport.
  *
  * @copyright Copyright (c) 2025 SkyRizz
  * @license Apache-2.0
  */
 
 #include "espsol_rpc.h"
+#include "espsol_rpc_internal.h"
 #include "espsol_utils.h"
+#include "espsol_json.h"
+#include "espsol_time.h"
+#include "espsol_worker.h"
 
 #include <string.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <stdarg.h>
 
 #if defined(ESP_PLATFORM) && ESP_PLATFORM
 #include "esp_log.h"
 #include "esp_http_client.h"
 #include "esp_crt_bundle.h"
-#include "cJSON.h"
-#include "freertos/FreeRTOS.h"
-#include "freertos/task.h"
+static const char *TAG = "espsol_rpc";
 #else
 /* Host compilation stubs */
 #define ESP_LOGI(tag, ...)
@@ -31,8 +36,6 @@
 #define ESP_LOGD(tag, ...)
 #endif
 
-static const char *TAG = "espsol_rpc";
-
 /* ============================================================================
  * RPC Client Internal Structure
  * ========================================================================== */
@@ -46,6 +49,10 @@ struct espsol_rpc_client {
     char last_error[256];               /**< Last error message */
     uint8_t max_retries;                /**< Max retry attempts */
     uint32_t retry_delay_ms;            /**< Initial retry delay */
+    espsol_rent_t rent;                 /**< Cached Rent sysvar */
+    bool rent_cached;                   /**< Rent sysvar has been fetched */
+    espsol_rpc_transport_t transport;   /**< Active transport */
+    espsol_call_options_t call_options; /**< Per-call deadline and cancellation */
 #if defined(ESP_PLATFORM) && ESP_PLATFORM
     esp_http_client_handle_t http_client;  /**< HTTP client handle */
 #endif
@@ -77,11 +84,11 @@ const char *espsol_commitment_to_str(espsol_commitment_t commitment)
 
 /**
  * @brief HTTP event handler for esp_http_client
+ *
+ * Response data is read by http_transport_perform(); events are only logged.
  */
 static esp_err_t http_event_handler(esp_http_client_event_t *evt)
 {
-    struct espsol_rpc_client *client = (struct espsol_rpc_client *)evt->user_data;
-    
     switch (evt->event_id) {
         case HTTP_EVENT_ERROR:
             ESP_LOGD(TAG, "HTTP_EVENT_ERROR");
@@ -97,13 +104,6 @@ static esp_err_t http_event_handler(esp_http_client_event_t *evt)
             break;
         case HTTP_EVENT_ON_DATA:
             ESP_LOGD(TAG, "HTTP_EVENT_ON_DATA, len=%d", evt->data_len);
-            if (client && client->response_buffer && evt->data_len > 0) {
-                size_t current_len = strlen(client->response_buffer);
-                if (current_len + evt->data_len < client->buffer_size - 1) {
-                    memcpy(client->response_buffer + current_len, evt->data, evt->data_len);
-                    client->response_buffer[current_len + evt->data_len] = '\0';
-                }
-            }
             break;
         case HTTP_EVENT_ON_FINISH:
             ESP_LOGD(TAG, "HTTP_EVENT_ON_FINISH");
@@ -118,162 +118,595 @@ static esp_err_t http_event_handler(esp_http_client_event_t *evt)
     return ESP_OK;
 }
 
+/**
+ * @brief Default streaming transport: HTTP POST with esp_http_client
+ *
+ * Uses the open/write/read API with a short socket timeout so the deadline
+ * and cancellation token are re-checked while waiting for the response.
+ */
+static esp_err_t http_transport_perform_stream(void *ctx,
+                                               const char *request, size_t request_len,
+                                               espsol_rpc_sink_fn sink, void *sink_ctx,
+                                               int *status_code,
+                                               const espsol_deadline_t *deadline)
+{
+    struct espsol_rpc_client *client = ctx;
+    esp_http_client_handle_t http = client->http_client;
+
+    /* Socket waits are bounded by the client timeout and the deadline */
+    uint32_t wait_ms = espsol_deadline_remaining_ms(deadline, client->timeout_ms);
+    if (deadline->cancel && wait_ms > ESPSOL_CANCEL_POLL_MS) {
+        wait_ms = ESPSOL_CANCEL_POLL_MS;
+    }
+    if (wait_ms == 0) {
+        return ESP_ERR_ESPSOL_TIMEOUT;
+    }
+    esp_http_client_set_timeout_ms(http, (int)wait_ms);
+
+    esp_err_t err = esp_http_client_open(http, (int)request_len);
+    if (err != ESP_OK) {
+        snprintf(client->last_error, sizeof(client->last_error),
+                 "HTTP request failed: %s", esp_err_to_name(err));
+        return ESP_ERR_ESPSOL_NETWORK_ERROR;
+    }
+
+    int64_t idle_since = espsol_time_us();
+    size_t written = 0;
+
+    while (written < request_len) {
+        int n = esp_http_client_write(http, request + written, (int)(request_len - written));
+        if (n < 0) {
+            err = ESP_ERR_ESPSOL_NETWORK_ERROR;
+            goto done;
+        }
+        written += (size_t)n;
+    }
+
+    /* Wait for headers, then body, in cancellable slices */
+    for (;;) {
+        int64_t length = esp_http_client_fetch_headers(http);
+        if (length >= 0) {
+            break;
+        }
+        if (length != -ESP_ERR_HTTP_EAGAIN) {
+            err = ESP_ERR_ESPSOL_NETWORK_ERROR;
+            goto done;
+        }
+        if ((err = espsol_deadline_check(deadline)) != ESP_OK) {
+            goto done;
+        }
+        if (espsol_time_us() - idle_since >= (int64_t)client->timeout_ms * 1000) {
+            err = ESP_ERR_ESPSOL_NETWORK_ERROR;
+            goto done;
+        }
+    }
+
+    *status_code = esp_http_client_get_status_code(http);
+    idle_since = espsol_time_us();
+
+    while (!esp_http_client_is_complete_data_received(http)) {
+        if ((err = espsol_deadline_check(deadline)) != ESP_OK) {
+            goto done;
+        }
+
+        char chunk[512];
+        int n = esp_http_client_read(http, chunk, sizeof(chunk));
+        if (n > 0) {
+            if ((err = sink(sink_ctx, *status_code, chunk, (size_t)n)) != ESP_OK) {
+                goto done;
+            }
+            idle_since = espsol_time_us();
+        } else if (n == 0) {
+            break;
+        } else if (n != -ESP_ERR_HTTP_EAGAIN ||
+                   espsol_time_us() - idle_since >= (int64_t)client->timeout_ms * 1000) {
+            err = ESP_ERR_ESPSOL_NETWORK_ERROR;
+            goto done;
+        }
+    }
+
+    err = ESP_OK;
+
+done:
+    if (err == ESP_ERR_ESPSOL_NETWORK_ERROR) {
+        snprintf(client->last_error, sizeof(client->last_error), "HTTP connection failed");
+    }
+    esp_http_client_close(http);
+    return err;
+}
+
+/**
+ * @brief Response buffer filled by buffer_sink()
+ */
+typedef struct {
+    char *data;         /**< Destination buffer */
+    size_t capacity;    /**< Capacity of data */
+    size_t len;         /**< Bytes stored */
+    bool overflow;      /**< Response exceeded capacity */
+} response_sink_t;
+
+static esp_err_t buffer_sink(void *sink_ctx, int status_code, const char *data, size_t len)
+{
+    response_sink_t *rsp = sink_ctx;
+    (void)status_code;
+
+    /* Keep draining after an overflow so the connection stays reusable */
+    if (len > rsp->capacity - rsp->len) {
+        rsp->overflow = true;
+        return ESP_OK;
+    }
+    memcpy(rsp->data + rsp->len, data, len);
+    rsp->len += len;
+    return ESP_OK;
+}
+
+/**
+ * @brief Default transport: buffered HTTP exchange
+ */
+static esp_err_t http_transport_perform(void *ctx,
+                                        const char *request, size_t request_len,
+                                        char *response, size_t response_cap,
+                                        size_t *response_len,
+                                        int *status_code,
+                                        const espsol_deadline_t *deadline)
+{
+    response_sink_t rsp = { .data = response, .capacity = response_cap };
+
+    esp_err_t err = http_transport_perform_stream(ctx, request, request_len,
+                                                  buffer_sink, &rsp,
+                                                  status_code, deadline);
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    *response_len = rsp.len;
+    return rsp.overflow ? ESP_ERR_ESPSOL_BUFFER_TOO_SMALL : ESP_OK;
+}
+
+#endif /* ESP_PLATFORM */
+
+/**
+ * @brief Install the platform default transport
+ */
+static void set_default_transport(struct espsol_rpc_client *client)
+{
+#if defined(ESP_PLATFORM) && ESP_PLATFORM
+    client->transport.perform = http_transport_perform;
+    client->transport.perform_stream = http_transport_perform_stream;
+    client->transport.ctx = client;
+#else
+    /* Host builds have no network; a transport must be installed */
+    client->transport.perform = NULL;
+    client->transport.perform_stream = NULL;
+    client->transport.ctx = NULL;
+#endif
+}
+
+/**
+ * @brief Check that a caller string can be embedded in JSON as-is
+ *
+ * String parameters are Base58/Base64 values or method names, which never
+ * need escaping; anything else is rejected rather than escaped.
+ */
+static bool is_json_safe(const char *s)
+{
+    for (; *s; s++) {
+        unsigned char c = (unsigned char)*s;
+        if (c < 0x20 || c == '"' || c == '\\') {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief printf into a newly allocated string
+ */
+static char *format_alloc(const char *fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    int len = vsnprintf(NULL, 0, fmt, args);
+    va_end(args);
+
+    if (len < 0) {
+        return NULL;
+    }
+
+    char *str = malloc((size_t)len + 1);
+    if (!str) {
+        return NULL;
+    }
+
+    va_start(args, fmt);
+    vsnprintf(str, (size_t)len + 1, fmt, args);
+    va_end(args);
+
+    return str;
+}
+
 /**
  * @brief Build JSON-RPC 2.0 request
  */
 static char *build_jsonrpc_request(struct espsol_rpc_client *client,
                                     const char *method,
-                                    cJSON *params)
+                                    const char *params)
 {
-    cJSON *root = cJSON_CreateObject();
-    if (!root) {
-        return NULL;
+    return format_alloc("{\"jsonrpc\":\"2.0\",\"id\":%lu,\"method\":\"%s\",\"params\":%s}",
+                        (unsigned long)++client->request_id, method,
+                        params ? params : "[]");
+}
+
+/**
+ * @brief Record a failed transport exchange
+ */
+static esp_err_t transport_error(struct espsol_rpc_client *client, esp_err_t err)
+{
+    if (err == ESP_ERR_ESPSOL_BUFFER_TOO_SMALL) {
+        snprintf(client->last_error, sizeof(client->last_error),
+                 "Response exceeds %u byte buffer", (unsigned)client->buffer_size);
+        ESP_LOGE(TAG, "%s", client->last_error);
+        return err;
     }
-    
-    cJSON_AddStringToObject(root, "jsonrpc", "2.0");
-    cJSON_AddNumberToObject(root, "id", ++client->request_id);
-    cJSON_AddStringToObject(root, "method", method);
-    
-    if (params) {
-        cJSON_AddItemToObject(root, "params", params);
-    } else {
-        cJSON_AddItemToObject(root, "params", cJSON_CreateArray());
+    if (err == ESP_ERR_ESPSOL_TIMEOUT || err == ESP_ERR_ESPSOL_CANCELLED) {
+        snprintf(client->last_error, sizeof(client->last_error), "%s",
+                 err == ESP_ERR_ESPSOL_TIMEOUT ? "Deadline exceeded" : "Cancelled");
+        ESP_LOGW(TAG, "%s", client->last_error);
+        return err;
+    }
+    if (client->last_error[0] == '\0') {
+        snprintf(client->last_error, sizeof(client->last_error),
+                 "Transport error 0x%x", (unsigned)err);
     }
-    
-    char *request = cJSON_PrintUnformatted(root);
-    cJSON_Delete(root);
-    
-    return request;
+    ESP_LOGE(TAG, "%s", client->last_error);
+    return err;
+}
+
+/**
+ * @brief Record a non-200 HTTP status
+ */
+static esp_err_t http_status_error(struct espsol_rpc_client *client, int status_code)
+{
+    snprintf(client->last_error, sizeof(client->last_error),
+             "HTTP error: status code %d", status_code);
+    ESP_LOGE(TAG, "%s", client->last_error);
+    /* Return special error for rate limiting (429) to allow retry */
+    if (status_code == 429) {
+        return ESP_ERR_ESPSOL_RATE_LIMITED;
+    }
+    return ESP_ERR_ESPSOL_RPC_FAILED;
 }
 
 /**
- * @brief Execute JSON-RPC request with retry logic
+ * @brief Execute a single JSON-RPC exchange and locate the result
+ *
+ * The result span points into the client's response buffer and stays
+ * valid until the next request on this client.
  */
 static esp_err_t execute_rpc_request_internal(struct espsol_rpc_client *client,
                                                const char *request_body,
-                                               cJSON **result)
+                                               const espsol_deadline_t *deadline,
+                                               espsol_json_t *result)
 {
-    if (!client || !request_body || !result) {
+    if (!client || !request_body || !deadline || !result) {
         return ESP_ERR_INVALID_ARG;
     }
-    
-    *result = NULL;
+
     client->last_error[0] = '\0';
-    
-    /* Clear response buffer */
-    memset(client->response_buffer, 0, client->buffer_size);
-    
-    /* Set POST data */
-    esp_http_client_set_post_field(client->http_client, request_body, strlen(request_body));
-    
+
     ESP_LOGD(TAG, "RPC Request: %s", request_body);
-    
-    /* Perform HTTP request */
-    esp_err_t err = esp_http_client_perform(client->http_client);
+
+    size_t response_len = 0;
+    int status_code = 0;
+    esp_err_t err = client->transport.perform(client->transport.ctx,
+                                              request_body, strlen(request_body),
+                                              client->response_buffer,
+                                              client->buffer_size - 1,
+                                              &response_len, &status_code,
+                                              deadline);
     if (err != ESP_OK) {
-        snprintf(client->last_error, sizeof(client->last_error), 
-                 "HTTP request failed: %s", esp_err_to_name(err));
-        ESP_LOGE(TAG, "%s", client->last_error);
-        return ESP_ERR_ESPSOL_NETWORK_ERROR;
+        return transport_error(client, err);
     }
-    
-    int status_code = esp_http_client_get_status_code(client->http_client);
+
+    if (response_len > client->buffer_size - 1) {
+        response_len = client->buffer_size - 1;
+    }
+    client->response_buffer[response_len] = '\0';
+
     if (status_code != 200) {
-        snprintf(client->last_error, sizeof(client->last_error),
-                 "HTTP error: status code %d", status_code);
-        ESP_LOGE(TAG, "%s", client->last_error);
-        /* Return special error for rate limiting (429) to allow retry */
-        if (status_code == 429) {
-            return ESP_ERR_ESPSOL_RATE_LIMITED;
-        }
-        return ESP_ERR_ESPSOL_RPC_FAILED;
+        return http_status_error(client, status_code);
     }
-    
+
     ESP_LOGD(TAG, "RPC Response: %s", client->response_buffer);
-    
+
     /* Parse JSON response */
-    cJSON *json = cJSON_Parse(client->response_buffer);
-    if (!json) {
+    espsol_json_t json;
+    if (!espsol_json_parse(client->response_buffer, response_len, &json) ||
+        espsol_json_type(&json) != ESPSOL_JSON_OBJECT) {
         snprintf(client->last_error, sizeof(client->last_error),
                  "Failed to parse JSON response");
         ESP_LOGE(TAG, "%s", client->last_error);
         return ESP_ERR_ESPSOL_RPC_PARSE_ERROR;
     }
-    
+
     /* Check for JSON-RPC error */
-    cJSON *error = cJSON_GetObjectItem(json, "error");
-    if (error && cJSON_IsObject(error)) {
-        cJSON *error_msg = cJSON_GetObjectItem(error, "message");
-        cJSON *error_code = cJSON_GetObjectItem(error, "code");
-        snprintf(client->last_error, sizeof(client->last_error),
-                 "RPC error %d: %s",
-                 error_code ? error_code->valueint : -1,
-                 error_msg && error_msg->valuestring ? error_msg->valuestring : "Unknown error");
-        ESP_LOGE(TAG, "%s", client->last_error);
-        cJSON_Delete(json);
-        return ESP_ERR_ESPSOL_RPC_FAILED;
+    espsol_json_t error;
+    if (espsol_json_get(&json, "error", &error) &&
+        espsol_json_type(&error) == ESPSOL_JSON_OBJECT) {
+        return espsol_rpc_report_error(client, &error);
     }
-    
+
     /* Extract result */
-    *result = cJSON_DetachItemFromObject(json, "result");
-    cJSON_Delete(json);
-    
-    if (!*result) {
+    if (!espsol_json_get(&json, "result", result)) {
         snprintf(client->last_error, sizeof(client->last_error),
                  "No result in RPC response");
         ESP_LOGE(TAG, "%s", client->last_error);
         return ESP_ERR_ESPSOL_RPC_PARSE_ERROR;
     }
-    
+
+    return ESP_OK;
+}
+
+/**
+ * @brief State of a streamed exchange
+ */
+typedef struct {
+    espsol_rpc_sink_fn sink;    /**< Caller's sink */
+    void *sink_ctx;             /**< Caller's sink context */
+    bool delivered;             /**< Part of the body reached the sink */
+} rpc_stream_t;
+
+static esp_err_t stream_sink(void *sink_ctx, int status_code, const char *data, size_t len)
+{
+    rpc_stream_t *stream = sink_ctx;
+
+    /* Error bodies are not passed on */
+    if (status_code != 200) {
+        return ESP_OK;
+    }
+    stream->delivered = true;
+    return stream->sink(stream->sink_ctx, status_code, data, len);
+}
+
+/**
+ * @brief Execute a single exchange, streaming the response body
+ *
+ * Transports without streaming support receive the body into the client
+ * buffer and hand it to the sink in one piece.
+ */
+static esp_err_t execute_rpc_stream_internal(struct espsol_rpc_client *client,
+                                             const char *request_body,
+                                             const espsol_deadline_t *deadline,
+                                             rpc_stream_t *stream)
+{
+    client->last_error[0] = '\0';
+
+    ESP_LOGD(TAG, "RPC Request: %s", request_body);
+
+    int status_code = 0;
+    esp_err_t err;
+
+    if (client->transport.perform_stream) {
+        err = client->transport.perform_stream(client->transport.ctx,
+                                               request_body, strlen(request_body),
+                                               stream_sink, stream,
+                                               &status_code, deadline);
+    } else {
+        size_t response_len = 0;
+        err = client->transport.perform(client->transport.ctx,
+                                        request_body, strlen(request_body),
+                                        client->response_buffer,
+                                        client->buffer_size - 1,
+                                        &response_len, &status_code,
+                                        deadline);
+        if (err == ESP_OK && status_code == 200) {
+            err = stream_sink(stream, status_code, client->response_buffer, response_len);
+        }
+    }
+
+    if (err != ESP_OK) {
+        return transport_error(client, err);
+    }
+    if (status_code != 200) {
+        return http_status_error(client, status_code);
+    }
     return ESP_OK;
 }
 
+/**
+ * @brief Record why a call stopped early
+ */
+static esp_err_t deadline_error(struct espsol_rpc_client *client, esp_err_t err)
+{
+    snprintf(client->last_error, sizeof(client->last_error), "%s",
+             err == ESP_ERR_ESPSOL_CANCELLED ? "Cancelled" : "Deadline exceeded");
+    ESP_LOGW(TAG, "%s", client->last_error);
+    return err;
+}
+
 /**
  * @brief Execute JSON-RPC request with automatic retry and exponential backoff
+ *
+ * Retries and backoff stay within the call deadline: a retry whose backoff
+ * would end past the deadline is not attempted. With stream set, the body
+ * goes to the stream's sink and the request is only retried while none of
+ * it has been delivered.
  */
 static esp_err_t execute_rpc_request(struct espsol_rpc_client *client,
                                       const char *request_body,
-                                      cJSON **result)
+                                      const espsol_deadline_t *deadline,
+                                      espsol_json_t *result,
+                                      rpc_stream_t *stream)
 {
+    if (!client->transport.perform) {
+        snprintf(client->last_error, sizeof(client->last_error),
+                 "No transport configured");
+        ESP_LOGE(TAG, "%s", client->last_error);
+        return ESP_ERR_ESPSOL_NETWORK_ERROR;
+    }
+
     esp_err_t err = ESP_FAIL;
     uint8_t attempt = 0;
     uint32_t delay_ms = client->retry_delay_ms;
-    
+
     while (attempt <= client->max_retries) {
-        err = execute_rpc_request_internal(client, request_body, result);
-        
+        esp_err_t limit = espsol_deadline_check(deadline);
+        if (limit != ESP_OK) {
+            return deadline_error(client, limit);
+        }
+
+        err = stream ? execute_rpc_stream_internal(client, request_body, deadline, stream)
+                     : execute_rpc_request_internal(client, request_body, deadline, result);
+
         /* Success - return immediately */
         if (err == ESP_OK) {
             return ESP_OK;
         }
-        
+
         /* Don't retry on non-recoverable errors */
-        if (err != ESP_ERR_ESPSOL_NETWORK_ERROR && 
+        if (err != ESP_ERR_ESPSOL_NETWORK_ERROR &&
             err != ESP_ERR_ESPSOL_RATE_LIMITED) {
             return err;
         }
-        
+        if (stream && stream->delivered) {
+            return err;     /* The sink already consumed part of the body */
+        }
+
         attempt++;
-        
+
         /* If we have retries left, wait and try again */
         if (attempt <= client->max_retries) {
-            ESP_LOGW(TAG, "Request failed, retry %u/%u in %lu ms...", 
+            if (espsol_deadline_remaining_ms(deadline, delay_ms) < delay_ms) {
+                return deadline_error(client, ESP_ERR_ESPSOL_TIMEOUT);
+            }
+
+            ESP_LOGW(TAG, "Request failed, retry %u/%u in %lu ms...",
                      attempt, client->max_retries, (unsigned long)delay_ms);
-            vTaskDelay(pdMS_TO_TICKS(delay_ms));
+            limit = espsol_deadline_sleep(deadline, delay_ms);
+            if (limit != ESP_OK) {
+                return deadline_error(client, limit);
+            }
             delay_ms *= 2;  /* Exponential backoff */
-            
+
             /* Cap delay at 10 seconds */
             if (delay_ms > 10000) {
                 delay_ms = 10000;
             }
         }
     }
-    
+
     ESP_LOGE(TAG, "Request failed after %u retries", client->max_retries);
     return err;
 }
 
-#endif /* ESP_PLATFORM */
+/**
+ * @brief Build, execute and free a JSON-RPC request
+ */
+static esp_err_t rpc_request(struct espsol_rpc_client *client,
+                             const char *method,
+                             const char *params,
+                             espsol_json_t *result)
+{
+    espsol_deadline_t deadline;
+    espsol_deadline_start(&deadline, &client->call_options);
+
+    char *request = build_jsonrpc_request(client, method, params);
+    if (!request) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    esp_err_t err = execute_rpc_request(client, request, &deadline, result, NULL);
+    free(request);
+    return err;
+}
+
+esp_err_t espsol_rpc_stream_request(espsol_rpc_handle_t handle,
+                                    const char *method,
+                                    const char *params,
+                                    espsol_rpc_sink_fn sink,
+                                    void *sink_ctx)
+{
+    if (!handle || !method || !sink) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    struct espsol_rpc_client *client = handle;
+    espsol_deadline_t deadline;
+    espsol_deadline_start(&deadline, &client->call_options);
+
+    char *request = build_jsonrpc_request(client, method, params);
+    if (!request) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    rpc_stream_t stream = { .sink = sink, .sink_ctx = sink_ctx, .delivered = false };
+    esp_err_t err = execute_rpc_request(client, request, &deadline, NULL, &stream);
+    free(request);
+    return err;
+}
+
+void espsol_rpc_set_last_error(espsol_rpc_handle_t handle, const char *message)
+{
+    struct espsol_rpc_client *client = handle;
+    snprintf(client->last_error, sizeof(client->last_error), "%s", message);
+}
+
+int64_t espsol_rpc_error_code(const espsol_json_t *error)
+{
+    espsol_json_t error_code;
+    int64_t code = -1;
+
+    if (espsol_json_get(error, "code", &error_code)) {
+        espsol_json_get_i64(&error_code, &code);
+    }
+    return code;
+}
+
+esp_err_t espsol_rpc_report_error(espsol_rpc_handle_t handle, const espsol_json_t *error)
+{
+    struct espsol_rpc_client *client = handle;
+    espsol_json_t error_msg;
+    char message[160];
+
+    if (!espsol_json_get(error, "message", &error_msg) ||
+        espsol_json_get_string(&error_msg, message, sizeof(message)) != ESP_OK) {
+        strcpy(message, "Unknown error");
+    }
+
+    snprintf(client->last_error, sizeof(client->last_error),
+             "RPC error %d: %s", (int)espsol_rpc_error_code(error), message);
+    ESP_LOGE(TAG, "%s", client->last_error);
+    return ESP_ERR_ESPSOL_RPC_FAILED;
+}
+
+espsol_commitment_t espsol_rpc_get_commitment(espsol_rpc_handle_t handle)
+{
+    return handle->commitment;
+}
+
+/**
+ * @brief Copy a JSON string value into a caller buffer
+ */
+static esp_err_t copy_json_string(const espsol_json_t *value, char *out, size_t out_len)
+{
+    esp_err_t err = espsol_json_get_string(value, out, out_len);
+    if (err == ESP_ERR_INVALID_ARG) {
+        return ESP_ERR_ESPSOL_RPC_PARSE_ERROR;
+    }
+    return err;
+}
+
+/**
+ * @brief Read a u64 encoded as a decimal string (token amounts)
+ */
+static bool json_get_u64_string(const espsol_json_t *value, uint64_t *out)
+{
+    if (espsol_json_type(value) != ESPSOL_JSON_STRING || value->len < 3) {
+        return false;
+    }
+    espsol_json_t digits = { .ptr = value->ptr + 1, .len = value->len - 2 };
+    return espsol_json_get_u64(&digits, out);
+}
 
 /* ============================================================================
  * Connection Management
@@ -292,15 +725,18 @@ esp_err_t espsol_rpc_init_with_config(espsol_rpc_handle_t *handle,
     if (!handle || !config || !config->endpoint) {
         return ESP_ERR_INVALID_ARG;
     }
-    
-#if defined(ESP_PLATFORM) && ESP_PLATFORM
+
+    if (config->transport && !config->transport->perform) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
     /* Allocate client structure */
     struct espsol_rpc_client *client = calloc(1, sizeof(struct espsol_rpc_client));
     if (!client) {
         ESP_LOGE(TAG, "Failed to allocate RPC client");
         return ESP_ERR_NO_MEM;
     }
-    
+
     /* Copy endpoint */
     client->endpoint = strdup(config->endpoint);
     if (!client->endpoint) {
@@ -308,7 +744,7 @@ esp_err_t espsol_rpc_init_with_config(espsol_rpc_handle_t *handle,
         ESP_LOGE(TAG, "Failed to allocate endpoint string");
         return ESP_ERR_NO_MEM;
     }
-    
+
     /* Set configuration */
     client->timeout_ms = config->timeout_ms;
     client->commitment = config->commitment;
@@ -317,7 +753,7 @@ esp_err_t espsol_rpc_init_with_config(espsol_rpc_handle_t *handle,
     client->last_error[0] = '\0';
     client->max_retries = config->max_retries;
     client->retry_delay_ms = config->retry_delay_ms > 0 ? config->retry_delay_ms : 500;
-    
+
     /* Allocate response buffer */
     client->response_buffer = calloc(1, client->buffer_size);
     if (!client->response_buffer) {
@@ -326,7 +762,8 @@ esp_err_t espsol_rpc_init_with_config(espsol_rpc_handle_t *handle,
         ESP_LOGE(TAG, "Failed to allocate response buffer");
         return ESP_ERR_NO_MEM;
     }
-    
+
+#if defined(ESP_PLATFORM) && ESP_PLATFORM
     /* Initialize HTTP client */
     esp_http_client_config_t http_config = {
         .url = client->endpoint,
@@ -339,7 +776,7 @@ esp_err_t espsol_rpc_init_with_config(espsol_rpc_handle_t *handle,
         /* Use ESP-IDF global CA store or skip verification for devnet testing */
         .crt_bundle_attach = esp_crt_bundle_attach,
     };
-    
+
     client->http_client = esp_http_client_init(&http_config);
     if (!client->http_client) {
         free(client->response_buffer);
@@ -348,19 +785,20 @@ esp_err_t espsol_rpc_init_with_config(espsol_rpc_handle_t *handle,
         ESP_LOGE(TAG, "Failed to initialize HTTP client");
         return ESP_ERR_ESPSOL_NETWORK_ERROR;
     }
-    
+
     /* Set JSON content type */
     esp_http_client_set_header(client->http_client, "Content-Type", "application/json");
-    
+#endif
+
+    if (config->transport) {
+        client->transport = *config->transport;
+    } else {
+        set_default_transport(client);
+    }
+
     *handle = client;
     ESP_LOGI(TAG, "RPC client initialized: %s", config->endpoint);
     return ESP_OK;
-#else
-    /* Host compilation - no actual HTTP */
-    (void)config;
-    *handle = NULL;
-    return ESP_OK;
-#endif
 }
 
 esp_err_t espsol_rpc_deinit(espsol_rpc_handle_t handle)
@@ -368,21 +806,20 @@ esp_err_t espsol_rpc_deinit(espsol_rpc_handle_t handle)
     if (!handle) {
         return ESP_ERR_INVALID_ARG;
     }
-    
-#if defined(ESP_PLATFORM) && ESP_PLATFORM
+
     struct espsol_rpc_client *client = handle;
-    
+
+#if defined(ESP_PLATFORM) && ESP_PLATFORM
     if (client->http_client) {
         esp_http_client_cleanup(client->http_client);
     }
-    
+#endif
+
     free(client->response_buffer);
     free(client->endpoint);
     free(client);
-    
+
     ESP_LOGI(TAG, "RPC client deinitialized");
-#endif
-    
     return ESP_OK;
 }
 
@@ -391,15 +828,13 @@ esp_err_t espsol_rpc_set_timeout(espsol_rpc_handle_t handle, uint32_t timeout_ms
     if (!handle) {
         return ESP_ERR_INVALID_ARG;
     }
-    
-#if defined(ESP_PLATFORM) && ESP_PLATFORM
+
     struct espsol_rpc_client *client = handle;
     client->timeout_ms = timeout_ms;
+#if defined(ESP_PLATFORM) && ESP_PLATFORM
     esp_http_client_set_timeout_ms(client->http_client, timeout_ms);
-#else
-    (void)timeout_ms;
 #endif
-    
+
     return ESP_OK;
 }
 
@@ -409,14 +844,58 @@ esp_err_t espsol_rpc_set_commitment(espsol_rpc_handle_t handle,
     if (!handle) {
         return ESP_ERR_INVALID_ARG;
     }
-    
-#if defined(ESP_PLATFORM) && ESP_PLATFORM
+
     struct espsol_rpc_client *client = handle;
     client->commitment = commitment;
-#else
-    (void)commitment;
-#endif
-    
+
+    return ESP_OK;
+}
+
+esp_err_t espsol_rpc_set_transport(espsol_rpc_handle_t handle,
+                                    const espsol_rpc_transport_t *transport)
+{
+    if (!handle || (transport && !transport->perform)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    struct espsol_rpc_client *client = handle;
+    if (transport) {
+        client->transport = *transport;
+    } else {
+        set_default_transport(client);
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t espsol_rpc_set_call_options(espsol_rpc_handle_t handle,
+                                       const espsol_call_options_t *options)
+{
+    if (!handle) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    struct espsol_rpc_client *client = handle;
+    if (options) {
+        client->call_options = *options;
+    } else {
+        espsol_call_options_t defaults = ESPSOL_CALL_OPTIONS_DEFAULT();
+        client->call_options = defaults;
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t espsol_rpc_get_transport(espsol_rpc_handle_t handle,
+                                    espsol_rpc_transport_t *transport)
+{
+    if (!handle || !transport) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    struct espsol_rpc_client *client = handle;
+    *transport = client->transport;
+
     return ESP_OK;
 }
 
@@ -425,13 +904,9 @@ const char *espsol_rpc_get_last_error(espsol_rpc_handle_t handle)
     if (!handle) {
         return NULL;
     }
-    
-#if defined(ESP_PLATFORM) && ESP_PLATFORM
+
     struct espsol_rpc_client *client = handle;
     return client->last_error[0] ? client->last_error : NULL;
-#else
-    return NULL;
-#endif
 }
 
 /* ============================================================================
@@ -444,46 +919,20 @@ esp_err_t espsol_rpc_get_version(espsol_rpc_handle_t handle,
     if (!handle || !version || len == 0) {
         return ESP_ERR_INVALID_ARG;
     }
-    
-#if defined(ESP_PLATFORM) && ESP_PLATFORM
-    struct espsol_rpc_client *client = handle;
-    
-    char *request = build_jsonrpc_request(client, "getVersion", NULL);
-    if (!request) {
-        return ESP_ERR_NO_MEM;
-    }
-    
-    cJSON *result = NULL;
-    esp_err_t err = execute_rpc_request(client, request, &result);
-    free(request);
-    
+
+    espsol_json_t result;
+    esp_err_t err = rpc_request(handle, "getVersion", NULL, &result);
     if (err != ESP_OK) {
         return err;
     }
-    
+
     /* Extract version string */
-    cJSON *solana_core = cJSON_GetObjectItem(result, "solana-core");
-    if (!solana_core || !cJSON_IsString(solana_core)) {
-        cJSON_Delete(result);
+    espsol_json_t solana_core;
+    if (!espsol_json_get(&result, "solana-core", &solana_core)) {
         return ESP_ERR_ESPSOL_RPC_PARSE_ERROR;
     }
-    
-    size_t ver_len = strlen(solana_core->valuestring);
-    if (ver_len >= len) {
-        cJSON_Delete(result);
-        return ESP_ERR_ESPSOL_BUFFER_TOO_SMALL;
-    }
-    
-    strncpy(version, solana_core->valuestring, len - 1);
-    version[len - 1] = '\0';
-    
-    cJSON_Delete(result);
-    return ESP_OK;
-#else
-    (void)len;
-    strcpy(version, "1.18.0");  /* Mock version for host testing */
-    return ESP_OK;
-#endif
+
+    return copy_json_string(&solana_core, version, len);
 }
 
 esp_err_t espsol_rpc_get_slot(espsol_rpc_handle_t handle, uint64_t *slot)
@@ -491,41 +940,23 @@ esp_err_t espsol_rpc_get_slot(espsol_rpc_handle_t handle, uint64_t *slot)
     if (!handle || !slot) {
         return ESP_ERR_INVALID_ARG;
     }
-    
-#if defined(ESP_PLATFORM) && ESP_PLATFORM
-    struct espsol_rpc_client *client = handle;
-    
+
     /* Build params with commitment */
-    cJSON *params = cJSON_CreateArray();
-    cJSON *config = cJSON_CreateObject();
-    cJSON_AddStringToObject(config, "commitment", espsol_commitment_to_str(client->commitment));
-    cJSON_AddItemToArray(params, config);
-    
-    char *request = build_jsonrpc_request(client, "getSlot", params);
-    if (!request) {
-        return ESP_ERR_NO_MEM;
-    }
-    
-    cJSON *result = NULL;
-    esp_err_t err = execute_rpc_request(client, request, &result);
-    free(request);
-    
+    char params[48];
+    snprintf(params, sizeof(params), "[{\"commitment\":\"%s\"}]",
+             espsol_commitment_to_str(handle->commitment));
+
+    espsol_json_t result;
+    esp_err_t err = rpc_request(handle, "getSlot", params, &result);
     if (err != ESP_OK) {
         return err;
     }
-    
-    if (!cJSON_IsNumber(result)) {
-        cJSON_Delete(result);
+
+    if (!espsol_json_get_u64(&result, slot)) {
         return ESP_ERR_ESPSOL_RPC_PARSE_ERROR;
     }
-    
-    *slot = (uint64_t)result->valuedouble;
-    cJSON_Delete(result);
-    return ESP_OK;
-#else
-    *slot = 123456789;  /* Mock slot for host testing */
+
     return ESP_OK;
-#endif
 }
 
 esp_err_t espsol_rpc_get_block_height(espsol_rpc_handle_t handle, uint64_t *height)
@@ -533,41 +964,23 @@ esp_err_t espsol_rpc_get_block_height(espsol_rpc_handle_t handle, uint64_t *heig
     if (!handle || !height) {
         return ESP_ERR_INVALID_ARG;
     }
-    
-#if defined(ESP_PLATFORM) && ESP_PLATFORM
-    struct espsol_rpc_client *client = handle;
-    
+
     /* Build params with commitment */
-    cJSON *params = cJSON_CreateArray();
-    cJSON *config = cJSON_CreateObject();
-    cJSON_AddStringToObject(config, "commitment", espsol_commitment_to_str(client->commitment));
-    cJSON_AddItemToArray(params, config);
-    
-    char *request = build_jsonrpc_request(client, "getBlockHeight", params);
-    if (!request) {
-        return ESP_ERR_NO_MEM;
-    }
-    
-    cJSON *result = NULL;
-    esp_err_t err = execute_rpc_request(client, request, &result);
-    free(request);
-    
+    char params[48];
+    snprintf(params, sizeof(params), "[{\"commitment\":\"%s\"}]",
+             espsol_commitment_to_str(handle->commitment));
+
+    espsol_json_t result;
+    esp_err_t err = rpc_request(handle, "getBlockHeight", params, &result);
     if (err != ESP_OK) {
         return err;
     }
-    
-    if (!cJSON_IsNumber(result)) {
-        cJSON_Delete(result);
+
+    if (!espsol_json_get_u64(&result, height)) {
         return ESP_ERR_ESPSOL_RPC_PARSE_ERROR;
     }
-    
-    *height = (uint64_t)result->valuedouble;
-    cJSON_Delete(result);
-    return ESP_OK;
-#else
-    *height = 100000000;  /* Mock height for host testing */
+
     return ESP_OK;
-#endif
 }
 
 esp_err_t espsol_rpc_get_health(espsol_rpc_handle_t handle, bool *is_healthy)
@@ -575,35 +988,18 @@ esp_err_t espsol_rpc_get_health(espsol_rpc_handle_t handle, bool *is_healthy)
     if (!handle || !is_healthy) {
         return ESP_ERR_INVALID_ARG;
     }
-    
-#if defined(ESP_PLATFORM) && ESP_PLATFORM
-    struct espsol_rpc_client *client = handle;
-    
-    char *request = build_jsonrpc_request(client, "getHealth", NULL);
-    if (!request) {
-        return ESP_ERR_NO_MEM;
-    }
-    
-    cJSON *result = NULL;
-    esp_err_t err = execute_rpc_request(client, request, &result);
-    free(request);
-    
+
+    espsol_json_t result;
+    esp_err_t err = rpc_request(handle, "getHealth", NULL, &result);
     if (err != ESP_OK) {
         /* Health check returns error if unhealthy */
         *is_healthy = false;
         return ESP_OK;
     }
-    
+
     /* Health returns "ok" string if healthy */
-    *is_healthy = cJSON_IsString(result) && 
-                  strcmp(result->valuestring, "ok") == 0;
-    
-    cJSON_Delete(result);
-    return ESP_OK;
-#else
-    *is_healthy = true;  /* Mock healthy for host testing */
+    *is_healthy = espsol_json_string_equals(&result, "ok");
     return ESP_OK;
-#endif
 }
 
 /* ============================================================================
@@ -614,142 +1010,109 @@ esp_err_t espsol_rpc_get_balance(espsol_rpc_handle_t handle,
                                   const char *pubkey,
                                   uint64_t *lamports)
 {
-    if (!handle || !pubkey || !lamports) {
+    if (!handle || !pubkey || !lamports || !is_json_safe(pubkey)) {
         return ESP_ERR_INVALID_ARG;
     }
-    
-#if defined(ESP_PLATFORM) && ESP_PLATFORM
-    struct espsol_rpc_client *client = handle;
-    
+
     /* Build params: [pubkey, {commitment}] */
-    cJSON *params = cJSON_CreateArray();
-    cJSON_AddItemToArray(params, cJSON_CreateString(pubkey));
-    
-    cJSON *config = cJSON_CreateObject();
-    cJSON_AddStringToObject(config, "commitment", espsol_commitment_to_str(client->commitment));
-    cJSON_AddItemToArray(params, config);
-    
-    char *request = build_jsonrpc_request(client, "getBalance", params);
-    if (!request) {
+    char *params = format_alloc("[\"%s\",{\"commitment\":\"%s\"}]", pubkey,
+                                espsol_commitment_to_str(handle->commitment));
+    if (!params) {
         return ESP_ERR_NO_MEM;
     }
-    
-    cJSON *result = NULL;
-    esp_err_t err = execute_rpc_request(client, request, &result);
-    free(request);
-    
+
+    espsol_json_t result;
+    esp_err_t err = rpc_request(handle, "getBalance", params, &result);
+    free(params);
+
     if (err != ESP_OK) {
         return err;
     }
-    
+
     /* Extract value from result */
-    cJSON *value = cJSON_GetObjectItem(result, "value");
-    if (!value || !cJSON_IsNumber(value)) {
-        cJSON_Delete(result);
+    espsol_json_t value;
+    if (!espsol_json_get(&result, "value", &value) ||
+        !espsol_json_get_u64(&value, lamports)) {
         return ESP_ERR_ESPSOL_RPC_PARSE_ERROR;
     }
-    
-    *lamports = (uint64_t)value->valuedouble;
-    cJSON_Delete(result);
-    return ESP_OK;
-#else
-    (void)pubkey;
-    *lamports = 1000000000;  /* Mock 1 SOL for host testing */
+
     return ESP_OK;
-#endif
 }
 
 esp_err_t espsol_rpc_get_account_info(espsol_rpc_handle_t handle,
                                        const char *pubkey,
                                        espsol_account_info_t *info)
 {
-    if (!handle || !pubkey || !info) {
+    if (!handle || !pubkey || !info || !is_json_safe(pubkey)) {
         return ESP_ERR_INVALID_ARG;
     }
-    
-#if defined(ESP_PLATFORM) && ESP_PLATFORM
-    struct espsol_rpc_client *client = handle;
-    
+
     /* Build params: [pubkey, {encoding, commitment}] */
-    cJSON *params = cJSON_CreateArray();
-    cJSON_AddItemToArray(params, cJSON_CreateString(pubkey));
-    
-    cJSON *config = cJSON_CreateObject();
-    cJSON_AddStringToObject(config, "encoding", "base64");
-    cJSON_AddStringToObject(config, "commitment", espsol_commitment_to_str(client->commitment));
-    cJSON_AddItemToArray(params, config);
-    
-    char *request = build_jsonrpc_request(client, "getAccountInfo", params);
-    if (!request) {
+    char *params = format_alloc("[\"%s\",{\"encoding\":\"base64\",\"commitment\":\"%s\"}]",
+                                pubkey, espsol_commitment_to_str(handle->commitment));
+    if (!params) {
         return ESP_ERR_NO_MEM;
     }
-    
-    cJSON *result = NULL;
-    esp_err_t err = execute_rpc_request(client, request, &result);
-    free(request);
-    
+
+    espsol_json_t result;
+    esp_err_t err = rpc_request(handle, "getAccountInfo", params, &result);
+    free(params);
+
     if (err != ESP_OK) {
         return err;
     }
-    
+
     /* Check for null account (not found) */
-    cJSON *value = cJSON_GetObjectItem(result, "value");
-    if (!value || cJSON_IsNull(value)) {
+    espsol_json_t value;
+    if (!espsol_json_get(&result, "value", &value) || espsol_json_is_null(&value)) {
         /* Account not found - return empty info */
         memset(info, 0, sizeof(espsol_account_info_t));
-        cJSON_Delete(result);
         return ESP_OK;
     }
-    
+
     /* Parse account info */
-    cJSON *lamports_json = cJSON_GetObjectItem(value, "lamports");
-    cJSON *owner_json = cJSON_GetObjectItem(value, "owner");
-    cJSON *executable_json = cJSON_GetObjectItem(value, "executable");
-    cJSON *rent_epoch_json = cJSON_GetObjectItem(value, "rentEpoch");
-    cJSON *data_json = cJSON_GetObjectItem(value, "data");
-    
-    if (lamports_json && cJSON_IsNumber(lamports_json)) {
-        info->lamports = (uint64_t)lamports_json->valuedouble;
-    }
-    
-    if (owner_json && cJSON_IsString(owner_json)) {
-        strncpy(info->owner, owner_json->valuestring, sizeof(info->owner) - 1);
-        info->owner[sizeof(info->owner) - 1] = '\0';
-    }
-    
-    if (executable_json) {
-        info->executable = cJSON_IsTrue(executable_json);
-    }
-    
-    if (rent_epoch_json && cJSON_IsNumber(rent_epoch_json)) {
-        info->rent_epoch = (uint64_t)rent_epoch_json->valuedouble;
-    }
-    
+    espsol_json_t field;
+
+    if (espsol_json_get(&value, "lamports", &field)) {
+        espsol_json_get_u64(&field, &info->lamports);
+    }
+
+    if (espsol_json_get(&value, "owner", &field)) {
+        copy_json_string(&field, info->owner, sizeof(info->owner));
+    }
+
+    if (espsol_json_get(&value, "executable", &field)) {
+        espsol_json_get_bool(&field, &info->executable);
+    }
+
+    if (espsol_json_get(&value, "rentEpoch", &field)) {
+        espsol_json_get_u64(&field, &info->rent_epoch);
+    }
+
     /* Parse data (base64 encoded) */
-    if (data_json && cJSON_IsArray(data_json)) {
-        cJSON *data_str = cJSON_GetArrayItem(data_json, 0);
-        if (data_str && cJSON_IsString(data_str) && info->data && info->data_capacity > 0) {
-            size_t decoded_len = info->data_capacity;
-            err = espsol_base64_decode(data_str->valuestring,
-                                        info->data, &decoded_len);
-            if (err == ESP_OK) {
-                info->data_len = decoded_len;
-            } else if (err == ESP_ERR_ESPSOL_BUFFER_TOO_SMALL) {
-                cJSON_Delete(result);
-                return ESP_ERR_ESPSOL_BUFFER_TOO_SMALL;
-            }
+    espsol_json_t data_json, data_str;
+    if (espsol_json_get(&value, "data", &data_json) &&
+        espsol_json_index(&data_json, 0, &data_str) &&
+        espsol_json_type(&data_str) == ESPSOL_JSON_STRING &&
+        info->data && info->data_capacity > 0) {
+        /* Base64 never contains escapes: terminate and decode in place */
+        char *encoded = handle->response_buffer + (data_str.ptr - handle->response_buffer) + 1;
+        char *encoded_end = encoded + data_str.len - 2;
+        char saved = *encoded_end;
+        *encoded_end = '\0';
+
+        size_t decoded_len = info->data_capacity;
+        err = espsol_base64_decode(encoded, info->data, &decoded_len);
+        *encoded_end = saved;
+
+        if (err == ESP_OK) {
+            info->data_len = decoded_len;
+        } else if (err == ESP_ERR_ESPSOL_BUFFER_TOO_SMALL) {
+            return ESP_ERR_ESPSOL_BUFFER_TOO_SMALL;
         }
     }
-    
-    cJSON_Delete(result);
-    return ESP_OK;
-#else
-    (void)pubkey;
-    memset(info, 0, sizeof(espsol_account_info_t));
-    info->lamports = 1000000000;
-    strncpy(info->owner, "11111111111111111111111111111111", sizeof(info->owner) - 1);
+
     return ESP_OK;
-#endif
 }
 
 /* ============================================================================
@@ -763,69 +1126,46 @@ esp_err_t espsol_rpc_get_latest_blockhash(espsol_rpc_handle_t handle,
     if (!handle || !blockhash) {
         return ESP_ERR_INVALID_ARG;
     }
-    
-#if defined(ESP_PLATFORM) && ESP_PLATFORM
-    struct espsol_rpc_client *client = handle;
-    
+
     /* Build params with commitment */
-    cJSON *params = cJSON_CreateArray();
-    cJSON *config = cJSON_CreateObject();
-    cJSON_AddStringToObject(config, "commitment", espsol_commitment_to_str(client->commitment));
-    cJSON_AddItemToArray(params, config);
-    
-    char *request = build_jsonrpc_request(client, "getLatestBlockhash", params);
-    if (!request) {
-        return ESP_ERR_NO_MEM;
-    }
-    
-    cJSON *result = NULL;
-    esp_err_t err = execute_rpc_request(client, request, &result);
-    free(request);
-    
+    char params[48];
+    snprintf(params, sizeof(params), "[{\"commitment\":\"%s\"}]",
+             espsol_commitment_to_str(handle->commitment));
+
+    espsol_json_t result;
+    esp_err_t err = rpc_request(handle, "getLatestBlockhash", params, &result);
     if (err != ESP_OK) {
         return err;
     }
-    
+
     /* Extract blockhash from result.value */
-    cJSON *value = cJSON_GetObjectItem(result, "value");
-    if (!value || !cJSON_IsObject(value)) {
-        cJSON_Delete(result);
+    espsol_json_t value, blockhash_json;
+    if (!espsol_json_get(&result, "value", &value) ||
+        !espsol_json_get(&value, "blockhash", &blockhash_json)) {
         return ESP_ERR_ESPSOL_RPC_PARSE_ERROR;
     }
-    
-    cJSON *blockhash_json = cJSON_GetObjectItem(value, "blockhash");
-    if (!blockhash_json || !cJSON_IsString(blockhash_json)) {
-        cJSON_Delete(result);
+
+    char blockhash_str[ESPSOL_ADDRESS_MAX_LEN];
+    if (espsol_json_get_string(&blockhash_json, blockhash_str, sizeof(blockhash_str)) != ESP_OK) {
         return ESP_ERR_ESPSOL_RPC_PARSE_ERROR;
     }
-    
+
     /* Decode base58 blockhash */
     size_t decoded_len = ESPSOL_BLOCKHASH_SIZE;
-    err = espsol_base58_decode(blockhash_json->valuestring,
-                               blockhash, &decoded_len);
+    err = espsol_base58_decode(blockhash_str, blockhash, &decoded_len);
     if (err != ESP_OK || decoded_len != ESPSOL_BLOCKHASH_SIZE) {
-        cJSON_Delete(result);
         return ESP_ERR_ESPSOL_RPC_PARSE_ERROR;
     }
-    
+
     /* Extract last valid block height if requested */
     if (last_valid_block_height) {
-        cJSON *height_json = cJSON_GetObjectItem(value, "lastValidBlockHeight");
-        if (height_json && cJSON_IsNumber(height_json)) {
-            *last_valid_block_height = (uint64_t)height_json->valuedouble;
+        espsol_json_t height_json;
+        if (espsol_json_get(&value, "lastValidBlockHeight", &height_json)) {
+            espsol_json_get_u64(&height_json, last_valid_block_height);
         }
     }
-    
-    cJSON_Delete(result);
-    return ESP_OK;
-#else
-    /* Mock blockhash for host testing */
-    memset(blockhash, 0xAB, ESPSOL_BLOCKHASH_SIZE);
-    if (last_valid_block_height) {
-        *last_valid_block_height = 100000150;
-    }
+
     return ESP_OK;
-#endif
 }
 
 esp_err_t espsol_rpc_get_latest_blockhash_str(espsol_rpc_handle_t handle,
@@ -835,19 +1175,19 @@ esp_err_t espsol_rpc_get_latest_blockhash_str(espsol_rpc_handle_t handle,
     if (!handle || !blockhash || len == 0) {
         return ESP_ERR_INVALID_ARG;
     }
-    
+
     uint8_t hash_bytes[ESPSOL_BLOCKHASH_SIZE];
     esp_err_t err = espsol_rpc_get_latest_blockhash(handle, hash_bytes, last_valid_block_height);
     if (err != ESP_OK) {
         return err;
     }
-    
+
     /* Encode to base58 */
     err = espsol_base58_encode(hash_bytes, ESPSOL_BLOCKHASH_SIZE, blockhash, len);
     if (err != ESP_OK) {
         return err;
     }
-    
+
     return ESP_OK;
 }
 
@@ -859,139 +1199,158 @@ esp_err_t espsol_rpc_send_transaction(espsol_rpc_handle_t handle,
                                        const char *tx_base64,
                                        char *signature, size_t sig_len)
 {
-    if (!handle || !tx_base64 || !signature || sig_len == 0) {
+    if (!handle || !tx_base64 || !signature || sig_len == 0 || !is_json_safe(tx_base64)) {
         return ESP_ERR_INVALID_ARG;
     }
-    
-#if defined(ESP_PLATFORM) && ESP_PLATFORM
-    struct espsol_rpc_client *client = handle;
-    
+
     /* Build params: [tx_base64, {encoding, preflightCommitment}] */
-    cJSON *params = cJSON_CreateArray();
-    cJSON_AddItemToArray(params, cJSON_CreateString(tx_base64));
-    
-    cJSON *config = cJSON_CreateObject();
-    cJSON_AddStringToObject(config, "encoding", "base64");
-    cJSON_AddStringToObject(config, "preflightCommitment", 
-                            espsol_commitment_to_str(client->commitment));
-    cJSON_AddItemToArray(params, config);
-    
-    char *request = build_jsonrpc_request(client, "sendTransaction", params);
-    if (!request) {
+    char *params = format_alloc("[\"%s\",{\"encoding\":\"base64\",\"preflightCommitment\":\"%s\"}]",
+                                tx_base64, espsol_commitment_to_str(handle->commitment));
+    if (!params) {
         return ESP_ERR_NO_MEM;
     }
-    
-    cJSON *result = NULL;
-    esp_err_t err = execute_rpc_request(client, request, &result);
-    free(request);
-    
+
+    espsol_json_t result;
+    esp_err_t err = rpc_request(handle, "sendTransaction", params, &result);
+    free(params);
+
     if (err != ESP_OK) {
         return err;
     }
-    
+
     /* Result is the transaction signature (base58) */
-    if (!cJSON_IsString(result)) {
-        cJSON_Delete(result);
-        return ESP_ERR_ESPSOL_RPC_PARSE_ERROR;
+    return copy_json_string(&result, signature, sig_len);
+}
+
+esp_err_t espsol_rpc_send_tx(espsol_rpc_handle_t handle, espsol_tx_handle_t tx,
+                             char *signature, size_t sig_len)
+{
+    if (!handle || !tx || !signature || sig_len == 0) {
+        return ESP_ERR_INVALID_ARG;
     }
-    
-    size_t result_len = strlen(result->valuestring);
-    if (result_len >= sig_len) {
-        cJSON_Delete(result);
-        return ESP_ERR_ESPSOL_BUFFER_TOO_SMALL;
+
+    if (!espsol_tx_is_signed(tx)) {
+        return ESP_ERR_ESPSOL_TX_NOT_SIGNED;
     }
-    
-    strncpy(signature, result->valuestring, sig_len - 1);
-    signature[sig_len - 1] = '\0';
-    
-    cJSON_Delete(result);
-    return ESP_OK;
-#else
-    (void)tx_base64;
-    strncpy(signature, "5VERv8NMvzbJMEkV8xnrLkEaWRtSz9CosKDYjCJjBRnbJLgp8uirBgmQpjKhoR4tjF3ZpRzrFmBV6UjKdiSZkQUW", 
-            sig_len - 1);
-    signature[sig_len - 1] = '\0';
-    return ESP_OK;
-#endif
+
+    size_t tx_len = 0;
+    esp_err_t err = espsol_tx_get_size(tx, &tx_len);
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    struct espsol_rpc_client *client = handle;
+    espsol_deadline_t deadline;
+    espsol_deadline_start(&deadline, &client->call_options);
+
+    /* Same body as sendTransaction with a Base64 string, encoded in place */
+    char head[96];
+    char tail[96];
+    int head_len = snprintf(head, sizeof(head),
+                            "{\"jsonrpc\":\"2.0\",\"id\":%lu,\"method\":\"sendTransaction\","
+                            "\"params\":[\"", (unsigned long)++client->request_id);
+    int tail_len = snprintf(tail, sizeof(tail),
+                            "\",{\"encoding\":\"base64\",\"preflightCommitment\":\"%s\"}]}",
+                            espsol_commitment_to_str(client->commitment));
+    size_t body_len = (size_t)head_len + espsol_base64_encoded_len(tx_len) - 1 + (size_t)tail_len;
+
+    char *request = malloc(body_len + 1);
+    if (!request) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    espsol_buffer_writer_t sink;
+    espsol_writer_t body;
+    espsol_buffer_writer_init(&sink, (uint8_t *)request, body_len, &body);
+
+    espsol_base64_writer_t enc;
+    espsol_writer_t writer;
+    espsol_base64_writer_init(&enc, &body, &writer);
+
+    err = body.write(body.ctx, (const uint8_t *)head, (size_t)head_len);
+    if (err == ESP_OK) {
+        err = espsol_tx_write(tx, &writer);
+    }
+    if (err == ESP_OK) {
+        err = espsol_base64_writer_finish(&enc);
+    }
+    if (err == ESP_OK) {
+        err = body.write(body.ctx, (const uint8_t *)tail, (size_t)tail_len);
+    }
+    if (err != ESP_OK) {
+        free(request);
+        return err;
+    }
+    request[sink.len] = '\0';
+
+    espsol_json_t result;
+    err = execute_rpc_request(client, request, &deadline, &result, NULL);
+    free(request);
+
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    return copy_json_string(&result, signature, sig_len);
 }
 
 esp_err_t espsol_rpc_get_transaction(espsol_rpc_handle_t handle,
                                       const char *signature,
                                       espsol_tx_response_t *response)
 {
-    if (!handle || !signature || !response) {
+    if (!handle || !signature || !response || !is_json_safe(signature)) {
         return ESP_ERR_INVALID_ARG;
     }
-    
-#if defined(ESP_PLATFORM) && ESP_PLATFORM
-    struct espsol_rpc_client *client = handle;
-    
+
     /* Build params: [signature, {encoding, commitment}] */
-    cJSON *params = cJSON_CreateArray();
-    cJSON_AddItemToArray(params, cJSON_CreateString(signature));
-    
-    cJSON *config = cJSON_CreateObject();
-    cJSON_AddStringToObject(config, "encoding", "json");
-    cJSON_AddStringToObject(config, "commitment", espsol_commitment_to_str(client->commitment));
-    cJSON_AddNumberToObject(config, "maxSupportedTransactionVersion", 0);
-    cJSON_AddItemToArray(params, config);
-    
-    char *request = build_jsonrpc_request(client, "getTransaction", params);
-    if (!request) {
+    char *params = format_alloc("[\"%s\",{\"encoding\":\"json\",\"commitment\":\"%s\","
+                                "\"maxSupportedTransactionVersion\":0}]",
+                                signature, espsol_commitment_to_str(handle->commitment));
+    if (!params) {
         return ESP_ERR_NO_MEM;
     }
-    
-    cJSON *result = NULL;
-    esp_err_t err = execute_rpc_request(client, request, &result);
-    free(request);
-    
+
+    espsol_json_t result;
+    esp_err_t err = rpc_request(handle, "getTransaction", params, &result);
+    free(params);
+
     if (err != ESP_OK) {
         return err;
     }
-    
+
     /* Initialize response */
     memset(response, 0, sizeof(espsol_tx_response_t));
     strncpy(response->signature, signature, sizeof(response->signature) - 1);
-    
-    if (cJSON_IsNull(result)) {
+
+    if (espsol_json_is_null(&result)) {
         /* Transaction not found */
         response->confirmed = false;
-        cJSON_Delete(result);
         return ESP_OK;
     }
-    
+
     /* Parse transaction info */
-    cJSON *slot_json = cJSON_GetObjectItem(result, "slot");
-    if (slot_json && cJSON_IsNumber(slot_json)) {
-        response->slot = (uint64_t)slot_json->valuedouble;
+    espsol_json_t slot_json;
+    if (espsol_json_get(&result, "slot", &slot_json)) {
+        espsol_json_get_u64(&slot_json, &response->slot);
     }
-    
+
     /* Check for transaction error */
-    cJSON *meta = cJSON_GetObjectItem(result, "meta");
-    if (meta && cJSON_IsObject(meta)) {
-        cJSON *meta_err = cJSON_GetObjectItem(meta, "err");
-        if (meta_err && !cJSON_IsNull(meta_err)) {
-            char *err_str = cJSON_PrintUnformatted(meta_err);
-            if (err_str) {
-                strncpy(response->error, err_str, sizeof(response->error) - 1);
-                response->error[sizeof(response->error) - 1] = '\0';
-                free(err_str);
-            }
+    espsol_json_t meta, meta_err;
+    if (espsol_json_get(&result, "meta", &meta) &&
+        espsol_json_type(&meta) == ESPSOL_JSON_OBJECT) {
+        if (espsol_json_get(&meta, "err", &meta_err) && !espsol_json_is_null(&meta_err)) {
+            /* Keep the raw error JSON */
+            size_t n = meta_err.len < sizeof(response->error) - 1 ?
+                       meta_err.len : sizeof(response->error) - 1;
+            memcpy(response->error, meta_err.ptr, n);
+            response->error[n] = '\0';
             response->confirmed = false;
         } else {
             response->confirmed = true;
         }
     }
-    
-    cJSON_Delete(result);
-    return ESP_OK;
-#else
-    memset(response, 0, sizeof(espsol_tx_response_t));
-    strncpy(response->signature, signature, sizeof(response->signature) - 1);
-    response->slot = 123456789;
-    response->confirmed = true;
+
     return ESP_OK;
-#endif
 }
 
 esp_err_t espsol_rpc_confirm_transaction(espsol_rpc_handle_t handle,
@@ -1002,42 +1361,43 @@ esp_err_t espsol_rpc_confirm_transaction(espsol_rpc_handle_t handle,
     if (!handle || !signature || !confirmed) {
         return ESP_ERR_INVALID_ARG;
     }
-    
-#if defined(ESP_PLATFORM) && ESP_PLATFORM
+
     uint32_t elapsed = 0;
     const uint32_t poll_interval = 500;  /* Poll every 500ms */
-    
+
+    /* The call options bound the whole confirmation wait */
+    espsol_deadline_t deadline;
+    espsol_deadline_start(&deadline, &handle->call_options);
+
     while (elapsed < timeout_ms) {
         espsol_tx_response_t response;
         esp_err_t err = espsol_rpc_get_transaction(handle, signature, &response);
-        
+
         if (err != ESP_OK) {
             return err;
         }
-        
+
         if (response.confirmed) {
             *confirmed = true;
             return ESP_OK;
         }
-        
+
         if (response.error[0] != '\0') {
             /* Transaction failed */
             *confirmed = false;
             return ESP_OK;
         }
-        
-        vTaskDelay(pdMS_TO_TICKS(poll_interval));
-        elapsed += poll_interval;
-    }
-    
-    *confirmed = false;
+
+        err = espsol_deadline_sleep(&deadline, poll_interval);
+        if (err != ESP_OK) {
+            *confirmed = false;
+            return err;
+        }
+        elapsed += poll_interval;
+    }
+
+    *confirmed = false;
     return ESP_ERR_ESPSOL_TIMEOUT;
-#else
-    (void)signature;
-    (void)timeout_ms;
-    *confirmed = true;
-    return ESP_OK;
-#endif
 }
 
 esp_err_t espsol_rpc_get_signature_statuses(espsol_rpc_handle_t handle,
@@ -1048,65 +1408,464 @@ esp_err_t espsol_rpc_get_signature_statuses(espsol_rpc_handle_t handle,
     if (!handle || !signatures || count == 0 || !confirmed) {
         return ESP_ERR_INVALID_ARG;
     }
-    
-#if defined(ESP_PLATFORM) && ESP_PLATFORM
-    struct espsol_rpc_client *client = handle;
-    
+
     /* Build params: [[signatures], {searchTransactionHistory}] */
-    cJSON *params = cJSON_CreateArray();
-    
-    cJSON *sig_array = cJSON_CreateArray();
+    const char *config = "],{\"searchTransactionHistory\":true}]";
+    size_t params_len = 2 + strlen(config) + 1;
     for (size_t i = 0; i < count; i++) {
-        cJSON_AddItemToArray(sig_array, cJSON_CreateString(signatures[i]));
-    }
-    cJSON_AddItemToArray(params, sig_array);
-    
-    cJSON *config = cJSON_CreateObject();
-    cJSON_AddBoolToObject(config, "searchTransactionHistory", true);
-    cJSON_AddItemToArray(params, config);
-    
-    char *request = build_jsonrpc_request(client, "getSignatureStatuses", params);
-    if (!request) {
+        if (!signatures[i] || !is_json_safe(signatures[i])) {
+            return ESP_ERR_INVALID_ARG;
+        }
+        params_len += strlen(signatures[i]) + 3;
+    }
+
+    char *params = malloc(params_len);
+    if (!params) {
         return ESP_ERR_NO_MEM;
     }
-    
-    cJSON *result = NULL;
-    esp_err_t err = execute_rpc_request(client, request, &result);
-    free(request);
-    
+
+    size_t offset = 0;
+    params[offset++] = '[';
+    params[offset++] = '[';
+    for (size_t i = 0; i < count; i++) {
+        offset += snprintf(params + offset, params_len - offset, "%s\"%s\"",
+                           i > 0 ? "," : "", signatures[i]);
+    }
+    snprintf(params + offset, params_len - offset, "%s", config);
+
+    espsol_json_t result;
+    esp_err_t err = rpc_request(handle, "getSignatureStatuses", params, &result);
+    free(params);
+
     if (err != ESP_OK) {
         return err;
     }
-    
+
     /* Parse value array */
-    cJSON *value = cJSON_GetObjectItem(result, "value");
-    if (!value || !cJSON_IsArray(value)) {
-        cJSON_Delete(result);
+    espsol_json_t value;
+    if (!espsol_json_get(&result, "value", &value) ||
+        espsol_json_type(&value) != ESPSOL_JSON_ARRAY) {
         return ESP_ERR_ESPSOL_RPC_PARSE_ERROR;
     }
-    
-    size_t array_size = cJSON_GetArraySize(value);
-    for (size_t i = 0; i < count && i < array_size; i++) {
-        cJSON *status = cJSON_GetArrayItem(value, i);
-        if (cJSON_IsNull(status)) {
-            confirmed[i] = false;
-        } else if (cJSON_IsObject(status)) {
-            cJSON *status_err = cJSON_GetObjectItem(status, "err");
-            confirmed[i] = (status_err == NULL || cJSON_IsNull(status_err));
+
+    size_t cursor = 0;
+    espsol_json_t status;
+    for (size_t i = 0; i < count && espsol_json_array_next(&value, &cursor, &status); i++) {
+        if (espsol_json_type(&status) == ESPSOL_JSON_OBJECT) {
+            espsol_json_t status_err;
+            confirmed[i] = !espsol_json_get(&status, "err", &status_err) ||
+                           espsol_json_is_null(&status_err);
         } else {
             confirmed[i] = false;
         }
     }
-    
-    cJSON_Delete(result);
+
     return ESP_OK;
-#else
-    for (size_t i = 0; i < count; i++) {
-        (void)signatures[i];
-        confirmed[i] = true;
+}
+
+/* ============================================================================
+ * Address History
+ * ========================================================================== */
+
+/**
+ * @brief One history entry, decoded as it streamed in
+ */
+typedef struct {
+    char signature[ESPSOL_SIGNATURE_MAX_LEN];   /**< Transaction signature (Base58) */
+    uint64_t slot;                              /**< Slot the transaction was processed */
+    int64_t block_time;                         /**< Unix timestamp of the block */
+    bool has_block_time;                        /**< block_time is known */
+    uint16_t error_len;                         /**< Length of the error JSON (0 = succeeded) */
+    size_t error_at;                            /**< Offset of the error JSON in the page */
+} history_entry_t;
+
+/**
+ * @brief One fetched page of getSignaturesForAddress results
+ */
+typedef struct {
+    history_entry_t *entries;   /**< Decoded entries (page_size slots) */
+    size_t count;               /**< Entries in the page */
+    size_t cursor;              /**< Next entry to return */
+    char *errors;               /**< Error JSON of failed transactions */
+    size_t errors_len;          /**< Bytes used in errors */
+    size_t errors_cap;          /**< Allocated size of errors */
+    bool loaded;                /**< entries is valid */
+    esp_err_t err;              /**< Outcome of the last fetch */
+} history_page_t;
+
+/**
+ * @brief State of a streamed getSignaturesForAddress response
+ */
+typedef struct {
+    espsol_json_stream_t json;                      /**< Streaming reader */
+    history_page_t *page;                           /**< Page being filled */
+    size_t capacity;                                /**< Entries requested */
+    history_entry_t entry;                          /**< Entry being read */
+    bool has_signature;                             /**< entry.signature was read */
+    bool has_slot;                                  /**< entry.slot was read */
+    bool is_array;                                  /**< Result is an array */
+    char signature[ESPSOL_SIGNATURE_MAX_LEN + 2];   /**< Captured signature string */
+    char scalar[32];                                /**< Captured number or literal */
+    char error[128];                                /**< Captured error JSON (may be truncated) */
+    char rpc_error[256];                            /**< JSON-RPC error object */
+    bool has_rpc_error;                             /**< rpc_error was captured */
+    esp_err_t err;                                  /**< Why the stream was stopped */
+} history_parser_t;
+
+struct espsol_history_iter {
+    struct espsol_rpc_client *client;           /**< Client used for requests */
+    char *address;                              /**< Address being walked */
+    char before[ESPSOL_SIGNATURE_MAX_LEN];      /**< Cursor for the next request */
+    char until[ESPSOL_SIGNATURE_MAX_LEN];       /**< Lower bound (empty = none) */
+    uint16_t page_size;                         /**< Signatures per request */
+    uint32_t remaining;                         /**< Signatures left to request */
+    bool exhausted;                             /**< No more pages to request */
+    history_page_t pages[2];                    /**< Current and next page */
+    history_page_t *current;                    /**< Page being returned */
+    history_page_t *next;                       /**< Page being fetched (current when inline) */
+    history_parser_t parser;                    /**< Parser of the page being fetched */
+    espsol_worker_t worker;                     /**< Prefetch task (NULL = inline) */
+    bool fetching;                              /**< Prefetch outstanding */
+};
+
+/**
+ * @brief Append the entry just read to the page
+ */
+static esp_err_t history_add_entry(history_parser_t *parser)
+{
+    history_page_t *page = parser->page;
+
+    if (!parser->has_signature || !parser->has_slot || page->count == parser->capacity) {
+        return ESP_ERR_ESPSOL_RPC_PARSE_ERROR;
     }
+
+    history_entry_t *entry = &page->entries[page->count];
+    *entry = parser->entry;
+    entry->error_at = page->errors_len;
+    if (entry->error_len > 0) {
+        if (page->errors_len + entry->error_len > page->errors_cap) {
+            size_t cap = page->errors_cap ? page->errors_cap * 2 : sizeof(parser->error);
+            char *errors = realloc(page->errors, cap);
+            if (!errors) {
+                return ESP_ERR_NO_MEM;
+            }
+            page->errors = errors;
+            page->errors_cap = cap;
+        }
+        memcpy(page->errors + page->errors_len, parser->error, entry->error_len);
+        page->errors_len += entry->error_len;
+    }
+    page->count++;
+    return ESP_OK;
+}
+
+static char *history_on_begin(void *ctx, const espsol_json_stream_t *json,
+                              char first, size_t *cap)
+{
+    history_parser_t *parser = ctx;
+
+    if (espsol_json_stream_at(json, "result")) {
+        parser->is_array = first == '[';
+        return NULL;
+    }
+    if (espsol_json_stream_at(json, "result.#")) {
+        memset(&parser->entry, 0, sizeof(parser->entry));
+        parser->has_signature = false;
+        parser->has_slot = false;
+        return NULL;
+    }
+    if (espsol_json_stream_at(json, "result.#.signature")) {
+        *cap = sizeof(parser->signature) - 1;
+        return parser->signature;
+    }
+    if (espsol_json_stream_at(json, "result.#.slot") ||
+        espsol_json_stream_at(json, "result.#.blockTime")) {
+        *cap = sizeof(parser->scalar) - 1;
+        return parser->scalar;
+    }
+    if (espsol_json_stream_at(json, "result.#.err")) {
+        *cap = sizeof(parser->error) - 1;
+        return parser->error;
+    }
+    if (espsol_json_stream_at(json, "error")) {
+        *cap = sizeof(parser->rpc_error) - 1;
+        return parser->rpc_error;
+    }
+    return NULL;
+}
+
+static bool history_on_end(void *ctx, const espsol_json_stream_t *json,
+                           const char *text, size_t len, bool truncated)
+{
+    history_parser_t *parser = ctx;
+    espsol_json_t value = { .ptr = text, .len = len };
+
+    if (!text) {
+        if (espsol_json_stream_at(json, "result.#")) {
+            parser->err = history_add_entry(parser);
+            return parser->err == ESP_OK;
+        }
+        return true;
+    }
+
+    if (text == parser->rpc_error) {
+        parser->rpc_error[len] = '\0';
+        parser->has_rpc_error = true;
+    } else if (text == parser->error) {
+        /* A long error is kept truncated, as in espsol_signature_info_t */
+        parser->entry.error_len = truncated || !espsol_json_is_null(&value) ? (uint16_t)len : 0;
+    } else if (truncated) {
+        parser->err = ESP_ERR_ESPSOL_RPC_PARSE_ERROR;
+        return false;
+    } else if (text == parser->signature) {
+        parser->has_signature = copy_json_string(&value, parser->entry.signature,
+                                                 sizeof(parser->entry.signature)) == ESP_OK;
+    } else if (espsol_json_stream_at(json, "result.#.slot")) {
+        parser->has_slot = espsol_json_get_u64(&value, &parser->entry.slot);
+    } else {
+        parser->entry.has_block_time = espsol_json_get_i64(&value, &parser->entry.block_time);
+    }
+    return true;
+}
+
+static esp_err_t history_sink(void *sink_ctx, int status_code, const char *data, size_t len)
+{
+    history_parser_t *parser = sink_ctx;
+    (void)status_code;
+
+    if (!espsol_json_stream_feed(&parser->json, data, len)) {
+        return parser->err != ESP_OK ? parser->err : ESP_ERR_ESPSOL_RPC_PARSE_ERROR;
+    }
+    return ESP_OK;
+}
+
+/**
+ * @brief Fetch the page after iter->before into iter->next
+ *
+ * Entries are decoded straight off the wire; only the entry being read
+ * is held as text. Advances the cursor only on success, so a failed page
+ * can be retried.
+ */
+static void history_fetch(void *arg)
+{
+    struct espsol_history_iter *iter = arg;
+    struct espsol_rpc_client *client = iter->client;
+    history_page_t *page = iter->next;
+    history_parser_t *parser = &iter->parser;
+    uint32_t limit = iter->remaining < iter->page_size ? iter->remaining : iter->page_size;
+
+    /* getSignaturesForAddress rejects commitment below confirmed */
+    espsol_commitment_t commitment = client->commitment == ESPSOL_COMMITMENT_PROCESSED ?
+                                     ESPSOL_COMMITMENT_CONFIRMED : client->commitment;
+
+    char params[96 + ESPSOL_ADDRESS_MAX_LEN + 2 * ESPSOL_SIGNATURE_MAX_LEN];
+    int len = snprintf(params, sizeof(params),
+                       "[\"%s\",{\"limit\":%lu,\"commitment\":\"%s\"",
+                       iter->address, (unsigned long)limit,
+                       espsol_commitment_to_str(commitment));
+    if (iter->before[0]) {
+        len += snprintf(params + len, sizeof(params) - len, ",\"before\":\"%s\"", iter->before);
+    }
+    if (iter->until[0]) {
+        len += snprintf(params + len, sizeof(params) - len, ",\"until\":\"%s\"", iter->until);
+    }
+    snprintf(params + len, sizeof(params) - len, "}]");
+
+    page->loaded = false;
+    page->count = 0;
+    page->cursor = 0;
+    page->errors_len = 0;
+    if (!page->entries) {
+        page->entries = malloc(iter->page_size * sizeof(history_entry_t));
+        if (!page->entries) {
+            page->err = ESP_ERR_NO_MEM;
+            return;
+        }
+    }
+
+    memset(parser, 0, sizeof(*parser));
+    parser->page = page;
+    parser->capacity = limit;
+    espsol_json_stream_init(&parser->json, history_on_begin, history_on_end, parser);
+
+    page->err = espsol_rpc_stream_request(client, "getSignaturesForAddress", params,
+                                          history_sink, parser);
+    if (page->err == ESP_OK && !espsol_json_stream_done(&parser->json)) {
+        page->err = ESP_ERR_ESPSOL_RPC_PARSE_ERROR;
+    }
+    if (page->err == ESP_OK && parser->has_rpc_error) {
+        espsol_json_t error = { .ptr = parser->rpc_error, .len = strlen(parser->rpc_error) };
+        page->err = espsol_rpc_report_error(client, &error);
+        return;
+    }
+    if (page->err == ESP_OK && !parser->is_array) {
+        page->err = ESP_ERR_ESPSOL_RPC_PARSE_ERROR;
+    }
+    if (page->err == ESP_ERR_ESPSOL_RPC_PARSE_ERROR) {
+        snprintf(client->last_error, sizeof(client->last_error),
+                 "Malformed getSignaturesForAddress response");
+    }
+    if (page->err != ESP_OK) {
+        return;
+    }
+    page->loaded = true;
+
+    /* Move the cursor to the oldest signature of this page */
+    if (page->count > 0) {
+        strcpy(iter->before, page->entries[page->count - 1].signature);
+    }
+    iter->remaining -= page->count;
+    if (page->count < limit || iter->remaining == 0) {
+        iter->exhausted = true;
+    }
+}
+
+/**
+ * @brief Start fetching the next page (in the background when prefetching)
+ */
+static void history_start_fetch(struct espsol_history_iter *iter)
+{
+    if (iter->worker) {
+        espsol_worker_submit(iter->worker, history_fetch, iter);
+        iter->fetching = true;
+    } else {
+        history_fetch(iter);
+    }
+}
+
+/**
+ * @brief Fill info from a decoded entry
+ */
+static void history_decode(const history_page_t *page, const history_entry_t *entry,
+                           espsol_signature_info_t *info)
+{
+    memset(info, 0, sizeof(*info));
+
+    strcpy(info->signature, entry->signature);
+    info->slot = entry->slot;
+    info->failed = entry->error_len > 0;
+    memcpy(info->error, page->errors + entry->error_at, entry->error_len);
+    info->has_block_time = entry->has_block_time;
+    info->block_time = entry->block_time;
+}
+
+esp_err_t espsol_rpc_history_open(espsol_rpc_handle_t handle,
+                                  const char *address,
+                                  const espsol_history_config_t *config,
+                                  espsol_history_iter_t *iter)
+{
+    espsol_history_config_t defaults = ESPSOL_HISTORY_CONFIG_DEFAULT();
+    if (!config) {
+        config = &defaults;
+    }
+
+    if (!handle || !address || !iter ||
+        config->page_size == 0 || config->page_size > 1000 ||
+        strlen(address) >= ESPSOL_ADDRESS_MAX_LEN || !is_json_safe(address)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if ((config->before && (strlen(config->before) >= ESPSOL_SIGNATURE_MAX_LEN ||
+                            !is_json_safe(config->before))) ||
+        (config->until && (strlen(config->until) >= ESPSOL_SIGNATURE_MAX_LEN ||
+                           !is_json_safe(config->until)))) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    struct espsol_history_iter *it = calloc(1, sizeof(*it));
+    if (!it) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    it->address = strdup(address);
+    if (!it->address) {
+        free(it);
+        return ESP_ERR_NO_MEM;
+    }
+
+    it->client = handle;
+    it->page_size = config->page_size;
+    it->remaining = config->limit > 0 ? config->limit : UINT32_MAX;
+    if (config->before) {
+        strcpy(it->before, config->before);
+    }
+    if (config->until) {
+        strcpy(it->until, config->until);
+    }
+    it->current = &it->pages[0];
+    it->next = config->prefetch ? &it->pages[1] : &it->pages[0];
+
+    if (config->prefetch) {
+        esp_err_t err = espsol_worker_create("espsol_history", ESPSOL_WORKER_STACK_SIZE,
+                                             &it->worker);
+        if (err != ESP_OK) {
+            free(it->address);
+            free(it);
+            return err;
+        }
+        /* First page loads while the caller gets ready */
+        history_start_fetch(it);
+    }
+
+    *iter = it;
+    return ESP_OK;
+}
+
+esp_err_t espsol_rpc_history_next(espsol_history_iter_t iter,
+                                  espsol_signature_info_t *info)
+{
+    if (!iter || !info) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    for (;;) {
+        history_page_t *page = iter->current;
+        if (page->loaded && page->cursor < page->count) {
+            history_decode(page, &page->entries[page->cursor++], info);
+            return ESP_OK;
+        }
+
+        /* Current page used up: take the next one */
+        if (!iter->fetching) {
+            if (iter->exhausted) {
+                return ESP_ERR_NOT_FOUND;
+            }
+            history_start_fetch(iter);
+        }
+        if (iter->fetching) {
+            espsol_worker_wait(iter->worker);
+            iter->fetching = false;
+        }
+
+        if (iter->next->err != ESP_OK) {
+            return iter->next->err;
+        }
+
+        /* The fetched page becomes current; the used one takes the next fetch */
+        if (iter->worker) {
+            iter->current = iter->next;
+            iter->next = page;
+            if (!iter->exhausted) {
+                history_start_fetch(iter);
+            }
+        }
+    }
+}
+
+esp_err_t espsol_rpc_history_close(espsol_history_iter_t iter)
+{
+    if (!iter) {
+        return ESP_OK;
+    }
+
+    espsol_worker_destroy(iter->worker);
+
+    for (size_t i = 0; i < 2; i++) {
+        free(iter->pages[i].entries);
+        free(iter->pages[i].errors);
+    }
+    free(iter->address);
+    free(iter);
     return ESP_OK;
-#endif
 }
 
 /* ============================================================================
@@ -1118,59 +1877,28 @@ esp_err_t espsol_rpc_request_airdrop(espsol_rpc_handle_t handle,
                                       uint64_t lamports,
                                       char *signature, size_t sig_len)
 {
-    if (!handle || !pubkey || !signature || sig_len == 0) {
+    if (!handle || !pubkey || !signature || sig_len == 0 || !is_json_safe(pubkey)) {
         return ESP_ERR_INVALID_ARG;
     }
-    
-#if defined(ESP_PLATFORM) && ESP_PLATFORM
-    struct espsol_rpc_client *client = handle;
-    
+
     /* Build params: [pubkey, lamports, {commitment}] */
-    cJSON *params = cJSON_CreateArray();
-    cJSON_AddItemToArray(params, cJSON_CreateString(pubkey));
-    cJSON_AddItemToArray(params, cJSON_CreateNumber((double)lamports));
-    
-    cJSON *config = cJSON_CreateObject();
-    cJSON_AddStringToObject(config, "commitment", espsol_commitment_to_str(client->commitment));
-    cJSON_AddItemToArray(params, config);
-    
-    char *request = build_jsonrpc_request(client, "requestAirdrop", params);
-    if (!request) {
+    char *params = format_alloc("[\"%s\",%llu,{\"commitment\":\"%s\"}]",
+                                pubkey, (unsigned long long)lamports,
+                                espsol_commitment_to_str(handle->commitment));
+    if (!params) {
         return ESP_ERR_NO_MEM;
     }
-    
-    cJSON *result = NULL;
-    esp_err_t err = execute_rpc_request(client, request, &result);
-    free(request);
-    
+
+    espsol_json_t result;
+    esp_err_t err = rpc_request(handle, "requestAirdrop", params, &result);
+    free(params);
+
     if (err != ESP_OK) {
         return err;
     }
-    
+
     /* Result is the airdrop transaction signature */
-    if (!cJSON_IsString(result)) {
-        cJSON_Delete(result);
-        return ESP_ERR_ESPSOL_RPC_PARSE_ERROR;
-    }
-    
-    size_t result_len = strlen(result->valuestring);
-    if (result_len >= sig_len) {
-        cJSON_Delete(result);
-        return ESP_ERR_ESPSOL_BUFFER_TOO_SMALL;
-    }
-    
-    strncpy(signature, result->valuestring, sig_len - 1);
-    signature[sig_len - 1] = '\0';
-    
-    cJSON_Delete(result);
-    return ESP_OK;
-#else
-    (void)pubkey;
-    (void)lamports;
-    strncpy(signature, "AirdropSignature123456789ABCDEF", sig_len - 1);
-    signature[sig_len - 1] = '\0';
-    return ESP_OK;
-#endif
+    return copy_json_string(&result, signature, sig_len);
 }
 
 /* ============================================================================
@@ -1186,119 +1914,94 @@ esp_err_t espsol_rpc_get_token_accounts_by_owner(espsol_rpc_handle_t handle,
     if (!handle || !owner || !accounts || !count || *count == 0) {
         return ESP_ERR_INVALID_ARG;
     }
-    
-#if defined(ESP_PLATFORM) && ESP_PLATFORM
-    struct espsol_rpc_client *client = handle;
+
+    if (!is_json_safe(owner) || (mint && !is_json_safe(mint))) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
     size_t max_accounts = *count;
     *count = 0;
-    
+
     /* Build params: [owner, {mint/programId}, {encoding}] */
-    cJSON *params = cJSON_CreateArray();
-    cJSON_AddItemToArray(params, cJSON_CreateString(owner));
-    
-    /* Filter by mint or program */
-    cJSON *filter = cJSON_CreateObject();
-    if (mint) {
-        cJSON_AddStringToObject(filter, "mint", mint);
-    } else {
-        /* Token Program ID */
-        cJSON_AddStringToObject(filter, "programId", "TokenkegQfeZyiNwAJbNbGKPFXCWuBvf9Ss623VQ5DA");
-    }
-    cJSON_AddItemToArray(params, filter);
-    
-    cJSON *config = cJSON_CreateObject();
-    cJSON_AddStringToObject(config, "encoding", "jsonParsed");
-    cJSON_AddStringToObject(config, "commitment", espsol_commitment_to_str(client->commitment));
-    cJSON_AddItemToArray(params, config);
-    
-    char *request = build_jsonrpc_request(client, "getTokenAccountsByOwner", params);
-    if (!request) {
+    char *params = format_alloc("[\"%s\",{\"%s\":\"%s\"},"
+                                "{\"encoding\":\"jsonParsed\",\"commitment\":\"%s\"}]",
+                                owner,
+                                mint ? "mint" : "programId",
+                                mint ? mint : "TokenkegQfeZyiNwAJbNbGKPFXCWuBvf9Ss623VQ5DA",
+                                espsol_commitment_to_str(handle->commitment));
+    if (!params) {
         return ESP_ERR_NO_MEM;
     }
-    
-    cJSON *result = NULL;
-    esp_err_t err = execute_rpc_request(client, request, &result);
-    free(request);
-    
+
+    espsol_json_t result;
+    esp_err_t err = rpc_request(handle, "getTokenAccountsByOwner", params, &result);
+    free(params);
+
     if (err != ESP_OK) {
         return err;
     }
-    
+
     /* Parse value array */
-    cJSON *value = cJSON_GetObjectItem(result, "value");
-    if (!value || !cJSON_IsArray(value)) {
-        cJSON_Delete(result);
+    espsol_json_t value;
+    if (!espsol_json_get(&result, "value", &value) ||
+        espsol_json_type(&value) != ESPSOL_JSON_ARRAY) {
         return ESP_ERR_ESPSOL_RPC_PARSE_ERROR;
     }
-    
-    size_t array_size = cJSON_GetArraySize(value);
-    for (size_t i = 0; i < array_size && *count < max_accounts; i++) {
-        cJSON *item = cJSON_GetArrayItem(value, i);
-        if (!item) continue;
-        
-        cJSON *pubkey_json = cJSON_GetObjectItem(item, "pubkey");
-        cJSON *account = cJSON_GetObjectItem(item, "account");
-        if (!pubkey_json || !account) continue;
-        
-        cJSON *data = cJSON_GetObjectItem(account, "data");
-        if (!data) continue;
-        
-        cJSON *parsed = cJSON_GetObjectItem(data, "parsed");
-        if (!parsed) continue;
-        
-        cJSON *info = cJSON_GetObjectItem(parsed, "info");
-        if (!info) continue;
-        
+
+    size_t array_size = 0;
+    size_t cursor = 0;
+    espsol_json_t item;
+    while (espsol_json_array_next(&value, &cursor, &item)) {
+        array_size++;
+        if (*count >= max_accounts) {
+            continue;
+        }
+
+        espsol_json_t pubkey_json, account, data, parsed, info;
+        if (!espsol_json_get(&item, "pubkey", &pubkey_json) ||
+            !espsol_json_get(&item, "account", &account) ||
+            !espsol_json_get(&account, "data", &data) ||
+            !espsol_json_get(&data, "parsed", &parsed) ||
+            !espsol_json_get(&parsed, "info", &info)) {
+            continue;
+        }
+
         espsol_token_account_t *ta = &accounts[*count];
         memset(ta, 0, sizeof(espsol_token_account_t));
-        
+
         /* Token account address */
-        if (cJSON_IsString(pubkey_json)) {
-            strncpy(ta->address, pubkey_json->valuestring, sizeof(ta->address) - 1);
-        }
-        
-        /* Mint */
-        cJSON *mint_json = cJSON_GetObjectItem(info, "mint");
-        if (mint_json && cJSON_IsString(mint_json)) {
-            strncpy(ta->mint, mint_json->valuestring, sizeof(ta->mint) - 1);
+        copy_json_string(&pubkey_json, ta->address, sizeof(ta->address));
+
+        /* Mint and owner */
+        espsol_json_t field;
+        if (espsol_json_get(&info, "mint", &field)) {
+            copy_json_string(&field, ta->mint, sizeof(ta->mint));
         }
-        
-        /* Owner */
-        cJSON *owner_json = cJSON_GetObjectItem(info, "owner");
-        if (owner_json && cJSON_IsString(owner_json)) {
-            strncpy(ta->owner, owner_json->valuestring, sizeof(ta->owner) - 1);
+        if (espsol_json_get(&info, "owner", &field)) {
+            copy_json_string(&field, ta->owner, sizeof(ta->owner));
         }
-        
+
         /* Token amount */
-        cJSON *token_amount = cJSON_GetObjectItem(info, "tokenAmount");
-        if (token_amount) {
-            cJSON *amount_json = cJSON_GetObjectItem(token_amount, "amount");
-            cJSON *decimals_json = cJSON_GetObjectItem(token_amount, "decimals");
-            
-            if (amount_json && cJSON_IsString(amount_json)) {
-                ta->amount = strtoull(amount_json->valuestring, NULL, 10);
+        espsol_json_t token_amount;
+        if (espsol_json_get(&info, "tokenAmount", &token_amount)) {
+            uint64_t decimals;
+            if (espsol_json_get(&token_amount, "amount", &field)) {
+                json_get_u64_string(&field, &ta->amount);
             }
-            if (decimals_json && cJSON_IsNumber(decimals_json)) {
-                ta->decimals = (uint8_t)decimals_json->valueint;
+            if (espsol_json_get(&token_amount, "decimals", &field) &&
+                espsol_json_get_u64(&field, &decimals)) {
+                ta->decimals = (uint8_t)decimals;
             }
         }
-        
+
         (*count)++;
     }
-    
-    cJSON_Delete(result);
-    
+
     if (array_size > max_accounts) {
         return ESP_ERR_ESPSOL_BUFFER_TOO_SMALL;
     }
-    
-    return ESP_OK;
-#else
-    (void)owner;
-    (void)mint;
-    *count = 0;
+
     return ESP_OK;
-#endif
 }
 
 esp_err_t espsol_rpc_get_token_balance(espsol_rpc_handle_t handle,
@@ -1306,63 +2009,44 @@ esp_err_t espsol_rpc_get_token_balance(espsol_rpc_handle_t handle,
                                         uint64_t *amount,
                                         uint8_t *decimals)
 {
-    if (!handle || !token_account || !amount) {
+    if (!handle || !token_account || !amount || !is_json_safe(token_account)) {
         return ESP_ERR_INVALID_ARG;
     }
-    
-#if defined(ESP_PLATFORM) && ESP_PLATFORM
-    struct espsol_rpc_client *client = handle;
-    
+
     /* Build params: [token_account, {commitment}] */
-    cJSON *params = cJSON_CreateArray();
-    cJSON_AddItemToArray(params, cJSON_CreateString(token_account));
-    
-    cJSON *config = cJSON_CreateObject();
-    cJSON_AddStringToObject(config, "commitment", espsol_commitment_to_str(client->commitment));
-    cJSON_AddItemToArray(params, config);
-    
-    char *request = build_jsonrpc_request(client, "getTokenAccountBalance", params);
-    if (!request) {
+    char *params = format_alloc("[\"%s\",{\"commitment\":\"%s\"}]", token_account,
+                                espsol_commitment_to_str(handle->commitment));
+    if (!params) {
         return ESP_ERR_NO_MEM;
     }
-    
-    cJSON *result = NULL;
-    esp_err_t err = execute_rpc_request(client, request, &result);
-    free(request);
-    
+
+    espsol_json_t result;
+    esp_err_t err = rpc_request(handle, "getTokenAccountBalance", params, &result);
+    free(params);
+
     if (err != ESP_OK) {
         return err;
     }
-    
+
     /* Parse value */
-    cJSON *value = cJSON_GetObjectItem(result, "value");
-    if (!value || !cJSON_IsObject(value)) {
-        cJSON_Delete(result);
+    espsol_json_t value, field;
+    if (!espsol_json_get(&result, "value", &value) ||
+        espsol_json_type(&value) != ESPSOL_JSON_OBJECT) {
         return ESP_ERR_ESPSOL_RPC_PARSE_ERROR;
     }
-    
-    cJSON *amount_json = cJSON_GetObjectItem(value, "amount");
-    if (amount_json && cJSON_IsString(amount_json)) {
-        *amount = strtoull(amount_json->valuestring, NULL, 10);
+
+    if (espsol_json_get(&value, "amount", &field)) {
+        json_get_u64_string(&field, amount);
     }
-    
-    if (decimals) {
-        cJSON *decimals_json = cJSON_GetObjectItem(value, "decimals");
-        if (decimals_json && cJSON_IsNumber(decimals_json)) {
-            *decimals = (uint8_t)decimals_json->valueint;
+
+    if (decimals && espsol_json_get(&value, "decimals", &field)) {
+        uint64_t d;
+        if (espsol_json_get_u64(&field, &d)) {
+            *decimals = (uint8_t)d;
         }
     }
-    
-    cJSON_Delete(result);
-    return ESP_OK;
-#else
-    (void)token_account;
-    *amount = 1000000;
-    if (decimals) {
-        *decimals = 6;
-    }
+
     return ESP_OK;
-#endif
 }
 
 /* ============================================================================
@@ -1374,61 +2058,35 @@ esp_err_t espsol_rpc_call(espsol_rpc_handle_t handle,
                            const char *params_json,
                            char *response, size_t response_len)
 {
-    if (!handle || !method || !response || response_len == 0) {
+    if (!handle || !method || !response || response_len == 0 || !is_json_safe(method)) {
         return ESP_ERR_INVALID_ARG;
     }
-    
-#if defined(ESP_PLATFORM) && ESP_PLATFORM
-    struct espsol_rpc_client *client = handle;
-    
-    /* Parse params if provided */
-    cJSON *params = NULL;
+
+    /* Validate params if provided */
+    const char *params = NULL;
     if (params_json && params_json[0] != '\0') {
-        params = cJSON_Parse(params_json);
-        if (!params) {
+        espsol_json_t parsed;
+        if (!espsol_json_parse(params_json, strlen(params_json), &parsed)) {
             return ESP_ERR_INVALID_ARG;
         }
+        params = params_json;
     }
-    
-    char *request = build_jsonrpc_request(client, method, params);
-    if (!request) {
-        return ESP_ERR_NO_MEM;
-    }
-    
-    cJSON *result = NULL;
-    esp_err_t err = execute_rpc_request(client, request, &result);
-    free(request);
-    
+
+    espsol_json_t result;
+    esp_err_t err = rpc_request(handle, method, params, &result);
     if (err != ESP_OK) {
         return err;
     }
-    
-    /* Convert result to string */
-    char *result_str = cJSON_PrintUnformatted(result);
-    cJSON_Delete(result);
-    
-    if (!result_str) {
-        return ESP_ERR_NO_MEM;
-    }
-    
-    size_t result_len = strlen(result_str);
-    if (result_len >= response_len) {
-        free(result_str);
+
+    /* Copy raw result JSON */
+    if (result.len >= response_len) {
         return ESP_ERR_ESPSOL_BUFFER_TOO_SMALL;
     }
-    
-    strncpy(response, result_str, response_len - 1);
-    response[response_len - 1] = '\0';
-    free(result_str);
-    
-    return ESP_OK;
-#else
-    (void)method;
-    (void)params_json;
-    strncpy(response, "{}", response_len - 1);
-    response[response_len - 1] = '\0';
+
+    memcpy(response, result.ptr, result.len);
+    response[result.len] = '\0';
+
     return ESP_OK;
-#endif
 }
 
 /* ============================================================================
@@ -1443,42 +2101,55 @@ esp_err_t espsol_rpc_get_minimum_balance_for_rent_exemption(
     if (!handle || !lamports) {
         return ESP_ERR_INVALID_ARG;
     }
-    
-#if defined(ESP_PLATFORM) && ESP_PLATFORM
-    struct espsol_rpc_client *client = handle;
-    
+
     /* Build params: [data_len, {commitment}] */
-    cJSON *params = cJSON_CreateArray();
-    cJSON_AddItemToArray(params, cJSON_CreateNumber((double)data_len));
-    
-    cJSON *config = cJSON_CreateObject();
-    cJSON_AddStringToObject(config, "commitment", espsol_commitment_to_str(client->commitment));
-    cJSON_AddItemToArray(params, config);
-    
-    char *request = build_jsonrpc_request(client, "getMinimumBalanceForRentExemption", params);
-    if (!request) {
-        return ESP_ERR_NO_MEM;
-    }
-    
-    cJSON *result = NULL;
-    esp_err_t err = execute_rpc_request(client, request, &result);
-    free(request);
-    
+    char params[64];
+    snprintf(params, sizeof(params), "[%lu,{\"commitment\":\"%s\"}]",
+             (unsigned long)data_len, espsol_commitment_to_str(handle->commitment));
+
+    espsol_json_t result;
+    esp_err_t err = rpc_request(handle, "getMinimumBalanceForRentExemption", params, &result);
     if (err != ESP_OK) {
         return err;
     }
-    
-    if (!cJSON_IsNumber(result)) {
-        cJSON_Delete(result);
+
+    if (!espsol_json_get_u64(&result, lamports)) {
         return ESP_ERR_ESPSOL_RPC_PARSE_ERROR;
     }
-    
-    *lamports = (uint64_t)result->valuedouble;
-    cJSON_Delete(result);
+
     return ESP_OK;
-#else
-    /* Mock calculation based on data length */
-    *lamports = 890880 + (data_len * 6960 / 1000);
+}
+
+esp_err_t espsol_rpc_get_rent(espsol_rpc_handle_t handle, espsol_rent_t *rent)
+{
+    if (!handle || !rent) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    struct espsol_rpc_client *client = handle;
+
+    if (!client->rent_cached) {
+        uint8_t data[ESPSOL_RENT_SYSVAR_SIZE];
+        espsol_account_info_t info = {0};
+        info.data = data;
+        info.data_capacity = sizeof(data);
+
+        esp_err_t err = espsol_rpc_get_account_info(handle, ESPSOL_RENT_SYSVAR_ADDRESS, &info);
+        if (err != ESP_OK) {
+            return err;
+        }
+
+        if (info.data_len < ESPSOL_RENT_SYSVAR_SIZE ||
+            espsol_rent_decode(data, info.data_len, &client->rent) != ESP_OK) {
+            snprintf(client->last_error, sizeof(client->last_error),
+                     "Invalid Rent sysvar data");
+            ESP_LOGE(TAG, "%s", client->last_error);
+            return ESP_ERR_ESPSOL_RPC_PARSE_ERROR;
+        }
+
+        client->rent_cached = true;
+    }
+
+    *rent = client->rent;
     return ESP_OK;
-#endif
 }
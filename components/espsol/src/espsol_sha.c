@@ -0,0 +1,686 @@
+/**
+ * @file espsol_sha.c
+ * @brief SHA-256 and SHA-512 for host builds
+ *
+ * Used on host builds by both Ed25519 backends, PDA derivation and the
+ * mnemonic checksum. On ESP32, libsodium and mbedTLS provide the hashes.
+ *
+ * The portable block functions are TweetNaCl-derived. On x86-64, faster
+ * ones are selected at run time; define ESPSOL_SHA_PORTABLE to build only
+ * the portable code.
+ *
+ * @copyright Public domain (TweetNaCl)
+ */
+
+#include "espsol_sha.h"
+#include <string.h>
+
+/* Only compile for non-ESP32 platforms */
+#if !defined(ESP_PLATFORM) || !ESP_PLATFORM
+
+#if !defined(ESPSOL_SHA_PORTABLE) && defined(__x86_64__) && \
+    (defined(__GNUC__) || defined(__clang__))
+#define ESPSOL_SHA_X86 1
+#else
+#define ESPSOL_SHA_X86 0
+#endif
+
+typedef uint8_t u8;
+typedef uint32_t u32;
+typedef uint64_t u64;
+
+/* ============================================================================
+ * SHA-512 Implementation
+ * ========================================================================== */
+
+static const u64 K[80] = {
+    0x428a2f98d728ae22ULL, 0x7137449123ef65cdULL, 0xb5c0fbcfec4d3b2fULL, 0xe9b5dba58189dbbcULL,
+    0x3956c25bf348b538ULL, 0x59f111f1b605d019ULL, 0x923f82a4af194f9bULL, 0xab1c5ed5da6d8118ULL,
+    0xd807aa98a3030242ULL, 0x12835b0145706fbeULL, 0x243185be4ee4b28cULL, 0x550c7dc3d5ffb4e2ULL,
+    0x72be5d74f27b896fULL, 0x80deb1fe3b1696b1ULL, 0x9bdc06a725c71235ULL, 0xc19bf174cf692694ULL,
+    0xe49b69c19ef14ad2ULL, 0xefbe4786384f25e3ULL, 0x0fc19dc68b8cd5b5ULL, 0x240ca1cc77ac9c65ULL,
+    0x2de92c6f592b0275ULL, 0x4a7484aa6ea6e483ULL, 0x5cb0a9dcbd41fbd4ULL, 0x76f988da831153b5ULL,
+    0x983e5152ee66dfabULL, 0xa831c66d2db43210ULL, 0xb00327c898fb213fULL, 0xbf597fc7beef0ee4ULL,
+    0xc6e00bf33da88fc2ULL, 0xd5a79147930aa725ULL, 0x06ca6351e003826fULL, 0x142929670a0e6e70ULL,
+    0x27b70a8546d22ffcULL, 0x2e1b21385c26c926ULL, 0x4d2c6dfc5ac42aedULL, 0x53380d139d95b3dfULL,
+    0x650a73548baf63deULL, 0x766a0abb3c77b2a8ULL, 0x81c2c92e47edaee6ULL, 0x92722c851482353bULL,
+    0xa2bfe8a14cf10364ULL, 0xa81a664bbc423001ULL, 0xc24b8b70d0f89791ULL, 0xc76c51a30654be30ULL,
+    0xd192e819d6ef5218ULL, 0xd69906245565a910ULL, 0xf40e35855771202aULL, 0x106aa07032bbd1b8ULL,
+    0x19a4c116b8d2d0c8ULL, 0x1e376c085141ab53ULL, 0x2748774cdf8eeb99ULL, 0x34b0bcb5e19b48a8ULL,
+    0x391c0cb3c5c95a63ULL, 0x4ed8aa4ae3418acbULL, 0x5b9cca4f7763e373ULL, 0x682e6ff3d6b2b8a3ULL,
+    0x748f82ee5defb2fcULL, 0x78a5636f43172f60ULL, 0x84c87814a1f0ab72ULL, 0x8cc702081a6439ecULL,
+    0x90befffa23631e28ULL, 0xa4506cebde82bde9ULL, 0xbef9a3f7b2c67915ULL, 0xc67178f2e372532bULL,
+    0xca273eceea26619cULL, 0xd186b8c721c0c207ULL, 0xeada7dd6cde0eb1eULL, 0xf57d4f7fee6ed178ULL,
+    0x06f067aa72176fbaULL, 0x0a637dc5a2c898a6ULL, 0x113f9804bef90daeULL, 0x1b710b35131c471bULL,
+    0x28db77f523047d84ULL, 0x32caab7b40c72493ULL, 0x3c9ebe0a15c9bebcULL, 0x431d67c49c100d4cULL,
+    0x4cc5d4becb3e42b6ULL, 0x597f299cfc657e2aULL, 0x5fcb6fab3ad6faecULL, 0x6c44198c4a475817ULL
+};
+
+static u64 dl64(const u8 *x)
+{
+    u64 u = 0;
+    for (int i = 0; i < 8; i++) u = (u << 8) | x[i];
+    return u;
+}
+
+static void ts64(u8 *x, u64 u)
+{
+    for (int i = 7; i >= 0; i--) { x[i] = u & 0xff; u >>= 8; }
+}
+
+#define R(x, c) ((x) >> (c) | (x) << (64 - (c)))
+#define Ch(x, y, z) (((x) & (y)) ^ (~(x) & (z)))
+#define Maj(x, y, z) (((x) & (y)) ^ ((x) & (z)) ^ ((y) & (z)))
+#define Sigma0(x) (R(x, 28) ^ R(x, 34) ^ R(x, 39))
+#define Sigma1(x) (R(x, 14) ^ R(x, 18) ^ R(x, 41))
+#define sigma0(x) (R(x, 1) ^ R(x, 8) ^ ((x) >> 7))
+#define sigma1(x) (R(x, 19) ^ R(x, 61) ^ ((x) >> 6))
+
+static void sha512_blocks_portable(u64 *h, const u8 *m, u64 n)
+{
+    u64 a, b, c, d, e, f, g, hh, t1, t2, w[80];
+
+    while (n >= 128) {
+        for (int i = 0; i < 16; i++) w[i] = dl64(m + 8 * i);
+        for (int i = 16; i < 80; i++)
+            w[i] = sigma1(w[i-2]) + w[i-7] + sigma0(w[i-15]) + w[i-16];
+
+        a = h[0]; b = h[1]; c = h[2]; d = h[3];
+        e = h[4]; f = h[5]; g = h[6]; hh = h[7];
+
+        for (int i = 0; i < 80; i++) {
+            t1 = hh + Sigma1(e) + Ch(e, f, g) + K[i] + w[i];
+            t2 = Sigma0(a) + Maj(a, b, c);
+            hh = g; g = f; f = e; e = d + t1;
+            d = c; c = b; b = a; a = t1 + t2;
+        }
+
+        h[0] += a; h[1] += b; h[2] += c; h[3] += d;
+        h[4] += e; h[5] += f; h[6] += g; h[7] += hh;
+
+        m += 128;
+        n -= 128;
+    }
+}
+
+/* ============================================================================
+ * SHA-256 Implementation (for PDA derivation)
+ * ========================================================================== */
+
+static const u32 IV256[8] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+    0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+static const u32 K256[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+static u32 dl32(const u8 *x)
+{
+    return ((u32)x[0] << 24) | ((u32)x[1] << 16) | ((u32)x[2] << 8) | x[3];
+}
+
+static void ts32(u8 *x, u32 u)
+{
+    x[0] = (u8)(u >> 24);
+    x[1] = (u8)(u >> 16);
+    x[2] = (u8)(u >> 8);
+    x[3] = (u8)u;
+}
+
+#define R32(x, c) (((x) >> (c)) | ((x) << (32 - (c))))
+#define S32(x, c) ((x) >> (c))
+#define Sigma0_256(x) (R32(x, 2) ^ R32(x, 13) ^ R32(x, 22))
+#define Sigma1_256(x) (R32(x, 6) ^ R32(x, 11) ^ R32(x, 25))
+#define sigma0_256(x) (R32(x, 7) ^ R32(x, 18) ^ S32(x, 3))
+#define sigma1_256(x) (R32(x, 17) ^ R32(x, 19) ^ S32(x, 10))
+#define Ch32(x, y, z) (((x) & (y)) ^ (~(x) & (z)))
+#define Maj32(x, y, z) (((x) & (y)) ^ ((x) & (z)) ^ ((y) & (z)))
+
+static void sha256_blocks_portable(u32 *h, const u8 *m, u64 n)
+{
+    u32 a, b, c, d, e, f, g, hh, t1, t2, w[64];
+
+    while (n >= 64) {
+        for (int i = 0; i < 16; i++) w[i] = dl32(m + 4 * i);
+        for (int i = 16; i < 64; i++)
+            w[i] = sigma1_256(w[i-2]) + w[i-7] + sigma0_256(w[i-15]) + w[i-16];
+
+        a = h[0]; b = h[1]; c = h[2]; d = h[3];
+        e = h[4]; f = h[5]; g = h[6]; hh = h[7];
+
+        for (int i = 0; i < 64; i++) {
+            t1 = hh + Sigma1_256(e) + Ch32(e, f, g) + K256[i] + w[i];
+            t2 = Sigma0_256(a) + Maj32(a, b, c);
+            hh = g; g = f; f = e; e = d + t1;
+            d = c; c = b; b = a; a = t1 + t2;
+        }
+
+        h[0] += a; h[1] += b; h[2] += c; h[3] += d;
+        h[4] += e; h[5] += f; h[6] += g; h[7] += hh;
+
+        m += 64;
+        n -= 64;
+    }
+}
+
+/**
+ * @brief Pad the last partial block of a SHA-256 input
+ *
+ * @param[out] tail   One or two padded blocks
+ * @param[in]  rest   Bytes after the last whole block
+ * @param[in]  n      Length of rest, below 64
+ * @param[in]  total  Length of the whole input
+ * @return Length of tail, 64 or 128
+ */
+static size_t sha256_pad(u8 tail[128], const u8 *rest, size_t n, u64 total)
+{
+    size_t len = n < 56 ? 64 : 128;
+
+    memset(tail, 0, 128);
+    if (n > 0) memcpy(tail, rest, n);
+    tail[n] = 0x80;
+
+    /* Length in bits at the end */
+    ts32(tail + len - 8, (u32)(total >> 29));
+    ts32(tail + len - 4, (u32)(total << 3));
+    return len;
+}
+
+/* ============================================================================
+ * x86-64 Acceleration
+ * ============================================================================
+ * Compiled with per-function target attributes, so the file still builds
+ * for a baseline x86-64, and chosen at load time from CPUID:
+ * - SHA-256 with the SHA extensions (SHA-NI): two rounds per instruction
+ * - SHA-512 with AVX2: message schedule four words at a time
+ * - SHA-256 with AVX2: eight independent inputs, one per 32-bit lane
+ * ========================================================================== */
+
+#if ESPSOL_SHA_X86
+
+#include <cpuid.h>
+#include <immintrin.h>
+
+__attribute__((target("sha,sse4.1")))
+static void sha256_blocks_shani(u32 *h, const u8 *m, u64 n)
+{
+    const __m128i bswap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+    __m128i state0, state1, msg, tmp, w[4];
+
+    /* The instructions keep the state as ABEF and CDGH */
+    tmp = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)&h[0]), 0xb1);
+    state1 = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)&h[4]), 0x1b);
+    state0 = _mm_alignr_epi8(tmp, state1, 8);
+    state1 = _mm_blend_epi16(state1, tmp, 0xf0);
+
+    while (n >= 64) {
+        __m128i abef = state0, cdgh = state1;
+
+        /* Four rounds per group; w[] holds the schedule for the next four groups */
+        for (int g = 0; g < 16; g++) {
+            if (g < 4) {
+                w[g] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(m + 16 * g)), bswap);
+            }
+            msg = _mm_add_epi32(w[g & 3], _mm_loadu_si128((const __m128i *)&K256[4 * g]));
+            state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+            if (g >= 3 && g <= 14) {
+                tmp = _mm_alignr_epi8(w[g & 3], w[(g - 1) & 3], 4);
+                w[(g + 1) & 3] = _mm_add_epi32(w[(g + 1) & 3], tmp);
+                w[(g + 1) & 3] = _mm_sha256msg2_epu32(w[(g + 1) & 3], w[g & 3]);
+            }
+            msg = _mm_shuffle_epi32(msg, 0x0e);
+            state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+            if (g >= 1 && g <= 12) {
+                w[(g - 1) & 3] = _mm_sha256msg1_epu32(w[(g - 1) & 3], w[g & 3]);
+            }
+        }
+
+        state0 = _mm_add_epi32(state0, abef);
+        state1 = _mm_add_epi32(state1, cdgh);
+        m += 64;
+        n -= 64;
+    }
+
+    tmp = _mm_shuffle_epi32(state0, 0x1b);
+    state1 = _mm_shuffle_epi32(state1, 0xb1);
+    _mm_storeu_si128((__m128i *)&h[0], _mm_blend_epi16(tmp, state1, 0xf0));
+    _mm_storeu_si128((__m128i *)&h[4], _mm_alignr_epi8(state1, tmp, 8));
+}
+
+#define ROR64x4(x, c) _mm256_or_si256(_mm256_srli_epi64(x, c), _mm256_slli_epi64(x, 64 - (c)))
+#define ROR64x2(x, c) _mm_or_si128(_mm_srli_epi64(x, c), _mm_slli_epi64(x, 64 - (c)))
+
+/**
+ * @brief w[i+16..i+19] from the window w[i..i+15] held in x[0..3]
+ *
+ * The sigma1 term of the upper pair depends on the lower pair, so the
+ * last two words are finished in a second step.
+ */
+__attribute__((target("avx2")))
+static __m256i sha512_schedule4(const __m256i x[4])
+{
+    /* w[i+1..i+4] and w[i+9..i+12]: windows shifted by one word */
+    __m256i w1 = _mm256_alignr_epi8(_mm256_permute2x128_si256(x[0], x[1], 0x21), x[0], 8);
+    __m256i w9 = _mm256_alignr_epi8(_mm256_permute2x128_si256(x[2], x[3], 0x21), x[2], 8);
+
+    __m256i s0 = _mm256_xor_si256(_mm256_xor_si256(ROR64x4(w1, 1), ROR64x4(w1, 8)),
+                                  _mm256_srli_epi64(w1, 7));
+    __m256i t = _mm256_add_epi64(_mm256_add_epi64(x[0], s0), w9);
+
+    __m128i prev = _mm256_extracti128_si256(x[3], 1);
+    __m128i s1 = _mm_xor_si128(_mm_xor_si128(ROR64x2(prev, 19), ROR64x2(prev, 61)),
+                               _mm_srli_epi64(prev, 6));
+    __m128i lo = _mm_add_epi64(_mm256_castsi256_si128(t), s1);
+    s1 = _mm_xor_si128(_mm_xor_si128(ROR64x2(lo, 19), ROR64x2(lo, 61)),
+                       _mm_srli_epi64(lo, 6));
+    __m128i hi = _mm_add_epi64(_mm256_extracti128_si256(t, 1), s1);
+    return _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+}
+
+__attribute__((target("avx2")))
+static void sha512_blocks_avx2(u64 *h, const u8 *m, u64 n)
+{
+    const __m256i bswap = _mm256_set_epi8(8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7,
+                                          8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7);
+    u64 a, b, c, d, e, f, g, hh, t1, t2;
+    u64 wk[4] __attribute__((aligned(32)));
+    __m256i x[4];
+
+    while (n >= 128) {
+        for (int j = 0; j < 4; j++) {
+            x[j] = _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i *)(m + 32 * j)), bswap);
+        }
+
+        a = h[0]; b = h[1]; c = h[2]; d = h[3];
+        e = h[4]; f = h[5]; g = h[6]; hh = h[7];
+
+        /* The next schedule words are computed while the rounds run */
+        for (int i = 0; i < 80; i += 4) {
+            _mm256_store_si256((__m256i *)wk,
+                               _mm256_add_epi64(x[0], _mm256_loadu_si256((const __m256i *)&K[i])));
+            __m256i next = i < 64 ? sha512_schedule4(x) : x[3];
+            x[0] = x[1]; x[1] = x[2]; x[2] = x[3]; x[3] = next;
+
+            for (int j = 0; j < 4; j++) {
+                t1 = hh + Sigma1(e) + Ch(e, f, g) + wk[j];
+                t2 = Sigma0(a) + Maj(a, b, c);
+                hh = g; g = f; f = e; e = d + t1;
+                d = c; c = b; b = a; a = t1 + t2;
+            }
+        }
+
+        h[0] += a; h[1] += b; h[2] += c; h[3] += d;
+        h[4] += e; h[5] += f; h[6] += g; h[7] += hh;
+
+        m += 128;
+        n -= 128;
+    }
+}
+
+#define ROR32x8(x, c) _mm256_or_si256(_mm256_srli_epi32(x, c), _mm256_slli_epi32(x, 32 - (c)))
+
+/**
+ * @brief Load eight words from each of eight blocks, one block per lane
+ *
+ * w[k] receives word k of every block: an 8x8 transpose of the rows.
+ */
+__attribute__((target("avx2")))
+static void sha256_load8(__m256i w[8], const u8 *const blk[8], size_t offset)
+{
+    const __m256i bswap = _mm256_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3,
+                                          12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+    __m256i r[8], t[8], u[8];
+
+    for (int l = 0; l < 8; l++) {
+        r[l] = _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i *)(blk[l] + offset)), bswap);
+    }
+    for (int l = 0; l < 8; l += 2) {
+        t[l] = _mm256_unpacklo_epi32(r[l], r[l + 1]);
+        t[l + 1] = _mm256_unpackhi_epi32(r[l], r[l + 1]);
+    }
+    for (int l = 0; l < 8; l += 4) {
+        u[l] = _mm256_unpacklo_epi64(t[l], t[l + 2]);
+        u[l + 1] = _mm256_unpackhi_epi64(t[l], t[l + 2]);
+        u[l + 2] = _mm256_unpacklo_epi64(t[l + 1], t[l + 3]);
+        u[l + 3] = _mm256_unpackhi_epi64(t[l + 1], t[l + 3]);
+    }
+    for (int k = 0; k < 4; k++) {
+        w[k] = _mm256_permute2x128_si256(u[k], u[k + 4], 0x20);
+        w[k + 4] = _mm256_permute2x128_si256(u[k], u[k + 4], 0x31);
+    }
+}
+
+/**
+ * @brief Hash up to eight inputs, one per 32-bit lane
+ *
+ * Every lane starts from the state iv reached after offset bytes, a
+ * whole number of blocks. Lanes finish after different numbers of
+ * blocks; a lane's state stops changing once its last block is done.
+ */
+__attribute__((target("avx2")))
+static void sha256_x8_avx2(const u32 iv[8], u64 offset, const u8 *const *data,
+                           const size_t *len, size_t lanes, u8 (*out)[32])
+{
+    static const u8 zero[64];
+    u8 tail[8][128];
+    size_t whole[8], blocks[8], max_blocks = 0;
+    __m256i s[8], w[16];
+
+    for (size_t l = 0; l < 8; l++) {
+        if (l < lanes) {
+            whole[l] = len[l] / 64;
+            blocks[l] = whole[l] + sha256_pad(tail[l], data[l] + 64 * whole[l],
+                                              len[l] % 64, offset + len[l]) / 64;
+        } else {
+            whole[l] = blocks[l] = 0;
+        }
+        if (blocks[l] > max_blocks) max_blocks = blocks[l];
+    }
+    for (int i = 0; i < 8; i++) s[i] = _mm256_set1_epi32((int)iv[i]);
+
+    for (size_t j = 0; j < max_blocks; j++) {
+        const u8 *blk[8];
+        int live[8];
+        for (size_t l = 0; l < 8; l++) {
+            live[l] = j < blocks[l] ? -1 : 0;
+            blk[l] = j < whole[l] ? data[l] + 64 * j
+                   : j < blocks[l] ? tail[l] + 64 * (j - whole[l]) : zero;
+        }
+        __m256i active = _mm256_setr_epi32(live[0], live[1], live[2], live[3],
+                                           live[4], live[5], live[6], live[7]);
+
+        __m256i a = s[0], b = s[1], c = s[2], d = s[3];
+        __m256i e = s[4], f = s[5], g = s[6], hh = s[7];
+
+        sha256_load8(w, blk, 0);
+        sha256_load8(w + 8, blk, 32);
+
+        for (int i = 0; i < 64; i++) {
+            __m256i wi = w[i & 15];
+            if (i >= 16) {
+                __m256i x = w[(i - 15) & 15], y = w[(i - 2) & 15];
+                __m256i s0 = _mm256_xor_si256(_mm256_xor_si256(ROR32x8(x, 7), ROR32x8(x, 18)),
+                                              _mm256_srli_epi32(x, 3));
+                __m256i s1 = _mm256_xor_si256(_mm256_xor_si256(ROR32x8(y, 17), ROR32x8(y, 19)),
+                                              _mm256_srli_epi32(y, 10));
+                wi = _mm256_add_epi32(_mm256_add_epi32(w[i & 15], s0),
+                                      _mm256_add_epi32(w[(i - 7) & 15], s1));
+                w[i & 15] = wi;
+            }
+
+            __m256i S1 = _mm256_xor_si256(_mm256_xor_si256(ROR32x8(e, 6), ROR32x8(e, 11)),
+                                          ROR32x8(e, 25));
+            __m256i ch = _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+            __m256i t1 = _mm256_add_epi32(_mm256_add_epi32(hh, S1),
+                                          _mm256_add_epi32(ch, _mm256_add_epi32(
+                                              wi, _mm256_set1_epi32((int)K256[i]))));
+            __m256i S0 = _mm256_xor_si256(_mm256_xor_si256(ROR32x8(a, 2), ROR32x8(a, 13)),
+                                          ROR32x8(a, 22));
+            __m256i maj = _mm256_or_si256(_mm256_and_si256(a, b),
+                                          _mm256_and_si256(c, _mm256_or_si256(a, b)));
+            __m256i t2 = _mm256_add_epi32(S0, maj);
+            hh = g; g = f; f = e; e = _mm256_add_epi32(d, t1);
+            d = c; c = b; b = a; a = _mm256_add_epi32(t1, t2);
+        }
+
+        __m256i v[8] = { a, b, c, d, e, f, g, hh };
+        for (int i = 0; i < 8; i++) {
+            s[i] = _mm256_blendv_epi8(s[i], _mm256_add_epi32(s[i], v[i]), active);
+        }
+    }
+
+    u32 lane[8][8];
+    for (int i = 0; i < 8; i++) _mm256_storeu_si256((__m256i *)lane[i], s[i]);
+    for (size_t l = 0; l < lanes; l++) {
+        for (int i = 0; i < 8; i++) ts32(out[l] + 4 * i, lane[i][l]);
+    }
+}
+
+static unsigned cpu_features(void)
+{
+    unsigned a, b, c, d, features = 0;
+
+    if (__get_cpuid_max(0, NULL) < 7 || !__get_cpuid(1, &a, &b, &c, &d)) {
+        return 0;
+    }
+    int ssse3 = (c >> 9) & 1, sse41 = (c >> 19) & 1;
+    int ymm = 0;
+
+    /* AVX registers are only usable if the OS saves them (OSXSAVE + XCR0) */
+    if (((c >> 27) & 1) && ((c >> 28) & 1)) {
+        unsigned lo, hi;
+        __asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+        ymm = (lo & 6) == 6;
+    }
+
+    __cpuid_count(7, 0, a, b, c, d);
+    if (((b >> 29) & 1) && ssse3 && sse41) features |= ESPSOL_SHA_SHANI;
+    if (((b >> 5) & 1) && ymm) features |= ESPSOL_SHA_AVX2;
+    return features;
+}
+
+#endif /* ESPSOL_SHA_X86 */
+
+/* ============================================================================
+ * Dispatch
+ * ========================================================================== */
+
+static void (*sha256_blocks)(u32 *h, const u8 *m, u64 n) = sha256_blocks_portable;
+static void (*sha512_blocks)(u64 *h, const u8 *m, u64 n) = sha512_blocks_portable;
+static unsigned s_features;
+
+unsigned espsol_sha_cpu_features(void)
+{
+#if ESPSOL_SHA_X86
+    return cpu_features();
+#else
+    return 0;
+#endif
+}
+
+unsigned espsol_sha_select(unsigned features)
+{
+    features &= espsol_sha_cpu_features();
+
+    sha256_blocks = sha256_blocks_portable;
+    sha512_blocks = sha512_blocks_portable;
+#if ESPSOL_SHA_X86
+    if (features & ESPSOL_SHA_SHANI) sha256_blocks = sha256_blocks_shani;
+    if (features & ESPSOL_SHA_AVX2) sha512_blocks = sha512_blocks_avx2;
+#endif
+    s_features = features;
+    return features;
+}
+
+#if ESPSOL_SHA_X86
+/* Pick the fastest paths before main() runs, so hashing never races on it */
+__attribute__((constructor))
+static void sha_select_best(void)
+{
+    espsol_sha_select(~0u);
+}
+#endif
+
+/* ============================================================================
+ * Public API
+ * ========================================================================== */
+
+static const u64 IV512[8] = {
+    0x6a09e667f3bcc908ULL, 0xbb67ae8584caa73bULL,
+    0x3c6ef372fe94f82bULL, 0xa54ff53a5f1d36f1ULL,
+    0x510e527fade682d1ULL, 0x9b05688c2b3e6c1fULL,
+    0x1f83d9abfb41bd6bULL, 0x5be0cd19137e2179ULL
+};
+
+void espsol_sha512_init(espsol_sha512_ctx_t *ctx)
+{
+    memcpy(ctx->state, IV512, sizeof(IV512));
+    ctx->total = 0;
+    ctx->block_len = 0;
+}
+
+void espsol_sha512_update(espsol_sha512_ctx_t *ctx, const u8 *data, size_t len)
+{
+    if (len == 0) return;
+    ctx->total += len;
+
+    /* Complete a partial block first */
+    if (ctx->block_len > 0) {
+        size_t take = 128 - ctx->block_len;
+        if (take > len) take = len;
+        memcpy(ctx->block + ctx->block_len, data, take);
+        ctx->block_len += take;
+        data += take;
+        len -= take;
+        if (ctx->block_len < 128) return;
+        sha512_blocks(ctx->state, ctx->block, 128);
+        ctx->block_len = 0;
+    }
+
+    /* Whole blocks are hashed straight from the input */
+    size_t whole = len & ~(size_t)127;
+    sha512_blocks(ctx->state, data, whole);
+    data += whole;
+    len -= whole;
+
+    memcpy(ctx->block, data, len);
+    ctx->block_len = len;
+}
+
+void espsol_sha512_final(espsol_sha512_ctx_t *ctx, u8 out[64])
+{
+    u8 x[256];
+    u64 n = ctx->block_len;
+    u64 b = ctx->total;
+
+    memset(x, 0, 256);
+    memcpy(x, ctx->block, n);
+    x[n] = 128;
+
+    n = 256 - 128 * (n < 112);
+    x[n - 9] = (u8)(b >> 61);
+    ts64(x + n - 8, b << 3);
+    sha512_blocks(ctx->state, x, n);
+
+    for (int i = 0; i < 8; i++) ts64(out + 8 * i, ctx->state[i]);
+}
+
+void espsol_sha512(const u8 *m, size_t len, u8 out[64])
+{
+    espsol_sha512_ctx_t ctx;
+
+    espsol_sha512_init(&ctx);
+    espsol_sha512_update(&ctx, m, len);
+    espsol_sha512_final(&ctx, out);
+}
+
+void espsol_sha256_init(espsol_sha256_ctx_t *ctx)
+{
+    memcpy(ctx->state, IV256, sizeof(IV256));
+    ctx->total = 0;
+    ctx->block_len = 0;
+}
+
+void espsol_sha256_update(espsol_sha256_ctx_t *ctx, const u8 *data, size_t len)
+{
+    if (len == 0) return;
+    ctx->total += len;
+
+    /* Complete a partial block first */
+    if (ctx->block_len > 0) {
+        size_t take = 64 - ctx->block_len;
+        if (take > len) take = len;
+        memcpy(ctx->block + ctx->block_len, data, take);
+        ctx->block_len += take;
+        data += take;
+        len -= take;
+        if (ctx->block_len < 64) return;
+        sha256_blocks(ctx->state, ctx->block, 64);
+        ctx->block_len = 0;
+    }
+
+    /* Whole blocks are hashed straight from the input */
+    size_t whole = len & ~(size_t)63;
+    sha256_blocks(ctx->state, data, whole);
+    data += whole;
+    len -= whole;
+
+    memcpy(ctx->block, data, len);
+    ctx->block_len = len;
+}
+
+void espsol_sha256_final(espsol_sha256_ctx_t *ctx, u8 out[32])
+{
+    u8 tail[128];
+
+    sha256_blocks(ctx->state, tail, sha256_pad(tail, ctx->block, ctx->block_len, ctx->total));
+    for (int i = 0; i < 8; i++) ts32(out + 4 * i, ctx->state[i]);
+}
+
+void espsol_sha256(const u8 *data, size_t len, u8 out[32])
+{
+    u32 h[8];
+    u8 tail[128];
+    size_t whole = len & ~(size_t)63;
+
+    memcpy(h, IV256, sizeof(IV256));
+    sha256_blocks(h, data, whole);
+    sha256_blocks(h, tail, sha256_pad(tail, data + whole, len - whole, len));
+
+    for (int i = 0; i < 8; i++) ts32(out + 4 * i, h[i]);
+}
+
+void espsol_sha256_many(const uint8_t *const *data, const size_t *len, size_t count,
+                        uint8_t (*out)[32])
+{
+    size_t i = 0;
+
+#if ESPSOL_SHA_X86
+    if (s_features & ESPSOL_SHA_AVX2) {
+        for (; i < count; i += 8) {
+            size_t lanes = count - i < 8 ? count - i : 8;
+            sha256_x8_avx2(IV256, 0, data + i, len + i, lanes, out + i);
+        }
+    }
+#endif
+    for (; i < count; i++) {
+        espsol_sha256(data[i], len[i], out[i]);
+    }
+}
+
+size_t espsol_sha256_lanes(void)
+{
+    return (s_features & ESPSOL_SHA_AVX2) ? 8 : 1;
+}
+
+void espsol_sha256_many_from(const espsol_sha256_ctx_t *prefix, const uint8_t *const *data,
+                             const size_t *len, size_t count, uint8_t (*out)[32])
+{
+    size_t i = 0;
+
+#if ESPSOL_SHA_X86
+    /* Lanes start on a block boundary; pending prefix bytes take the serial path */
+    if ((s_features & ESPSOL_SHA_AVX2) && prefix->block_len == 0) {
+        for (; i < count; i += 8) {
+            size_t lanes = count - i < 8 ? count - i : 8;
+            sha256_x8_avx2(prefix->state, prefix->total, data + i, len + i, lanes, out + i);
+        }
+    }
+#endif
+    for (; i < count; i++) {
+        espsol_sha256_ctx_t ctx = *prefix;
+        espsol_sha256_update(&ctx, data[i], len[i]);
+        espsol_sha256_final(&ctx, out[i]);
+    }
+}
+
+#endif /* !ESP_PLATFORM */
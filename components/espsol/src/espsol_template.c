@@ -0,0 +1,301 @@
+/**
+ * @file espsol_template.c
+ * @brief ESPSOL Patchable Transaction Templates Implementation
+ *
+ * The template keeps the transaction in wire format: the compact
+ * signature count, the signature slots and the sealed message. Patching
+ * writes straight into the message bytes, signing writes straight into
+ * the signature slots.
+ *
+ * @copyright Copyright (c) 2025 SkyRizz
+ * @license Apache-2.0
+ */
+
+#include "espsol_template.h"
+#include "espsol_utils.h"
+#include "espsol_crypto.h"
+#include "espsol_tx_internal.h"
+
+#include <string.h>
+
+#if defined(ESP_PLATFORM) && ESP_PLATFORM
+#include "esp_log.h"
+static const char *TAG = "espsol_template";
+#else
+#define ESP_LOGI(tag, ...)
+#define ESP_LOGW(tag, ...)
+#define ESP_LOGE(tag, ...)
+#define ESP_LOGD(tag, ...)
+#endif
+
+/** Version prefix bit of a versioned message */
+#define MESSAGE_VERSION_PREFIX  0x80
+
+/* ============================================================================
+ * Internal Helper Functions
+ * ========================================================================== */
+
+static uint8_t *message_at(espsol_tx_template_t *tpl, size_t offset)
+{
+    return tpl->wire + tpl->message_offset + offset;
+}
+
+/**
+ * @brief Patching changes the message, so every signature is stale
+ */
+static void drop_signatures(espsol_tx_template_t *tpl)
+{
+    tpl->signed_mask = 0;
+}
+
+static esp_err_t add_slot(espsol_tx_template_t *tpl, size_t offset, size_t size,
+                          espsol_tx_slot_kind_t kind, size_t *slot)
+{
+    if (tpl->slot_count >= ESPSOL_TX_TEMPLATE_MAX_SLOTS) {
+        return ESP_ERR_ESPSOL_BUFFER_TOO_SMALL;
+    }
+
+    espsol_tx_slot_t *s = &tpl->slots[tpl->slot_count];
+    s->offset = (uint16_t)offset;
+    s->size = (uint8_t)size;
+    s->kind = (uint8_t)kind;
+    *slot = tpl->slot_count++;
+    return ESP_OK;
+}
+
+/* ============================================================================
+ * Template Creation
+ * ========================================================================== */
+
+esp_err_t espsol_tx_template_init(espsol_tx_template_t *tpl, espsol_tx_handle_t tx)
+{
+    if (!tpl || !tx) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    const uint8_t *message;
+    size_t message_len;
+    esp_err_t err = espsol_tx_get_message(tx, &message, &message_len);
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    /* Header: [version prefix], required signatures, read-only counts, keys */
+    size_t pos = (message[0] & MESSAGE_VERSION_PREFIX) ? 1 : 0;
+    size_t signer_count = message[pos];
+    size_t key_count;
+    pos += 3;
+    if (!espsol_tx_read_compact_u16(message, message_len, &pos, &key_count) ||
+        pos + key_count * ESPSOL_PUBKEY_SIZE + ESPSOL_BLOCKHASH_SIZE > message_len) {
+        return ESP_ERR_ESPSOL_TX_BUILD_ERROR;
+    }
+
+    /* Signature count stays below 128, so its compact-u16 is one byte */
+    size_t message_offset = 1 + signer_count * ESPSOL_SIGNATURE_SIZE;
+    if (message_offset + message_len > sizeof(tpl->wire)) {
+        return ESP_ERR_ESPSOL_BUFFER_TOO_SMALL;
+    }
+
+    memset(tpl, 0, sizeof(*tpl));
+    tpl->wire[0] = (uint8_t)signer_count;
+    memcpy(tpl->wire + message_offset, message, message_len);
+    tpl->message_offset = message_offset;
+    tpl->message_len = message_len;
+    tpl->wire_len = message_offset + message_len;
+    tpl->signer_count = signer_count;
+    tpl->key_count = key_count;
+    tpl->keys_offset = pos;
+    tpl->blockhash_offset = pos + key_count * ESPSOL_PUBKEY_SIZE;
+
+    ESP_LOGD(TAG, "Template created (%u bytes, %u signers)",
+             (unsigned)tpl->wire_len, (unsigned)signer_count);
+    return ESP_OK;
+}
+
+esp_err_t espsol_tx_template_add_data_slot(espsol_tx_template_t *tpl,
+                                            size_t instruction,
+                                            size_t offset, size_t size,
+                                            size_t *slot)
+{
+    if (!tpl || !slot || size == 0 || size > ESPSOL_PUBKEY_SIZE) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    /* Walk the instructions up to the requested one */
+    const uint8_t *message = message_at(tpl, 0);
+    size_t len = tpl->message_len;
+    size_t pos = tpl->blockhash_offset + ESPSOL_BLOCKHASH_SIZE;
+    size_t ix_count, account_count, data_len;
+    if (!espsol_tx_read_compact_u16(message, len, &pos, &ix_count) || instruction >= ix_count) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    for (size_t i = 0; ; i++) {
+        pos++;  /* Program index */
+        if (!espsol_tx_read_compact_u16(message, len, &pos, &account_count)) {
+            return ESP_ERR_INVALID_ARG;
+        }
+        pos += account_count;
+        if (!espsol_tx_read_compact_u16(message, len, &pos, &data_len) || pos + data_len > len) {
+            return ESP_ERR_INVALID_ARG;
+        }
+        if (i == instruction) {
+            break;
+        }
+        pos += data_len;
+    }
+
+    if (offset > data_len || size > data_len - offset) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    return add_slot(tpl, pos + offset, size, ESPSOL_TX_SLOT_DATA, slot);
+}
+
+esp_err_t espsol_tx_template_add_key_slot(espsol_tx_template_t *tpl,
+                                           const uint8_t pubkey[ESPSOL_PUBKEY_SIZE],
+                                           size_t *slot)
+{
+    if (!tpl || !pubkey || !slot) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    for (size_t i = 0; i < tpl->key_count; i++) {
+        size_t offset = tpl->keys_offset + i * ESPSOL_PUBKEY_SIZE;
+        if (memcmp(message_at(tpl, offset), pubkey, ESPSOL_PUBKEY_SIZE) != 0) {
+            continue;
+        }
+        if (i < tpl->signer_count) {
+            ESP_LOGE(TAG, "Signer keys cannot be patched");
+            return ESP_ERR_INVALID_ARG;
+        }
+        return add_slot(tpl, offset, ESPSOL_PUBKEY_SIZE, ESPSOL_TX_SLOT_KEY, slot);
+    }
+    return ESP_ERR_NOT_FOUND;
+}
+
+/* ============================================================================
+ * Patching
+ * ========================================================================== */
+
+esp_err_t espsol_tx_template_set_bytes(espsol_tx_template_t *tpl, size_t slot,
+                                        const uint8_t *data, size_t len)
+{
+    if (!tpl || !data || slot >= tpl->slot_count || len != tpl->slots[slot].size) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    const espsol_tx_slot_t *s = &tpl->slots[slot];
+
+    /* An account key must stay unique among the static keys */
+    if (s->kind == ESPSOL_TX_SLOT_KEY) {
+        for (size_t i = 0; i < tpl->key_count; i++) {
+            size_t offset = tpl->keys_offset + i * ESPSOL_PUBKEY_SIZE;
+            if (offset != s->offset &&
+                memcmp(message_at(tpl, offset), data, ESPSOL_PUBKEY_SIZE) == 0) {
+                return ESP_ERR_INVALID_ARG;
+            }
+        }
+    }
+
+    memcpy(message_at(tpl, s->offset), data, len);
+    drop_signatures(tpl);
+    return ESP_OK;
+}
+
+esp_err_t espsol_tx_template_set_u64(espsol_tx_template_t *tpl, size_t slot, uint64_t value)
+{
+    uint8_t bytes[8];
+    for (int i = 0; i < 8; i++) {
+        bytes[i] = (uint8_t)(value >> (i * 8));
+    }
+    return espsol_tx_template_set_bytes(tpl, slot, bytes, sizeof(bytes));
+}
+
+esp_err_t espsol_tx_template_set_pubkey(espsol_tx_template_t *tpl, size_t slot,
+                                         const uint8_t pubkey[ESPSOL_PUBKEY_SIZE])
+{
+    if (!pubkey) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    return espsol_tx_template_set_bytes(tpl, slot, pubkey, ESPSOL_PUBKEY_SIZE);
+}
+
+esp_err_t espsol_tx_template_set_blockhash(espsol_tx_template_t *tpl,
+                                            const uint8_t blockhash[ESPSOL_BLOCKHASH_SIZE])
+{
+    if (!tpl || !blockhash || tpl->message_len == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    memcpy(message_at(tpl, tpl->blockhash_offset), blockhash, ESPSOL_BLOCKHASH_SIZE);
+    drop_signatures(tpl);
+    return ESP_OK;
+}
+
+/* ============================================================================
+ * Signing and Output
+ * ========================================================================== */
+
+esp_err_t espsol_tx_template_sign(espsol_tx_template_t *tpl, const espsol_keypair_t *keypair)
+{
+    if (!tpl || !keypair) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    /* Signer i signs into signature slot i */
+    for (size_t i = 0; i < tpl->signer_count; i++) {
+        size_t offset = tpl->keys_offset + i * ESPSOL_PUBKEY_SIZE;
+        if (memcmp(message_at(tpl, offset), keypair->public_key, ESPSOL_PUBKEY_SIZE) != 0) {
+            continue;
+        }
+
+        uint8_t *signature = tpl->wire + 1 + i * ESPSOL_SIGNATURE_SIZE;
+        if (espsol_sign(message_at(tpl, 0), tpl->message_len, keypair, signature) != ESP_OK) {
+            ESP_LOGE(TAG, "Failed to sign template");
+            return ESP_ERR_ESPSOL_CRYPTO_ERROR;
+        }
+        tpl->signed_mask |= (uint32_t)1 << i;
+        return ESP_OK;
+    }
+
+    ESP_LOGE(TAG, "Keypair public key not found in required signers");
+    return ESP_ERR_ESPSOL_TX_BUILD_ERROR;
+}
+
+bool espsol_tx_template_is_signed(const espsol_tx_template_t *tpl)
+{
+    if (!tpl || tpl->message_len == 0) {
+        return false;
+    }
+    return tpl->signed_mask == ((uint32_t)1 << tpl->signer_count) - 1;
+}
+
+esp_err_t espsol_tx_template_get_transaction(const espsol_tx_template_t *tpl,
+                                              const uint8_t **data, size_t *len)
+{
+    if (!tpl || !data || !len) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (!espsol_tx_template_is_signed(tpl)) {
+        return ESP_ERR_ESPSOL_TX_NOT_SIGNED;
+    }
+
+    *data = tpl->wire;
+    *len = tpl->wire_len;
+    return ESP_OK;
+}
+
+esp_err_t espsol_tx_template_to_base64(const espsol_tx_template_t *tpl,
+                                        char *output, size_t output_len)
+{
+    if (!tpl || !output || output_len == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (!espsol_tx_template_is_signed(tpl)) {
+        return ESP_ERR_ESPSOL_TX_NOT_SIGNED;
+    }
+
+    return espsol_base64_encode(tpl->wire, tpl->wire_len, output, output_len);
+}
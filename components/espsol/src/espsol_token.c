@@ -15,6 +15,7 @@
 #include "espsol_token.h"
 #include "espsol_tx.h"
 #include "espsol_crypto.h"
+#include "espsol_worker.h"
 #include <string.h>
 
 #if defined(ESP_PLATFORM) && ESP_PLATFORM
@@ -26,8 +27,13 @@ static const char *TAG = "espsol_token";
 #include <stdio.h>
 #define ESP_LOGI(tag, ...)
 #define ESP_LOGE(tag, ...) fprintf(stderr, __VA_ARGS__); fprintf(stderr, "\n")
-/* SHA256 from portable implementation */
-extern void espsol_sha256(const uint8_t *data, size_t len, uint8_t out[32]);
+/* SHA256 and the curve check from portable implementations */
+#include "espsol_sha.h"
+#ifdef USE_LIBSODIUM
+#include "sodium.h"
+#else
+#include "espsol_ed25519.h"
+#endif
 #endif
 
 /* ============================================================================
@@ -68,8 +74,10 @@ static void sha256_hash(const uint8_t *data, size_t len, uint8_t out[32])
 /**
  * @brief Check if a point is on the Ed25519 curve
  *
- * This is a simplified check - we attempt to decompress the y-coordinate
- * and verify if it's a valid curve point.
+ * A candidate is a valid PDA when it does not decompress to a curve
+ * point. Small-order points and non-canonical y still count as on the
+ * curve, so libsodium's crypto_core_ed25519_is_valid_point(), which
+ * rejects them, would accept addresses the runtime does not.
  */
 bool espsol_is_on_curve(const uint8_t pubkey[ESPSOL_PUBKEY_SIZE])
 {
@@ -77,23 +85,170 @@ bool espsol_is_on_curve(const uint8_t pubkey[ESPSOL_PUBKEY_SIZE])
         return false;
     }
     
+#if (defined(ESP_PLATFORM) && ESP_PLATFORM) || defined(USE_LIBSODIUM)
+    /* Addition decodes its operands with ge25519_frombytes() and nothing more */
+    static const uint8_t IDENTITY[ESPSOL_PUBKEY_SIZE] = { 1 };
+    uint8_t sum[ESPSOL_PUBKEY_SIZE];
+    return crypto_core_ed25519_add(sum, pubkey, IDENTITY) == 0;
+#else
+    return espsol_ed25519_is_on_curve(pubkey);
+#endif
+}
+
+/* ============================================================================
+ * PDA Engine
+ * ========================================================================== */
+
+/** PDA marker string, hashed after the program ID */
+static const char PDA_MARKER[] = "ProgramDerivedAddress";
+#define PDA_MARKER_LEN  (sizeof(PDA_MARKER) - 1)
+
+/** Bytes a candidate hashes after the midstate: seed remainder, bump, program ID, marker */
+#define PDA_TAIL_MAX    (63 + 1 + ESPSOL_PUBKEY_SIZE + PDA_MARKER_LEN)
+
+/** Most bump candidates hashed per call (one per SHA-256 lane) */
+#define PDA_LANES_MAX   8
+
 #if defined(ESP_PLATFORM) && ESP_PLATFORM
-    /* Use libsodium to check if valid Ed25519 point */
-    /* Try to use the public key - if it's invalid, operations fail */
-    /* For libsodium, we can check by attempting core_ed25519_is_valid_point */
-    return crypto_core_ed25519_is_valid_point(pubkey) == 1;
+typedef crypto_hash_sha256_state sha256_state_t;
+#define sha256_init(state)              crypto_hash_sha256_init(state)
+#define sha256_update(state, in, len)   crypto_hash_sha256_update(state, in, len)
+#define sha256_final(state, out)        crypto_hash_sha256_final(state, out)
 #else
-    /* Simplified host check - just check if it's all zeros (definitely not on curve) */
-    uint8_t zeros[ESPSOL_PUBKEY_SIZE] = {0};
-    if (memcmp(pubkey, zeros, ESPSOL_PUBKEY_SIZE) == 0) {
+typedef espsol_sha256_ctx_t sha256_state_t;
+#define sha256_init(state)              espsol_sha256_init(state)
+#define sha256_update(state, in, len)   espsol_sha256_update(state, in, len)
+#define sha256_final(state, out)        espsol_sha256_final(state, out)
+#endif
+
+/**
+ * @brief Bump search for one set of seeds and program
+ *
+ * The seeds are hashed once, up to their last whole block. Each bump
+ * candidate then only hashes the rest: the seed bytes past that block,
+ * the bump, the program ID and the marker.
+ */
+typedef struct {
+    sha256_state_t prefix;          /**< Midstate after the whole blocks of the seeds */
+    uint8_t tail[PDA_TAIL_MAX];     /**< Candidate input after the midstate */
+    size_t tail_len;                /**< Length of tail */
+    size_t bump_at;                 /**< Offset of the bump in tail */
+} pda_engine_t;
+
+/**
+ * @brief Check seeds against the runtime's limits
+ *
+ * The bump is one more seed, so at most ESPSOL_MAX_SEEDS - 1 are given.
+ */
+static bool pda_seeds_valid(const uint8_t **seeds, const size_t *seed_lens, size_t seed_count)
+{
+    if (seed_count >= ESPSOL_MAX_SEEDS) {
         return false;
     }
-    /* For host testing, we'll assume it's on curve unless it's a known PDA */
-    /* A proper implementation would do the full curve check */
+    for (size_t i = 0; i < seed_count; i++) {
+        if (seed_lens[i] > ESPSOL_MAX_SEED_LEN || (seeds[i] == NULL && seed_lens[i] > 0)) {
+            return false;
+        }
+    }
     return true;
+}
+
+static void pda_engine_init(pda_engine_t *engine,
+                            const uint8_t **seeds, const size_t *seed_lens, size_t seed_count,
+                            const uint8_t program_id[ESPSOL_PUBKEY_SIZE])
+{
+    size_t n = 0;
+
+    /* Gather the seeds in tail, hashing each block as it fills */
+    sha256_init(&engine->prefix);
+    for (size_t i = 0; i < seed_count; i++) {
+        const uint8_t *seed = seeds[i];
+        size_t len = seed_lens[i];
+
+        while (len > 0) {
+            size_t take = 64 - n < len ? 64 - n : len;
+            memcpy(engine->tail + n, seed, take);
+            n += take;
+            seed += take;
+            len -= take;
+            if (n == 64) {
+                sha256_update(&engine->prefix, engine->tail, 64);
+                n = 0;
+            }
+        }
+    }
+
+    engine->bump_at = n++;
+    memcpy(engine->tail + n, program_id, ESPSOL_PUBKEY_SIZE);
+    n += ESPSOL_PUBKEY_SIZE;
+    memcpy(engine->tail + n, PDA_MARKER, PDA_MARKER_LEN);
+    engine->tail_len = n + PDA_MARKER_LEN;
+}
+
+/**
+ * @brief Hash the candidates for bump, bump - 1, ... (count of them)
+ */
+static void pda_engine_hash(const pda_engine_t *engine, uint8_t bump, size_t count,
+                            uint8_t (*out)[32])
+{
+#if defined(ESP_PLATFORM) && ESP_PLATFORM
+    for (size_t i = 0; i < count; i++) {
+        sha256_state_t state = engine->prefix;
+        uint8_t b = (uint8_t)(bump - i);
+
+        sha256_update(&state, engine->tail, engine->bump_at);
+        sha256_update(&state, &b, 1);
+        sha256_update(&state, engine->tail + engine->bump_at + 1,
+                      engine->tail_len - engine->bump_at - 1);
+        sha256_final(&state, out[i]);
+    }
+#else
+    uint8_t tails[PDA_LANES_MAX][PDA_TAIL_MAX];
+    const uint8_t *data[PDA_LANES_MAX];
+    size_t lens[PDA_LANES_MAX];
+
+    for (size_t i = 0; i < count; i++) {
+        memcpy(tails[i], engine->tail, engine->tail_len);
+        tails[i][engine->bump_at] = (uint8_t)(bump - i);
+        data[i] = tails[i];
+        lens[i] = engine->tail_len;
+    }
+    espsol_sha256_many_from(&engine->prefix, data, lens, count, out);
 #endif
 }
 
+static esp_err_t pda_engine_find(const pda_engine_t *engine,
+                                 uint8_t pda[ESPSOL_PUBKEY_SIZE], uint8_t *bump)
+{
+#if defined(ESP_PLATFORM) && ESP_PLATFORM
+    /* Candidates are hashed one at a time; most searches stop at the first */
+    const int lanes = 1;
+#else
+    const int lanes = (int)espsol_sha256_lanes();
+#endif
+    uint8_t candidates[PDA_LANES_MAX][32];
+
+    /* Try bump seeds from 255 down to 0 */
+    for (int b = 255; b >= 0; b -= lanes) {
+        int count = b + 1 < lanes ? b + 1 : lanes;
+        pda_engine_hash(engine, (uint8_t)b, (size_t)count, candidates);
+
+        for (int i = 0; i < count; i++) {
+            /* Check if candidate is OFF the curve (valid PDA) */
+            if (!espsol_is_on_curve(candidates[i])) {
+                memcpy(pda, candidates[i], ESPSOL_PUBKEY_SIZE);
+                if (bump != NULL) {
+                    *bump = (uint8_t)(b - i);
+                }
+                return ESP_OK;
+            }
+        }
+    }
+
+    /* No valid bump found (extremely rare) */
+    return ESP_ERR_ESPSOL_CRYPTO_ERROR;
+}
+
 esp_err_t espsol_token_find_pda(
     const uint8_t **seeds,
     const size_t *seed_lens,
@@ -102,56 +257,17 @@ esp_err_t espsol_token_find_pda(
     uint8_t pda[ESPSOL_PUBKEY_SIZE],
     uint8_t *bump)
 {
-    if (seeds == NULL || seed_lens == NULL || program_id == NULL || pda == NULL) {
+    if ((seed_count > 0 && (seeds == NULL || seed_lens == NULL)) ||
+        program_id == NULL || pda == NULL) {
         return ESP_ERR_INVALID_ARG;
     }
-    
-    /* Try bump seeds from 255 down to 0 */
-    uint8_t hash_input[512];
-    size_t offset;
-    uint8_t candidate[32];
-    
-    /* PDA marker string */
-    static const char PDA_MARKER[] = "ProgramDerivedAddress";
-    
-    for (int b = 255; b >= 0; b--) {
-        offset = 0;
-        
-        /* Concatenate all seeds */
-        for (size_t i = 0; i < seed_count; i++) {
-            if (offset + seed_lens[i] > sizeof(hash_input) - 64) {
-                return ESP_ERR_ESPSOL_BUFFER_TOO_SMALL;
-            }
-            memcpy(hash_input + offset, seeds[i], seed_lens[i]);
-            offset += seed_lens[i];
-        }
-        
-        /* Add bump seed */
-        hash_input[offset++] = (uint8_t)b;
-        
-        /* Add program ID */
-        memcpy(hash_input + offset, program_id, ESPSOL_PUBKEY_SIZE);
-        offset += ESPSOL_PUBKEY_SIZE;
-        
-        /* Add PDA marker */
-        memcpy(hash_input + offset, PDA_MARKER, sizeof(PDA_MARKER) - 1);
-        offset += sizeof(PDA_MARKER) - 1;
-        
-        /* Hash to get candidate */
-        sha256_hash(hash_input, offset, candidate);
-        
-        /* Check if candidate is OFF the curve (valid PDA) */
-        if (!espsol_is_on_curve(candidate)) {
-            memcpy(pda, candidate, ESPSOL_PUBKEY_SIZE);
-            if (bump != NULL) {
-                *bump = (uint8_t)b;
-            }
-            return ESP_OK;
-        }
+    if (!pda_seeds_valid(seeds, seed_lens, seed_count)) {
+        return ESP_ERR_INVALID_ARG;
     }
-    
-    /* No valid bump found (extremely rare) */
-    return ESP_ERR_ESPSOL_CRYPTO_ERROR;
+
+    pda_engine_t engine;
+    pda_engine_init(&engine, seeds, seed_lens, seed_count, program_id);
+    return pda_engine_find(&engine, pda, bump);
 }
 
 esp_err_t espsol_token_get_ata_address(
@@ -181,6 +297,139 @@ esp_err_t espsol_token_get_ata_address(
         ata_address, NULL);
 }
 
+/* ============================================================================
+ * Batch ATA Derivation
+ * ========================================================================== */
+
+/* Threads deriving a batch, the caller included */
+#ifdef CONFIG_ESPSOL_PDA_WORKERS
+#define PDA_WORKERS CONFIG_ESPSOL_PDA_WORKERS
+#else
+#define PDA_WORKERS 4
+#endif
+
+/** Fewest pairs worth handing to another thread */
+#define PDA_PAIRS_PER_WORKER    32
+
+/** Stack for a derivation task: hashing and one curve check, no I/O */
+#define PDA_WORKER_STACK_SIZE   4096
+
+typedef struct {
+    const uint8_t (*wallets)[ESPSOL_PUBKEY_SIZE];
+    const uint8_t (*mints)[ESPSOL_PUBKEY_SIZE];
+    uint8_t (*ata_addresses)[ESPSOL_PUBKEY_SIZE];
+    size_t begin;                   /**< First pair of this share */
+    size_t end;                     /**< One past the last pair */
+    esp_err_t err;                  /**< Result for the share */
+} ata_job_t;
+
+static void ata_job(void *arg)
+{
+    ata_job_t *job = arg;
+
+    job->err = ESP_OK;
+    for (size_t i = job->begin; i < job->end && job->err == ESP_OK; i++) {
+        job->err = espsol_token_get_ata_address(job->wallets[i], job->mints[i],
+                                                job->ata_addresses[i]);
+    }
+}
+
+esp_err_t espsol_token_get_ata_addresses_batch(
+    const uint8_t (*wallets)[ESPSOL_PUBKEY_SIZE],
+    const uint8_t (*mints)[ESPSOL_PUBKEY_SIZE],
+    size_t count,
+    uint8_t (*ata_addresses)[ESPSOL_PUBKEY_SIZE])
+{
+    if (count > 0 && (wallets == NULL || mints == NULL || ata_addresses == NULL)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    size_t shares = count / PDA_PAIRS_PER_WORKER;
+    if (shares > PDA_WORKERS) {
+        shares = PDA_WORKERS;
+    }
+    if (shares == 0) {
+        shares = 1;
+    }
+
+    ata_job_t jobs[PDA_WORKERS];
+    espsol_worker_t workers[PDA_WORKERS] = { NULL };
+
+    for (size_t s = 0; s < shares; s++) {
+        jobs[s] = (ata_job_t){
+            .wallets = wallets,
+            .mints = mints,
+            .ata_addresses = ata_addresses,
+            .begin = count * s / shares,
+            .end = count * (s + 1) / shares,
+        };
+    }
+
+    /* The caller takes the first share; a share without a worker runs inline too */
+    for (size_t s = 1; s < shares; s++) {
+        if (espsol_worker_create("espsol_pda", PDA_WORKER_STACK_SIZE, &workers[s]) == ESP_OK) {
+            espsol_worker_submit(workers[s], ata_job, &jobs[s]);
+        } else {
+            workers[s] = NULL;
+        }
+    }
+
+    ata_job(&jobs[0]);
+    for (size_t s = 1; s < shares; s++) {
+        if (workers[s] == NULL) {
+            ata_job(&jobs[s]);
+        }
+    }
+
+    esp_err_t err = ESP_OK;
+    for (size_t s = 0; s < shares; s++) {
+        espsol_worker_destroy(workers[s]);
+        if (err == ESP_OK) {
+            err = jobs[s].err;
+        }
+    }
+    return err;
+}
+
+/* ============================================================================
+ * Seed-Derived Addresses
+ * ========================================================================== */
+
+esp_err_t espsol_token_create_with_seed(
+    const uint8_t base[ESPSOL_PUBKEY_SIZE],
+    const char *seed,
+    const uint8_t owner[ESPSOL_PUBKEY_SIZE],
+    uint8_t address[ESPSOL_PUBKEY_SIZE])
+{
+    if (base == NULL || seed == NULL || owner == NULL || address == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    size_t seed_len = strlen(seed);
+    if (seed_len > ESPSOL_MAX_SEED_LEN) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    /* An owner ending in the marker could make the address collide with a PDA */
+    if (memcmp(owner + ESPSOL_PUBKEY_SIZE - PDA_MARKER_LEN, PDA_MARKER, PDA_MARKER_LEN) == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    /* SHA-256(base || seed || owner) */
+    uint8_t hash_input[ESPSOL_PUBKEY_SIZE + ESPSOL_MAX_SEED_LEN + ESPSOL_PUBKEY_SIZE];
+    size_t offset = 0;
+
+    memcpy(hash_input, base, ESPSOL_PUBKEY_SIZE);
+    offset += ESPSOL_PUBKEY_SIZE;
+    memcpy(hash_input + offset, seed, seed_len);
+    offset += seed_len;
+    memcpy(hash_input + offset, owner, ESPSOL_PUBKEY_SIZE);
+    offset += ESPSOL_PUBKEY_SIZE;
+
+    sha256_hash(hash_input, offset, address);
+    return ESP_OK;
+}
+
 /* ============================================================================
  * Transaction Instructions - Associated Token Account
  * ========================================================================== */
@@ -0,0 +1,460 @@
+/**
+ * @file espsol_transport.c
+ * @brief ESPSOL RPC Record/Replay Transport Implementation
+ *
+ * Recording file format (all integers little-endian):
+ *
+ *   Header:  "ESRR" | u8 version | 3 reserved bytes
+ *   Record:  u32 request_len | u32 response_len | u32 latency_us |
+ *            i32 result | i32 status_code | request | response
+ *
+ * @copyright Copyright (c) 2025 SkyRizz
+ * @license Apache-2.0
+ */
+
+#include "espsol_transport.h"
+#include "espsol_time.h"
+
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+#if defined(ESP_PLATFORM) && ESP_PLATFORM
+#include "esp_log.h"
+static const char *TAG = "espsol_transport";
+#else
+#define ESP_LOGI(tag, ...)
+#define ESP_LOGW(tag, ...)
+#define ESP_LOGE(tag, ...)
+#define ESP_LOGD(tag, ...)
+#endif
+
+#define RECORDING_MAGIC         "ESRR"
+#define RECORDING_VERSION       1
+#define RECORDING_HEADER_SIZE   8
+#define RECORD_HEADER_SIZE      20
+
+/* ============================================================================
+ * Internal Structures
+ * ========================================================================== */
+
+struct espsol_rpc_recorder {
+    FILE *file;                         /**< Output file */
+    espsol_rpc_transport_t inner;       /**< Wrapped transport */
+    size_t count;                       /**< Exchanges recorded */
+    bool write_error;                   /**< A write failed */
+};
+
+/**
+ * @brief One recorded exchange (pointers into the loaded file)
+ */
+typedef struct {
+    const char *request;
+    size_t request_len;
+    const char *response;
+    size_t response_len;
+    uint32_t latency_us;
+    esp_err_t result;
+    int status_code;
+    bool consumed;
+} replay_entry_t;
+
+struct espsol_rpc_replay {
+    uint8_t *data;                      /**< Loaded file contents */
+    replay_entry_t *entries;            /**< Parsed exchanges */
+    size_t entry_count;                 /**< Number of exchanges */
+    size_t remaining;                   /**< Exchanges not yet served */
+    size_t next;                        /**< Next entry (strict order) */
+    espsol_rpc_replay_config_t config;  /**< Replay configuration */
+};
+
+/* ============================================================================
+ * Internal Helper Functions
+ * ========================================================================== */
+
+static void put_u32(uint8_t *p, uint32_t v)
+{
+    for (int i = 0; i < 4; i++) {
+        p[i] = (uint8_t)(v >> (i * 8));
+    }
+}
+
+static uint32_t get_u32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) |
+           ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/**
+ * @brief Locate the top-level "id" member so it can be ignored when matching
+ *
+ * On return [*id_start, *id_end) covers `"id":<value>` and one adjacent
+ * comma. If there is no id member both are set to len.
+ */
+static void find_id_member(const char *s, size_t len, size_t *id_start, size_t *id_end)
+{
+    static const char key[] = "\"id\":";
+    const size_t key_len = sizeof(key) - 1;
+
+    *id_start = len;
+    *id_end = len;
+
+    for (size_t i = 0; i + key_len <= len; i++) {
+        if (memcmp(s + i, key, key_len) != 0) {
+            continue;
+        }
+
+        size_t end = i + key_len;
+        while (end < len && s[end] != ',' && s[end] != '}') {
+            end++;
+        }
+
+        if (end < len && s[end] == ',') {
+            end++;
+        } else if (i > 0 && s[i - 1] == ',') {
+            i--;
+        }
+
+        *id_start = i;
+        *id_end = end;
+        return;
+    }
+}
+
+/**
+ * @brief Compare two requests ignoring their JSON-RPC ids
+ */
+static bool requests_match(const char *a, size_t a_len, const char *b, size_t b_len)
+{
+    size_t a_start, a_end, b_start, b_end;
+    find_id_member(a, a_len, &a_start, &a_end);
+    find_id_member(b, b_len, &b_start, &b_end);
+
+    return a_start == b_start &&
+           a_len - a_end == b_len - b_end &&
+           memcmp(a, b, a_start) == 0 &&
+           memcmp(a + a_end, b + b_end, a_len - a_end) == 0;
+}
+
+/* ============================================================================
+ * Recorder Transport
+ * ========================================================================== */
+
+static esp_err_t recorder_perform(void *ctx,
+                                  const char *request, size_t request_len,
+                                  char *response, size_t response_cap,
+                                  size_t *response_len,
+                                  int *status_code,
+                                  const espsol_deadline_t *deadline)
+{
+    struct espsol_rpc_recorder *rec = ctx;
+
+    *response_len = 0;
+    *status_code = 0;
+
+    int64_t start = espsol_time_us();
+    esp_err_t result = rec->inner.perform(rec->inner.ctx, request, request_len,
+                                          response, response_cap,
+                                          response_len, status_code, deadline);
+    int64_t elapsed = espsol_time_us() - start;
+
+    size_t body_len = (result == ESP_OK) ? *response_len : 0;
+
+    uint8_t header[RECORD_HEADER_SIZE];
+    put_u32(header, (uint32_t)request_len);
+    put_u32(header + 4, (uint32_t)body_len);
+    put_u32(header + 8, elapsed > UINT32_MAX ? UINT32_MAX : (uint32_t)elapsed);
+    put_u32(header + 12, (uint32_t)result);
+    put_u32(header + 16, (uint32_t)*status_code);
+
+    if (fwrite(header, 1, sizeof(header), rec->file) != sizeof(header) ||
+        fwrite(request, 1, request_len, rec->file) != request_len ||
+        fwrite(response, 1, body_len, rec->file) != body_len ||
+        fflush(rec->file) != 0) {
+        rec->write_error = true;
+        ESP_LOGE(TAG, "Failed to write recording");
+    } else {
+        rec->count++;
+    }
+
+    return result;
+}
+
+esp_err_t espsol_rpc_recorder_create(const char *path,
+                                      const espsol_rpc_transport_t *inner,
+                                      espsol_rpc_recorder_handle_t *recorder)
+{
+    if (!path || !inner || !inner->perform || !recorder) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    struct espsol_rpc_recorder *rec = calloc(1, sizeof(struct espsol_rpc_recorder));
+    if (!rec) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    rec->file = fopen(path, "wb");
+    if (!rec->file) {
+        ESP_LOGE(TAG, "Failed to open %s", path);
+        free(rec);
+        return ESP_FAIL;
+    }
+
+    uint8_t header[RECORDING_HEADER_SIZE] = { 'E', 'S', 'R', 'R', RECORDING_VERSION, 0, 0, 0 };
+    if (fwrite(header, 1, sizeof(header), rec->file) != sizeof(header)) {
+        fclose(rec->file);
+        free(rec);
+        return ESP_FAIL;
+    }
+
+    rec->inner = *inner;
+    *recorder = rec;
+    return ESP_OK;
+}
+
+esp_err_t espsol_rpc_recorder_get_transport(espsol_rpc_recorder_handle_t recorder,
+                                             espsol_rpc_transport_t *transport)
+{
+    if (!recorder || !transport) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    transport->perform = recorder_perform;
+    transport->perform_stream = NULL;
+    transport->ctx = recorder;
+    return ESP_OK;
+}
+
+esp_err_t espsol_rpc_recorder_get_count(espsol_rpc_recorder_handle_t recorder,
+                                         size_t *count)
+{
+    if (!recorder || !count) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    *count = recorder->count;
+    return ESP_OK;
+}
+
+esp_err_t espsol_rpc_recorder_destroy(espsol_rpc_recorder_handle_t recorder)
+{
+    if (!recorder) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    bool failed = recorder->write_error;
+    if (fclose(recorder->file) != 0) {
+        failed = true;
+    }
+    free(recorder);
+
+    return failed ? ESP_FAIL : ESP_OK;
+}
+
+/* ============================================================================
+ * Replay Transport
+ * ========================================================================== */
+
+static esp_err_t replay_perform(void *ctx,
+                                const char *request, size_t request_len,
+                                char *response, size_t response_cap,
+                                size_t *response_len,
+                                int *status_code,
+                                const espsol_deadline_t *deadline)
+{
+    struct espsol_rpc_replay *replay = ctx;
+    replay_entry_t *entry = NULL;
+
+    *response_len = 0;
+    *status_code = 0;
+
+    if (replay->config.strict_order) {
+        if (replay->next < replay->entry_count) {
+            replay_entry_t *candidate = &replay->entries[replay->next];
+            if (requests_match(candidate->request, candidate->request_len,
+                               request, request_len)) {
+                entry = candidate;
+                replay->next++;
+            }
+        }
+    } else {
+        for (size_t i = 0; i < replay->entry_count; i++) {
+            replay_entry_t *candidate = &replay->entries[i];
+            if (!candidate->consumed &&
+                requests_match(candidate->request, candidate->request_len,
+                               request, request_len)) {
+                entry = candidate;
+                break;
+            }
+        }
+    }
+
+    if (!entry) {
+        ESP_LOGE(TAG, "No recorded exchange for request: %.*s", (int)request_len, request);
+        return ESP_ERR_ESPSOL_RPC_FAILED;
+    }
+
+    entry->consumed = true;
+    replay->remaining--;
+
+    uint64_t delay_us = (uint64_t)entry->latency_us * replay->config.latency_percent / 100 +
+                        (uint64_t)replay->config.added_latency_ms * 1000;
+    esp_err_t err = espsol_deadline_sleep(deadline, (uint32_t)((delay_us + 999) / 1000));
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    *status_code = entry->status_code;
+
+    if (entry->result != ESP_OK) {
+        return entry->result;
+    }
+
+    if (entry->response_len > response_cap) {
+        return ESP_ERR_ESPSOL_BUFFER_TOO_SMALL;
+    }
+
+    memcpy(response, entry->response, entry->response_len);
+    *response_len = entry->response_len;
+    return ESP_OK;
+}
+
+esp_err_t espsol_rpc_replay_create(const char *path,
+                                    const espsol_rpc_replay_config_t *config,
+                                    espsol_rpc_replay_handle_t *replay)
+{
+    if (!path || !replay) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    FILE *file = fopen(path, "rb");
+    if (!file) {
+        ESP_LOGE(TAG, "Failed to open %s", path);
+        return ESP_FAIL;
+    }
+
+    /* Load the whole recording */
+    long file_size = -1;
+    if (fseek(file, 0, SEEK_END) == 0) {
+        file_size = ftell(file);
+    }
+    if (file_size < RECORDING_HEADER_SIZE || fseek(file, 0, SEEK_SET) != 0) {
+        fclose(file);
+        return ESP_FAIL;
+    }
+
+    struct espsol_rpc_replay *r = calloc(1, sizeof(struct espsol_rpc_replay));
+    if (!r) {
+        fclose(file);
+        return ESP_ERR_NO_MEM;
+    }
+
+    r->data = malloc((size_t)file_size);
+    if (!r->data) {
+        fclose(file);
+        free(r);
+        return ESP_ERR_NO_MEM;
+    }
+
+    size_t size = fread(r->data, 1, (size_t)file_size, file);
+    fclose(file);
+
+    if (size != (size_t)file_size ||
+        memcmp(r->data, RECORDING_MAGIC, 4) != 0 ||
+        r->data[4] != RECORDING_VERSION) {
+        ESP_LOGE(TAG, "Invalid recording %s", path);
+        espsol_rpc_replay_destroy(r);
+        return ESP_FAIL;
+    }
+
+    /* First pass: count and validate records */
+    size_t offset = RECORDING_HEADER_SIZE;
+    size_t count = 0;
+    while (offset < size) {
+        if (size - offset < RECORD_HEADER_SIZE) {
+            espsol_rpc_replay_destroy(r);
+            return ESP_FAIL;
+        }
+        uint64_t body = (uint64_t)get_u32(r->data + offset) + get_u32(r->data + offset + 4);
+        offset += RECORD_HEADER_SIZE;
+        if (body > size - offset) {
+            espsol_rpc_replay_destroy(r);
+            return ESP_FAIL;
+        }
+        offset += (size_t)body;
+        count++;
+    }
+
+    if (count > 0) {
+        r->entries = calloc(count, sizeof(replay_entry_t));
+        if (!r->entries) {
+            espsol_rpc_replay_destroy(r);
+            return ESP_ERR_NO_MEM;
+        }
+    }
+
+    /* Second pass: index records */
+    offset = RECORDING_HEADER_SIZE;
+    for (size_t i = 0; i < count; i++) {
+        const uint8_t *h = r->data + offset;
+        replay_entry_t *e = &r->entries[i];
+
+        e->request_len = get_u32(h);
+        e->response_len = get_u32(h + 4);
+        e->latency_us = get_u32(h + 8);
+        e->result = (esp_err_t)(int32_t)get_u32(h + 12);
+        e->status_code = (int)(int32_t)get_u32(h + 16);
+
+        offset += RECORD_HEADER_SIZE;
+        e->request = (const char *)(r->data + offset);
+        offset += e->request_len;
+        e->response = (const char *)(r->data + offset);
+        offset += e->response_len;
+    }
+
+    r->entry_count = count;
+    r->remaining = count;
+
+    espsol_rpc_replay_config_t defaults = ESPSOL_RPC_REPLAY_CONFIG_DEFAULT();
+    r->config = config ? *config : defaults;
+
+    ESP_LOGI(TAG, "Loaded %u exchanges from %s", (unsigned)count, path);
+    *replay = r;
+    return ESP_OK;
+}
+
+esp_err_t espsol_rpc_replay_get_transport(espsol_rpc_replay_handle_t replay,
+                                           espsol_rpc_transport_t *transport)
+{
+    if (!replay || !transport) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    transport->perform = replay_perform;
+    transport->perform_stream = NULL;
+    transport->ctx = replay;
+    return ESP_OK;
+}
+
+esp_err_t espsol_rpc_replay_get_remaining(espsol_rpc_replay_handle_t replay,
+                                           size_t *count)
+{
+    if (!replay || !count) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    *count = replay->remaining;
+    return ESP_OK;
+}
+
+esp_err_t espsol_rpc_replay_destroy(espsol_rpc_replay_handle_t replay)
+{
+    if (!replay) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    free(replay->entries);
+    free(replay->data);
+    free(replay);
+    return ESP_OK;
+}
@@ -10,14 +10,17 @@
  */
 
 #include "espsol_tx.h"
+#include "espsol_tx_internal.h"
 #include "espsol_utils.h"
 #include "espsol_crypto.h"
+#include "espsol_fee.h"
 
 #include <string.h>
 #include <stdlib.h>
 
 #if defined(ESP_PLATFORM) && ESP_PLATFORM
 #include "esp_log.h"
+#include "sdkconfig.h"
 #else
 #define ESP_LOGI(tag, ...)
 #define ESP_LOGW(tag, ...)
@@ -25,6 +28,30 @@
 #define ESP_LOGD(tag, ...)
 #endif
 
+/* Host builds always include versioned transaction support */
+#if !(defined(ESP_PLATFORM) && ESP_PLATFORM) || defined(CONFIG_ESPSOL_ENABLE_VERSIONED_TX)
+#define ESPSOL_VERSIONED_TX 1
+#else
+#define ESPSOL_VERSIONED_TX 0
+#endif
+
+/* Priority fee set on every new transaction (micro-lamports per compute unit) */
+#ifdef CONFIG_ESPSOL_DEFAULT_PRIORITY_FEE
+#define DEFAULT_PRIORITY_FEE CONFIG_ESPSOL_DEFAULT_PRIORITY_FEE
+#else
+#define DEFAULT_PRIORITY_FEE 0
+#endif
+
+/* Host builds always include durable nonce support */
+#if !(defined(ESP_PLATFORM) && ESP_PLATFORM) || defined(CONFIG_ESPSOL_ENABLE_DURABLE_NONCES)
+#define ESPSOL_DURABLE_NONCES 1
+#else
+#define ESPSOL_DURABLE_NONCES 0
+#endif
+
+/** Version prefix bit of a versioned message */
+#define MESSAGE_VERSION_PREFIX  0x80
+
 static const char *TAG = "espsol_tx";
 
 /* ============================================================================
@@ -58,32 +85,91 @@ const uint8_t ESPSOL_MEMO_PROGRAM_ID[ESPSOL_PUBKEY_SIZE] = {
     0xe4, 0x1f, 0xa8, 0x40, 0x41, 0x05, 0x44, 0x8d
 };
 
+/* Compute Budget Program: ComputeBudget111111111111111111111111111111 */
+const uint8_t ESPSOL_COMPUTE_BUDGET_PROGRAM_ID[ESPSOL_PUBKEY_SIZE] = {
+    0x03, 0x06, 0x46, 0x6f, 0xe5, 0x21, 0x17, 0x32,
+    0xff, 0xec, 0xad, 0xba, 0x72, 0xc3, 0x9b, 0xe7,
+    0xbc, 0x8c, 0xe5, 0xbb, 0xc5, 0xf7, 0x12, 0x6b,
+    0x2c, 0x43, 0x9b, 0x3a, 0x40, 0x00, 0x00, 0x00
+};
+
+/* RecentBlockhashes sysvar: SysvarRecentB1ockHashes11111111111111111111 */
+const uint8_t ESPSOL_RECENT_BLOCKHASHES_SYSVAR_ID[ESPSOL_PUBKEY_SIZE] = {
+    0x06, 0xa7, 0xd5, 0x17, 0x19, 0x2c, 0x56, 0x8e,
+    0xe0, 0x8a, 0x84, 0x5f, 0x73, 0xd2, 0x97, 0x88,
+    0xcf, 0x03, 0x5c, 0x31, 0x45, 0xb2, 0x1a, 0xb3,
+    0x44, 0xd8, 0x06, 0x2e, 0xa9, 0x40, 0x00, 0x00
+};
+
+/* Rent sysvar: SysvarRent111111111111111111111111111111111 */
+const uint8_t ESPSOL_RENT_SYSVAR_ID[ESPSOL_PUBKEY_SIZE] = {
+    0x06, 0xa7, 0xd5, 0x17, 0x19, 0x2c, 0x5c, 0x51,
+    0x21, 0x8c, 0xc9, 0x4c, 0x3d, 0x4a, 0xf1, 0x7f,
+    0x58, 0xda, 0xee, 0x08, 0x9b, 0xa1, 0xfd, 0x44,
+    0xe3, 0xdb, 0xd9, 0x8a, 0x00, 0x00, 0x00, 0x00
+};
+
 /* ============================================================================
  * Internal Structures
  * ========================================================================== */
 
+/* Key flags */
+#define KEY_SIGNER      0x01    /**< Signs in some instruction */
+#define KEY_WRITABLE    0x02    /**< Writable in some instruction */
+#define KEY_INVOKED     0x04    /**< Invoked as a program */
+#define KEY_USED        0x08    /**< Referenced by an instruction */
+
+/** Arena size of a new transaction's first allocation */
+#define TX_ARENA_INITIAL    256
+
+/** Smallest arena accepted for a static transaction */
+#define TX_STATIC_MIN_ARENA 128
+
+/** Slots in the key index; a power of two, kept at most half full */
+#define TX_KEY_INDEX_SIZE   (ESPSOL_MAX_LOADED_ACCOUNTS * 2)
+
+/** Account priority buckets, in message order */
+#define TX_BUCKET_COUNT     4
+
+/** Position groups once lookups are applied (static, then writable and read-only per table) */
+#define TX_LOOKUP_RANKS     (1 + 2 * ESPSOL_MAX_LOOKUP_TABLES)
+
 /**
- * @brief Internal instruction structure
+ * @brief Key table entry
+ *
+ * Every account referenced by the transaction appears once in the key
+ * table. Instructions refer to accounts by their key table index.
  */
 typedef struct {
-    uint8_t program_id[ESPSOL_PUBKEY_SIZE];
-    espsol_account_meta_t accounts[ESPSOL_MAX_ACCOUNTS];
-    size_t account_count;
-    uint8_t data[ESPSOL_MAX_INSTRUCTION_DATA];
-    size_t data_len;
-} espsol_instruction_t;
+    uint8_t pubkey[ESPSOL_PUBKEY_SIZE];
+    uint8_t flags;              /**< KEY_* flags merged over all instructions */
+    uint8_t position;           /**< Index in the compiled account list */
+    uint8_t at;                 /**< Key at compiled position equal to this entry's index */
+    int8_t lookup_table;        /**< Table the account is loaded from (-1 = static key) */
+    uint8_t lookup_index;       /**< Index within that table */
+} tx_key_t;
 
 /**
- * @brief Internal account entry for deduplication
+ * @brief Instruction record
+ *
+ * Followed in the arena by account_count key indices and data_len bytes
+ * of instruction data, padded to an even length.
  */
 typedef struct {
-    uint8_t pubkey[ESPSOL_PUBKEY_SIZE];
-    bool is_signer;
-    bool is_writable;
-} espsol_account_entry_t;
+    uint8_t program;            /**< Key index of the program */
+    uint8_t reserved;
+    uint16_t account_count;     /**< Number of account references */
+    uint16_t data_len;          /**< Length of instruction data */
+} tx_ix_t;
 
 /**
  * @brief Internal transaction structure
+ *
+ * Instructions, keys and signatures share one arena. Instruction records
+ * grow up from the start of the arena, the signature slots follow the
+ * last record, and the key table grows down from the end. Once sealed,
+ * the serialized message sits right after the signature slots. A heap
+ * arena grows on demand; a static one is fixed.
  */
 struct espsol_transaction {
     /* Fee payer (first signer) */
@@ -93,20 +179,39 @@ struct espsol_transaction {
     /* Recent blockhash */
     uint8_t blockhash[ESPSOL_BLOCKHASH_SIZE];
     bool has_blockhash;
+    bool has_nonce;             /**< Blockhash is a durable nonce advanced by instruction 0 */
     
-    /* Instructions */
-    espsol_instruction_t instructions[ESPSOL_MAX_INSTRUCTIONS];
-    size_t instruction_count;
+    /* Message version and address lookup tables */
+    espsol_tx_version_t version;
+    espsol_lookup_table_t lookup_tables[ESPSOL_MAX_LOOKUP_TABLES];
+    size_t lookup_table_count;
     
-    /* Deduplicated accounts (built during serialization) */
-    espsol_account_entry_t accounts[ESPSOL_MAX_ACCOUNTS];
-    size_t account_count;
+    /* Arena */
+    uint8_t *arena;
+    size_t arena_cap;
+    bool is_static;             /**< Handle and arena live in a caller buffer */
     
-    /* Signatures */
-    uint8_t signatures[ESPSOL_MAX_SIGNERS][ESPSOL_SIGNATURE_SIZE];
-    uint8_t signer_pubkeys[ESPSOL_MAX_SIGNERS][ESPSOL_PUBKEY_SIZE];
-    size_t signer_count;
+    /* Arena contents */
+    size_t records_len;         /**< Bytes of instruction records */
+    size_t instruction_count;
+    size_t key_count;
+    size_t wire_len;            /**< Wire bytes of all instructions */
+    size_t used_keys;           /**< Keys referenced by an instruction */
+    size_t signer_keys;         /**< Keys that sign in some instruction */
+    size_t sig_slots;           /**< Signature slots after the records */
+    size_t signer_count;        /**< Highest signed slot + 1 */
+    size_t message_len;         /**< Sealed message bytes after the signature slots (0 = not sealed) */
+    
+    /* Open-addressing index over the key table (key index + 1, 0 = empty) */
+    uint8_t key_index[TX_KEY_INDEX_SIZE];
+    
+    /* Compiled account list: static keys first, then writable and
+     * read-only accounts loaded from lookup tables */
+    size_t account_count;
+    size_t static_count;
     size_t required_signers;
+    size_t readonly_signed;     /**< Read-only signers among the static keys */
+    size_t readonly_unsigned;   /**< Read-only non-signers among the static keys */
     
     /* State */
     bool is_signed;
@@ -127,109 +232,366 @@ static bool pubkey_equals(const uint8_t a[ESPSOL_PUBKEY_SIZE],
 }
 
 /**
- * @brief Find or add account to the deduplicated list
- * @return Account index, or -1 if list is full
+ * @brief Get a key table entry
  */
-static int find_or_add_account(struct espsol_transaction *tx,
-                               const uint8_t pubkey[ESPSOL_PUBKEY_SIZE],
-                               bool is_signer,
-                               bool is_writable)
+static tx_key_t *key_at(const struct espsol_transaction *tx, size_t index)
 {
-    /* Search for existing account */
-    for (size_t i = 0; i < tx->account_count; i++) {
-        if (pubkey_equals(tx->accounts[i].pubkey, pubkey)) {
-            /* Update flags (merge with more permissive) */
-            tx->accounts[i].is_signer = tx->accounts[i].is_signer || is_signer;
-            tx->accounts[i].is_writable = tx->accounts[i].is_writable || is_writable;
-            return (int)i;
-        }
+    return (tx_key_t *)(tx->arena + tx->arena_cap - (index + 1) * sizeof(tx_key_t));
+}
+
+/**
+ * @brief Get the next instruction record
+ * @param offset In: record offset; out: offset of the following record
+ */
+static const tx_ix_t *next_record(const struct espsol_transaction *tx, size_t *offset,
+                                  const uint8_t **accounts, const uint8_t **data)
+{
+    const tx_ix_t *ix = (const tx_ix_t *)(tx->arena + *offset);
+    const uint8_t *body = tx->arena + *offset + sizeof(tx_ix_t);
+    
+    if (accounts) {
+        *accounts = body;
+    }
+    if (data) {
+        *data = body + ix->account_count;
+    }
+    *offset += (sizeof(tx_ix_t) + ix->account_count + ix->data_len + 1) & ~(size_t)1;
+    return ix;
+}
+
+static uint8_t *signature_slot(const struct espsol_transaction *tx, size_t index)
+{
+    return tx->arena + tx->records_len + index * ESPSOL_SIGNATURE_SIZE;
+}
+
+/**
+ * @brief Get the sealed message, or where it will be written
+ */
+static uint8_t *sealed_message(const struct espsol_transaction *tx)
+{
+    return signature_slot(tx, tx->sig_slots);
+}
+
+/**
+ * @brief Drop the sealed message and signatures, keeping compiled accounts
+ */
+static void unseal(struct espsol_transaction *tx)
+{
+    tx->is_signed = false;
+    tx->sig_slots = 0;
+    tx->signer_count = 0;
+    tx->message_len = 0;
+}
+
+/**
+ * @brief Mark the message changed, dropping compiled state and signatures
+ */
+static void invalidate(struct espsol_transaction *tx)
+{
+    tx->accounts_compiled = false;
+    unseal(tx);
+}
+
+/**
+ * @brief Bytes left between the used front of the arena and the key table
+ */
+static size_t arena_free(const struct espsol_transaction *tx)
+{
+    size_t used = tx->records_len + tx->sig_slots * ESPSOL_SIGNATURE_SIZE +
+                  tx->message_len + tx->key_count * sizeof(tx_key_t);
+    return tx->arena_cap - used;
+}
+
+/**
+ * @brief Make room for needed more bytes in the arena
+ */
+static esp_err_t arena_reserve(struct espsol_transaction *tx, size_t needed)
+{
+    size_t keys_len = tx->key_count * sizeof(tx_key_t);
+    size_t used = tx->arena_cap - arena_free(tx);
+    
+    if (tx->arena_cap - used >= needed) {
+        return ESP_OK;
+    }
+    if (tx->is_static) {
+        ESP_LOGE(TAG, "Static transaction buffer full");
+        return ESP_ERR_NO_MEM;
+    }
+    
+    size_t cap = tx->arena_cap ? tx->arena_cap : TX_ARENA_INITIAL;
+    while (cap - used < needed) {
+        cap *= 2;
+    }
+    
+    uint8_t *arena = realloc(tx->arena, cap);
+    if (!arena) {
+        ESP_LOGE(TAG, "Failed to grow transaction arena");
+        return ESP_ERR_NO_MEM;
+    }
+    
+    /* The key table stays at the end */
+    memmove(arena + cap - keys_len, arena + tx->arena_cap - keys_len, keys_len);
+    tx->arena = arena;
+    tx->arena_cap = cap;
+    return ESP_OK;
+}
+
+/**
+ * @brief FNV-1a hash of a public key
+ */
+static uint32_t hash_pubkey(const uint8_t pubkey[ESPSOL_PUBKEY_SIZE])
+{
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < ESPSOL_PUBKEY_SIZE; i++) {
+        h = (h ^ pubkey[i]) * 16777619u;
+    }
+    return h;
+}
+
+/**
+ * @brief Find the key index slot for a public key
+ * @return Slot holding the key, or the empty slot ending its probe sequence
+ */
+static size_t index_slot(const struct espsol_transaction *tx, const uint8_t pubkey[ESPSOL_PUBKEY_SIZE])
+{
+    size_t pos = hash_pubkey(pubkey) & (TX_KEY_INDEX_SIZE - 1);
+    
+    while (tx->key_index[pos] != 0 &&
+           !pubkey_equals(key_at(tx, tx->key_index[pos] - 1)->pubkey, pubkey)) {
+        pos = (pos + 1) & (TX_KEY_INDEX_SIZE - 1);
+    }
+    return pos;
+}
+
+/**
+ * @brief Find a key in the key table
+ * @return Key index, or -1 if not found
+ */
+static int find_key(const struct espsol_transaction *tx, const uint8_t pubkey[ESPSOL_PUBKEY_SIZE])
+{
+    return (int)tx->key_index[index_slot(tx, pubkey)] - 1;
+}
+
+/**
+ * @brief Find a key, appending it with no flags if missing
+ *
+ * The caller reserves arena space for the key beforehand.
+ * @return Key index, or -1 if the key table is full
+ */
+static int intern_key(struct espsol_transaction *tx, const uint8_t pubkey[ESPSOL_PUBKEY_SIZE])
+{
+    size_t slot = index_slot(tx, pubkey);
+    if (tx->key_index[slot] != 0) {
+        return (int)tx->key_index[slot] - 1;
     }
     
-    /* Add new account */
-    if (tx->account_count >= ESPSOL_MAX_ACCOUNTS) {
+    if (tx->key_count >= ESPSOL_MAX_LOADED_ACCOUNTS) {
         return -1;
     }
     
-    memcpy(tx->accounts[tx->account_count].pubkey, pubkey, ESPSOL_PUBKEY_SIZE);
-    tx->accounts[tx->account_count].is_signer = is_signer;
-    tx->accounts[tx->account_count].is_writable = is_writable;
+    tx_key_t *key = key_at(tx, tx->key_count);
+    memset(key, 0, sizeof(*key));
+    memcpy(key->pubkey, pubkey, ESPSOL_PUBKEY_SIZE);
+    tx->key_index[slot] = (uint8_t)(tx->key_count + 1);
+    return (int)tx->key_count++;
+}
+
+/**
+ * @brief Merge instruction flags into a key, keeping the running counts
+ */
+static void merge_flags(struct espsol_transaction *tx, tx_key_t *key, uint8_t flags)
+{
+    uint8_t added = flags & ~key->flags;
+    if (added & KEY_USED) {
+        tx->used_keys++;
+    }
+    if (added & KEY_SIGNER) {
+        tx->signer_keys++;
+    }
+    key->flags |= flags;
+}
+
+/**
+ * @brief Effective flags of a key, counting the fee payer as a writable signer
+ */
+static uint8_t key_flags(const struct espsol_transaction *tx, const tx_key_t *key)
+{
+    uint8_t flags = key->flags;
+    if (tx->has_fee_payer && pubkey_equals(key->pubkey, tx->fee_payer)) {
+        flags |= KEY_USED | KEY_SIGNER | KEY_WRITABLE;
+    }
+    return flags;
+}
+
+/**
+ * @brief Stable partition of accounts by rank
+ *
+ * Accounts keep their relative order within a rank, so accounts of the
+ * same priority stay in order of first use, as web3.js orders them.
+ */
+static void partition_accounts(uint8_t *order, const uint8_t *ranks, size_t count,
+                               size_t rank_count)
+{
+    size_t starts[TX_LOOKUP_RANKS + 1] = {0};
+    uint8_t sorted[ESPSOL_MAX_LOADED_ACCOUNTS];
+    
+    for (size_t i = 0; i < count; i++) {
+        starts[ranks[i] + 1]++;
+    }
+    for (size_t r = 1; r <= rank_count; r++) {
+        starts[r] += starts[r - 1];
+    }
+    for (size_t i = 0; i < count; i++) {
+        sorted[starts[ranks[i]]++] = order[i];
+    }
+    memcpy(order, sorted, count);
+}
+
+/**
+ * @brief Position group of a compiled account
+ *
+ * Static keys come first, then writable accounts loaded from each table
+ * in table order, then read-only accounts loaded from each table.
+ */
+static int lookup_rank(const struct espsol_transaction *tx, const tx_key_t *key)
+{
+    if (key->lookup_table < 0) {
+        return 0;
+    }
+    bool writable = (key_flags(tx, key) & KEY_WRITABLE) != 0;
+    return 1 + key->lookup_table + (writable ? 0 : ESPSOL_MAX_LOOKUP_TABLES);
+}
+
+/**
+ * @brief Move accounts found in lookup tables behind the static keys
+ *
+ * Signers and invoked programs must stay static. Every other account is
+ * loaded from the first table that holds it.
+ */
+static void compile_lookups(struct espsol_transaction *tx, uint8_t *order)
+{
+    size_t static_count = 0;
+    uint8_t ranks[ESPSOL_MAX_LOADED_ACCOUNTS];
+    
+    for (size_t i = 0; i < tx->account_count; i++) {
+        tx_key_t *key = key_at(tx, order[i]);
+        
+        if (!(key_flags(tx, key) & (KEY_SIGNER | KEY_INVOKED))) {
+            for (size_t t = 0; t < tx->lookup_table_count && key->lookup_table < 0; t++) {
+                const espsol_lookup_table_t *table = &tx->lookup_tables[t];
+                for (size_t k = 0; k < table->address_count; k++) {
+                    if (pubkey_equals(table->addresses[k], key->pubkey)) {
+                        key->lookup_table = (int8_t)t;
+                        key->lookup_index = (uint8_t)k;
+                        break;
+                    }
+                }
+            }
+        }
+        
+        if (key->lookup_table < 0) {
+            static_count++;
+        }
+        ranks[i] = (uint8_t)lookup_rank(tx, key);
+    }
+    
+    /* A stable partition keeps the static key order intact */
+    partition_accounts(order, ranks, tx->account_count, TX_LOOKUP_RANKS);
     
-    return (int)tx->account_count++;
+    tx->static_count = static_count;
 }
 
 /**
- * @brief Compile accounts from instructions (deduplication and ordering)
+ * @brief Compile accounts from the key table (ordering and lookups)
  *
  * Solana account ordering:
  * 1. Writable signers
  * 2. Read-only signers
  * 3. Writable non-signers
  * 4. Read-only non-signers
+ *
+ * The fee payer comes first; other accounts keep their order of first
+ * use within each group.
  */
-static esp_err_t compile_accounts(struct espsol_transaction *tx)
+static esp_err_t build_accounts(struct espsol_transaction *tx)
 {
     if (tx->accounts_compiled) {
         return ESP_OK;
     }
     
     tx->account_count = 0;
+    tx->static_count = 0;
     tx->required_signers = 0;
     
-    /* Add fee payer first (always writable signer) */
+    /* The fee payer is always part of the message, first */
+    uint8_t order[ESPSOL_MAX_LOADED_ACCOUNTS];
+    int payer = -1;
     if (tx->has_fee_payer) {
-        if (find_or_add_account(tx, tx->fee_payer, true, true) < 0) {
+        esp_err_t err = arena_reserve(tx, sizeof(tx_key_t));
+        if (err != ESP_OK) {
+            return err;
+        }
+        payer = intern_key(tx, tx->fee_payer);
+        if (payer < 0) {
             return ESP_ERR_ESPSOL_MAX_ACCOUNTS;
         }
+        order[tx->account_count++] = (uint8_t)payer;
     }
     
-    /* Add all accounts from instructions */
+    /* Then every referenced key in order of first use in the message;
+     * instructions can be inserted ahead of older ones, so walk them */
+    uint64_t seen = payer >= 0 ? (uint64_t)1 << payer : 0;
+    for (size_t i = 0; i < tx->key_count; i++) {
+        key_at(tx, i)->lookup_table = -1;
+    }
+    size_t record = 0;
     for (size_t i = 0; i < tx->instruction_count; i++) {
-        espsol_instruction_t *ix = &tx->instructions[i];
-        
-        /* Add program ID (read-only, non-signer) */
-        if (find_or_add_account(tx, ix->program_id, false, false) < 0) {
-            return ESP_ERR_ESPSOL_MAX_ACCOUNTS;
-        }
+        const uint8_t *accounts;
+        const tx_ix_t *ix = next_record(tx, &record, &accounts, NULL);
         
-        /* Add instruction accounts */
-        for (size_t j = 0; j < ix->account_count; j++) {
-            if (find_or_add_account(tx, ix->accounts[j].pubkey,
-                                    ix->accounts[j].is_signer,
-                                    ix->accounts[j].is_writable) < 0) {
-                return ESP_ERR_ESPSOL_MAX_ACCOUNTS;
+        for (size_t a = 0; a <= ix->account_count; a++) {
+            uint8_t index = a == 0 ? ix->program : accounts[a - 1];
+            if (!(seen & ((uint64_t)1 << index))) {
+                seen |= (uint64_t)1 << index;
+                order[tx->account_count++] = index;
             }
         }
     }
     
-    /* Sort accounts: signers first, then writable, then read-only */
-    /* Using simple bubble sort since max accounts is small */
+    /* Partition accounts: signers first, then writable, then read-only */
+    uint8_t ranks[ESPSOL_MAX_LOADED_ACCOUNTS];
     for (size_t i = 0; i < tx->account_count; i++) {
-        for (size_t j = i + 1; j < tx->account_count; j++) {
-            bool swap = false;
-            
-            /* Priority: signer+writable > signer+readonly > writable > readonly */
-            int priority_i = (tx->accounts[i].is_signer ? 2 : 0) +
-                            (tx->accounts[i].is_writable ? 1 : 0);
-            int priority_j = (tx->accounts[j].is_signer ? 2 : 0) +
-                            (tx->accounts[j].is_writable ? 1 : 0);
-            
-            if (priority_j > priority_i) {
-                swap = true;
-            }
-            
-            if (swap) {
-                espsol_account_entry_t tmp = tx->accounts[i];
-                tx->accounts[i] = tx->accounts[j];
-                tx->accounts[j] = tmp;
+        uint8_t flags = key_flags(tx, key_at(tx, order[i]));
+        ranks[i] = (uint8_t)(((flags & KEY_SIGNER) ? 0 : 2) + ((flags & KEY_WRITABLE) ? 0 : 1));
+        if (flags & KEY_SIGNER) {
+            tx->required_signers++;
+        }
+    }
+    partition_accounts(order, ranks, tx->account_count, TX_BUCKET_COUNT);
+    
+    tx->static_count = tx->account_count;
+    if (tx->lookup_table_count > 0) {
+        compile_lookups(tx, order);
+    }
+    
+    /* Header counts cover the static keys only */
+    tx->readonly_signed = 0;
+    tx->readonly_unsigned = 0;
+    for (size_t i = 0; i < tx->static_count; i++) {
+        uint8_t flags = key_flags(tx, key_at(tx, order[i]));
+        if (!(flags & KEY_WRITABLE)) {
+            if (flags & KEY_SIGNER) {
+                tx->readonly_signed++;
+            } else {
+                tx->readonly_unsigned++;
             }
         }
     }
     
-    /* Count required signers */
+    /* Instructions refer to key indices; resolve them to positions once */
     for (size_t i = 0; i < tx->account_count; i++) {
-        if (tx->accounts[i].is_signer) {
-            tx->required_signers++;
-        }
+        key_at(tx, order[i])->position = (uint8_t)i;
+        key_at(tx, i)->at = order[i];
     }
     
     tx->accounts_compiled = true;
@@ -237,17 +599,27 @@ static esp_err_t compile_accounts(struct espsol_transaction *tx)
 }
 
 /**
- * @brief Find account index in compiled list
+ * @brief Build the account list and check that the static keys fit
  */
-static int find_account_index(struct espsol_transaction *tx,
-                              const uint8_t pubkey[ESPSOL_PUBKEY_SIZE])
+static esp_err_t compile_accounts(struct espsol_transaction *tx)
 {
-    for (size_t i = 0; i < tx->account_count; i++) {
-        if (pubkey_equals(tx->accounts[i].pubkey, pubkey)) {
-            return (int)i;
-        }
+    esp_err_t err = build_accounts(tx);
+    if (err != ESP_OK) {
+        return err;
     }
-    return -1;
+    
+    if (tx->static_count > ESPSOL_MAX_ACCOUNTS) {
+        return ESP_ERR_ESPSOL_MAX_ACCOUNTS;
+    }
+    return ESP_OK;
+}
+
+/**
+ * @brief Get the compiled account at a position
+ */
+static const tx_key_t *account_at(const struct espsol_transaction *tx, size_t position)
+{
+    return key_at(tx, key_at(tx, position)->at);
 }
 
 /**
@@ -271,6 +643,23 @@ static size_t write_compact_u16(uint8_t *buffer, uint16_t value)
     }
 }
 
+/**
+ * @brief Length of a compact-u16 encoding
+ */
+static size_t compact_u16_len(size_t value)
+{
+    return value < 0x80 ? 1 : (value < 0x4000 ? 2 : 3);
+}
+
+/**
+ * @brief Wire bytes of an instruction: program index, accounts and data
+ */
+static size_t instruction_wire_len(size_t account_count, size_t data_len)
+{
+    return 1 + compact_u16_len(account_count) + account_count +
+           compact_u16_len(data_len) + data_len;
+}
+
 /**
  * @brief Serialize the transaction message (for signing)
  */
@@ -290,42 +679,34 @@ static esp_err_t serialize_message(struct espsol_transaction *tx,
     
     size_t offset = 0;
     
-    /* Message header (3 bytes) */
-    /* num_required_signatures */
-    uint8_t num_readonly_signed = 0;
-    uint8_t num_readonly_unsigned = 0;
-    
-    /* Count read-only accounts */
-    for (size_t i = 0; i < tx->account_count; i++) {
-        if (!tx->accounts[i].is_writable) {
-            if (tx->accounts[i].is_signer) {
-                num_readonly_signed++;
-            } else {
-                num_readonly_unsigned++;
-            }
-        }
+    /* Version prefix (0x80 | version) */
+    if (tx->version == ESPSOL_TX_VERSION_0) {
+        if (offset + 1 > buffer_len) return ESP_ERR_ESPSOL_BUFFER_TOO_SMALL;
+        buffer[offset++] = MESSAGE_VERSION_PREFIX;
     }
     
+    /* Message header (3 bytes) */
     if (offset + 3 > buffer_len) return ESP_ERR_ESPSOL_BUFFER_TOO_SMALL;
     buffer[offset++] = (uint8_t)tx->required_signers;
-    buffer[offset++] = num_readonly_signed;
-    buffer[offset++] = num_readonly_unsigned;
+    buffer[offset++] = (uint8_t)tx->readonly_signed;
+    buffer[offset++] = (uint8_t)tx->readonly_unsigned;
     
     /* Account addresses (compact array) */
-    size_t compact_len = write_compact_u16(buffer + offset, (uint16_t)tx->account_count);
+    if (offset + 3 > buffer_len) return ESP_ERR_ESPSOL_BUFFER_TOO_SMALL;
+    size_t compact_len = write_compact_u16(buffer + offset, (uint16_t)tx->static_count);
     offset += compact_len;
     
-    if (offset + tx->account_count * ESPSOL_PUBKEY_SIZE > buffer_len) {
+    if (offset + tx->static_count * ESPSOL_PUBKEY_SIZE > buffer_len) {
         return ESP_ERR_ESPSOL_BUFFER_TOO_SMALL;
     }
     
-    for (size_t i = 0; i < tx->account_count; i++) {
-        memcpy(buffer + offset, tx->accounts[i].pubkey, ESPSOL_PUBKEY_SIZE);
+    for (size_t i = 0; i < tx->static_count; i++) {
+        memcpy(buffer + offset, account_at(tx, i)->pubkey, ESPSOL_PUBKEY_SIZE);
         offset += ESPSOL_PUBKEY_SIZE;
     }
     
     /* Recent blockhash */
-    if (offset + ESPSOL_BLOCKHASH_SIZE > buffer_len) {
+    if (offset + ESPSOL_BLOCKHASH_SIZE + 3 > buffer_len) {
         return ESP_ERR_ESPSOL_BUFFER_TOO_SMALL;
     }
     memcpy(buffer + offset, tx->blockhash, ESPSOL_BLOCKHASH_SIZE);
@@ -335,45 +716,106 @@ static esp_err_t serialize_message(struct espsol_transaction *tx,
     compact_len = write_compact_u16(buffer + offset, (uint16_t)tx->instruction_count);
     offset += compact_len;
     
+    size_t record = 0;
     for (size_t i = 0; i < tx->instruction_count; i++) {
-        espsol_instruction_t *ix = &tx->instructions[i];
+        const uint8_t *accounts;
+        const uint8_t *data;
+        const tx_ix_t *ix = next_record(tx, &record, &accounts, &data);
         
-        /* Program ID index */
-        int prog_idx = find_account_index(tx, ix->program_id);
-        if (prog_idx < 0) {
-            return ESP_ERR_ESPSOL_TX_BUILD_ERROR;
+        /* Program ID index, then account indices (compact array) */
+        if (offset + 1 + 3 + ix->account_count + 3 > buffer_len) {
+            return ESP_ERR_ESPSOL_BUFFER_TOO_SMALL;
         }
-        if (offset + 1 > buffer_len) return ESP_ERR_ESPSOL_BUFFER_TOO_SMALL;
-        buffer[offset++] = (uint8_t)prog_idx;
+        buffer[offset++] = key_at(tx, ix->program)->position;
         
-        /* Account indices (compact array) */
-        compact_len = write_compact_u16(buffer + offset, (uint16_t)ix->account_count);
+        compact_len = write_compact_u16(buffer + offset, ix->account_count);
         offset += compact_len;
         
         for (size_t j = 0; j < ix->account_count; j++) {
-            int acc_idx = find_account_index(tx, ix->accounts[j].pubkey);
-            if (acc_idx < 0) {
-                return ESP_ERR_ESPSOL_TX_BUILD_ERROR;
-            }
-            if (offset + 1 > buffer_len) return ESP_ERR_ESPSOL_BUFFER_TOO_SMALL;
-            buffer[offset++] = (uint8_t)acc_idx;
+            buffer[offset++] = key_at(tx, accounts[j])->position;
         }
         
         /* Instruction data (compact array) */
-        compact_len = write_compact_u16(buffer + offset, (uint16_t)ix->data_len);
+        compact_len = write_compact_u16(buffer + offset, ix->data_len);
         offset += compact_len;
         
         if (offset + ix->data_len > buffer_len) {
             return ESP_ERR_ESPSOL_BUFFER_TOO_SMALL;
         }
-        memcpy(buffer + offset, ix->data, ix->data_len);
+        memcpy(buffer + offset, data, ix->data_len);
         offset += ix->data_len;
     }
     
+    /* Address table lookups (compact array, v0 only) */
+    if (tx->version == ESPSOL_TX_VERSION_0) {
+        size_t used_tables = 0;
+        for (size_t t = 0; t < tx->lookup_table_count; t++) {
+            for (size_t i = tx->static_count; i < tx->account_count; i++) {
+                if (account_at(tx, i)->lookup_table == (int8_t)t) {
+                    used_tables++;
+                    break;
+                }
+            }
+        }
+        
+        if (offset + 1 > buffer_len) return ESP_ERR_ESPSOL_BUFFER_TOO_SMALL;
+        offset += write_compact_u16(buffer + offset, (uint16_t)used_tables);
+        
+        for (size_t t = 0; t < tx->lookup_table_count; t++) {
+            uint8_t writable[ESPSOL_MAX_LOADED_ACCOUNTS];
+            uint8_t readonly[ESPSOL_MAX_LOADED_ACCOUNTS];
+            size_t writable_count = 0;
+            size_t readonly_count = 0;
+            
+            for (size_t i = tx->static_count; i < tx->account_count; i++) {
+                const tx_key_t *key = account_at(tx, i);
+                if (key->lookup_table != (int8_t)t) {
+                    continue;
+                }
+                if (key_flags(tx, key) & KEY_WRITABLE) {
+                    writable[writable_count++] = key->lookup_index;
+                } else {
+                    readonly[readonly_count++] = key->lookup_index;
+                }
+            }
+            
+            if (writable_count + readonly_count == 0) {
+                continue;
+            }
+            
+            /* Table key, then writable and read-only index arrays (counts < 128) */
+            size_t needed = ESPSOL_PUBKEY_SIZE + 2 + writable_count + readonly_count;
+            if (offset + needed > buffer_len) {
+                return ESP_ERR_ESPSOL_BUFFER_TOO_SMALL;
+            }
+            memcpy(buffer + offset, tx->lookup_tables[t].key, ESPSOL_PUBKEY_SIZE);
+            offset += ESPSOL_PUBKEY_SIZE;
+            buffer[offset++] = (uint8_t)writable_count;
+            memcpy(buffer + offset, writable, writable_count);
+            offset += writable_count;
+            buffer[offset++] = (uint8_t)readonly_count;
+            memcpy(buffer + offset, readonly, readonly_count);
+            offset += readonly_count;
+        }
+    }
+    
     *out_len = offset;
     return ESP_OK;
 }
 
+/**
+ * @brief Apply the configured default priority fee to an empty transaction
+ */
+static esp_err_t apply_default_budget(struct espsol_transaction *tx)
+{
+#if DEFAULT_PRIORITY_FEE > 0
+    return espsol_tx_set_compute_unit_price(tx, DEFAULT_PRIORITY_FEE);
+#else
+    (void)tx;
+    return ESP_OK;
+#endif
+}
+
 /* ============================================================================
  * Transaction Lifecycle
  * ========================================================================== */
@@ -384,37 +826,87 @@ esp_err_t espsol_tx_create(espsol_tx_handle_t *tx)
         return ESP_ERR_INVALID_ARG;
     }
     
+    /* The arena is allocated when the first instruction is added */
     struct espsol_transaction *t = calloc(1, sizeof(struct espsol_transaction));
     if (!t) {
         ESP_LOGE(TAG, "Failed to allocate transaction");
         return ESP_ERR_NO_MEM;
     }
     
+    esp_err_t err = apply_default_budget(t);
+    if (err != ESP_OK) {
+        espsol_tx_destroy(t);
+        return err;
+    }
+    
     *tx = t;
     ESP_LOGD(TAG, "Transaction created");
     return ESP_OK;
 }
 
-esp_err_t espsol_tx_destroy(espsol_tx_handle_t tx)
+esp_err_t espsol_tx_init_static(void *buffer, size_t size, espsol_tx_handle_t *tx)
 {
-    if (!tx) {
+    if (!buffer || !tx) {
         return ESP_ERR_INVALID_ARG;
     }
     
-    free(tx);
-    ESP_LOGD(TAG, "Transaction destroyed");
-    return ESP_OK;
-}
-
-esp_err_t espsol_tx_reset(espsol_tx_handle_t tx)
-{
-    if (!tx) {
-        return ESP_ERR_INVALID_ARG;
+    /* Align the handle; the arena needs no alignment beyond 2 bytes */
+    uintptr_t start = ((uintptr_t)buffer + sizeof(void *) - 1) & ~(uintptr_t)(sizeof(void *) - 1);
+    size_t skip = start - (uintptr_t)buffer;
+    size_t header = (sizeof(struct espsol_transaction) + 1) & ~(size_t)1;
+    
+    if (size < skip + header + TX_STATIC_MIN_ARENA) {
+        return ESP_ERR_ESPSOL_BUFFER_TOO_SMALL;
     }
     
+    struct espsol_transaction *t = (struct espsol_transaction *)start;
+    memset(t, 0, sizeof(*t));
+    t->arena = (uint8_t *)start + header;
+    t->arena_cap = size - skip - header;
+    t->is_static = true;
+    
+    esp_err_t err = apply_default_budget(t);
+    if (err != ESP_OK) {
+        return err;
+    }
+    
+    *tx = t;
+    return ESP_OK;
+}
+
+esp_err_t espsol_tx_destroy(espsol_tx_handle_t tx)
+{
+    if (!tx) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    /* A static transaction's storage belongs to the caller */
+    if (!tx->is_static) {
+        free(tx->arena);
+        free(tx);
+    }
+    ESP_LOGD(TAG, "Transaction destroyed");
+    return ESP_OK;
+}
+
+esp_err_t espsol_tx_reset(espsol_tx_handle_t tx)
+{
+    if (!tx) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    /* Keep the arena for reuse */
+    uint8_t *arena = tx->arena;
+    size_t arena_cap = tx->arena_cap;
+    bool is_static = tx->is_static;
+    
     memset(tx, 0, sizeof(struct espsol_transaction));
+    tx->arena = arena;
+    tx->arena_cap = arena_cap;
+    tx->is_static = is_static;
+    
     ESP_LOGD(TAG, "Transaction reset");
-    return ESP_OK;
+    return apply_default_budget(tx);
 }
 
 /* ============================================================================
@@ -430,8 +922,7 @@ esp_err_t espsol_tx_set_fee_payer(espsol_tx_handle_t tx,
     
     memcpy(tx->fee_payer, pubkey, ESPSOL_PUBKEY_SIZE);
     tx->has_fee_payer = true;
-    tx->accounts_compiled = false;  /* Need to recompile */
-    tx->is_signed = false;
+    invalidate(tx);  /* Need to recompile */
     
     return ESP_OK;
 }
@@ -445,8 +936,97 @@ esp_err_t espsol_tx_set_recent_blockhash(espsol_tx_handle_t tx,
     
     memcpy(tx->blockhash, blockhash, ESPSOL_BLOCKHASH_SIZE);
     tx->has_blockhash = true;
-    tx->is_signed = false;  /* Blockhash change invalidates signatures */
     
+    /* Blockhash change invalidates the sealed message and signatures */
+    unseal(tx);
+    
+    return ESP_OK;
+}
+
+esp_err_t espsol_tx_set_version(espsol_tx_handle_t tx, espsol_tx_version_t version)
+{
+    if (!tx || (version != ESPSOL_TX_VERSION_LEGACY && version != ESPSOL_TX_VERSION_0)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+#if !ESPSOL_VERSIONED_TX
+    if (version != ESPSOL_TX_VERSION_LEGACY) {
+        ESP_LOGE(TAG, "Versioned transactions disabled (CONFIG_ESPSOL_ENABLE_VERSIONED_TX)");
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+#endif
+
+    tx->version = version;
+    if (version == ESPSOL_TX_VERSION_LEGACY) {
+        tx->lookup_table_count = 0;
+    }
+    invalidate(tx);
+    
+    return ESP_OK;
+}
+
+esp_err_t espsol_tx_get_version(espsol_tx_handle_t tx, espsol_tx_version_t *version)
+{
+    if (!tx || !version) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    *version = tx->version;
+    return ESP_OK;
+}
+
+esp_err_t espsol_tx_add_lookup_table(espsol_tx_handle_t tx,
+                                      const espsol_lookup_table_t *table)
+{
+    if (!tx || !table || table->address_count > 256 ||
+        (table->address_count > 0 && !table->addresses)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    if (tx->lookup_table_count >= ESPSOL_MAX_LOOKUP_TABLES) {
+        return ESP_ERR_ESPSOL_MAX_ACCOUNTS;
+    }
+    
+    esp_err_t err = espsol_tx_set_version(tx, ESPSOL_TX_VERSION_0);
+    if (err != ESP_OK) {
+        return err;
+    }
+    
+    tx->lookup_tables[tx->lookup_table_count++] = *table;
+    return ESP_OK;
+}
+
+esp_err_t espsol_tx_get_lookup_candidates(espsol_tx_handle_t tx,
+                                           const uint8_t **keys,
+                                           size_t capacity,
+                                           size_t *count,
+                                           size_t *account_count)
+{
+    if (!tx || !keys || !count) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    esp_err_t err = build_accounts(tx);
+    if (err != ESP_OK) {
+        return err;
+    }
+    
+    size_t n = 0;
+    for (size_t i = 0; i < tx->account_count; i++) {
+        const tx_key_t *key = account_at(tx, i);
+        if (key_flags(tx, key) & (KEY_SIGNER | KEY_INVOKED)) {
+            continue;
+        }
+        if (n >= capacity) {
+            return ESP_ERR_ESPSOL_BUFFER_TOO_SMALL;
+        }
+        keys[n++] = key->pubkey;
+    }
+    
+    *count = n;
+    if (account_count) {
+        *account_count = tx->account_count;
+    }
     return ESP_OK;
 }
 
@@ -463,44 +1043,27 @@ esp_err_t espsol_tx_add_transfer(espsol_tx_handle_t tx,
         return ESP_ERR_INVALID_ARG;
     }
     
-    if (tx->instruction_count >= ESPSOL_MAX_INSTRUCTIONS) {
-        ESP_LOGE(TAG, "Maximum instructions reached");
-        return ESP_ERR_ESPSOL_MAX_INSTRUCTIONS;
-    }
-    
-    espsol_instruction_t *ix = &tx->instructions[tx->instruction_count];
-    
-    /* System Program ID */
-    memcpy(ix->program_id, ESPSOL_SYSTEM_PROGRAM_ID, ESPSOL_PUBKEY_SIZE);
-    
     /* Accounts: [from (signer, writable), to (writable)] */
-    ix->account_count = 2;
-    memcpy(ix->accounts[0].pubkey, from, ESPSOL_PUBKEY_SIZE);
-    ix->accounts[0].is_signer = true;
-    ix->accounts[0].is_writable = true;
-    
-    memcpy(ix->accounts[1].pubkey, to, ESPSOL_PUBKEY_SIZE);
-    ix->accounts[1].is_signer = false;
-    ix->accounts[1].is_writable = true;
+    espsol_account_meta_t accounts[2] = {
+        { .is_signer = true, .is_writable = true },
+        { .is_signer = false, .is_writable = true },
+    };
+    memcpy(accounts[0].pubkey, from, ESPSOL_PUBKEY_SIZE);
+    memcpy(accounts[1].pubkey, to, ESPSOL_PUBKEY_SIZE);
     
     /* Instruction data: [u32 instruction_type (2=Transfer), u64 lamports] */
-    ix->data_len = 12;
-    /* Transfer instruction type = 2 (little-endian u32) */
-    ix->data[0] = 2;
-    ix->data[1] = 0;
-    ix->data[2] = 0;
-    ix->data[3] = 0;
+    uint8_t data[12] = { 2, 0, 0, 0 };
     /* Lamports (little-endian u64) */
     for (int i = 0; i < 8; i++) {
-        ix->data[4 + i] = (uint8_t)(lamports >> (i * 8));
+        data[4 + i] = (uint8_t)(lamports >> (i * 8));
     }
     
-    tx->instruction_count++;
-    tx->accounts_compiled = false;
-    tx->is_signed = false;
-    
-    ESP_LOGD(TAG, "Added transfer instruction: %llu lamports", (unsigned long long)lamports);
-    return ESP_OK;
+    esp_err_t err = espsol_tx_add_instruction(tx, ESPSOL_SYSTEM_PROGRAM_ID,
+                                              accounts, 2, data, sizeof(data));
+    if (err == ESP_OK) {
+        ESP_LOGD(TAG, "Added transfer instruction: %llu lamports", (unsigned long long)lamports);
+    }
+    return err;
 }
 
 esp_err_t espsol_tx_add_create_account(espsol_tx_handle_t tx,
@@ -514,58 +1077,137 @@ esp_err_t espsol_tx_add_create_account(espsol_tx_handle_t tx,
         return ESP_ERR_INVALID_ARG;
     }
     
-    if (tx->instruction_count >= ESPSOL_MAX_INSTRUCTIONS) {
-        return ESP_ERR_ESPSOL_MAX_INSTRUCTIONS;
-    }
-    
-    espsol_instruction_t *ix = &tx->instructions[tx->instruction_count];
-    
-    /* System Program ID */
-    memcpy(ix->program_id, ESPSOL_SYSTEM_PROGRAM_ID, ESPSOL_PUBKEY_SIZE);
-    
     /* Accounts: [from (signer, writable), new_account (signer, writable)] */
-    ix->account_count = 2;
-    memcpy(ix->accounts[0].pubkey, from, ESPSOL_PUBKEY_SIZE);
-    ix->accounts[0].is_signer = true;
-    ix->accounts[0].is_writable = true;
-    
-    memcpy(ix->accounts[1].pubkey, new_account, ESPSOL_PUBKEY_SIZE);
-    ix->accounts[1].is_signer = true;
-    ix->accounts[1].is_writable = true;
+    espsol_account_meta_t accounts[2] = {
+        { .is_signer = true, .is_writable = true },
+        { .is_signer = true, .is_writable = true },
+    };
+    memcpy(accounts[0].pubkey, from, ESPSOL_PUBKEY_SIZE);
+    memcpy(accounts[1].pubkey, new_account, ESPSOL_PUBKEY_SIZE);
     
     /* Instruction data: [u32 type (0=CreateAccount), u64 lamports, u64 space, pubkey owner] */
-    ix->data_len = 4 + 8 + 8 + 32;  /* 52 bytes */
-    
-    /* CreateAccount instruction type = 0 */
-    ix->data[0] = 0;
-    ix->data[1] = 0;
-    ix->data[2] = 0;
-    ix->data[3] = 0;
+    uint8_t data[4 + 8 + 8 + 32] = { 0 };  /* 52 bytes */
     
     /* Lamports */
     for (int i = 0; i < 8; i++) {
-        ix->data[4 + i] = (uint8_t)(lamports >> (i * 8));
+        data[4 + i] = (uint8_t)(lamports >> (i * 8));
     }
     
     /* Space */
     for (int i = 0; i < 8; i++) {
-        ix->data[12 + i] = (uint8_t)(space >> (i * 8));
+        data[12 + i] = (uint8_t)(space >> (i * 8));
     }
     
     /* Owner */
-    memcpy(ix->data + 20, owner, ESPSOL_PUBKEY_SIZE);
-    
-    tx->instruction_count++;
-    tx->accounts_compiled = false;
-    tx->is_signed = false;
+    memcpy(data + 20, owner, ESPSOL_PUBKEY_SIZE);
     
-    return ESP_OK;
+    return espsol_tx_add_instruction(tx, ESPSOL_SYSTEM_PROGRAM_ID,
+                                     accounts, 2, data, sizeof(data));
 }
 
 /* ============================================================================
  * Custom Instructions
  * ========================================================================== */
 
+/**
+ * @brief Insert an instruction record at a record offset
+ *
+ * Records from the offset on move up to make room, so the new
+ * instruction takes their place in the message.
+ */
+static esp_err_t insert_instruction(struct espsol_transaction *tx, size_t offset,
+                                    const uint8_t program_id[ESPSOL_PUBKEY_SIZE],
+                                    const espsol_account_meta_t *accounts,
+                                    size_t account_count,
+                                    const uint8_t *data,
+                                    size_t data_len)
+{
+    if (tx->instruction_count >= ESPSOL_MAX_INSTRUCTIONS) {
+        ESP_LOGE(TAG, "Maximum instructions reached");
+        return ESP_ERR_ESPSOL_MAX_INSTRUCTIONS;
+    }
+    
+    /* Every index and data byte goes on the wire */
+    size_t ix_wire_len = instruction_wire_len(account_count, data_len);
+    if (data_len > ESPSOL_MAX_INSTRUCTION_DATA ||
+        tx->wire_len + ix_wire_len > ESPSOL_MAX_TX_SIZE) {
+        return ESP_ERR_ESPSOL_BUFFER_TOO_SMALL;
+    }
+    
+    /* Distinct keys not seen yet, by account position (account_count is the
+     * program), so a full key table is refused before anything changes */
+    uint16_t fresh[ESPSOL_MAX_LOADED_ACCOUNTS];
+    size_t new_keys = 0;
+    for (size_t i = 0; i <= account_count; i++) {
+        const uint8_t *pubkey = i < account_count ? accounts[i].pubkey : program_id;
+        if (find_key(tx, pubkey) >= 0) {
+            continue;
+        }
+        size_t j = 0;
+        while (j < new_keys) {
+            const uint8_t *seen = fresh[j] < account_count ?
+                                  accounts[fresh[j]].pubkey : program_id;
+            if (memcmp(seen, pubkey, ESPSOL_PUBKEY_SIZE) == 0) {
+                break;
+            }
+            j++;
+        }
+        if (j < new_keys) {
+            continue;
+        }
+        if (new_keys == ESPSOL_MAX_LOADED_ACCOUNTS - tx->key_count) {
+            return ESP_ERR_ESPSOL_MAX_ACCOUNTS;
+        }
+        fresh[new_keys++] = (uint16_t)i;
+    }
+    
+    /* The sealed message is dropped below, so its bytes count as free */
+    size_t record_len = (sizeof(tx_ix_t) + account_count + data_len + 1) & ~(size_t)1;
+    size_t needed = record_len + new_keys * sizeof(tx_key_t);
+    size_t sealed = tx->sig_slots * ESPSOL_SIGNATURE_SIZE + tx->message_len;
+    esp_err_t err = arena_reserve(tx, needed > sealed ? needed - sealed : 0);
+    if (err != ESP_OK) {
+        return err;
+    }
+    
+    invalidate(tx);
+    
+    tx_ix_t *ix = (tx_ix_t *)(tx->arena + offset);
+    uint8_t *indices = (uint8_t *)(ix + 1);
+    memmove(tx->arena + offset + record_len, ix, tx->records_len - offset);
+    
+    int program = intern_key(tx, program_id);
+    for (size_t i = 0; i < account_count; i++) {
+        indices[i] = (uint8_t)intern_key(tx, accounts[i].pubkey);
+    }
+    
+    merge_flags(tx, key_at(tx, program), KEY_USED | KEY_INVOKED);
+    for (size_t i = 0; i < account_count; i++) {
+        uint8_t flags = KEY_USED;
+        if (accounts[i].is_signer) {
+            flags |= KEY_SIGNER;
+        }
+        if (accounts[i].is_writable) {
+            flags |= KEY_WRITABLE;
+        }
+        merge_flags(tx, key_at(tx, indices[i]), flags);
+    }
+    
+    ix->program = (uint8_t)program;
+    ix->reserved = 0;
+    ix->account_count = (uint16_t)account_count;
+    ix->data_len = (uint16_t)data_len;
+    if (data_len > 0) {
+        memcpy(indices + account_count, data, data_len);
+    }
+    
+    tx->records_len += record_len;
+    tx->wire_len += ix_wire_len;
+    tx->instruction_count++;
+    
+    return ESP_OK;
+}
+
 esp_err_t espsol_tx_add_instruction(espsol_tx_handle_t tx,
                                      const uint8_t program_id[ESPSOL_PUBKEY_SIZE],
                                      const espsol_account_meta_t *accounts,
@@ -585,124 +1227,414 @@ esp_err_t espsol_tx_add_instruction(espsol_tx_handle_t tx,
         return ESP_ERR_INVALID_ARG;
     }
     
-    if (tx->instruction_count >= ESPSOL_MAX_INSTRUCTIONS) {
-        return ESP_ERR_ESPSOL_MAX_INSTRUCTIONS;
+    return insert_instruction(tx, tx->records_len, program_id, accounts, account_count,
+                              data, data_len);
+}
+
+/**
+ * @brief Flags of an account in the message (0 if absent)
+ */
+static uint8_t message_flags(const struct espsol_transaction *tx,
+                             const uint8_t pubkey[ESPSOL_PUBKEY_SIZE])
+{
+    if (tx->has_fee_payer && pubkey_equals(pubkey, tx->fee_payer)) {
+        return KEY_USED | KEY_SIGNER | KEY_WRITABLE;
+    }
+    int index = find_key(tx, pubkey);
+    return index < 0 ? 0 : key_at(tx, (size_t)index)->flags;
+}
+
+esp_err_t espsol_tx_instruction_cost(espsol_tx_handle_t tx,
+                                      const uint8_t program_id[ESPSOL_PUBKEY_SIZE],
+                                      const espsol_account_meta_t *accounts,
+                                      size_t account_count,
+                                      size_t data_len,
+                                      espsol_tx_cost_t *cost)
+{
+    if (!tx || !program_id || !cost || (account_count > 0 && !accounts)) {
+        return ESP_ERR_INVALID_ARG;
     }
     
-    if (account_count > ESPSOL_MAX_ACCOUNTS) {
-        return ESP_ERR_ESPSOL_MAX_ACCOUNTS;
+    cost->new_keys = 0;
+    cost->new_signers = 0;
+    cost->instruction_bytes = instruction_wire_len(account_count, data_len);
+    
+    bool program_new = !(message_flags(tx, program_id) & KEY_USED);
+    if (program_new) {
+        cost->new_keys++;
     }
     
-    if (data_len > ESPSOL_MAX_INSTRUCTION_DATA) {
+    /* Repeats within the instruction count once, at their first occurrence */
+    for (size_t i = 0; i < account_count; i++) {
+        const uint8_t *pubkey = accounts[i].pubkey;
+        uint8_t flags = message_flags(tx, pubkey);
+        bool seen = program_new && pubkey_equals(pubkey, program_id);
+        bool signer = (flags & KEY_SIGNER) != 0;
+        
+        for (size_t j = 0; j < i && !(seen && signer); j++) {
+            if (pubkey_equals(accounts[j].pubkey, pubkey)) {
+                seen = true;
+                signer = signer || accounts[j].is_signer;
+            }
+        }
+        
+        if (!(flags & KEY_USED) && !seen) {
+            cost->new_keys++;
+        }
+        if (accounts[i].is_signer && !signer) {
+            cost->new_signers++;
+        }
+    }
+    
+    return ESP_OK;
+}
+
+esp_err_t espsol_tx_add_memo(espsol_tx_handle_t tx, const char *memo)
+{
+    if (!tx || !memo) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    size_t memo_len = strlen(memo);
+    if (memo_len > ESPSOL_MAX_INSTRUCTION_DATA) {
         return ESP_ERR_ESPSOL_BUFFER_TOO_SMALL;
     }
     
-    espsol_instruction_t *ix = &tx->instructions[tx->instruction_count];
+    /* Memo program takes no accounts, just data */
+    return espsol_tx_add_instruction(tx, ESPSOL_MEMO_PROGRAM_ID,
+                                      NULL, 0,
+                                      (const uint8_t *)memo, memo_len);
+}
+
+/* ============================================================================
+ * Compute Budget
+ * ========================================================================== */
+
+/* Compute Budget instruction tags */
+#define COMPUTE_BUDGET_HEAP_FRAME       1
+#define COMPUTE_BUDGET_UNIT_LIMIT       2
+#define COMPUTE_BUDGET_UNIT_PRICE       3
+#define COMPUTE_BUDGET_LOADED_DATA      4
+
+/**
+ * @brief Check whether an instruction record invokes the Compute Budget program
+ */
+static bool is_compute_budget(const struct espsol_transaction *tx, const tx_ix_t *ix)
+{
+    return pubkey_equals(key_at(tx, ix->program)->pubkey, ESPSOL_COMPUTE_BUDGET_PROGRAM_ID);
+}
+
+/**
+ * @brief Set a Compute Budget instruction
+ *
+ * An instruction with the same tag is updated in place. Otherwise the
+ * new one goes after the Compute Budget instructions at the front of the
+ * message, so they stay together and ahead of everything but a nonce
+ * advance.
+ */
+static esp_err_t set_compute_budget(struct espsol_transaction *tx, uint8_t tag,
+                                    uint64_t value, size_t value_len)
+{
+    uint8_t data[9] = { tag };
+    for (size_t i = 0; i < value_len; i++) {
+        data[1 + i] = (uint8_t)(value >> (i * 8));
+    }
     
-    memcpy(ix->program_id, program_id, ESPSOL_PUBKEY_SIZE);
+    size_t front = 0;
+    bool leading = true;
+    size_t record = 0;
+    for (size_t i = 0; i < tx->instruction_count; i++) {
+        const uint8_t *ix_data;
+        const tx_ix_t *ix = next_record(tx, &record, NULL, &ix_data);
+        
+        /* AdvanceNonceAccount stays ahead of everything */
+        if (i == 0 && tx->has_nonce) {
+            front = record;
+            continue;
+        }
+        if (!is_compute_budget(tx, ix)) {
+            leading = false;
+            continue;
+        }
+        if (leading) {
+            front = record;
+        }
+        if (ix->data_len == 1 + value_len && ix_data[0] == tag) {
+            memcpy((uint8_t *)ix_data, data, 1 + value_len);
+            unseal(tx);
+            return ESP_OK;
+        }
+    }
     
-    ix->account_count = account_count;
-    for (size_t i = 0; i < account_count; i++) {
-        memcpy(ix->accounts[i].pubkey, accounts[i].pubkey, ESPSOL_PUBKEY_SIZE);
-        ix->accounts[i].is_signer = accounts[i].is_signer;
-        ix->accounts[i].is_writable = accounts[i].is_writable;
+    return insert_instruction(tx, front, ESPSOL_COMPUTE_BUDGET_PROGRAM_ID, NULL, 0,
+                              data, 1 + value_len);
+}
+
+esp_err_t espsol_tx_set_compute_unit_limit(espsol_tx_handle_t tx, uint32_t units)
+{
+    if (!tx) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    return set_compute_budget(tx, COMPUTE_BUDGET_UNIT_LIMIT, units, 4);
+}
+
+esp_err_t espsol_tx_set_compute_unit_price(espsol_tx_handle_t tx, uint64_t micro_lamports)
+{
+    if (!tx) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    return set_compute_budget(tx, COMPUTE_BUDGET_UNIT_PRICE, micro_lamports, 8);
+}
+
+esp_err_t espsol_tx_set_heap_frame(espsol_tx_handle_t tx, uint32_t bytes)
+{
+    if (!tx || bytes < ESPSOL_MIN_HEAP_FRAME_BYTES || bytes > ESPSOL_MAX_HEAP_FRAME_BYTES ||
+        bytes % 1024 != 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    return set_compute_budget(tx, COMPUTE_BUDGET_HEAP_FRAME, bytes, 4);
+}
+
+esp_err_t espsol_tx_set_loaded_accounts_data_limit(espsol_tx_handle_t tx, uint32_t bytes)
+{
+    if (!tx || bytes == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    return set_compute_budget(tx, COMPUTE_BUDGET_LOADED_DATA, bytes, 4);
+}
+
+esp_err_t espsol_tx_clear_compute_budget(espsol_tx_handle_t tx)
+{
+    if (!tx) {
+        return ESP_ERR_INVALID_ARG;
     }
     
-    ix->data_len = data_len;
-    if (data_len > 0) {
-        memcpy(ix->data, data, data_len);
+    /* Compact the other records over the Compute Budget ones */
+    size_t record = 0;
+    size_t kept = 0;
+    size_t count = tx->instruction_count;
+    int program = -1;
+    for (size_t i = 0; i < count; i++) {
+        size_t start = record;
+        const uint8_t *accounts;
+        const tx_ix_t *ix = next_record(tx, &record, &accounts, NULL);
+        
+        if (is_compute_budget(tx, ix)) {
+            program = ix->program;
+            tx->wire_len -= instruction_wire_len(ix->account_count, ix->data_len);
+            tx->instruction_count--;
+            continue;
+        }
+        memmove(tx->arena + kept, tx->arena + start, record - start);
+        kept += record - start;
     }
     
-    tx->instruction_count++;
-    tx->accounts_compiled = false;
-    tx->is_signed = false;
+    if (program < 0) {
+        return ESP_OK;
+    }
+    tx->records_len = kept;
+    invalidate(tx);
+    
+    /* Drop the program from the message unless another instruction still uses it */
+    record = 0;
+    for (size_t i = 0; i < tx->instruction_count; i++) {
+        const uint8_t *accounts;
+        const tx_ix_t *ix = next_record(tx, &record, &accounts, NULL);
+        if (memchr(accounts, program, ix->account_count)) {
+            return ESP_OK;
+        }
+    }
+    tx_key_t *key = key_at(tx, (size_t)program);
+    if (key->flags & KEY_USED) {
+        tx->used_keys--;
+    }
+    key->flags = 0;
+    return ESP_OK;
+}
+
+/* ============================================================================
+ * Durable Nonce
+ * ========================================================================== */
+
+esp_err_t espsol_tx_set_durable_nonce(espsol_tx_handle_t tx,
+                                      const uint8_t nonce_account[ESPSOL_PUBKEY_SIZE],
+                                      const uint8_t authority[ESPSOL_PUBKEY_SIZE],
+                                      const uint8_t nonce[ESPSOL_BLOCKHASH_SIZE])
+{
+    if (!tx || !nonce_account || !authority || !nonce) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+#if !ESPSOL_DURABLE_NONCES
+    ESP_LOGE(TAG, "Durable nonces disabled (CONFIG_ESPSOL_ENABLE_DURABLE_NONCES)");
+    return ESP_ERR_NOT_SUPPORTED;
+#else
+    /* The advance instruction is fixed once added; only the nonce value changes */
+    if (tx->has_nonce) {
+        const uint8_t *accounts;
+        size_t record = 0;
+        next_record(tx, &record, &accounts, NULL);
+        if (!pubkey_equals(key_at(tx, accounts[0])->pubkey, nonce_account) ||
+            !pubkey_equals(key_at(tx, accounts[2])->pubkey, authority)) {
+            ESP_LOGE(TAG, "Nonce account already set; reset the transaction to change it");
+            return ESP_ERR_INVALID_ARG;
+        }
+    } else {
+        /* AdvanceNonceAccount: u32 tag 4 */
+        espsol_account_meta_t accounts[3] = {
+            { .is_signer = false, .is_writable = true },
+            { .is_signer = false, .is_writable = false },
+            { .is_signer = true, .is_writable = false },
+        };
+        memcpy(accounts[0].pubkey, nonce_account, ESPSOL_PUBKEY_SIZE);
+        memcpy(accounts[1].pubkey, ESPSOL_RECENT_BLOCKHASHES_SYSVAR_ID, ESPSOL_PUBKEY_SIZE);
+        memcpy(accounts[2].pubkey, authority, ESPSOL_PUBKEY_SIZE);
+        uint8_t data[4] = { 4, 0, 0, 0 };
+        
+        esp_err_t err = insert_instruction(tx, 0, ESPSOL_SYSTEM_PROGRAM_ID, accounts, 3,
+                                           data, sizeof(data));
+        if (err != ESP_OK) {
+            return err;
+        }
+        tx->has_nonce = true;
+    }
+    
+    memcpy(tx->blockhash, nonce, ESPSOL_BLOCKHASH_SIZE);
+    tx->has_blockhash = true;
+    unseal(tx);
+    return ESP_OK;
+#endif
+}
+
+/* ============================================================================
+ * Signing
+ * ========================================================================== */
+
+/**
+ * @brief Get the signature slot of a required signer, or -1
+ */
+static int find_signer(const struct espsol_transaction *tx, const uint8_t pubkey[ESPSOL_PUBKEY_SIZE])
+{
+    for (size_t i = 0; i < tx->required_signers && i < tx->account_count; i++) {
+        if (pubkey_equals(account_at(tx, i)->pubkey, pubkey)) {
+            return (int)i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Update the signed state after a slot was written
+ */
+static void signature_filled(struct espsol_transaction *tx, size_t index)
+{
+    if (index >= tx->signer_count) {
+        tx->signer_count = index + 1;
+    }
+    
+    /* Check if fully signed: unsigned slots are all zero */
+    static const uint8_t empty[ESPSOL_SIGNATURE_SIZE] = { 0 };
+    tx->is_signed = true;
+    for (size_t i = 0; i < tx->sig_slots; i++) {
+        if (memcmp(signature_slot(tx, i), empty, ESPSOL_SIGNATURE_SIZE) == 0) {
+            tx->is_signed = false;
+        }
+    }
+}
+
+esp_err_t espsol_tx_seal(espsol_tx_handle_t tx)
+{
+    if (!tx) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    if (tx->message_len > 0) {
+        return ESP_OK;
+    }
+    
+    esp_err_t err = compile_accounts(tx);
+    if (err != ESP_OK) {
+        return err;
+    }
+    
+    if (!tx->has_blockhash) {
+        ESP_LOGE(TAG, "Cannot seal: missing blockhash");
+        return ESP_ERR_ESPSOL_TX_BUILD_ERROR;
+    }
+    
+    /* One empty signature slot per required signer, after the instruction records */
+    tx->sig_slots = 0;
+    tx->signer_count = 0;
+    err = arena_reserve(tx, tx->required_signers * ESPSOL_SIGNATURE_SIZE);
+    if (err != ESP_OK) {
+        return err;
+    }
+    tx->sig_slots = tx->required_signers;
+    memset(signature_slot(tx, 0), 0, tx->sig_slots * ESPSOL_SIGNATURE_SIZE);
+    
+    /* Serialize the message into the free space, growing a heap arena if it does not fit */
+    size_t message_len = 0;
+    err = serialize_message(tx, sealed_message(tx), arena_free(tx), &message_len);
+    if (err == ESP_ERR_ESPSOL_BUFFER_TOO_SMALL) {
+        err = arena_reserve(tx, ESPSOL_MAX_TX_SIZE);
+        if (err == ESP_OK) {
+            err = serialize_message(tx, sealed_message(tx), arena_free(tx), &message_len);
+        }
+    }
+    if (err != ESP_OK) {
+        tx->sig_slots = 0;
+        return err;
+    }
     
+    tx->message_len = message_len;
+    ESP_LOGD(TAG, "Transaction sealed (%u byte message)", (unsigned)message_len);
     return ESP_OK;
 }
 
-esp_err_t espsol_tx_add_memo(espsol_tx_handle_t tx, const char *memo)
+esp_err_t espsol_tx_get_message(espsol_tx_handle_t tx,
+                                 const uint8_t **message, size_t *message_len)
 {
-    if (!tx || !memo) {
+    if (!tx || !message || !message_len) {
         return ESP_ERR_INVALID_ARG;
     }
     
-    size_t memo_len = strlen(memo);
-    if (memo_len > ESPSOL_MAX_INSTRUCTION_DATA) {
-        return ESP_ERR_ESPSOL_BUFFER_TOO_SMALL;
+    esp_err_t err = espsol_tx_seal(tx);
+    if (err != ESP_OK) {
+        return err;
     }
     
-    /* Memo program takes no accounts, just data */
-    return espsol_tx_add_instruction(tx, ESPSOL_MEMO_PROGRAM_ID,
-                                      NULL, 0,
-                                      (const uint8_t *)memo, memo_len);
+    *message = sealed_message(tx);
+    *message_len = tx->message_len;
+    return ESP_OK;
 }
 
-/* ============================================================================
- * Signing
- * ========================================================================== */
-
 esp_err_t espsol_tx_sign(espsol_tx_handle_t tx, const espsol_keypair_t *keypair)
 {
     if (!tx || !keypair) {
         return ESP_ERR_INVALID_ARG;
     }
     
-    /* Compile accounts if needed */
-    esp_err_t err = compile_accounts(tx);
-    if (err != ESP_OK) {
-        return err;
-    }
-    
-    if (!tx->has_blockhash) {
-        ESP_LOGE(TAG, "Cannot sign: missing blockhash");
-        return ESP_ERR_ESPSOL_TX_BUILD_ERROR;
-    }
-    
-    /* Serialize the message */
-    uint8_t message[ESPSOL_MAX_TX_SIZE];
-    size_t message_len = 0;
-    err = serialize_message(tx, message, sizeof(message), &message_len);
+    /* Serialize the message once; every signer signs the same bytes */
+    esp_err_t err = espsol_tx_seal(tx);
     if (err != ESP_OK) {
         return err;
     }
     
     /* Find which signer this keypair corresponds to */
-    int signer_idx = -1;
-    for (size_t i = 0; i < tx->required_signers && i < tx->account_count; i++) {
-        if (pubkey_equals(tx->accounts[i].pubkey, keypair->public_key)) {
-            signer_idx = (int)i;
-            break;
-        }
-    }
-    
+    int signer_idx = find_signer(tx, keypair->public_key);
     if (signer_idx < 0) {
         ESP_LOGE(TAG, "Keypair public key not found in required signers");
         return ESP_ERR_ESPSOL_TX_BUILD_ERROR;
     }
     
-    if ((size_t)signer_idx >= ESPSOL_MAX_SIGNERS) {
-        ESP_LOGE(TAG, "Too many signers");
-        return ESP_ERR_ESPSOL_MAX_ACCOUNTS;
-    }
-    
-    /* Sign the message */
-    err = espsol_sign(message, message_len, keypair, tx->signatures[signer_idx]);
+    /* Sign the sealed message */
+    err = espsol_sign(sealed_message(tx), tx->message_len, keypair, signature_slot(tx, signer_idx));
     if (err != ESP_OK) {
         ESP_LOGE(TAG, "Failed to sign transaction");
         return ESP_ERR_ESPSOL_CRYPTO_ERROR;
     }
     
-    /* Store the signer pubkey */
-    memcpy(tx->signer_pubkeys[signer_idx], keypair->public_key, ESPSOL_PUBKEY_SIZE);
-    
-    /* Update signer count */
-    if ((size_t)signer_idx >= tx->signer_count) {
-        tx->signer_count = (size_t)signer_idx + 1;
-    }
-    
-    /* Check if fully signed */
-    tx->is_signed = (tx->signer_count >= tx->required_signers);
-    
+    signature_filled(tx, (size_t)signer_idx);
     ESP_LOGD(TAG, "Transaction signed by signer %d", signer_idx);
     return ESP_OK;
 }
@@ -715,8 +1647,13 @@ esp_err_t espsol_tx_sign_multiple(espsol_tx_handle_t tx,
         return ESP_ERR_INVALID_ARG;
     }
     
+    esp_err_t err = espsol_tx_seal(tx);
+    if (err != ESP_OK) {
+        return err;
+    }
+    
     for (size_t i = 0; i < count; i++) {
-        esp_err_t err = espsol_tx_sign(tx, keypairs[i]);
+        err = espsol_tx_sign(tx, keypairs[i]);
         if (err != ESP_OK) {
             return err;
         }
@@ -725,15 +1662,133 @@ esp_err_t espsol_tx_sign_multiple(espsol_tx_handle_t tx,
     return ESP_OK;
 }
 
+esp_err_t espsol_tx_add_signature(espsol_tx_handle_t tx,
+                                   const uint8_t pubkey[ESPSOL_PUBKEY_SIZE],
+                                   const uint8_t signature[ESPSOL_SIGNATURE_SIZE])
+{
+    if (!tx || !pubkey || !signature) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    esp_err_t err = espsol_tx_seal(tx);
+    if (err != ESP_OK) {
+        return err;
+    }
+    
+    int signer_idx = find_signer(tx, pubkey);
+    if (signer_idx < 0) {
+        ESP_LOGE(TAG, "Public key not found in required signers");
+        return ESP_ERR_ESPSOL_TX_BUILD_ERROR;
+    }
+    
+    /* A signature made over other bytes would only fail at the node */
+    if (espsol_verify(sealed_message(tx), tx->message_len, signature, pubkey) != ESP_OK) {
+        ESP_LOGE(TAG, "Signature does not match the message");
+        return ESP_ERR_ESPSOL_SIGNATURE_INVALID;
+    }
+    
+    memcpy(signature_slot(tx, signer_idx), signature, ESPSOL_SIGNATURE_SIZE);
+    signature_filled(tx, (size_t)signer_idx);
+    ESP_LOGD(TAG, "Signature added for signer %d", signer_idx);
+    return ESP_OK;
+}
+
+esp_err_t espsol_tx_verify_signatures(espsol_tx_handle_t tx, size_t *invalid_index)
+{
+    if (!tx) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    if (!tx->is_signed) {
+        static const uint8_t empty[ESPSOL_SIGNATURE_SIZE] = { 0 };
+        for (size_t i = 0; i < tx->sig_slots; i++) {
+            if (memcmp(signature_slot(tx, i), empty, ESPSOL_SIGNATURE_SIZE) == 0) {
+                if (invalid_index) {
+                    *invalid_index = i;
+                }
+                break;
+            }
+        }
+        return ESP_ERR_ESPSOL_TX_NOT_SIGNED;
+    }
+    
+    /* Signer keys lead the static keys of the sealed message */
+    const uint8_t *keys = sealed_message(tx) + (tx->version == ESPSOL_TX_VERSION_0 ? 1 : 0) +
+                          3 + compact_u16_len(tx->static_count);
+    
+    esp_err_t err = espsol_verify_signers(sealed_message(tx), tx->message_len,
+                                          (const uint8_t (*)[ESPSOL_SIGNATURE_SIZE])signature_slot(tx, 0),
+                                          (const uint8_t (*)[ESPSOL_PUBKEY_SIZE])keys,
+                                          tx->required_signers, invalid_index);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Transaction signature does not verify");
+    }
+    return err;
+}
+
 /* ============================================================================
  * Serialization
  * ========================================================================== */
 
-esp_err_t espsol_tx_serialize(espsol_tx_handle_t tx,
-                               uint8_t *buffer, size_t buffer_len,
-                               size_t *out_len)
+bool espsol_tx_read_compact_u16(const uint8_t *buf, size_t len, size_t *pos, size_t *value)
 {
-    if (!tx || !buffer || !out_len) {
+    size_t result = 0;
+    for (int i = 0; i < 3; i++) {
+        if (*pos >= len) {
+            return false;
+        }
+        uint8_t byte = buf[(*pos)++];
+        if (i == 2 && byte > 0x03) {
+            return false;
+        }
+        result |= (size_t)(byte & 0x7F) << (7 * i);
+        if (!(byte & 0x80)) {
+            *value = result;
+            return i == 0 || byte != 0;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Length of the signature slots and the sealed message
+ */
+static size_t wire_len(const struct espsol_transaction *tx)
+{
+    return compact_u16_len(tx->required_signers) +
+           tx->required_signers * ESPSOL_SIGNATURE_SIZE + tx->message_len;
+}
+
+/**
+ * @brief Write the signature slots and the sealed message
+ *
+ * Straight from the arena, so nothing is staged on the stack.
+ */
+static esp_err_t write_wire(const struct espsol_transaction *tx,
+                            const espsol_writer_t *writer)
+{
+    /* Signatures (compact array) */
+    uint8_t count[3];
+    size_t compact_len = write_compact_u16(count, (uint16_t)tx->required_signers);
+    esp_err_t err = writer->write(writer->ctx, count, compact_len);
+    if (err != ESP_OK) {
+        return err;
+    }
+    
+    /* Slots are contiguous and in signer order */
+    err = writer->write(writer->ctx, signature_slot(tx, 0),
+                        tx->required_signers * ESPSOL_SIGNATURE_SIZE);
+    if (err != ESP_OK) {
+        return err;
+    }
+    
+    /* Sealed message */
+    return writer->write(writer->ctx, sealed_message(tx), tx->message_len);
+}
+
+esp_err_t espsol_tx_write(espsol_tx_handle_t tx, const espsol_writer_t *writer)
+{
+    if (!tx || !writer || !writer->write) {
         return ESP_ERR_INVALID_ARG;
     }
     
@@ -742,30 +1797,54 @@ esp_err_t espsol_tx_serialize(espsol_tx_handle_t tx,
         return ESP_ERR_ESPSOL_TX_NOT_SIGNED;
     }
     
-    size_t offset = 0;
+    return write_wire(tx, writer);
+}
+
+esp_err_t espsol_tx_serialize(espsol_tx_handle_t tx,
+                               uint8_t *buffer, size_t buffer_len,
+                               size_t *out_len)
+{
+    if (!tx || !buffer || !out_len) {
+        return ESP_ERR_INVALID_ARG;
+    }
     
-    /* Signatures (compact array) */
-    size_t compact_len = write_compact_u16(buffer + offset, (uint16_t)tx->required_signers);
-    offset += compact_len;
+    espsol_buffer_writer_t sink;
+    espsol_writer_t writer;
+    espsol_buffer_writer_init(&sink, buffer, buffer_len, &writer);
     
-    /* Write signatures in order */
-    for (size_t i = 0; i < tx->required_signers; i++) {
-        if (offset + ESPSOL_SIGNATURE_SIZE > buffer_len) {
-            return ESP_ERR_ESPSOL_BUFFER_TOO_SMALL;
-        }
-        memcpy(buffer + offset, tx->signatures[i], ESPSOL_SIGNATURE_SIZE);
-        offset += ESPSOL_SIGNATURE_SIZE;
+    esp_err_t err = espsol_tx_write(tx, &writer);
+    if (err != ESP_OK) {
+        return err;
     }
     
-    /* Message */
-    size_t message_len = 0;
-    esp_err_t err = serialize_message(tx, buffer + offset, buffer_len - offset, &message_len);
+    *out_len = sink.len;
+    return ESP_OK;
+}
+
+esp_err_t espsol_tx_serialize_partial(espsol_tx_handle_t tx,
+                                       uint8_t *buffer, size_t buffer_len,
+                                       size_t *out_len)
+{
+    if (!tx || !buffer || !out_len) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    /* Missing signatures stay zero in their slots */
+    esp_err_t err = espsol_tx_seal(tx);
     if (err != ESP_OK) {
         return err;
     }
-    offset += message_len;
     
-    *out_len = offset;
+    espsol_buffer_writer_t sink;
+    espsol_writer_t writer;
+    espsol_buffer_writer_init(&sink, buffer, buffer_len, &writer);
+    
+    err = write_wire(tx, &writer);
+    if (err != ESP_OK) {
+        return err;
+    }
+    
+    *out_len = sink.len;
     return ESP_OK;
 }
 
@@ -776,15 +1855,35 @@ esp_err_t espsol_tx_to_base64(espsol_tx_handle_t tx,
         return ESP_ERR_INVALID_ARG;
     }
     
-    uint8_t buffer[ESPSOL_MAX_TX_SIZE];
-    size_t tx_len = 0;
+    if (!tx->is_signed) {
+        ESP_LOGE(TAG, "Transaction not fully signed");
+        return ESP_ERR_ESPSOL_TX_NOT_SIGNED;
+    }
+    
+    size_t encoded_len = espsol_base64_encoded_len(wire_len(tx));
+    if (output_len < encoded_len) {
+        return ESP_ERR_ESPSOL_BUFFER_TOO_SMALL;
+    }
+    
+    /* Serialize through the encoder into output */
+    espsol_buffer_writer_t sink;
+    espsol_writer_t out;
+    espsol_buffer_writer_init(&sink, (uint8_t *)output, encoded_len - 1, &out);
+    
+    espsol_base64_writer_t enc;
+    espsol_writer_t writer;
+    espsol_base64_writer_init(&enc, &out, &writer);
     
-    esp_err_t err = espsol_tx_serialize(tx, buffer, sizeof(buffer), &tx_len);
+    esp_err_t err = write_wire(tx, &writer);
+    if (err == ESP_OK) {
+        err = espsol_base64_writer_finish(&enc);
+    }
     if (err != ESP_OK) {
         return err;
     }
     
-    return espsol_base64_encode(buffer, tx_len, output, output_len);
+    output[sink.len] = '\0';
+    return ESP_OK;
 }
 
 esp_err_t espsol_tx_to_base58(espsol_tx_handle_t tx,
@@ -794,15 +1893,28 @@ esp_err_t espsol_tx_to_base58(espsol_tx_handle_t tx,
         return ESP_ERR_INVALID_ARG;
     }
     
-    uint8_t buffer[ESPSOL_MAX_TX_SIZE];
-    size_t tx_len = 0;
+    if (!tx->is_signed) {
+        ESP_LOGE(TAG, "Transaction not fully signed");
+        return ESP_ERR_ESPSOL_TX_NOT_SIGNED;
+    }
+    
+    /* Base58 cannot stream: serialize into the tail of output and encode in place */
+    size_t tx_len = wire_len(tx);
+    if (output_len < tx_len + 1) {
+        return ESP_ERR_ESPSOL_BUFFER_TOO_SMALL;
+    }
+    
+    uint8_t *tail = (uint8_t *)output + output_len - tx_len;
+    espsol_buffer_writer_t sink;
+    espsol_writer_t writer;
+    espsol_buffer_writer_init(&sink, tail, tx_len, &writer);
     
-    esp_err_t err = espsol_tx_serialize(tx, buffer, sizeof(buffer), &tx_len);
+    esp_err_t err = write_wire(tx, &writer);
     if (err != ESP_OK) {
         return err;
     }
     
-    return espsol_base58_encode(buffer, tx_len, output, output_len);
+    return espsol_base58_encode(tail, tx_len, output, output_len);
 }
 
 /* ============================================================================
@@ -839,7 +1951,7 @@ esp_err_t espsol_tx_get_signature(espsol_tx_handle_t tx,
         return ESP_ERR_INVALID_ARG;
     }
     
-    memcpy(signature, tx->signatures[index], ESPSOL_SIGNATURE_SIZE);
+    memcpy(signature, signature_slot(tx, index), ESPSOL_SIGNATURE_SIZE);
     return ESP_OK;
 }
 
@@ -854,7 +1966,7 @@ esp_err_t espsol_tx_get_signature_base58(espsol_tx_handle_t tx,
         return ESP_ERR_ESPSOL_TX_NOT_SIGNED;
     }
     
-    return espsol_base58_encode(tx->signatures[0], ESPSOL_SIGNATURE_SIZE,
+    return espsol_base58_encode(signature_slot(tx, 0), ESPSOL_SIGNATURE_SIZE,
                                  output, output_len);
 }
 
@@ -883,3 +1995,222 @@ esp_err_t espsol_tx_get_account_count(espsol_tx_handle_t tx, size_t *count)
     *count = tx->account_count;
     return ESP_OK;
 }
+
+/* ============================================================================
+ * Size Estimation
+ * ========================================================================== */
+
+/**
+ * @brief Add the fee payer to key and signer totals unless an instruction counted it
+ */
+static void count_fee_payer(const struct espsol_transaction *tx, size_t *keys, size_t *signers)
+{
+    if (!tx->has_fee_payer) {
+        return;
+    }
+    int index = find_key(tx, tx->fee_payer);
+    uint8_t flags = index < 0 ? 0 : key_at(tx, (size_t)index)->flags;
+    if (!(flags & KEY_USED)) {
+        (*keys)++;
+    }
+    if (!(flags & KEY_SIGNER)) {
+        (*signers)++;
+    }
+}
+
+/**
+ * @brief Wire bytes of the lookup entries of a compiled v0 message
+ */
+static size_t lookups_wire_len(const struct espsol_transaction *tx, size_t *tables_used)
+{
+    size_t writable[ESPSOL_MAX_LOOKUP_TABLES] = {0};
+    size_t readonly[ESPSOL_MAX_LOOKUP_TABLES] = {0};
+    
+    for (size_t i = tx->static_count; i < tx->account_count; i++) {
+        const tx_key_t *key = account_at(tx, i);
+        if (key_flags(tx, key) & KEY_WRITABLE) {
+            writable[key->lookup_table]++;
+        } else {
+            readonly[key->lookup_table]++;
+        }
+    }
+    
+    size_t len = 0;
+    *tables_used = 0;
+    for (size_t t = 0; t < tx->lookup_table_count; t++) {
+        if (writable[t] + readonly[t] == 0) {
+            continue;
+        }
+        (*tables_used)++;
+        len += ESPSOL_PUBKEY_SIZE + compact_u16_len(writable[t]) + writable[t] +
+               compact_u16_len(readonly[t]) + readonly[t];
+    }
+    return len;
+}
+
+/**
+ * @brief Static keys, signers and lookup section of the message as it stands
+ *
+ * Without lookup tables this is O(1) from the running counts. With
+ * tables the accounts are compiled (once) to see which ones are loaded.
+ */
+static esp_err_t message_totals(struct espsol_transaction *tx, size_t *keys, size_t *signers,
+                                size_t *tables_used, size_t *lookups_len)
+{
+    *keys = tx->used_keys;
+    *signers = tx->signer_keys;
+    count_fee_payer(tx, keys, signers);
+    *tables_used = 0;
+    *lookups_len = 0;
+    
+    if (tx->lookup_table_count > 0) {
+        esp_err_t err = build_accounts(tx);
+        if (err != ESP_OK) {
+            return err;
+        }
+        *keys = tx->static_count;
+        *lookups_len = lookups_wire_len(tx, tables_used);
+    }
+    return ESP_OK;
+}
+
+/**
+ * @brief Wire size of a signed transaction with the given totals
+ */
+static size_t wire_size(const struct espsol_transaction *tx, size_t keys, size_t signers,
+                        size_t instructions, size_t instructions_len,
+                        size_t tables_used, size_t lookups_len)
+{
+    size_t size = compact_u16_len(signers) + signers * ESPSOL_SIGNATURE_SIZE +
+                  3 + compact_u16_len(keys) + keys * ESPSOL_PUBKEY_SIZE +
+                  ESPSOL_BLOCKHASH_SIZE + compact_u16_len(instructions) + instructions_len;
+    
+    if (tx->version == ESPSOL_TX_VERSION_0) {
+        size += 1 + compact_u16_len(tables_used) + lookups_len;
+    }
+    return size;
+}
+
+esp_err_t espsol_tx_get_size(espsol_tx_handle_t tx, size_t *size)
+{
+    if (!tx || !size) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    size_t keys, signers, tables_used, lookups_len;
+    esp_err_t err = message_totals(tx, &keys, &signers, &tables_used, &lookups_len);
+    if (err != ESP_OK) {
+        return err;
+    }
+    
+    *size = wire_size(tx, keys, signers, tx->instruction_count, tx->wire_len,
+                      tables_used, lookups_len);
+    return ESP_OK;
+}
+
+esp_err_t espsol_tx_instruction_fits(espsol_tx_handle_t tx,
+                                      const uint8_t program_id[ESPSOL_PUBKEY_SIZE],
+                                      const espsol_account_meta_t *accounts,
+                                      size_t account_count,
+                                      size_t data_len,
+                                      size_t *size)
+{
+    espsol_tx_cost_t cost;
+    esp_err_t err = espsol_tx_instruction_cost(tx, program_id, accounts, account_count,
+                                               data_len, &cost);
+    if (err != ESP_OK) {
+        return err;
+    }
+    
+    if (tx->instruction_count >= ESPSOL_MAX_INSTRUCTIONS) {
+        return ESP_ERR_ESPSOL_MAX_INSTRUCTIONS;
+    }
+    
+    size_t keys, signers, tables_used, lookups_len;
+    err = message_totals(tx, &keys, &signers, &tables_used, &lookups_len);
+    if (err != ESP_OK) {
+        return err;
+    }
+    
+    /* New accounts count as static keys. With lookup tables, a new signer
+     * may be a loaded account that has to move into the static keys. */
+    size_t total = (tx->lookup_table_count > 0 ? tx->account_count : keys) + cost.new_keys;
+    keys += cost.new_keys;
+    if (tx->lookup_table_count > 0) {
+        keys += cost.new_signers;
+    }
+    signers += cost.new_signers;
+    
+    size_t new_size = wire_size(tx, keys, signers, tx->instruction_count + 1,
+                                tx->wire_len + cost.instruction_bytes, tables_used, lookups_len);
+    if (size) {
+        *size = new_size;
+    }
+    
+    if (total > ESPSOL_MAX_LOADED_ACCOUNTS || keys > ESPSOL_MAX_ACCOUNTS ||
+        signers > ESPSOL_MAX_SIGNERS) {
+        return ESP_ERR_ESPSOL_MAX_ACCOUNTS;
+    }
+    if (data_len > ESPSOL_MAX_INSTRUCTION_DATA || new_size > ESPSOL_MAX_TX_SIZE) {
+        return ESP_ERR_ESPSOL_BUFFER_TOO_SMALL;
+    }
+    return ESP_OK;
+}
+
+/* ============================================================================
+ * Fee Calculation
+ * ========================================================================== */
+
+esp_err_t espsol_tx_calculate_fee(espsol_tx_handle_t tx, uint64_t *lamports)
+{
+    if (!tx || !lamports) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    esp_err_t err = compile_accounts(tx);
+    if (err != ESP_OK) {
+        return err;
+    }
+    
+    /* Scan Compute Budget instructions for the requested limit and price */
+    bool has_limit = false;
+    uint32_t cu_limit = 0;
+    uint64_t cu_price = 0;
+    size_t other_instructions = 0;
+    
+    size_t record = 0;
+    for (size_t i = 0; i < tx->instruction_count; i++) {
+        const uint8_t *data;
+        const tx_ix_t *ix = next_record(tx, &record, NULL, &data);
+        
+        if (!pubkey_equals(key_at(tx, ix->program)->pubkey, ESPSOL_COMPUTE_BUDGET_PROGRAM_ID)) {
+            other_instructions++;
+            continue;
+        }
+        
+        if (ix->data_len == 5 && data[0] == 2) {
+            /* SetComputeUnitLimit: u8 tag, u32 units */
+            cu_limit = 0;
+            for (int b = 0; b < 4; b++) {
+                cu_limit |= (uint32_t)data[1 + b] << (b * 8);
+            }
+            has_limit = true;
+        } else if (ix->data_len == 9 && data[0] == 3) {
+            /* SetComputeUnitPrice: u8 tag, u64 micro-lamports */
+            cu_price = 0;
+            for (int b = 0; b < 8; b++) {
+                cu_price |= (uint64_t)data[1 + b] << (b * 8);
+            }
+        }
+    }
+    
+    if (!has_limit) {
+        uint64_t units = (uint64_t)other_instructions * ESPSOL_DEFAULT_INSTRUCTION_COMPUTE_UNITS;
+        cu_limit = (uint32_t)(units > ESPSOL_MAX_COMPUTE_UNIT_LIMIT ?
+                              ESPSOL_MAX_COMPUTE_UNIT_LIMIT : units);
+    } else if (cu_limit > ESPSOL_MAX_COMPUTE_UNIT_LIMIT) {
+        cu_limit = ESPSOL_MAX_COMPUTE_UNIT_LIMIT;
+    }
+    
+    return espsol_fee_calculate(tx->required_signers, cu_limit, cu_price, lamports);
+}
@@ -0,0 +1,469 @@
+/**
+ * @file espsol_view.c
+ * @brief ESPSOL Wire Transaction Parser Implementation
+ *
+ * Parsing is a single bounds-checked pass that records where each
+ * section starts. Accessors walk the recorded sections again, which is
+ * safe without further checks because the parse already proved every
+ * length fits.
+ *
+ * @copyright Copyright (c) 2025 SkyRizz
+ * @license Apache-2.0
+ */
+
+#include "espsol_view.h"
+#include "espsol_crypto.h"
+#include "espsol_tx_internal.h"
+
+#include <string.h>
+
+#if defined(ESP_PLATFORM) && ESP_PLATFORM
+#include "esp_log.h"
+static const char *TAG = "espsol_view";
+#else
+#define ESP_LOGI(tag, ...)
+#define ESP_LOGW(tag, ...)
+#define ESP_LOGE(tag, ...)
+#define ESP_LOGD(tag, ...)
+#endif
+
+/** Version prefix bit of a versioned message */
+#define MESSAGE_VERSION_PREFIX  0x80
+
+/** Accounts a message can address with one-byte indexes */
+#define MAX_ACCOUNT_INDEXES     256
+
+/* ============================================================================
+ * Internal Helper Functions
+ * ========================================================================== */
+
+/**
+ * @brief Skip a compact array of count elements of size bytes each
+ */
+static bool skip_array(const uint8_t *buf, size_t len, size_t *pos, size_t size, size_t *count)
+{
+    if (!espsol_tx_read_compact_u16(buf, len, pos, count) || *count * size > len - *pos) {
+        return false;
+    }
+    *pos += *count * size;
+    return true;
+}
+
+static esp_err_t parse_message(const uint8_t *message, size_t len, espsol_tx_view_t *view)
+{
+    size_t pos = 0;
+
+    if (len == 0) {
+        return ESP_ERR_ESPSOL_ENCODING_FAILED;
+    }
+    if (message[0] & MESSAGE_VERSION_PREFIX) {
+        if ((message[0] & ~MESSAGE_VERSION_PREFIX) != 0) {
+            ESP_LOGE(TAG, "Unsupported message version %u", message[0] & ~MESSAGE_VERSION_PREFIX);
+            return ESP_ERR_NOT_SUPPORTED;
+        }
+        view->version = ESPSOL_TX_VERSION_0;
+        pos = 1;
+    } else {
+        view->version = ESPSOL_TX_VERSION_LEGACY;
+    }
+
+    /* Header, keys and blockhash */
+    if (len - pos < 3) {
+        return ESP_ERR_ESPSOL_ENCODING_FAILED;
+    }
+    view->required_signatures = message[pos];
+    view->readonly_signed = message[pos + 1];
+    view->readonly_unsigned = message[pos + 2];
+    pos += 3;
+
+    if (!skip_array(message, len, &pos, ESPSOL_PUBKEY_SIZE, &view->key_count)) {
+        return ESP_ERR_ESPSOL_ENCODING_FAILED;
+    }
+    view->keys = message + pos - view->key_count * ESPSOL_PUBKEY_SIZE;
+
+    if (len - pos < ESPSOL_BLOCKHASH_SIZE) {
+        return ESP_ERR_ESPSOL_ENCODING_FAILED;
+    }
+    view->blockhash = message + pos;
+    pos += ESPSOL_BLOCKHASH_SIZE;
+
+    /* Instructions: program index, account indexes, data */
+    if (!espsol_tx_read_compact_u16(message, len, &pos, &view->instruction_count)) {
+        return ESP_ERR_ESPSOL_ENCODING_FAILED;
+    }
+    view->instructions = message + pos;
+    for (size_t i = 0; i < view->instruction_count; i++) {
+        size_t count;
+        if (pos >= len) {
+            return ESP_ERR_ESPSOL_ENCODING_FAILED;
+        }
+        pos++;
+        if (!skip_array(message, len, &pos, 1, &count) ||
+            !skip_array(message, len, &pos, 1, &count)) {
+            return ESP_ERR_ESPSOL_ENCODING_FAILED;
+        }
+    }
+
+    /* Lookups: table key, writable indexes, read-only indexes */
+    view->lookups = NULL;
+    view->lookup_count = 0;
+    view->loaded_writable = 0;
+    view->loaded_readonly = 0;
+    if (view->version == ESPSOL_TX_VERSION_0) {
+        if (!espsol_tx_read_compact_u16(message, len, &pos, &view->lookup_count)) {
+            return ESP_ERR_ESPSOL_ENCODING_FAILED;
+        }
+        view->lookups = message + pos;
+        for (size_t i = 0; i < view->lookup_count; i++) {
+            size_t writable, readonly;
+            if (len - pos < ESPSOL_PUBKEY_SIZE) {
+                return ESP_ERR_ESPSOL_ENCODING_FAILED;
+            }
+            pos += ESPSOL_PUBKEY_SIZE;
+            if (!skip_array(message, len, &pos, 1, &writable) ||
+                !skip_array(message, len, &pos, 1, &readonly)) {
+                return ESP_ERR_ESPSOL_ENCODING_FAILED;
+            }
+            view->loaded_writable += writable;
+            view->loaded_readonly += readonly;
+        }
+    }
+
+    if (pos != len) {
+        ESP_LOGE(TAG, "%u trailing bytes after message", (unsigned)(len - pos));
+        return ESP_ERR_ESPSOL_ENCODING_FAILED;
+    }
+
+    view->message = message;
+    view->message_len = len;
+    return ESP_OK;
+}
+
+/* ============================================================================
+ * Parsing
+ * ========================================================================== */
+
+esp_err_t espsol_tx_view_parse(const uint8_t *data, size_t len, espsol_tx_view_t *view)
+{
+    if (!data || !view) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    memset(view, 0, sizeof(*view));
+
+    size_t pos = 0;
+    size_t signature_count;
+    if (!skip_array(data, len, &pos, ESPSOL_SIGNATURE_SIZE, &signature_count)) {
+        return ESP_ERR_ESPSOL_ENCODING_FAILED;
+    }
+
+    esp_err_t err = parse_message(data + pos, len - pos, view);
+    if (err != ESP_OK) {
+        memset(view, 0, sizeof(*view));
+        return err;
+    }
+
+    view->wire = data;
+    view->wire_len = len;
+    view->signatures = data + pos - signature_count * ESPSOL_SIGNATURE_SIZE;
+    view->signature_count = signature_count;
+    return ESP_OK;
+}
+
+esp_err_t espsol_tx_view_parse_message(const uint8_t *message, size_t len,
+                                        espsol_tx_view_t *view)
+{
+    if (!message || !view) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    memset(view, 0, sizeof(*view));
+    esp_err_t err = parse_message(message, len, view);
+    if (err != ESP_OK) {
+        memset(view, 0, sizeof(*view));
+    }
+    return err;
+}
+
+esp_err_t espsol_tx_view_validate(const espsol_tx_view_t *view)
+{
+    if (!view || !view->message) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    /* A bare message still needs room for its signatures */
+    size_t size = view->wire ? view->wire_len
+                             : 1 + view->required_signatures * ESPSOL_SIGNATURE_SIZE + view->message_len;
+    if (size > ESPSOL_MAX_TX_SIZE) {
+        ESP_LOGE(TAG, "Transaction is %u bytes", (unsigned)size);
+        return ESP_ERR_ESPSOL_BUFFER_TOO_SMALL;
+    }
+
+    /* Header: at least a writable fee payer, counts within the keys */
+    if (view->required_signatures == 0 ||
+        view->readonly_signed >= view->required_signatures ||
+        (size_t)view->required_signatures + view->readonly_unsigned > view->key_count) {
+        ESP_LOGE(TAG, "Invalid message header");
+        return ESP_ERR_ESPSOL_TX_BUILD_ERROR;
+    }
+    if (view->wire && view->signature_count != view->required_signatures) {
+        ESP_LOGE(TAG, "%u signature slots for %u signers",
+                 (unsigned)view->signature_count, view->required_signatures);
+        return ESP_ERR_ESPSOL_TX_BUILD_ERROR;
+    }
+
+    size_t total = view->key_count + view->loaded_writable + view->loaded_readonly;
+    if (total > MAX_ACCOUNT_INDEXES) {
+        return ESP_ERR_ESPSOL_TX_BUILD_ERROR;
+    }
+
+    for (size_t i = 1; i < view->key_count; i++) {
+        const uint8_t *key = view->keys + i * ESPSOL_PUBKEY_SIZE;
+        for (size_t j = 0; j < i; j++) {
+            if (memcmp(key, view->keys + j * ESPSOL_PUBKEY_SIZE, ESPSOL_PUBKEY_SIZE) == 0) {
+                ESP_LOGE(TAG, "Account %u duplicates account %u", (unsigned)i, (unsigned)j);
+                return ESP_ERR_ESPSOL_TX_BUILD_ERROR;
+            }
+        }
+    }
+
+    /* Programs are static keys other than the fee payer */
+    espsol_tx_view_instruction_t ix;
+    for (size_t i = 0; i < view->instruction_count; i++) {
+        espsol_tx_view_get_instruction(view, i, &ix);
+        if (ix.program_index == 0 || ix.program_index >= view->key_count) {
+            ESP_LOGE(TAG, "Instruction %u: invalid program index", (unsigned)i);
+            return ESP_ERR_ESPSOL_TX_BUILD_ERROR;
+        }
+        for (size_t a = 0; a < ix.account_count; a++) {
+            if (ix.accounts[a] >= total) {
+                ESP_LOGE(TAG, "Instruction %u: account index out of range", (unsigned)i);
+                return ESP_ERR_ESPSOL_TX_BUILD_ERROR;
+            }
+        }
+    }
+
+    espsol_tx_view_lookup_t lookup;
+    for (size_t i = 0; i < view->lookup_count; i++) {
+        espsol_tx_view_get_lookup(view, i, &lookup);
+        if (lookup.writable_count + lookup.readonly_count == 0) {
+            ESP_LOGE(TAG, "Lookup %u loads no accounts", (unsigned)i);
+            return ESP_ERR_ESPSOL_TX_BUILD_ERROR;
+        }
+    }
+
+    return ESP_OK;
+}
+
+/* ============================================================================
+ * Accessors
+ * ========================================================================== */
+
+esp_err_t espsol_tx_view_get_instruction(const espsol_tx_view_t *view, size_t index,
+                                         espsol_tx_view_instruction_t *ix)
+{
+    if (!view || !ix || index >= view->instruction_count) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    /* Bounds were checked by the parse */
+    const uint8_t *end = view->message + view->message_len;
+    size_t len = (size_t)(end - view->instructions);
+    size_t pos = 0;
+    for (size_t i = 0; ; i++) {
+        ix->program_index = view->instructions[pos++];
+        espsol_tx_read_compact_u16(view->instructions, len, &pos, &ix->account_count);
+        ix->accounts = view->instructions + pos;
+        pos += ix->account_count;
+        espsol_tx_read_compact_u16(view->instructions, len, &pos, &ix->data_len);
+        ix->data = view->instructions + pos;
+        pos += ix->data_len;
+        if (i == index) {
+            return ESP_OK;
+        }
+    }
+}
+
+esp_err_t espsol_tx_view_get_lookup(const espsol_tx_view_t *view, size_t index,
+                                    espsol_tx_view_lookup_t *lookup)
+{
+    if (!view || !lookup || index >= view->lookup_count) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    const uint8_t *end = view->message + view->message_len;
+    size_t len = (size_t)(end - view->lookups);
+    size_t pos = 0;
+    for (size_t i = 0; ; i++) {
+        lookup->key = view->lookups + pos;
+        pos += ESPSOL_PUBKEY_SIZE;
+        espsol_tx_read_compact_u16(view->lookups, len, &pos, &lookup->writable_count);
+        lookup->writable = view->lookups + pos;
+        pos += lookup->writable_count;
+        espsol_tx_read_compact_u16(view->lookups, len, &pos, &lookup->readonly_count);
+        lookup->readonly = view->lookups + pos;
+        pos += lookup->readonly_count;
+        if (i == index) {
+            return ESP_OK;
+        }
+    }
+}
+
+const uint8_t *espsol_tx_view_get_key(const espsol_tx_view_t *view, size_t index)
+{
+    if (!view || index >= view->key_count) {
+        return NULL;
+    }
+    return view->keys + index * ESPSOL_PUBKEY_SIZE;
+}
+
+esp_err_t espsol_tx_view_find_key(const espsol_tx_view_t *view,
+                                  const uint8_t pubkey[ESPSOL_PUBKEY_SIZE],
+                                  size_t *index)
+{
+    if (!view || !pubkey || !index) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    for (size_t i = 0; i < view->key_count; i++) {
+        if (memcmp(view->keys + i * ESPSOL_PUBKEY_SIZE, pubkey, ESPSOL_PUBKEY_SIZE) == 0) {
+            *index = i;
+            return ESP_OK;
+        }
+    }
+    return ESP_ERR_NOT_FOUND;
+}
+
+bool espsol_tx_view_is_signer(const espsol_tx_view_t *view, size_t index)
+{
+    return view && index < view->required_signatures && index < view->key_count;
+}
+
+bool espsol_tx_view_is_writable(const espsol_tx_view_t *view, size_t index)
+{
+    if (!view) {
+        return false;
+    }
+
+    if (index < view->required_signatures) {
+        return index + view->readonly_signed < view->required_signatures;
+    }
+    if (index < view->key_count) {
+        return index + view->readonly_unsigned < view->key_count;
+    }
+    return index - view->key_count < view->loaded_writable;
+}
+
+bool espsol_tx_view_is_signed(const espsol_tx_view_t *view, size_t index)
+{
+    if (!view || index >= view->signature_count) {
+        return false;
+    }
+
+    const uint8_t *slot = view->signatures + index * ESPSOL_SIGNATURE_SIZE;
+    uint8_t any = 0;
+    for (size_t i = 0; i < ESPSOL_SIGNATURE_SIZE; i++) {
+        any |= slot[i];
+    }
+    return any != 0;
+}
+
+/* ============================================================================
+ * Signing Serialized Transactions
+ * ========================================================================== */
+
+/**
+ * @brief Parse wire and find the signature slot of pubkey
+ */
+static esp_err_t find_slot(const uint8_t *wire, size_t len, const uint8_t pubkey[ESPSOL_PUBKEY_SIZE],
+                           espsol_tx_view_t *view, size_t *slot)
+{
+    esp_err_t err = espsol_tx_view_parse(wire, len, view);
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    /* Slots map to the signer keys only when the counts agree */
+    if (view->signature_count != view->required_signatures ||
+        view->required_signatures > view->key_count) {
+        ESP_LOGE(TAG, "Signature slots do not match the header");
+        return ESP_ERR_ESPSOL_TX_BUILD_ERROR;
+    }
+
+    if (espsol_tx_view_find_key(view, pubkey, slot) != ESP_OK || !espsol_tx_view_is_signer(view, *slot)) {
+        ESP_LOGE(TAG, "Public key not found in required signers");
+        return ESP_ERR_ESPSOL_TX_BUILD_ERROR;
+    }
+    return ESP_OK;
+}
+
+esp_err_t espsol_tx_wire_sign(uint8_t *wire, size_t len, const espsol_keypair_t *keypair)
+{
+    if (!wire || !keypair) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    espsol_tx_view_t view;
+    size_t slot;
+    esp_err_t err = find_slot(wire, len, keypair->public_key, &view, &slot);
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    uint8_t *signature = wire + (view.signatures - wire) + slot * ESPSOL_SIGNATURE_SIZE;
+    if (espsol_sign(view.message, view.message_len, keypair, signature) != ESP_OK) {
+        return ESP_ERR_ESPSOL_CRYPTO_ERROR;
+    }
+    return ESP_OK;
+}
+
+esp_err_t espsol_tx_wire_add_signature(uint8_t *wire, size_t len,
+                                       const uint8_t pubkey[ESPSOL_PUBKEY_SIZE],
+                                       const uint8_t signature[ESPSOL_SIGNATURE_SIZE])
+{
+    if (!wire || !pubkey || !signature) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    espsol_tx_view_t view;
+    size_t slot;
+    esp_err_t err = find_slot(wire, len, pubkey, &view, &slot);
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    if (espsol_verify(view.message, view.message_len, signature, pubkey) != ESP_OK) {
+        ESP_LOGE(TAG, "Signature does not match the message");
+        return ESP_ERR_ESPSOL_SIGNATURE_INVALID;
+    }
+
+    memcpy(wire + (view.signatures - wire) + slot * ESPSOL_SIGNATURE_SIZE, signature, ESPSOL_SIGNATURE_SIZE);
+    return ESP_OK;
+}
+
+esp_err_t espsol_tx_view_verify_signatures(const espsol_tx_view_t *view, size_t *invalid_index)
+{
+    if (!view) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (!view->signatures || view->signature_count != view->required_signatures ||
+        view->required_signatures > view->key_count) {
+        ESP_LOGE(TAG, "Signature slots do not match the header");
+        return ESP_ERR_ESPSOL_TX_BUILD_ERROR;
+    }
+
+    for (size_t i = 0; i < view->signature_count; i++) {
+        if (!espsol_tx_view_is_signed(view, i)) {
+            if (invalid_index) {
+                *invalid_index = i;
+            }
+            return ESP_ERR_ESPSOL_TX_NOT_SIGNED;
+        }
+    }
+
+    return espsol_verify_signers(view->message, view->message_len,
+                                 (const uint8_t (*)[ESPSOL_SIGNATURE_SIZE])view->signatures,
+                                 (const uint8_t (*)[ESPSOL_PUBKEY_SIZE])view->keys,
+                                 view->signature_count, invalid_index);
+}
@@ -0,0 +1,232 @@
+/**
+ * @file espsol_worker.c
+ * @brief ESPSOL Background Worker Implementation
+ *
+ * @copyright Copyright (c) 2025 SkyRizz
+ * @license Apache-2.0
+ */
+
+#include "espsol_worker.h"
+
+#include <stdlib.h>
+
+#if defined(ESP_PLATFORM) && ESP_PLATFORM
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#else
+#include <pthread.h>
+#endif
+
+/* ============================================================================
+ * Worker Structure
+ * ========================================================================== */
+
+struct espsol_worker {
+#if defined(ESP_PLATFORM) && ESP_PLATFORM
+    SemaphoreHandle_t start;    /**< Given to start a job (or stop) */
+    SemaphoreHandle_t idle;     /**< Available while no job is running */
+#else
+    pthread_t thread;           /**< Worker thread */
+    pthread_mutex_t lock;       /**< Protects the fields below */
+    pthread_cond_t changed;     /**< Signalled on any state change */
+    bool pending;               /**< A job is queued or running */
+#endif
+    espsol_worker_fn_t fn;      /**< Current job */
+    void *arg;                  /**< Current job argument */
+    bool stop;                  /**< Worker should exit */
+};
+
+#if defined(ESP_PLATFORM) && ESP_PLATFORM
+
+/* ============================================================================
+ * FreeRTOS Implementation
+ * ========================================================================== */
+
+static void worker_task(void *param)
+{
+    espsol_worker_t worker = param;
+
+    for (;;) {
+        xSemaphoreTake(worker->start, portMAX_DELAY);
+        if (worker->stop) {
+            break;
+        }
+        worker->fn(worker->arg);
+        xSemaphoreGive(worker->idle);
+    }
+
+    xSemaphoreGive(worker->idle);
+    vTaskDelete(NULL);
+}
+
+esp_err_t espsol_worker_create(const char *name, uint32_t stack_size, espsol_worker_t *worker)
+{
+    if (!worker) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    espsol_worker_t w = calloc(1, sizeof(*w));
+    if (!w) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    w->start = xSemaphoreCreateBinary();
+    w->idle = xSemaphoreCreateBinary();
+    if (!w->start || !w->idle) {
+        goto fail;
+    }
+    xSemaphoreGive(w->idle);
+
+    if (xTaskCreate(worker_task, name ? name : "espsol_worker", stack_size,
+                    w, tskIDLE_PRIORITY + 5, NULL) != pdPASS) {
+        goto fail;
+    }
+
+    *worker = w;
+    return ESP_OK;
+
+fail:
+    if (w->start) {
+        vSemaphoreDelete(w->start);
+    }
+    if (w->idle) {
+        vSemaphoreDelete(w->idle);
+    }
+    free(w);
+    return ESP_ERR_NO_MEM;
+}
+
+void espsol_worker_submit(espsol_worker_t worker, espsol_worker_fn_t fn, void *arg)
+{
+    xSemaphoreTake(worker->idle, portMAX_DELAY);
+    worker->fn = fn;
+    worker->arg = arg;
+    xSemaphoreGive(worker->start);
+}
+
+void espsol_worker_wait(espsol_worker_t worker)
+{
+    xSemaphoreTake(worker->idle, portMAX_DELAY);
+    xSemaphoreGive(worker->idle);
+}
+
+void espsol_worker_destroy(espsol_worker_t worker)
+{
+    if (!worker) {
+        return;
+    }
+
+    xSemaphoreTake(worker->idle, portMAX_DELAY);
+    worker->stop = true;
+    xSemaphoreGive(worker->start);
+
+    /* The task gives idle once more on its way out */
+    xSemaphoreTake(worker->idle, portMAX_DELAY);
+
+    vSemaphoreDelete(worker->start);
+    vSemaphoreDelete(worker->idle);
+    free(worker);
+}
+
+#else
+
+/* ============================================================================
+ * pthread Implementation (host builds)
+ * ========================================================================== */
+
+static void *worker_thread(void *param)
+{
+    espsol_worker_t worker = param;
+
+    pthread_mutex_lock(&worker->lock);
+    for (;;) {
+        while (!worker->pending && !worker->stop) {
+            pthread_cond_wait(&worker->changed, &worker->lock);
+        }
+        if (!worker->pending) {
+            break;
+        }
+
+        pthread_mutex_unlock(&worker->lock);
+        worker->fn(worker->arg);
+        pthread_mutex_lock(&worker->lock);
+
+        worker->pending = false;
+        pthread_cond_broadcast(&worker->changed);
+    }
+    pthread_mutex_unlock(&worker->lock);
+
+    return NULL;
+}
+
+esp_err_t espsol_worker_create(const char *name, uint32_t stack_size, espsol_worker_t *worker)
+{
+    (void)name;
+    (void)stack_size;
+
+    if (!worker) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    espsol_worker_t w = calloc(1, sizeof(*w));
+    if (!w) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    pthread_mutex_init(&w->lock, NULL);
+    pthread_cond_init(&w->changed, NULL);
+
+    if (pthread_create(&w->thread, NULL, worker_thread, w) != 0) {
+        pthread_cond_destroy(&w->changed);
+        pthread_mutex_destroy(&w->lock);
+        free(w);
+        return ESP_ERR_NO_MEM;
+    }
+
+    *worker = w;
+    return ESP_OK;
+}
+
+void espsol_worker_submit(espsol_worker_t worker, espsol_worker_fn_t fn, void *arg)
+{
+    pthread_mutex_lock(&worker->lock);
+    while (worker->pending) {
+        pthread_cond_wait(&worker->changed, &worker->lock);
+    }
+    worker->fn = fn;
+    worker->arg = arg;
+    worker->pending = true;
+    pthread_cond_broadcast(&worker->changed);
+    pthread_mutex_unlock(&worker->lock);
+}
+
+void espsol_worker_wait(espsol_worker_t worker)
+{
+    pthread_mutex_lock(&worker->lock);
+    while (worker->pending) {
+        pthread_cond_wait(&worker->changed, &worker->lock);
+    }
+    pthread_mutex_unlock(&worker->lock);
+}
+
+void espsol_worker_destroy(espsol_worker_t worker)
+{
+    if (!worker) {
+        return;
+    }
+
+    pthread_mutex_lock(&worker->lock);
+    worker->stop = true;
+    pthread_cond_broadcast(&worker->changed);
+    pthread_mutex_unlock(&worker->lock);
+
+    /* The thread finishes a pending job before it exits */
+    pthread_join(worker->thread, NULL);
+
+    pthread_cond_destroy(&worker->changed);
+    pthread_mutex_destroy(&worker->lock);
+    free(worker);
+}
+
+#endif /* ESP_PLATFORM */
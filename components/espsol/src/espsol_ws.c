@@ -42,6 +42,7 @@ struct espsol_ws_client {
     SemaphoreHandle_t mutex;                     /**< Thread-safety mutex */
     subscription_entry_t subscriptions[ESPSOL_WS_MAX_SUBSCRIPTIONS]; /**< Active subscriptions */
     int next_request_id;                         /**< JSON-RPC request ID counter */
+    espsol_call_options_t call_options;          /**< Per-call deadline and cancellation */
 };
 
 /* ============================================================================
@@ -53,7 +54,8 @@ static void websocket_event_handler(void *handler_args, esp_event_base_t base,
 static esp_err_t send_jsonrpc_request(espsol_ws_handle_t handle,
                                       const char *method,
                                       cJSON *params,
-                                      int *request_id);
+                                      int *request_id,
+                                      const espsol_deadline_t *deadline);
 static void process_notification(espsol_ws_handle_t handle, cJSON *json);
 static void process_response(espsol_ws_handle_t handle, cJSON *json);
 
@@ -217,15 +219,51 @@ static void websocket_event_handler(void *handler_args, esp_event_base_t base,
  * JSON-RPC Message Processing
  * ========================================================================== */
 
+/**
+ * @brief Take the client lock within the call deadline
+ *
+ * Waits in short slices so a cancellation is noticed while another task
+ * holds the lock.
+ */
+static esp_err_t ws_lock(espsol_ws_handle_t handle, espsol_deadline_t *deadline)
+{
+    espsol_deadline_start(deadline, &handle->call_options);
+
+    if (deadline->expires_us == 0 && !deadline->cancel) {
+        xSemaphoreTake(handle->mutex, portMAX_DELAY);
+        return ESP_OK;
+    }
+
+    for (;;) {
+        esp_err_t err = espsol_deadline_check(deadline);
+        if (err != ESP_OK) {
+            return err;
+        }
+
+        uint32_t wait_ms = espsol_deadline_remaining_ms(deadline, ESPSOL_CANCEL_POLL_MS);
+        if (xSemaphoreTake(handle->mutex, pdMS_TO_TICKS(wait_ms)) == pdTRUE) {
+            return ESP_OK;
+        }
+    }
+}
+
 static esp_err_t send_jsonrpc_request(espsol_ws_handle_t handle,
                                       const char *method,
                                       cJSON *params,
-                                      int *request_id)
+                                      int *request_id,
+                                      const espsol_deadline_t *deadline)
 {
     if (!handle || !method) {
+        cJSON_Delete(params);
         return ESP_ERR_INVALID_ARG;
     }
 
+    esp_err_t err = espsol_deadline_check(deadline);
+    if (err != ESP_OK) {
+        cJSON_Delete(params);
+        return err;
+    }
+
     // Get next request ID
     int id = handle->next_request_id++;
 
@@ -256,7 +294,8 @@ static esp_err_t send_jsonrpc_request(espsol_ws_handle_t handle,
     // Send via WebSocket
     int sent = esp_websocket_client_send_text(handle->ws_handle, json_str, 
                                               strlen(json_str), 
-                                              pdMS_TO_TICKS(handle->config.timeout_ms));
+                                              pdMS_TO_TICKS(espsol_deadline_remaining_ms(
+                                                  deadline, handle->config.timeout_ms)));
     
     free(json_str);
 
@@ -556,6 +595,23 @@ esp_err_t espsol_ws_is_connected(espsol_ws_handle_t handle, bool *connected)
     return ESP_OK;
 }
 
+esp_err_t espsol_ws_set_call_options(espsol_ws_handle_t handle,
+                                     const espsol_call_options_t *options)
+{
+    if (!handle) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (options) {
+        handle->call_options = *options;
+    } else {
+        espsol_call_options_t defaults = ESPSOL_CALL_OPTIONS_DEFAULT();
+        handle->call_options = defaults;
+    }
+
+    return ESP_OK;
+}
+
 /* ============================================================================
  * Subscription API Implementation
  * ========================================================================== */
@@ -568,7 +624,11 @@ esp_err_t espsol_ws_account_subscribe(espsol_ws_handle_t handle,
         return ESP_ERR_INVALID_ARG;
     }
 
-    xSemaphoreTake(handle->mutex, portMAX_DELAY);
+    espsol_deadline_t deadline;
+    esp_err_t lock_err = ws_lock(handle, &deadline);
+    if (lock_err != ESP_OK) {
+        return lock_err;
+    }
 
     // Build parameters
     cJSON *params = cJSON_CreateArray();
@@ -582,7 +642,7 @@ esp_err_t espsol_ws_account_subscribe(espsol_ws_handle_t handle,
     cJSON_AddItemToArray(params, config);
 
     int request_id;
-    esp_err_t ret = send_jsonrpc_request(handle, "accountSubscribe", params, &request_id);
+    esp_err_t ret = send_jsonrpc_request(handle, "accountSubscribe", params, &request_id, &deadline);
     
     if (ret == ESP_OK && subscription_id) {
         *subscription_id = request_id; // Temporary, will be updated on response
@@ -600,12 +660,16 @@ esp_err_t espsol_ws_account_unsubscribe(espsol_ws_handle_t handle,
         return ESP_ERR_INVALID_ARG;
     }
 
-    xSemaphoreTake(handle->mutex, portMAX_DELAY);
+    espsol_deadline_t deadline;
+    esp_err_t lock_err = ws_lock(handle, &deadline);
+    if (lock_err != ESP_OK) {
+        return lock_err;
+    }
 
     cJSON *params = cJSON_CreateArray();
     cJSON_AddItemToArray(params, cJSON_CreateNumber(subscription_id));
 
-    esp_err_t ret = send_jsonrpc_request(handle, "accountUnsubscribe", params, NULL);
+    esp_err_t ret = send_jsonrpc_request(handle, "accountUnsubscribe", params, NULL, &deadline);
     
     if (ret == ESP_OK) {
         remove_subscription(handle, subscription_id);
@@ -623,7 +687,11 @@ esp_err_t espsol_ws_program_subscribe(espsol_ws_handle_t handle,
         return ESP_ERR_INVALID_ARG;
     }
 
-    xSemaphoreTake(handle->mutex, portMAX_DELAY);
+    espsol_deadline_t deadline;
+    esp_err_t lock_err = ws_lock(handle, &deadline);
+    if (lock_err != ESP_OK) {
+        return lock_err;
+    }
 
     cJSON *params = cJSON_CreateArray();
     cJSON_AddItemToArray(params, cJSON_CreateString(program_id));
@@ -635,7 +703,7 @@ esp_err_t espsol_ws_program_subscribe(espsol_ws_handle_t handle,
     cJSON_AddItemToArray(params, config);
 
     int request_id;
-    esp_err_t ret = send_jsonrpc_request(handle, "programSubscribe", params, &request_id);
+    esp_err_t ret = send_jsonrpc_request(handle, "programSubscribe", params, &request_id, &deadline);
     
     if (ret == ESP_OK && subscription_id) {
         *subscription_id = request_id;
@@ -653,12 +721,16 @@ esp_err_t espsol_ws_program_unsubscribe(espsol_ws_handle_t handle,
         return ESP_ERR_INVALID_ARG;
     }
 
-    xSemaphoreTake(handle->mutex, portMAX_DELAY);
+    espsol_deadline_t deadline;
+    esp_err_t lock_err = ws_lock(handle, &deadline);
+    if (lock_err != ESP_OK) {
+        return lock_err;
+    }
 
     cJSON *params = cJSON_CreateArray();
     cJSON_AddItemToArray(params, cJSON_CreateNumber(subscription_id));
 
-    esp_err_t ret = send_jsonrpc_request(handle, "programUnsubscribe", params, NULL);
+    esp_err_t ret = send_jsonrpc_request(handle, "programUnsubscribe", params, NULL, &deadline);
     
     if (ret == ESP_OK) {
         remove_subscription(handle, subscription_id);
@@ -676,7 +748,11 @@ esp_err_t espsol_ws_signature_subscribe(espsol_ws_handle_t handle,
         return ESP_ERR_INVALID_ARG;
     }
 
-    xSemaphoreTake(handle->mutex, portMAX_DELAY);
+    espsol_deadline_t deadline;
+    esp_err_t lock_err = ws_lock(handle, &deadline);
+    if (lock_err != ESP_OK) {
+        return lock_err;
+    }
 
     cJSON *params = cJSON_CreateArray();
     cJSON_AddItemToArray(params, cJSON_CreateString(signature));
@@ -687,7 +763,7 @@ esp_err_t espsol_ws_signature_subscribe(espsol_ws_handle_t handle,
     cJSON_AddItemToArray(params, config);
 
     int request_id;
-    esp_err_t ret = send_jsonrpc_request(handle, "signatureSubscribe", params, &request_id);
+    esp_err_t ret = send_jsonrpc_request(handle, "signatureSubscribe", params, &request_id, &deadline);
     
     if (ret == ESP_OK && subscription_id) {
         *subscription_id = request_id;
@@ -705,12 +781,16 @@ esp_err_t espsol_ws_signature_unsubscribe(espsol_ws_handle_t handle,
         return ESP_ERR_INVALID_ARG;
     }
 
-    xSemaphoreTake(handle->mutex, portMAX_DELAY);
+    espsol_deadline_t deadline;
+    esp_err_t lock_err = ws_lock(handle, &deadline);
+    if (lock_err != ESP_OK) {
+        return lock_err;
+    }
 
     cJSON *params = cJSON_CreateArray();
     cJSON_AddItemToArray(params, cJSON_CreateNumber(subscription_id));
 
-    esp_err_t ret = send_jsonrpc_request(handle, "signatureUnsubscribe", params, NULL);
+    esp_err_t ret = send_jsonrpc_request(handle, "signatureUnsubscribe", params, NULL, &deadline);
     
     if (ret == ESP_OK) {
         remove_subscription(handle, subscription_id);
@@ -728,7 +808,11 @@ esp_err_t espsol_ws_logs_subscribe(espsol_ws_handle_t handle,
         return ESP_ERR_INVALID_ARG;
     }
 
-    xSemaphoreTake(handle->mutex, portMAX_DELAY);
+    espsol_deadline_t deadline;
+    esp_err_t lock_err = ws_lock(handle, &deadline);
+    if (lock_err != ESP_OK) {
+        return lock_err;
+    }
 
     cJSON *params = cJSON_CreateArray();
     
@@ -747,7 +831,7 @@ esp_err_t espsol_ws_logs_subscribe(espsol_ws_handle_t handle,
     cJSON_AddItemToArray(params, config);
 
     int request_id;
-    esp_err_t ret = send_jsonrpc_request(handle, "logsSubscribe", params, &request_id);
+    esp_err_t ret = send_jsonrpc_request(handle, "logsSubscribe", params, &request_id, &deadline);
     
     if (ret == ESP_OK && subscription_id) {
         *subscription_id = request_id;
@@ -765,12 +849,16 @@ esp_err_t espsol_ws_logs_unsubscribe(espsol_ws_handle_t handle,
         return ESP_ERR_INVALID_ARG;
     }
 
-    xSemaphoreTake(handle->mutex, portMAX_DELAY);
+    espsol_deadline_t deadline;
+    esp_err_t lock_err = ws_lock(handle, &deadline);
+    if (lock_err != ESP_OK) {
+        return lock_err;
+    }
 
     cJSON *params = cJSON_CreateArray();
     cJSON_AddItemToArray(params, cJSON_CreateNumber(subscription_id));
 
-    esp_err_t ret = send_jsonrpc_request(handle, "logsUnsubscribe", params, NULL);
+    esp_err_t ret = send_jsonrpc_request(handle, "logsUnsubscribe", params, NULL, &deadline);
     
     if (ret == ESP_OK) {
         remove_subscription(handle, subscription_id);
@@ -787,12 +875,16 @@ esp_err_t espsol_ws_slot_subscribe(espsol_ws_handle_t handle,
         return ESP_ERR_INVALID_ARG;
     }
 
-    xSemaphoreTake(handle->mutex, portMAX_DELAY);
+    espsol_deadline_t deadline;
+    esp_err_t lock_err = ws_lock(handle, &deadline);
+    if (lock_err != ESP_OK) {
+        return lock_err;
+    }
 
     cJSON *params = cJSON_CreateArray();
 
     int request_id;
-    esp_err_t ret = send_jsonrpc_request(handle, "slotSubscribe", params, &request_id);
+    esp_err_t ret = send_jsonrpc_request(handle, "slotSubscribe", params, &request_id, &deadline);
     
     if (ret == ESP_OK && subscription_id) {
         *subscription_id = request_id;
@@ -810,12 +902,16 @@ esp_err_t espsol_ws_slot_unsubscribe(espsol_ws_handle_t handle,
         return ESP_ERR_INVALID_ARG;
     }
 
-    xSemaphoreTake(handle->mutex, portMAX_DELAY);
+    espsol_deadline_t deadline;
+    esp_err_t lock_err = ws_lock(handle, &deadline);
+    if (lock_err != ESP_OK) {
+        return lock_err;
+    }
 
     cJSON *params = cJSON_CreateArray();
     cJSON_AddItemToArray(params, cJSON_CreateNumber(subscription_id));
 
-    esp_err_t ret = send_jsonrpc_request(handle, "slotUnsubscribe", params, NULL);
+    esp_err_t ret = send_jsonrpc_request(handle, "slotUnsubscribe", params, NULL, &deadline);
     
     if (ret == ESP_OK) {
         remove_subscription(handle, subscription_id);
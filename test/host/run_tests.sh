@@ -17,19 +17,37 @@ COMMON_SRCS=(
     "$COMPONENT_DIR/src/espsol_base58.c"
     "$COMPONENT_DIR/src/espsol_base64.c"
     "$COMPONENT_DIR/src/espsol_crypto.c"
+    "$COMPONENT_DIR/src/espsol_sha.c"
     "$COMPONENT_DIR/src/espsol_ed25519.c"
+    "$COMPONENT_DIR/src/espsol_ed25519_fast.c"
     "$COMPONENT_DIR/src/espsol_tx.c"
+    "$COMPONENT_DIR/src/espsol_template.c"
+    "$COMPONENT_DIR/src/espsol_pack.c"
+    "$COMPONENT_DIR/src/espsol_view.c"
     "$COMPONENT_DIR/src/espsol_token.c"
+    "$COMPONENT_DIR/src/espsol_fee.c"
+    "$COMPONENT_DIR/src/espsol_worker.c"
 )
 
-# Mnemonic source files (uses SHA-256 from espsol_ed25519.c)
+# RPC source files
+RPC_SRCS=(
+    "$COMPONENT_DIR/src/espsol_rpc.c"
+    "$COMPONENT_DIR/src/espsol_json.c"
+    "$COMPONENT_DIR/src/espsol_transport.c"
+    "$COMPONENT_DIR/src/espsol_cancel.c"
+    "$COMPONENT_DIR/src/espsol_block.c"
+    "$COMPONENT_DIR/src/espsol_alt.c"
+    "$COMPONENT_DIR/src/espsol_nonce.c"
+)
+
+# Mnemonic source files (uses SHA-256 from espsol_sha.c)
 MNEMONIC_SRCS=(
     "$COMPONENT_DIR/src/espsol_mnemonic.c"
     "$COMPONENT_DIR/src/espsol_bip39_wordlist.c"
 )
 
 # Common flags
-CFLAGS="-Wall -Wextra -g -I$COMPONENT_DIR/include -I$COMPONENT_DIR/priv_include -I$COMPONENT_DIR/src -DESP_PLATFORM=0"
+CFLAGS="-Wall -Wextra -g -I$COMPONENT_DIR/include -I$COMPONENT_DIR/priv_include -I$COMPONENT_DIR/src -DESP_PLATFORM=0 -pthread"
 
 echo "Compiling encoding and crypto tests..."
 gcc $CFLAGS \
@@ -37,6 +55,12 @@ gcc $CFLAGS \
     "${COMMON_SRCS[@]}" \
     -o "$SCRIPT_DIR/test_encoding"
 
+echo "Compiling encoding and crypto tests (reference Ed25519)..."
+gcc $CFLAGS -DESPSOL_ED25519_REF \
+    "$SCRIPT_DIR/test_encoding.c" \
+    "${COMMON_SRCS[@]}" \
+    -o "$SCRIPT_DIR/test_encoding_ref"
+
 echo "Compiling transaction tests..."
 gcc $CFLAGS \
     "$SCRIPT_DIR/test_tx.c" \
@@ -62,11 +86,70 @@ gcc $CFLAGS \
     "${MNEMONIC_SRCS[@]}" \
     -o "$SCRIPT_DIR/test_mnemonic"
 
+echo "Compiling transaction template tests..."
+gcc $CFLAGS \
+    "$SCRIPT_DIR/test_template.c" \
+    "${COMMON_SRCS[@]}" \
+    -o "$SCRIPT_DIR/test_template"
+
+echo "Compiling instruction packer tests..."
+gcc $CFLAGS \
+    "$SCRIPT_DIR/test_pack.c" \
+    "${COMMON_SRCS[@]}" \
+    -o "$SCRIPT_DIR/test_pack"
+
+echo "Compiling instruction packer tests (default priority fee)..."
+gcc $CFLAGS -DCONFIG_ESPSOL_DEFAULT_PRIORITY_FEE=1000 \
+    "$SCRIPT_DIR/test_pack.c" \
+    "${COMMON_SRCS[@]}" \
+    -o "$SCRIPT_DIR/test_pack_fee"
+
+echo "Compiling wire parser tests..."
+gcc $CFLAGS \
+    "$SCRIPT_DIR/test_view.c" \
+    "${COMMON_SRCS[@]}" \
+    -o "$SCRIPT_DIR/test_view"
+
+echo "Compiling rent and fee tests..."
+gcc $CFLAGS \
+    "$SCRIPT_DIR/test_fee.c" \
+    "${COMMON_SRCS[@]}" \
+    -o "$SCRIPT_DIR/test_fee"
+
+echo "Compiling RPC transport tests..."
+gcc $CFLAGS \
+    "$SCRIPT_DIR/test_rpc.c" \
+    "${COMMON_SRCS[@]}" \
+    "${RPC_SRCS[@]}" \
+    -pthread \
+    -o "$SCRIPT_DIR/test_rpc"
+
+echo "Compiling address lookup table tests..."
+gcc $CFLAGS \
+    "$SCRIPT_DIR/test_alt.c" \
+    "${COMMON_SRCS[@]}" \
+    "${RPC_SRCS[@]}" \
+    -pthread \
+    -o "$SCRIPT_DIR/test_alt"
+
+echo "Compiling durable nonce tests..."
+gcc $CFLAGS \
+    "$SCRIPT_DIR/test_nonce.c" \
+    "${COMMON_SRCS[@]}" \
+    "${RPC_SRCS[@]}" \
+    -pthread \
+    -o "$SCRIPT_DIR/test_nonce"
+
 echo ""
 echo "Running encoding and crypto tests..."
 echo ""
 "$SCRIPT_DIR/test_encoding"
 
+echo ""
+echo "Running encoding and crypto tests (reference Ed25519)..."
+echo ""
+"$SCRIPT_DIR/test_encoding_ref"
+
 echo ""
 echo "Running transaction tests..."
 echo ""
@@ -87,8 +170,50 @@ echo "Running mnemonic tests..."
 echo ""
 "$SCRIPT_DIR/test_mnemonic"
 
+echo ""
+echo "Running transaction template tests..."
+echo ""
+"$SCRIPT_DIR/test_template"
+
+echo ""
+echo "Running instruction packer tests..."
+echo ""
+"$SCRIPT_DIR/test_pack"
+
+echo ""
+echo "Running instruction packer tests (default priority fee)..."
+echo ""
+"$SCRIPT_DIR/test_pack_fee"
+
+echo ""
+echo "Running wire parser tests..."
+echo ""
+"$SCRIPT_DIR/test_view"
+
+echo ""
+echo "Running rent and fee tests..."
+echo ""
+"$SCRIPT_DIR/test_fee"
+
+echo ""
+echo "Running RPC transport tests..."
+echo ""
+(cd "$SCRIPT_DIR" && ./test_rpc)
+
+echo ""
+echo "Running address lookup table tests..."
+echo ""
+"$SCRIPT_DIR/test_alt"
+
+echo ""
+echo "Running durable nonce tests..."
+echo ""
+"$SCRIPT_DIR/test_nonce"
+
 # Clean up
-rm -f "$SCRIPT_DIR/test_encoding" "$SCRIPT_DIR/test_tx" "$SCRIPT_DIR/test_token" "$SCRIPT_DIR/test_errors" "$SCRIPT_DIR/test_mnemonic"
+rm -f "$SCRIPT_DIR/test_encoding" "$SCRIPT_DIR/test_encoding_ref" "$SCRIPT_DIR/test_tx" "$SCRIPT_DIR/test_token" "$SCRIPT_DIR/test_errors" "$SCRIPT_DIR/test_mnemonic" \
+      "$SCRIPT_DIR/test_template" "$SCRIPT_DIR/test_pack" "$SCRIPT_DIR/test_pack_fee" "$SCRIPT_DIR/test_fee" "$SCRIPT_DIR/test_rpc" "$SCRIPT_DIR/test_alt" \
+      "$SCRIPT_DIR/test_nonce" "$SCRIPT_DIR/test_view"
 
 echo ""
 echo "All tests completed!"
@@ -0,0 +1,492 @@
+/**
+ * @file test_alt.c
+ * @brief Host-based Unit Tests for ESPSOL Address Lookup Tables
+ *
+ * Tests table account decoding, the lookup table cache, table selection
+ * for v0 transactions, fetching tables over RPC and the Address Lookup
+ * Table program instructions.
+ *
+ * @copyright Copyright (c) 2025 SkyRizz
+ * @license Apache-2.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Include ESPSOL headers */
+#include "espsol_types.h"
+#include "espsol_crypto.h"
+#include "espsol_tx.h"
+#include "espsol_rpc.h"
+#include "espsol_transport.h"
+#include "espsol_utils.h"
+#include "espsol_alt.h"
+
+#include "test_node.h"
+
+/* ============================================================================
+ * Test Framework
+ * ========================================================================== */
+
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        if (condition) { \
+            printf("✓ PASS: %s\n", message); \
+            tests_passed++; \
+        } else { \
+            printf("✗ FAIL: %s\n", message); \
+            tests_failed++; \
+        } \
+    } while (0)
+
+#define TEST_ASSERT_EQ(actual, expected, message) \
+    do { \
+        if ((actual) == (expected)) { \
+            printf("✓ PASS: %s\n", message); \
+            tests_passed++; \
+        } else { \
+            printf("✗ FAIL: %s (expected %llu, got %llu)\n", message, \
+                   (unsigned long long)(expected), (unsigned long long)(actual)); \
+            tests_failed++; \
+        } \
+    } while (0)
+
+/* ============================================================================
+ * Helpers
+ * ========================================================================== */
+
+#define TABLE_DATA_MAX  (ESPSOL_ALT_HEADER_SIZE + ESPSOL_ALT_MAX_ADDRESSES * ESPSOL_PUBKEY_SIZE)
+
+static void put_u64(uint8_t *p, uint64_t v)
+{
+    for (int i = 0; i < 8; i++) {
+        p[i] = (uint8_t)(v >> (i * 8));
+    }
+}
+
+/**
+ * @brief Build table account data holding count addresses filled with first, first+1, ...
+ */
+static size_t make_table(uint8_t *data, uint64_t deactivation_slot,
+                         uint64_t last_extended_slot, uint8_t start_index,
+                         uint8_t first, size_t count)
+{
+    memset(data, 0, ESPSOL_ALT_HEADER_SIZE);
+    data[0] = 1;
+    put_u64(data + 4, deactivation_slot);
+    put_u64(data + 12, last_extended_slot);
+    data[20] = start_index;
+    data[21] = 1;
+    memset(data + 22, 0xEE, ESPSOL_PUBKEY_SIZE);
+
+    for (size_t i = 0; i < count; i++) {
+        memset(data + ESPSOL_ALT_HEADER_SIZE + i * ESPSOL_PUBKEY_SIZE,
+               (uint8_t)(first + i), ESPSOL_PUBKEY_SIZE);
+    }
+    return ESPSOL_ALT_HEADER_SIZE + count * ESPSOL_PUBKEY_SIZE;
+}
+
+/**
+ * @brief Add an instruction reading count accounts filled with first, first+1, ...
+ */
+static void add_reader(espsol_tx_handle_t tx, uint8_t first, size_t count)
+{
+    espsol_account_meta_t metas[ESPSOL_MAX_ACCOUNTS];
+    for (size_t i = 0; i < count; i++) {
+        memset(metas[i].pubkey, (uint8_t)(first + i), ESPSOL_PUBKEY_SIZE);
+        metas[i].is_signer = false;
+        metas[i].is_writable = (i % 2) == 0;
+    }
+
+    uint8_t program[ESPSOL_PUBKEY_SIZE];
+    memset(program, 0x01, sizeof(program));
+    const uint8_t data[] = { 0x07 };
+    espsol_tx_add_instruction(tx, program, metas, count, data, sizeof(data));
+}
+
+static size_t signed_size(espsol_tx_handle_t tx)
+{
+    uint8_t buffer[ESPSOL_MAX_TX_SIZE];
+    size_t len = 0;
+    if (espsol_tx_sign(tx, &payer) != ESP_OK ||
+        espsol_tx_serialize(tx, buffer, sizeof(buffer), &len) != ESP_OK) {
+        return 0;
+    }
+    return len;
+}
+
+/* ============================================================================
+ * Decoding Tests
+ * ========================================================================== */
+
+static void test_decode(void)
+{
+    printf("\n========== Table Decoding Tests ==========\n\n");
+
+    uint8_t data[TABLE_DATA_MAX + ESPSOL_PUBKEY_SIZE];
+    size_t len = make_table(data, ESPSOL_ALT_ACTIVE, 500, 2, 0x40, 3);
+
+    espsol_alt_state_t state;
+    const uint8_t (*addresses)[ESPSOL_PUBKEY_SIZE] = NULL;
+    esp_err_t err = espsol_alt_decode(data, len, &state, &addresses);
+    TEST_ASSERT_EQ(err, ESP_OK, "Decode table account");
+    TEST_ASSERT(state.deactivation_slot == ESPSOL_ALT_ACTIVE && state.last_extended_slot == 500 &&
+                state.last_extended_start_index == 2 && state.address_count == 3,
+                "Header fields decoded");
+    TEST_ASSERT(state.has_authority && state.authority[0] == 0xEE && state.authority[31] == 0xEE,
+                "Authority decoded");
+    TEST_ASSERT(addresses && addresses[2][0] == 0x42 && addresses[2][31] == 0x42,
+                "Addresses point into the account data");
+
+    data[21] = 0;
+    espsol_alt_decode(data, len, &state, NULL);
+    TEST_ASSERT(!state.has_authority && state.authority[0] == 0, "Frozen table has no authority");
+
+    TEST_ASSERT_EQ(espsol_alt_decode(data, len - 1, &state, NULL), ESP_ERR_ESPSOL_RPC_PARSE_ERROR,
+                   "Partial address rejected");
+    TEST_ASSERT_EQ(espsol_alt_decode(data, 40, &state, NULL), ESP_ERR_ESPSOL_RPC_PARSE_ERROR,
+                   "Short header rejected");
+    make_table(data, ESPSOL_ALT_ACTIVE, 0, 0, 0, 0);
+    TEST_ASSERT_EQ(espsol_alt_decode(data, sizeof(data), &state, NULL), ESP_ERR_ESPSOL_RPC_PARSE_ERROR,
+                   "More than 256 addresses rejected");
+    data[0] = 0;
+    TEST_ASSERT_EQ(espsol_alt_decode(data, ESPSOL_ALT_HEADER_SIZE, &state, NULL),
+                   ESP_ERR_ESPSOL_RPC_PARSE_ERROR, "Uninitialized account rejected");
+    TEST_ASSERT_EQ(espsol_alt_decode(NULL, 0, &state, NULL), ESP_ERR_INVALID_ARG, "NULL data rejected");
+}
+
+/* ============================================================================
+ * Cache Tests
+ * ========================================================================== */
+
+static void test_cache(void)
+{
+    printf("\n========== Lookup Table Cache Tests ==========\n\n");
+
+    espsol_alt_cache_config_t config = ESPSOL_ALT_CACHE_CONFIG_DEFAULT();
+    config.max_tables = 3;
+    config.max_age_slots = 100;
+    espsol_alt_cache_handle_t cache = NULL;
+    TEST_ASSERT_EQ(espsol_alt_cache_create(&config, &cache), ESP_OK, "Cache created");
+
+    uint8_t data[TABLE_DATA_MAX];
+    uint8_t key_a[32], key_b[32], key_c[32], key_d[32];
+    memset(key_a, 0x0A, 32);
+    memset(key_b, 0x0B, 32);
+    memset(key_c, 0x0C, 32);
+    memset(key_d, 0x0D, 32);
+
+    /* Full 256-address table exercises index growth */
+    size_t len = make_table(data, ESPSOL_ALT_ACTIVE, 10, 0, 0x00, 256);
+    TEST_ASSERT_EQ(espsol_alt_cache_put(cache, key_a, data, len, 50), ESP_OK, "Put full table");
+
+    /* Extended in the slot it was read at: the last four are not usable yet */
+    len = make_table(data, ESPSOL_ALT_ACTIVE, 60, 4, 0x80, 8);
+    TEST_ASSERT_EQ(espsol_alt_cache_put(cache, key_b, data, len, 60), ESP_OK, "Put warming table");
+
+    espsol_lookup_table_t table;
+    espsol_alt_state_t state;
+    TEST_ASSERT_EQ(espsol_alt_cache_get(cache, key_a, &table, &state), ESP_OK, "Get cached table");
+    TEST_ASSERT(table.address_count == 256 && memcmp(table.key, key_a, 32) == 0 &&
+                table.addresses[255][0] == 0xFF, "Table contents copied");
+    espsol_alt_cache_get(cache, key_b, &table, &state);
+    TEST_ASSERT(table.address_count == 4 && state.address_count == 8,
+                "Addresses extended in the current slot withheld");
+
+    uint8_t address[32], found[32];
+    uint8_t index = 0;
+    memset(address, 0x20, 32);
+    TEST_ASSERT_EQ(espsol_alt_cache_find(cache, address, found, &index), ESP_OK, "Find address");
+    TEST_ASSERT(index == 0x20 && memcmp(found, key_a, 32) == 0, "Index and table reported");
+    memset(address, 0x85, 32);
+    espsol_alt_cache_find(cache, address, found, &index);
+    TEST_ASSERT(memcmp(found, key_a, 32) == 0, "Withheld address resolved through other table");
+
+    /* Re-reading a later slot makes the whole table usable */
+    len = make_table(data, ESPSOL_ALT_ACTIVE, 60, 4, 0x80, 8);
+    espsol_alt_cache_put(cache, key_b, data, len, 61);
+    espsol_alt_cache_get(cache, key_b, &table, NULL);
+    TEST_ASSERT_EQ(table.address_count, 8, "Refresh replaces the entry");
+
+    /* Deactivated tables are cached but never used */
+    len = make_table(data, 70, 10, 0, 0xF0, 4);
+    espsol_alt_cache_put(cache, key_c, data, len, 70);
+
+    /* Cache full: the table read longest ago is evicted */
+    len = make_table(data, ESPSOL_ALT_ACTIVE, 10, 0, 0x10, 2);
+    espsol_alt_cache_put(cache, key_d, data, len, 80);
+    TEST_ASSERT_EQ(espsol_alt_cache_get(cache, key_a, &table, NULL), ESP_ERR_NOT_FOUND,
+                   "Oldest table evicted");
+    memset(address, 0xF2, 32);
+    TEST_ASSERT_EQ(espsol_alt_cache_find(cache, address, NULL, NULL), ESP_ERR_NOT_FOUND,
+                   "Deactivated table not indexed");
+    memset(address, 0x11, 32);
+    TEST_ASSERT_EQ(espsol_alt_cache_find(cache, address, found, &index), ESP_OK, "New table indexed");
+    TEST_ASSERT(index == 1 && memcmp(found, key_d, 32) == 0, "New table index correct");
+
+    size_t removed = 0;
+    espsol_alt_cache_expire(cache, 165, &removed);
+    TEST_ASSERT_EQ(removed, 2, "Deactivated and stale tables expired");
+    TEST_ASSERT(espsol_alt_cache_get(cache, key_d, &table, NULL) == ESP_OK &&
+                espsol_alt_cache_get(cache, key_b, &table, NULL) == ESP_ERR_NOT_FOUND,
+                "Recent table kept");
+
+    TEST_ASSERT_EQ(espsol_alt_cache_remove(cache, key_d), ESP_OK, "Remove table");
+    TEST_ASSERT_EQ(espsol_alt_cache_find(cache, address, NULL, NULL), ESP_ERR_NOT_FOUND,
+                   "Removed table no longer indexed");
+    TEST_ASSERT_EQ(espsol_alt_cache_remove(cache, key_d), ESP_ERR_NOT_FOUND, "Remove missing table");
+
+    data[0] = 2;
+    TEST_ASSERT_EQ(espsol_alt_cache_put(cache, key_a, data, len, 1), ESP_ERR_ESPSOL_RPC_PARSE_ERROR,
+                   "Invalid account not cached");
+
+    config.max_tables = 0;
+    espsol_alt_cache_handle_t bad = NULL;
+    TEST_ASSERT_EQ(espsol_alt_cache_create(&config, &bad), ESP_ERR_INVALID_ARG, "Zero tables rejected");
+    TEST_ASSERT_EQ(espsol_alt_cache_destroy(cache), ESP_OK, "Cache destroyed");
+}
+
+/* ============================================================================
+ * Selection Tests
+ * ========================================================================== */
+
+static void test_select(void)
+{
+    printf("\n========== Table Selection Tests ==========\n\n");
+
+    espsol_alt_cache_handle_t cache = NULL;
+    espsol_alt_cache_create(NULL, &cache);
+
+    uint8_t data[TABLE_DATA_MAX];
+    uint8_t key[32];
+    size_t len;
+
+    /* A: 0x40..0x45, B: 0x44..0x49 overlaps A, C: 0x4A only, D: 0x60..0x7F */
+    memset(key, 0x0A, 32);
+    len = make_table(data, ESPSOL_ALT_ACTIVE, 1, 0, 0x40, 6);
+    espsol_alt_cache_put(cache, key, data, len, 10);
+    memset(key, 0x0B, 32);
+    len = make_table(data, ESPSOL_ALT_ACTIVE, 1, 0, 0x44, 6);
+    espsol_alt_cache_put(cache, key, data, len, 10);
+    memset(key, 0x0C, 32);
+    len = make_table(data, ESPSOL_ALT_ACTIVE, 1, 0, 0x4A, 1);
+    espsol_alt_cache_put(cache, key, data, len, 10);
+    memset(key, 0x0D, 32);
+    len = make_table(data, ESPSOL_ALT_ACTIVE, 1, 0, 0x60, 32);
+    espsol_alt_cache_put(cache, key, data, len, 10);
+
+    /* 0x40..0x4A: A and B cover 10, C would only add one */
+    espsol_tx_handle_t tx = new_tx();
+    add_reader(tx, 0x40, 11);
+    size_t legacy = signed_size(tx);
+
+    int saved = -1;
+    TEST_ASSERT_EQ(espsol_alt_cache_select(cache, tx, &saved), ESP_OK, "Select tables");
+    espsol_tx_version_t version = ESPSOL_TX_VERSION_LEGACY;
+    espsol_tx_get_version(tx, &version);
+    TEST_ASSERT_EQ(version, ESPSOL_TX_VERSION_0, "Transaction made v0");
+    TEST_ASSERT_EQ(saved, 10 * 31 - 2 * 34 - 2, "Two overlapping tables chosen over three");
+    size_t compact = signed_size(tx);
+    TEST_ASSERT(compact > 0 && legacy - compact == (size_t)saved, "Reported saving matches serialization");
+
+    /* Selecting again replaces the previous tables */
+    TEST_ASSERT(espsol_alt_cache_select(cache, tx, &saved) == ESP_OK && signed_size(tx) == compact,
+                "Selection is repeatable");
+    espsol_tx_destroy(tx);
+
+    /* One table account and a signer: tables cost more than they save */
+    tx = new_tx();
+    add_reader(tx, 0x4A, 1);
+    espsol_tx_add_transfer(tx, payer.public_key, payer.public_key, 1);
+    TEST_ASSERT_EQ(espsol_alt_cache_select(cache, tx, &saved), ESP_OK, "Select for small transaction");
+    espsol_tx_get_version(tx, &version);
+    TEST_ASSERT(version == ESPSOL_TX_VERSION_LEGACY && saved == 0, "Small transaction stays legacy");
+    espsol_tx_destroy(tx);
+
+    /* 24 accounts cannot be legacy; only table D can hold them */
+    tx = new_tx();
+    add_reader(tx, 0x60, 12);
+    add_reader(tx, 0x6C, 12);
+    TEST_ASSERT_EQ(espsol_tx_sign(tx, &payer), ESP_ERR_ESPSOL_MAX_ACCOUNTS, "Legacy over account limit");
+    TEST_ASSERT_EQ(espsol_alt_cache_select(cache, tx, &saved), ESP_OK, "Select for large transaction");
+    TEST_ASSERT(signed_size(tx) > 0 && saved == 24 * 31 - 34 - 2, "Large transaction fits with one table");
+    espsol_tx_destroy(tx);
+
+    /* Unknown accounts cannot be loaded */
+    tx = new_tx();
+    add_reader(tx, 0x90, 11);
+    add_reader(tx, 0x9B, 11);
+    TEST_ASSERT_EQ(espsol_alt_cache_select(cache, tx, &saved), ESP_ERR_ESPSOL_MAX_ACCOUNTS,
+                   "Too many uncached accounts reported");
+    espsol_tx_destroy(tx);
+
+    TEST_ASSERT_EQ(espsol_alt_cache_select(NULL, NULL, NULL), ESP_ERR_INVALID_ARG, "NULL arguments rejected");
+    espsol_alt_cache_destroy(cache);
+}
+
+/* ============================================================================
+ * RPC Fetch Tests
+ * ========================================================================== */
+
+static void test_fetch(void)
+{
+    printf("\n========== Table Fetch Tests ==========\n\n");
+
+    test_node_t node = { .chunk = 13, .stream_only = true };
+    espsol_rpc_handle_t rpc = test_node_connect(&node);
+
+    espsol_alt_cache_handle_t cache = NULL;
+    espsol_alt_cache_create(NULL, &cache);
+
+    char program[ESPSOL_ADDRESS_MAX_LEN];
+    espsol_pubkey_to_address(ESPSOL_ADDRESS_LOOKUP_TABLE_PROGRAM_ID, program, sizeof(program));
+    TEST_ASSERT(strcmp(program, "AddressLookupTab1e1111111111111111111111111") == 0,
+                "Program ID encodes to its address");
+
+    uint8_t key[32];
+    memset(key, 0x0A, 32);
+    char address[ESPSOL_ADDRESS_MAX_LEN];
+    espsol_pubkey_to_address(key, address, sizeof(address));
+
+    /* Largest table, far beyond the client buffer */
+    uint8_t *data = malloc(TABLE_DATA_MAX);
+    size_t len = make_table(data, ESPSOL_ALT_ACTIVE, 250, 0, 0x00, 256);
+    test_node_set_account(&node, data, len, program);
+
+    esp_err_t err = espsol_alt_cache_fetch(cache, rpc, key);
+    TEST_ASSERT_EQ(err, ESP_OK, "Fetch table");
+    TEST_ASSERT(strstr(node.request, "\"getAccountInfo\"") && strstr(node.request, address) &&
+                strstr(node.request, "\"encoding\":\"base64\""), "Account requested as base64");
+
+    espsol_lookup_table_t table;
+    TEST_ASSERT(espsol_alt_cache_get(cache, key, &table, NULL) == ESP_OK && table.address_count == 256 &&
+                table.addresses[200][0] == 200, "Fetched table cached");
+
+    /* Expiry measured from the response slot */
+    size_t removed = 0;
+    espsol_alt_cache_expire(cache, 300 + 9000, &removed);
+    TEST_ASSERT_EQ(removed, 0, "Fetched slot recorded");
+
+    test_node_set_account(&node, data, len, "Sysvar1111111111111111111111111111111111111");
+    TEST_ASSERT_EQ(espsol_alt_cache_fetch(cache, rpc, key), ESP_ERR_ESPSOL_RPC_PARSE_ERROR,
+                   "Account owned by another program rejected");
+
+    test_node_set_body(&node, "{\"jsonrpc\":\"2.0\",\"result\":{\"context\":{\"slot\":300},\"value\":null},\"id\":1}");
+    TEST_ASSERT_EQ(espsol_alt_cache_fetch(cache, rpc, key), ESP_ERR_NOT_FOUND, "Missing account");
+
+    test_node_set_body(&node, "{\"jsonrpc\":\"2.0\",\"error\":{\"code\":-32602,"
+                              "\"message\":\"Invalid param\"},\"id\":1}");
+    TEST_ASSERT_EQ(espsol_alt_cache_fetch(cache, rpc, key), ESP_ERR_ESPSOL_RPC_FAILED, "RPC error reported");
+    TEST_ASSERT(strcmp(espsol_rpc_get_last_error(rpc), "RPC error -32602: Invalid param") == 0,
+                "RPC error message kept");
+
+    test_node_set_body(&node, "{\"jsonrpc\":\"2.0\",\"result\":{\"context\":{\"slot\":300},\"value\":{\"data\":[\"AQ");
+    TEST_ASSERT_EQ(espsol_alt_cache_fetch(cache, rpc, key), ESP_ERR_ESPSOL_RPC_PARSE_ERROR,
+                   "Truncated response detected");
+
+    free(node.body);
+    free(data);
+    espsol_alt_cache_destroy(cache);
+    espsol_rpc_deinit(rpc);
+}
+
+/* ============================================================================
+ * Instruction Tests
+ * ========================================================================== */
+
+/**
+ * @brief Find the instruction data at the end of a signed message
+ */
+static const uint8_t *message_tail(espsol_tx_handle_t tx, uint8_t *buffer, size_t tail)
+{
+    size_t len = 0;
+    if (espsol_tx_sign(tx, &payer) != ESP_OK ||
+        espsol_tx_serialize(tx, buffer, ESPSOL_MAX_TX_SIZE, &len) != ESP_OK || len < tail) {
+        return NULL;
+    }
+    return buffer + len - tail;
+}
+
+static void test_instructions(void)
+{
+    printf("\n========== Lookup Table Instruction Tests ==========\n\n");
+
+    uint8_t buffer[ESPSOL_MAX_TX_SIZE];
+    uint8_t table[32], recipient[32];
+    memset(table, 0x0A, 32);
+    memset(recipient, 0x33, 32);
+
+    espsol_tx_handle_t tx = new_tx();
+    TEST_ASSERT_EQ(espsol_tx_add_alt_deactivate(tx, table, payer.public_key), ESP_OK, "Add deactivate");
+    const uint8_t *tail = message_tail(tx, buffer, 9);
+    const uint8_t deactivate[] = { 2, 2, 1, 0, 4, 3, 0, 0, 0 };
+    TEST_ASSERT(tail && memcmp(tail, deactivate, sizeof(deactivate)) == 0,
+                "Deactivate accounts and data");
+    espsol_tx_destroy(tx);
+
+    tx = new_tx();
+    TEST_ASSERT_EQ(espsol_tx_add_alt_close(tx, table, payer.public_key, recipient), ESP_OK, "Add close");
+    tail = message_tail(tx, buffer, 10);
+    const uint8_t close[] = { 3, 3, 1, 0, 2, 4, 4, 0, 0, 0 };
+    TEST_ASSERT(tail && memcmp(tail, close, sizeof(close)) == 0, "Close accounts and data");
+    espsol_tx_destroy(tx);
+
+    uint8_t addresses[40][32];
+    for (int i = 0; i < 40; i++) {
+        memset(addresses[i], 0x50 + i, 32);
+    }
+
+    tx = new_tx();
+    TEST_ASSERT_EQ(espsol_tx_add_alt_extend(tx, table, payer.public_key, payer.public_key,
+                                            (const uint8_t (*)[32])addresses, 2),
+                   ESP_OK, "Add extend");
+    tail = message_tail(tx, buffer, 1 + 12 + 64);
+    const uint8_t extend[] = { 12 + 64, 2, 0, 0, 0, 2, 0, 0, 0, 0, 0, 0, 0 };
+    TEST_ASSERT(tail && memcmp(tail, extend, sizeof(extend)) == 0 && tail[13] == 0x50 && tail[76] == 0x51,
+                "Extend data holds count and addresses");
+
+    TEST_ASSERT_EQ(espsol_tx_add_alt_extend(tx, table, payer.public_key, payer.public_key,
+                                            (const uint8_t (*)[32])addresses, 40),
+                   ESP_ERR_ESPSOL_BUFFER_TOO_SMALL, "Extend beyond instruction data rejected");
+    TEST_ASSERT_EQ(espsol_tx_add_alt_extend(tx, table, payer.public_key, payer.public_key,
+                                            (const uint8_t (*)[32])addresses, 0),
+                   ESP_ERR_INVALID_ARG, "Empty extend rejected");
+    TEST_ASSERT_EQ(espsol_tx_add_alt_create(tx, NULL, payer.public_key, 1, table), ESP_ERR_INVALID_ARG,
+                   "Create without authority rejected");
+    espsol_tx_destroy(tx);
+}
+
+/* ============================================================================
+ * Main
+ * ========================================================================== */
+
+int main(void)
+{
+    printf("==============================================\n");
+    printf("   ESPSOL Address Lookup Table Tests\n");
+    printf("==============================================\n");
+
+    uint8_t seed[ESPSOL_SEED_SIZE];
+    memset(seed, 0x42, sizeof(seed));
+    espsol_keypair_from_seed(seed, &payer);
+    memset(blockhash, 0xBB, sizeof(blockhash));
+
+    test_decode();
+    test_cache();
+    test_select();
+    test_fetch();
+    test_instructions();
+
+    /* Summary */
+    printf("\n==============================================\n");
+    printf("Test Summary: %d passed, %d failed\n", tests_passed, tests_failed);
+    printf("==============================================\n");
+
+    return tests_failed > 0 ? 1 : 0;
+}
@@ -13,11 +13,13 @@
 #include <string.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include <time.h>
 
 /* Include ESPSOL headers (they handle host compatibility) */
 #include "espsol_types.h"
 #include "espsol_utils.h"
 #include "espsol_crypto.h"
+#include "espsol_sha.h"
 
 /* ============================================================================
  * Test Framework
@@ -160,6 +162,45 @@ static void test_base58_encode_decode(void)
         err = espsol_base58_encode(data, sizeof(data), encoded, 2);
         TEST_ASSERT_EQ(err, ESP_ERR_ESPSOL_BUFFER_TOO_SMALL, "Detect buffer too small");
     }
+
+    /* Test 8: Transaction-sized input (no fixed working buffer) */
+    {
+        static uint8_t big[ESPSOL_MAX_TX_SIZE];
+        static uint8_t big_decoded[ESPSOL_MAX_TX_SIZE];
+        static char big_encoded[ESPSOL_MAX_TX_SIZE * 2];
+        big[0] = 0;
+        big[1] = 0;
+        for (size_t i = 2; i < sizeof(big); i++) {
+            big[i] = (uint8_t)(i * 131 + 7);
+        }
+
+        size_t need = espsol_base58_encoded_len(sizeof(big));
+        err = espsol_base58_encode(big, sizeof(big), big_encoded, need);
+        TEST_ASSERT_EQ(err, ESP_OK, "Encode 1232 bytes in encoded_len() buffer");
+        TEST_ASSERT(big_encoded[0] == '1' && big_encoded[1] == '1' && big_encoded[2] != '1',
+                    "Leading zero bytes kept as '1'");
+
+        size_t exact = strlen(big_encoded) + 1;
+        err = espsol_base58_encode(big, sizeof(big), big_encoded, exact - 1);
+        TEST_ASSERT_EQ(err, ESP_ERR_ESPSOL_BUFFER_TOO_SMALL, "One byte short is too small");
+
+        /* Input already in the tail of the output buffer */
+        memcpy(big_encoded + exact - sizeof(big), big, sizeof(big));
+        err = espsol_base58_encode((const uint8_t *)big_encoded + exact - sizeof(big),
+                                   sizeof(big), big_encoded, exact);
+        TEST_ASSERT_EQ(err, ESP_OK, "Encode in place from the buffer tail");
+        TEST_ASSERT_EQ(strlen(big_encoded), exact - 1, "In-place result has the same length");
+
+        decoded_len = sizeof(big_decoded);
+        err = espsol_base58_decode(big_encoded, big_decoded, &decoded_len);
+        TEST_ASSERT_EQ(err, ESP_OK, "Decode 1232 bytes");
+        TEST_ASSERT(decoded_len == sizeof(big) && memcmp(big, big_decoded, sizeof(big)) == 0,
+                    "1232-byte roundtrip");
+
+        decoded_len = sizeof(big) - 1;
+        err = espsol_base58_decode(big_encoded, big_decoded, &decoded_len);
+        TEST_ASSERT_EQ(err, ESP_ERR_ESPSOL_BUFFER_TOO_SMALL, "Decode one byte short is too small");
+    }
 }
 
 /* ============================================================================
@@ -259,6 +300,112 @@ static void test_base64_encode_decode(void)
     }
 }
 
+/* ============================================================================
+ * Streaming Writer Tests
+ * ========================================================================== */
+
+typedef struct {
+    char text[2048];
+    size_t len;
+    size_t calls;
+    size_t limit;           /* Fail once len would pass this */
+} collect_t;
+
+static esp_err_t collect_write(void *ctx, const uint8_t *data, size_t len)
+{
+    collect_t *c = ctx;
+    if (c->len + len > c->limit) {
+        return ESP_ERR_ESPSOL_RPC_FAILED;
+    }
+    memcpy(c->text + c->len, data, len);
+    c->len += len;
+    c->calls++;
+    return ESP_OK;
+}
+
+static void test_writers(void)
+{
+    printf("\n========== Streaming Writer Tests ==========\n\n");
+
+    static uint8_t data[1000];
+    static char expected[1400];
+    for (size_t i = 0; i < sizeof(data); i++) {
+        data[i] = (uint8_t)(i * 37 + 11);
+    }
+
+    /* Base64 writer matches the one-shot encoder for every tail length */
+    {
+        bool all_match = true;
+        for (size_t n = 0; n < 8; n++) {
+            espsol_base64_encode(data, n, expected, sizeof(expected));
+
+            collect_t c = { .limit = sizeof(c.text) };
+            espsol_writer_t out = { .write = collect_write, .ctx = &c };
+            espsol_base64_writer_t enc;
+            espsol_writer_t writer;
+            espsol_base64_writer_init(&enc, &out, &writer);
+            for (size_t i = 0; i < n; i++) {
+                writer.write(writer.ctx, data + i, 1);
+            }
+            espsol_base64_writer_finish(&enc);
+            c.text[c.len] = '\0';
+            all_match = all_match && strcmp(c.text, expected) == 0;
+        }
+        TEST_ASSERT(all_match, "Byte-at-a-time Base64 matches for lengths 0-7");
+    }
+
+    /* Uneven chunks across block boundaries */
+    {
+        espsol_base64_encode(data, sizeof(data), expected, sizeof(expected));
+
+        collect_t c = { .limit = sizeof(c.text) };
+        espsol_writer_t out = { .write = collect_write, .ctx = &c };
+        espsol_base64_writer_t enc;
+        espsol_writer_t writer;
+        espsol_base64_writer_init(&enc, &out, &writer);
+
+        size_t off = 0;
+        esp_err_t err = ESP_OK;
+        for (size_t chunk = 1; off < sizeof(data) && err == ESP_OK; chunk = chunk % 97 + 5) {
+            size_t n = chunk < sizeof(data) - off ? chunk : sizeof(data) - off;
+            err = writer.write(writer.ctx, data + off, n);
+            off += n;
+        }
+        if (err == ESP_OK) {
+            err = espsol_base64_writer_finish(&enc);
+        }
+        c.text[c.len] = '\0';
+        TEST_ASSERT_EQ(err, ESP_OK, "Chunked Base64 encode");
+        TEST_ASSERT_STR_EQ(c.text, expected, "Chunked Base64 matches one-shot");
+        TEST_ASSERT(c.calls < c.len / 32, "Characters passed on in blocks");
+    }
+
+    /* Errors from the destination stop the encoder */
+    {
+        collect_t c = { .limit = 100 };
+        espsol_writer_t out = { .write = collect_write, .ctx = &c };
+        espsol_base64_writer_t enc;
+        espsol_writer_t writer;
+        espsol_base64_writer_init(&enc, &out, &writer);
+        esp_err_t err = writer.write(writer.ctx, data, sizeof(data));
+        TEST_ASSERT_EQ(err, ESP_ERR_ESPSOL_RPC_FAILED, "Destination error returned");
+    }
+
+    /* Buffer writer */
+    {
+        uint8_t buf[8];
+        espsol_buffer_writer_t sink;
+        espsol_writer_t writer;
+        espsol_buffer_writer_init(&sink, buf, sizeof(buf), &writer);
+        TEST_ASSERT_EQ(writer.write(writer.ctx, data, 5), ESP_OK, "Buffer writer accepts 5 bytes");
+        TEST_ASSERT_EQ(writer.write(writer.ctx, data, 4), ESP_ERR_ESPSOL_BUFFER_TOO_SMALL,
+                       "Buffer writer rejects overflow");
+        TEST_ASSERT_EQ(sink.len, 5, "Rejected write leaves length");
+        TEST_ASSERT_EQ(writer.write(writer.ctx, data + 5, 3), ESP_OK, "Buffer writer fills exactly");
+        TEST_ASSERT(sink.len == 8 && memcmp(buf, data, 8) == 0, "Buffer writer contents");
+    }
+}
+
 /* ============================================================================
  * Address Utility Tests
  * ========================================================================== */
@@ -527,6 +674,616 @@ static void test_crypto_signing(void)
     }
 }
 
+static void test_crypto_vectors(void)
+{
+    printf("\n========== Ed25519 Known-Answer Tests ==========\n\n");
+
+    esp_err_t err;
+
+    /* RFC 8032 TEST 2 and TEST 3 */
+    static const struct {
+        uint8_t seed[32];
+        uint8_t public_key[32];
+        uint8_t message[2];
+        size_t message_len;
+        uint8_t signature[64];
+    } vectors[] = {
+        {
+            {
+                0x4c, 0xcd, 0x08, 0x9b, 0x28, 0xff, 0x96, 0xda,
+                0x9d, 0xb6, 0xc3, 0x46, 0xec, 0x11, 0x4e, 0x0f,
+                0x5b, 0x8a, 0x31, 0x9f, 0x35, 0xab, 0xa6, 0x24,
+                0xda, 0x8c, 0xf6, 0xed, 0x4f, 0xb8, 0xa6, 0xfb
+            },
+            {
+                0x3d, 0x40, 0x17, 0xc3, 0xe8, 0x43, 0x89, 0x5a,
+                0x92, 0xb7, 0x0a, 0xa7, 0x4d, 0x1b, 0x7e, 0xbc,
+                0x9c, 0x98, 0x2c, 0xcf, 0x2e, 0xc4, 0x96, 0x8c,
+                0xc0, 0xcd, 0x55, 0xf1, 0x2a, 0xf4, 0x66, 0x0c
+            },
+            { 0x72 }, 1,
+            {
+                0x92, 0xa0, 0x09, 0xa9, 0xf0, 0xd4, 0xca, 0xb8,
+                0x72, 0x0e, 0x82, 0x0b, 0x5f, 0x64, 0x25, 0x40,
+                0xa2, 0xb2, 0x7b, 0x54, 0x16, 0x50, 0x3f, 0x8f,
+                0xb3, 0x76, 0x22, 0x23, 0xeb, 0xdb, 0x69, 0xda,
+                0x08, 0x5a, 0xc1, 0xe4, 0x3e, 0x15, 0x99, 0x6e,
+                0x45, 0x8f, 0x36, 0x13, 0xd0, 0xf1, 0x1d, 0x8c,
+                0x38, 0x7b, 0x2e, 0xae, 0xb4, 0x30, 0x2a, 0xee,
+                0xb0, 0x0d, 0x29, 0x16, 0x12, 0xbb, 0x0c, 0x00
+            }
+        },
+        {
+            {
+                0xc5, 0xaa, 0x8d, 0xf4, 0x3f, 0x9f, 0x83, 0x7b,
+                0xed, 0xb7, 0x44, 0x2f, 0x31, 0xdc, 0xb7, 0xb1,
+                0x66, 0xd3, 0x85, 0x35, 0x07, 0x6f, 0x09, 0x4b,
+                0x85, 0xce, 0x3a, 0x2e, 0x0b, 0x44, 0x58, 0xf7
+            },
+            {
+                0xfc, 0x51, 0xcd, 0x8e, 0x62, 0x18, 0xa1, 0xa3,
+                0x8d, 0xa4, 0x7e, 0xd0, 0x02, 0x30, 0xf0, 0x58,
+                0x08, 0x16, 0xed, 0x13, 0xba, 0x33, 0x03, 0xac,
+                0x5d, 0xeb, 0x91, 0x15, 0x48, 0x90, 0x80, 0x25
+            },
+            { 0xaf, 0x82 }, 2,
+            {
+                0x62, 0x91, 0xd6, 0x57, 0xde, 0xec, 0x24, 0x02,
+                0x48, 0x27, 0xe6, 0x9c, 0x3a, 0xbe, 0x01, 0xa3,
+                0x0c, 0xe5, 0x48, 0xa2, 0x84, 0x74, 0x3a, 0x44,
+                0x5e, 0x36, 0x80, 0xd7, 0xdb, 0x5a, 0xc3, 0xac,
+                0x18, 0xff, 0x9b, 0x53, 0x8d, 0x16, 0xf2, 0x90,
+                0xae, 0x67, 0xf7, 0x60, 0x98, 0x4d, 0xc6, 0x59,
+                0x4a, 0x7c, 0x15, 0xe9, 0x71, 0x6e, 0xd2, 0x8d,
+                0xc0, 0x27, 0xbe, 0xce, 0xea, 0x1e, 0xc4, 0x0a
+            }
+        }
+    };
+
+    for (size_t v = 0; v < sizeof(vectors) / sizeof(vectors[0]); v++) {
+        espsol_keypair_t keypair;
+        uint8_t signature[64];
+        espsol_keypair_from_seed(vectors[v].seed, &keypair);
+        TEST_ASSERT(memcmp(keypair.public_key, vectors[v].public_key, 32) == 0,
+                    "RFC 8032 public key");
+        err = espsol_sign(vectors[v].message, vectors[v].message_len, &keypair, signature);
+        TEST_ASSERT(err == ESP_OK && memcmp(signature, vectors[v].signature, 64) == 0,
+                    "RFC 8032 signature");
+        err = espsol_verify(vectors[v].message, vectors[v].message_len,
+                            vectors[v].signature, vectors[v].public_key);
+        TEST_ASSERT_EQ(err, ESP_OK, "RFC 8032 signature verifies");
+        espsol_keypair_clear(&keypair);
+    }
+
+    /* Keys and signatures over growing messages, digested. The digest
+     * was computed with an independent implementation, so every backend
+     * must produce exactly these bytes. */
+    static const uint8_t expected_digest[32] = {
+        0x3e, 0xe7, 0x75, 0xe1, 0x62, 0x3c, 0xd4, 0x96,
+        0x80, 0x6c, 0x32, 0xfe, 0xd2, 0xcf, 0x20, 0x0a,
+        0x7d, 0xb8, 0x75, 0x62, 0xfb, 0x79, 0xee, 0xc8,
+        0x07, 0x85, 0x7c, 0x01, 0x64, 0x02, 0x1d, 0x52
+    };
+    uint8_t transcript[32 * 96];
+    uint8_t message[32 * 9];
+    bool all_verify = true;
+    bool all_reject = true;
+    for (int i = 0; i < 32; i++) {
+        uint8_t seed[32];
+        espsol_keypair_t keypair;
+        uint8_t *entry = transcript + i * 96;
+        for (int j = 0; j < 32; j++) {
+            seed[j] = (uint8_t)(i * 7 + j);
+        }
+        for (int j = 0; j < i * 9; j++) {
+            message[j] = (uint8_t)(i + j * 13);
+        }
+        espsol_keypair_from_seed(seed, &keypair);
+        memcpy(entry, keypair.public_key, 32);
+        espsol_sign(message, i * 9, &keypair, entry + 32);
+        all_verify &= espsol_verify(message, i * 9, entry + 32, keypair.public_key) == ESP_OK;
+        entry[32 + 2 * i] ^= 0x04;
+        all_reject &= espsol_verify(message, i * 9, entry + 32, keypair.public_key) != ESP_OK;
+        entry[32 + 2 * i] ^= 0x04;
+        espsol_keypair_clear(&keypair);
+    }
+    uint8_t digest[32];
+    espsol_sha256(transcript, sizeof(transcript), digest);
+    TEST_ASSERT(memcmp(digest, expected_digest, 32) == 0, "32 keypairs and signatures match");
+    TEST_ASSERT(all_verify, "All 32 signatures verify");
+    TEST_ASSERT(all_reject, "All 32 corrupted signatures rejected");
+}
+
+static void test_sha_paths(void)
+{
+    printf("\n========== SHA-256 / SHA-512 Paths ==========\n\n");
+
+    static const uint8_t abc_256[32] = {
+        0xba, 0x78, 0x16, 0xbf, 0x8f, 0x01, 0xcf, 0xea, 0x41, 0x41, 0x40, 0xde, 0x5d, 0xae, 0x22, 0x23,
+        0xb0, 0x03, 0x61, 0xa3, 0x96, 0x17, 0x7a, 0x9c, 0xb4, 0x10, 0xff, 0x61, 0xf2, 0x00, 0x15, 0xad
+    };
+    static const uint8_t two_block_256[32] = {
+        0x24, 0x8d, 0x6a, 0x61, 0xd2, 0x06, 0x38, 0xb8, 0xe5, 0xc0, 0x26, 0x93, 0x0c, 0x3e, 0x60, 0x39,
+        0xa3, 0x3c, 0xe4, 0x59, 0x64, 0xff, 0x21, 0x67, 0xf6, 0xec, 0xed, 0xd4, 0x19, 0xdb, 0x06, 0xc1
+    };
+    static const uint8_t long_256[32] = {
+        0x57, 0x79, 0x9d, 0xe8, 0x0e, 0x3d, 0xd6, 0xe2, 0xac, 0x4d, 0x40, 0xc4, 0x1a, 0x15, 0x0d, 0x16,
+        0x62, 0xf7, 0xf8, 0x7d, 0x0d, 0x99, 0x47, 0x76, 0xa2, 0xfd, 0xc3, 0x7c, 0x39, 0xb0, 0xea, 0x4e
+    };
+    static const uint8_t long_512[64] = {
+        0xbe, 0xf8, 0x24, 0x65, 0x84, 0x55, 0xc7, 0x5d, 0x8e, 0xd4, 0x38, 0xdb, 0x9b, 0x1c, 0x2c, 0x26,
+        0xc7, 0x05, 0xf5, 0xf0, 0x42, 0x3c, 0x3b, 0x42, 0x83, 0x4e, 0x0a, 0x5a, 0xde, 0xd3, 0x12, 0x3e,
+        0xfc, 0x6b, 0xe2, 0xda, 0x58, 0x9e, 0x55, 0xe4, 0x3f, 0x3d, 0x1d, 0x03, 0xe6, 0xa8, 0x31, 0x34,
+        0xbb, 0x97, 0x81, 0x33, 0x3b, 0xc6, 0x3f, 0x72, 0xa0, 0xe2, 0x55, 0x9d, 0x12, 0x63, 0x20, 0x9d
+    };
+    static const uint8_t abc_512[64] = {
+        0xdd, 0xaf, 0x35, 0xa1, 0x93, 0x61, 0x7a, 0xba, 0xcc, 0x41, 0x73, 0x49, 0xae, 0x20, 0x41, 0x31,
+        0x12, 0xe6, 0xfa, 0x4e, 0x89, 0xa9, 0x7e, 0xa2, 0x0a, 0x9e, 0xee, 0xe6, 0x4b, 0x55, 0xd3, 0x9a,
+        0x21, 0x92, 0x99, 0x2a, 0x27, 0x4f, 0xc1, 0xa8, 0x36, 0xba, 0x3c, 0x23, 0xa3, 0xfe, 0xeb, 0xbd,
+        0x45, 0x4d, 0x44, 0x23, 0x64, 0x3c, 0xe8, 0x0e, 0x2a, 0x9a, 0xc9, 0x4f, 0xa5, 0x4c, 0xa4, 0x9f
+    };
+
+    uint8_t data[1000];
+    for (size_t i = 0; i < sizeof(data); i++) data[i] = (uint8_t)(i * 37 + 11);
+
+    /* Independent inputs straddling the one- and two-block padding cases */
+    enum { MANY = 21 };
+    const uint8_t *inputs[MANY];
+    size_t lens[MANY];
+    uint8_t expected[MANY][32], digests[MANY][32];
+    for (size_t i = 0; i < MANY; i++) {
+        lens[i] = (i * 29) % 200;
+        inputs[i] = data + i * 7;
+    }
+    lens[3] = 55; lens[4] = 56; lens[5] = 64; lens[6] = 0;
+    espsol_sha_select(0);
+    for (size_t i = 0; i < MANY; i++) espsol_sha256(inputs[i], lens[i], expected[i]);
+
+    /* The same inputs after a shared prefix, ending on and off a block boundary */
+    static const size_t prefix_lens[] = { 0, 64, 96, 128 };
+    enum { PREFIXES = sizeof(prefix_lens) / sizeof(prefix_lens[0]) };
+    espsol_sha256_ctx_t prefixes[PREFIXES];
+    uint8_t expected_from[PREFIXES][MANY][32];
+    for (size_t k = 0; k < PREFIXES; k++) {
+        espsol_sha256_init(&prefixes[k]);
+        espsol_sha256_update(&prefixes[k], data + 500, prefix_lens[k]);
+        for (size_t i = 0; i < MANY; i++) {
+            espsol_sha256_ctx_t ctx = prefixes[k];
+            espsol_sha256_update(&ctx, inputs[i], lens[i]);
+            espsol_sha256_final(&ctx, expected_from[k][i]);
+        }
+    }
+
+    static const struct {
+        unsigned features;
+        const char *name;
+    } paths[] = {
+        { 0, "portable" },
+        { ESPSOL_SHA_SHANI, "SHA-NI" },
+        { ESPSOL_SHA_AVX2, "AVX2" },
+        { ESPSOL_SHA_SHANI | ESPSOL_SHA_AVX2, "SHA-NI + AVX2" },
+    };
+    unsigned cpu = espsol_sha_cpu_features();
+    char label[96];
+
+    for (size_t p = 0; p < sizeof(paths) / sizeof(paths[0]); p++) {
+        if ((paths[p].features & cpu) != paths[p].features) {
+            printf("  (%s not supported here, skipped)\n", paths[p].name);
+            continue;
+        }
+        TEST_ASSERT_EQ(espsol_sha_select(paths[p].features), paths[p].features, "Path selected");
+
+        uint8_t d256[32], d512[64];
+        bool ok = true;
+        espsol_sha256((const uint8_t *)"abc", 3, d256);
+        ok &= memcmp(d256, abc_256, 32) == 0;
+        espsol_sha256((const uint8_t *)"abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq",
+                      56, d256);
+        ok &= memcmp(d256, two_block_256, 32) == 0;
+        espsol_sha256(data, sizeof(data), d256);
+        ok &= memcmp(d256, long_256, 32) == 0;
+        snprintf(label, sizeof(label), "SHA-256 known answers (%s)", paths[p].name);
+        TEST_ASSERT(ok, label);
+
+        ok = true;
+        espsol_sha512((const uint8_t *)"abc", 3, d512);
+        ok &= memcmp(d512, abc_512, 64) == 0;
+        espsol_sha512(data, sizeof(data), d512);
+        ok &= memcmp(d512, long_512, 64) == 0;
+        snprintf(label, sizeof(label), "SHA-512 known answers (%s)", paths[p].name);
+        TEST_ASSERT(ok, label);
+
+        memset(digests, 0, sizeof(digests));
+        espsol_sha256_many(inputs, lens, MANY, digests);
+        snprintf(label, sizeof(label), "Multi-buffer SHA-256 matches (%s)", paths[p].name);
+        TEST_ASSERT(memcmp(digests, expected, sizeof(expected)) == 0, label);
+
+        /* Incremental digest split at odd offsets */
+        espsol_sha256_ctx_t ctx;
+        espsol_sha256_init(&ctx);
+        espsol_sha256_update(&ctx, data, 3);
+        espsol_sha256_update(&ctx, data + 3, 0);
+        espsol_sha256_update(&ctx, data + 3, 130);
+        espsol_sha256_update(&ctx, data + 133, sizeof(data) - 133);
+        espsol_sha256_final(&ctx, d256);
+        snprintf(label, sizeof(label), "Incremental SHA-256 matches (%s)", paths[p].name);
+        TEST_ASSERT(memcmp(d256, long_256, 32) == 0, label);
+
+        ok = true;
+        for (size_t k = 0; k < PREFIXES; k++) {
+            memset(digests, 0, sizeof(digests));
+            espsol_sha256_many_from(&prefixes[k], inputs, lens, MANY, digests);
+            ok &= memcmp(digests, expected_from[k], sizeof(digests)) == 0;
+        }
+        snprintf(label, sizeof(label), "Multi-buffer SHA-256 from a midstate matches (%s)",
+                 paths[p].name);
+        TEST_ASSERT(ok, label);
+    }
+
+    espsol_sha_select(~0u);
+}
+
+/* Producer that writes a message in chunks of a fixed size */
+typedef struct {
+    const uint8_t *data;
+    size_t len;
+    size_t chunk;
+    int calls;
+    int fail_on_call;
+} chunked_message_t;
+
+static esp_err_t write_chunked(void *ctx, const espsol_writer_t *writer)
+{
+    chunked_message_t *m = (chunked_message_t *)ctx;
+    m->calls++;
+    if (m->calls == m->fail_on_call) {
+        return ESP_ERR_ESPSOL_BUFFER_TOO_SMALL;
+    }
+    for (size_t off = 0; off < m->len; off += m->chunk) {
+        size_t n = m->len - off < m->chunk ? m->len - off : m->chunk;
+        esp_err_t err = writer->write(writer->ctx, m->data + off, n);
+        if (err != ESP_OK) {
+            return err;
+        }
+    }
+    return ESP_OK;
+}
+
+static void test_crypto_sign_stream(void)
+{
+    printf("\n========== Incremental Hashing and Streamed Signing ==========\n\n");
+
+    /* FIPS 180-2 SHA-512 examples: one block and two blocks */
+    static const uint8_t abc_digest[64] = {
+        0xdd, 0xaf, 0x35, 0xa1, 0x93, 0x61, 0x7a, 0xba, 0xcc, 0x41, 0x73, 0x49, 0xae, 0x20, 0x41, 0x31,
+        0x12, 0xe6, 0xfa, 0x4e, 0x89, 0xa9, 0x7e, 0xa2, 0x0a, 0x9e, 0xee, 0xe6, 0x4b, 0x55, 0xd3, 0x9a,
+        0x21, 0x92, 0x99, 0x2a, 0x27, 0x4f, 0xc1, 0xa8, 0x36, 0xba, 0x3c, 0x23, 0xa3, 0xfe, 0xeb, 0xbd,
+        0x45, 0x4d, 0x44, 0x23, 0x64, 0x3c, 0xe8, 0x0e, 0x2a, 0x9a, 0xc9, 0x4f, 0xa5, 0x4c, 0xa4, 0x9f
+    };
+    static const uint8_t long_digest[64] = {
+        0x8e, 0x95, 0x9b, 0x75, 0xda, 0xe3, 0x13, 0xda, 0x8c, 0xf4, 0xf7, 0x28, 0x14, 0xfc, 0x14, 0x3f,
+        0x8f, 0x77, 0x79, 0xc6, 0xeb, 0x9f, 0x7f, 0xa1, 0x72, 0x99, 0xae, 0xad, 0xb6, 0x88, 0x90, 0x18,
+        0x50, 0x1d, 0x28, 0x9e, 0x49, 0x00, 0xf7, 0xe4, 0x33, 0x1b, 0x99, 0xde, 0xc4, 0xb5, 0x43, 0x3a,
+        0xc7, 0xd3, 0x29, 0xee, 0xb6, 0xdd, 0x26, 0x54, 0x5e, 0x96, 0xe5, 0x5b, 0x87, 0x4b, 0xe9, 0x09
+    };
+    const char *long_msg = "abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmn"
+                           "hijklmnoijklmnopjklmnopqklmnopqrlmnopqrsmnopqrstnopqrstu";
+    uint8_t digest[64], expected[64];
+    espsol_sha512_ctx_t sha;
+
+    espsol_sha512((const uint8_t *)"abc", 3, digest);
+    TEST_ASSERT(memcmp(digest, abc_digest, 64) == 0, "SHA-512 of \"abc\"");
+
+    espsol_sha512_init(&sha);
+    espsol_sha512_update(&sha, (const uint8_t *)long_msg, 50);
+    espsol_sha512_update(&sha, NULL, 0);
+    espsol_sha512_update(&sha, (const uint8_t *)long_msg + 50, 62);
+    espsol_sha512_final(&sha, digest);
+    TEST_ASSERT(memcmp(digest, long_digest, 64) == 0, "SHA-512 of two-block message in pieces");
+
+    /* Every split point, across block boundaries and the padding cases */
+    uint8_t data[300];
+    for (size_t i = 0; i < sizeof(data); i++) data[i] = (uint8_t)(i * 37 + 11);
+    bool all_match = true;
+    for (size_t len = 0; len <= sizeof(data) && all_match; len += 7) {
+        espsol_sha512(data, len, expected);
+        for (size_t cut = 0; cut <= len; cut++) {
+            espsol_sha512_init(&sha);
+            espsol_sha512_update(&sha, data, cut);
+            espsol_sha512_update(&sha, data + cut, len - cut);
+            espsol_sha512_final(&sha, digest);
+            if (memcmp(digest, expected, 64) != 0) {
+                all_match = false;
+                break;
+            }
+        }
+    }
+    TEST_ASSERT(all_match, "Split updates match one-shot digests");
+
+    /* Streamed signatures match one-shot signatures for any chunking */
+    uint8_t seed[32];
+    for (int i = 0; i < 32; i++) seed[i] = (uint8_t)(0xa0 + i);
+    espsol_keypair_t keypair;
+    espsol_keypair_from_seed(seed, &keypair);
+
+    uint8_t sig[64], streamed[64];
+    chunked_message_t m = { data, sizeof(data), 1, 0, 0 };
+    bool same = true;
+    static const size_t chunks[] = { 1, 3, 64, 127, 128, 129, 300 };
+    for (size_t c = 0; c < sizeof(chunks) / sizeof(chunks[0]); c++) {
+        m.chunk = chunks[c];
+        m.calls = 0;
+        espsol_sign(data, sizeof(data), &keypair, sig);
+        if (espsol_sign_stream(write_chunked, &m, &keypair, streamed) != ESP_OK ||
+            memcmp(sig, streamed, 64) != 0 || m.calls != 2) {
+            same = false;
+        }
+    }
+    TEST_ASSERT(same, "Streamed signatures match, producer called twice");
+    TEST_ASSERT(espsol_verify(data, sizeof(data), streamed, keypair.public_key) == ESP_OK,
+                "Streamed signature verifies");
+
+    /* The raw key path expands the seed itself and must agree */
+    espsol_sign_raw(data, sizeof(data), keypair.private_key, streamed);
+    TEST_ASSERT(memcmp(sig, streamed, 64) == 0, "Raw key signature matches cached expansion");
+
+    espsol_keypair_t imported;
+    espsol_keypair_from_private_key(keypair.private_key, &imported);
+    espsol_sign(data, sizeof(data), &imported, streamed);
+    TEST_ASSERT(memcmp(sig, streamed, 64) == 0, "Imported keypair signs identically");
+
+    /* A failing producer stops signing and leaves no partial signature */
+    static const uint8_t zero[64] = {0};
+    m.chunk = 16;
+    m.calls = 0;
+    m.fail_on_call = 2;
+    esp_err_t err = espsol_sign_stream(write_chunked, &m, &keypair, streamed);
+    TEST_ASSERT(err == ESP_ERR_ESPSOL_BUFFER_TOO_SMALL && memcmp(streamed, zero, 64) == 0,
+                "Producer error returned, signature zeroed");
+
+    TEST_ASSERT(espsol_sign_stream(NULL, &m, &keypair, streamed) == ESP_ERR_INVALID_ARG,
+                "NULL producer rejected");
+    espsol_keypair_clear(&imported);
+    TEST_ASSERT(espsol_sign_stream(write_chunked, &m, &imported, streamed) ==
+                ESP_ERR_ESPSOL_KEYPAIR_NOT_INIT, "Cleared keypair rejected");
+
+    espsol_keypair_clear(&keypair);
+}
+
+static void test_crypto_verify_signers(void)
+{
+    printf("\n========== Multi-Signer Verification Tests ==========\n\n");
+
+    enum { SIGNERS = 8 };
+    espsol_keypair_t keypairs[SIGNERS];
+    uint8_t public_keys[SIGNERS][ESPSOL_PUBKEY_SIZE];
+    uint8_t signatures[SIGNERS][ESPSOL_SIGNATURE_SIZE];
+    uint8_t message[300];
+    for (size_t i = 0; i < sizeof(message); i++) {
+        message[i] = (uint8_t)(i * 13);
+    }
+    for (int i = 0; i < SIGNERS; i++) {
+        uint8_t seed[32];
+        memset(seed, 0x30 + i, sizeof(seed));
+        espsol_keypair_from_seed(seed, &keypairs[i]);
+        memcpy(public_keys[i], keypairs[i].public_key, ESPSOL_PUBKEY_SIZE);
+        espsol_sign(message, sizeof(message), &keypairs[i], signatures[i]);
+    }
+
+    size_t bad = 99;
+    esp_err_t err = espsol_verify_signers(message, sizeof(message),
+                                          (const uint8_t (*)[64])signatures,
+                                          (const uint8_t (*)[32])public_keys, SIGNERS, &bad);
+    TEST_ASSERT_EQ(err, ESP_OK, "All signatures verify");
+    TEST_ASSERT_EQ(bad, 99, "Index untouched on success");
+
+    err = espsol_verify_signers(message, sizeof(message),
+                                (const uint8_t (*)[64])signatures,
+                                (const uint8_t (*)[32])public_keys, 1, NULL);
+    TEST_ASSERT_EQ(err, ESP_OK, "Single signature verifies");
+    err = espsol_verify_signers(message, sizeof(message), NULL, NULL, 0, NULL);
+    TEST_ASSERT_EQ(err, ESP_OK, "Empty set verifies");
+    err = espsol_verify_signers(NULL, 4, (const uint8_t (*)[64])signatures,
+                                (const uint8_t (*)[32])public_keys, 2, NULL);
+    TEST_ASSERT_EQ(err, ESP_ERR_INVALID_ARG, "NULL message with length rejected");
+
+    signatures[5][10] ^= 0x01;
+    err = espsol_verify_signers(message, sizeof(message),
+                                (const uint8_t (*)[64])signatures,
+                                (const uint8_t (*)[32])public_keys, SIGNERS, &bad);
+    TEST_ASSERT(err == ESP_ERR_ESPSOL_SIGNATURE_INVALID && bad == 5,
+                "Corrupted R found by index");
+    signatures[5][10] ^= 0x01;
+
+    signatures[6][40] ^= 0x01;
+    err = espsol_verify_signers(message, sizeof(message),
+                                (const uint8_t (*)[64])signatures,
+                                (const uint8_t (*)[32])public_keys, SIGNERS, &bad);
+    TEST_ASSERT(err == ESP_ERR_ESPSOL_SIGNATURE_INVALID && bad == 6,
+                "Corrupted S found by index");
+    signatures[6][40] ^= 0x01;
+
+    message[0] ^= 0x01;
+    err = espsol_verify_signers(message, sizeof(message),
+                                (const uint8_t (*)[64])signatures,
+                                (const uint8_t (*)[32])public_keys, SIGNERS, &bad);
+    TEST_ASSERT(err == ESP_ERR_ESPSOL_SIGNATURE_INVALID && bad == 0, "Changed message rejected");
+    message[0] ^= 0x01;
+
+    /* Valid signatures under swapped keys */
+    uint8_t swapped[2][ESPSOL_PUBKEY_SIZE];
+    memcpy(swapped[0], public_keys[1], 32);
+    memcpy(swapped[1], public_keys[0], 32);
+    err = espsol_verify_signers(message, sizeof(message), (const uint8_t (*)[64])signatures,
+                                (const uint8_t (*)[32])swapped, 2, &bad);
+    TEST_ASSERT(err == ESP_ERR_ESPSOL_SIGNATURE_INVALID && bad == 0, "Swapped keys rejected");
+
+    /* S + L verifies the same equation but is a malleated encoding */
+    static const uint8_t order[32] = {
+        0xed, 0xd3, 0xf5, 0x5c, 0x1a, 0x63, 0x12, 0x58, 0xd6, 0x9c, 0xf7, 0xa2,
+        0xde, 0xf9, 0xde, 0x14, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x10
+    };
+    uint8_t malleated[2][ESPSOL_SIGNATURE_SIZE];
+    memcpy(malleated, signatures, sizeof(malleated));
+    unsigned carry = 0;
+    for (int i = 0; i < 32; i++) {
+        carry += malleated[1][32 + i] + order[i];
+        malleated[1][32 + i] = (uint8_t)carry;
+        carry >>= 8;
+    }
+    err = espsol_verify(message, sizeof(message), malleated[1], public_keys[1]);
+    TEST_ASSERT_EQ(err, ESP_ERR_ESPSOL_SIGNATURE_INVALID, "Non-canonical S rejected");
+    err = espsol_verify_signers(message, sizeof(message), (const uint8_t (*)[64])malleated,
+                                (const uint8_t (*)[32])public_keys, 2, &bad);
+    TEST_ASSERT(err == ESP_ERR_ESPSOL_SIGNATURE_INVALID && bad == 1,
+                "Non-canonical S rejected in a batch");
+
+    /* R = [r]B + T with T of order 8 and S = r + k*a: the cofactored
+     * equation holds but [S]B - [k]A != R, so the runtime rejects it */
+    static const uint8_t mixed_key[32] = {
+        0x03, 0x52, 0x8a, 0x84, 0xcf, 0x35, 0xf3, 0x3d, 0xbe, 0xf1, 0xb3, 0x21,
+        0x92, 0xd9, 0x35, 0x14, 0x4e, 0x9d, 0x62, 0x33, 0x84, 0xd0, 0xb0, 0x79,
+        0xca, 0x68, 0x7c, 0x00, 0x10, 0x9b, 0x81, 0x96
+    };
+    static const uint8_t mixed_sig[64] = {
+        0x77, 0x1c, 0xde, 0x0e, 0x45, 0x99, 0x06, 0xc6, 0xaa, 0x59, 0xbc, 0x5e,
+        0x70, 0x60, 0x5a, 0xb7, 0x79, 0x85, 0x1b, 0x38, 0xa0, 0xa2, 0x9c, 0x22,
+        0x2a, 0x71, 0x5d, 0x3c, 0x14, 0xb9, 0x62, 0xae, 0x30, 0xd8, 0x94, 0x35,
+        0x85, 0x46, 0xae, 0x64, 0xcc, 0xdb, 0x97, 0xf2, 0x59, 0x47, 0x01, 0x9a,
+        0x17, 0xb2, 0x8b, 0xe6, 0x9d, 0x44, 0xa7, 0xbd, 0x74, 0x14, 0x0c, 0x77,
+        0x74, 0x17, 0xa7, 0x0d
+    };
+    static const char mixed_msg[] = "mixed-order R";
+    espsol_keypair_t mixed_signer;
+    uint8_t mixed_seed[32];
+    memset(mixed_seed, 0x3a, sizeof(mixed_seed));
+    espsol_keypair_from_seed(mixed_seed, &mixed_signer);
+    TEST_ASSERT(memcmp(mixed_signer.public_key, mixed_key, 32) == 0, "Mixed-order vector key derived");
+    err = espsol_verify((const uint8_t *)mixed_msg, strlen(mixed_msg), mixed_sig, mixed_key);
+    TEST_ASSERT_EQ(err, ESP_ERR_ESPSOL_SIGNATURE_INVALID, "Mixed-order R rejected");
+    uint8_t mixed_sigs[2][ESPSOL_SIGNATURE_SIZE];
+    uint8_t mixed_keys[2][ESPSOL_PUBKEY_SIZE];
+    espsol_sign((const uint8_t *)mixed_msg, strlen(mixed_msg), &keypairs[0], mixed_sigs[0]);
+    memcpy(mixed_keys[0], keypairs[0].public_key, 32);
+    memcpy(mixed_sigs[1], mixed_sig, 64);
+    memcpy(mixed_keys[1], mixed_key, 32);
+    err = espsol_verify_signers((const uint8_t *)mixed_msg, strlen(mixed_msg),
+                                (const uint8_t (*)[64])mixed_sigs,
+                                (const uint8_t (*)[32])mixed_keys, 2, &bad);
+    TEST_ASSERT(err == ESP_ERR_ESPSOL_SIGNATURE_INVALID && bad == 1,
+                "Mixed-order R rejected among signers");
+    espsol_keypair_clear(&mixed_signer);
+}
+
+static void test_crypto_verify_batch(void)
+{
+    printf("\n========== Batch Verification Tests ==========\n\n");
+
+    /* Telemetry from a few devices; 150 items take the bucket path */
+    enum { DEVICES = 6, ITEMS = 150, SMALL = 20 };
+    static uint8_t messages[ITEMS][48];
+    static uint8_t signatures[ITEMS][ESPSOL_SIGNATURE_SIZE];
+    static espsol_signed_message_t items[ITEMS];
+    espsol_keypair_t keypairs[DEVICES];
+
+    for (int i = 0; i < DEVICES; i++) {
+        uint8_t seed[32];
+        memset(seed, 0x50 + i, sizeof(seed));
+        espsol_keypair_from_seed(seed, &keypairs[i]);
+    }
+    for (int i = 0; i < ITEMS; i++) {
+        espsol_keypair_t *kp = &keypairs[i % DEVICES];
+        size_t len = (size_t)(i % 49);
+        for (size_t j = 0; j < len; j++) {
+            messages[i][j] = (uint8_t)(i * 31 + j);
+        }
+        espsol_sign(messages[i], len, kp, signatures[i]);
+        items[i].message = len ? messages[i] : NULL;
+        items[i].message_len = len;
+        items[i].signature = signatures[i];
+        items[i].public_key = kp->public_key;
+    }
+
+    size_t bad = 999;
+    esp_err_t err = espsol_verify_batch(items, SMALL, &bad);
+    TEST_ASSERT_EQ(err, ESP_OK, "Small batch verifies");
+    err = espsol_verify_batch(items, ITEMS, &bad);
+    TEST_ASSERT_EQ(err, ESP_OK, "Large batch verifies");
+    TEST_ASSERT_EQ(bad, 999, "Index untouched on success");
+    TEST_ASSERT_EQ(espsol_verify_batch(NULL, 0, NULL), ESP_OK, "Empty batch verifies");
+    TEST_ASSERT_EQ(espsol_verify_batch(NULL, 3, NULL), ESP_ERR_INVALID_ARG, "NULL items rejected");
+    items[4].public_key = NULL;
+    TEST_ASSERT_EQ(espsol_verify_batch(items, SMALL, NULL), ESP_ERR_INVALID_ARG,
+                   "NULL public key rejected");
+    items[4].public_key = keypairs[4].public_key;
+
+    signatures[13][50] ^= 0x20;
+    err = espsol_verify_batch(items, SMALL, &bad);
+    TEST_ASSERT(err == ESP_ERR_ESPSOL_SIGNATURE_INVALID && bad == 13, "Bad signature pinpointed");
+    signatures[13][50] ^= 0x20;
+
+    messages[120][3] ^= 0x01;
+    err = espsol_verify_batch(items, ITEMS, &bad);
+    TEST_ASSERT(err == ESP_ERR_ESPSOL_SIGNATURE_INVALID && bad == 120,
+                "Changed message pinpointed in a large batch");
+    messages[120][3] ^= 0x01;
+
+    /* Message signed by one device, claimed by another */
+    items[7].public_key = keypairs[0].public_key;
+    err = espsol_verify_batch(items, ITEMS, &bad);
+    TEST_ASSERT(err == ESP_ERR_ESPSOL_SIGNATURE_INVALID && bad == 7, "Wrong signer pinpointed");
+    items[7].public_key = keypairs[7 % DEVICES].public_key;
+
+    /* Swapping two signatures keeps every equation term but breaks each one */
+    items[30].signature = signatures[31];
+    items[31].signature = signatures[30];
+    err = espsol_verify_batch(items, ITEMS, &bad);
+    TEST_ASSERT(err == ESP_ERR_ESPSOL_SIGNATURE_INVALID && bad == 30, "Swapped signatures rejected");
+    items[30].signature = signatures[30];
+    items[31].signature = signatures[31];
+
+    /* Several bad items: the result must match per-item verification on
+     * every backend, whether or not it batches */
+    signatures[3][5] ^= 0x01;
+    messages[9][0] ^= 0x01;
+    signatures[40][60] ^= 0x01;
+    size_t expected = ITEMS;
+    for (int i = 0; i < ITEMS; i++) {
+        if (espsol_verify(items[i].message, items[i].message_len, items[i].signature,
+                          items[i].public_key) != ESP_OK) {
+            expected = (size_t)i;
+            break;
+        }
+    }
+    TEST_ASSERT_EQ(expected, 3, "Per-item verification finds the first bad item");
+    err = espsol_verify_batch(items, ITEMS, &bad);
+    TEST_ASSERT(err == ESP_ERR_ESPSOL_SIGNATURE_INVALID && bad == expected,
+                "Mixed batch reports the first bad item");
+    err = espsol_verify_batch(items + 4, ITEMS - 4, &bad);
+    TEST_ASSERT(err == ESP_ERR_ESPSOL_SIGNATURE_INVALID && bad == 5,
+                "Next bad item found after the first");
+    err = espsol_verify_batch(items + 10, 30, &bad);
+    TEST_ASSERT_EQ(err, ESP_OK, "Valid run between bad items verifies");
+    err = espsol_verify_batch(items + 10, 31, &bad);
+    TEST_ASSERT(err == ESP_ERR_ESPSOL_SIGNATURE_INVALID && bad == 30,
+                "Bad last item found");
+    signatures[3][5] ^= 0x01;
+    messages[9][0] ^= 0x01;
+    signatures[40][60] ^= 0x01;
+
+    clock_t start = clock();
+    for (int i = 0; i < ITEMS; i++) {
+        espsol_verify(items[i].message, items[i].message_len, items[i].signature,
+                      items[i].public_key);
+    }
+    clock_t separate = clock() - start;
+    start = clock();
+    espsol_verify_batch(items, ITEMS, NULL);
+    clock_t batched = clock() - start;
+    printf("  %d messages: separate %.1f ms, batched %.1f ms\n", ITEMS,
+           separate * 1000.0 / CLOCKS_PER_SEC, batched * 1000.0 / CLOCKS_PER_SEC);
+}
+
 static void test_crypto_self_test(void)
 {
     printf("\n========== Crypto Self-Test ==========\n\n");
@@ -549,10 +1306,16 @@ int main(void)
 
     test_base58_encode_decode();
     test_base64_encode_decode();
+    test_writers();
     test_address_utils();
     test_hex_utils();
     test_crypto_keypair();
     test_crypto_signing();
+    test_crypto_vectors();
+    test_sha_paths();
+    test_crypto_sign_stream();
+    test_crypto_verify_signers();
+    test_crypto_verify_batch();
     test_crypto_self_test();
 
     printf("\n");
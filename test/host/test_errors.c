@@ -71,9 +71,10 @@ static void test_error_code_values(void)
     TEST_ASSERT_EQ(ESP_ERR_ESPSOL_NOT_INITIALIZED, 0x50012, "NOT_INITIALIZED = 0x50012");
     TEST_ASSERT_EQ(ESP_ERR_ESPSOL_RATE_LIMITED, 0x50013, "RATE_LIMITED = 0x50013");
     TEST_ASSERT_EQ(ESP_ERR_ESPSOL_INVALID_MNEMONIC, 0x50014, "INVALID_MNEMONIC = 0x50014");
+    TEST_ASSERT_EQ(ESP_ERR_ESPSOL_CANCELLED, 0x50015, "CANCELLED = 0x50015");
     
     /* Verify MAX is set correctly */
-    TEST_ASSERT_EQ(ESP_ERR_ESPSOL_MAX, ESP_ERR_ESPSOL_INVALID_MNEMONIC, "MAX error equals INVALID_MNEMONIC");
+    TEST_ASSERT_EQ(ESP_ERR_ESPSOL_MAX, ESP_ERR_ESPSOL_CANCELLED, "MAX error equals CANCELLED");
 }
 
 static void test_espsol_is_err_macro(void)
@@ -86,6 +87,7 @@ static void test_espsol_is_err_macro(void)
     TEST_ASSERT(ESPSOL_IS_ERR(ESP_ERR_ESPSOL_RATE_LIMITED), "RATE_LIMITED is ESPSOL error");
     TEST_ASSERT(ESPSOL_IS_ERR(ESP_ERR_ESPSOL_CRYPTO_ERROR), "CRYPTO_ERROR is ESPSOL error");
     TEST_ASSERT(ESPSOL_IS_ERR(ESP_ERR_ESPSOL_INVALID_MNEMONIC), "INVALID_MNEMONIC is ESPSOL error");
+    TEST_ASSERT(ESPSOL_IS_ERR(ESP_ERR_ESPSOL_CANCELLED), "CANCELLED is ESPSOL error");
     
     /* Test non-ESPSOL errors */
     TEST_ASSERT(!ESPSOL_IS_ERR(ESP_OK), "ESP_OK is not ESPSOL error");
@@ -95,7 +97,7 @@ static void test_espsol_is_err_macro(void)
     
     /* Test edge cases */
     TEST_ASSERT(!ESPSOL_IS_ERR(ESP_ERR_ESPSOL_BASE), "BASE alone is not ESPSOL error");
-    TEST_ASSERT(!ESPSOL_IS_ERR(ESP_ERR_ESPSOL_BASE + 0x15), "Beyond MAX is not ESPSOL error");
+    TEST_ASSERT(!ESPSOL_IS_ERR(ESP_ERR_ESPSOL_BASE + 0x16), "Beyond MAX is not ESPSOL error");
     TEST_ASSERT(!ESPSOL_IS_ERR(0), "Zero is not ESPSOL error");
 }
 
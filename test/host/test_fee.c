@@ -0,0 +1,226 @@
+/**
+ * @file test_fee.c
+ * @brief Host-based Unit Tests for ESPSOL Rent and Fee Calculation
+ *
+ * Tests Rent sysvar decoding, rent-exempt minimum balances,
+ * and transaction fee calculation.
+ *
+ * @copyright Copyright (c) 2025 SkyRizz
+ * @license Apache-2.0
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Include ESPSOL headers */
+#include "espsol_types.h"
+#include "espsol_crypto.h"
+#include "espsol_tx.h"
+#include "espsol_token.h"
+#include "espsol_fee.h"
+
+/* ============================================================================
+ * Test Framework
+ * ========================================================================== */
+
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        if (condition) { \
+            printf("✓ PASS: %s\n", message); \
+            tests_passed++; \
+        } else { \
+            printf("✗ FAIL: %s\n", message); \
+            tests_failed++; \
+        } \
+    } while (0)
+
+#define TEST_ASSERT_EQ(actual, expected, message) \
+    do { \
+        if ((actual) == (expected)) { \
+            printf("✓ PASS: %s\n", message); \
+            tests_passed++; \
+        } else { \
+            printf("✗ FAIL: %s (expected %llu, got %llu)\n", message, \
+                   (unsigned long long)(expected), (unsigned long long)(actual)); \
+            tests_failed++; \
+        } \
+    } while (0)
+
+/* ============================================================================
+ * Rent Tests
+ * ========================================================================== */
+
+static void test_rent_decode(void)
+{
+    printf("\n========== Rent Sysvar Decode Tests ==========\n\n");
+
+    /* 3480 lamports/byte-year, threshold 2.0, burn 50% */
+    const uint8_t sysvar[ESPSOL_RENT_SYSVAR_SIZE] = {
+        0x98, 0x0d, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40,
+        0x32
+    };
+
+    espsol_rent_t rent;
+    esp_err_t err = espsol_rent_decode(sysvar, sizeof(sysvar), &rent);
+    TEST_ASSERT_EQ(err, ESP_OK, "Decode Rent sysvar");
+    TEST_ASSERT_EQ(rent.lamports_per_byte_year, 3480, "lamports_per_byte_year = 3480");
+    TEST_ASSERT(rent.exemption_threshold == 2.0, "exemption_threshold = 2.0");
+    TEST_ASSERT_EQ(rent.burn_percent, 50, "burn_percent = 50");
+
+    /* Truncated data */
+    err = espsol_rent_decode(sysvar, sizeof(sysvar) - 1, &rent);
+    TEST_ASSERT_EQ(err, ESP_ERR_INVALID_ARG, "Truncated sysvar rejected");
+
+    /* Negative threshold */
+    uint8_t bad[ESPSOL_RENT_SYSVAR_SIZE];
+    memcpy(bad, sysvar, sizeof(bad));
+    bad[15] = 0xC0;
+    err = espsol_rent_decode(bad, sizeof(bad), &rent);
+    TEST_ASSERT_EQ(err, ESP_ERR_INVALID_ARG, "Negative threshold rejected");
+
+    err = espsol_rent_decode(NULL, sizeof(sysvar), &rent);
+    TEST_ASSERT_EQ(err, ESP_ERR_INVALID_ARG, "NULL data rejected");
+}
+
+static void test_rent_minimum_balance(void)
+{
+    printf("\n========== Rent Minimum Balance Tests ==========\n\n");
+
+    uint64_t lamports = 0;
+    espsol_rent_t rent = ESPSOL_RENT_DEFAULT();
+
+    esp_err_t err = espsol_rent_minimum_balance(&rent, 0, &lamports);
+    TEST_ASSERT_EQ(err, ESP_OK, "Minimum balance for empty account");
+    TEST_ASSERT_EQ(lamports, 890880, "Empty account = 890880 lamports");
+
+    espsol_rent_minimum_balance(&rent, ESPSOL_TOKEN_ACCOUNT_SIZE, &lamports);
+    TEST_ASSERT_EQ(lamports, ESPSOL_TOKEN_ACCOUNT_RENT, "Token account matches ESPSOL_TOKEN_ACCOUNT_RENT");
+
+    espsol_rent_minimum_balance(&rent, ESPSOL_MINT_ACCOUNT_SIZE, &lamports);
+    TEST_ASSERT_EQ(lamports, 1461600, "Mint account = 1461600 lamports");
+
+    /* NULL rent uses defaults */
+    espsol_rent_minimum_balance(NULL, 1, &lamports);
+    TEST_ASSERT_EQ(lamports, 890880 + 6960, "NULL rent uses default parameters");
+
+    /* Fractional threshold is exact */
+    rent.lamports_per_byte_year = 1000;
+    rent.exemption_threshold = 1.5;
+    espsol_rent_minimum_balance(&rent, 0, &lamports);
+    TEST_ASSERT_EQ(lamports, 192000, "Threshold 1.5 computed exactly");
+
+    rent.exemption_threshold = 0.0;
+    espsol_rent_minimum_balance(&rent, 100, &lamports);
+    TEST_ASSERT_EQ(lamports, 0, "Zero threshold gives zero balance");
+
+    /* Overflow is reported */
+    rent.lamports_per_byte_year = UINT64_MAX / 2;
+    rent.exemption_threshold = 2.0;
+    err = espsol_rent_minimum_balance(&rent, 0, &lamports);
+    TEST_ASSERT_EQ(err, ESP_ERR_INVALID_ARG, "Overflow rejected");
+
+    err = espsol_rent_minimum_balance(NULL, 0, NULL);
+    TEST_ASSERT_EQ(err, ESP_ERR_INVALID_ARG, "NULL output rejected");
+}
+
+/* ============================================================================
+ * Fee Tests
+ * ========================================================================== */
+
+static void test_fee_calculate(void)
+{
+    printf("\n========== Fee Calculation Tests ==========\n\n");
+
+    uint64_t lamports = 0;
+
+    espsol_fee_priority(200000, 1, &lamports);
+    TEST_ASSERT_EQ(lamports, 1, "Priority fee rounds up");
+
+    espsol_fee_priority(200000, 1000000, &lamports);
+    TEST_ASSERT_EQ(lamports, 200000, "Priority fee 1 lamport per CU");
+
+    espsol_fee_priority(0, 5000, &lamports);
+    TEST_ASSERT_EQ(lamports, 0, "Zero compute units has no priority fee");
+
+    TEST_ASSERT(espsol_fee_priority(ESPSOL_MAX_COMPUTE_UNIT_LIMIT, UINT64_MAX, &lamports) ==
+                ESP_ERR_INVALID_ARG, "Priority fee overflow rejected");
+
+    esp_err_t err = espsol_fee_calculate(1, 0, 0, &lamports);
+    TEST_ASSERT_EQ(err, ESP_OK, "Calculate base fee");
+    TEST_ASSERT_EQ(lamports, 5000, "One signature = 5000 lamports");
+
+    espsol_fee_calculate(2, 300000, 10000, &lamports);
+    TEST_ASSERT_EQ(lamports, 13000, "Two signatures plus priority fee");
+}
+
+static void test_tx_calculate_fee(void)
+{
+    printf("\n========== Transaction Fee Tests ==========\n\n");
+
+    uint8_t seed[32];
+    for (int i = 0; i < 32; i++) seed[i] = (uint8_t)(i + 1);
+    espsol_keypair_t payer;
+    espsol_keypair_from_seed(seed, &payer);
+
+    uint8_t recipient[32];
+    for (int i = 0; i < 32; i++) recipient[i] = (uint8_t)(i + 0x21);
+
+    espsol_tx_handle_t tx;
+    espsol_tx_create(&tx);
+    espsol_tx_set_fee_payer(tx, payer.public_key);
+    espsol_tx_add_transfer(tx, payer.public_key, recipient, 1000);
+
+    uint64_t fee = 0;
+    esp_err_t err = espsol_tx_calculate_fee(tx, &fee);
+    TEST_ASSERT_EQ(err, ESP_OK, "Calculate transfer fee");
+    TEST_ASSERT_EQ(fee, 5000, "Plain transfer costs 5000 lamports");
+
+    /* SetComputeUnitPrice(10000 micro-lamports) without a limit:
+     * default 200k units for the one transfer instruction */
+    uint8_t price_data[9] = { 3, 0x10, 0x27, 0, 0, 0, 0, 0, 0 };
+    espsol_tx_add_instruction(tx, ESPSOL_COMPUTE_BUDGET_PROGRAM_ID, NULL, 0,
+                               price_data, sizeof(price_data));
+    espsol_tx_calculate_fee(tx, &fee);
+    TEST_ASSERT_EQ(fee, 7000, "Price with default limit adds 2000 lamports");
+
+    /* SetComputeUnitLimit(100000) */
+    uint8_t limit_data[5] = { 2, 0xa0, 0x86, 0x01, 0x00 };
+    espsol_tx_add_instruction(tx, ESPSOL_COMPUTE_BUDGET_PROGRAM_ID, NULL, 0,
+                               limit_data, sizeof(limit_data));
+    espsol_tx_calculate_fee(tx, &fee);
+    TEST_ASSERT_EQ(fee, 6000, "Explicit limit adds 1000 lamports");
+
+    err = espsol_tx_calculate_fee(NULL, &fee);
+    TEST_ASSERT_EQ(err, ESP_ERR_INVALID_ARG, "NULL transaction rejected");
+
+    espsol_tx_destroy(tx);
+}
+
+/* ============================================================================
+ * Main
+ * ========================================================================== */
+
+int main(void)
+{
+    printf("==============================================\n");
+    printf("   ESPSOL Rent and Fee Host Tests\n");
+    printf("==============================================\n");
+
+    test_rent_decode();
+    test_rent_minimum_balance();
+    test_fee_calculate();
+    test_tx_calculate_fee();
+
+    /* Summary */
+    printf("\n==============================================\n");
+    printf("Test Summary: %d passed, %d failed\n", tests_passed, tests_failed);
+    printf("==============================================\n");
+
+    return tests_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,147 @@
+/**
+ * @file test_node.h
+ * @brief Shared Fixtures for ESPSOL Host Tests
+ *
+ * A fee payer with a fixed blockhash for building transactions, and a
+ * canned-response RPC node that answers every request with the same body,
+ * buffered or streamed in small chunks.
+ *
+ * @copyright Copyright (c) 2025 SkyRizz
+ * @license Apache-2.0
+ */
+
+#ifndef TEST_NODE_H
+#define TEST_NODE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "espsol_types.h"
+#include "espsol_crypto.h"
+#include "espsol_tx.h"
+#include "espsol_rpc.h"
+#include "espsol_transport.h"
+#include "espsol_utils.h"
+
+/* ============================================================================
+ * Transactions
+ * ========================================================================== */
+
+static espsol_keypair_t payer;
+static uint8_t blockhash[ESPSOL_BLOCKHASH_SIZE];
+
+static inline espsol_tx_handle_t new_tx(void)
+{
+    espsol_tx_handle_t tx = NULL;
+    espsol_tx_create(&tx);
+    espsol_tx_set_fee_payer(tx, payer.public_key);
+    espsol_tx_set_recent_blockhash(tx, blockhash);
+    return tx;
+}
+
+/* ============================================================================
+ * RPC Node
+ * ========================================================================== */
+
+typedef struct {
+    char *body;             /**< Response for the next request */
+    size_t chunk;           /**< Bytes per sink call */
+    bool stream_only;       /**< Fail buffered exchanges */
+    char request[512];      /**< Last request */
+} test_node_t;
+
+static inline esp_err_t test_node_perform(void *ctx,
+                                          const char *request, size_t request_len,
+                                          char *response, size_t response_cap,
+                                          size_t *response_len,
+                                          int *status_code,
+                                          const espsol_deadline_t *deadline)
+{
+    test_node_t *node = ctx;
+    (void)deadline;
+
+    snprintf(node->request, sizeof(node->request), "%.*s", (int)request_len, request);
+    if (node->stream_only) {
+        *status_code = 500;
+        return ESP_FAIL;
+    }
+    size_t len = strlen(node->body);
+    if (len >= response_cap) {
+        return ESP_ERR_ESPSOL_BUFFER_TOO_SMALL;
+    }
+    memcpy(response, node->body, len + 1);
+    *response_len = len;
+    *status_code = 200;
+    return ESP_OK;
+}
+
+static inline esp_err_t test_node_perform_stream(void *ctx,
+                                                 const char *request, size_t request_len,
+                                                 espsol_rpc_sink_fn sink, void *sink_ctx,
+                                                 int *status_code,
+                                                 const espsol_deadline_t *deadline)
+{
+    test_node_t *node = ctx;
+    (void)deadline;
+
+    snprintf(node->request, sizeof(node->request), "%.*s", (int)request_len, request);
+    *status_code = 200;
+
+    size_t len = strlen(node->body);
+    size_t chunk = node->chunk ? node->chunk : len;
+    esp_err_t err = ESP_OK;
+    for (size_t pos = 0; pos < len && err == ESP_OK; pos += chunk) {
+        size_t n = len - pos < chunk ? len - pos : chunk;
+        err = sink(sink_ctx, 200, node->body + pos, n);
+    }
+    return err;
+}
+
+/**
+ * @brief Create a client that talks to node, without retries
+ */
+static inline espsol_rpc_handle_t test_node_connect(test_node_t *node)
+{
+    espsol_rpc_transport_t transport = {
+        .perform = test_node_perform,
+        .perform_stream = test_node_perform_stream,
+        .ctx = node,
+    };
+    espsol_rpc_config_t config = ESPSOL_RPC_CONFIG_DEFAULT();
+    config.max_retries = 0;
+    config.transport = &transport;
+    espsol_rpc_handle_t rpc = NULL;
+    espsol_rpc_init_with_config(&rpc, &config);
+    return rpc;
+}
+
+/**
+ * @brief Answer with a raw body
+ */
+static inline void test_node_set_body(test_node_t *node, const char *body)
+{
+    free(node->body);
+    node->body = strdup(body);
+}
+
+/**
+ * @brief Answer getAccountInfo with base64 account data
+ */
+static inline void test_node_set_account(test_node_t *node, const uint8_t *data, size_t len,
+                                         const char *owner)
+{
+    char *b64 = malloc(espsol_base64_encoded_len(len));
+    espsol_base64_encode(data, len, b64, espsol_base64_encoded_len(len));
+
+    size_t cap = strlen(b64) + 512;
+    node->body = realloc(node->body, cap);
+    snprintf(node->body, cap,
+             "{\"jsonrpc\":\"2.0\",\"result\":{\"context\":{\"slot\":300},"
+             "\"value\":{\"data\":[\"%s\",\"base64\"],\"executable\":false,"
+             "\"lamports\":1447680,\"owner\":\"%s\",\"rentEpoch\":0}},\"id\":1}",
+             b64, owner);
+    free(b64);
+}
+
+#endif /* TEST_NODE_H */
@@ -0,0 +1,375 @@
+/**
+ * @file test_nonce.c
+ * @brief Host-based Unit Tests for ESPSOL Durable Nonces
+ *
+ * Tests nonce account decoding, the nonce cache, fetching nonce accounts
+ * over RPC, the System Program nonce instructions and the durable nonce
+ * transaction mode.
+ *
+ * @copyright Copyright (c) 2025 SkyRizz
+ * @license Apache-2.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Include ESPSOL headers */
+#include "espsol_types.h"
+#include "espsol_crypto.h"
+#include "espsol_tx.h"
+#include "espsol_rpc.h"
+#include "espsol_transport.h"
+#include "espsol_utils.h"
+#include "espsol_nonce.h"
+
+#include "test_node.h"
+
+/* ============================================================================
+ * Test Framework
+ * ========================================================================== */
+
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        if (condition) { \
+            printf("✓ PASS: %s\n", message); \
+            tests_passed++; \
+        } else { \
+            printf("✗ FAIL: %s\n", message); \
+            tests_failed++; \
+        } \
+    } while (0)
+
+#define TEST_ASSERT_EQ(actual, expected, message) \
+    do { \
+        if ((actual) == (expected)) { \
+            printf("✓ PASS: %s\n", message); \
+            tests_passed++; \
+        } else { \
+            printf("✗ FAIL: %s (expected %llu, got %llu)\n", message, \
+                   (unsigned long long)(expected), (unsigned long long)(actual)); \
+            tests_failed++; \
+        } \
+    } while (0)
+
+/* ============================================================================
+ * Helpers
+ * ========================================================================== */
+
+/**
+ * @brief Build nonce account data with the nonce filled with fill
+ */
+static void make_nonce(uint8_t data[ESPSOL_NONCE_ACCOUNT_SIZE], uint32_t state, uint8_t fill)
+{
+    memset(data, 0, ESPSOL_NONCE_ACCOUNT_SIZE);
+    data[0] = 1;
+    data[4] = (uint8_t)state;
+    memcpy(data + 8, payer.public_key, ESPSOL_PUBKEY_SIZE);
+    memset(data + 40, fill, ESPSOL_BLOCKHASH_SIZE);
+    data[72] = 0x88;
+    data[73] = 0x13;
+}
+
+static size_t sign_and_serialize(espsol_tx_handle_t tx, uint8_t *buffer)
+{
+    size_t len = 0;
+    if (espsol_tx_sign(tx, &payer) != ESP_OK ||
+        espsol_tx_serialize(tx, buffer, ESPSOL_MAX_TX_SIZE, &len) != ESP_OK) {
+        return 0;
+    }
+    return len;
+}
+
+static const uint8_t *message_tail(espsol_tx_handle_t tx, size_t tail)
+{
+    const uint8_t *message = NULL;
+    size_t len = 0;
+    if (espsol_tx_get_message(tx, &message, &len) != ESP_OK || len < tail) {
+        return NULL;
+    }
+    return message + len - tail;
+}
+
+/* ============================================================================
+ * Decode and Cache Tests
+ * ========================================================================== */
+
+static void test_decode(void)
+{
+    printf("\n========== Nonce Decode Tests ==========\n\n");
+
+    uint8_t data[ESPSOL_NONCE_ACCOUNT_SIZE];
+    make_nonce(data, 1, 0xC1);
+
+    espsol_nonce_state_t state;
+    esp_err_t err = espsol_nonce_decode(data, sizeof(data), &state);
+    TEST_ASSERT_EQ(err, ESP_OK, "Decode nonce account");
+    TEST_ASSERT(state.version == 1 && state.initialized, "Version and state decoded");
+    TEST_ASSERT(memcmp(state.authority, payer.public_key, 32) == 0, "Authority decoded");
+    TEST_ASSERT(state.nonce[0] == 0xC1 && state.nonce[31] == 0xC1, "Nonce decoded");
+    TEST_ASSERT_EQ(state.lamports_per_signature, 5000, "Fee rate decoded");
+
+    make_nonce(data, 0, 0);
+    err = espsol_nonce_decode(data, sizeof(data), &state);
+    TEST_ASSERT(err == ESP_OK && !state.initialized, "Uninitialized account decoded");
+
+    TEST_ASSERT_EQ(espsol_nonce_decode(data, sizeof(data) - 1, &state), ESP_ERR_ESPSOL_RPC_PARSE_ERROR,
+                   "Wrong size rejected");
+    data[0] = 2;
+    TEST_ASSERT_EQ(espsol_nonce_decode(data, sizeof(data), &state), ESP_ERR_ESPSOL_RPC_PARSE_ERROR,
+                   "Unknown version rejected");
+    TEST_ASSERT_EQ(espsol_nonce_decode(NULL, sizeof(data), &state), ESP_ERR_INVALID_ARG, "NULL data rejected");
+}
+
+static void test_cache(void)
+{
+    printf("\n========== Nonce Cache Tests ==========\n\n");
+
+    espsol_nonce_cache_handle_t cache = NULL;
+    TEST_ASSERT_EQ(espsol_nonce_cache_create(0, &cache), ESP_ERR_INVALID_ARG, "Empty cache rejected");
+    TEST_ASSERT_EQ(espsol_nonce_cache_create(2, &cache), ESP_OK, "Create cache");
+
+    uint8_t a[32], b[32], c[32], key[32];
+    memset(a, 0xA0, 32);
+    memset(b, 0xB0, 32);
+    memset(c, 0xC0, 32);
+
+    uint8_t data[ESPSOL_NONCE_ACCOUNT_SIZE];
+    make_nonce(data, 0, 0);
+    TEST_ASSERT_EQ(espsol_nonce_cache_put(cache, a, data, sizeof(data)), ESP_ERR_ESPSOL_RPC_PARSE_ERROR,
+                   "Uninitialized account rejected");
+
+    make_nonce(data, 1, 0x11);
+    TEST_ASSERT_EQ(espsol_nonce_cache_put(cache, a, data, sizeof(data)), ESP_OK, "Put first account");
+    make_nonce(data, 1, 0x22);
+    TEST_ASSERT_EQ(espsol_nonce_cache_put(cache, b, data, sizeof(data)), ESP_OK, "Put second account");
+    TEST_ASSERT_EQ(espsol_nonce_cache_put(cache, c, data, sizeof(data)), ESP_ERR_NO_MEM, "Full cache rejected");
+
+    espsol_nonce_state_t state;
+    bool used = true;
+    esp_err_t err = espsol_nonce_cache_get(cache, a, &state, &used);
+    TEST_ASSERT(err == ESP_OK && !used && state.nonce[0] == 0x11, "Get cached account");
+    TEST_ASSERT_EQ(espsol_nonce_cache_get(cache, c, &state, NULL), ESP_ERR_NOT_FOUND, "Unknown account");
+
+    /* Each nonce is handed out once */
+    err = espsol_nonce_cache_take(cache, key, &state);
+    TEST_ASSERT(err == ESP_OK && memcmp(key, a, 32) == 0 && state.nonce[0] == 0x11, "Take first nonce");
+    err = espsol_nonce_cache_take(cache, key, &state);
+    TEST_ASSERT(err == ESP_OK && memcmp(key, b, 32) == 0, "Take second nonce");
+    TEST_ASSERT_EQ(espsol_nonce_cache_take(cache, key, &state), ESP_ERR_NOT_FOUND, "All nonces used");
+    espsol_nonce_cache_get(cache, a, &state, &used);
+    TEST_ASSERT(used, "Taken nonce marked used");
+
+    /* Only a new nonce value makes an account available again */
+    make_nonce(data, 1, 0x11);
+    espsol_nonce_cache_put(cache, a, data, sizeof(data));
+    TEST_ASSERT_EQ(espsol_nonce_cache_take(cache, key, &state), ESP_ERR_NOT_FOUND,
+                   "Same nonce stays used");
+    make_nonce(data, 1, 0x12);
+    espsol_nonce_cache_put(cache, a, data, sizeof(data));
+    err = espsol_nonce_cache_take(cache, key, &state);
+    TEST_ASSERT(err == ESP_OK && memcmp(key, a, 32) == 0 && state.nonce[0] == 0x12,
+                "Advanced nonce available again");
+
+    TEST_ASSERT_EQ(espsol_nonce_cache_remove(cache, b), ESP_OK, "Remove account");
+    TEST_ASSERT_EQ(espsol_nonce_cache_remove(cache, b), ESP_ERR_NOT_FOUND, "Removed account gone");
+    TEST_ASSERT_EQ(espsol_nonce_cache_put(cache, c, data, sizeof(data)), ESP_OK, "Removed slot reused");
+
+    espsol_nonce_cache_destroy(cache);
+}
+
+/* ============================================================================
+ * RPC Fetch Tests
+ * ========================================================================== */
+
+static void test_fetch(void)
+{
+    printf("\n========== Nonce Fetch Tests ==========\n\n");
+
+    test_node_t node = {0};
+    espsol_rpc_handle_t rpc = test_node_connect(&node);
+
+    espsol_nonce_cache_handle_t cache = NULL;
+    espsol_nonce_cache_create(4, &cache);
+
+    uint8_t key[32];
+    memset(key, 0x0C, 32);
+    char address[ESPSOL_ADDRESS_MAX_LEN];
+    espsol_pubkey_to_address(key, address, sizeof(address));
+
+    uint8_t data[ESPSOL_NONCE_ACCOUNT_SIZE];
+    make_nonce(data, 1, 0x5A);
+    test_node_set_account(&node, data, sizeof(data), "11111111111111111111111111111111");
+
+    esp_err_t err = espsol_nonce_cache_fetch(cache, rpc, key);
+    TEST_ASSERT_EQ(err, ESP_OK, "Fetch nonce account");
+    TEST_ASSERT(strstr(node.request, "\"getAccountInfo\"") && strstr(node.request, address),
+                "Nonce account requested");
+
+    espsol_nonce_state_t state;
+    TEST_ASSERT(espsol_nonce_cache_get(cache, key, &state, NULL) == ESP_OK && state.nonce[0] == 0x5A,
+                "Fetched nonce cached");
+
+    test_node_set_account(&node, data, sizeof(data), "Sysvar1111111111111111111111111111111111111");
+    TEST_ASSERT_EQ(espsol_nonce_cache_fetch(cache, rpc, key), ESP_ERR_ESPSOL_RPC_PARSE_ERROR,
+                   "Account owned by another program rejected");
+
+    uint8_t big[ESPSOL_NONCE_ACCOUNT_SIZE + 8] = {0};
+    test_node_set_account(&node, big, sizeof(big), "11111111111111111111111111111111");
+    TEST_ASSERT_EQ(espsol_nonce_cache_fetch(cache, rpc, key), ESP_ERR_ESPSOL_RPC_PARSE_ERROR,
+                   "Oversized account rejected");
+
+    test_node_set_body(&node, "{\"jsonrpc\":\"2.0\",\"result\":{\"context\":{\"slot\":300},\"value\":null},\"id\":1}");
+    TEST_ASSERT_EQ(espsol_nonce_cache_fetch(cache, rpc, key), ESP_ERR_NOT_FOUND, "Missing account");
+
+    free(node.body);
+    espsol_nonce_cache_destroy(cache);
+    espsol_rpc_deinit(rpc);
+}
+
+/* ============================================================================
+ * Instruction Tests
+ * ========================================================================== */
+
+static void test_instructions(void)
+{
+    printf("\n========== Nonce Instruction Tests ==========\n\n");
+
+    uint8_t nonce[32], recipient[32];
+    memset(nonce, 0x0C, 32);
+    memset(recipient, 0x33, 32);
+
+    /* Keys: payer 0, nonce 1, recipient 2, System 3, RecentBlockhashes 4, Rent 5 */
+    espsol_tx_handle_t tx = new_tx();
+    TEST_ASSERT_EQ(espsol_tx_add_nonce_withdraw(tx, nonce, payer.public_key, recipient, 1000),
+                   ESP_OK, "Add withdraw");
+    const uint8_t *tail = message_tail(tx, 20);
+    const uint8_t withdraw[] = { 3, 5, 1, 2, 4, 5, 0, 12, 5, 0, 0, 0, 0xE8, 0x03, 0, 0, 0, 0, 0, 0 };
+    TEST_ASSERT(tail && memcmp(tail, withdraw, sizeof(withdraw)) == 0, "Withdraw accounts and data");
+    espsol_tx_destroy(tx);
+
+    tx = new_tx();
+    TEST_ASSERT_EQ(espsol_tx_add_nonce_authorize(tx, nonce, payer.public_key, recipient),
+                   ESP_OK, "Add authorize");
+    tail = message_tail(tx, 5 + 36);
+    const uint8_t authorize[] = { 2, 2, 1, 0, 36, 7, 0, 0, 0, 0x33 };
+    TEST_ASSERT(tail && memcmp(tail, authorize, sizeof(authorize)) == 0, "Authorize accounts and data");
+    espsol_tx_destroy(tx);
+
+    tx = new_tx();
+    TEST_ASSERT_EQ(espsol_tx_add_nonce_create(tx, payer.public_key, nonce, payer.public_key, 1447680),
+                   ESP_OK, "Add create and initialize");
+    tail = message_tail(tx, 6 + 36);
+    const uint8_t initialize[] = { 2, 3, 1, 3, 4, 36, 6, 0, 0, 0 };
+    TEST_ASSERT(tail && memcmp(tail, initialize, sizeof(initialize)) == 0 &&
+                memcmp(tail + 10, payer.public_key, 32) == 0, "Initialize follows create");
+    TEST_ASSERT_EQ(espsol_tx_add_nonce_advance(tx, NULL, payer.public_key), ESP_ERR_INVALID_ARG,
+                   "Advance without account rejected");
+    espsol_tx_destroy(tx);
+}
+
+/* ============================================================================
+ * Durable Transaction Tests
+ * ========================================================================== */
+
+static void test_durable_tx(void)
+{
+    printf("\n========== Durable Transaction Tests ==========\n\n");
+
+    uint8_t nonce_account[32], other[32], recipient[32];
+    uint8_t nonce[32], next_nonce[32];
+    memset(nonce_account, 0x0C, 32);
+    memset(other, 0x0D, 32);
+    memset(recipient, 0x33, 32);
+    memset(nonce, 0x5A, 32);
+    memset(next_nonce, 0x5B, 32);
+
+    /* Compute Budget added later still goes after AdvanceNonceAccount */
+    espsol_tx_handle_t tx = NULL;
+    espsol_tx_create(&tx);
+    espsol_tx_set_fee_payer(tx, payer.public_key);
+    espsol_tx_add_transfer(tx, payer.public_key, recipient, 1000);
+    esp_err_t err = espsol_tx_set_durable_nonce(tx, nonce_account, payer.public_key, nonce);
+    TEST_ASSERT_EQ(err, ESP_OK, "Set durable nonce");
+    espsol_tx_set_compute_unit_price(tx, 5000);
+
+    espsol_tx_handle_t manual = NULL;
+    espsol_tx_create(&manual);
+    espsol_tx_set_fee_payer(manual, payer.public_key);
+    espsol_tx_set_recent_blockhash(manual, nonce);
+    espsol_tx_add_nonce_advance(manual, nonce_account, payer.public_key);
+    const uint8_t price[] = { 3, 0x88, 0x13, 0, 0, 0, 0, 0, 0 };
+    espsol_tx_add_instruction(manual, ESPSOL_COMPUTE_BUDGET_PROGRAM_ID, NULL, 0, price, sizeof(price));
+    espsol_tx_add_transfer(manual, payer.public_key, recipient, 1000);
+
+    uint8_t wire[ESPSOL_MAX_TX_SIZE], expected[ESPSOL_MAX_TX_SIZE];
+    size_t len = sign_and_serialize(tx, wire);
+    size_t expected_len = sign_and_serialize(manual, expected);
+    TEST_ASSERT(len > 0 && len == expected_len && memcmp(wire, expected, len) == 0,
+                "Advance stays first and nonce is the blockhash");
+
+    /* Refreshing the nonce keeps a single advance instruction */
+    err = espsol_tx_set_durable_nonce(tx, nonce_account, payer.public_key, next_nonce);
+    TEST_ASSERT_EQ(err, ESP_OK, "Refresh nonce");
+    TEST_ASSERT(!espsol_tx_is_signed(tx), "Refresh drops signatures");
+    espsol_tx_set_recent_blockhash(manual, next_nonce);
+    len = sign_and_serialize(tx, wire);
+    expected_len = sign_and_serialize(manual, expected);
+    TEST_ASSERT(len > 0 && len == expected_len && memcmp(wire, expected, len) == 0,
+                "Refreshed nonce matches");
+
+    TEST_ASSERT_EQ(espsol_tx_set_durable_nonce(tx, other, payer.public_key, nonce), ESP_ERR_INVALID_ARG,
+                   "Different nonce account rejected");
+    TEST_ASSERT_EQ(espsol_tx_set_durable_nonce(tx, nonce_account, recipient, nonce), ESP_ERR_INVALID_ARG,
+                   "Different authority rejected");
+
+    /* Clearing the Compute Budget leaves the advance in place */
+    espsol_tx_clear_compute_budget(tx);
+    espsol_tx_destroy(manual);
+    espsol_tx_create(&manual);
+    espsol_tx_set_fee_payer(manual, payer.public_key);
+    espsol_tx_set_recent_blockhash(manual, next_nonce);
+    espsol_tx_add_nonce_advance(manual, nonce_account, payer.public_key);
+    espsol_tx_add_transfer(manual, payer.public_key, recipient, 1000);
+    len = sign_and_serialize(tx, wire);
+    expected_len = sign_and_serialize(manual, expected);
+    TEST_ASSERT(len > 0 && len == expected_len && memcmp(wire, expected, len) == 0,
+                "Advance kept after clearing Compute Budget");
+
+    espsol_tx_destroy(manual);
+    espsol_tx_destroy(tx);
+}
+
+/* ============================================================================
+ * Main
+ * ========================================================================== */
+
+int main(void)
+{
+    printf("==============================================\n");
+    printf("   ESPSOL Durable Nonce Host Tests\n");
+    printf("==============================================\n");
+
+    uint8_t seed[32];
+    memset(seed, 0x42, sizeof(seed));
+    espsol_keypair_from_seed(seed, &payer);
+    memset(blockhash, 0xab, sizeof(blockhash));
+
+    test_decode();
+    test_cache();
+    test_fetch();
+    test_instructions();
+    test_durable_tx();
+
+    /* Summary */
+    printf("\n==============================================\n");
+    printf("Test Summary: %d passed, %d failed\n", tests_passed, tests_failed);
+    printf("==============================================\n");
+
+    return tests_failed > 0 ? 1 : 0;
+}
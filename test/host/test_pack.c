@@ -0,0 +1,331 @@
+/**
+ * @file test_pack.c
+ * @brief Host-based Unit Tests for ESPSOL Instruction Packer
+ *
+ * Tests greedy packing of instructions into transactions under the size,
+ * account, signer and instruction limits.
+ *
+ * @copyright Copyright (c) 2025 SkyRizz
+ * @license Apache-2.0
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Include ESPSOL headers */
+#include "espsol_types.h"
+#include "espsol_utils.h"
+#include "espsol_crypto.h"
+#include "espsol_tx.h"
+#include "espsol_pack.h"
+
+/* ============================================================================
+ * Test Framework
+ * ========================================================================== */
+
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        if (condition) { \
+            printf("✓ PASS: %s\n", message); \
+            tests_passed++; \
+        } else { \
+            printf("✗ FAIL: %s\n", message); \
+            tests_failed++; \
+        } \
+    } while (0)
+
+#define TEST_ASSERT_EQ(actual, expected, message) \
+    do { \
+        if ((actual) == (expected)) { \
+            printf("✓ PASS: %s\n", message); \
+            tests_passed++; \
+        } else { \
+            printf("✗ FAIL: %s (expected %llu, got %llu)\n", message, \
+                   (unsigned long long)(expected), (unsigned long long)(actual)); \
+            tests_failed++; \
+        } \
+    } while (0)
+
+/* Priority fee every new transaction starts with (run_tests.sh builds both) */
+#ifdef CONFIG_ESPSOL_DEFAULT_PRIORITY_FEE
+#define DEFAULT_FEE CONFIG_ESPSOL_DEFAULT_PRIORITY_FEE
+#else
+#define DEFAULT_FEE 0
+#endif
+
+/* ============================================================================
+ * Helpers
+ * ========================================================================== */
+
+static espsol_keypair_t payer;
+static uint8_t blockhash[32];
+static uint8_t program_id[32];
+
+static espsol_packer_handle_t create_packer(bool reserve_compute_budget)
+{
+    espsol_packer_config_t config = ESPSOL_PACKER_CONFIG_DEFAULT();
+    memcpy(config.fee_payer, payer.public_key, 32);
+    config.blockhash = blockhash;
+    config.reserve_compute_budget = reserve_compute_budget;
+
+    espsol_packer_handle_t packer = NULL;
+    espsol_packer_create(&config, &packer);
+    return packer;
+}
+
+/**
+ * @brief Take every closed transaction, sign and serialize it
+ * @return Number of transactions, or -1 if one failed
+ */
+static int drain(espsol_packer_handle_t packer, size_t *instructions, size_t *max_len,
+                 bool add_compute_budget)
+{
+    espsol_tx_handle_t tx;
+    int count = 0;
+    *instructions = 0;
+    *max_len = 0;
+
+    while (espsol_packer_take(packer, &tx) == ESP_OK) {
+        size_t n = 0;
+        espsol_tx_get_instruction_count(tx, &n);
+        *instructions += n;
+
+        if (add_compute_budget) {
+            const uint8_t limit[5] = { 2, 0x40, 0x0d, 0x03, 0x00 };
+            const uint8_t price[9] = { 3, 0xe8, 0x03 };
+            if (espsol_tx_add_instruction(tx, ESPSOL_COMPUTE_BUDGET_PROGRAM_ID, NULL, 0, limit, 5) != ESP_OK ||
+                espsol_tx_add_instruction(tx, ESPSOL_COMPUTE_BUDGET_PROGRAM_ID, NULL, 0, price, 9) != ESP_OK) {
+                count = -1;
+            }
+        }
+
+        uint8_t buffer[ESPSOL_MAX_TX_SIZE];
+        size_t len = 0;
+        if (espsol_tx_sign(tx, &payer) != ESP_OK ||
+            espsol_tx_serialize(tx, buffer, sizeof(buffer), &len) != ESP_OK) {
+            count = -1;
+        }
+        if (len > *max_len) {
+            *max_len = len;
+        }
+        espsol_tx_destroy(tx);
+        if (count >= 0) {
+            count++;
+        }
+    }
+    return count;
+}
+
+/* ============================================================================
+ * Packer Tests
+ * ========================================================================== */
+
+#if DEFAULT_FEE == 0
+/* Exact packing counts assume transactions start empty */
+static void test_pack_transfers(void)
+{
+    printf("\n========== Transfer Packing Tests ==========\n\n");
+
+    espsol_packer_handle_t packer = create_packer(true);
+    TEST_ASSERT(packer != NULL, "Create packer");
+
+    esp_err_t err = ESP_OK;
+    for (int i = 0; i < 100 && err == ESP_OK; i++) {
+        uint8_t to[32];
+        memset(to, 0, sizeof(to));
+        to[0] = (uint8_t)i;
+        to[31] = 0x5a;
+        err = espsol_packer_add_transfer(packer, payer.public_key, to, 1000 + i);
+    }
+    TEST_ASSERT_EQ(err, ESP_OK, "Add 100 transfers");
+    TEST_ASSERT_EQ(espsol_packer_pending(packer), 12, "Full transactions closed while packing");
+    espsol_packer_flush(packer);
+
+    size_t instructions = 0, max_len = 0;
+    int count = drain(packer, &instructions, &max_len, true);
+    TEST_ASSERT_EQ(count, 13, "Eight transfers per transaction with budget room");
+    TEST_ASSERT_EQ(instructions, 100, "Every transfer packed once");
+    TEST_ASSERT(max_len <= ESPSOL_MAX_TX_SIZE, "Compute Budget instructions fit the reserve");
+
+    /* Repeated recipient: shared keys cost nothing */
+    uint8_t to[32];
+    memset(to, 0x77, sizeof(to));
+    espsol_packer_destroy(packer);
+    packer = create_packer(false);
+    for (int i = 0; i < 25; i++) {
+        espsol_packer_add_transfer(packer, payer.public_key, to, 1);
+    }
+    espsol_packer_flush(packer);
+    count = drain(packer, &instructions, &max_len, false);
+    TEST_ASSERT_EQ(count, 3, "Ten transfers per transaction without reserve");
+
+    espsol_tx_handle_t tx = NULL;
+    TEST_ASSERT_EQ(espsol_packer_take(packer, &tx), ESP_ERR_NOT_FOUND, "Nothing left to take");
+    TEST_ASSERT_EQ(espsol_packer_flush(packer), ESP_OK, "Flush with nothing open");
+    espsol_packer_destroy(packer);
+}
+
+static void test_pack_limits(void)
+{
+    printf("\n========== Packing Limit Tests ==========\n\n");
+
+    static uint8_t data[ESPSOL_MAX_TX_SIZE];
+    memset(data, 0x3c, sizeof(data));
+    size_t instructions = 0, max_len = 0;
+
+    /* Size: empty transaction 134 bytes, program key 32, instruction 4 + data */
+    espsol_packer_handle_t packer = create_packer(false);
+    esp_err_t err = espsol_packer_add_instruction(packer, program_id, NULL, 0, data, 1063);
+    TEST_ASSERT_EQ(err, ESP_ERR_ESPSOL_BUFFER_TOO_SMALL, "Oversized instruction rejected");
+    err = espsol_packer_add_instruction(packer, program_id, NULL, 0, data, 1062);
+    TEST_ASSERT_EQ(err, ESP_OK, "Packing continues after rejection");
+    espsol_packer_flush(packer);
+    drain(packer, &instructions, &max_len, false);
+    TEST_ASSERT_EQ(max_len, ESPSOL_MAX_TX_SIZE, "Tracked size is exact");
+
+    for (int i = 0; i < 7; i++) {
+        espsol_packer_add_instruction(packer, program_id, NULL, 0, data, 300);
+    }
+    espsol_packer_flush(packer);
+    int count = drain(packer, &instructions, &max_len, false);
+    TEST_ASSERT_EQ(count, 3, "Three 300-byte instructions per transaction");
+    TEST_ASSERT(max_len <= ESPSOL_MAX_TX_SIZE, "Size limit respected");
+
+    /* Accounts: payer, program and five new accounts per instruction */
+    espsol_account_meta_t accounts[5];
+    memset(accounts, 0, sizeof(accounts));
+    for (int i = 0; i < 6; i++) {
+        for (int a = 0; a < 5; a++) {
+            memset(accounts[a].pubkey, 0x10 + i * 5 + a, 32);
+            accounts[a].is_writable = true;
+        }
+        espsol_packer_add_instruction(packer, program_id, accounts, 5, NULL, 0);
+    }
+    espsol_packer_flush(packer);
+    count = drain(packer, &instructions, &max_len, false);
+    TEST_ASSERT_EQ(count, 2, "Three instructions per transaction under the account limit");
+
+    /* Signers: 96 bytes each; repeats within a transaction count once */
+    espsol_keypair_t signers[12];
+    for (int i = 0; i < 12; i++) {
+        uint8_t seed[32];
+        memset(seed, 0xa0 + i, sizeof(seed));
+        espsol_keypair_from_seed(seed, &signers[i]);
+    }
+    for (int i = 0; i < 3; i++) {
+        for (int a = 0; a < 4; a++) {
+            memcpy(accounts[a].pubkey, signers[i * 4 + a].public_key, 32);
+            accounts[a].is_signer = true;
+        }
+        espsol_packer_add_instruction(packer, program_id, accounts, 4, NULL, 0);
+        if (i < 2) {
+            espsol_packer_add_instruction(packer, program_id, accounts, 4, NULL, 0);
+            TEST_ASSERT_EQ(espsol_packer_pending(packer), 0, "Repeated signers counted once");
+        }
+    }
+    TEST_ASSERT_EQ(espsol_packer_pending(packer), 1, "Thirteenth signer starts a new transaction");
+    espsol_packer_destroy(packer);
+
+    espsol_packer_config_t config = ESPSOL_PACKER_CONFIG_DEFAULT();
+    config.reserve_instructions = ESPSOL_MAX_INSTRUCTIONS;
+    TEST_ASSERT_EQ(espsol_packer_create(&config, &packer), ESP_ERR_INVALID_ARG, "Reserve leaving no room rejected");
+    TEST_ASSERT_EQ(espsol_packer_create(NULL, &packer), ESP_ERR_INVALID_ARG, "NULL config rejected");
+}
+#endif
+
+static void test_pack_default_fee(void)
+{
+    printf("\n========== Default Priority Fee Tests ==========\n\n");
+
+    /* New transactions may start with a price instruction the packer must count */
+    espsol_packer_handle_t packer = create_packer(false);
+    esp_err_t err = ESP_OK;
+    for (int i = 0; i < 40 && err == ESP_OK; i++) {
+        uint8_t to[32];
+        memset(to, 0x21, sizeof(to));
+        to[0] = (uint8_t)i;
+        err = espsol_packer_add_transfer(packer, payer.public_key, to, 1);
+    }
+    TEST_ASSERT_EQ(err, ESP_OK, "Add 40 transfers");
+    TEST_ASSERT(espsol_packer_pending(packer) >= 3, "Full transactions closed while packing");
+    espsol_packer_flush(packer);
+
+    size_t instructions = 0, max_len = 0;
+    int count = drain(packer, &instructions, &max_len, false);
+    TEST_ASSERT(count >= 4, "Every transaction signed and serialized");
+    TEST_ASSERT_EQ(instructions, 40 + (DEFAULT_FEE > 0 ? (size_t)count : 0),
+                   "Every transfer packed once, plus one price instruction per transaction");
+    TEST_ASSERT(max_len <= ESPSOL_MAX_TX_SIZE, "Size limit respected");
+    espsol_tx_handle_t tx = NULL;
+
+    /* The reserve leaves room for the limit only, the price being in place */
+    espsol_packer_destroy(packer);
+    packer = create_packer(true);
+    uint8_t data[120];
+    memset(data, 0x5a, sizeof(data));
+    for (int i = 0; i < 40; i++) {
+        espsol_packer_add_instruction(packer, program_id, NULL, 0, data, sizeof(data));
+    }
+    espsol_packer_flush(packer);
+    bool budget_fits = true, filled = true;
+    size_t taken = 0;
+    while (espsol_packer_take(packer, &tx) == ESP_OK) {
+        size_t size = 0;
+        espsol_tx_set_compute_unit_limit(tx, 200000);
+        espsol_tx_set_compute_unit_price(tx, 1000);
+        espsol_tx_get_size(tx, &size);
+        budget_fits = budget_fits && size <= ESPSOL_MAX_TX_SIZE;
+        /* Every transaction but the last has no room for one more instruction */
+        taken++;
+        if (espsol_packer_pending(packer) > 0) {
+            filled = filled && size + 3 + sizeof(data) > ESPSOL_MAX_TX_SIZE;
+        }
+        espsol_tx_destroy(tx);
+    }
+    TEST_ASSERT(taken >= 3 && budget_fits, "Compute Budget fits every packed transaction");
+    TEST_ASSERT(filled, "Reserve counts only the missing budget instructions");
+
+    /* A flush with only the default instruction yields nothing */
+    espsol_packer_add_transfer(packer, payer.public_key, payer.public_key, 1);
+    espsol_packer_flush(packer);
+    TEST_ASSERT_EQ(espsol_packer_take(packer, &tx), ESP_OK, "Take the last transaction");
+    espsol_tx_destroy(tx);
+    TEST_ASSERT_EQ(espsol_packer_flush(packer), ESP_OK, "Flush with nothing packed");
+    TEST_ASSERT_EQ(espsol_packer_pending(packer), 0, "No empty transaction closed");
+    espsol_packer_destroy(packer);
+}
+
+/* ============================================================================
+ * Main
+ * ========================================================================== */
+
+int main(void)
+{
+    printf("==============================================\n");
+    printf("   ESPSOL Instruction Packer Host Tests\n");
+    printf("==============================================\n");
+
+    uint8_t seed[32];
+    memset(seed, 0x42, sizeof(seed));
+    espsol_keypair_from_seed(seed, &payer);
+    memset(blockhash, 0xab, sizeof(blockhash));
+    memset(program_id, 0x03, sizeof(program_id));
+
+#if DEFAULT_FEE == 0
+    test_pack_transfers();
+    test_pack_limits();
+#endif
+    test_pack_default_fee();
+
+    /* Summary */
+    printf("\n==============================================\n");
+    printf("Test Summary: %d passed, %d failed\n", tests_passed, tests_failed);
+    printf("==============================================\n");
+
+    return tests_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,1208 @@
+/**
+ * @file test_rpc.c
+ * @brief Host-based Unit Tests for ESPSOL RPC Client and Transports
+ *
+ * Runs the RPC client against an in-process fake node, records the
+ * session, and replays it through a fresh client without the node.
+ *
+ * @copyright Copyright (c) 2025 SkyRizz
+ * @license Apache-2.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <time.h>
+#include <pthread.h>
+#include <unistd.h>
+
+/* Include ESPSOL headers */
+#include "espsol_types.h"
+#include "espsol_rpc.h"
+#include "espsol_transport.h"
+#include "espsol_cancel.h"
+#include "espsol_utils.h"
+
+/* ============================================================================
+ * Test Framework
+ * ========================================================================== */
+
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        if (condition) { \
+            printf("✓ PASS: %s\n", message); \
+            tests_passed++; \
+        } else { \
+            printf("✗ FAIL: %s\n", message); \
+            tests_failed++; \
+        } \
+    } while (0)
+
+#define TEST_ASSERT_EQ(actual, expected, message) \
+    do { \
+        if ((actual) == (expected)) { \
+            printf("✓ PASS: %s\n", message); \
+            tests_passed++; \
+        } else { \
+            printf("✗ FAIL: %s (expected %llu, got %llu)\n", message, \
+                   (unsigned long long)(expected), (unsigned long long)(actual)); \
+            tests_failed++; \
+        } \
+    } while (0)
+
+/* ============================================================================
+ * Fake RPC Node
+ * ========================================================================== */
+
+#define RECORDING_PATH  "test_rpc_recording.bin"
+#define TEST_BLOCKHASH  "CZ8YUVdk7znjrUmnb5n7kgySk9yRAsQDYmyCxzfSky9t"
+#define TEST_SIGNATURE  "5VERv8NMvzbJMEkV8xnrLkEaWRtSz9CosKDYjCJjBRnbJLgp8uirBgmQpjKhoR4tjF3ZpRzrFmBV6UjKdiSZkQUW"
+#define TEST_PUBKEY     "11111111111111111111111111111111"
+
+#define HISTORY_LEN     40
+
+typedef struct {
+    int calls;              /**< Exchanges served */
+    int slot_failures;      /**< getSlot requests to answer with 429 */
+    int history_calls;      /**< getSignaturesForAddress requests served */
+    int history_failures;   /**< getSignaturesForAddress requests to fail */
+    char sent[2048];        /**< Last sendTransaction request body */
+} fake_node_t;
+
+/**
+ * @brief Read the sigNNN index following key in a request, -1 if absent
+ */
+static int request_sig_index(const char *request, const char *key)
+{
+    const char *p = strstr(request, key);
+    return p ? atoi(p + strlen(key)) : -1;
+}
+
+/**
+ * @brief Serve getSignaturesForAddress from a fixed history of sig000 (newest)
+ *        to sig039 (oldest)
+ */
+static esp_err_t fake_node_history(fake_node_t *node, const char *request,
+                                   char *response, size_t response_cap,
+                                   size_t *response_len)
+{
+    node->history_calls++;
+    if (node->history_failures > 0) {
+        node->history_failures--;
+        const char *body = "{\"jsonrpc\":\"2.0\",\"error\":{\"code\":-32000,"
+                           "\"message\":\"Try again\"},\"id\":1}";
+        *response_len = strlen(body);
+        memcpy(response, body, *response_len);
+        return ESP_OK;
+    }
+
+    int before = request_sig_index(request, "\"before\":\"sig");
+    int until = request_sig_index(request, "\"until\":\"sig");
+    int limit = request_sig_index(request, "\"limit\":");
+    int first = before + 1;
+    int end = until >= 0 ? until : HISTORY_LEN;
+
+    size_t len = (size_t)snprintf(response, response_cap, "{\"jsonrpc\":\"2.0\",\"result\":[");
+    for (int i = first; i < end && i < first + limit; i++) {
+        char err[48] = "null";
+        char block_time[16] = "null";
+        if (i % 7 == 3) {
+            strcpy(err, "{\"InstructionError\":[0,{\"Custom\":1}]}");
+        }
+        if (i % 10 != 9) {
+            snprintf(block_time, sizeof(block_time), "%d", 1700000000 - i);
+        }
+        len += (size_t)snprintf(response + len, len < response_cap ? response_cap - len : 0,
+                                "%s{\"signature\":\"sig%03d\",\"slot\":%d,\"err\":%s,"
+                                "\"memo\":null,\"blockTime\":%s,"
+                                "\"confirmationStatus\":\"finalized\"}",
+                                i > first ? "," : "", i, 1000 - i, err, block_time);
+    }
+    len += (size_t)snprintf(response + len, len < response_cap ? response_cap - len : 0,
+                            "],\"id\":1}");
+    if (len > response_cap) {
+        return ESP_ERR_ESPSOL_BUFFER_TOO_SMALL;
+    }
+    *response_len = len;
+    return ESP_OK;
+}
+
+static esp_err_t fake_node_perform(void *ctx,
+                                   const char *request, size_t request_len,
+                                   char *response, size_t response_cap,
+                                   size_t *response_len,
+                                   int *status_code,
+                                   const espsol_deadline_t *deadline)
+{
+    fake_node_t *node = ctx;
+    const char *body;
+    (void)deadline;
+
+    node->calls++;
+    *status_code = 200;
+
+    if (strstr(request, "\"getSignaturesForAddress\"")) {
+        return fake_node_history(node, request, response, response_cap, response_len);
+    }
+
+    if (strstr(request, "\"getBalance\"")) {
+        body = "{\"jsonrpc\":\"2.0\",\"result\":{\"context\":{\"slot\":1},"
+               "\"value\":2500000000},\"id\":1}";
+    } else if (strstr(request, "\"getLatestBlockhash\"")) {
+        body = "{\"jsonrpc\":\"2.0\",\"result\":{\"context\":{\"slot\":1},"
+               "\"value\":{\"blockhash\":\"" TEST_BLOCKHASH "\","
+               "\"lastValidBlockHeight\":987654321}},\"id\":1}";
+    } else if (strstr(request, "\"getAccountInfo\"")) {
+        body = "{\"jsonrpc\":\"2.0\",\"result\":{\"context\":{\"slot\":1},"
+               "\"value\":{\"data\":[\"mA0AAAAAAAAAAAAAAAAAQDI=\",\"base64\"],"
+               "\"executable\":false,\"lamports\":1009200,"
+               "\"owner\":\"Sysvar1111111111111111111111111111111111111\","
+               "\"rentEpoch\":18446744073709551615}},\"id\":1}";
+    } else if (strstr(request, "\"sendTransaction\"")) {
+        if (request_len < sizeof(node->sent)) {
+            memcpy(node->sent, request, request_len + 1);
+        }
+        body = "{\"jsonrpc\":\"2.0\",\"result\":\"" TEST_SIGNATURE "\",\"id\":1}";
+    } else if (strstr(request, "\"getSlot\"")) {
+        if (node->slot_failures > 0) {
+            node->slot_failures--;
+            *status_code = 429;
+            body = "Too many requests";
+        } else {
+            body = "{\"jsonrpc\":\"2.0\",\"result\":123456789,\"id\":1}";
+        }
+    } else if (strstr(request, "\"getTokenAccountBalance\"")) {
+        body = "{\"jsonrpc\":\"2.0\",\"result\":{\"context\":{\"slot\":1},"
+               "\"value\":{\"amount\":\"18446744073709551000\",\"decimals\":6,"
+               "\"uiAmountString\":\"18446744073709.551\"}},\"id\":1}";
+    } else if (strstr(request, "\"getHealth\"")) {
+        body = "{\"jsonrpc\":\"2.0\",\"error\":{\"code\":-32005,"
+               "\"message\":\"Node is behind by 42 slots\"},\"id\":1}";
+    } else {
+        body = "{\"jsonrpc\":\"2.0\",\"error\":{\"code\":-32601,"
+               "\"message\":\"Method not found\"},\"id\":1}";
+    }
+
+    size_t len = strlen(body);
+    if (len > response_cap) {
+        return ESP_ERR_ESPSOL_BUFFER_TOO_SMALL;
+    }
+    memcpy(response, body, len);
+    *response_len = len;
+    return ESP_OK;
+}
+
+/**
+ * @brief Serve fake_node_perform's response in small chunks
+ */
+static esp_err_t fake_node_perform_stream(void *ctx,
+                                          const char *request, size_t request_len,
+                                          espsol_rpc_sink_fn sink, void *sink_ctx,
+                                          int *status_code,
+                                          const espsol_deadline_t *deadline)
+{
+    char body[8192];
+    size_t len = 0;
+    esp_err_t err = fake_node_perform(ctx, request, request_len, body, sizeof(body), &len,
+                                      status_code, deadline);
+    for (size_t pos = 0; pos < len && err == ESP_OK; pos += 7) {
+        err = sink(sink_ctx, *status_code, body + pos, len - pos < 7 ? len - pos : 7);
+    }
+    return err;
+}
+
+static espsol_rpc_config_t test_config(void)
+{
+    espsol_rpc_config_t config = ESPSOL_RPC_CONFIG_DEFAULT();
+    config.max_retries = 2;
+    config.retry_delay_ms = 1;
+    return config;
+}
+
+static int64_t now_ms(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+/* ============================================================================
+ * Session (shared by record and replay)
+ * ========================================================================== */
+
+static void run_session(espsol_rpc_handle_t rpc, const char *label)
+{
+    char message[128];
+    esp_err_t err;
+
+    uint64_t lamports = 0;
+    err = espsol_rpc_get_balance(rpc, TEST_PUBKEY, &lamports);
+    snprintf(message, sizeof(message), "%s: getBalance value", label);
+    TEST_ASSERT(err == ESP_OK && lamports == 2500000000ULL, message);
+
+    uint8_t blockhash[ESPSOL_BLOCKHASH_SIZE];
+    uint64_t last_valid = 0;
+    err = espsol_rpc_get_latest_blockhash(rpc, blockhash, &last_valid);
+    snprintf(message, sizeof(message), "%s: getLatestBlockhash decoded", label);
+    TEST_ASSERT(err == ESP_OK && blockhash[0] == 0xAB && blockhash[31] == 0xAB &&
+                last_valid == 987654321ULL, message);
+
+    espsol_rent_t rent;
+    err = espsol_rpc_get_rent(rpc, &rent);
+    snprintf(message, sizeof(message), "%s: Rent sysvar from base64 account data", label);
+    TEST_ASSERT(err == ESP_OK && rent.lamports_per_byte_year == 3480 &&
+                rent.exemption_threshold == 2.0 && rent.burn_percent == 50, message);
+
+    char signature[ESPSOL_SIGNATURE_MAX_LEN];
+    err = espsol_rpc_send_transaction(rpc, "AQID", signature, sizeof(signature));
+    snprintf(message, sizeof(message), "%s: sendTransaction signature", label);
+    TEST_ASSERT(err == ESP_OK && strcmp(signature, TEST_SIGNATURE) == 0, message);
+
+    uint64_t slot = 0;
+    err = espsol_rpc_get_slot(rpc, &slot);
+    snprintf(message, sizeof(message), "%s: getSlot succeeds after 429 retry", label);
+    TEST_ASSERT(err == ESP_OK && slot == 123456789ULL, message);
+
+    uint64_t amount = 0;
+    uint8_t decimals = 0;
+    err = espsol_rpc_get_token_balance(rpc, TEST_PUBKEY, &amount, &decimals);
+    snprintf(message, sizeof(message), "%s: token amount string keeps full u64 precision", label);
+    TEST_ASSERT(err == ESP_OK && amount == 18446744073709551000ULL && decimals == 6, message);
+
+    bool healthy = true;
+    err = espsol_rpc_get_health(rpc, &healthy);
+    snprintf(message, sizeof(message), "%s: JSON-RPC error reported as unhealthy", label);
+    TEST_ASSERT(err == ESP_OK && !healthy, message);
+
+    const char *last_error = espsol_rpc_get_last_error(rpc);
+    snprintf(message, sizeof(message), "%s: last error carries RPC message", label);
+    TEST_ASSERT(last_error && strcmp(last_error, "RPC error -32005: Node is behind by 42 slots") == 0,
+                message);
+}
+
+/* ============================================================================
+ * Client Tests
+ * ========================================================================== */
+
+static void test_client_basics(void)
+{
+    printf("\n========== RPC Client Tests ==========\n\n");
+
+    espsol_rpc_config_t config = test_config();
+    espsol_rpc_handle_t rpc = NULL;
+    esp_err_t err = espsol_rpc_init_with_config(&rpc, &config);
+    TEST_ASSERT(err == ESP_OK && rpc != NULL, "Host init returns a real client");
+
+    uint64_t slot = 0;
+    err = espsol_rpc_get_slot(rpc, &slot);
+    TEST_ASSERT_EQ(err, ESP_ERR_ESPSOL_NETWORK_ERROR, "Host client without transport fails");
+    TEST_ASSERT(espsol_rpc_get_last_error(rpc) &&
+                strcmp(espsol_rpc_get_last_error(rpc), "No transport configured") == 0,
+                "Missing transport reported");
+
+    espsol_rpc_transport_t bad = { .perform = NULL, .ctx = NULL };
+    TEST_ASSERT_EQ(espsol_rpc_set_transport(rpc, &bad), ESP_ERR_INVALID_ARG,
+                   "Transport without perform rejected");
+
+    fake_node_t node = {0};
+    espsol_rpc_transport_t transport = { .perform = fake_node_perform, .ctx = &node };
+    TEST_ASSERT_EQ(espsol_rpc_set_transport(rpc, &transport), ESP_OK, "Custom transport installed");
+
+    espsol_rpc_transport_t current;
+    espsol_rpc_get_transport(rpc, &current);
+    TEST_ASSERT(current.perform == fake_node_perform && current.ctx == &node,
+                "Installed transport returned");
+
+    node.slot_failures = 5;
+    err = espsol_rpc_get_slot(rpc, &slot);
+    TEST_ASSERT_EQ(err, ESP_ERR_ESPSOL_RATE_LIMITED, "Persistent 429 fails after retries");
+    TEST_ASSERT_EQ(node.calls, 3, "Initial attempt plus max_retries");
+
+    uint64_t lamports;
+    err = espsol_rpc_get_balance(rpc, "bad\"key", &lamports);
+    TEST_ASSERT_EQ(err, ESP_ERR_INVALID_ARG, "Pubkey needing JSON escaping rejected");
+
+    char response[128];
+    err = espsol_rpc_call(rpc, "getFoo", "[1,", response, sizeof(response));
+    TEST_ASSERT_EQ(err, ESP_ERR_INVALID_ARG, "Malformed params rejected");
+
+    err = espsol_rpc_call(rpc, "getBalance", "[\"" TEST_PUBKEY "\"]", response, sizeof(response));
+    TEST_ASSERT(err == ESP_OK && strcmp(response, "{\"context\":{\"slot\":1},\"value\":2500000000}") == 0,
+                "Generic call returns raw result JSON");
+
+    err = espsol_rpc_call(rpc, "getFoo", NULL, response, sizeof(response));
+    TEST_ASSERT_EQ(err, ESP_ERR_ESPSOL_RPC_FAILED, "Unknown method returns RPC error");
+
+    espsol_rpc_deinit(rpc);
+
+    /* Response larger than the client buffer */
+    config.buffer_size = 32;
+    config.transport = &transport;
+    err = espsol_rpc_init_with_config(&rpc, &config);
+    TEST_ASSERT(err == ESP_OK, "Transport set through config");
+    err = espsol_rpc_get_balance(rpc, TEST_PUBKEY, &lamports);
+    TEST_ASSERT_EQ(err, ESP_ERR_ESPSOL_BUFFER_TOO_SMALL, "Oversized response reported");
+    espsol_rpc_deinit(rpc);
+}
+
+static void test_send_tx(void)
+{
+    printf("\n========== Send Transaction Handle Tests ==========\n\n");
+
+    fake_node_t node = {0};
+    espsol_rpc_transport_t transport = { .perform = fake_node_perform, .ctx = &node };
+    espsol_rpc_config_t config = test_config();
+    config.transport = &transport;
+    espsol_rpc_handle_t rpc = NULL;
+    espsol_rpc_init_with_config(&rpc, &config);
+
+    espsol_keypair_t payer;
+    uint8_t seed[32];
+    memset(seed, 0x5e, sizeof(seed));
+    espsol_keypair_from_seed(seed, &payer);
+    uint8_t blockhash[32];
+    memset(blockhash, 0xab, sizeof(blockhash));
+    uint8_t recipient[32];
+    memset(recipient, 0x12, sizeof(recipient));
+
+    espsol_tx_handle_t tx = NULL;
+    espsol_tx_create(&tx);
+    espsol_tx_set_fee_payer(tx, payer.public_key);
+    espsol_tx_set_recent_blockhash(tx, blockhash);
+    espsol_tx_add_transfer(tx, payer.public_key, recipient, 1000);
+
+    char signature[ESPSOL_SIGNATURE_MAX_LEN];
+    esp_err_t err = espsol_rpc_send_tx(rpc, tx, signature, sizeof(signature));
+    TEST_ASSERT_EQ(err, ESP_ERR_ESPSOL_TX_NOT_SIGNED, "Unsigned transaction rejected");
+    TEST_ASSERT_EQ(node.calls, 0, "Nothing sent for an unsigned transaction");
+
+    espsol_tx_sign(tx, &payer);
+    err = espsol_rpc_send_tx(rpc, tx, signature, sizeof(signature));
+    TEST_ASSERT(err == ESP_OK && strcmp(signature, TEST_SIGNATURE) == 0,
+                "Transaction handle sent, signature returned");
+
+    char tx_base64[1700];
+    espsol_tx_to_base64(tx, tx_base64, sizeof(tx_base64));
+    char params[1800];
+    snprintf(params, sizeof(params),
+             "\"params\":[\"%s\",{\"encoding\":\"base64\",\"preflightCommitment\":\"confirmed\"}]}",
+             tx_base64);
+    size_t sent_len = strlen(node.sent);
+    TEST_ASSERT(sent_len > strlen(params) &&
+                strcmp(node.sent + sent_len - strlen(params), params) == 0,
+                "Body ends with the Base64 transaction params");
+
+    char streamed[sizeof(node.sent)];
+    memcpy(streamed, node.sent, sizeof(streamed));
+    err = espsol_rpc_send_transaction(rpc, tx_base64, signature, sizeof(signature));
+    char *streamed_method = strstr(streamed, "\"method\"");
+    char *string_method = strstr(node.sent, "\"method\"");
+    TEST_ASSERT(err == ESP_OK && streamed_method && string_method &&
+                strcmp(streamed_method, string_method) == 0,
+                "Same request as sending the Base64 string");
+
+    espsol_tx_destroy(tx);
+    espsol_rpc_deinit(rpc);
+}
+
+/* ============================================================================
+ * Record / Replay Tests
+ * ========================================================================== */
+
+static void test_record(void)
+{
+    printf("\n========== Record Tests ==========\n\n");
+
+    fake_node_t node = { .calls = 0, .slot_failures = 1 };
+    espsol_rpc_transport_t inner = { .perform = fake_node_perform, .ctx = &node };
+
+    espsol_rpc_recorder_handle_t recorder = NULL;
+    esp_err_t err = espsol_rpc_recorder_create(RECORDING_PATH, &inner, &recorder);
+    TEST_ASSERT(err == ESP_OK && recorder != NULL, "Recorder created");
+
+    espsol_rpc_transport_t transport;
+    espsol_rpc_recorder_get_transport(recorder, &transport);
+
+    espsol_rpc_config_t config = test_config();
+    config.transport = &transport;
+    espsol_rpc_handle_t rpc = NULL;
+    espsol_rpc_init_with_config(&rpc, &config);
+
+    run_session(rpc, "record");
+    espsol_rpc_deinit(rpc);
+
+    size_t count = 0;
+    espsol_rpc_recorder_get_count(recorder, &count);
+    TEST_ASSERT_EQ(count, (size_t)node.calls, "Every exchange recorded");
+    TEST_ASSERT_EQ(count, 8, "Retried request recorded twice");
+    TEST_ASSERT_EQ(espsol_rpc_recorder_destroy(recorder), ESP_OK, "Recording closed");
+}
+
+static void test_replay(void)
+{
+    printf("\n========== Replay Tests ==========\n\n");
+
+    espsol_rpc_replay_handle_t replay = NULL;
+    esp_err_t err = espsol_rpc_replay_create(RECORDING_PATH, NULL, &replay);
+    TEST_ASSERT(err == ESP_OK && replay != NULL, "Recording loaded");
+
+    espsol_rpc_transport_t transport;
+    espsol_rpc_replay_get_transport(replay, &transport);
+
+    espsol_rpc_config_t config = test_config();
+    config.transport = &transport;
+    espsol_rpc_handle_t rpc = NULL;
+    espsol_rpc_init_with_config(&rpc, &config);
+
+    /* Shift request ids so matching must ignore them */
+    char version[32];
+    err = espsol_rpc_get_version(rpc, version, sizeof(version));
+    TEST_ASSERT_EQ(err, ESP_ERR_ESPSOL_RPC_FAILED, "Unrecorded request misses");
+
+    run_session(rpc, "replay");
+
+    size_t remaining = 99;
+    espsol_rpc_replay_get_remaining(replay, &remaining);
+    TEST_ASSERT_EQ(remaining, 0, "All exchanges served");
+
+    uint64_t slot;
+    err = espsol_rpc_get_slot(rpc, &slot);
+    TEST_ASSERT_EQ(err, ESP_ERR_ESPSOL_RPC_FAILED, "Exchanges are served once");
+
+    espsol_rpc_deinit(rpc);
+    espsol_rpc_replay_destroy(replay);
+
+    /* Strict order: the first recorded request is getBalance */
+    espsol_rpc_replay_config_t strict = ESPSOL_RPC_REPLAY_CONFIG_DEFAULT();
+    strict.strict_order = true;
+    espsol_rpc_replay_create(RECORDING_PATH, &strict, &replay);
+    espsol_rpc_replay_get_transport(replay, &transport);
+    espsol_rpc_init_with_config(&rpc, &config);
+
+    err = espsol_rpc_get_slot(rpc, &slot);
+    TEST_ASSERT_EQ(err, ESP_ERR_ESPSOL_RPC_FAILED, "Strict order rejects out-of-order request");
+
+    uint64_t lamports = 0;
+    err = espsol_rpc_get_balance(rpc, TEST_PUBKEY, &lamports);
+    TEST_ASSERT(err == ESP_OK && lamports == 2500000000ULL, "Strict order serves next request");
+
+    espsol_rpc_deinit(rpc);
+    espsol_rpc_replay_destroy(replay);
+
+    /* Latency injection */
+    espsol_rpc_replay_config_t slow = ESPSOL_RPC_REPLAY_CONFIG_DEFAULT();
+    slow.added_latency_ms = 30;
+    espsol_rpc_replay_create(RECORDING_PATH, &slow, &replay);
+    espsol_rpc_replay_get_transport(replay, &transport);
+    espsol_rpc_init_with_config(&rpc, &config);
+
+    int64_t start = now_ms();
+    err = espsol_rpc_get_balance(rpc, TEST_PUBKEY, &lamports);
+    int64_t elapsed = now_ms() - start;
+    TEST_ASSERT(err == ESP_OK && elapsed >= 30, "Added latency applied");
+
+    espsol_rpc_deinit(rpc);
+    espsol_rpc_replay_destroy(replay);
+
+    /* Bad input */
+    err = espsol_rpc_replay_create("does_not_exist.bin", NULL, &replay);
+    TEST_ASSERT_EQ(err, ESP_FAIL, "Missing recording fails");
+
+    FILE *f = fopen(RECORDING_PATH, "wb");
+    fwrite("ESRR\x01\0\0\0\x10\0\0\0", 1, 12, f);
+    fclose(f);
+    err = espsol_rpc_replay_create(RECORDING_PATH, NULL, &replay);
+    TEST_ASSERT_EQ(err, ESP_FAIL, "Truncated recording rejected");
+
+    remove(RECORDING_PATH);
+}
+
+/* ============================================================================
+ * Deadline and Cancellation Tests
+ * ========================================================================== */
+
+static void *cancel_after_delay(void *arg)
+{
+    usleep(50 * 1000);
+    espsol_cancel_token_cancel(arg);
+    return NULL;
+}
+
+static void test_deadlines(void)
+{
+    printf("\n========== Deadline and Cancellation Tests ==========\n\n");
+
+    fake_node_t node = {0};
+    espsol_rpc_transport_t transport = { .perform = fake_node_perform, .ctx = &node };
+
+    espsol_rpc_config_t config = test_config();
+    config.max_retries = 5;
+    config.retry_delay_ms = 200;
+    config.transport = &transport;
+    espsol_rpc_handle_t rpc = NULL;
+    espsol_rpc_init_with_config(&rpc, &config);
+
+    TEST_ASSERT_EQ(espsol_rpc_set_call_options(NULL, NULL), ESP_ERR_INVALID_ARG,
+                   "Call options need a handle");
+
+    /* Backoff that would overrun the deadline is not slept */
+    espsol_call_options_t options = ESPSOL_CALL_OPTIONS_DEFAULT();
+    options.deadline_ms = 100;
+    espsol_rpc_set_call_options(rpc, &options);
+
+    uint64_t slot = 0;
+    node.slot_failures = 100;
+    int64_t start = now_ms();
+    esp_err_t err = espsol_rpc_get_slot(rpc, &slot);
+    int64_t elapsed = now_ms() - start;
+    TEST_ASSERT_EQ(err, ESP_ERR_ESPSOL_TIMEOUT, "Retries stop at the deadline");
+    TEST_ASSERT(elapsed < 100, "Deadline enforced without sleeping the backoff");
+    TEST_ASSERT_EQ(node.calls, 1, "No retry attempted past the deadline");
+    TEST_ASSERT(strcmp(espsol_rpc_get_last_error(rpc), "Deadline exceeded") == 0,
+                "Deadline reported in last error");
+
+    /* A new call gets a fresh budget */
+    node.slot_failures = 0;
+    err = espsol_rpc_get_slot(rpc, &slot);
+    TEST_ASSERT(err == ESP_OK && slot == 123456789ULL, "Deadline restarts per call");
+
+    /* Cancelled token stops calls before the transport is used */
+    espsol_cancel_token_t token = ESPSOL_CANCEL_TOKEN_INIT();
+    options.deadline_ms = 0;
+    options.cancel = &token;
+    espsol_rpc_set_call_options(rpc, &options);
+
+    espsol_cancel_token_cancel(&token);
+    TEST_ASSERT(espsol_cancel_token_is_cancelled(&token), "Token reports cancellation");
+    node.calls = 0;
+    err = espsol_rpc_get_slot(rpc, &slot);
+    TEST_ASSERT_EQ(err, ESP_ERR_ESPSOL_CANCELLED, "Cancelled token fails the call");
+    TEST_ASSERT_EQ(node.calls, 0, "Cancelled call never reaches the transport");
+
+    espsol_cancel_token_reset(&token);
+    err = espsol_rpc_get_slot(rpc, &slot);
+    TEST_ASSERT_EQ(err, ESP_OK, "Reset token allows calls again");
+
+    /* Cancelling from another thread interrupts backoff */
+    node.slot_failures = 100;
+    pthread_t thread;
+    pthread_create(&thread, NULL, cancel_after_delay, &token);
+    start = now_ms();
+    err = espsol_rpc_get_slot(rpc, &slot);
+    elapsed = now_ms() - start;
+    pthread_join(thread, NULL);
+    TEST_ASSERT_EQ(err, ESP_ERR_ESPSOL_CANCELLED, "Cancel interrupts retry backoff");
+    TEST_ASSERT(elapsed < 200, "Backoff cut short by cancellation");
+
+    /* NULL options restore unlimited calls */
+    espsol_rpc_set_call_options(rpc, NULL);
+    node.slot_failures = 0;
+    err = espsol_rpc_get_slot(rpc, &slot);
+    TEST_ASSERT_EQ(err, ESP_OK, "NULL options clear the token");
+    espsol_rpc_deinit(rpc);
+
+    /* Cancelling interrupts a slow transport, not just backoff */
+    fake_node_t recorded = {0};
+    espsol_rpc_transport_t inner = { .perform = fake_node_perform, .ctx = &recorded };
+    espsol_rpc_recorder_handle_t recorder = NULL;
+    espsol_rpc_recorder_create(RECORDING_PATH, &inner, &recorder);
+    espsol_rpc_recorder_get_transport(recorder, &transport);
+    config = test_config();
+    config.transport = &transport;
+    espsol_rpc_init_with_config(&rpc, &config);
+    espsol_rpc_get_slot(rpc, &slot);
+    espsol_rpc_deinit(rpc);
+    espsol_rpc_recorder_destroy(recorder);
+
+    espsol_rpc_replay_config_t slow = ESPSOL_RPC_REPLAY_CONFIG_DEFAULT();
+    slow.added_latency_ms = 2000;
+    espsol_rpc_replay_handle_t replay = NULL;
+    espsol_rpc_replay_create(RECORDING_PATH, &slow, &replay);
+    espsol_rpc_replay_get_transport(replay, &transport);
+    espsol_rpc_init_with_config(&rpc, &config);
+
+    espsol_cancel_token_reset(&token);
+    espsol_rpc_set_call_options(rpc, &options);
+    pthread_create(&thread, NULL, cancel_after_delay, &token);
+    start = now_ms();
+    err = espsol_rpc_get_slot(rpc, &slot);
+    elapsed = now_ms() - start;
+    pthread_join(thread, NULL);
+    TEST_ASSERT_EQ(err, ESP_ERR_ESPSOL_CANCELLED, "Cancel interrupts a response in flight");
+    TEST_ASSERT(elapsed < 500, "In-flight wait cut short by cancellation");
+
+    espsol_rpc_deinit(rpc);
+    espsol_rpc_replay_destroy(replay);
+    remove(RECORDING_PATH);
+}
+
+/* ============================================================================
+ * Address History Tests
+ * ========================================================================== */
+
+/**
+ * @brief Walk an iterator, checking entries are consecutive from first
+ *
+ * @return Number of entries returned, -1 if the sequence was wrong
+ */
+static int walk_history(espsol_history_iter_t iter, int first, esp_err_t *last_err)
+{
+    espsol_signature_info_t info;
+    int count = 0;
+    esp_err_t err;
+
+    while ((err = espsol_rpc_history_next(iter, &info)) == ESP_OK) {
+        char expected[8];
+        int i = first + count;
+        snprintf(expected, sizeof(expected), "sig%03d", i);
+        if (strcmp(info.signature, expected) != 0 || info.slot != (uint64_t)(1000 - i) ||
+            info.failed != (i % 7 == 3) || info.has_block_time != (i % 10 != 9) ||
+            (info.has_block_time && info.block_time != 1700000000 - i)) {
+            return -1;
+        }
+        count++;
+    }
+
+    *last_err = err;
+    return count;
+}
+
+static void test_history(void)
+{
+    printf("\n========== Address History Tests ==========\n\n");
+
+    fake_node_t node = {0};
+    espsol_rpc_transport_t transport = { .perform = fake_node_perform, .ctx = &node };
+    espsol_rpc_config_t config = test_config();
+    config.transport = &transport;
+    espsol_rpc_handle_t rpc = NULL;
+    espsol_rpc_init_with_config(&rpc, &config);
+
+    espsol_history_iter_t iter = NULL;
+    espsol_history_config_t history = ESPSOL_HISTORY_CONFIG_DEFAULT();
+    esp_err_t last_err = ESP_OK;
+
+    history.page_size = 0;
+    TEST_ASSERT_EQ(espsol_rpc_history_open(rpc, TEST_PUBKEY, &history, &iter),
+                   ESP_ERR_INVALID_ARG, "Zero page size rejected");
+    history.page_size = 16;
+    history.before = "bad\"sig";
+    TEST_ASSERT_EQ(espsol_rpc_history_open(rpc, TEST_PUBKEY, &history, &iter),
+                   ESP_ERR_INVALID_ARG, "Cursor needing JSON escaping rejected");
+    history.before = NULL;
+
+    /* Full walk with default settings */
+    TEST_ASSERT_EQ(espsol_rpc_history_open(rpc, TEST_PUBKEY, NULL, &iter), ESP_OK,
+                   "Iterator opened with defaults");
+    TEST_ASSERT_EQ(node.history_calls, 0, "No request before the first entry without prefetch");
+    TEST_ASSERT_EQ(walk_history(iter, 0, &last_err), HISTORY_LEN, "Whole history in order");
+    TEST_ASSERT_EQ(last_err, ESP_ERR_NOT_FOUND, "End reported as not found");
+    TEST_ASSERT_EQ(node.history_calls, 3, "Short last page ends paging");
+    espsol_signature_info_t info;
+    TEST_ASSERT_EQ(espsol_rpc_history_next(iter, &info), ESP_ERR_NOT_FOUND, "Stays at end");
+    espsol_rpc_history_close(iter);
+
+    /* Failed transaction carries its error */
+    espsol_rpc_history_open(rpc, TEST_PUBKEY, NULL, &iter);
+    for (int i = 0; i <= 3; i++) {
+        espsol_rpc_history_next(iter, &info);
+    }
+    TEST_ASSERT(info.failed && strcmp(info.error, "{\"InstructionError\":[0,{\"Custom\":1}]}") == 0,
+                "Error JSON returned for failed transaction");
+    espsol_rpc_history_close(iter);
+
+    /* Limit */
+    node.history_calls = 0;
+    history.page_size = 4;
+    history.limit = 10;
+    espsol_rpc_history_open(rpc, TEST_PUBKEY, &history, &iter);
+    TEST_ASSERT_EQ(walk_history(iter, 0, &last_err), 10, "Limit caps entries");
+    TEST_ASSERT_EQ(node.history_calls, 3, "Last page only requests what is left");
+    espsol_rpc_history_close(iter);
+
+    /* before / until window */
+    history.limit = 0;
+    history.before = "sig005";
+    history.until = "sig015";
+    espsol_rpc_history_open(rpc, TEST_PUBKEY, &history, &iter);
+    TEST_ASSERT_EQ(walk_history(iter, 6, &last_err), 9, "Window between before and until");
+    espsol_rpc_history_close(iter);
+    history.before = NULL;
+    history.until = NULL;
+
+    /* A failed page is retried by the next call */
+    espsol_rpc_history_open(rpc, TEST_PUBKEY, &history, &iter);
+    for (int i = 0; i < 4; i++) {
+        espsol_rpc_history_next(iter, &info);
+    }
+    node.history_failures = 1;
+    TEST_ASSERT_EQ(espsol_rpc_history_next(iter, &info), ESP_ERR_ESPSOL_RPC_FAILED,
+                   "Page error returned");
+    TEST_ASSERT(espsol_rpc_history_next(iter, &info) == ESP_OK &&
+                strcmp(info.signature, "sig004") == 0, "Retry resumes at the same cursor");
+    espsol_rpc_history_close(iter);
+
+    /* Prefetch */
+    node.history_calls = 0;
+    history.page_size = 16;
+    history.prefetch = true;
+    espsol_rpc_history_open(rpc, TEST_PUBKEY, &history, &iter);
+    TEST_ASSERT_EQ(walk_history(iter, 0, &last_err), HISTORY_LEN, "Prefetching walk in order");
+    TEST_ASSERT_EQ(last_err, ESP_ERR_NOT_FOUND, "Prefetching walk ends");
+    TEST_ASSERT_EQ(node.history_calls, 3, "Prefetch requests no extra pages");
+    espsol_rpc_history_close(iter);
+
+    espsol_rpc_history_open(rpc, TEST_PUBKEY, &history, &iter);
+    espsol_rpc_history_next(iter, &info);
+    TEST_ASSERT_EQ(espsol_rpc_history_close(iter), ESP_OK, "Close with prefetch in flight");
+
+    node.history_failures = 1;
+    espsol_rpc_history_open(rpc, TEST_PUBKEY, &history, &iter);
+    TEST_ASSERT_EQ(espsol_rpc_history_next(iter, &info), ESP_ERR_ESPSOL_RPC_FAILED,
+                   "Prefetched page error returned");
+    TEST_ASSERT_EQ(walk_history(iter, 0, &last_err), HISTORY_LEN, "Prefetch retries failed page");
+    espsol_rpc_history_close(iter);
+    espsol_rpc_deinit(rpc);
+
+    /* Page larger than the client buffer */
+    config.buffer_size = 512;
+    espsol_rpc_init_with_config(&rpc, &config);
+    history.prefetch = false;
+    espsol_rpc_history_open(rpc, TEST_PUBKEY, &history, &iter);
+    TEST_ASSERT_EQ(espsol_rpc_history_next(iter, &info), ESP_ERR_ESPSOL_BUFFER_TOO_SMALL,
+                   "Oversized page reported");
+    espsol_rpc_history_close(iter);
+    espsol_rpc_deinit(rpc);
+
+    /* A streaming transport decodes pages far larger than the client buffer */
+    transport.perform_stream = fake_node_perform_stream;
+    espsol_rpc_init_with_config(&rpc, &config);
+    node.history_calls = 0;
+    espsol_rpc_history_open(rpc, TEST_PUBKEY, &history, &iter);
+    TEST_ASSERT_EQ(walk_history(iter, 0, &last_err), HISTORY_LEN, "Streamed walk in order");
+    TEST_ASSERT_EQ(node.history_calls, 3, "Streamed pages requested once");
+    espsol_rpc_history_close(iter);
+
+    history.prefetch = true;
+    espsol_rpc_history_open(rpc, TEST_PUBKEY, &history, &iter);
+    TEST_ASSERT_EQ(walk_history(iter, 0, &last_err), HISTORY_LEN, "Streamed prefetching walk in order");
+    espsol_rpc_history_close(iter);
+
+    node.history_failures = 1;
+    espsol_rpc_history_open(rpc, TEST_PUBKEY, &history, &iter);
+    TEST_ASSERT_EQ(espsol_rpc_history_next(iter, &info), ESP_ERR_ESPSOL_RPC_FAILED,
+                   "Streamed page error returned");
+    TEST_ASSERT(strcmp(espsol_rpc_get_last_error(rpc), "RPC error -32000: Try again") == 0,
+                "Streamed page error message kept");
+    TEST_ASSERT_EQ(walk_history(iter, 0, &last_err), HISTORY_LEN, "Streamed page retried");
+    espsol_rpc_history_close(iter);
+    espsol_rpc_deinit(rpc);
+}
+
+/* ============================================================================
+ * Block Streaming Tests
+ * ========================================================================== */
+
+#define BLOCK_TXS       24
+#define BLOCK_BODY_MAX  (64 * 1024)
+
+static const uint8_t WATCHED_PROGRAM[ESPSOL_PUBKEY_SIZE] = {
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+};
+
+typedef struct {
+    int calls;              /**< getBlock requests served */
+    int rate_limited;       /**< Requests to answer with 429 */
+    size_t chunk;           /**< Streaming chunk size */
+} block_node_t;
+
+/**
+ * @brief Serialize test transaction i of a block
+ *
+ * Every third transaction calls the watched program, transaction 7 calls
+ * a second watched program (0xCC...), and every fifth is a v0 message.
+ */
+static size_t build_block_tx(uint64_t slot, int i, uint8_t *tx)
+{
+    size_t len = 0;
+    bool versioned = i % 5 == 4;
+
+    tx[len++] = 1;
+    memset(tx + len, (int)((slot * 31 + (uint64_t)i) & 0xFF), 64);
+    len += 64;
+    if (versioned) {
+        tx[len++] = 0x80;
+    }
+    tx[len++] = 1;
+    tx[len++] = 0;
+    tx[len++] = 1;
+    tx[len++] = 3;
+    memset(tx + len, 0x11 + i, 32);
+    len += 32;
+    memset(tx + len, i % 3 == 0 ? 0xAA : (i == 7 ? 0xCC : 0xBB), 32);
+    len += 32;
+    memset(tx + len, 0, 64);    /* System program, then recent blockhash */
+    len += 64;
+    const uint8_t ix[] = { 1, 1, 1, 0, 0 };
+    memcpy(tx + len, ix, sizeof(ix));
+    len += sizeof(ix);
+    if (versioned) {
+        tx[len++] = 0;
+    }
+    return len;
+}
+
+/**
+ * @brief Build the getBlock response for a slot
+ *
+ * 101 is skipped, 104 is not available yet, 105 is truncated.
+ */
+static size_t build_block_body(uint64_t slot, char *out, size_t cap)
+{
+    if (slot == 101) {
+        return (size_t)snprintf(out, cap, "{\"jsonrpc\":\"2.0\",\"error\":{\"code\":-32007,"
+                                "\"message\":\"Slot 101 was skipped\"},\"id\":1}");
+    }
+    if (slot == 104) {
+        return (size_t)snprintf(out, cap, "{\"jsonrpc\":\"2.0\",\"error\":{\"code\":-32004,"
+                                "\"message\":\"Block not available for slot 104\"},\"id\":1}");
+    }
+
+    size_t len = (size_t)snprintf(out, cap,
+                                  "{\"jsonrpc\":\"2.0\",\"result\":{\"previousBlockhash\":\"%s\","
+                                  "\"blockhash\":\"%s\",\"parentSlot\":%llu,\"transactions\":[",
+                                  TEST_PUBKEY, TEST_BLOCKHASH, (unsigned long long)(slot - 1));
+
+    for (int i = 0; i < BLOCK_TXS; i++) {
+        uint8_t tx[ESPSOL_MAX_TX_SIZE];
+        char b64[512];
+        size_t tx_len = build_block_tx(slot, i, tx);
+        espsol_base64_encode(tx, tx_len, b64, sizeof(b64));
+
+        len += (size_t)snprintf(out + len, cap - len,
+                                "%s{\"meta\":{\"err\":%s,\"fee\":5000,\"innerInstructions\":[],"
+                                "\"logMessages\":[\"Program log: \\\"quoted\\\" [x] {y}\",\"ok\"],"
+                                "\"preBalances\":[1,2,3],\"status\":{\"Ok\":null}},"
+                                "\"transaction\":[\"%s\",\"base64\"],\"version\":%s}",
+                                i > 0 ? "," : "",
+                                i % 4 == 3 ? "{\"InstructionError\":[0,{\"Custom\":6}]}" : "null",
+                                b64, i % 5 == 4 ? "0" : "\"legacy\"");
+    }
+
+    len += (size_t)snprintf(out + len, cap - len,
+                            "],\"blockTime\":%llu,\"blockHeight\":%llu},\"id\":1}",
+                            (unsigned long long)(1700000000 + slot),
+                            (unsigned long long)(slot - 10));
+    if (slot == 105) {
+        len /= 2;
+    }
+    return len;
+}
+
+static uint64_t request_slot(const char *request)
+{
+    const char *params = strstr(request, "\"params\":[");
+    return params ? strtoull(params + 10, NULL, 10) : 0;
+}
+
+static esp_err_t block_node_perform_stream(void *ctx,
+                                           const char *request, size_t request_len,
+                                           espsol_rpc_sink_fn sink, void *sink_ctx,
+                                           int *status_code,
+                                           const espsol_deadline_t *deadline)
+{
+    block_node_t *node = ctx;
+    (void)request_len;
+    (void)deadline;
+
+    node->calls++;
+    if (node->rate_limited > 0) {
+        node->rate_limited--;
+        *status_code = 429;
+        return sink(sink_ctx, 429, "Too many requests", 17);
+    }
+
+    char *body = malloc(BLOCK_BODY_MAX);
+    size_t len = build_block_body(request_slot(request), body, BLOCK_BODY_MAX);
+    *status_code = 200;
+
+    esp_err_t err = ESP_OK;
+    for (size_t pos = 0; pos < len && err == ESP_OK; pos += node->chunk) {
+        size_t n = len - pos < node->chunk ? len - pos : node->chunk;
+        err = sink(sink_ctx, 200, body + pos, n);
+    }
+    free(body);
+    return err;
+}
+
+static esp_err_t block_node_perform(void *ctx,
+                                    const char *request, size_t request_len,
+                                    char *response, size_t response_cap,
+                                    size_t *response_len,
+                                    int *status_code,
+                                    const espsol_deadline_t *deadline)
+{
+    block_node_t *node = ctx;
+    (void)request_len;
+    (void)deadline;
+
+    node->calls++;
+    *status_code = 200;
+    *response_len = build_block_body(request_slot(request), response, response_cap);
+    return *response_len <= response_cap ? ESP_OK : ESP_ERR_ESPSOL_BUFFER_TOO_SMALL;
+}
+
+typedef struct {
+    int matches;            /**< Transactions received */
+    int blocks;             /**< Blocks received */
+    int skipped;            /**< Skipped slots received */
+    bool in_order;          /**< Every callback followed the previous one */
+    uint64_t last_slot;     /**< Slot of the previous callback */
+    int last_index;         /**< Index of the previous transaction */
+    int stop_after;         /**< Fail the callback after this many (0 = never) */
+    espsol_block_tx_t seen[BLOCK_TXS];  /**< First block's transactions */
+    char errors[BLOCK_TXS][128];        /**< Their error JSON */
+} block_sink_t;
+
+static esp_err_t on_block_tx(const espsol_block_tx_t *tx, void *user_ctx)
+{
+    block_sink_t *sink = user_ctx;
+
+    if (tx->slot < sink->last_slot ||
+        (tx->slot == sink->last_slot && (int)tx->index <= sink->last_index)) {
+        sink->in_order = false;
+    }
+    if (tx->slot != sink->last_slot) {
+        sink->last_index = -1;
+    }
+    sink->last_slot = tx->slot;
+    sink->last_index = (int)tx->index;
+
+    uint8_t expected[ESPSOL_MAX_TX_SIZE];
+    size_t expected_len = build_block_tx(tx->slot, (int)tx->index, expected);
+    if (tx->tx_len != expected_len || memcmp(tx->tx, expected, expected_len) != 0) {
+        sink->in_order = false;
+    }
+
+    if (sink->matches < BLOCK_TXS) {
+        sink->seen[sink->matches] = *tx;
+        snprintf(sink->errors[sink->matches], sizeof(sink->errors[0]), "%s", tx->error);
+    }
+    sink->matches++;
+
+    if (sink->stop_after > 0 && sink->matches >= sink->stop_after) {
+        return ESP_FAIL;
+    }
+    return ESP_OK;
+}
+
+static esp_err_t on_block_done(const espsol_block_info_t *info, void *user_ctx)
+{
+    block_sink_t *sink = user_ctx;
+    sink->blocks++;
+    if (info->skipped) {
+        sink->skipped++;
+    }
+    return ESP_OK;
+}
+
+static void test_block_stream(void)
+{
+    printf("\n========== Block Streaming Tests ==========\n\n");
+
+    const uint8_t programs[2][ESPSOL_PUBKEY_SIZE] = {
+        { 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+          0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA },
+        { 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC,
+          0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC },
+    };
+    TEST_ASSERT(memcmp(programs[0], WATCHED_PROGRAM, ESPSOL_PUBKEY_SIZE) == 0, "Watched program set up");
+
+    block_node_t node = { .chunk = 7 };
+    espsol_rpc_transport_t transport = {
+        .perform = block_node_perform,
+        .perform_stream = block_node_perform_stream,
+        .ctx = &node,
+    };
+    espsol_rpc_config_t config = test_config();
+    config.transport = &transport;
+    espsol_rpc_handle_t rpc = NULL;
+    espsol_rpc_init_with_config(&rpc, &config);
+
+    block_sink_t sink = { .in_order = true, .last_index = -1 };
+    espsol_block_filter_t filter = {
+        .programs = programs,
+        .program_count = 2,
+        .on_transaction = on_block_tx,
+        .on_block = on_block_done,
+        .user_ctx = &sink,
+    };
+    espsol_block_info_t info;
+
+    espsol_block_filter_t bad = filter;
+    bad.on_transaction = NULL;
+    TEST_ASSERT_EQ(espsol_rpc_get_block_stream(rpc, 100, &bad, &info), ESP_ERR_INVALID_ARG,
+                   "Filter without callback rejected");
+
+    /* Block far larger than the 4 KB client buffer, in 7-byte chunks */
+    esp_err_t err = espsol_rpc_get_block_stream(rpc, 100, &filter, &info);
+    TEST_ASSERT_EQ(err, ESP_OK, "Large block streamed");
+    TEST_ASSERT_EQ(info.tx_count, BLOCK_TXS, "Every transaction parsed");
+    TEST_ASSERT_EQ(info.matched, 9, "Only watched programs matched");
+    TEST_ASSERT_EQ(sink.matches, 9, "Callback per match");
+    TEST_ASSERT(sink.in_order, "Matches in block order with exact bytes");
+    TEST_ASSERT(strcmp(info.blockhash, TEST_BLOCKHASH) == 0 && info.parent_slot == 99 &&
+                info.has_block_time && info.block_time == 1700000100 && info.block_height == 90,
+                "Block summary read around the transaction list");
+    TEST_ASSERT(sink.seen[1].index == 3 && sink.seen[1].failed &&
+                strcmp(sink.errors[1], "{\"InstructionError\":[0,{\"Custom\":6}]}") == 0,
+                "Failed transaction carries error JSON");
+    TEST_ASSERT(!sink.seen[0].failed && strcmp(sink.errors[0], "") == 0, "Successful transaction has no error");
+    TEST_ASSERT(sink.seen[2].index == 6 && sink.seen[3].index == 7 && sink.seen[3].program == 1,
+                "Second watched program reported by index");
+    TEST_ASSERT(sink.seen[4].index == 9, "Versioned transaction matched");
+
+    uint8_t first_sig[ESPSOL_SIGNATURE_SIZE];
+    char first_sig_b58[ESPSOL_SIGNATURE_MAX_LEN];
+    memset(first_sig, (100 * 31) & 0xFF, sizeof(first_sig));
+    espsol_base58_encode(first_sig, sizeof(first_sig), first_sig_b58, sizeof(first_sig_b58));
+    TEST_ASSERT(strcmp(sink.seen[0].signature, first_sig_b58) == 0, "First signature encoded");
+
+    /* No programs: every transaction */
+    memset(&sink, 0, sizeof(sink));
+    sink.in_order = true;
+    sink.last_index = -1;
+    espsol_block_filter_t all = filter;
+    all.program_count = 0;
+    err = espsol_rpc_get_block_stream(rpc, 100, &all, &info);
+    TEST_ASSERT(err == ESP_OK && sink.matches == BLOCK_TXS, "Empty filter matches all");
+
+    /* Skipped, unavailable and truncated slots */
+    err = espsol_rpc_get_block_stream(rpc, 101, &filter, &info);
+    TEST_ASSERT(err == ESP_OK && info.skipped && info.tx_count == 0, "Skipped slot reported");
+    err = espsol_rpc_get_block_stream(rpc, 104, &filter, &info);
+    TEST_ASSERT_EQ(err, ESP_ERR_ESPSOL_RPC_FAILED, "Unavailable block fails");
+    TEST_ASSERT(strstr(espsol_rpc_get_last_error(rpc), "Block not available") != NULL,
+                "RPC error message kept");
+    err = espsol_rpc_get_block_stream(rpc, 105, &filter, &info);
+    TEST_ASSERT_EQ(err, ESP_ERR_ESPSOL_RPC_PARSE_ERROR, "Truncated block detected");
+
+    /* Callback stops the stream */
+    memset(&sink, 0, sizeof(sink));
+    sink.stop_after = 2;
+    err = espsol_rpc_get_block_stream(rpc, 100, &filter, &info);
+    TEST_ASSERT(err == ESP_FAIL && sink.matches == 2, "Callback error stops the stream");
+
+    /* Rate limit before any data is retried */
+    memset(&sink, 0, sizeof(sink));
+    node.calls = 0;
+    node.rate_limited = 1;
+    err = espsol_rpc_get_block_stream(rpc, 100, &filter, &info);
+    TEST_ASSERT(err == ESP_OK && node.calls == 2 && sink.matches == 9, "Stream retried after 429");
+    espsol_rpc_deinit(rpc);
+
+    /* Transport without streaming falls back to the client buffer */
+    espsol_rpc_transport_t buffered = { .perform = block_node_perform, .ctx = &node };
+    config.transport = &buffered;
+    config.buffer_size = BLOCK_BODY_MAX;
+    espsol_rpc_init_with_config(&rpc, &config);
+    memset(&sink, 0, sizeof(sink));
+    err = espsol_rpc_get_block_stream(rpc, 100, &filter, &info);
+    TEST_ASSERT(err == ESP_OK && info.matched == 9 && sink.matches == 9, "Buffered transport fallback");
+    espsol_rpc_deinit(rpc);
+
+    /* Sequential walk over 100..103 */
+    config.transport = &transport;
+    config.buffer_size = 0;
+    espsol_rpc_init_with_config(&rpc, &config);
+    memset(&sink, 0, sizeof(sink));
+    sink.in_order = true;
+    sink.last_index = -1;
+    uint64_t next_slot = 0;
+    err = espsol_rpc_walk_blocks(rpc, 100, 4, &filter, &next_slot);
+    TEST_ASSERT_EQ(err, ESP_OK, "Walk completes");
+    TEST_ASSERT(sink.blocks == 4 && sink.skipped == 1 && sink.matches == 27 && sink.in_order,
+                "Walk delivers blocks in order");
+    TEST_ASSERT_EQ(next_slot, 104, "Walk reports next slot");
+
+    /* Pipelined walk on a second client */
+    block_node_t pipeline_node = { .chunk = 5 };
+    espsol_rpc_transport_t pipeline_transport = {
+        .perform = block_node_perform,
+        .perform_stream = block_node_perform_stream,
+        .ctx = &pipeline_node,
+    };
+    config.transport = &pipeline_transport;
+    espsol_rpc_handle_t pipeline = NULL;
+    espsol_rpc_init_with_config(&pipeline, &config);
+    filter.pipeline = pipeline;
+
+    memset(&sink, 0, sizeof(sink));
+    sink.in_order = true;
+    sink.last_index = -1;
+    node.calls = 0;
+    err = espsol_rpc_walk_blocks(rpc, 100, 4, &filter, &next_slot);
+    TEST_ASSERT(err == ESP_OK && next_slot == 104, "Pipelined walk completes");
+    TEST_ASSERT(sink.blocks == 4 && sink.skipped == 1 && sink.matches == 27 && sink.in_order,
+                "Pipelined walk delivers blocks in order");
+    TEST_ASSERT(node.calls == 2 && pipeline_node.calls == 2, "Requests split across both clients");
+
+    /* Buffer too small for block 103: streamed again on the main client */
+    memset(&sink, 0, sizeof(sink));
+    sink.in_order = true;
+    sink.last_index = -1;
+    node.calls = 0;
+    pipeline_node.calls = 0;
+    filter.pipeline_buffer = 1024;
+    err = espsol_rpc_walk_blocks(rpc, 100, 4, &filter, &next_slot);
+    TEST_ASSERT(err == ESP_OK && next_slot == 104, "Walk with a small pipeline buffer completes");
+    TEST_ASSERT(sink.blocks == 4 && sink.skipped == 1 && sink.matches == 27 && sink.in_order,
+                "Overflowing block delivered once, in order");
+    TEST_ASSERT(node.calls == 3 && pipeline_node.calls == 2, "Overflowing block fetched again");
+    filter.pipeline_buffer = 0;
+
+    memset(&sink, 0, sizeof(sink));
+    sink.in_order = true;
+    sink.last_index = -1;
+    err = espsol_rpc_walk_blocks(rpc, 102, 4, &filter, &next_slot);
+    TEST_ASSERT_EQ(err, ESP_ERR_ESPSOL_RPC_FAILED, "Pipelined walk stops at unavailable block");
+    TEST_ASSERT(next_slot == 104 && sink.blocks == 2 && sink.matches == 18,
+                "Blocks before the failure delivered");
+    TEST_ASSERT(strstr(espsol_rpc_get_last_error(rpc), "Block not available") != NULL,
+                "Pipeline error reported on the main client");
+
+    espsol_rpc_deinit(pipeline);
+    espsol_rpc_deinit(rpc);
+}
+
+/* ============================================================================
+ * Main
+ * ========================================================================== */
+
+int main(void)
+{
+    printf("==============================================\n");
+    printf("   ESPSOL RPC Host Tests\n");
+    printf("==============================================\n");
+
+    test_client_basics();
+    test_send_tx();
+    test_record();
+    test_replay();
+    test_deadlines();
+    test_history();
+    test_block_stream();
+
+    /* Summary */
+    printf("\n==============================================\n");
+    printf("Test Summary: %d passed, %d failed\n", tests_passed, tests_failed);
+    printf("==============================================\n");
+
+    return tests_failed > 0 ? 1 : 0;
+}
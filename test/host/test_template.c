@@ -0,0 +1,223 @@
+/**
+ * @file test_template.c
+ * @brief Host-based Unit Tests for ESPSOL Transaction Templates
+ *
+ * Tests template creation, slot patching, re-signing and output against
+ * transactions built from scratch.
+ *
+ * @copyright Copyright (c) 2025 SkyRizz
+ * @license Apache-2.0
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Include ESPSOL headers */
+#include "espsol_types.h"
+#include "espsol_utils.h"
+#include "espsol_crypto.h"
+#include "espsol_tx.h"
+#include "espsol_template.h"
+
+/* ============================================================================
+ * Test Framework
+ * ========================================================================== */
+
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        if (condition) { \
+            printf("✓ PASS: %s\n", message); \
+            tests_passed++; \
+        } else { \
+            printf("✗ FAIL: %s\n", message); \
+            tests_failed++; \
+        } \
+    } while (0)
+
+#define TEST_ASSERT_EQ(actual, expected, message) \
+    do { \
+        if ((actual) == (expected)) { \
+            printf("✓ PASS: %s\n", message); \
+            tests_passed++; \
+        } else { \
+            printf("✗ FAIL: %s (expected %llu, got %llu)\n", message, \
+                   (unsigned long long)(expected), (unsigned long long)(actual)); \
+            tests_failed++; \
+        } \
+    } while (0)
+
+/* ============================================================================
+ * Helpers
+ * ========================================================================== */
+
+static espsol_keypair_t payer;
+static uint8_t recipient[32];
+static uint8_t blockhash[32];
+
+/**
+ * @brief Build, sign and serialize a transfer with a memo from scratch
+ */
+static size_t build_transfer(const uint8_t to[32], uint64_t lamports,
+                             const uint8_t hash[32], uint8_t *buffer)
+{
+    espsol_tx_handle_t tx = NULL;
+    size_t len = 0;
+
+    espsol_tx_create(&tx);
+    espsol_tx_set_fee_payer(tx, payer.public_key);
+    espsol_tx_set_recent_blockhash(tx, hash);
+    espsol_tx_add_transfer(tx, payer.public_key, to, lamports);
+    espsol_tx_add_memo(tx, "payout");
+    espsol_tx_sign(tx, &payer);
+    espsol_tx_serialize(tx, buffer, ESPSOL_MAX_TX_SIZE, &len);
+    espsol_tx_destroy(tx);
+    return len;
+}
+
+/* ============================================================================
+ * Template Tests
+ * ========================================================================== */
+
+static void test_template_patch(void)
+{
+    printf("\n========== Template Patch Tests ==========\n\n");
+
+    espsol_tx_handle_t tx = NULL;
+    espsol_tx_create(&tx);
+    espsol_tx_set_fee_payer(tx, payer.public_key);
+    espsol_tx_set_recent_blockhash(tx, blockhash);
+    espsol_tx_add_transfer(tx, payer.public_key, recipient, 1000);
+    espsol_tx_add_memo(tx, "payout");
+
+    static espsol_tx_template_t tpl;
+    esp_err_t err = espsol_tx_template_init(&tpl, tx);
+    TEST_ASSERT_EQ(err, ESP_OK, "Create template from transaction");
+    espsol_tx_destroy(tx);
+
+    size_t amount_slot = 0, recipient_slot = 0;
+    err = espsol_tx_template_add_data_slot(&tpl, 0, 4, 8, &amount_slot);
+    TEST_ASSERT_EQ(err, ESP_OK, "Add amount slot");
+    err = espsol_tx_template_add_key_slot(&tpl, recipient, &recipient_slot);
+    TEST_ASSERT(err == ESP_OK && recipient_slot != amount_slot, "Add recipient slot");
+
+    /* Unpatched template matches the original transaction */
+    uint8_t expected[ESPSOL_MAX_TX_SIZE];
+    size_t expected_len = build_transfer(recipient, 1000, blockhash, expected);
+    const uint8_t *wire = NULL;
+    size_t wire_len = 0;
+    err = espsol_tx_template_get_transaction(&tpl, &wire, &wire_len);
+    TEST_ASSERT_EQ(err, ESP_ERR_ESPSOL_TX_NOT_SIGNED, "Unsigned template rejected");
+    espsol_tx_template_sign(&tpl, &payer);
+    err = espsol_tx_template_get_transaction(&tpl, &wire, &wire_len);
+    TEST_ASSERT(err == ESP_OK && wire_len == expected_len && memcmp(wire, expected, wire_len) == 0,
+                "Signed template matches built transaction");
+
+    /* Patch every slot, then compare with a transaction built from scratch */
+    uint8_t next_recipient[32];
+    uint8_t next_blockhash[32];
+    memset(next_recipient, 0x5e, sizeof(next_recipient));
+    memset(next_blockhash, 0xb7, sizeof(next_blockhash));
+    espsol_tx_template_set_u64(&tpl, amount_slot, 123456789012ULL);
+    espsol_tx_template_set_pubkey(&tpl, recipient_slot, next_recipient);
+    espsol_tx_template_set_blockhash(&tpl, next_blockhash);
+    TEST_ASSERT(!espsol_tx_template_is_signed(&tpl), "Patching drops signatures");
+
+    espsol_tx_template_sign(&tpl, &payer);
+    expected_len = build_transfer(next_recipient, 123456789012ULL, next_blockhash, expected);
+    err = espsol_tx_template_get_transaction(&tpl, &wire, &wire_len);
+    TEST_ASSERT(err == ESP_OK && wire_len == expected_len && memcmp(wire, expected, wire_len) == 0,
+                "Patched template matches rebuilt transaction");
+
+    char b64_template[ESPSOL_MAX_TX_SIZE * 2];
+    char b64_expected[ESPSOL_MAX_TX_SIZE * 2];
+    err = espsol_tx_template_to_base64(&tpl, b64_template, sizeof(b64_template));
+    espsol_base64_encode(expected, expected_len, b64_expected, sizeof(b64_expected));
+    TEST_ASSERT(err == ESP_OK && strcmp(b64_template, b64_expected) == 0, "Base64 output matches");
+
+    TEST_ASSERT(espsol_verify(wire + 1 + 64, wire_len - 1 - 64, wire + 1, payer.public_key) == ESP_OK,
+                "Template signature verifies");
+}
+
+static void test_template_errors(void)
+{
+    printf("\n========== Template Error Tests ==========\n\n");
+
+    espsol_tx_handle_t tx = NULL;
+    espsol_tx_create(&tx);
+    espsol_tx_set_fee_payer(tx, payer.public_key);
+    espsol_tx_add_transfer(tx, payer.public_key, recipient, 1000);
+
+    static espsol_tx_template_t tpl;
+    esp_err_t err = espsol_tx_template_init(&tpl, tx);
+    TEST_ASSERT_EQ(err, ESP_ERR_ESPSOL_TX_BUILD_ERROR, "Transaction without blockhash rejected");
+    espsol_tx_set_recent_blockhash(tx, blockhash);
+    err = espsol_tx_template_init(&tpl, tx);
+    TEST_ASSERT_EQ(err, ESP_OK, "Create template");
+    espsol_tx_destroy(tx);
+
+    size_t slot = 0;
+    err = espsol_tx_template_add_data_slot(&tpl, 1, 0, 4, &slot);
+    TEST_ASSERT_EQ(err, ESP_ERR_INVALID_ARG, "Missing instruction rejected");
+    err = espsol_tx_template_add_data_slot(&tpl, 0, 8, 8, &slot);
+    TEST_ASSERT_EQ(err, ESP_ERR_INVALID_ARG, "Slot past instruction data rejected");
+    err = espsol_tx_template_add_key_slot(&tpl, payer.public_key, &slot);
+    TEST_ASSERT_EQ(err, ESP_ERR_INVALID_ARG, "Signer key slot rejected");
+    uint8_t unknown[32];
+    memset(unknown, 0x99, sizeof(unknown));
+    err = espsol_tx_template_add_key_slot(&tpl, unknown, &slot);
+    TEST_ASSERT_EQ(err, ESP_ERR_NOT_FOUND, "Unknown key rejected");
+
+    err = espsol_tx_template_add_key_slot(&tpl, recipient, &slot);
+    TEST_ASSERT_EQ(err, ESP_OK, "Add recipient slot");
+    err = espsol_tx_template_set_pubkey(&tpl, slot, ESPSOL_SYSTEM_PROGRAM_ID);
+    TEST_ASSERT_EQ(err, ESP_ERR_INVALID_ARG, "Duplicate account key rejected");
+    err = espsol_tx_template_set_u64(&tpl, slot, 1);
+    TEST_ASSERT_EQ(err, ESP_ERR_INVALID_ARG, "Size mismatch rejected");
+    err = espsol_tx_template_set_u64(&tpl, 7, 1);
+    TEST_ASSERT_EQ(err, ESP_ERR_INVALID_ARG, "Unknown slot rejected");
+
+    espsol_keypair_t other;
+    uint8_t seed[32];
+    memset(seed, 0x33, sizeof(seed));
+    espsol_keypair_from_seed(seed, &other);
+    err = espsol_tx_template_sign(&tpl, &other);
+    TEST_ASSERT_EQ(err, ESP_ERR_ESPSOL_TX_BUILD_ERROR, "Non-signer keypair rejected");
+
+    for (int i = 1; i < ESPSOL_TX_TEMPLATE_MAX_SLOTS; i++) {
+        espsol_tx_template_add_data_slot(&tpl, 0, 4, 8, &slot);
+    }
+    err = espsol_tx_template_add_data_slot(&tpl, 0, 4, 8, &slot);
+    TEST_ASSERT_EQ(err, ESP_ERR_ESPSOL_BUFFER_TOO_SMALL, "Slot table full");
+}
+
+/* ============================================================================
+ * Main
+ * ========================================================================== */
+
+int main(void)
+{
+    printf("==============================================\n");
+    printf("   ESPSOL Transaction Template Host Tests\n");
+    printf("==============================================\n");
+
+    uint8_t seed[32];
+    memset(seed, 0x42, sizeof(seed));
+    espsol_keypair_from_seed(seed, &payer);
+    memset(recipient, 0x24, sizeof(recipient));
+    memset(blockhash, 0xab, sizeof(blockhash));
+
+    test_template_patch();
+    test_template_errors();
+
+    /* Summary */
+    printf("\n==============================================\n");
+    printf("Test Summary: %d passed, %d failed\n", tests_passed, tests_failed);
+    printf("==============================================\n");
+
+    return tests_failed > 0 ? 1 : 0;
+}
@@ -3,7 +3,8 @@
  * @brief Host-based unit tests for SPL Token operations
  *
  * Tests for:
- * - ATA address derivation
+ * - ATA address derivation (single and batched)
+ * - Seed-derived addresses
  * - Token transfer instructions
  * - Token account operations
  *
@@ -22,6 +23,7 @@
 #include "espsol_crypto.h"
 #include "espsol_tx.h"
 #include "espsol_token.h"
+#include "espsol_sha.h"
 
 /* Test counters */
 static int tests_passed = 0;
@@ -55,16 +57,6 @@ static int tests_failed = 0;
     } \
 } while(0)
 
-/* Helper to print pubkey as hex */
-static void print_hex(const char *label, const uint8_t *data, size_t len)
-{
-    printf("%s: ", label);
-    for (size_t i = 0; i < len; i++) {
-        printf("%02x", data[i]);
-    }
-    printf("\n");
-}
-
 /* ============================================================================
  * Test Cases
  * ========================================================================== */
@@ -412,20 +404,196 @@ static void test_on_curve_check(void)
     esp_err_t err = espsol_keypair_generate(&keypair);
     ASSERT_EQ(ESP_OK, err, "generate keypair");
     
-    /* For host testing, our simple implementation always returns true for non-zero keys */
     bool on_curve = espsol_is_on_curve(keypair.public_key);
     ASSERT_TRUE(on_curve, "generated pubkey should be on curve");
     
-    /* Zero key should not be on curve */
-    uint8_t zeros[ESPSOL_PUBKEY_SIZE] = {0};
-    on_curve = espsol_is_on_curve(zeros);
-    ASSERT_TRUE(!on_curve, "zero key should not be on curve");
+    /* The zero key decodes to a point of order 4 */
+    uint8_t key[ESPSOL_PUBKEY_SIZE] = {0};
+    on_curve = espsol_is_on_curve(key);
+    ASSERT_TRUE(on_curve, "zero key is on curve");
+
+    /* Non-canonical y = p + 1 decodes like y = 1, the identity */
+    memset(key, 0xff, sizeof(key));
+    key[0] = 0xee;
+    key[31] = 0x7f;
+    ASSERT_TRUE(espsol_is_on_curve(key), "non-canonical y is on curve");
+
+    /* A PDA is off the curve */
+    espsol_address_to_pubkey("5ksWBW9kuRfqvu3BqKLSPKgmqWbDjxUsNhNJy1AtXJJe", key);
+    ASSERT_TRUE(!espsol_is_on_curve(key), "PDA is off curve");
+
+    /* SHA-256("espsol-curve-<i>"): bit i set where libsodium's
+     * ge25519_frombytes() accepts the digest */
+    const uint64_t on_curve_mask = 0x99cd619115fe974fULL;
+    int mismatches = 0;
+    for (int i = 0; i < 64; i++) {
+        char label[24];
+        uint8_t digest[32];
+        int n = snprintf(label, sizeof(label), "espsol-curve-%d", i);
+        espsol_sha256((const uint8_t *)label, (size_t)n, digest);
+        if (espsol_is_on_curve(digest) != (bool)((on_curve_mask >> i) & 1)) {
+            mismatches++;
+        }
+    }
+    ASSERT_EQ(0, mismatches, "curve check matches libsodium on 64 digests");
     
     /* NULL check */
     on_curve = espsol_is_on_curve(NULL);
     ASSERT_TRUE(!on_curve, "NULL should not be on curve");
 }
 
+static void test_pda_derivation(void)
+{
+    printf("\n[Test: PDA Derivation]\n");
+
+    /* Bumps 255 to 251 give on-curve candidates for this seed */
+    static const uint8_t expected_pda[ESPSOL_PUBKEY_SIZE] = {
+        0x46, 0xab, 0xd3, 0x99, 0x4a, 0xb6, 0x99, 0x3c,
+        0x7e, 0xaf, 0xc1, 0xdd, 0x2d, 0x72, 0x4f, 0x00,
+        0x73, 0x46, 0xde, 0x39, 0x00, 0x6d, 0x99, 0x3b,
+        0xc1, 0xb6, 0x68, 0xb7, 0x85, 0x47, 0x37, 0xe3,
+    };
+    const uint8_t *seeds[1] = { (const uint8_t *)"espsol-17" };
+    const size_t seed_lens[1] = { 9 };
+    uint8_t pda[ESPSOL_PUBKEY_SIZE];
+    uint8_t bump = 0;
+    esp_err_t err = espsol_token_find_pda(seeds, seed_lens, 1, ESPSOL_TOKEN_PROGRAM_ID,
+                                          pda, &bump);
+    ASSERT_EQ(ESP_OK, err, "find PDA");
+    ASSERT_EQ(250, bump, "PDA bump");
+    ASSERT_MEM_EQ(expected_pda, pda, ESPSOL_PUBKEY_SIZE, "PDA matches");
+
+    /* Seeds the runtime would reject */
+    static const uint8_t long_seed[ESPSOL_MAX_SEED_LEN + 1] = {0};
+    const uint8_t *many_seeds[ESPSOL_MAX_SEEDS];
+    size_t many_lens[ESPSOL_MAX_SEEDS];
+    for (int i = 0; i < ESPSOL_MAX_SEEDS; i++) {
+        many_seeds[i] = long_seed;
+        many_lens[i] = 1;
+    }
+    err = espsol_token_find_pda(many_seeds, many_lens, ESPSOL_MAX_SEEDS - 1,
+                                ESPSOL_TOKEN_PROGRAM_ID, pda, NULL);
+    ASSERT_EQ(ESP_OK, err, "most seeds accepted");
+    err = espsol_token_find_pda(many_seeds, many_lens, ESPSOL_MAX_SEEDS,
+                                ESPSOL_TOKEN_PROGRAM_ID, pda, NULL);
+    ASSERT_EQ(ESP_ERR_INVALID_ARG, err, "too many seeds rejected");
+    many_lens[0] = ESPSOL_MAX_SEED_LEN + 1;
+    err = espsol_token_find_pda(many_seeds, many_lens, 1, ESPSOL_TOKEN_PROGRAM_ID, pda, NULL);
+    ASSERT_EQ(ESP_ERR_INVALID_ARG, err, "long seed rejected");
+    many_seeds[0] = NULL;
+    many_lens[0] = 1;
+    err = espsol_token_find_pda(many_seeds, many_lens, 1, ESPSOL_TOKEN_PROGRAM_ID, pda, NULL);
+    ASSERT_EQ(ESP_ERR_INVALID_ARG, err, "NULL seed rejected");
+    err = espsol_token_find_pda(NULL, NULL, 0, ESPSOL_TOKEN_PROGRAM_ID, pda, NULL);
+    ASSERT_EQ(ESP_OK, err, "no seeds accepted");
+
+    /* USDC associated token accounts */
+    static const struct {
+        const char *wallet;
+        const char *ata;
+    } vectors[] = {
+        { "9WzDXwBbmkg8ZTbNMqUxvQRAyrZzDsGYdLVL9zYtAWWM", "FGETo8T8wMcN2wCjav8VK6eh3dLk63evNDPxzLSJra8B" },
+        { "vines1vzrYbzLMRdu58ou5XTby4qAqVRLmqo36NKPTg", "9jrTvdU2Am3UmgSAX8EKS9wwrSufkWRbZzEukDogqpQg" },
+        { "11111111111111111111111111111111", "HJt8Tjdsc9ms9i4WCZEzhzr4oyf3ANcdzXrNdLPFqm3M" },
+    };
+    uint8_t usdc[ESPSOL_PUBKEY_SIZE];
+    espsol_address_to_pubkey("EPjFWdd5AufqSSqeM2qN1xzybapC8G4wEGGkZwyTDt1v", usdc);
+
+    for (size_t i = 0; i < sizeof(vectors) / sizeof(vectors[0]); i++) {
+        uint8_t wallet[ESPSOL_PUBKEY_SIZE], expected[ESPSOL_PUBKEY_SIZE], ata[ESPSOL_PUBKEY_SIZE];
+        espsol_address_to_pubkey(vectors[i].wallet, wallet);
+        espsol_address_to_pubkey(vectors[i].ata, expected);
+        err = espsol_token_get_ata_address(wallet, usdc, ata);
+        ASSERT_EQ(ESP_OK, err, "derive USDC ATA");
+        ASSERT_MEM_EQ(expected, ata, ESPSOL_PUBKEY_SIZE, "USDC ATA matches");
+    }
+}
+
+static void test_create_with_seed(void)
+{
+    printf("\n[Test: Create With Seed]\n");
+
+    uint8_t base[ESPSOL_PUBKEY_SIZE], owner[ESPSOL_PUBKEY_SIZE], address[ESPSOL_PUBKEY_SIZE];
+    for (int i = 0; i < ESPSOL_PUBKEY_SIZE; i++) {
+        base[i] = (uint8_t)i;
+        owner[i] = (uint8_t)(i * 7 + 3);
+    }
+
+    /* SHA-256(base || "espsol-airdrop" || owner) */
+    static const uint8_t expected[ESPSOL_PUBKEY_SIZE] = {
+        0x53, 0x1e, 0xaa, 0xe8, 0x31, 0x52, 0x78, 0xe5,
+        0xfd, 0x34, 0x11, 0x90, 0x0e, 0x7c, 0x2f, 0x06,
+        0xe1, 0x59, 0xc8, 0x78, 0x46, 0x50, 0x05, 0x33,
+        0xe6, 0x25, 0xae, 0xf1, 0x55, 0xc9, 0xe2, 0x55,
+    };
+    esp_err_t err = espsol_token_create_with_seed(base, "espsol-airdrop", owner, address);
+    ASSERT_EQ(ESP_OK, err, "derive seed address");
+    ASSERT_MEM_EQ(expected, address, ESPSOL_PUBKEY_SIZE, "seed address matches");
+
+    /* Seeds up to ESPSOL_MAX_SEED_LEN bytes */
+    char seed[ESPSOL_MAX_SEED_LEN + 2];
+    memset(seed, 'a', sizeof(seed) - 1);
+    seed[ESPSOL_MAX_SEED_LEN] = '\0';
+    err = espsol_token_create_with_seed(base, seed, owner, address);
+    ASSERT_EQ(ESP_OK, err, "longest seed accepted");
+    seed[ESPSOL_MAX_SEED_LEN] = 'a';
+    seed[ESPSOL_MAX_SEED_LEN + 1] = '\0';
+    err = espsol_token_create_with_seed(base, seed, owner, address);
+    ASSERT_EQ(ESP_ERR_INVALID_ARG, err, "seed too long rejected");
+
+    /* An owner ending in the PDA marker is illegal */
+    memcpy(owner + ESPSOL_PUBKEY_SIZE - 21, "ProgramDerivedAddress", 21);
+    err = espsol_token_create_with_seed(base, "x", owner, address);
+    ASSERT_EQ(ESP_ERR_INVALID_ARG, err, "PDA marker owner rejected");
+
+    err = espsol_token_create_with_seed(base, NULL, owner, address);
+    ASSERT_EQ(ESP_ERR_INVALID_ARG, err, "NULL seed rejected");
+}
+
+static void test_ata_batch(void)
+{
+    printf("\n[Test: Batch ATA Derivation]\n");
+
+    /* Enough pairs to be split among several threads, with one shared mint */
+    enum { PAIRS = 150 };
+    static uint8_t wallets[PAIRS][ESPSOL_PUBKEY_SIZE];
+    static uint8_t mints[PAIRS][ESPSOL_PUBKEY_SIZE];
+    static uint8_t batch[PAIRS][ESPSOL_PUBKEY_SIZE];
+    for (int i = 0; i < PAIRS; i++) {
+        for (int j = 0; j < ESPSOL_PUBKEY_SIZE; j++) {
+            wallets[i][j] = (uint8_t)(i * 31 + j * 17 + 1);
+            mints[i][j] = (uint8_t)(i % 3 == 0 ? j : i + j * 5);
+        }
+    }
+
+    esp_err_t batch_err = espsol_token_get_ata_addresses_batch(
+        (const uint8_t (*)[ESPSOL_PUBKEY_SIZE])wallets,
+        (const uint8_t (*)[ESPSOL_PUBKEY_SIZE])mints, PAIRS, batch);
+
+    /* Same result as deriving each pair on its own */
+    esp_err_t serial_err = ESP_OK;
+    int mismatches = 0;
+    for (int i = 0; i < PAIRS; i++) {
+        uint8_t ata[ESPSOL_PUBKEY_SIZE];
+        esp_err_t err = espsol_token_get_ata_address(wallets[i], mints[i], ata);
+        if (serial_err == ESP_OK) {
+            serial_err = err;
+        }
+        if (err == ESP_OK && memcmp(ata, batch[i], ESPSOL_PUBKEY_SIZE) != 0) {
+            mismatches++;
+        }
+    }
+    ASSERT_EQ(ESP_OK, serial_err, "serial derivation succeeds");
+    ASSERT_EQ(serial_err, batch_err, "batch result matches serial derivation");
+    ASSERT_EQ(0, mismatches, "batch addresses match serial derivation");
+
+    ASSERT_EQ(ESP_OK, espsol_token_get_ata_addresses_batch(NULL, NULL, 0, NULL),
+              "empty batch accepted");
+    ASSERT_EQ(ESP_ERR_INVALID_ARG, espsol_token_get_ata_addresses_batch(
+                  NULL, (const uint8_t (*)[ESPSOL_PUBKEY_SIZE])mints, 1, batch),
+              "NULL wallets rejected");
+}
+
 /* ============================================================================
  * Main Test Runner
  * ========================================================================== */
@@ -447,6 +615,9 @@ int main(void)
     test_combined_token_transaction();
     test_null_argument_checks();
     test_on_curve_check();
+    test_pda_derivation();
+    test_create_with_seed();
+    test_ata_batch();
     
     /* Print summary */
     printf("\n============================================\n");
@@ -18,6 +18,7 @@
 #include "espsol_utils.h"
 #include "espsol_crypto.h"
 #include "espsol_tx.h"
+#include "espsol_view.h"
 
 /* ============================================================================
  * Test Framework
@@ -359,6 +360,940 @@ static void test_tx_memo(void)
     espsol_tx_destroy(tx);
 }
 
+static void test_tx_versioned(void)
+{
+    printf("\n========== Versioned Transaction Tests ==========\n\n");
+    
+    espsol_tx_handle_t tx = NULL;
+    esp_err_t err;
+    
+    espsol_keypair_t payer;
+    uint8_t seed[32];
+    memset(seed, 0x42, sizeof(seed));
+    espsol_keypair_from_seed(seed, &payer);
+    
+    uint8_t blockhash[32];
+    memset(blockhash, 0xBB, sizeof(blockhash));
+    
+    /* Table A holds two recipients and a read-only account, table B a program */
+    uint8_t table_a_keys[3][32];
+    memset(table_a_keys[0], 0xA0, 32);
+    memset(table_a_keys[1], 0xA1, 32);
+    memset(table_a_keys[2], 0xA2, 32);
+    uint8_t table_b_keys[1][32];
+    memset(table_b_keys[0], 0xB0, 32);
+    
+    espsol_lookup_table_t table_a = { .addresses = table_a_keys, .address_count = 3 };
+    espsol_lookup_table_t table_b = { .addresses = table_b_keys, .address_count = 1 };
+    memset(table_a.key, 0x7A, 32);
+    memset(table_b.key, 0x7B, 32);
+    
+    uint8_t static_only[32];
+    memset(static_only, 0x55, 32);
+    
+    espsol_tx_create(&tx);
+    espsol_tx_version_t version = ESPSOL_TX_VERSION_0;
+    espsol_tx_get_version(tx, &version);
+    TEST_ASSERT_EQ(version, ESPSOL_TX_VERSION_LEGACY, "New transaction is legacy");
+    TEST_ASSERT_EQ(espsol_tx_set_version(tx, (espsol_tx_version_t)7), ESP_ERR_INVALID_ARG,
+                   "Unknown version rejected");
+    
+    err = espsol_tx_add_lookup_table(tx, &table_a);
+    TEST_ASSERT_EQ(err, ESP_OK, "Add lookup table A");
+    err = espsol_tx_add_lookup_table(tx, &table_b);
+    TEST_ASSERT_EQ(err, ESP_OK, "Add lookup table B");
+    espsol_tx_get_version(tx, &version);
+    TEST_ASSERT_EQ(version, ESPSOL_TX_VERSION_0, "Lookup table selects v0");
+    
+    espsol_tx_set_fee_payer(tx, payer.public_key);
+    espsol_tx_set_recent_blockhash(tx, blockhash);
+    espsol_tx_add_transfer(tx, payer.public_key, table_a_keys[0], 1000);
+    
+    /* Program in table B must stay static because it is invoked */
+    espsol_account_meta_t metas[3] = {
+        { .is_signer = false, .is_writable = true },
+        { .is_signer = false, .is_writable = false },
+        { .is_signer = true, .is_writable = true },
+    };
+    memcpy(metas[0].pubkey, table_a_keys[1], 32);
+    memcpy(metas[1].pubkey, table_a_keys[2], 32);
+    memcpy(metas[2].pubkey, payer.public_key, 32);
+    uint8_t data[] = { 0x09 };
+    espsol_tx_add_instruction(tx, table_b_keys[0], metas, 3, data, sizeof(data));
+    espsol_tx_add_transfer(tx, payer.public_key, static_only, 2000);
+    
+    size_t count = 0;
+    espsol_tx_get_account_count(tx, &count);
+    TEST_ASSERT_EQ(count, 7, "All accounts counted");
+    
+    err = espsol_tx_sign(tx, &payer);
+    TEST_ASSERT_EQ(err, ESP_OK, "Sign v0 transaction");
+    
+    uint8_t buffer[1232];
+    size_t len = 0;
+    err = espsol_tx_serialize(tx, buffer, sizeof(buffer), &len);
+    TEST_ASSERT_EQ(err, ESP_OK, "Serialize v0 transaction");
+    
+    const uint8_t *msg = buffer + 1 + 64;
+    size_t msg_len = len - 1 - 64;
+    TEST_ASSERT(buffer[0] == 1 && msg[0] == 0x80, "Signature count then version prefix");
+    TEST_ASSERT(msg[1] == 1 && msg[2] == 0 && msg[3] == 2, "Header counts static keys only");
+    TEST_ASSERT_EQ(msg[4], 4, "Four static keys");
+    TEST_ASSERT(memcmp(msg + 5, payer.public_key, 32) == 0, "Fee payer first");
+    
+    bool static_ok = true;
+    for (int i = 0; i < 4; i++) {
+        if (msg[5 + i * 32] == 0xA0 || msg[5 + i * 32] == 0xA1 || msg[5 + i * 32] == 0xA2) {
+            static_ok = false;
+        }
+    }
+    TEST_ASSERT(static_ok, "Looked-up accounts not in static keys");
+    
+    /* First instruction: transfer to table A[0], the first loaded writable (index 4) */
+    const uint8_t *p = msg + 5 + 4 * 32 + 32;
+    TEST_ASSERT_EQ(p[0], 3, "Three instructions");
+    TEST_ASSERT(p[2] == 2 && p[3] == 0 && p[4] == 4, "Transfer recipient resolved to loaded index");
+    p += 1 + 1 + 1 + 2 + 1 + 12;
+    TEST_ASSERT(p[1] == 3 && p[2] == 5 && p[3] == 6 && p[4] == 0,
+                "Custom instruction uses writable then read-only loaded indices");
+    
+    /* Lookups: only table A is used */
+    const uint8_t expected_lookups[] = { 1, 0x7A, 2, 0, 1, 1, 2 };
+    const uint8_t *lookups = msg + msg_len - sizeof(expected_lookups) - 31;
+    TEST_ASSERT(lookups[0] == expected_lookups[0] && lookups[1] == 0x7A && lookups[32] == 0x7A &&
+                memcmp(lookups + 33, expected_lookups + 2, 5) == 0,
+                "Unused table omitted, index lists encoded");
+    
+    uint8_t signature[64];
+    espsol_tx_get_signature(tx, 0, signature);
+    TEST_ASSERT_EQ(espsol_verify(msg, msg_len, signature, payer.public_key), ESP_OK,
+                   "Signature covers the v0 message");
+    
+    /* Same transaction as legacy is larger */
+    size_t v0_len = len;
+    espsol_tx_set_version(tx, ESPSOL_TX_VERSION_LEGACY);
+    espsol_tx_sign(tx, &payer);
+    espsol_tx_serialize(tx, buffer, sizeof(buffer), &len);
+    TEST_ASSERT(buffer[65] == 1 && len > v0_len, "Legacy message has no prefix and is larger");
+    espsol_tx_destroy(tx);
+    
+    /* 24 recipients: too many for legacy, fits with a lookup table */
+    static uint8_t recipients[24][32];
+    for (int i = 0; i < 24; i++) {
+        memset(recipients[i], 0x10 + i, 32);
+    }
+    espsol_lookup_table_t big = { .addresses = recipients, .address_count = 24 };
+    memset(big.key, 0x7C, 32);
+    
+    for (int pass = 0; pass < 2; pass++) {
+        espsol_tx_create(&tx);
+        if (pass == 1) {
+            espsol_tx_add_lookup_table(tx, &big);
+        }
+        espsol_tx_set_fee_payer(tx, payer.public_key);
+        espsol_tx_set_recent_blockhash(tx, blockhash);
+        espsol_account_meta_t many[ESPSOL_MAX_ACCOUNTS];
+        for (int ix = 0; ix < 2; ix++) {
+            for (int i = 0; i < 12; i++) {
+                memcpy(many[i].pubkey, recipients[ix * 12 + i], 32);
+                many[i].is_signer = false;
+                many[i].is_writable = true;
+            }
+            espsol_tx_add_instruction(tx, static_only, many, 12, NULL, 0);
+        }
+        err = espsol_tx_sign(tx, &payer);
+        if (pass == 0) {
+            TEST_ASSERT_EQ(err, ESP_ERR_ESPSOL_MAX_ACCOUNTS, "Legacy rejects 26 accounts");
+        } else {
+            TEST_ASSERT_EQ(err, ESP_OK, "v0 signs 26 accounts via lookup table");
+            espsol_tx_serialize(tx, buffer, sizeof(buffer), &len);
+            TEST_ASSERT(buffer[1 + 64 + 4] == 2, "Only payer and program are static");
+        }
+        espsol_tx_destroy(tx);
+    }
+    
+    espsol_tx_create(&tx);
+    for (int i = 0; i < ESPSOL_MAX_LOOKUP_TABLES; i++) {
+        espsol_tx_add_lookup_table(tx, &table_a);
+    }
+    TEST_ASSERT_EQ(espsol_tx_add_lookup_table(tx, &table_a), ESP_ERR_ESPSOL_MAX_ACCOUNTS,
+                   "Lookup table limit enforced");
+    espsol_tx_destroy(tx);
+}
+
+static void build_payment(espsol_tx_handle_t tx, const espsol_keypair_t *payer)
+{
+    uint8_t to[32];
+    uint8_t blockhash[32];
+    memset(to, 0x21, sizeof(to));
+    memset(blockhash, 0xab, sizeof(blockhash));
+    
+    espsol_tx_set_fee_payer(tx, payer->public_key);
+    espsol_tx_set_recent_blockhash(tx, blockhash);
+    espsol_tx_add_transfer(tx, payer->public_key, to, 5000);
+    espsol_tx_add_memo(tx, "static");
+    espsol_tx_sign(tx, payer);
+}
+
+static void test_tx_static(void)
+{
+    printf("\n========== Static Transaction Tests ==========\n\n");
+    
+    espsol_keypair_t payer;
+    uint8_t seed[32];
+    memset(seed, 0x11, sizeof(seed));
+    espsol_keypair_from_seed(seed, &payer);
+    
+    /* Heap transaction as reference */
+    espsol_tx_handle_t heap_tx = NULL;
+    espsol_tx_create(&heap_tx);
+    build_payment(heap_tx, &payer);
+    uint8_t expected[1232];
+    size_t expected_len = 0;
+    esp_err_t err = espsol_tx_serialize(heap_tx, expected, sizeof(expected), &expected_len);
+    TEST_ASSERT_EQ(err, ESP_OK, "Serialize heap transaction");
+    espsol_tx_destroy(heap_tx);
+    
+    /* Same transaction in a stack buffer */
+    uint8_t storage[ESPSOL_TX_STATIC_SIZE];
+    espsol_tx_handle_t tx = NULL;
+    err = espsol_tx_init_static(storage + 1, sizeof(storage) - 1, &tx);
+    TEST_ASSERT_EQ(err, ESP_OK, "Init static transaction (unaligned buffer)");
+    build_payment(tx, &payer);
+    TEST_ASSERT(espsol_tx_is_signed(tx), "Static transaction is signed");
+    
+    uint8_t buffer[1232];
+    size_t out_len = 0;
+    err = espsol_tx_serialize(tx, buffer, sizeof(buffer), &out_len);
+    TEST_ASSERT_EQ(err, ESP_OK, "Serialize static transaction");
+    TEST_ASSERT(out_len == expected_len && memcmp(buffer, expected, out_len) == 0,
+                "Static transaction matches heap transaction");
+    
+    /* Reset keeps the buffer */
+    err = espsol_tx_reset(tx);
+    TEST_ASSERT_EQ(err, ESP_OK, "Reset static transaction");
+    build_payment(tx, &payer);
+    err = espsol_tx_serialize(tx, buffer, sizeof(buffer), &out_len);
+    TEST_ASSERT(err == ESP_OK && out_len == expected_len && memcmp(buffer, expected, out_len) == 0,
+                "Rebuilt static transaction matches");
+    TEST_ASSERT_EQ(espsol_tx_destroy(tx), ESP_OK, "Destroy static transaction");
+    
+    /* Exhausting the buffer */
+    uint8_t small[784];
+    err = espsol_tx_init_static(small, sizeof(small), &tx);
+    TEST_ASSERT_EQ(err, ESP_OK, "Init small static transaction");
+    espsol_account_meta_t accounts[8];
+    for (int i = 0; i < 8; i++) {
+        memset(accounts[i].pubkey, 0x40 + i, 32);
+        accounts[i].is_signer = false;
+        accounts[i].is_writable = true;
+    }
+    err = ESP_OK;
+    for (int i = 0; i < 10 && err == ESP_OK; i++) {
+        accounts[0].pubkey[0] = (uint8_t)i;
+        err = espsol_tx_add_instruction(tx, payer.public_key, accounts, 8, NULL, 0);
+    }
+    TEST_ASSERT_EQ(err, ESP_ERR_NO_MEM, "Full static buffer returns NO_MEM");
+    
+    /* An instruction that does not fit leaves the signed message alone */
+    uint8_t signed_storage[1400];
+    static uint8_t big[700];
+    uint8_t blockhash[32];
+    memset(blockhash, 0xab, sizeof(blockhash));
+    espsol_tx_init_static(signed_storage, sizeof(signed_storage), &tx);
+    espsol_tx_set_fee_payer(tx, payer.public_key);
+    espsol_tx_set_recent_blockhash(tx, blockhash);
+    espsol_tx_add_instruction(tx, payer.public_key, accounts, 8, NULL, 0);
+    espsol_tx_sign(tx, &payer);
+    err = espsol_tx_add_instruction(tx, payer.public_key, accounts, 1, big, sizeof(big));
+    TEST_ASSERT(err == ESP_ERR_NO_MEM && espsol_tx_is_signed(tx),
+                "Rejected instruction keeps the signature");
+    TEST_ASSERT_EQ(espsol_tx_serialize(tx, buffer, sizeof(buffer), &out_len), ESP_OK,
+                   "Signed transaction still serializes");
+    
+    err = espsol_tx_init_static(small, 16, &tx);
+    TEST_ASSERT_EQ(err, ESP_ERR_ESPSOL_BUFFER_TOO_SMALL, "Tiny static buffer rejected");
+    err = espsol_tx_init_static(NULL, sizeof(small), &tx);
+    TEST_ASSERT_EQ(err, ESP_ERR_INVALID_ARG, "NULL static buffer rejected");
+}
+
+static void test_tx_limits(void)
+{
+    printf("\n========== Transaction Limit Tests ==========\n\n");
+    
+    espsol_keypair_t signers[6];
+    for (int i = 0; i < 6; i++) {
+        uint8_t seed[32];
+        memset(seed, 0x60 + i, sizeof(seed));
+        espsol_keypair_from_seed(seed, &signers[i]);
+    }
+    uint8_t blockhash[32];
+    memset(blockhash, 0xcd, sizeof(blockhash));
+    uint8_t program_id[32];
+    memset(program_id, 0x03, sizeof(program_id));
+    
+    /* Large instruction data */
+    espsol_tx_handle_t tx = NULL;
+    espsol_tx_create(&tx);
+    espsol_tx_set_fee_payer(tx, signers[0].public_key);
+    espsol_tx_set_recent_blockhash(tx, blockhash);
+    static uint8_t data[ESPSOL_MAX_TX_SIZE + 1];
+    memset(data, 0x5a, sizeof(data));
+    esp_err_t err = espsol_tx_add_instruction(tx, program_id, NULL, 0, data, 900);
+    TEST_ASSERT_EQ(err, ESP_OK, "Add 900 bytes of instruction data");
+    err = espsol_tx_sign(tx, &signers[0]);
+    TEST_ASSERT_EQ(err, ESP_OK, "Sign large transaction");
+    
+    uint8_t buffer[1232];
+    size_t out_len = 0;
+    err = espsol_tx_serialize(tx, buffer, sizeof(buffer), &out_len);
+    TEST_ASSERT_EQ(err, ESP_OK, "Serialize large transaction");
+    TEST_ASSERT(out_len > 1000 && buffer[out_len - 1] == 0x5a, "Large data serialized");
+    
+    err = espsol_tx_add_instruction(tx, program_id, NULL, 0, data, 400);
+    TEST_ASSERT_EQ(err, ESP_ERR_ESPSOL_BUFFER_TOO_SMALL, "Data beyond wire size rejected");
+    err = espsol_tx_add_instruction(tx, program_id, NULL, 0, data, sizeof(data));
+    TEST_ASSERT_EQ(err, ESP_ERR_ESPSOL_BUFFER_TOO_SMALL, "Oversized instruction rejected");
+    espsol_tx_destroy(tx);
+    
+    /* Six signers */
+    espsol_tx_create(&tx);
+    espsol_tx_set_fee_payer(tx, signers[0].public_key);
+    espsol_tx_set_recent_blockhash(tx, blockhash);
+    espsol_account_meta_t accounts[6];
+    for (int i = 0; i < 6; i++) {
+        memcpy(accounts[i].pubkey, signers[i].public_key, 32);
+        accounts[i].is_signer = true;
+        accounts[i].is_writable = (i % 2) == 0;
+    }
+    err = espsol_tx_add_instruction(tx, program_id, accounts, 6, NULL, 0);
+    TEST_ASSERT_EQ(err, ESP_OK, "Add instruction with six signers");
+    
+    /* Sign out of order */
+    for (int i = 5; i >= 0; i--) {
+        err = espsol_tx_sign(tx, &signers[i]);
+        if (err != ESP_OK || (i > 0 && espsol_tx_is_signed(tx))) {
+            break;
+        }
+    }
+    TEST_ASSERT_EQ(err, ESP_OK, "Sign with six keypairs");
+    TEST_ASSERT(espsol_tx_is_signed(tx), "Fully signed after last signer");
+    
+    size_t sig_count = 0;
+    espsol_tx_get_signature_count(tx, &sig_count);
+    TEST_ASSERT_EQ(sig_count, 6, "Six signatures");
+    
+    err = espsol_tx_serialize(tx, buffer, sizeof(buffer), &out_len);
+    TEST_ASSERT_EQ(err, ESP_OK, "Serialize six-signer transaction");
+    TEST_ASSERT(buffer[0] == 6 && buffer[1 + 6 * 64] == 6, "Six signatures required");
+    
+    uint8_t signature[64];
+    espsol_tx_get_signature(tx, 0, signature);
+    TEST_ASSERT(memcmp(buffer + 1, signature, 64) == 0, "Fee payer signature first");
+    espsol_tx_destroy(tx);
+}
+
+static void test_tx_account_order(void)
+{
+    printf("\n========== Account Ordering Tests ==========\n\n");
+    
+    espsol_keypair_t payer;
+    uint8_t seed[32];
+    memset(seed, 0x71, sizeof(seed));
+    espsol_keypair_from_seed(seed, &payer);
+    uint8_t blockhash[32];
+    memset(blockhash, 0xcd, sizeof(blockhash));
+    uint8_t program_id[32];
+    memset(program_id, 0x03, sizeof(program_id));
+    
+    /* R1 is read-only at first use and becomes writable later */
+    espsol_account_meta_t accounts[5];
+    const uint8_t fill[5] = { 0x11, 0x21, 0x12, 0x22, 0x11 };
+    const bool writable[5] = { false, true, false, true, true };
+    for (int i = 0; i < 5; i++) {
+        memset(accounts[i].pubkey, fill[i], 32);
+        accounts[i].is_signer = false;
+        accounts[i].is_writable = writable[i];
+    }
+    
+    espsol_tx_handle_t tx = NULL;
+    espsol_tx_create(&tx);
+    espsol_tx_set_fee_payer(tx, payer.public_key);
+    espsol_tx_set_recent_blockhash(tx, blockhash);
+    esp_err_t err = espsol_tx_add_instruction(tx, program_id, accounts, 5, NULL, 0);
+    TEST_ASSERT_EQ(err, ESP_OK, "Add instruction with repeated account");
+    espsol_tx_sign(tx, &payer);
+    
+    uint8_t buffer[1232];
+    size_t out_len = 0;
+    err = espsol_tx_serialize(tx, buffer, sizeof(buffer), &out_len);
+    TEST_ASSERT_EQ(err, ESP_OK, "Serialize ordered transaction");
+    
+    /* Payer, writable R1 W1 W2, read-only program R2, each group in first-use order */
+    const uint8_t *msg = buffer + 1 + 64;
+    const uint8_t expected_keys[6] = { 0, 0x11, 0x21, 0x22, 0x03, 0x12 };
+    bool order_ok = msg[0] == 1 && msg[1] == 0 && msg[2] == 2 && msg[3] == 6 &&
+                    memcmp(msg + 4, payer.public_key, 32) == 0;
+    for (int i = 1; i < 6; i++) {
+        order_ok = order_ok && msg[4 + i * 32] == expected_keys[i] && msg[4 + i * 32 + 31] == expected_keys[i];
+    }
+    TEST_ASSERT(order_ok, "Accounts partitioned stably");
+    
+    const uint8_t *ix = msg + 4 + 6 * 32 + 32;
+    const uint8_t expected_ix[8] = { 1, 4, 5, 1, 2, 5, 3, 1 };
+    TEST_ASSERT(memcmp(ix, expected_ix, sizeof(expected_ix)) == 0, "Instruction indices follow compiled order");
+    espsol_tx_destroy(tx);
+    
+    /* Fill the key table: program, payer and 62 table accounts */
+    static uint8_t keys[62][32];
+    espsol_account_meta_t metas[63];
+    memset(metas, 0, sizeof(metas));
+    memcpy(metas[0].pubkey, payer.public_key, 32);
+    metas[0].is_signer = true;
+    metas[0].is_writable = true;
+    for (int i = 0; i < 62; i++) {
+        memset(keys[i], 0, 32);
+        keys[i][0] = (uint8_t)i;
+        keys[i][31] = 0xa5;
+        memcpy(metas[i + 1].pubkey, keys[i], 32);
+        metas[i + 1].is_writable = (i % 2) == 0;
+    }
+    
+    espsol_tx_create(&tx);
+    espsol_tx_set_fee_payer(tx, payer.public_key);
+    espsol_tx_set_recent_blockhash(tx, blockhash);
+    err = ESP_OK;
+    for (int i = 0; i < 9 && err == ESP_OK; i++) {
+        err = espsol_tx_add_instruction(tx, program_id, &metas[i * 7], 7, NULL, 0);
+    }
+    TEST_ASSERT_EQ(err, ESP_OK, "Add 64 distinct keys");
+    
+    espsol_account_meta_t extra[2];
+    memcpy(&extra[0], &metas[3], sizeof(extra[0]));
+    memset(&extra[1], 0, sizeof(extra[1]));
+    memset(extra[1].pubkey, 0x77, 32);
+    err = espsol_tx_add_instruction(tx, program_id, extra, 2, NULL, 0);
+    TEST_ASSERT_EQ(err, ESP_ERR_ESPSOL_MAX_ACCOUNTS, "65th key rejected");
+    size_t count = 0;
+    espsol_tx_get_instruction_count(tx, &count);
+    TEST_ASSERT_EQ(count, 9, "Rejected instruction not added");
+    
+    /* A new key listed twice takes one slot */
+    espsol_tx_handle_t full;
+    espsol_tx_create(&full);
+    espsol_tx_set_fee_payer(full, payer.public_key);
+    espsol_tx_set_recent_blockhash(full, blockhash);
+    for (int i = 0; i < 9; i++) {
+        espsol_tx_add_instruction(full, program_id, &metas[i * 7], i < 8 ? 7 : 6, NULL, 0);
+    }
+    espsol_account_meta_t twice[2];
+    memset(twice, 0, sizeof(twice));
+    memset(twice[0].pubkey, 0x77, 32);
+    memset(twice[1].pubkey, 0x77, 32);
+    twice[1].is_writable = true;
+    err = espsol_tx_add_instruction(full, program_id, twice, 2, NULL, 0);
+    TEST_ASSERT_EQ(err, ESP_OK, "Repeated new key fills the last slot");
+    espsol_tx_destroy(full);
+    
+    memcpy(&extra[1], &metas[60], sizeof(extra[1]));
+    err = espsol_tx_add_instruction(tx, program_id, extra, 2, NULL, 0);
+    TEST_ASSERT_EQ(err, ESP_OK, "Known keys still found after rejection");
+    
+    espsol_lookup_table_t table = {
+        .addresses = (const uint8_t (*)[32])keys,
+        .address_count = 62,
+    };
+    memset(table.key, 0x7a, 32);
+    espsol_tx_add_lookup_table(tx, &table);
+    espsol_tx_sign(tx, &payer);
+    err = espsol_tx_serialize(tx, buffer, sizeof(buffer), &out_len);
+    TEST_ASSERT_EQ(err, ESP_OK, "Serialize full key table with lookups");
+    espsol_tx_get_account_count(tx, &count);
+    TEST_ASSERT_EQ(count, 64, "All keys compiled once");
+    TEST_ASSERT(buffer[1 + 64 + 4] == 2, "Only payer and program are static");
+    
+    /* Last instruction: keys[2] is loaded writable #1, keys[59] loaded read-only #29 */
+    const uint8_t expected_last[5] = { 1, 2, 2 + 1, 2 + 31 + 29, 0 };
+    const uint8_t *lookups = buffer + out_len - (1 + 32 + 2 + 62);
+    TEST_ASSERT(memcmp(lookups - sizeof(expected_last), expected_last, sizeof(expected_last)) == 0,
+                "Last instruction resolved to loaded positions");
+    espsol_tx_destroy(tx);
+}
+
+static void test_tx_seal(void)
+{
+    printf("\n========== Sealed Message Tests ==========\n\n");
+    
+    espsol_keypair_t signers[3];
+    const espsol_keypair_t *keypairs[3];
+    for (int i = 0; i < 3; i++) {
+        uint8_t seed[32];
+        memset(seed, 0x80 + i, sizeof(seed));
+        espsol_keypair_from_seed(seed, &signers[i]);
+        keypairs[i] = &signers[i];
+    }
+    uint8_t blockhash[32];
+    memset(blockhash, 0xcd, sizeof(blockhash));
+    uint8_t program_id[32];
+    memset(program_id, 0x03, sizeof(program_id));
+    espsol_account_meta_t accounts[3];
+    for (int i = 0; i < 3; i++) {
+        memcpy(accounts[i].pubkey, signers[i].public_key, 32);
+        accounts[i].is_signer = true;
+        accounts[i].is_writable = true;
+    }
+    
+    espsol_tx_handle_t tx = NULL;
+    espsol_tx_create(&tx);
+    espsol_tx_set_fee_payer(tx, signers[0].public_key);
+    
+    esp_err_t err = espsol_tx_seal(tx);
+    TEST_ASSERT_EQ(err, ESP_ERR_ESPSOL_TX_BUILD_ERROR, "Seal without blockhash rejected");
+    
+    espsol_tx_set_recent_blockhash(tx, blockhash);
+    espsol_tx_add_instruction(tx, program_id, accounts, 3, NULL, 0);
+    err = espsol_tx_seal(tx);
+    TEST_ASSERT_EQ(err, ESP_OK, "Seal transaction");
+    
+    const uint8_t *message = NULL;
+    size_t message_len = 0;
+    err = espsol_tx_get_message(tx, &message, &message_len);
+    TEST_ASSERT(err == ESP_OK && message_len > 0 && message[0] == 3, "Sealed message available");
+    
+    err = espsol_tx_sign_multiple(tx, keypairs, 3);
+    TEST_ASSERT(err == ESP_OK && espsol_tx_is_signed(tx), "Three signers sign the sealed message");
+    
+    uint8_t buffer[1232];
+    size_t out_len = 0;
+    espsol_tx_serialize(tx, buffer, sizeof(buffer), &out_len);
+    TEST_ASSERT(out_len == 1 + 3 * 64 + message_len &&
+                memcmp(buffer + 1 + 3 * 64, message, message_len) == 0,
+                "Serialization prepends signatures to sealed message");
+    bool verified = true;
+    for (int i = 0; i < 3; i++) {
+        verified = verified && espsol_verify(message, message_len, buffer + 1 + i * 64,
+                                             signers[i].public_key) == ESP_OK;
+    }
+    TEST_ASSERT(verified, "Signatures verify against sealed message");
+    
+    /* Any change drops the seal and the signatures */
+    blockhash[0] ^= 1;
+    espsol_tx_set_recent_blockhash(tx, blockhash);
+    TEST_ASSERT(!espsol_tx_is_signed(tx), "New blockhash drops signatures");
+    err = espsol_tx_get_message(tx, &message, &message_len);
+    TEST_ASSERT(err == ESP_OK && message[4 + 4 * 32] == blockhash[0], "Resealed with new blockhash");
+    
+    espsol_tx_add_memo(tx, "sealed");
+    TEST_ASSERT_EQ(espsol_tx_serialize(tx, buffer, sizeof(buffer), &out_len), ESP_ERR_ESPSOL_TX_NOT_SIGNED,
+                   "New instruction drops signatures");
+    err = espsol_tx_sign_multiple(tx, keypairs, 3);
+    espsol_tx_get_message(tx, &message, &message_len);
+    espsol_tx_serialize(tx, buffer, sizeof(buffer), &out_len);
+    TEST_ASSERT(err == ESP_OK && memcmp(buffer + out_len - 6, "sealed", 6) == 0 &&
+                espsol_verify(message, message_len, buffer + 1, signers[0].public_key) == ESP_OK,
+                "Resigned after change");
+    espsol_tx_destroy(tx);
+}
+
+static void test_tx_partial_sign(void)
+{
+    printf("\n========== Partial Signing Tests ==========\n\n");
+    
+    espsol_keypair_t backend, device;
+    uint8_t seed[32];
+    memset(seed, 0x90, sizeof(seed));
+    espsol_keypair_from_seed(seed, &backend);
+    memset(seed, 0x91, sizeof(seed));
+    espsol_keypair_from_seed(seed, &device);
+    const espsol_keypair_t *keypairs[2] = { &backend, &device };
+    
+    uint8_t blockhash[32], recipient[32];
+    memset(blockhash, 0xce, sizeof(blockhash));
+    memset(recipient, 0x77, sizeof(recipient));
+    
+    espsol_tx_handle_t tx = NULL;
+    espsol_tx_create(&tx);
+    espsol_tx_set_fee_payer(tx, backend.public_key);
+    espsol_tx_add_transfer(tx, device.public_key, recipient, 5000);
+    
+    uint8_t signature[64];
+    memset(signature, 0x11, sizeof(signature));
+    TEST_ASSERT_EQ(espsol_tx_add_signature(tx, backend.public_key, signature), ESP_ERR_ESPSOL_TX_BUILD_ERROR,
+                   "Signature without blockhash rejected");
+    espsol_tx_set_recent_blockhash(tx, blockhash);
+    
+    /* The device signs first and exports with an empty fee payer slot */
+    esp_err_t err = espsol_tx_sign(tx, &device);
+    TEST_ASSERT(err == ESP_OK && !espsol_tx_is_signed(tx), "Device signs its slot");
+    
+    uint8_t partial[ESPSOL_MAX_TX_SIZE];
+    size_t partial_len = 0;
+    uint8_t buffer[ESPSOL_MAX_TX_SIZE];
+    size_t out_len = 0;
+    TEST_ASSERT_EQ(espsol_tx_serialize(tx, buffer, sizeof(buffer), &out_len), ESP_ERR_ESPSOL_TX_NOT_SIGNED,
+                   "Full serialization still requires every signature");
+    err = espsol_tx_serialize_partial(tx, partial, sizeof(partial), &partial_len);
+    static const uint8_t empty[64] = { 0 };
+    TEST_ASSERT(err == ESP_OK && partial[0] == 2 && memcmp(partial + 1, empty, 64) == 0 &&
+                memcmp(partial + 65, empty, 64) != 0, "Partial serialization zeroes missing slot");
+    TEST_ASSERT_EQ(espsol_tx_serialize_partial(tx, partial, 100, &out_len), ESP_ERR_ESPSOL_BUFFER_TOO_SMALL,
+                   "Partial serialization checks buffer size");
+    
+    size_t invalid = 99;
+    err = espsol_tx_verify_signatures(tx, &invalid);
+    TEST_ASSERT(err == ESP_ERR_ESPSOL_TX_NOT_SIGNED && invalid == 0, "Verification reports the empty slot");
+    
+    /* The backend signs the same message elsewhere and the signature is injected */
+    const uint8_t *message = NULL;
+    size_t message_len = 0;
+    espsol_tx_get_message(tx, &message, &message_len);
+    espsol_sign(message, message_len, &backend, signature);
+    
+    signature[0] ^= 1;
+    TEST_ASSERT_EQ(espsol_tx_add_signature(tx, backend.public_key, signature), ESP_ERR_ESPSOL_SIGNATURE_INVALID,
+                   "Bad signature rejected");
+    TEST_ASSERT(!espsol_tx_is_signed(tx), "Rejected signature not stored");
+    signature[0] ^= 1;
+    TEST_ASSERT_EQ(espsol_tx_add_signature(tx, recipient, signature), ESP_ERR_ESPSOL_TX_BUILD_ERROR,
+                   "Non-signer rejected");
+    TEST_ASSERT_EQ(espsol_tx_add_signature(tx, device.public_key, signature), ESP_ERR_ESPSOL_SIGNATURE_INVALID,
+                   "Signature of another signer rejected");
+    err = espsol_tx_add_signature(tx, backend.public_key, signature);
+    TEST_ASSERT(err == ESP_OK && espsol_tx_is_signed(tx), "Injected signature completes the transaction");
+    
+    size_t count = 0;
+    espsol_tx_get_signature_count(tx, &count);
+    TEST_ASSERT_EQ(count, 2, "Both slots counted");
+    
+    /* Same bytes as signing everything locally */
+    espsol_tx_serialize(tx, buffer, sizeof(buffer), &out_len);
+    uint8_t expected[ESPSOL_MAX_TX_SIZE];
+    size_t expected_len = 0;
+    espsol_tx_set_recent_blockhash(tx, blockhash);
+    espsol_tx_sign_multiple(tx, keypairs, 2);
+    espsol_tx_serialize(tx, expected, sizeof(expected), &expected_len);
+    TEST_ASSERT(out_len == expected_len && memcmp(buffer, expected, out_len) == 0,
+                "Injected transaction matches locally signed one");
+    TEST_ASSERT(partial_len == out_len && memcmp(partial + 65, buffer + 65, out_len - 65) == 0,
+                "Partial export carries the final message");
+    TEST_ASSERT_EQ(espsol_tx_verify_signatures(tx, NULL), ESP_OK, "Both signatures verify");
+    
+    /* Device signature with an order-8 component in R, valid only under the
+     * cofactored equation: every path must reject it like the runtime */
+    static const uint8_t mixed[64] = {
+        0xdf, 0x06, 0xe2, 0x89, 0x19, 0xf7, 0x8a, 0xb8, 0xda, 0xe4, 0x3a, 0x8b,
+        0x1d, 0xea, 0x19, 0x69, 0xd2, 0xa4, 0x73, 0xc9, 0xe0, 0xaf, 0x24, 0x9a,
+        0x90, 0xef, 0x3f, 0x7c, 0x2b, 0xf6, 0x95, 0x9b, 0x23, 0x3c, 0x72, 0xc2,
+        0x60, 0x50, 0x97, 0xba, 0x54, 0x3a, 0xcb, 0x05, 0x7b, 0x3a, 0x59, 0x56,
+        0xab, 0x8d, 0xbf, 0x83, 0x21, 0x3b, 0xe4, 0x57, 0xfd, 0xce, 0xcb, 0xa4,
+        0xa2, 0x37, 0xce, 0x03
+    };
+    TEST_ASSERT_EQ(espsol_tx_add_signature(tx, device.public_key, mixed), ESP_ERR_ESPSOL_SIGNATURE_INVALID,
+                   "Mixed-order R not injected");
+    memcpy(buffer + 1 + 64, mixed, 64);
+    espsol_tx_view_t view;
+    err = espsol_tx_view_parse(buffer, out_len, &view);
+    invalid = 99;
+    TEST_ASSERT(err == ESP_OK &&
+                espsol_tx_view_verify_signatures(&view, &invalid) == ESP_ERR_ESPSOL_SIGNATURE_INVALID &&
+                invalid == 1, "Relay rejects mixed-order R");
+    
+    espsol_tx_set_version(tx, ESPSOL_TX_VERSION_0);
+    espsol_tx_sign_multiple(tx, keypairs, 2);
+    TEST_ASSERT_EQ(espsol_tx_verify_signatures(tx, NULL), ESP_OK, "v0 signatures verify");
+    TEST_ASSERT_EQ(espsol_tx_verify_signatures(NULL, NULL), ESP_ERR_INVALID_ARG, "NULL transaction rejected");
+    espsol_tx_destroy(tx);
+}
+
+/**
+ * @brief Sign with every keypair and compare the estimate with the real size
+ */
+static bool size_matches(espsol_tx_handle_t tx, const espsol_keypair_t **keypairs, size_t count)
+{
+    size_t estimate = 0;
+    if (espsol_tx_get_size(tx, &estimate) != ESP_OK ||
+        espsol_tx_sign_multiple(tx, keypairs, count) != ESP_OK) {
+        return false;
+    }
+    uint8_t buffer[ESPSOL_MAX_TX_SIZE];
+    size_t out_len = 0;
+    if (espsol_tx_serialize(tx, buffer, sizeof(buffer), &out_len) != ESP_OK) {
+        return false;
+    }
+    return estimate == out_len;
+}
+
+static void test_tx_size(void)
+{
+    printf("\n========== Size Estimation Tests ==========\n\n");
+    
+    espsol_keypair_t signers[3];
+    const espsol_keypair_t *keypairs[3];
+    for (int i = 0; i < 3; i++) {
+        uint8_t seed[32];
+        memset(seed, 0x90 + i, sizeof(seed));
+        espsol_keypair_from_seed(seed, &signers[i]);
+        keypairs[i] = &signers[i];
+    }
+    uint8_t blockhash[32];
+    memset(blockhash, 0xcd, sizeof(blockhash));
+    uint8_t program_id[32];
+    memset(program_id, 0x03, sizeof(program_id));
+    uint8_t recipient[32];
+    memset(recipient, 0x24, sizeof(recipient));
+    
+    espsol_tx_handle_t tx = NULL;
+    espsol_tx_create(&tx);
+    espsol_tx_set_fee_payer(tx, signers[0].public_key);
+    espsol_tx_set_recent_blockhash(tx, blockhash);
+    
+    size_t size = 0;
+    espsol_tx_get_size(tx, &size);
+    TEST_ASSERT_EQ(size, 1 + 64 + 3 + 1 + 32 + 32 + 1, "Empty transaction counts the fee payer");
+    
+    size_t predicted = 0;
+    esp_err_t err = espsol_tx_instruction_fits(tx, program_id, NULL, 0, 12, &predicted);
+    TEST_ASSERT_EQ(err, ESP_OK, "Small instruction fits");
+    espsol_tx_add_transfer(tx, signers[0].public_key, recipient, 5);
+    espsol_tx_add_memo(tx, "size");
+    
+    /* Repeated accounts, a new signer and a read-only signer */
+    espsol_account_meta_t accounts[4] = {
+        { .is_signer = false, .is_writable = true },
+        { .is_signer = true, .is_writable = true },
+        { .is_signer = true, .is_writable = false },
+        { .is_signer = false, .is_writable = false },
+    };
+    memcpy(accounts[0].pubkey, recipient, 32);
+    memcpy(accounts[1].pubkey, signers[1].public_key, 32);
+    memcpy(accounts[2].pubkey, signers[2].public_key, 32);
+    memcpy(accounts[3].pubkey, signers[1].public_key, 32);
+    static uint8_t data[200];
+    memset(data, 0x11, sizeof(data));
+    err = espsol_tx_instruction_fits(tx, program_id, accounts, 4, 200, &predicted);
+    espsol_tx_add_instruction(tx, program_id, accounts, 4, data, 200);
+    espsol_tx_get_size(tx, &size);
+    TEST_ASSERT(err == ESP_OK && predicted == size, "Fit query predicts the new size");
+    TEST_ASSERT(size_matches(tx, keypairs, 3), "Legacy estimate matches serialized size");
+    
+    err = espsol_tx_instruction_fits(tx, program_id, NULL, 0, ESPSOL_MAX_TX_SIZE - size, NULL);
+    TEST_ASSERT_EQ(err, ESP_ERR_ESPSOL_BUFFER_TOO_SMALL, "Oversized instruction does not fit");
+    err = espsol_tx_instruction_fits(tx, program_id, NULL, 0, ESPSOL_MAX_TX_SIZE - size - 4, &predicted);
+    TEST_ASSERT(err == ESP_OK && predicted == ESPSOL_MAX_TX_SIZE, "Instruction filling the last byte fits");
+    
+    espsol_account_meta_t many[20];
+    memset(many, 0, sizeof(many));
+    for (int i = 0; i < 20; i++) {
+        memset(many[i].pubkey, 0x40 + i, 32);
+    }
+    err = espsol_tx_instruction_fits(tx, program_id, many, 20, 0, NULL);
+    TEST_ASSERT_EQ(err, ESP_ERR_ESPSOL_MAX_ACCOUNTS, "Too many static accounts reported");
+    
+    /* v0 without and with a lookup table */
+    espsol_tx_set_version(tx, ESPSOL_TX_VERSION_0);
+    TEST_ASSERT(size_matches(tx, keypairs, 3), "v0 estimate matches serialized size");
+    
+    uint8_t table_keys[2][32];
+    memset(table_keys[0], 0x24, 32);
+    memset(table_keys[1], 0x55, 32);
+    espsol_lookup_table_t table = {
+        .addresses = (const uint8_t (*)[32])table_keys,
+        .address_count = 2,
+    };
+    memset(table.key, 0x7a, 32);
+    espsol_tx_add_lookup_table(tx, &table);
+    espsol_tx_get_size(tx, &size);
+    TEST_ASSERT(size_matches(tx, keypairs, 3), "Lookup table estimate matches serialized size");
+    
+    memcpy(accounts[0].pubkey, table_keys[1], 32);
+    err = espsol_tx_instruction_fits(tx, program_id, accounts, 1, 0, &predicted);
+    espsol_tx_add_instruction(tx, program_id, accounts, 1, NULL, 0);
+    TEST_ASSERT(size_matches(tx, keypairs, 3), "Loaded account estimate matches serialized size");
+    espsol_tx_get_size(tx, &size);
+    TEST_ASSERT(err == ESP_OK && predicted >= size, "Fit query is an upper bound with tables");
+    
+    for (size_t n = 4; n < ESPSOL_MAX_INSTRUCTIONS; n++) {
+        espsol_tx_add_memo(tx, "x");
+    }
+    err = espsol_tx_instruction_fits(tx, program_id, NULL, 0, 0, NULL);
+    TEST_ASSERT_EQ(err, ESP_ERR_ESPSOL_MAX_INSTRUCTIONS, "Instruction limit reported");
+    espsol_tx_destroy(tx);
+}
+
+static esp_err_t count_write(void *ctx, const uint8_t *data, size_t len)
+{
+    (void)data;
+    size_t *calls = ctx;
+    (*calls)++;
+    return len > 0 ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+static void test_tx_text_output(void)
+{
+    printf("\n========== Text Output Tests ==========\n\n");
+    
+    espsol_keypair_t payer;
+    uint8_t seed[32];
+    memset(seed, 0x61, sizeof(seed));
+    espsol_keypair_from_seed(seed, &payer);
+    uint8_t blockhash[32];
+    memset(blockhash, 0xe1, sizeof(blockhash));
+    uint8_t program_id[32];
+    memset(program_id, 0x05, sizeof(program_id));
+    
+    espsol_tx_handle_t tx = NULL;
+    espsol_tx_create(&tx);
+    espsol_tx_set_fee_payer(tx, payer.public_key);
+    espsol_tx_set_recent_blockhash(tx, blockhash);
+    
+    /* Fill the transaction to the last byte: program key plus 4 bytes of framing */
+    size_t size = 0;
+    espsol_tx_get_size(tx, &size);
+    static uint8_t data[ESPSOL_MAX_TX_SIZE];
+    for (size_t i = 0; i < sizeof(data); i++) {
+        data[i] = (uint8_t)(i * 7 + 3);
+    }
+    espsol_tx_add_instruction(tx, program_id, NULL, 0, data, ESPSOL_MAX_TX_SIZE - size - 36);
+    
+    static char text[ESPSOL_MAX_TX_SIZE * 2];
+    esp_err_t err = espsol_tx_to_base64(tx, text, sizeof(text));
+    TEST_ASSERT_EQ(err, ESP_ERR_ESPSOL_TX_NOT_SIGNED, "Base64 needs a signed transaction");
+    
+    static uint8_t wire[ESPSOL_MAX_TX_SIZE];
+    size_t wire_len = 0;
+    espsol_tx_sign(tx, &payer);
+    espsol_tx_serialize(tx, wire, sizeof(wire), &wire_len);
+    TEST_ASSERT_EQ(wire_len, ESPSOL_MAX_TX_SIZE, "Transaction has the maximum size");
+    
+    size_t calls = 0;
+    espsol_writer_t counter = { .write = count_write, .ctx = &calls };
+    err = espsol_tx_write(tx, &counter);
+    TEST_ASSERT(err == ESP_OK && calls == 3, "Writer gets count, signatures and message");
+    
+    static char expected[ESPSOL_MAX_TX_SIZE * 2];
+    espsol_base64_encode(wire, wire_len, expected, sizeof(expected));
+    size_t b64_len = espsol_base64_encoded_len(wire_len);
+    err = espsol_tx_to_base64(tx, text, b64_len);
+    TEST_ASSERT_EQ(err, ESP_OK, "Base64 fits encoded_len() exactly");
+    TEST_ASSERT(strcmp(text, expected) == 0, "Streamed Base64 matches serialize + encode");
+    err = espsol_tx_to_base64(tx, text, b64_len - 1);
+    TEST_ASSERT_EQ(err, ESP_ERR_ESPSOL_BUFFER_TOO_SMALL, "Base64 one byte short rejected");
+    
+    err = espsol_tx_to_base58(tx, text, espsol_base58_encoded_len(wire_len));
+    TEST_ASSERT_EQ(err, ESP_OK, "Base58 of a full-size transaction");
+    espsol_base58_encode(wire, wire_len, expected, sizeof(expected));
+    TEST_ASSERT(strcmp(text, expected) == 0, "In-place Base58 matches serialize + encode");
+    
+    static uint8_t decoded[ESPSOL_MAX_TX_SIZE];
+    size_t decoded_len = sizeof(decoded);
+    err = espsol_base58_decode(text, decoded, &decoded_len);
+    TEST_ASSERT(err == ESP_OK && decoded_len == wire_len &&
+                memcmp(decoded, wire, wire_len) == 0, "Base58 decodes to the wire bytes");
+    
+    err = espsol_tx_to_base58(tx, text, wire_len);
+    TEST_ASSERT_EQ(err, ESP_ERR_ESPSOL_BUFFER_TOO_SMALL, "Base58 short buffer rejected");
+    espsol_tx_destroy(tx);
+}
+
+/**
+ * @brief Sign and serialize a transaction into buffer
+ */
+static size_t sign_and_serialize(espsol_tx_handle_t tx, const espsol_keypair_t *keypair,
+                                 uint8_t *buffer)
+{
+    size_t len = 0;
+    espsol_tx_sign(tx, keypair);
+    espsol_tx_serialize(tx, buffer, ESPSOL_MAX_TX_SIZE, &len);
+    return len;
+}
+
+static void test_tx_compute_budget(void)
+{
+    printf("\n========== Compute Budget Tests ==========\n\n");
+    
+    espsol_keypair_t payer;
+    uint8_t seed[32];
+    memset(seed, 0x61, sizeof(seed));
+    espsol_keypair_from_seed(seed, &payer);
+    uint8_t blockhash[32];
+    memset(blockhash, 0xe1, sizeof(blockhash));
+    uint8_t recipient[32];
+    memset(recipient, 0x24, sizeof(recipient));
+    
+    espsol_tx_handle_t tx = NULL, expected = NULL;
+    espsol_tx_create(&tx);
+    espsol_tx_create(&expected);
+    espsol_tx_set_fee_payer(tx, payer.public_key);
+    espsol_tx_set_fee_payer(expected, payer.public_key);
+    espsol_tx_set_recent_blockhash(tx, blockhash);
+    espsol_tx_set_recent_blockhash(expected, blockhash);
+    
+    /* Set after the other instructions, but ends up at the front */
+    espsol_tx_add_transfer(tx, payer.public_key, recipient, 1000);
+    espsol_tx_add_memo(tx, "budget");
+    esp_err_t err = espsol_tx_set_compute_unit_price(tx, 5000);
+    TEST_ASSERT_EQ(err, ESP_OK, "Set compute unit price");
+    err = espsol_tx_set_compute_unit_limit(tx, 300000);
+    TEST_ASSERT_EQ(err, ESP_OK, "Set compute unit limit");
+    
+    uint8_t price_data[9] = { 3, 0x88, 0x13, 0, 0, 0, 0, 0, 0 };
+    uint8_t limit_data[5] = { 2, 0xe0, 0x93, 0x04, 0x00 };
+    espsol_tx_add_instruction(expected, ESPSOL_COMPUTE_BUDGET_PROGRAM_ID, NULL, 0,
+                              price_data, sizeof(price_data));
+    espsol_tx_add_instruction(expected, ESPSOL_COMPUTE_BUDGET_PROGRAM_ID, NULL, 0,
+                              limit_data, sizeof(limit_data));
+    espsol_tx_add_transfer(expected, payer.public_key, recipient, 1000);
+    espsol_tx_add_memo(expected, "budget");
+    
+    uint8_t wire[ESPSOL_MAX_TX_SIZE], expected_wire[ESPSOL_MAX_TX_SIZE];
+    size_t len = sign_and_serialize(tx, &payer, wire);
+    size_t expected_len = sign_and_serialize(expected, &payer, expected_wire);
+    TEST_ASSERT(len == expected_len && memcmp(wire, expected_wire, len) == 0,
+                "Budget instructions placed at the front");
+    
+    /* Setting again updates in place and drops the signature */
+    size_t count = 0;
+    uint64_t fee = 0;
+    espsol_tx_set_compute_unit_price(tx, 7000);
+    espsol_tx_get_instruction_count(tx, &count);
+    TEST_ASSERT_EQ(count, 4, "Update keeps one instruction per kind");
+    TEST_ASSERT(!espsol_tx_is_signed(tx), "Update drops signatures");
+    espsol_tx_calculate_fee(tx, &fee);
+    TEST_ASSERT_EQ(fee, 5000 + 2100, "Fee follows the updated price");
+    
+    TEST_ASSERT_EQ(espsol_tx_set_heap_frame(tx, 1000), ESP_ERR_INVALID_ARG, "Unaligned heap frame rejected");
+    TEST_ASSERT_EQ(espsol_tx_set_heap_frame(tx, 512 * 1024), ESP_ERR_INVALID_ARG, "Oversized heap frame rejected");
+    TEST_ASSERT_EQ(espsol_tx_set_heap_frame(tx, 64 * 1024), ESP_OK, "Request heap frame");
+    TEST_ASSERT_EQ(espsol_tx_set_loaded_accounts_data_limit(tx, 0), ESP_ERR_INVALID_ARG,
+                   "Zero loaded data limit rejected");
+    TEST_ASSERT_EQ(espsol_tx_set_loaded_accounts_data_limit(tx, 32 * 1024), ESP_OK,
+                   "Set loaded accounts data limit");
+    espsol_tx_get_instruction_count(tx, &count);
+    TEST_ASSERT_EQ(count, 6, "All four kinds present");
+    
+    /* Clearing restores the plain transaction */
+    err = espsol_tx_clear_compute_budget(tx);
+    espsol_tx_get_instruction_count(tx, &count);
+    TEST_ASSERT(err == ESP_OK && count == 2, "Clear removes budget instructions");
+    
+    espsol_tx_reset(expected);
+    espsol_tx_set_fee_payer(expected, payer.public_key);
+    espsol_tx_set_recent_blockhash(expected, blockhash);
+    espsol_tx_add_transfer(expected, payer.public_key, recipient, 1000);
+    espsol_tx_add_memo(expected, "budget");
+    
+    size_t size = 0;
+    espsol_tx_get_size(tx, &size);
+    len = sign_and_serialize(tx, &payer, wire);
+    expected_len = sign_and_serialize(expected, &payer, expected_wire);
+    TEST_ASSERT(len == expected_len && memcmp(wire, expected_wire, len) == 0,
+                "Cleared transaction matches plain build");
+    TEST_ASSERT_EQ(size, len, "Size estimate drops the budget program");
+    
+    espsol_tx_destroy(tx);
+    espsol_tx_destroy(expected);
+}
+
 static void test_program_ids(void)
 {
     printf("\n========== Program ID Tests ==========\n\n");
@@ -397,6 +1332,15 @@ int main(void)
     test_tx_reset();
     test_tx_custom_instruction();
     test_tx_memo();
+    test_tx_versioned();
+    test_tx_static();
+    test_tx_limits();
+    test_tx_account_order();
+    test_tx_seal();
+    test_tx_partial_sign();
+    test_tx_size();
+    test_tx_text_output();
+    test_tx_compute_budget();
     test_program_ids();
     
     /* Summary */
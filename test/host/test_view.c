@@ -0,0 +1,435 @@
+/**
+ * @file test_view.c
+ * @brief Host-based Unit Tests for the ESPSOL Wire Transaction Parser
+ *
+ * Tests parsing legacy and v0 transactions built by espsol_tx, rejection
+ * of truncated and malformed bytes, pre-send validation and signing
+ * serialized transactions in place.
+ *
+ * @copyright Copyright (c) 2025 SkyRizz
+ * @license Apache-2.0
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Include ESPSOL headers */
+#include "espsol_types.h"
+#include "espsol_crypto.h"
+#include "espsol_tx.h"
+#include "espsol_view.h"
+
+/* ============================================================================
+ * Test Framework
+ * ========================================================================== */
+
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        if (condition) { \
+            printf("✓ PASS: %s\n", message); \
+            tests_passed++; \
+        } else { \
+            printf("✗ FAIL: %s\n", message); \
+            tests_failed++; \
+        } \
+    } while (0)
+
+#define TEST_ASSERT_EQ(actual, expected, message) \
+    do { \
+        if ((actual) == (expected)) { \
+            printf("✓ PASS: %s\n", message); \
+            tests_passed++; \
+        } else { \
+            printf("✗ FAIL: %s (expected %llu, got %llu)\n", message, \
+                   (unsigned long long)(expected), (unsigned long long)(actual)); \
+            tests_failed++; \
+        } \
+    } while (0)
+
+/* ============================================================================
+ * Helpers
+ * ========================================================================== */
+
+static espsol_keypair_t payer;
+static uint8_t recipient[32];
+static uint8_t blockhash[32];
+
+/**
+ * @brief Sign and serialize a transfer with a memo
+ */
+static size_t build_legacy(uint8_t *buffer)
+{
+    espsol_tx_handle_t tx = NULL;
+    size_t len = 0;
+
+    espsol_tx_create(&tx);
+    espsol_tx_set_fee_payer(tx, payer.public_key);
+    espsol_tx_set_recent_blockhash(tx, blockhash);
+    espsol_tx_add_transfer(tx, payer.public_key, recipient, 1000);
+    espsol_tx_add_memo(tx, "view");
+    espsol_tx_sign(tx, &payer);
+    espsol_tx_serialize(tx, buffer, ESPSOL_MAX_TX_SIZE, &len);
+    espsol_tx_destroy(tx);
+    return len;
+}
+
+/* ============================================================================
+ * Parse Tests
+ * ========================================================================== */
+
+static void test_parse_legacy(void)
+{
+    printf("\n========== Legacy Parse Tests ==========\n\n");
+
+    uint8_t wire[ESPSOL_MAX_TX_SIZE];
+    size_t len = build_legacy(wire);
+
+    espsol_tx_view_t view;
+    esp_err_t err = espsol_tx_view_parse(wire, len, &view);
+    TEST_ASSERT_EQ(err, ESP_OK, "Parse legacy transaction");
+    TEST_ASSERT(view.version == ESPSOL_TX_VERSION_LEGACY && view.lookup_count == 0, "Legacy message");
+    TEST_ASSERT(view.signature_count == 1 && view.required_signatures == 1 &&
+                view.readonly_signed == 0 && view.readonly_unsigned == 2, "Header parsed");
+    TEST_ASSERT_EQ(view.key_count, 4, "Four static keys");
+    TEST_ASSERT(memcmp(espsol_tx_view_get_key(&view, 0), payer.public_key, 32) == 0, "Fee payer first");
+    TEST_ASSERT(espsol_tx_view_get_key(&view, 4) == NULL, "Key index out of range");
+    TEST_ASSERT(memcmp(view.blockhash, blockhash, 32) == 0, "Blockhash parsed");
+    TEST_ASSERT(view.message == wire + 65 && view.message_len == len - 65, "Message points into wire");
+
+    size_t index = 0;
+    TEST_ASSERT(espsol_tx_view_find_key(&view, recipient, &index) == ESP_OK && index == 1, "Find recipient");
+    TEST_ASSERT_EQ(espsol_tx_view_find_key(&view, blockhash, &index), ESP_ERR_NOT_FOUND, "Unknown key");
+    TEST_ASSERT(espsol_tx_view_is_signer(&view, 0) && !espsol_tx_view_is_signer(&view, 1), "Signer flags");
+    TEST_ASSERT(espsol_tx_view_is_writable(&view, 0) && espsol_tx_view_is_writable(&view, 1) &&
+                !espsol_tx_view_is_writable(&view, 2) && !espsol_tx_view_is_writable(&view, 3),
+                "Writable flags");
+
+    espsol_tx_view_instruction_t ix;
+    TEST_ASSERT_EQ(view.instruction_count, 2, "Two instructions");
+    err = espsol_tx_view_get_instruction(&view, 0, &ix);
+    TEST_ASSERT(err == ESP_OK && ix.account_count == 2 && ix.accounts[0] == 0 && ix.accounts[1] == 1 &&
+                ix.data_len == 12 && ix.data[0] == 2 && ix.data[4] == 0xE8,
+                "Transfer instruction parsed");
+    TEST_ASSERT(memcmp(espsol_tx_view_get_key(&view, ix.program_index), ESPSOL_SYSTEM_PROGRAM_ID, 32) == 0,
+                "Transfer program");
+    err = espsol_tx_view_get_instruction(&view, 1, &ix);
+    TEST_ASSERT(err == ESP_OK && ix.account_count == 0 && ix.data_len == 4 && memcmp(ix.data, "view", 4) == 0,
+                "Memo instruction parsed");
+    TEST_ASSERT_EQ(espsol_tx_view_get_instruction(&view, 2, &ix), ESP_ERR_INVALID_ARG,
+                   "Instruction index out of range");
+
+    TEST_ASSERT(espsol_tx_view_is_signed(&view, 0) && !espsol_tx_view_is_signed(&view, 1), "Signature slot");
+    TEST_ASSERT(espsol_verify(view.message, view.message_len, view.signatures, payer.public_key) == ESP_OK,
+                "Signature covers the parsed message");
+    TEST_ASSERT_EQ(espsol_tx_view_validate(&view), ESP_OK, "Built transaction validates");
+
+    /* A bare message parses the same way */
+    espsol_tx_view_t message;
+    err = espsol_tx_view_parse_message(view.message, view.message_len, &message);
+    TEST_ASSERT(err == ESP_OK && message.wire == NULL && message.signature_count == 0 &&
+                message.key_count == 4 && message.instruction_count == 2, "Parse bare message");
+    TEST_ASSERT_EQ(espsol_tx_view_validate(&message), ESP_OK, "Bare message validates");
+
+    /* Unsigned slots are zero */
+    memset(wire + 1, 0, 64);
+    espsol_tx_view_parse(wire, len, &view);
+    TEST_ASSERT(!espsol_tx_view_is_signed(&view, 0), "Empty signature slot");
+}
+
+static void test_parse_v0(void)
+{
+    printf("\n========== Versioned Parse Tests ==========\n\n");
+
+    uint8_t addresses[6][32];
+    for (int i = 0; i < 6; i++) {
+        memset(addresses[i], 0x60 + i, 32);
+    }
+    espsol_lookup_table_t table = { .addresses = (const uint8_t (*)[32])addresses, .address_count = 6 };
+    memset(table.key, 0x0A, 32);
+
+    espsol_account_meta_t metas[4];
+    for (int i = 0; i < 4; i++) {
+        memcpy(metas[i].pubkey, addresses[i + 1], 32);
+        metas[i].is_signer = false;
+        metas[i].is_writable = (i % 2) == 0;
+    }
+    uint8_t program[32];
+    memset(program, 0x01, sizeof(program));
+    const uint8_t data[] = { 0x07 };
+
+    espsol_tx_handle_t tx = NULL;
+    espsol_tx_create(&tx);
+    espsol_tx_set_fee_payer(tx, payer.public_key);
+    espsol_tx_set_recent_blockhash(tx, blockhash);
+    espsol_tx_add_lookup_table(tx, &table);
+    espsol_tx_add_instruction(tx, program, metas, 4, data, sizeof(data));
+    espsol_tx_sign(tx, &payer);
+
+    uint8_t wire[ESPSOL_MAX_TX_SIZE];
+    size_t len = 0;
+    espsol_tx_serialize(tx, wire, sizeof(wire), &len);
+    espsol_tx_destroy(tx);
+
+    espsol_tx_view_t view;
+    esp_err_t err = espsol_tx_view_parse(wire, len, &view);
+    TEST_ASSERT_EQ(err, ESP_OK, "Parse v0 transaction");
+    TEST_ASSERT(view.version == ESPSOL_TX_VERSION_0 && view.key_count == 2, "Only signer and program static");
+    TEST_ASSERT(view.lookup_count == 1 && view.loaded_writable == 2 && view.loaded_readonly == 2,
+                "Loaded account counts");
+
+    espsol_tx_view_lookup_t lookup;
+    err = espsol_tx_view_get_lookup(&view, 0, &lookup);
+    TEST_ASSERT(err == ESP_OK && memcmp(lookup.key, table.key, 32) == 0 &&
+                lookup.writable_count == 2 && lookup.writable[0] == 1 && lookup.writable[1] == 3 &&
+                lookup.readonly_count == 2 && lookup.readonly[0] == 2 && lookup.readonly[1] == 4,
+                "Lookup entry parsed");
+    TEST_ASSERT_EQ(espsol_tx_view_get_lookup(&view, 1, &lookup), ESP_ERR_INVALID_ARG,
+                   "Lookup index out of range");
+
+    espsol_tx_view_instruction_t ix;
+    espsol_tx_view_get_instruction(&view, 0, &ix);
+    TEST_ASSERT(ix.program_index == 1 && ix.account_count == 4 && ix.accounts[0] == 2 && ix.accounts[1] == 4,
+                "Instruction uses loaded indexes");
+    TEST_ASSERT(espsol_tx_view_is_writable(&view, 2) && espsol_tx_view_is_writable(&view, 3) &&
+                !espsol_tx_view_is_writable(&view, 4) && !espsol_tx_view_is_writable(&view, 5),
+                "Loaded writable accounts come first");
+    TEST_ASSERT_EQ(espsol_tx_view_validate(&view), ESP_OK, "v0 transaction validates");
+
+    /* Truncating the lookups is caught */
+    TEST_ASSERT_EQ(espsol_tx_view_parse(wire, len - 1, &view), ESP_ERR_ESPSOL_ENCODING_FAILED,
+                   "Truncated lookup rejected");
+}
+
+static void test_malformed(void)
+{
+    printf("\n========== Malformed Input Tests ==========\n\n");
+
+    uint8_t wire[ESPSOL_MAX_TX_SIZE + 1];
+    size_t len = build_legacy(wire);
+    espsol_tx_view_t view;
+
+    bool all_rejected = true;
+    for (size_t i = 0; i < len; i++) {
+        if (espsol_tx_view_parse(wire, i, &view) != ESP_ERR_ESPSOL_ENCODING_FAILED) {
+            all_rejected = false;
+        }
+    }
+    TEST_ASSERT(all_rejected, "Every truncation rejected");
+    TEST_ASSERT(view.message == NULL && view.key_count == 0, "Failed parse clears the view");
+
+    wire[len] = 0;
+    TEST_ASSERT_EQ(espsol_tx_view_parse(wire, len + 1, &view), ESP_ERR_ESPSOL_ENCODING_FAILED,
+                   "Trailing bytes rejected");
+
+    /* Overlong compact-u16 for the signature count */
+    const uint8_t overlong[] = { 0x80, 0x00 };
+    TEST_ASSERT_EQ(espsol_tx_view_parse(overlong, sizeof(overlong), &view), ESP_ERR_ESPSOL_ENCODING_FAILED,
+                   "Overlong length rejected");
+    const uint8_t too_big[] = { 0xFF, 0xFF, 0x04 };
+    TEST_ASSERT_EQ(espsol_tx_view_parse(too_big, sizeof(too_big), &view), ESP_ERR_ESPSOL_ENCODING_FAILED,
+                   "Length above 0xFFFF rejected");
+
+    uint8_t message[] = { 0x81, 1, 0, 0 };
+    TEST_ASSERT_EQ(espsol_tx_view_parse_message(message, sizeof(message), &view), ESP_ERR_NOT_SUPPORTED,
+                   "Unknown version rejected");
+    TEST_ASSERT_EQ(espsol_tx_view_parse(NULL, 0, &view), ESP_ERR_INVALID_ARG, "NULL data rejected");
+}
+
+/* ============================================================================
+ * Validation Tests
+ * ========================================================================== */
+
+static void test_validate(void)
+{
+    printf("\n========== Validation Tests ==========\n\n");
+
+    uint8_t wire[ESPSOL_MAX_TX_SIZE];
+    uint8_t copy[ESPSOL_MAX_TX_SIZE];
+    size_t len = build_legacy(wire);
+    espsol_tx_view_t view;
+    espsol_tx_view_parse(wire, len, &view);
+
+    size_t header = (size_t)(view.message - wire);
+    size_t keys = (size_t)(view.keys - wire);
+    size_t ixs = (size_t)(view.instructions - wire);
+
+    memcpy(copy, wire, len);
+    memcpy(copy + keys + 2 * 32, copy + keys + 1 * 32, 32);
+    espsol_tx_view_parse(copy, len, &view);
+    TEST_ASSERT_EQ(espsol_tx_view_validate(&view), ESP_ERR_ESPSOL_TX_BUILD_ERROR, "Duplicate key rejected");
+
+    memcpy(copy, wire, len);
+    copy[header + 1] = 1;
+    espsol_tx_view_parse(copy, len, &view);
+    TEST_ASSERT_EQ(espsol_tx_view_validate(&view), ESP_ERR_ESPSOL_TX_BUILD_ERROR,
+                   "Read-only fee payer rejected");
+
+    memcpy(copy, wire, len);
+    copy[header + 2] = 4;
+    espsol_tx_view_parse(copy, len, &view);
+    TEST_ASSERT_EQ(espsol_tx_view_validate(&view), ESP_ERR_ESPSOL_TX_BUILD_ERROR,
+                   "Header beyond keys rejected");
+
+    memcpy(copy, wire, len);
+    copy[header] = 2;
+    espsol_tx_view_parse(copy, len, &view);
+    TEST_ASSERT_EQ(espsol_tx_view_validate(&view), ESP_ERR_ESPSOL_TX_BUILD_ERROR,
+                   "Missing signature slot rejected");
+
+    /* First instruction: program index, account count, accounts */
+    memcpy(copy, wire, len);
+    copy[ixs] = 0;
+    espsol_tx_view_parse(copy, len, &view);
+    TEST_ASSERT_EQ(espsol_tx_view_validate(&view), ESP_ERR_ESPSOL_TX_BUILD_ERROR,
+                   "Fee payer as program rejected");
+
+    memcpy(copy, wire, len);
+    copy[ixs] = 4;
+    espsol_tx_view_parse(copy, len, &view);
+    TEST_ASSERT_EQ(espsol_tx_view_validate(&view), ESP_ERR_ESPSOL_TX_BUILD_ERROR,
+                   "Program index out of range rejected");
+
+    memcpy(copy, wire, len);
+    copy[ixs + 3] = 4;
+    espsol_tx_view_parse(copy, len, &view);
+    TEST_ASSERT_EQ(espsol_tx_view_validate(&view), ESP_ERR_ESPSOL_TX_BUILD_ERROR,
+                   "Account index out of range rejected");
+
+    /* One instruction carrying 1200 bytes of data */
+    static uint8_t big[1400];
+    size_t pos = 0;
+    big[pos++] = 1;
+    pos += 64;
+    big[pos++] = 1;
+    big[pos++] = 0;
+    big[pos++] = 1;
+    big[pos++] = 2;
+    memcpy(big + pos, payer.public_key, 32);
+    pos += 32;
+    memcpy(big + pos, ESPSOL_MEMO_PROGRAM_ID, 32);
+    pos += 32;
+    memcpy(big + pos, blockhash, 32);
+    pos += 32;
+    big[pos++] = 1;
+    big[pos++] = 1;
+    big[pos++] = 0;
+    big[pos++] = 0xB0;
+    big[pos++] = 0x09;
+    pos += 1200;
+
+    esp_err_t err = espsol_tx_view_parse(big, pos, &view);
+    TEST_ASSERT(err == ESP_OK && view.instruction_count == 1, "Parse multi-byte lengths");
+    espsol_tx_view_instruction_t ix;
+    espsol_tx_view_get_instruction(&view, 0, &ix);
+    TEST_ASSERT_EQ(ix.data_len, 1200, "Data length decoded");
+    TEST_ASSERT_EQ(espsol_tx_view_validate(&view), ESP_ERR_ESPSOL_BUFFER_TOO_SMALL, "Oversized transaction");
+}
+
+/* ============================================================================
+ * Signing Tests
+ * ========================================================================== */
+
+static void test_wire_sign(void)
+{
+    printf("\n========== Wire Signing Tests ==========\n\n");
+
+    espsol_keypair_t device;
+    uint8_t seed[32];
+    memset(seed, 0x43, sizeof(seed));
+    espsol_keypair_from_seed(seed, &device);
+    const espsol_keypair_t *keypairs[2] = { &payer, &device };
+
+    espsol_tx_handle_t tx = NULL;
+    espsol_tx_create(&tx);
+    espsol_tx_set_fee_payer(tx, payer.public_key);
+    espsol_tx_set_recent_blockhash(tx, blockhash);
+    espsol_tx_add_transfer(tx, device.public_key, recipient, 5000);
+
+    /* Exported with both slots empty, as a backend would send it */
+    uint8_t wire[ESPSOL_MAX_TX_SIZE];
+    size_t len = 0;
+    espsol_tx_serialize_partial(tx, wire, sizeof(wire), &len);
+
+    espsol_tx_view_t view;
+    espsol_tx_view_parse(wire, len, &view);
+    TEST_ASSERT(!espsol_tx_view_is_signed(&view, 0) && !espsol_tx_view_is_signed(&view, 1),
+                "Partial export has empty slots");
+    size_t invalid = 99;
+    TEST_ASSERT(espsol_tx_view_verify_signatures(&view, &invalid) == ESP_ERR_ESPSOL_TX_NOT_SIGNED &&
+                invalid == 0, "Verification reports the empty slot");
+
+    esp_err_t err = espsol_tx_wire_sign(wire, len, &device);
+    espsol_tx_view_parse(wire, len, &view);
+    TEST_ASSERT(err == ESP_OK && !espsol_tx_view_is_signed(&view, 0) && espsol_tx_view_is_signed(&view, 1),
+                "Device signs its slot in place");
+
+    uint8_t signature[64];
+    espsol_sign(view.message, view.message_len, &payer, signature);
+    TEST_ASSERT_EQ(espsol_tx_wire_add_signature(wire, len, recipient, signature), ESP_ERR_ESPSOL_TX_BUILD_ERROR,
+                   "Non-signer rejected");
+    signature[63] ^= 0x40;
+    TEST_ASSERT_EQ(espsol_tx_wire_add_signature(wire, len, payer.public_key, signature),
+                   ESP_ERR_ESPSOL_SIGNATURE_INVALID, "Bad signature rejected");
+    signature[63] ^= 0x40;
+    err = espsol_tx_wire_add_signature(wire, len, payer.public_key, signature);
+    espsol_tx_view_parse(wire, len, &view);
+    TEST_ASSERT(err == ESP_OK && espsol_tx_view_is_signed(&view, 0), "Detached signature injected");
+
+    uint8_t expected[ESPSOL_MAX_TX_SIZE];
+    size_t expected_len = 0;
+    espsol_tx_sign_multiple(tx, keypairs, 2);
+    espsol_tx_serialize(tx, expected, sizeof(expected), &expected_len);
+    TEST_ASSERT(len == expected_len && memcmp(wire, expected, len) == 0, "Matches locally signed transaction");
+    espsol_tx_destroy(tx);
+
+    espsol_tx_view_parse(wire, len, &view);
+    TEST_ASSERT_EQ(espsol_tx_view_verify_signatures(&view, NULL), ESP_OK, "Both signatures verify");
+    wire[1 + 64 + 40] ^= 0x01;
+    err = espsol_tx_view_verify_signatures(&view, &invalid);
+    TEST_ASSERT(err == ESP_ERR_ESPSOL_SIGNATURE_INVALID && invalid == 1, "Corrupted slot found by index");
+    wire[1 + 64 + 40] ^= 0x01;
+
+    espsol_tx_view_t bare;
+    espsol_tx_view_parse_message(view.message, view.message_len, &bare);
+    TEST_ASSERT_EQ(espsol_tx_view_verify_signatures(&bare, NULL), ESP_ERR_ESPSOL_TX_BUILD_ERROR,
+                   "Bare message has no signatures to verify");
+
+    /* Slot count that disagrees with the header */
+    wire[0] = 1;
+    TEST_ASSERT(espsol_tx_wire_sign(wire, len, &payer) != ESP_OK, "Mismatched slots rejected");
+}
+
+/* ============================================================================
+ * Main
+ * ========================================================================== */
+
+int main(void)
+{
+    printf("==============================================\n");
+    printf("   ESPSOL Wire Transaction Parser Host Tests\n");
+    printf("==============================================\n");
+
+    uint8_t seed[32];
+    memset(seed, 0x42, sizeof(seed));
+    espsol_keypair_from_seed(seed, &payer);
+    memset(recipient, 0x24, sizeof(recipient));
+    memset(blockhash, 0xab, sizeof(blockhash));
+
+    test_parse_legacy();
+    test_parse_v0();
+    test_malformed();
+    test_validate();
+    test_wire_sign();
+
+    /* Summary */
+    printf("\n==============================================\n");
+    printf("Test Summary: %d passed, %d failed\n", tests_passed, tests_failed);
+    printf("==============================================\n");
+
+    return tests_failed > 0 ? 1 : 0;
+}